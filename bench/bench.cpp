@@ -0,0 +1,235 @@
+/** @file bench.cpp
+ *  @brief Runtime parsing throughput benchmarks
+ *
+ *  Measures `Pe`/`Elf` construction, `getSections()` and `getHeaders()` on
+ *  synthetic files with 1 to 65535 sections/program headers, the DWARF
+ *  line program state machine and `LineTable` on synthetic line programs,
+ *  and `Pe::versionInfo()` on the PE images of the tests (one operation maps
+ *  and parses one file, so files/s per core is 1e9 / ns/op).
+ *
+ *  Usage: bench [--filter=substring] [--min-time=seconds] [--json=file]
+ *               [--test-programs=directory]
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark.h"
+#include "pelfParser.h"
+#include "dwarfLine.h"
+#include "mappedFile.h"
+#include "syntheticFiles.h"
+
+
+namespace {
+
+/* Number of sections (and program headers for Elf) of the generated files */
+constexpr std::size_t table_sizes[] = { 1, 16, 256, 4096, 65535 };
+
+
+auto registerElfBenchmarks(pelf::bench::Runner& runner) -> void
+{
+  for (const auto entries : table_sizes) {
+    /* Shared so every std::function copy refers to the same file */
+    const auto data = std::make_shared<const std::vector<unsigned char>>(
+      pelf::bench::makeSyntheticElf(entries, entries));
+    const auto elf = std::make_shared<const pelf::Elf<std::vector<unsigned char>>>(
+      *data);
+    const auto suffix = "/" + std::to_string(entries);
+
+    runner.add("ElfConstruct" + suffix, data->size(), [data] {
+      pelf::Elf<std::vector<unsigned char>> parsed{ *data };
+      pelf::bench::doNotOptimize(parsed);
+    });
+
+    runner.add("ElfGetSections" + suffix,
+      entries * sizeof(pelf::Elf64_Shdr),
+      [elf] { pelf::bench::doNotOptimize(elf->getSections()); });
+
+    runner.add("ElfGetHeaders" + suffix,
+      sizeof(pelf::Elf64_Ehdr) + entries * sizeof(pelf::Elf64_Phdr),
+      [elf] { pelf::bench::doNotOptimize(elf->getHeaders()); });
+  }
+}
+
+auto registerPeBenchmarks(pelf::bench::Runner& runner) -> void
+{
+  for (const auto entries : table_sizes) {
+    const auto data = std::make_shared<const std::vector<unsigned char>>(
+      pelf::bench::makeSyntheticPe(entries));
+    const auto pe =
+      std::make_shared<const pelf::Pe<std::vector<unsigned char>>>(*data);
+    const auto suffix = "/" + std::to_string(entries);
+
+    runner.add("PeConstruct" + suffix, data->size(), [data] {
+      pelf::Pe<std::vector<unsigned char>> parsed{ *data };
+      pelf::bench::doNotOptimize(parsed);
+    });
+
+    runner.add("PeGetSections" + suffix,
+      entries * sizeof(pelf::IMAGE_SECTION_HEADER),
+      [pe] { pelf::bench::doNotOptimize(pe->getSections()); });
+
+    runner.add("PeGetHeaders" + suffix,
+      sizeof(pelf::PeHeaders),
+      [pe] { pelf::bench::doNotOptimize(pe->getHeaders()); });
+  }
+}
+
+auto registerDwarfBenchmarks(pelf::bench::Runner& runner) -> void
+{
+  for (const std::size_t rows : { 1024, 65536, 1048576 }) {
+    const auto data = std::make_shared<const std::vector<unsigned char>>(
+      pelf::bench::makeSyntheticLineProgram(rows));
+    /* The programs point into the data, the lambdas keep both alive */
+    const auto program = std::make_shared<const pelf::LineProgram<>>(
+      pelf::LineSections{ *data, {}, {} }, 0, 8);
+    const auto table = std::make_shared<const pelf::LineTable>(
+      pelf::DebugLine{ pelf::LineSections{ *data, {}, {} }, 8 });
+    const auto suffix = "/" + std::to_string(rows);
+
+    runner.add("LineProgramRun" + suffix, data->size(), [data, program] {
+      std::uint64_t lines{};
+      program->forEachRow(
+        [&](const pelf::LineRow& row) { lines += row.line; });
+      pelf::bench::doNotOptimize(lines);
+    });
+
+    runner.add("LineTableBuild" + suffix, data->size(), [data, program] {
+      pelf::LineTable built;
+      built.add(*program);
+      pelf::bench::doNotOptimize(built);
+    });
+
+    /* A batch of sorted addresses spread over the whole table */
+    std::vector<std::uint64_t> addresses(1024);
+    for (std::size_t i{}; i < addresses.size(); ++i) {
+      addresses[i] = 0x401000 + i * (rows / 1024) * 0x10000 / 1024;
+    }
+    runner.add("LineTableLookup" + suffix,
+      addresses.size() * sizeof(std::uint64_t),
+      [table, addresses] {
+        std::vector<std::optional<pelf::LineTable::Location>> locations(
+          addresses.size());
+        table->lookup(addresses, locations);
+        pelf::bench::doNotOptimize(locations);
+      });
+  }
+}
+
+/* Parses `bytes` and reads the file version, what a crawler of a directory
+ * of images does for every file once it's mapped */
+auto readFileVersion(std::span<const unsigned char> bytes) -> std::size_t
+{
+  std::size_t length{};
+  std::visit(
+    [&](const auto& parsed) {
+      if constexpr (requires { parsed.versionInfo(); }) {
+        const auto version = parsed.versionInfo();
+        if (!version) { return; }
+
+        if (const auto value = version->string("FileVersion")) {
+          length = value->size();
+        }
+      }
+    },
+    pelf::open(bytes));
+
+  return length;
+}
+
+auto registerVersionInfoBenchmarks(pelf::bench::Runner& runner,
+  const std::filesystem::path& directory) -> void
+{
+  std::error_code error;
+  if (!std::filesystem::is_directory(directory, error)) { return; }
+
+  std::vector<std::filesystem::path> images;
+  for (const auto& entry :
+    std::filesystem::directory_iterator(directory, error)) {
+    const auto extension = entry.path().extension();
+    if (extension == ".exe" || extension == ".dll") {
+      images.push_back(entry.path());
+    }
+  }
+  std::sort(images.begin(), images.end());
+
+  /* Mapped is the whole cost of a file, Parse leaves out the system calls */
+  for (const auto& image : images) {
+    const auto name = image.filename().string();
+    const auto size = std::filesystem::file_size(image);
+
+    runner.add("VersionInfoMapped/" + name, size, [image] {
+      const pelf::MappedFile file{ image };
+      pelf::bench::doNotOptimize(readFileVersion(file.bytes()));
+    });
+
+    const pelf::MappedFile file{ image };
+    const auto data = std::make_shared<const std::vector<unsigned char>>(
+      file.bytes().begin(), file.bytes().end());
+    runner.add("VersionInfoParse/" + name, size, [data] {
+      pelf::bench::doNotOptimize(readFileVersion(*data));
+    });
+  }
+}
+
+}// namespace
+
+
+auto main(int argc, char** argv) -> int
+{
+  double min_time{ 0.5 };
+  std::string filter;
+  std::string json_path;
+  std::string test_programs{ "tests/test_programs" };
+
+  for (int i{ 1 }; i < argc; ++i) {
+    const std::string_view arg{ argv[i] };
+
+    if (arg.starts_with("--filter=")) {
+      filter = arg.substr(9);
+    } else if (arg.starts_with("--min-time=")) {
+      min_time = std::stod(std::string{ arg.substr(11) });
+    } else if (arg.starts_with("--json=")) {
+      json_path = arg.substr(7);
+    } else if (arg.starts_with("--test-programs=")) {
+      test_programs = arg.substr(16);
+    } else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--filter=substring] [--min-time=seconds] [--json=file]"
+                   " [--test-programs=directory]\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  pelf::bench::Runner runner{ min_time, filter };
+
+  try {
+    registerElfBenchmarks(runner);
+    registerPeBenchmarks(runner);
+    registerDwarfBenchmarks(runner);
+    registerVersionInfoBenchmarks(runner, test_programs);
+  } catch (const pelf::PelfException& e) {
+    std::cerr << "Failed to parse a synthetic file: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  const auto results = runner.run(std::cout);
+
+  if (!json_path.empty()) {
+    std::ofstream json{ json_path };
+    pelf::bench::Runner::writeJson(json, results);
+  }
+
+  return EXIT_SUCCESS;
+}
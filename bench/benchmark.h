@@ -0,0 +1,231 @@
+/** @file benchmark.h
+ *  @brief Minimal benchmark harness
+ *
+ *  This file contains a small self-contained benchmark harness modelled after
+ *  Google Benchmark: every benchmark is run for a growing number of
+ *  iterations until it takes at least `minTime`, then it reports ns/op and
+ *  bytes/s, results can also be written as JSON for regression tracking
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PELF_BENCHMARK_H_
+#define PELF_BENCHMARK_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace pelf::bench {
+
+
+/** @brief Prevents the compiler from optimizing away `value`
+ *
+ *  @param value Value that has to be computed
+ * */
+template<class T> inline auto doNotOptimize(const T& value) -> void
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+
+/** @brief Result of a single benchmark */
+struct Result
+{
+  std::string name; /**< Name of the benchmark, e.g. "ElfConstruct/4096" */
+  std::size_t iterations{}; /**< Number of iterations measured */
+  double nsPerOp{}; /**< Average wall time of an iteration in nanoseconds */
+  double bytesPerSecond{}; /**< Bytes processed per second */
+};
+
+
+/** @brief Registry and runner of benchmarks
+ *
+ * */
+class Runner
+{
+public:
+  /** @brief Runner constructor
+   *
+   *  @param minTime Minimum time (in seconds) a benchmark has to run before
+   *  its result is accepted
+   *  @param filter Only benchmarks whose name contains `filter` are run
+   * */
+  explicit Runner(double minTime = 0.5, std::string filter = {});
+
+  /** @brief Registers a benchmark
+   *
+   *  @param name Name of the benchmark
+   *  @param bytesPerOp Number of bytes processed by one call to `function`,
+   *  used to compute the bytes/s column
+   *  @param function Code to be measured, it's called once per iteration
+   * */
+  auto add(std::string name,
+    std::size_t bytesPerOp,
+    std::function<void()> function) -> void;
+
+  /** @brief Runs every registered benchmark and prints a table to `out`
+   *
+   *  @return Results of the benchmarks that were run
+   * */
+  auto run(std::ostream& out) -> std::vector<Result>;
+
+  /** @brief Writes `results` in the Google Benchmark JSON format
+   *
+   *  @param out Stream where the JSON document is written
+   *  @param results Results returned by `run()`
+   * */
+  static auto writeJson(std::ostream& out, const std::vector<Result>& results)
+    -> void;
+
+private:
+  struct Entry
+  {
+    std::string name;
+    std::size_t bytesPerOp{};
+    std::function<void()> function;
+  };
+
+  double mMinTime; /**< Minimum time per benchmark in seconds */
+  std::string mFilter; /**< Substring that benchmark names must contain */
+  std::vector<Entry> mEntries; /**< Registered benchmarks */
+
+  /** @brief Measures a single benchmark */
+  [[nodiscard]] auto measure(const Entry& entry) const -> Result;
+};
+
+
+inline Runner::Runner(double minTime, std::string filter)
+  : mMinTime(minTime), mFilter(std::move(filter))
+{}
+
+inline auto Runner::add(std::string name,
+  std::size_t bytesPerOp,
+  std::function<void()> function) -> void
+{
+  mEntries.push_back({ std::move(name), bytesPerOp, std::move(function) });
+}
+
+inline auto Runner::measure(const Entry& entry) const -> Result
+{
+  using clock = std::chrono::steady_clock;
+
+  /* Warm up caches and the allocator */
+  entry.function();
+
+  std::size_t iterations{ 1 };
+  double elapsed{};
+
+  /* Same strategy as Google Benchmark, keep growing the number of iterations
+   * until the run is long enough to be meaningful */
+  for (;;) {
+    const auto start = clock::now();
+    for (std::size_t i{}; i < iterations; ++i) { entry.function(); }
+    elapsed =
+      std::chrono::duration<double>(clock::now() - start).count();
+
+    if (elapsed >= mMinTime || iterations >= 1'000'000'000) { break; }
+
+    const double multiplier = elapsed > 0.0 ? (mMinTime * 1.4) / elapsed : 10;
+    const auto next = static_cast<std::size_t>(
+      static_cast<double>(iterations) * (multiplier > 10 ? 10 : multiplier));
+    iterations = next > iterations ? next : iterations + 1;
+  }
+
+  Result result;
+  result.name = entry.name;
+  result.iterations = iterations;
+  result.nsPerOp = elapsed * 1e9 / static_cast<double>(iterations);
+  result.bytesPerSecond = static_cast<double>(entry.bytesPerOp)
+                          * static_cast<double>(iterations) / elapsed;
+  return result;
+}
+
+inline auto Runner::run(std::ostream& out) -> std::vector<Result>
+{
+  std::vector<Result> results;
+
+  out << std::left << std::setw(40) << "Benchmark" << std::right
+      << std::setw(16) << "ns/op" << std::setw(14) << "Iterations"
+      << std::setw(16) << "MB/s" << '\n'
+      << std::string(86, '-') << '\n';
+
+  for (const auto& entry : mEntries) {
+    if (entry.name.find(mFilter) == std::string::npos) { continue; }
+
+    const auto result = measure(entry);
+
+    out << std::left << std::setw(40) << result.name << std::right
+        << std::fixed << std::setprecision(1) << std::setw(16)
+        << result.nsPerOp << std::setw(14) << result.iterations
+        << std::setw(16) << result.bytesPerSecond / 1e6 << '\n';
+
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+inline auto Runner::writeJson(std::ostream& out,
+  const std::vector<Result>& results) -> void
+{
+  const auto now = std::time(nullptr);
+  char date[64]{};
+  std::strftime(date, sizeof(date), "%FT%T%z", std::localtime(&now));
+
+  out << "{\n"
+      << "  \"context\": {\n"
+      << "    \"date\": \"" << date << "\",\n"
+      << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#if defined(__clang__)
+      << "    \"compiler\": \"clang " << __clang_version__ << "\",\n"
+#elif defined(__GNUC__)
+      << "    \"compiler\": \"gcc " << __VERSION__ << "\",\n"
+#endif
+#ifdef NDEBUG
+      << "    \"library_build_type\": \"release\"\n"
+#else
+      << "    \"library_build_type\": \"debug\"\n"
+#endif
+      << "  },\n"
+      << "  \"benchmarks\": [\n";
+
+  for (std::size_t i{}; i < results.size(); ++i) {
+    const auto& result = results[i];
+    out << "    {\n"
+        << "      \"name\": \"" << result.name << "\",\n"
+        << "      \"run_type\": \"iteration\",\n"
+        << "      \"iterations\": " << result.iterations << ",\n"
+        << std::setprecision(3) << std::fixed
+        << "      \"real_time\": " << result.nsPerOp << ",\n"
+        << "      \"time_unit\": \"ns\",\n"
+        << std::setprecision(0)
+        << "      \"bytes_per_second\": " << result.bytesPerSecond << '\n'
+        << "    }" << (i + 1 < results.size() ? "," : "") << '\n';
+  }
+
+  out << "  ]\n}\n";
+}
+
+
+}// namespace pelf::bench
+
+
+#endif
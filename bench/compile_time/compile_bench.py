@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+"""Compile-time parsing cost benchmark and regression gate.
+
+Generates synthetic PE/ELF files of 64 KiB to 16 MiB, embeds them as
+constexpr std::array headers (the same layout `xxd -i` based headers use) and
+compiles compile_time.cpp once per (compiler, mode, size), recording the
+compiler wall time and peak RSS.
+
+Modes:
+  embed            only includes the embedded array (baseline cost)
+  pe_sections      pelf::getPeNumberOfSections()
+  pe_construct     constexpr pelf::Pe construction
+  elf_tables       pelf::getElfTablesSize()
+  elf_construct    constexpr pelf::Elf construction
+
+Usage:
+  compile_bench.py [--compilers g++,clang++] [--sizes 64K,1M] [--modes ...]
+                   [--json results.json] [--baseline old.json]
+                   [--tolerance 0.25]
+
+With --baseline the script exits with status 1 if any measurement is slower or
+uses more memory than the baseline by more than --tolerance (relative), or if
+a configuration that compiled in the baseline no longer does.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parents[2]
+SOURCE = Path(__file__).resolve().parent / "compile_time.cpp"
+
+MODES = {
+    "embed": ("PELF_BENCH_EMBED_ONLY", "pe"),
+    "pe_sections": ("PELF_BENCH_PE_SECTIONS", "pe"),
+    "pe_construct": ("PELF_BENCH_PE_CONSTRUCT", "pe"),
+    "elf_tables": ("PELF_BENCH_ELF_TABLES", "elf"),
+    "elf_construct": ("PELF_BENCH_ELF_CONSTRUCT", "elf"),
+}
+
+DEFAULT_SIZES = "64K,256K,1M,4M,16M"
+NUM_SECTIONS = 16
+NUM_PROGRAM_HEADERS = 8
+
+
+def parse_size(text):
+    units = {"K": 1 << 10, "M": 1 << 20, "G": 1 << 30}
+    text = text.strip().upper()
+    if text[-1] in units:
+        return int(text[:-1]) * units[text[-1]]
+    return int(text)
+
+
+def make_pe(size):
+    """PE32+ file with NUM_SECTIONS sections, zero padded to `size` bytes."""
+    data = bytearray(size)
+    pe_header_address = 0x40
+    optional_header_size = 240
+    data[0:2] = b"MZ"
+    struct.pack_into("<I", data, 0x3C, pe_header_address)
+    data[pe_header_address:pe_header_address + 4] = b"PE\0\0"
+
+    offset = pe_header_address + 4
+    struct.pack_into("<HHIIIHH", data, offset, 0x8664, NUM_SECTIONS, 0, 0, 0,
+                     optional_header_size, 0x22)
+    offset += 20
+    # Standard fields + windows specific fields (PE32+)
+    struct.pack_into("<HBBIIIII", data, offset, 0x20B, 14, 0, 0, 0, 0, 0x1000,
+                     0x1000)
+    struct.pack_into("<QII", data, offset + 24, 0x140000000, 0x1000, 0x200)
+    struct.pack_into("<I", data, offset + 24 + 84, 16)  # NumberOfRvaAndSizes
+    offset += optional_header_size
+
+    raw_size = max(0x200, (size - 0x400) // NUM_SECTIONS // 0x200 * 0x200)
+    for i in range(NUM_SECTIONS):
+        name = (".s%d" % i).encode().ljust(8, b"\0")
+        struct.pack_into("<8sIIIIIIHHI", data, offset, name, raw_size,
+                         0x1000 * (i + 1), raw_size, 0x400 + i * raw_size, 0,
+                         0, 0, 0, 0x40000040)
+        offset += 40
+    return bytes(data)
+
+
+def make_elf(size):
+    """64-bit little endian ELF file, zero padded to `size` bytes."""
+    data = bytearray(size)
+    phoff = 64
+    shoff = phoff + NUM_PROGRAM_HEADERS * 56
+    data[0:16] = b"\x7fELF\x02\x01\x01" + b"\0" * 9
+    struct.pack_into("<HHIQQQIHHHHHH", data, 16, 2, 62, 1, 0x401000, phoff,
+                     shoff, 0, 64, 56, NUM_PROGRAM_HEADERS, 64, NUM_SECTIONS,
+                     0)
+    for i in range(NUM_PROGRAM_HEADERS):
+        struct.pack_into("<IIQQQQQQ", data, phoff + i * 56, 1, 4, 0,
+                         0x400000 + i * 0x1000, 0x400000 + i * 0x1000,
+                         size, size, 0x1000)
+    for i in range(1, NUM_SECTIONS):
+        struct.pack_into("<IIQQQQIIQQ", data, shoff + i * 64, 0, 1, 2,
+                         0x400000 + i * 0x10, i * 0x10, 0x10, 0, 0, 1, 0)
+    return bytes(data)
+
+
+def write_header(path, data):
+    """Writes `data` as a constexpr std::array named bench_data."""
+    with open(path, "w") as out:
+        out.write("#include <array>\n\n")
+        out.write("constexpr std::array<unsigned char, %d> bench_data = {\n"
+                  % len(data))
+        line = 12
+        for i in range(0, len(data), line):
+            chunk = data[i:i + line]
+            out.write("  " + ", ".join("0x%02x" % b for b in chunk) + ",\n")
+        out.write("};\n")
+
+
+def compiler_flags(compiler):
+    """Flags that lift the constant evaluation limits of each compiler."""
+    version = subprocess.run([compiler, "--version"], capture_output=True,
+                             text=True).stdout
+    if "clang" in version:
+        return ["-fconstexpr-steps=2147483647"], version.splitlines()[0]
+    return ["-fconstexpr-ops-limit=4294967296",
+            "-fconstexpr-loop-limit=2147483647"], version.splitlines()[0]
+
+
+def compile_once(compiler, flags, define, header, timeout):
+    """Compiles compile_time.cpp, returns (status, wall seconds, peak RSS KiB)."""
+    command = [compiler, "-std=c++20", "-O0", "-c", "-o", os.devnull,
+               "-I" + str(ROOT / "include"), "-D" + define,
+               '-DPELF_BENCH_DATA="%s"' % header] + flags + [str(SOURCE)]
+
+    # The diagnostics go to a file, a pipe that isn't read while the compiler
+    # runs blocks it once it's full
+    with tempfile.TemporaryFile() as diagnostics:
+        start = time.perf_counter()
+        process = subprocess.Popen(command, stdout=subprocess.DEVNULL,
+                                   stderr=diagnostics)
+        timer = threading.Timer(timeout, process.kill)
+        timer.start()
+        # With no options wait4 blocks until the compiler exits, reaps it and
+        # returns the resource usage of that child alone (getrusage would
+        # add up every child waited for so far)
+        _, status, usage = os.wait4(process.pid, 0)
+        wall = time.perf_counter() - start
+        timed_out = not timer.is_alive()
+        timer.cancel()
+        process.returncode = os.waitstatus_to_exitcode(status)
+        diagnostics.seek(0)
+        stderr = diagnostics.read().decode(errors="replace")
+
+    if timed_out:
+        result = "timeout"
+    elif process.returncode != 0:
+        result = "failed"
+        sys.stderr.write(stderr[-2000:])
+    else:
+        result = "ok"
+
+    # ru_maxrss is in KiB on Linux
+    return result, wall, usage.ru_maxrss
+
+
+def run(args):
+    compilers = [c for c in args.compilers.split(",") if shutil.which(c)]
+    if not compilers:
+        sys.exit("None of the compilers %s was found" % args.compilers)
+
+    sizes = [parse_size(s) for s in args.sizes.split(",")]
+    modes = args.modes.split(",")
+    for mode in modes:
+        if mode not in MODES:
+            sys.exit("Unknown mode %s" % mode)
+
+    results = []
+    with tempfile.TemporaryDirectory(prefix="pelf_compile_bench_") as work:
+        headers = {}
+        for size in sizes:
+            for fmt, maker in (("pe", make_pe), ("elf", make_elf)):
+                path = Path(work) / ("%s_%d.h" % (fmt, size))
+                write_header(path, maker(size))
+                headers[(fmt, size)] = path
+
+        for compiler in compilers:
+            flags, version = compiler_flags(compiler)
+            for mode in modes:
+                define, fmt = MODES[mode]
+                for size in sizes:
+                    status, wall, rss = compile_once(
+                        compiler, flags, define, headers[(fmt, size)],
+                        args.timeout)
+                    record = {
+                        "compiler": compiler,
+                        "compiler_version": version,
+                        "mode": mode,
+                        "size_bytes": size,
+                        "status": status,
+                        "wall_seconds": round(wall, 3),
+                        "peak_rss_kib": rss,
+                    }
+                    results.append(record)
+                    print("%-10s %-14s %10d  %-8s %9.2f s %10.1f MiB"
+                          % (compiler, mode, size, status, wall, rss / 1024),
+                          flush=True)
+    return results
+
+
+def key(record):
+    return (record["compiler"], record["mode"], record["size_bytes"])
+
+
+def check_regressions(results, baseline, tolerance, min_delta):
+    """Returns a list of human readable regressions."""
+    previous = {key(r): r for r in baseline["results"]}
+    regressions = []
+    for record in results:
+        old = previous.get(key(record))
+        if old is None:
+            continue
+        name = "%s %s %d" % key(record)
+        if old["status"] == "ok" and record["status"] != "ok":
+            regressions.append("%s: %s (was ok)" % (name, record["status"]))
+            continue
+        if record["status"] != "ok" or old["status"] != "ok":
+            continue
+        wall, old_wall = record["wall_seconds"], old["wall_seconds"]
+        if wall > old_wall * (1 + tolerance) and wall - old_wall > min_delta:
+            regressions.append("%s: wall time %.2f s -> %.2f s"
+                               % (name, old_wall, wall))
+        rss, old_rss = record["peak_rss_kib"], old["peak_rss_kib"]
+        if rss > old_rss * (1 + tolerance):
+            regressions.append("%s: peak RSS %.1f MiB -> %.1f MiB"
+                               % (name, old_rss / 1024, rss / 1024))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--compilers", default="g++,clang++")
+    parser.add_argument("--sizes", default=DEFAULT_SIZES)
+    parser.add_argument("--modes", default=",".join(MODES))
+    parser.add_argument("--timeout", type=float, default=1800,
+                        help="seconds before a compilation is killed")
+    parser.add_argument("--json", help="write the results to this file")
+    parser.add_argument("--baseline", help="results of a previous run")
+    parser.add_argument("--tolerance", type=float, default=0.25,
+                        help="allowed relative increase (default 0.25)")
+    parser.add_argument("--min-delta", type=float, default=0.5,
+                        help="ignore wall time increases below this many "
+                             "seconds (default 0.5)")
+    args = parser.parse_args()
+
+    results = run(args)
+
+    if args.json:
+        with open(args.json, "w") as out:
+            json.dump({"results": results}, out, indent=2)
+
+    if args.baseline:
+        with open(args.baseline) as baseline_file:
+            baseline = json.load(baseline_file)
+        regressions = check_regressions(results, baseline, args.tolerance,
+                                        args.min_delta)
+        for regression in regressions:
+            print("REGRESSION " + regression)
+        if regressions:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
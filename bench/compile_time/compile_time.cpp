@@ -0,0 +1,51 @@
+/** @file compile_time.cpp
+ *  @brief Translation unit compiled by compile_bench.py
+ *
+ *  Exactly one of the PELF_BENCH_* macros selects what is evaluated at compile
+ *  time on the embedded binary `bench_data` (included from PELF_BENCH_DATA, a
+ *  header generated by compile_bench.py):
+ *
+ *  - PELF_BENCH_EMBED_ONLY: nothing, measures the cost of the array itself
+ *  - PELF_BENCH_PE_SECTIONS: `getPeNumberOfSections()`
+ *  - PELF_BENCH_PE_CONSTRUCT: constexpr `Pe` construction
+ *  - PELF_BENCH_ELF_TABLES: `getElfTablesSize()`
+ *  - PELF_BENCH_ELF_CONSTRUCT: constexpr `Elf` construction
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+#include <cstdlib>
+
+#include "pelfParser.h"
+
+#include PELF_BENCH_DATA
+
+
+#if defined(PELF_BENCH_PE_SECTIONS) || defined(PELF_BENCH_PE_CONSTRUCT)
+inline constexpr auto sections = pelf::getPeNumberOfSections(bench_data);
+static_assert(sections != 0);
+#endif
+
+#ifdef PELF_BENCH_PE_CONSTRUCT
+constexpr pelf::Pe<decltype(bench_data), sections> compile_pe{ bench_data };
+static_assert(compile_pe.getHeaders().getCoffHeader().NumberOfSections
+              == sections);
+#endif
+
+#if defined(PELF_BENCH_ELF_TABLES) || defined(PELF_BENCH_ELF_CONSTRUCT)
+inline constexpr auto tables_size = pelf::getElfTablesSize(bench_data);
+static_assert(tables_size.sectionTable != 0);
+#endif
+
+#ifdef PELF_BENCH_ELF_CONSTRUCT
+constexpr pelf::Elf<decltype(bench_data),
+  tables_size.sectionTable,
+  tables_size.programTable>
+  compile_elf{ bench_data };
+static_assert(compile_elf.getHeaders().programHeaders.size()
+              == tables_size.programTable);
+#endif
+
+
+auto main() -> int { return bench_data[0] == 0 ? EXIT_FAILURE : EXIT_SUCCESS; }
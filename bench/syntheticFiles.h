@@ -0,0 +1,284 @@
+/** @file syntheticFiles.h
+ *  @brief Deterministic generators of synthetic PE and ELF files
+ *
+ *  The benchmarks need files with an arbitrary number of sections and program
+ *  headers, instead of depending on an external corpus the files are built in
+ *  memory, the same parameters always produce the same bytes
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PELF_SYNTHETICFILES_H_
+#define PELF_SYNTHETICFILES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "pelfParser.h"
+#include "dwarfStructs.h"
+
+
+namespace pelf::bench {
+
+
+/** @brief Copies `value` into `data` at `offset` (little endian host) */
+template<class Struct>
+inline auto writeStruct(std::vector<unsigned char>& data,
+  std::size_t offset,
+  const Struct& value) -> void
+{
+  std::memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+
+/** @brief Builds a 64-bit little endian ELF file
+ *
+ *  The file contains an Elf header, `numProgramHeaders` PT_LOAD program
+ *  headers and `numSections` sections (including the null section at index
+ *  0). Counts that don't fit in `e_shnum`/`e_phnum` use the extended
+ *  numbering stored in the section at index 0, like real linkers do
+ *
+ *  @param numSections Number of entries in the section table (at least 1)
+ *  @param numProgramHeaders Number of entries in the program header table
+ *
+ *  @return Bytes of the generated file
+ * */
+inline auto makeSyntheticElf(std::size_t numSections,
+  std::size_t numProgramHeaders) -> std::vector<unsigned char>
+{
+  if (numSections == 0) { numSections = 1; }
+
+  constexpr std::size_t section_data_size{ 16 };
+
+  const std::size_t phoff = sizeof(Elf64_Ehdr);
+  const std::size_t data_offset = phoff + numProgramHeaders * sizeof(Elf64_Phdr);
+  const std::size_t shoff = data_offset + numSections * section_data_size;
+
+  std::vector<unsigned char> data(shoff + numSections * sizeof(Elf64_Shdr));
+
+  Elf64_Ehdr header{};
+  const unsigned char ident[16] = { EI_MAG0, EI_MAG1, EI_MAG2, EI_MAG3,
+    EI_CLASS, EI_DATA, 1 };
+  std::memcpy(&header.e_ident_high, ident, 8);
+  std::memcpy(&header.e_ident_low, ident + 8, 8);
+  header.e_type = 2;// ET_EXEC
+  header.e_machine = 62;// EM_X86_64
+  header.e_version = 1;
+  header.e_entry = 0x401000;
+  header.e_phoff = numProgramHeaders != 0 ? phoff : 0;
+  header.e_shoff = shoff;
+  header.e_ehsize = sizeof(Elf64_Ehdr);
+  header.e_phentsize = sizeof(Elf64_Phdr);
+  header.e_phnum = static_cast<std::uint16_t>(
+    numProgramHeaders >= PN_XNUM ? PN_XNUM : numProgramHeaders);
+  header.e_shentsize = sizeof(Elf64_Shdr);
+  header.e_shnum = static_cast<std::uint16_t>(
+    numSections >= SHN_LORESERVE ? 0 : numSections);
+  header.e_shstrndx = 0;
+  writeStruct(data, 0, header);
+
+  for (std::size_t i{}; i < numProgramHeaders; ++i) {
+    Elf64_Phdr program_header{};
+    program_header.p_type = 1;// PT_LOAD
+    program_header.p_flags = 4;// PF_R
+    program_header.p_offset = data_offset;
+    program_header.p_vaddr = 0x400000 + i * 0x1000;
+    program_header.p_paddr = program_header.p_vaddr;
+    program_header.p_filesz = section_data_size;
+    program_header.p_memsz = section_data_size;
+    program_header.p_align = 0x1000;
+    writeStruct(data, phoff + i * sizeof(Elf64_Phdr), program_header);
+  }
+
+  /* Null section, it also carries the extended section/program header count */
+  Elf64_Shdr null_section{};
+  if (numSections >= SHN_LORESERVE) { null_section.sh_size = numSections; }
+  if (numProgramHeaders >= PN_XNUM) {
+    null_section.sh_info = static_cast<std::uint32_t>(numProgramHeaders);
+  }
+  writeStruct(data, shoff, null_section);
+
+  for (std::size_t i{ 1 }; i < numSections; ++i) {
+    Elf64_Shdr section{};
+    section.sh_type = SHT_PROGBITS;
+    section.sh_flags = (i % 3 == 0) ? SHF_ALLOC | SHF_EXECINSTR : SHF_ALLOC;
+    section.sh_addr = 0x400000 + i * section_data_size;
+    section.sh_offset = data_offset + i * section_data_size;
+    section.sh_size = section_data_size;
+    section.sh_addralign = 1;
+    writeStruct(data, shoff + i * sizeof(Elf64_Shdr), section);
+  }
+
+  return data;
+}
+
+
+/** @brief Builds a PE32+ file
+ *
+ *  The file contains a DOS header, the PE signature, the coff header, the
+ *  optional header (with 16 data directories) and `numSections` sections
+ *
+ *  @param numSections Number of entries in the section table (at most 65535)
+ *
+ *  @return Bytes of the generated file
+ * */
+inline auto makeSyntheticPe(std::size_t numSections)
+  -> std::vector<unsigned char>
+{
+  constexpr std::uint32_t pe_header_address{ 0x40 };
+  constexpr std::size_t optional_header_size{ sizeof(StandardCoffFields)
+                                              + sizeof(WindowsSpecificFields)
+                                              + sizeof(IMAGE_DATA_DIRECTORY)
+                                                  * IMAGE_NUMBER_OF_DIRECTORY_ENTRIES };
+  constexpr std::size_t section_data_size{ 0x200 };
+
+  const std::size_t section_table = pe_header_address + sizeof(DWORD)
+                                    + sizeof(IMAGE_FILE_HEADER)
+                                    + optional_header_size;
+  const std::size_t headers_size =
+    section_table + numSections * sizeof(IMAGE_SECTION_HEADER);
+  const std::size_t first_section =
+    (headers_size + section_data_size - 1) / section_data_size
+    * section_data_size;
+
+  std::vector<unsigned char> data(
+    first_section + numSections * section_data_size);
+
+  data[0] = 'M';
+  data[1] = 'Z';
+  writeStruct(data, 0x3c, pe_header_address);
+
+  const unsigned char signature[4] = { 'P', 'E', 0, 0 };
+  std::memcpy(data.data() + pe_header_address, signature, sizeof(signature));
+
+  IMAGE_FILE_HEADER coff{};
+  coff.Machine = 0x8664;
+  coff.NumberOfSections = static_cast<WORD>(numSections);
+  coff.SizeOfOptionalHeader = static_cast<WORD>(optional_header_size);
+  coff.Characteristics = 0x22;
+  writeStruct(data, pe_header_address + sizeof(DWORD), coff);
+
+  StandardCoffFields scf{};
+  scf.Magic = 0x20b;
+  scf.AddressOfEntryPoint = 0x1000;
+  scf.BaseOfCode = 0x1000;
+  const std::size_t scf_offset =
+    pe_header_address + sizeof(DWORD) + sizeof(IMAGE_FILE_HEADER);
+  writeStruct(data, scf_offset, scf);
+
+  WindowsSpecificFields wsf{};
+  wsf.ImageBase = 0x140000000;
+  wsf.SectionAlignment = 0x1000;
+  wsf.FileAlignment = section_data_size;
+  wsf.SizeOfImage =
+    static_cast<DWORD>(0x1000 + numSections * wsf.SectionAlignment);
+  wsf.SizeOfHeaders = static_cast<DWORD>(first_section);
+  wsf.Subsystem = 3;
+  wsf.NumberOfRvaAndSizes = IMAGE_NUMBER_OF_DIRECTORY_ENTRIES;
+  writeStruct(data, scf_offset + sizeof(scf), wsf);
+
+  for (std::size_t i{}; i < numSections; ++i) {
+    IMAGE_SECTION_HEADER section{};
+    const char name[8] = { '.', 's', static_cast<char>('0' + i % 10) };
+    std::memcpy(&section.Name, name, sizeof(name));
+    section.PhysAddressAndVirtSize = section_data_size;
+    section.VirtualAddress = static_cast<DWORD>(0x1000 + i * 0x1000);
+    section.SizeOfRawData = section_data_size;
+    section.PointerToRawData =
+      static_cast<DWORD>(first_section + i * section_data_size);
+    section.Characteristics = 0x40000040;// INITIALIZED_DATA | MEM_READ
+    writeStruct(
+      data, section_table + i * sizeof(IMAGE_SECTION_HEADER), section);
+  }
+
+  return data;
+}
+
+
+
+/** @brief Builds a `.debug_line` section with a DWARF 4 line program
+ *
+ *  The program has one file and `numRows` rows split in sequences of 1024
+ *  rows. Like the output of compilers most rows are special opcodes, with a
+ *  column or line change every few rows
+ *
+ *  @param numRows Number of rows, without the ends of sequence
+ *
+ *  @return Bytes of the section
+ * */
+inline auto makeSyntheticLineProgram(std::size_t numRows)
+  -> std::vector<unsigned char>
+{
+  constexpr std::uint8_t opcode_base{ 13 };
+  constexpr std::size_t rows_per_sequence{ 1024 };
+
+  const auto uleb = [](std::vector<unsigned char>& out, std::uint64_t value) {
+    do {
+      const auto byte = static_cast<unsigned char>(value & 0x7f);
+      value >>= 7;
+      out.push_back(value != 0 ? byte | 0x80 : byte);
+    } while (value != 0);
+  };
+
+  std::vector<unsigned char> header{
+    4, 0,// version
+    0, 0, 0, 0,// header_length, patched below
+    1,// minimum_instruction_length
+    1,// maximum_operations_per_instruction
+    1,// default_is_stmt
+    static_cast<unsigned char>(-5),// line_base
+    14,// line_range
+    opcode_base, 0, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1,// standard_opcode_lengths
+    0,// no include directories
+    'm', 'a', 'i', 'n', '.', 'c', 0, 0, 0, 0,// file 1
+    0// end of the file names
+  };
+  const auto header_length = static_cast<std::uint32_t>(header.size() - 6);
+  std::memcpy(header.data() + 2, &header_length, sizeof(header_length));
+
+  std::vector<unsigned char> program;
+  std::uint64_t address{ 0x401000 };
+
+  for (std::size_t row{}; row < numRows; ++row) {
+    if (row % rows_per_sequence == 0) {
+      if (row != 0) {
+        program.insert(program.end(), { 0, 1, DW_LNE_end_sequence });
+      }
+      program.insert(program.end(), { 0, 9, DW_LNE_set_address });
+      for (int i{}; i < 8; ++i) {
+        program.push_back(static_cast<unsigned char>(address >> (8 * i)));
+      }
+      address += 0x10000;
+    }
+
+    if (row % 8 == 7) {
+      program.push_back(DW_LNS_set_column);
+      uleb(program, row % 80);
+      program.push_back(DW_LNS_advance_line);
+      program.push_back(2);
+    }
+
+    /* Address advance 0 to 7, line advance -1 to 3 */
+    const auto adjusted = (row * 7 % 8) * 14 + 4 + row % 5;
+    program.push_back(static_cast<unsigned char>(opcode_base + adjusted));
+  }
+  program.insert(program.end(), { 0, 1, DW_LNE_end_sequence });
+
+  std::vector<unsigned char> data(4);
+  const auto unit_length =
+    static_cast<std::uint32_t>(header.size() + program.size());
+  std::memcpy(data.data(), &unit_length, sizeof(unit_length));
+  data.insert(data.end(), header.begin(), header.end());
+  data.insert(data.end(), program.begin(), program.end());
+
+  return data;
+}
+
+}// namespace pelf::bench
+
+
+#endif
@@ -14,6 +14,21 @@
 
 #include "Pelf.h"
 #include "elfStructs.h"
+#include "sectionColumns.h"
+#include "elfNotes.h"
+#include "ehFrame.h"
+#include "decompress.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 
 namespace pelf {
@@ -22,25 +37,27 @@ namespace pelf {
 /**
  * @brief Get the Section Table Size
  *
+ * @tparam Class File class (`Elf64Class` or `Elf32Class`)
  * @tparam Callable object
  * @param elfHeader Elf header of the file (already initialized)
  * @param read_struct function that reads a header and initializes it.
  * @return Returns the Number of Entries in the Elf section table
  */
-template<class Function>
-constexpr auto getSectionTableSize(const Elf64_Ehdr& elfHeader,
+template<class Class = Elf64Class, class Function>
+constexpr auto getSectionTableSize(const typename Class::Ehdr& elfHeader,
   Function read_struct) -> std::size_t;
 
 /**
  * @brief Get the Program Table Size
  *
+ * @tparam Class File class (`Elf64Class` or `Elf32Class`)
  * @tparam Callable object
  * @param elfHeader Elf header of the file (already initialized)
  * @param read_struct function that reads a header and initializes it.
  * @return Returns the Number of Entries in the Elf program header table
  */
-template<class Function>
-constexpr auto getProgramTableSize(const Elf64_Ehdr& elfHeader,
+template<class Class = Elf64Class, class Function>
+constexpr auto getProgramTableSize(const typename Class::Ehdr& elfHeader,
   Function read_struct) -> std::size_t;
 
 /**
@@ -56,21 +73,37 @@ template<class Container>
 constexpr auto getElfTablesSize(const Container& data)
   -> TableSizes requires container_and_convertible_v<Container, unsigned char>;
 
+/**
+ * @brief Same as above, but the file class and byte order are given instead of
+ * being read from e_ident
+ *
+ * @tparam Class File class (`Elf64Class` or `Elf32Class`)
+ * @tparam Endian Byte order of the file
+ * @param data
+ * @return Returns a `TableSizes` struct
+ */
+template<class Class,
+  std::endian Endian = std::endian::little,
+  class Container>
+constexpr auto getElfTablesSize(const Container& data)
+  -> TableSizes requires container_and_convertible_v<Container, unsigned char>;
+
 
-template<class Function>
-constexpr auto getSectionTableSize(const Elf64_Ehdr& elfHeader,
+template<class Class, class Function>
+constexpr auto getSectionTableSize(const typename Class::Ehdr& elfHeader,
   Function read_struct) -> std::size_t
 {
   /* If the offset of the section table is zero, then the size has to be zero */
   if (elfHeader.e_shoff == 0) { return 0; }
 
-  /* If e_shnum holds a value greater or equal than SHN_LORESERVE , then the
-     number of entries of the section table is in the variable sh_size which
-     is member of the inital entry in section header table
+  /* If the number of entries is greater or equal than SHN_LORESERVE, then
+     e_shnum holds zero and the number of entries of the section table is in
+     the variable sh_size which is member of the inital entry in section header
+     table (for files with no sections sh_size is zero too)
       */
-  if (elfHeader.e_shnum >= SHN_LORESERVE) {
+  if (elfHeader.e_shnum == 0) {
     /* Read the initial entry in section header table*/
-    Elf64_Shdr section_header = {};
+    typename Class::Shdr section_header = {};
     read_struct(section_header, elfHeader.e_shoff);
     return section_header.sh_size;
   }
@@ -79,8 +112,8 @@ constexpr auto getSectionTableSize(const Elf64_Ehdr& elfHeader,
 }
 
 
-template<class Function>
-constexpr auto getProgramTableSize(const Elf64_Ehdr& elfHeader,
+template<class Class, class Function>
+constexpr auto getProgramTableSize(const typename Class::Ehdr& elfHeader,
   Function read_struct) -> std::size_t
 {
   /* If the offset of the program header table is zero, then the size has to be
@@ -93,7 +126,7 @@ constexpr auto getProgramTableSize(const Elf64_Ehdr& elfHeader,
       */
   if (elfHeader.e_phnum >= PN_XNUM) {
     /* Read the initial entry in section header table*/
-    Elf64_Shdr section_header = {};
+    typename Class::Shdr section_header = {};
     read_struct(section_header, elfHeader.e_shoff);
     return section_header.sh_info;
   }
@@ -102,6 +135,22 @@ constexpr auto getProgramTableSize(const Elf64_Ehdr& elfHeader,
 }
 
 template<class Container>
+constexpr auto getElfTablesSize(const Container& data)
+  -> TableSizes requires container_and_convertible_v<Container, unsigned char>
+{
+  const bool big_endian = readByte(data, EI_DATA_OFFSET) == ELFDATA2MSB;
+
+  if (readByte(data, EI_CLASS_OFFSET) == ELFCLASS32) {
+    return big_endian
+             ? getElfTablesSize<Elf32Class, std::endian::big>(data)
+             : getElfTablesSize<Elf32Class, std::endian::little>(data);
+  }
+
+  return big_endian ? getElfTablesSize<Elf64Class, std::endian::big>(data)
+                    : getElfTablesSize<Elf64Class, std::endian::little>(data);
+}
+
+template<class Class, std::endian Endian, class Container>
 constexpr auto getElfTablesSize(const Container& data)
   -> TableSizes requires container_and_convertible_v<Container, unsigned char>
 {
@@ -115,7 +164,11 @@ constexpr auto getElfTablesSize(const Container& data)
 #pragma unroll
       for (std::size_t i{}; i < sizeof(member); ++i) {
         if (sizeof(member) > 1) { member <<= 8; }
-        member |= data.at(sizeof(member) - 1 + offset - i);
+        if constexpr (Endian == std::endian::little) {
+          member |= readByte(data, sizeof(member) - 1 + offset - i);
+        } else {
+          member |= readByte(data, offset + i);
+        }
       }
 
       offset += sizeof(member);
@@ -128,14 +181,16 @@ constexpr auto getElfTablesSize(const Container& data)
   /* Need to read some headers in order to extract the section table size
   and the program header table size */
 
-  Elf64_Ehdr elf_header = {};
+  typename Class::Ehdr elf_header = {};
 
   /* Read the elf header */
   read_struct(elf_header, ELF_HEADER_OFFSET);
 
-  tables_size.sectionTable = getSectionTableSize(elf_header, read_struct);
+  tables_size.sectionTable =
+    getSectionTableSize<Class>(elf_header, read_struct);
 
-  tables_size.programTable = getProgramTableSize(elf_header, read_struct);
+  tables_size.programTable =
+    getProgramTableSize<Class>(elf_header, read_struct);
 
 
   return tables_size;
@@ -148,50 +203,272 @@ constexpr auto getElfTablesSize(const Container& data)
  *  that needs to be parsed
  *  @tparam NumOfSections Number of entries in the section table
  *  @tparam NumOfProgHeaders Number of entries in the program header table
+ *  @tparam Class File class, `Elf64Class` (default) or `Elf32Class`, it
+ *  selects the structs used to read the file, see `pelf::Elf32`
+ *  @tparam Endian Byte order of the file (EI_DATA), big endian files are
+ *  swapped while they are read, files in the byte order of the host are
+ *  copied as they are
+ *  @tparam Allocator Allocator used by the tables when they are vectors (only
+ *  when parsing at runtime), e.g. `std::pmr::polymorphic_allocator<std::byte>`
+ *  to parse into an arena, see `pelf::pmr::Elf`
  *
  * */
 template<class Container,
   std::size_t NumOfSections = 0,
-  std::size_t NumOfProgHeaders = 0>
+  std::size_t NumOfProgHeaders = 0,
+  class Class = Elf64Class,
+  std::endian Endian = std::endian::little,
+  class Allocator = std::allocator<std::byte>>
 class Elf
-  : public Pelf<Container, Elf<Container, NumOfSections, NumOfProgHeaders>>
+  : public Pelf<Container,
+      Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>>
 {
 public:
+  using FileClass = Class; /**< `Elf64Class` or `Elf32Class` */
+  static constexpr std::endian byteOrder{ Endian }; /**< Byte order of the
+                                                       file */
+
   /** @brief Elf constructor
    *
    *  @param data data to be parsed
+   *  @param alloc allocator used by the tables (and by the copy of `data` if
+   *  `Container` is allocator aware)
    * */
-  constexpr explicit Elf(const Container& data);
+  constexpr explicit Elf(const Container& data,
+    const Allocator& alloc = Allocator{});
 
   /**
    * @brief Returns a `ElfHeaders` struct that contains the Elf header and the
    * program header table
    *
-   * @return ElfHeaders<NumOfProgHeaders>
+   * @return A reference to the headers, the program header table keeps the
+   * allocator of this object
    */
   [[nodiscard]] constexpr auto getHeaders() const noexcept
-    -> ElfHeaders<NumOfProgHeaders>;
+    -> const ElfHeaders<NumOfProgHeaders, Class, Allocator>&;
 
   /**
    * @brief Returns the Section table
    *
-   * @return Table<Elf64_Shdr, NumOfSections>
+   * @return A reference to the section table, no copy is made
    */
   [[nodiscard]] constexpr auto getSections() const noexcept
-    -> Table<Elf64_Shdr, NumOfSections>;
+    -> const Table<typename Class::Shdr, NumOfSections, Allocator>&;
+
+  /**
+   * @brief Returns a columnar (struct of arrays) copy of the section table
+   *
+   * Useful when the same section table is queried many times, see
+   * `SectionColumns`
+   *
+   * @return SectionColumns
+   */
+  [[nodiscard]] constexpr auto getSectionColumns() const -> SectionColumns;
+
+  /**
+   * @brief Returns the allocator used by the tables
+   *
+   * @return Allocator
+   */
+  [[nodiscard]] constexpr auto getAllocator() const noexcept -> Allocator;
+
+  /**
+   * @brief Returns the contents of a section
+   *
+   * @param section Entry of the section table
+   * @return Span over the data of the file, empty for SHT_NOBITS sections. It
+   * throws `PelfException` if the section is outside of the file
+   */
+  [[nodiscard]] constexpr auto getSectionData(
+    const typename Class::Shdr& section) const -> std::span<const unsigned char>;
+
+  /**
+   * @brief Returns the bytes of a segment that are stored in the file
+   *
+   * @param segment Entry of the program header table
+   * @return Span over the data of the file, `p_filesz` bytes. It throws
+   * `PelfException` if the segment is outside of the file
+   */
+  [[nodiscard]] constexpr auto getSegmentData(
+    const typename Class::Phdr& segment) const -> std::span<const unsigned char>;
+
+  /**
+   * @brief Returns `true` if the data of the section is compressed
+   * (SHF_COMPRESSED)
+   *
+   * @param section Entry of the section table
+   */
+  [[nodiscard]] constexpr auto isCompressed(
+    const typename Class::Shdr& section) const noexcept -> bool;
+
+  /**
+   * @brief Returns the compression header of a SHF_COMPRESSED section
+   *
+   * @param section Entry of the section table
+   * @return Class::Chdr, it throws `PelfException` if the section isn't
+   * compressed
+   */
+  [[nodiscard]] constexpr auto getCompressionHeader(
+    const typename Class::Shdr& section) const -> typename Class::Chdr;
+
+  /**
+   * @brief Returns the size of the contents of a section, once decompressed
+   *
+   * @param section Entry of the section table
+   * @return `ch_size` for compressed sections, `sh_size` otherwise and zero for
+   * SHT_NOBITS sections
+   */
+  [[nodiscard]] constexpr auto getSectionSize(
+    const typename Class::Shdr& section) const -> std::uint64_t;
+
+  /**
+   * @brief Returns the contents of a section, decompressing them if needed
+   *
+   * Sections that aren't compressed are returned from the data of the file
+   * and `buffer` isn't used. Compressed sections are decompressed into
+   * `buffer`, it must have at least `getSectionSize(section)` bytes
+   *
+   * @param section Entry of the section table
+   * @param buffer Buffer for the decompressed data
+   * @return Contents of the section, it throws `PelfException` if `buffer` is
+   * too small or the section can't be decompressed (see `decompress()`)
+   */
+  [[nodiscard]] auto getSectionContents(const typename Class::Shdr& section,
+    std::span<unsigned char> buffer) const -> std::span<const unsigned char>;
+
+  /**
+   * @brief Same as above, but `buffer` is resized to the size of the
+   * decompressed data, reusing a buffer between calls avoids allocations
+   *
+   * `ch_size` is read from the file, it throws `pelfInvalidSize` before
+   * resizing `buffer` if it's larger than `maxSize` or than the algorithm can
+   * produce from the compressed data (see `maxCompressionRatio()`)
+   *
+   * @param section Entry of the section table
+   * @param buffer Buffer for the decompressed data
+   * @param maxSize Largest decompressed size accepted
+   * @return Contents of the section
+   */
+  template<class BufferAllocator>
+  [[nodiscard]] auto getSectionContents(const typename Class::Shdr& section,
+    std::vector<unsigned char, BufferAllocator>& buffer,
+    std::uint64_t maxSize = std::numeric_limits<std::uint64_t>::max()) const
+    -> std::span<const unsigned char>;
+
+  /**
+   * @brief Returns the name of a section, read from the section header string
+   * table (e_shstrndx)
+   *
+   * @param section Entry of the section table
+   * @return Name of the section, empty if the file has no string table
+   */
+  [[nodiscard]] auto getSectionName(const typename Class::Shdr& section) const
+    -> std::string_view;
+
+  /**
+   * @brief Returns the first section named `name`
+   *
+   * @param name Name of the section, e.g. ".gnu_debuglink"
+   * @return Entry of the section table, `std::nullopt` if there isn't one
+   */
+  [[nodiscard]] auto findSection(std::string_view name) const
+    -> std::optional<typename Class::Shdr>;
+
+  /**
+   * @brief Returns the contents of the `.gnu_debuglink` section
+   *
+   * @return DebugLink, `std::nullopt` if the file doesn't have one
+   */
+  [[nodiscard]] auto debugLink() const -> std::optional<DebugLink>;
+
+  /**
+   * @brief Returns the notes of a PT_NOTE segment
+   *
+   * Only the bytes of the segment are read, it throws `PelfException` if the
+   * segment is outside of the file
+   *
+   * @param segment Entry of the program header table
+   * @return NoteRange<Endian>
+   */
+  [[nodiscard]] constexpr auto getNotes(const typename Class::Phdr& segment)
+    const -> NoteRange<Endian>;
+
+  /**
+   * @brief Returns the notes of a SHT_NOTE section
+   *
+   * @param section Entry of the section table
+   * @return NoteRange<Endian>
+   */
+  [[nodiscard]] constexpr auto getNotes(const typename Class::Shdr& section)
+    const -> NoteRange<Endian>;
+
+  /**
+   * @brief Returns the GNU build ID of the file (NT_GNU_BUILD_ID)
+   *
+   * The PT_NOTE segments are searched first, the SHT_NOTE sections are only
+   * searched if no segment has a build ID (e.g. relocatable files), so just
+   * the pages that contain notes are read. With a `std::span` over a memory
+   * mapped file as `Container` nothing else is loaded from disk
+   *
+   * @return Build ID bytes pointing into the data of the file, empty if the
+   * file doesn't have a build ID
+   */
+  [[nodiscard]] constexpr auto buildId() const
+    -> std::span<const unsigned char>;
+
+  /**
+   * @brief Returns the bytes of the file from the virtual address `address`
+   * to the end of the PT_LOAD segment that contains it
+   *
+   * Files without segments (e.g. separate debug files) are looked up in the
+   * SHF_ALLOC sections
+   *
+   * @param address Virtual address
+   * @return Bytes of the file, empty if no segment or section contains
+   * `address` or it's only in memory (p_memsz > p_filesz)
+   */
+  [[nodiscard]] constexpr auto getDataAtAddress(std::uint64_t address) const
+    -> std::span<const unsigned char>;
+
+  /**
+   * @brief Returns the `.eh_frame_hdr` of the file and the `.eh_frame` it
+   * points to
+   *
+   * The PT_GNU_EH_FRAME segment is used, or the `.eh_frame_hdr` section if
+   * there's no segment. Nothing is copied, the table of FDEs is searched in
+   * the data of the file
+   *
+   * @return EhFrameHdr, `std::nullopt` if the file doesn't have one. It throws
+   * `PelfException` if the header is invalid or `.eh_frame` isn't in the file
+   */
+  [[nodiscard]] auto ehFrameHdr() const -> std::optional<EhFrameHdr<Endian>>;
 
 
 private:
-  friend class Pelf<Container, Elf<Container, NumOfSections, NumOfProgHeaders>>;
+  friend class Pelf<Container,
+    Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>>;
   /* Member Variables */
 
-  ElfHeaders<NumOfProgHeaders> mHeaders; /**< Struct that contains the elf
-                          header and the program header table */
+  Allocator mAllocator; /**< Allocator used by the tables */
+
+  ElfHeaders<NumOfProgHeaders, Class, Allocator>
+    mHeaders; /**< Struct that contains the elf header and the program header
+                 table */
 
-  Table<Elf64_Shdr, NumOfSections> mSections = {}; /**< Section header table */
+  Table<typename Class::Shdr, NumOfSections, Allocator>
+    mSections; /**< Section header table */
 
   /* Private member functions */
 
+  /**
+   * @brief Returns the bytes of the file from `offset` to `offset + size`
+   *
+   * @return Returns a span over `mData`, it throws `PelfException` if the
+   * range is outside of the file
+   */
+  constexpr auto getBytes(std::uint64_t offset, std::uint64_t size) const
+    -> std::span<const unsigned char>;
+
 
   /**
    * @brief Checks if the elf file size is valid
@@ -229,10 +506,19 @@ private:
 
 template<class Container,
   std::size_t NumOfSections,
-  std::size_t NumOfProgHeaders>
-constexpr Elf<Container, NumOfSections, NumOfProgHeaders>::Elf(
-  const Container& data)
-  : Pelf<Container, Elf<Container, NumOfSections, NumOfProgHeaders>>(data)
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::Elf(
+  const Container& data,
+  const Allocator& alloc)
+  : Pelf<Container,
+    Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>>(data,
+    alloc),
+    mAllocator(alloc),
+    mHeaders{ {}, makeTable<decltype(mHeaders.programHeaders)>(alloc) },
+    mSections(makeTable<decltype(mSections)>(alloc))
 {
   checkFileSize();
 
@@ -242,10 +528,13 @@ constexpr Elf<Container, NumOfSections, NumOfProgHeaders>::Elf(
 
 template<class Container,
   std::size_t NumOfSections,
-  std::size_t NumOfProgHeaders>
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
 constexpr auto
-  Elf<Container, NumOfSections, NumOfProgHeaders>::getHeaders() const noexcept
-  -> ElfHeaders<NumOfProgHeaders>
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getHeaders()
+    const noexcept -> const ElfHeaders<NumOfProgHeaders, Class, Allocator>&
 {
   return mHeaders;
 }
@@ -253,11 +542,445 @@ constexpr auto
 
 template<class Container,
   std::size_t NumOfSections,
-  std::size_t NumOfProgHeaders>
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getSections()
+    const noexcept
+  -> const Table<typename Class::Shdr, NumOfSections, Allocator>&
+{
+  return mSections;
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getSectionColumns()
+    const -> SectionColumns
+{
+  return SectionColumns{ mSections };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getAllocator()
+    const noexcept -> Allocator
+{
+  return mAllocator;
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getSectionData(
+    const typename Class::Shdr& section) const -> std::span<const unsigned char>
+{
+  if (section.sh_type == SHT_NOBITS) { return {}; }
+
+  return getBytes(section.sh_offset, section.sh_size);
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getSegmentData(
+    const typename Class::Phdr& segment) const -> std::span<const unsigned char>
+{
+  return getBytes(segment.p_offset, segment.p_filesz);
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::isCompressed(
+    const typename Class::Shdr& section) const noexcept -> bool
+{
+  return (section.sh_flags & SHF_COMPRESSED) != 0
+         && section.sh_type != SHT_NOBITS;
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getCompressionHeader(
+    const typename Class::Shdr& section) const -> typename Class::Chdr
+{
+  if (!isCompressed(section)) {
+    throw PelfException{ "The section isn't compressed" };
+  }
+
+  return readStruct<typename Class::Chdr, Endian>(getSectionData(section), 0);
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getSectionSize(
+    const typename Class::Shdr& section) const -> std::uint64_t
+{
+  if (section.sh_type == SHT_NOBITS) { return 0; }
+  if (isCompressed(section)) { return getCompressionHeader(section).ch_size; }
+  return section.sh_size;
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getSectionContents(
+    const typename Class::Shdr& section,
+    std::span<unsigned char> buffer) const -> std::span<const unsigned char>
+{
+  const auto data = getSectionData(section);
+  if (!isCompressed(section)) { return data; }
+
+  const auto header = readStruct<typename Class::Chdr, Endian>(data, 0);
+  if (header.ch_size > buffer.size()) {
+    throw pelfInvalidSize{ "Buffer too small for the decompressed section",
+      buffer.size() };
+  }
+
+  const auto output = buffer.first(static_cast<std::size_t>(header.ch_size));
+  decompress(header.ch_type, data.subspan(sizeof(typename Class::Chdr)), output);
+
+  return output;
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+template<class BufferAllocator>
+auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getSectionContents(
+    const typename Class::Shdr& section,
+    std::vector<unsigned char, BufferAllocator>& buffer,
+    std::uint64_t maxSize) const -> std::span<const unsigned char>
+{
+  if (!isCompressed(section)) { return getSectionData(section); }
+
+  const auto header = getCompressionHeader(section);
+  const std::uint64_t compressed =
+    getSectionData(section).size() - sizeof(typename Class::Chdr);
+  if (header.ch_size > maxSize
+      || header.ch_size / maxCompressionRatio(header.ch_type) > compressed) {
+    throw pelfInvalidSize{ "Invalid compressed section, ch_size is too large",
+      static_cast<std::size_t>(header.ch_size) };
+  }
+
+  buffer.resize(static_cast<std::size_t>(header.ch_size));
+  return getSectionContents(section, std::span<unsigned char>{ buffer });
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getSectionName(
+    const typename Class::Shdr& section) const -> std::string_view
+{
+  std::size_t index = mHeaders.elfHeader.e_shstrndx;
+
+  /* If the index doesn't fit in e_shstrndx it's in sh_link of section 0 */
+  if (index == SHN_XINDEX && !mSections.empty()) {
+    index = mSections[0].sh_link;
+  }
+
+  if (index == 0 || index >= mSections.size()) { return {}; }
+
+  const auto strings = getSectionData(mSections[index]);
+  if (section.sh_name >= strings.size()) { return {}; }
+
+  const auto name = strings.subspan(section.sh_name);
+  std::size_t size{};
+  while (size < name.size() && name[size] != 0) { ++size; }
+
+  return { reinterpret_cast<const char*>(name.data()), size };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::findSection(
+    std::string_view name) const -> std::optional<typename Class::Shdr>
+{
+  for (const auto& section : mSections) {
+    if (getSectionName(section) == name) { return section; }
+  }
+
+  return std::nullopt;
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::debugLink() const
+    -> std::optional<DebugLink>
+{
+  const auto section = findSection(".gnu_debuglink");
+  if (!section) { return std::nullopt; }
+
+  /* Null terminated file name, padded to 4 bytes, followed by the CRC */
+  const auto data = getSectionData(*section);
+  std::size_t size{};
+  while (size < data.size() && data[size] != 0) { ++size; }
+
+  const std::size_t crc_offset = (size + 1 + 3) & ~std::size_t{ 3 };
+
+  DebugLink link;
+  link.fileName = { reinterpret_cast<const char*>(data.data()), size };
+  link.crc = readInteger<std::uint32_t, Endian>(data, crc_offset);
+
+  return link;
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getNotes(
+    const typename Class::Phdr& segment) const -> NoteRange<Endian>
+{
+  return NoteRange<Endian>{ getBytes(segment.p_offset, segment.p_filesz),
+    static_cast<std::size_t>(segment.p_align) };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getNotes(
+    const typename Class::Shdr& section) const -> NoteRange<Endian>
+{
+  return NoteRange<Endian>{ getBytes(section.sh_offset, section.sh_size),
+    static_cast<std::size_t>(section.sh_addralign) };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::buildId() const
+    -> std::span<const unsigned char>
+{
+  for (const auto& segment : mHeaders.programHeaders) {
+    if (segment.p_type != PT_NOTE) { continue; }
+
+    const auto build_id = findBuildId(getNotes(segment));
+    if (!build_id.empty()) { return build_id; }
+  }
+
+  for (const auto& section : mSections) {
+    if (section.sh_type != SHT_NOTE) { continue; }
+
+    const auto build_id = findBuildId(getNotes(section));
+    if (!build_id.empty()) { return build_id; }
+  }
+
+  return {};
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getDataAtAddress(
+    std::uint64_t address) const -> std::span<const unsigned char>
+{
+  bool has_segments{};
+
+  for (const auto& segment : mHeaders.programHeaders) {
+    if (segment.p_type != PT_LOAD) { continue; }
+    has_segments = true;
+
+    if (address < segment.p_vaddr || address - segment.p_vaddr >= segment.p_filesz) {
+      continue;
+    }
+
+    const std::uint64_t offset = address - segment.p_vaddr;
+    return getBytes(segment.p_offset + offset, segment.p_filesz - offset);
+  }
+
+  if (has_segments) { return {}; }
+
+  for (const auto& section : mSections) {
+    if ((section.sh_flags & SHF_ALLOC) == 0 || section.sh_type == SHT_NOBITS) {
+      continue;
+    }
+
+    if (address < section.sh_addr || address - section.sh_addr >= section.sh_size) {
+      continue;
+    }
+
+    const std::uint64_t offset = address - section.sh_addr;
+    return getBytes(section.sh_offset + offset, section.sh_size - offset);
+  }
+
+  return {};
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::ehFrameHdr() const
+    -> std::optional<EhFrameHdr<Endian>>
+{
+  constexpr std::uint8_t address_size = Class::ident == ELFCLASS64 ? 8 : 4;
+
+  std::span<const unsigned char> hdr;
+  std::optional<std::uint64_t> hdr_address;
+
+  for (const auto& segment : mHeaders.programHeaders) {
+    if (segment.p_type != PT_GNU_EH_FRAME) { continue; }
+
+    hdr = getBytes(segment.p_offset, segment.p_filesz);
+    hdr_address = segment.p_vaddr;
+    break;
+  }
+
+  if (!hdr_address) {
+    const auto section = findSection(".eh_frame_hdr");
+    if (!section) { return std::nullopt; }
+
+    hdr = getSectionData(*section);
+    hdr_address = section->sh_addr;
+  }
+
+  /* .eh_frame_hdr only has the address of .eh_frame, not its size, FDEs are
+   * bounded by their length and the zero terminator */
+  const auto frame = getDataAtAddress(
+    EhFrameHdr<Endian>::readFramePointer(hdr, *hdr_address, address_size));
+  if (frame.empty()) {
+    throw PelfException{ "Invalid .eh_frame_hdr, .eh_frame isn't in the file" };
+  }
+
+  return EhFrameHdr<Endian>{ hdr, *hdr_address, frame, address_size };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
 constexpr auto
-  Elf<Container, NumOfSections, NumOfProgHeaders>::checkFileSize() const -> void
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::getBytes(
+    std::uint64_t offset,
+    std::uint64_t size) const -> std::span<const unsigned char>
 {
-  if (this->mData.size() < MIN_ELF_SIZE) {
+  const std::size_t file_size = std::size(this->mData);
+
+  if (offset > file_size || size > file_size - offset) {
+    throw PelfException{ "Invalid offset, out of the bounds of the file" };
+  }
+
+  using Value = std::remove_cv_t<typename Container::value_type>;
+  std::span<const unsigned char> bytes;
+
+  if constexpr (std::is_same_v<Value, unsigned char>) {
+    bytes = { std::data(this->mData), file_size };
+  } else {
+    bytes = { reinterpret_cast<const unsigned char*>(std::data(this->mData)),
+      file_size };
+  }
+
+  return bytes.subspan(static_cast<std::size_t>(offset),
+    static_cast<std::size_t>(size));
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::checkFileSize()
+    const -> void
+{
+  if (this->mData.size() < sizeof(typename Class::Ehdr)) {
     throw pelfInvalidSize{"Elf file it's too small", this->mData.size()};
   }
 
@@ -266,10 +989,13 @@ constexpr auto
 
 template<class Container,
   std::size_t NumOfSections,
-  std::size_t NumOfProgHeaders>
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
 constexpr auto
-  Elf<Container, NumOfSections, NumOfProgHeaders>::checkSignatures() const
-  -> void
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::checkSignatures()
+    const -> void
 {
 
   /* Read first 16 bytes to check magic numbers */
@@ -279,7 +1005,9 @@ constexpr auto
 
   const bool check = magic_numbers[0] == EI_MAG0 && magic_numbers[1] == EI_MAG1
          && magic_numbers[2] == EI_MAG2 && magic_numbers[3] == EI_MAG3
-         && magic_numbers[4] == EI_CLASS && magic_numbers[5] == EI_DATA;
+         && magic_numbers[EI_CLASS_OFFSET] == Class::ident
+         && magic_numbers[EI_DATA_OFFSET]
+              == (Endian == std::endian::big ? ELFDATA2MSB : ELFDATA2LSB);
 
   if (!check) {
     throw pelfInvalidSignature{"Invalid ELF magic numbers"};
@@ -290,14 +1018,25 @@ constexpr auto
 
 template<class Container,
   std::size_t NumOfSections,
-  std::size_t NumOfProgHeaders>
-constexpr auto Elf<Container, NumOfSections, NumOfProgHeaders>::parseHeaders()
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::parseHeaders()
   -> void
 {
 
   /* Read the elf header into mElfHeaders.elfHeader, the elf header is always at
    * offset 0 */
-  this->readHeader(mHeaders.elfHeader, 0);
+  this->template readHeader<Endian>(mHeaders.elfHeader, 0);
+
+  if constexpr (Endian == std::endian::big) {
+    /* e_ident is an array of bytes, its byte order doesn't depend on EI_DATA
+     * so it's swapped back to keep the same value for both encodings */
+    mHeaders.elfHeader.e_ident_high = byteSwap(mHeaders.elfHeader.e_ident_high);
+    mHeaders.elfHeader.e_ident_low = byteSwap(mHeaders.elfHeader.e_ident_low);
+  }
 
 
   // e_phoff can't be negative, unless it's an invalid file and an exception
@@ -307,31 +1046,35 @@ constexpr auto Elf<Container, NumOfSections, NumOfProgHeaders>::parseHeaders()
 
   /* Read the program header table */
 
-  if constexpr (std::is_same_v<decltype(mHeaders.programHeaders),
-                  std::vector<Elf64_Phdr>>) {
+  if constexpr (NumOfProgHeaders == 0) {
     /* Get number of entries in the program header table */
 
     /* This should be re-written it's pretty ugly */
     std::size_t program_header_table_size{};
     if (mHeaders.elfHeader.e_phnum >= PN_XNUM) {
-      program_header_table_size = getElfTablesSize(this->mData).programTable;
+      program_header_table_size =
+        getElfTablesSize<Class, Endian>(this->mData).programTable;
     } else {
       program_header_table_size = mHeaders.elfHeader.e_phnum;
     }
 
+    this->template checkTableSize<typename Class::Phdr>(
+      program_header_table_size, offset);
     mHeaders.programHeaders.resize(program_header_table_size);
   }
 
-  for (auto& header : mHeaders.programHeaders) {
-    offset = this->readHeader(header, offset);
-  }
+  this->template readTable<Endian>(mHeaders.programHeaders, offset);
 }
 
 
 template<class Container,
   std::size_t NumOfSections,
-  std::size_t NumOfProgHeaders>
-constexpr auto Elf<Container, NumOfSections, NumOfProgHeaders>::parseSections()
+  std::size_t NumOfProgHeaders,
+  class Class,
+  std::endian Endian,
+  class Allocator>
+constexpr auto
+  Elf<Container, NumOfSections, NumOfProgHeaders, Class, Endian, Allocator>::parseSections()
   -> void
 {
 
@@ -342,23 +1085,64 @@ constexpr auto Elf<Container, NumOfSections, NumOfProgHeaders>::parseSections()
     mHeaders.elfHeader.e_shoff);// section table offset
 
 
-  if constexpr (std::is_same_v<decltype(mSections), std::vector<Elf64_Shdr>>) {
+  if constexpr (NumOfSections == 0) {
     /* Get number of entries in the section table */
     std::size_t section_table_size{};
-    if (mHeaders.elfHeader.e_shnum >= SHN_LORESERVE) {
-      section_table_size = getElfTablesSize(this->mData).sectionTable;
+    if (mHeaders.elfHeader.e_shnum == 0) {
+      section_table_size =
+        getElfTablesSize<Class, Endian>(this->mData).sectionTable;
     } else {
       section_table_size = mHeaders.elfHeader.e_shnum;
     }
+    this->template checkTableSize<typename Class::Shdr>(
+      section_table_size, offset);
     mSections.resize(section_table_size);
   }
 
-  for (auto& header : mSections) {
-    offset = this->readHeader(header, offset);
-  }
+  this->template readTable<Endian>(mSections, offset);
 }
 
 
+/** @brief Elf class for 32-bit files
+ *
+ *  `open()` checks the file class once and returns either an `Elf` or an
+ *  `Elf32`, the parsing code is instantiated separately for each class
+ * */
+template<class Container,
+  std::size_t NumOfSections = 0,
+  std::size_t NumOfProgHeaders = 0,
+  std::endian Endian = std::endian::little,
+  class Allocator = std::allocator<std::byte>>
+using Elf32 = Elf<Container,
+  NumOfSections,
+  NumOfProgHeaders,
+  Elf32Class,
+  Endian,
+  Allocator>;
+
+
+namespace pmr {
+
+/** @brief Elf parsed at runtime whose tables are allocated from a
+ * `std::pmr::memory_resource`, e.g. a per-thread
+ * `std::pmr::monotonic_buffer_resource` that is released between files
+ *
+ *  @tparam Container The type of the container used to store the file content
+ *  @tparam Class File class (`Elf64Class` or `Elf32Class`)
+ *  @tparam Endian Byte order of the file
+ * */
+template<class Container,
+  class Class = Elf64Class,
+  std::endian Endian = std::endian::little>
+using Elf = pelf::Elf<Container,
+  0,
+  0,
+  Class,
+  Endian,
+  std::pmr::polymorphic_allocator<std::byte>>;
+
+}// namespace pmr
+
 }// namespace pelf
 
 
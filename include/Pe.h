@@ -13,11 +13,27 @@
 
 #include "peStructs.h"
 #include "Pelf.h"
+#include "peUnwind.h"
+#include "coff.h"
+#include "peResources.h"
+#include "peVersion.h"
+#include "peExports.h"
+#include "peImports.h"
+#include "peOrdinals.h"
+#include "peRich.h"
+#include "peDebug.h"
+#include "peLoadConfig.h"
+#include "peClr.h"
+#include "checksum.h"
 
 #include <algorithm>
 #include <cassert>
 #include <vector>
 #include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <type_traits>
 
 #include <boost/hana.hpp>
@@ -50,7 +66,7 @@ consteval auto getPeNumberOfSections(const Container& data) requires
   for (std::size_t i{}; i < sizeof(pe_header_address); ++i) {
     pe_header_address <<= 8;
     pe_header_address |= static_cast<std::uint32_t>(
-      data.at(sizeof(pe_header_address) - 1 + offset--));
+      readByte(data, sizeof(pe_header_address) - 1 + offset--));
   }
 
   /* Offset of the Number of Sections */
@@ -60,7 +76,7 @@ consteval auto getPeNumberOfSections(const Container& data) requires
 
   for (std::size_t i{}; i < sizeof(number_of_sections); ++i) {
     number_of_sections <<= 8;
-    number_of_sections |= data.at(sizeof(number_of_sections) - 1 + offset - i);
+    number_of_sections |= readByte(data, sizeof(number_of_sections) - 1 + offset - i);
   }
 
   return number_of_sections;
@@ -73,26 +89,40 @@ consteval auto getPeNumberOfSections(const Container& data) requires
  *  that needs to be parsed
  *  @tparam NumOfSections Number of Sections of the Pe File (Size of the section
  * table)
+ *  @tparam Class Image class, `Pe32PlusClass` (default) or `Pe32Class`, it
+ *  selects the layout of the optional header, see `pelf::Pe32`
+ *  @tparam Allocator Allocator used by the section table when it's a vector
+ *  (only when parsing at runtime), see `pelf::pmr::Pe`
  *
  * */
-template<class Container, std::size_t NumOfSections = 0>
-class Pe : public Pelf<Container, Pe<Container, NumOfSections>>
+template<class Container,
+  std::size_t NumOfSections = 0,
+  class Class = Pe32PlusClass,
+  class Allocator = std::allocator<std::byte>>
+class Pe
+  : public Pelf<Container, Pe<Container, NumOfSections, Class, Allocator>>
 {
 public:
+  using FileClass = Class; /**< `Pe32PlusClass` or `Pe32Class` */
+
   /** @brief Pe constructor
    *
    *  @param data data to be parsed
+   *  @param alloc allocator used by the section table (and by the copy of
+   *  `data` if `Container` is allocator aware)
    * */
-  constexpr explicit Pe(const Container& data);
+  constexpr explicit Pe(const Container& data,
+    const Allocator& alloc = Allocator{});
 
   /** @brief Returns a struct that contains all Pe headers
    *
-   *  @return Returns a struct `PeHeaders` that contains the coff header and
-   *    the optional header, which are represented by the hana
-   *    struct `IMAGE_FILE_HEADER` and the `OptionalHeader` struct
+   *  @return Returns a struct `BasicPeHeaders` that contains the coff header
+   *    and the optional header, which are represented by the hana
+   *    struct `IMAGE_FILE_HEADER` and the `BasicOptionalHeader` struct
    *
    * */
-  [[nodiscard]] constexpr auto getHeaders() const noexcept -> PeHeaders;
+  [[nodiscard]] constexpr auto getHeaders() const noexcept
+    -> BasicPeHeaders<Class>;
 
   /** @brief  Returns the section table from the Pe file
    *
@@ -101,15 +131,306 @@ public:
    *  `IMAGE_SECTION_HEADER`, on the other side, if parsing happens at runtime
    *  it returns a std::vector with all the sections.
    *
-   *  @return Returns either an array or a vector that represents the section
-   * table
+   *  @return Returns a reference to either an array or a vector that
+   * represents the section table
    *
    * */
   [[nodiscard]] constexpr auto getSections() const noexcept
-    -> Table<IMAGE_SECTION_HEADER, NumOfSections>;
+    -> const Table<IMAGE_SECTION_HEADER, NumOfSections, Allocator>&;
+
+  /** @brief Returns the allocator used by the section table
+   *
+   *  @return Allocator
+   * */
+  [[nodiscard]] constexpr auto getAllocator() const noexcept -> Allocator;
+
+  /**
+   * @brief Translates a relative virtual address to an offset of the file
+   *
+   * @param rva Relative virtual address
+   * @return Offset of the file, `std::nullopt` if `rva` isn't in the headers
+   * or in the raw data of a section (e.g. uninitialized data)
+   */
+  [[nodiscard]] constexpr auto rvaToOffset(DWORD rva) const
+    -> std::optional<std::uint64_t>;
+
+  /**
+   * @brief Returns the bytes of the file from `rva` to the end of the raw data
+   * of the section that contains it
+   *
+   * @param rva Relative virtual address
+   * @return Span over the data of the file, empty if `rva` isn't in the file
+   */
+  [[nodiscard]] constexpr auto getDataAtRva(DWORD rva) const
+    -> std::span<const unsigned char>;
+
+  /**
+   * @brief Returns the bytes of a data directory
+   *
+   * @param index IMAGE_DIRECTORY_ENTRY_*
+   * @return Span over the data of the file, empty if the image doesn't have
+   * the directory. It throws `PelfException` if the directory isn't in the
+   * file
+   */
+  [[nodiscard]] constexpr auto getDataDirectory(std::size_t index) const
+    -> std::span<const unsigned char>;
+
+  /**
+   * @brief Returns the exception directory (`.pdata`) of an x64 image
+   *
+   * @return ExceptionTable, empty if the image doesn't have one. It throws
+   * `PelfException` for other machines, their entries have other layouts
+   */
+  [[nodiscard]] constexpr auto getExceptionTable() const -> ExceptionTable;
+
+  /**
+   * @brief Returns the unwind info of an entry of the exception table
+   *
+   * @param function Entry of the exception table
+   * @return UnwindInfo, it throws `PelfException` if it isn't in the file
+   */
+  [[nodiscard]] constexpr auto getUnwindInfo(
+    const IMAGE_RUNTIME_FUNCTION_ENTRY& function) const -> UnwindInfo;
+
+  /**
+   * @brief Returns the COFF symbol table of the image (PointerToSymbolTable)
+   *
+   * Images rarely have one, MinGW and debug builds of some toolchains keep it
+   *
+   * @return CoffSymbolTable, empty if the image doesn't have one. It throws
+   * `PelfException` if the table exceeds the file
+   */
+  [[nodiscard]] auto getSymbolTable() const -> CoffSymbolTable;
+
+  /**
+   * @brief Returns the root of the resource tree (data directory 2)
+   *
+   * @return ResourceDirectory, empty if the image doesn't have resources. It
+   * throws `PelfException` if the root isn't in the data directory
+   */
+  [[nodiscard]] constexpr auto getResources() const -> ResourceDirectory;
+
+  /**
+   * @brief Finds a resource by type, name and language
+   *
+   * Each level of the tree is a binary search, the rest of the tree isn't
+   * read
+   *
+   * @param type RT_* or the name of the type
+   * @param name ID or name of the resource
+   * @param language Language ID, if it isn't given the first language of the
+   * resource is returned (the lowest ID, 0 is LANG_NEUTRAL)
+   * @return Resource, `std::nullopt` if the image doesn't have it. It throws
+   * `PelfException` if the tree or the data of the resource isn't in the file
+   */
+  [[nodiscard]] constexpr auto findResource(const ResourceId& type,
+    const ResourceId& name,
+    std::optional<WORD> language = std::nullopt) const
+    -> std::optional<Resource>;
+
+  /**
+   * @brief Returns the bytes of a leaf of the resource tree
+   *
+   * @param entry Data entry of the resource
+   * @return Span over the data of the file, it throws `PelfException` if the
+   * data isn't in the file
+   */
+  [[nodiscard]] constexpr auto getResourceData(
+    const IMAGE_RESOURCE_DATA_ENTRY& entry) const
+    -> std::span<const unsigned char>;
+
+  /**
+   * @brief Returns the version resource (RT_VERSION) of the image
+   *
+   * It goes straight to the first version resource and its first language,
+   * the strings are decoded when they're requested
+   *
+   * @return VersionInfo, `std::nullopt` if the image doesn't have one. It
+   * throws `PelfException` if the resource is malformed
+   */
+  [[nodiscard]] constexpr auto versionInfo() const
+    -> std::optional<VersionInfo>;
+
+  /**
+   * @brief Returns the export directory (data directory 0)
+   *
+   * @return ExportDirectory, empty if the image doesn't export anything. It
+   * throws `PelfException` if the directory isn't in the file. The image must
+   * outlive it
+   */
+  [[nodiscard]] auto getExports() const -> ExportDirectory<Pe>;
+
+  /**
+   * @brief Returns the import directory (data directory 1)
+   *
+   * @return ImportDirectory, empty if the image doesn't import anything. The
+   * image must outlive it
+   */
+  [[nodiscard]] auto getImports() const -> ImportDirectory<Pe>;
+
+  /**
+   * @brief Returns the delay import directory (data directory 13)
+   *
+   * @return DelayImportDirectory, empty if the image doesn't delay load any
+   * DLL. The image must outlive it
+   */
+  [[nodiscard]] auto getDelayImports() const -> DelayImportDirectory<Pe>;
+
+  /**
+   * @brief Returns the bound import directory (data directory 11), usually
+   * in the headers after the section table
+   *
+   * @return BoundImportDirectory, empty if the image isn't bound
+   */
+  [[nodiscard]] auto getBoundImports() const -> BoundImportDirectory;
+
+  /**
+   * @brief Computes the imphash of the image
+   *
+   * The MD5 of "dll.function" for every import, in order and separated by
+   * commas, in lower case and without the .dll, .ocx or .sys extension of the
+   * DLL (the same as pefile). Imports by ordinal of ws2_32.dll, wsock32.dll
+   * and oleaut32.dll are hashed by name (see `ordinalName()`), the other
+   * ones are "ord<number>". The names are hashed straight from the file, no
+   * string is built
+   *
+   * @return Digest, `std::nullopt` if the image doesn't import anything
+   */
+  [[nodiscard]] auto imphash() const -> std::optional<Md5Digest>;
+
+  /**
+   * @brief Returns the Rich header, between the DOS stub and the PE header
+   *
+   * @return RichHeader, `std::nullopt` if the image doesn't have one (it's
+   * only written by Microsoft linkers)
+   */
+  [[nodiscard]] constexpr auto richHeader() const
+    -> std::optional<RichHeader>;
+
+  /**
+   * @brief Returns the debug directory (data directory 6)
+   *
+   * @return DebugDirectory, empty if the image doesn't have one. It throws
+   * `PelfException` if the directory isn't in the file
+   */
+  [[nodiscard]] constexpr auto getDebugDirectory() const -> DebugDirectory;
+
+  /**
+   * @brief Returns the data of an entry of the debug directory
+   *
+   * The RVA is translated through the section table, `PointerToRawData` is
+   * used for data that isn't mapped (e.g. the COFF symbols of old images)
+   *
+   * @param entry Entry of the debug directory
+   * @return Span over the data of the file, empty if the entry doesn't have
+   * data. It throws `PelfException` if the data isn't in the file
+   */
+  [[nodiscard]] constexpr auto getDebugData(
+    const IMAGE_DEBUG_DIRECTORY& entry) const -> std::span<const unsigned char>;
+
+  /**
+   * @brief Returns the PDB of the image, from the RSDS record of the first
+   * CODEVIEW entry of the debug directory
+   *
+   * @return PdbInfo whose path is a view of the file, `std::nullopt` if the
+   * image doesn't reference a PDB 7.0
+   */
+  [[nodiscard]] auto codeView() const -> std::optional<PdbInfo>;
+
+  /**
+   * @brief Returns the bytes of the file from a virtual address to the end of
+   * the raw data of the section that contains it
+   *
+   * @param va Virtual address, e.g. a field of the load config directory
+   * @return Span over the data of the file, empty if `va` isn't in the file
+   */
+  [[nodiscard]] constexpr auto getDataAtVa(typename Class::Address va) const
+    -> std::span<const unsigned char>;
+
+  /**
+   * @brief Returns the load config directory (data directory 10)
+   *
+   * The size of the directory is its `Size` field, the fields of newer
+   * versions of the structure are 0
+   *
+   * @return Directory, `std::nullopt` if the image doesn't have one. It
+   * throws `PelfException` if the directory isn't in the file
+   */
+  [[nodiscard]] constexpr auto loadConfig() const
+    -> std::optional<typename Class::LoadConfigDirectory>;
+
+  /**
+   * @brief Returns the CFG function table of a /guard:cf image, the RVAs of
+   * the valid targets of indirect calls
+   *
+   * @return RvaTable, empty if the image doesn't have one. It throws
+   * `PelfException` if the table isn't in the file
+   */
+  [[nodiscard]] constexpr auto guardFunctions() const -> RvaTable;
+
+  /**
+   * @brief Returns the RVAs of the valid targets of longjmp of a /guard:cf
+   * image
+   */
+  [[nodiscard]] constexpr auto guardLongJumpTargets() const -> RvaTable;
+
+  /**
+   * @brief Returns the RVAs of the IAT entries whose address is taken
+   */
+  [[nodiscard]] constexpr auto guardAddressTakenIatEntries() const
+    -> RvaTable;
+
+  /**
+   * @brief Returns the SafeSEH handler table of an x86 image, the RVAs of
+   * the valid exception handlers
+   */
+  [[nodiscard]] constexpr auto safeSehHandlers() const -> RvaTable;
+
+  /**
+   * @brief Returns `true` if `rva` is a valid target of indirect calls, it's
+   * in the CFG function table and it isn't suppressed
+   *
+   * The load config is decoded by every call, `guardFunctions()` is faster
+   * to check many RVAs
+   */
+  [[nodiscard]] constexpr auto isGuardCallTarget(DWORD rva) const -> bool;
+
+  /**
+   * @brief Returns the TLS directory (data directory 9)
+   *
+   * @return Directory, `std::nullopt` if the image doesn't have one. It
+   * throws `PelfException` if the directory isn't in the file
+   */
+  [[nodiscard]] constexpr auto tlsDirectory() const
+    -> std::optional<typename Class::TlsDirectory>;
+
+  /**
+   * @brief Returns the virtual addresses of the TLS callbacks, they're
+   * called before the entry point
+   */
+  [[nodiscard]] constexpr auto tlsCallbacks() const
+    -> TlsCallbacks<typename Class::Address>;
+
+  /**
+   * @brief Returns the CLI header of a .NET assembly (data directory 14)
+   *
+   * @return Header, `std::nullopt` if the image isn't a .NET assembly. It
+   * throws `PelfException` if the header isn't in the file
+   */
+  [[nodiscard]] constexpr auto clrHeader() const
+    -> std::optional<IMAGE_COR20_HEADER>;
+
+  /**
+   * @brief Returns the metadata of a .NET assembly
+   *
+   * @return ClrMetadata whose streams are views of the file, `std::nullopt`
+   * if the image isn't a .NET assembly. It throws `PelfException` if the
+   * metadata isn't in the file or isn't valid
+   */
+  [[nodiscard]] auto clrMetadata() const -> std::optional<ClrMetadata>;
 
 private:
-  friend class Pelf<Container, Pe<Container, NumOfSections>>;
+  friend class Pelf<Container, Pe<Container, NumOfSections, Class, Allocator>>;
 
 
   /* Variables */
@@ -123,18 +444,28 @@ private:
     97
   }; /**< Minimum possible PE file size */
 
+  Allocator mAllocator; /**< Allocator used by the section table */
+
   std::uint32_t mPeHeaderAddress{}; /**< 32 bit value that represents the start
                                        address of the coff header */
 
-  PeHeaders mHeaders; /**< Struct that contains all Pe headers, more precisely
+  BasicPeHeaders<Class>
+    mHeaders; /**< Struct that contains all Pe headers, more precisely
                            it contains the coff header (`IMAGE_FILE_HEADER`)
                            and the optional header (`OptionalHeader`)*/
 
-  Table<IMAGE_SECTION_HEADER, NumOfSections>
-    mSections = {}; /**< Container that represents the section table */
+  Table<IMAGE_SECTION_HEADER, NumOfSections, Allocator>
+    mSections; /**< Container that represents the section table */
 
   /* Private member functions */
 
+  /** @brief Returns a table of `count` entries of `stride` bytes at `va`,
+   * it throws `PelfException` if it isn't in the file */
+  constexpr auto getRvaTable(typename Class::Address va,
+    typename Class::Address count,
+    std::size_t stride) const -> RvaTable;
+
+
 
   /** @brief  Checks if MZ DOS signature and PE signature are valid,
    * if any signature is invalid then an exception is thrown
@@ -197,11 +528,26 @@ private:
    * @return Returns the Pe Header Address
    */
   constexpr auto readPeHeaderAddress() const -> std::uint32_t;
+
+  /**
+   * @brief Returns the bytes of the file from `offset` to `offset + size`
+   *
+   * @return Returns a span over `mData`, it throws `PelfException` if the
+   * range is outside of the file
+   */
+  constexpr auto getBytes(std::uint64_t offset, std::uint64_t size) const
+    -> std::span<const unsigned char>;
 };
 
 
-template<class Container, std::size_t NumOfSections>
-constexpr auto Pe<Container, NumOfSections>::readPeHeaderAddress() const -> std::uint32_t {
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::readPeHeaderAddress()
+    const -> std::uint32_t
+{
   
   /* Should differentiate between runtime and compile time algorithm */
   std::size_t offset{ 0x3c };
@@ -209,15 +555,23 @@ constexpr auto Pe<Container, NumOfSections>::readPeHeaderAddress() const -> std:
   for (std::size_t i{}; i < sizeof(address); ++i) {
     address <<= 8;
     address |= static_cast<std::uint32_t>(
-      this->mData.at(sizeof(address) - 1 + offset--));
+      readByte(this->mData, sizeof(address) - 1 + offset--));
   }
 
   return address;
 }
 
-template<class Container, std::size_t NumOfSections>
-constexpr Pe<Container, NumOfSections>::Pe(const Container& data)
-  : Pelf<Container, Pe<Container, NumOfSections>>(data)
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr Pe<Container, NumOfSections, Class, Allocator>::Pe(
+  const Container& data,
+  const Allocator& alloc)
+  : Pelf<Container, Pe<Container, NumOfSections, Class, Allocator>>(data,
+    alloc),
+    mAllocator(alloc),
+    mSections(makeTable<decltype(mSections)>(alloc))
 {
 
   checkFileSize();
@@ -230,16 +584,26 @@ constexpr Pe<Container, NumOfSections>::Pe(const Container& data)
   this->parse();
 }
 
-template<class Container, std::size_t NumOfSections>
-constexpr auto Pe<Container, NumOfSections>::checkMZDSignature() const -> bool
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::checkMZDSignature()
+    const -> bool
 {
 
   return (this->mData[0] == (mMZDSignature >> 8)
           && this->mData[1] == (mMZDSignature & 0xFF));
 }
 
-template<class Container, std::size_t NumOfSections>
-constexpr auto Pe<Container, NumOfSections>::checkPESignature() const -> bool
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::checkPESignature()
+    const -> bool
 {
   /* Read PE Signature from offset mPeHeaderAddress*/
   std::uint32_t pe_signature{};
@@ -248,7 +612,7 @@ constexpr auto Pe<Container, NumOfSections>::checkPESignature() const -> bool
   /* mPeSignature is set as 0x5045000, so no need to read the value backwards */
   for (std::size_t i{}; i < sizeof(pe_signature); ++i) {
     pe_signature <<= 8;
-    pe_signature |= this->mData.at(offset++);
+    pe_signature |= readByte(this->mData, offset++);
   }
 
 
@@ -256,8 +620,13 @@ constexpr auto Pe<Container, NumOfSections>::checkPESignature() const -> bool
 }
 
 
-template<class Container, std::size_t NumOfSections>
-constexpr auto Pe<Container, NumOfSections>::checkSignatures() const -> void
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::checkSignatures()
+    const -> void
 {
   if (!checkMZDSignature()) {
     throw pelfInvalidSignature{ "Invalid MZ DOS Signature" };
@@ -268,8 +637,12 @@ constexpr auto Pe<Container, NumOfSections>::checkSignatures() const -> void
   }
 }
 
-template<class Container, std::size_t NumOfSections>
-constexpr auto Pe<Container, NumOfSections>::checkFileSize() const -> void
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::checkFileSize() const -> void
 {
   if (this->mData.size() < mMinPeSize) {
     throw pelfInvalidSize{ "Pe file it's too small", this->mData.size() };
@@ -277,66 +650,802 @@ constexpr auto Pe<Container, NumOfSections>::checkFileSize() const -> void
 }
 
 
-template<class Container, std::size_t NumOfSections>
-constexpr auto Pe<Container, NumOfSections>::getSectionTableOffset() const
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getSectionTableOffset() const
   -> std::ptrdiff_t
 {
-  return mPeHeaderAddress + sizeof(mHeaders.mCoffHeader)
-         + sizeof(mHeaders.mOptionalHeader.mDataDirectories)
-             * IMAGE_NUMBER_OF_DIRECTORY_ENTRIES
-         + sizeof(mHeaders.mOptionalHeader.mWsf)
-         + sizeof(mHeaders.mOptionalHeader.mScf);
+  /* The section table follows the PE signature, the coff header and the
+   * optional header, whose size is stored in the coff header */
+  return mPeHeaderAddress + sizeof(DWORD) + sizeof(mHeaders.mCoffHeader)
+         + mHeaders.mCoffHeader.SizeOfOptionalHeader;
 }
 
-template<class Container, std::size_t NumOfSections>
-constexpr auto Pe<Container, NumOfSections>::parseHeaders() -> void
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::parseHeaders() -> void
 {
 
   std::ptrdiff_t offset = mPeHeaderAddress + 4;
 
   offset = this->readHeader(mHeaders.mCoffHeader, offset);
   offset = this->readHeader(mHeaders.mOptionalHeader.mScf, offset);
+
+  /* The layout of the rest of the optional header depends on the image class */
+  if (mHeaders.mOptionalHeader.mScf.Magic != Class::magic) {
+    throw pelfInvalidSignature{ "Invalid optional header magic" };
+  }
+
   offset = this->readHeader(mHeaders.mOptionalHeader.mWsf, offset);
 
-  for (auto& data_dir : mHeaders.mOptionalHeader.mDataDirectories) {
-    offset = this->readHeader(data_dir, offset);
+  /* Data directories that are not present in the file are left empty */
+  const std::size_t number_of_directories =
+    std::min<std::size_t>(mHeaders.mOptionalHeader.mWsf.NumberOfRvaAndSizes,
+      IMAGE_NUMBER_OF_DIRECTORY_ENTRIES);
+
+  for (std::size_t i{}; i < number_of_directories; ++i) {
+    offset =
+      this->readHeader(mHeaders.mOptionalHeader.mDataDirectories[i], offset);
   }
 }
 
 
-template<class Container, std::size_t NumOfSections>
-constexpr auto Pe<Container, NumOfSections>::getHeaders() const noexcept
-  -> PeHeaders
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getHeaders() const noexcept
+  -> BasicPeHeaders<Class>
 {
   return mHeaders;
 }
 
 
-template<class Container, std::size_t NumOfSections>
-constexpr auto Pe<Container, NumOfSections>::parseSections() -> void
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::parseSections() -> void
 {
 
   /* Compute section table offset */
   std::ptrdiff_t offset = getSectionTableOffset();
 
-  if constexpr (std::is_same_v<decltype(mSections),
-                  std::vector<IMAGE_SECTION_HEADER>>) {
+  if constexpr (NumOfSections == 0) {
     mSections.resize(mHeaders.mCoffHeader.NumberOfSections);
   }
 
-  for (auto& section : mSections) {
-    offset = this->readHeader(section, offset);
-  }
+  this->readTable(mSections, offset);
 }
 
 
-template<class Container, std::size_t NumOfSections>
-constexpr auto Pe<Container, NumOfSections>::getSections() const noexcept
-  -> Table<IMAGE_SECTION_HEADER, NumOfSections>
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getSections() const noexcept
+  -> const Table<IMAGE_SECTION_HEADER, NumOfSections, Allocator>&
 {
   return mSections;
 }
 
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getAllocator() const
+  noexcept -> Allocator
+{
+  return mAllocator;
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::rvaToOffset(DWORD rva)
+    const -> std::optional<std::uint64_t>
+{
+  if (rva < mHeaders.mOptionalHeader.mWsf.SizeOfHeaders) { return rva; }
+
+  for (const auto& section : mSections) {
+    /* The raw data is padded to FileAlignment, the virtual size is exact */
+    const std::uint64_t size = section.PhysAddressAndVirtSize == 0
+                                 ? section.SizeOfRawData
+                                 : std::min(section.SizeOfRawData,
+                                   section.PhysAddressAndVirtSize);
+
+    if (rva >= section.VirtualAddress && rva - section.VirtualAddress < size) {
+      return std::uint64_t{ section.PointerToRawData } + (rva - section.VirtualAddress);
+    }
+  }
+
+  return std::nullopt;
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getDataAtRva(DWORD rva)
+    const -> std::span<const unsigned char>
+{
+  const DWORD size_of_headers = mHeaders.mOptionalHeader.mWsf.SizeOfHeaders;
+  if (rva < size_of_headers) {
+    const std::uint64_t end =
+      std::min<std::uint64_t>(size_of_headers, std::size(this->mData));
+    if (rva >= end) { return {}; }
+
+    return getBytes(rva, end - rva);
+  }
+
+  for (const auto& section : mSections) {
+    const std::uint64_t size = section.PhysAddressAndVirtSize == 0
+                                 ? section.SizeOfRawData
+                                 : std::min(section.SizeOfRawData,
+                                   section.PhysAddressAndVirtSize);
+
+    if (rva >= section.VirtualAddress && rva - section.VirtualAddress < size) {
+      const std::uint64_t offset = rva - section.VirtualAddress;
+      return getBytes(section.PointerToRawData + offset, size - offset);
+    }
+  }
+
+  return {};
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getDataDirectory(
+    std::size_t index) const -> std::span<const unsigned char>
+{
+  if (index >= IMAGE_NUMBER_OF_DIRECTORY_ENTRIES) {
+    throw PelfException{ "Invalid data directory index" };
+  }
+
+  const auto directory = mHeaders.mOptionalHeader.mDataDirectories[index];
+  if (directory.VirtualAddress == 0 || directory.Size == 0) { return {}; }
+
+  /* The certificate table isn't mapped, its address is a file offset */
+  if (index == IMAGE_DIRECTORY_ENTRY_SECURITY) {
+    return getBytes(directory.VirtualAddress, directory.Size);
+  }
+
+  const auto data = getDataAtRva(directory.VirtualAddress);
+  if (data.size() < directory.Size) {
+    throw PelfException{ "Invalid data directory, it isn't in the file" };
+  }
+
+  return data.first(directory.Size);
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getExceptionTable() const
+  -> ExceptionTable
+{
+  const auto data = getDataDirectory(IMAGE_DIRECTORY_ENTRY_EXCEPTION);
+
+  if (!data.empty()
+      && mHeaders.mCoffHeader.Machine != IMAGE_FILE_MACHINE_AMD64) {
+    throw PelfException{
+      "Unsupported exception directory, only x64 images are supported"
+    };
+  }
+
+  return ExceptionTable{ data };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getUnwindInfo(
+    const IMAGE_RUNTIME_FUNCTION_ENTRY& function) const -> UnwindInfo
+{
+  return decodeUnwindInfo(getDataAtRva(function.UnwindInfoAddress));
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+auto Pe<Container, NumOfSections, Class, Allocator>::getSymbolTable() const
+  -> CoffSymbolTable
+{
+  const auto& coff_header = mHeaders.mCoffHeader;
+
+  return makeCoffSymbolTable(getBytes(0, std::size(this->mData)),
+    coff_header.PointerToSymbolTable,
+    coff_header.NumberOfSymbols);
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getResources() const
+  -> ResourceDirectory
+{
+  const auto data = getDataDirectory(IMAGE_DIRECTORY_ENTRY_RESOURCE);
+  if (data.empty()) { return {}; }
+
+  return ResourceDirectory{ data, 0 };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::findResource(
+    const ResourceId& type,
+    const ResourceId& name,
+    std::optional<WORD> language) const -> std::optional<Resource>
+{
+  const auto types = getResources();
+
+  const auto type_entry = types.find(type);
+  if (!type_entry || !type_entry->isDirectory()) { return std::nullopt; }
+
+  const auto name_entry = type_entry->directory().find(name);
+  if (!name_entry || !name_entry->isDirectory()) { return std::nullopt; }
+
+  const auto languages = name_entry->directory();
+  std::optional<ResourceEntry> leaf;
+  if (language) {
+    leaf = languages.find(*language);
+  } else if (!languages.empty()) {
+    leaf = languages.entry(0);
+  }
+  if (!leaf || leaf->isDirectory()) { return std::nullopt; }
+
+  const auto entry = leaf->dataEntry();
+  return Resource{ leaf->id(), entry, getResourceData(entry) };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getResourceData(
+    const IMAGE_RESOURCE_DATA_ENTRY& entry) const
+    -> std::span<const unsigned char>
+{
+  const auto data = getDataAtRva(entry.OffsetToData);
+  if (data.size() < entry.Size) {
+    throw PelfException{ "Invalid resource, its data isn't in the file" };
+  }
+
+  return data.first(entry.Size);
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::versionInfo() const
+  -> std::optional<VersionInfo>
+{
+  /* The name is VS_VERSION_INFO (1) in practice, any name is accepted */
+  const auto type = getResources().find(RT_VERSION);
+  if (!type || !type->isDirectory()) { return std::nullopt; }
+
+  const auto names = type->directory();
+  if (names.empty() || !names.entry(0).isDirectory()) { return std::nullopt; }
+
+  const auto languages = names.entry(0).directory();
+  if (languages.empty() || languages.entry(0).isDirectory()) {
+    return std::nullopt;
+  }
+
+  return VersionInfo{ getResourceData(languages.entry(0).dataEntry()) };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+auto Pe<Container, NumOfSections, Class, Allocator>::getExports() const
+  -> ExportDirectory<Pe>
+{
+  /* Size is needed, the forwarders are the addresses inside the directory */
+  return { *this,
+    getDataDirectory(IMAGE_DIRECTORY_ENTRY_EXPORT),
+    mHeaders.mOptionalHeader.mDataDirectories[IMAGE_DIRECTORY_ENTRY_EXPORT]
+      .VirtualAddress };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+auto Pe<Container, NumOfSections, Class, Allocator>::getImports() const
+  -> ImportDirectory<Pe>
+{
+  /* Size isn't reliable, the table ends at a zero descriptor */
+  const auto& directory =
+    mHeaders.mOptionalHeader.mDataDirectories[IMAGE_DIRECTORY_ENTRY_IMPORT];
+  if (directory.VirtualAddress == 0) { return { *this, {} }; }
+
+  return { *this, getDataAtRva(directory.VirtualAddress) };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+auto Pe<Container, NumOfSections, Class, Allocator>::getDelayImports() const
+  -> DelayImportDirectory<Pe>
+{
+  /* Like the import directory the table ends at a zero descriptor */
+  const auto& directory =
+    mHeaders.mOptionalHeader
+      .mDataDirectories[IMAGE_DIRECTORY_ENTRY_DELAY_IMPORT];
+  const auto image_base = mHeaders.mOptionalHeader.mWsf.ImageBase;
+  if (directory.VirtualAddress == 0) { return { *this, {}, image_base }; }
+
+  return { *this, getDataAtRva(directory.VirtualAddress), image_base };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+auto Pe<Container, NumOfSections, Class, Allocator>::getBoundImports() const
+  -> BoundImportDirectory
+{
+  /* The names follow the descriptors, they may be past Size */
+  const auto& directory =
+    mHeaders.mOptionalHeader
+      .mDataDirectories[IMAGE_DIRECTORY_ENTRY_BOUND_IMPORT];
+  if (directory.VirtualAddress == 0) { return {}; }
+
+  return BoundImportDirectory{ getDataAtRva(directory.VirtualAddress) };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+auto Pe<Container, NumOfSections, Class, Allocator>::imphash() const
+  -> std::optional<Md5Digest>
+{
+  const auto imports = getImports();
+  if (imports.empty()) { return std::nullopt; }
+
+  Md5 hash;
+  const auto update_lower = [&hash](std::string_view text) {
+    for (const char c : text) {
+      hash.update(static_cast<unsigned char>(
+        c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c));
+    }
+  };
+
+  bool first{ true };
+  for (const auto& imported : imports) {
+    std::string_view dll = imported.name();
+    if (const auto dot = dll.rfind('.'); dot != std::string_view::npos) {
+      const auto extension = dll.substr(dot + 1);
+      if (detail::equalsIgnoreCase(extension, "dll")
+          || detail::equalsIgnoreCase(extension, "ocx")
+          || detail::equalsIgnoreCase(extension, "sys")) {
+        dll = dll.substr(0, dot);
+      }
+    }
+
+    for (const auto& function : imported.functions()) {
+      if (!first) { hash.update(static_cast<unsigned char>(',')); }
+      first = false;
+
+      update_lower(dll);
+      hash.update(static_cast<unsigned char>('.'));
+
+      if (!function.ordinal) {
+        update_lower(function.name);
+        continue;
+      }
+
+      /* pefile looks the ordinal up with the full name of the DLL */
+      if (const auto name = ordinalName(imported.name(), *function.ordinal)) {
+        update_lower(*name);
+        continue;
+      }
+
+      /* "ord" and the decimal ordinal */
+      std::array<char, 5> digits{};
+      std::size_t count{};
+      for (WORD value = *function.ordinal; count == 0 || value != 0;
+           value /= 10) {
+        digits[count++] = static_cast<char>('0' + value % 10);
+      }
+      hash.update(std::string_view{ "ord" });
+      while (count != 0) {
+        hash.update(static_cast<unsigned char>(digits[--count]));
+      }
+    }
+  }
+
+  return hash.finish();
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::richHeader() const
+  -> std::optional<RichHeader>
+{
+  return RichHeader::find(getBytes(0, mPeHeaderAddress));
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getDebugDirectory() const
+  -> DebugDirectory
+{
+  return DebugDirectory{ getDataDirectory(IMAGE_DIRECTORY_ENTRY_DEBUG) };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getDebugData(
+    const IMAGE_DEBUG_DIRECTORY& entry) const -> std::span<const unsigned char>
+{
+  if (entry.SizeOfData == 0) { return {}; }
+
+  if (entry.AddressOfRawData != 0) {
+    const auto data = getDataAtRva(entry.AddressOfRawData);
+    if (data.size() >= entry.SizeOfData) {
+      return data.first(entry.SizeOfData);
+    }
+  }
+
+  if (entry.PointerToRawData == 0) {
+    throw PelfException{ "Invalid debug directory entry, its data isn't in the "
+                         "file" };
+  }
+
+  return getBytes(entry.PointerToRawData, entry.SizeOfData);
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+auto Pe<Container, NumOfSections, Class, Allocator>::codeView() const
+  -> std::optional<PdbInfo>
+{
+  const auto entry = getDebugDirectory().find(IMAGE_DEBUG_TYPE_CODEVIEW);
+  if (!entry) { return std::nullopt; }
+
+  return decodeCodeView(getDebugData(*entry));
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getDataAtVa(
+    typename Class::Address va) const -> std::span<const unsigned char>
+{
+  const auto image_base = mHeaders.mOptionalHeader.mWsf.ImageBase;
+  if (va < image_base || va - image_base > 0xffffffff) { return {}; }
+
+  return getDataAtRva(static_cast<DWORD>(va - image_base));
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::loadConfig() const
+  -> std::optional<typename Class::LoadConfigDirectory>
+{
+  using Directory = typename Class::LoadConfigDirectory;
+
+  const auto directory =
+    mHeaders.mOptionalHeader
+      .mDataDirectories[IMAGE_DIRECTORY_ENTRY_LOAD_CONFIG];
+  if (directory.VirtualAddress == 0 || directory.Size == 0) {
+    return std::nullopt;
+  }
+
+  const auto data = getDataAtRva(directory.VirtualAddress);
+  if (data.size() < 4) {
+    throw PelfException{ "Invalid load config directory, it isn't in the "
+                         "file" };
+  }
+
+  /* The Size field is the size of the structure, not the size of the data
+   * directory (old x86 linkers wrote 0x40 there). The missing fields of
+   * older versions are 0 */
+  const std::size_t size = std::min<std::size_t>(
+    { readInteger<DWORD>(data, 0), data.size(), sizeof(Directory) });
+  std::array<unsigned char, sizeof(Directory)> bytes{};
+  std::copy_n(data.begin(), size, bytes.begin());
+
+  return readStruct<Directory>(bytes, 0);
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getRvaTable(
+    typename Class::Address va,
+    typename Class::Address count,
+    std::size_t stride) const -> RvaTable
+{
+  if (va == 0 || count == 0) { return {}; }
+
+  const auto data = getDataAtVa(va);
+  if (count > data.size() / stride) {
+    throw PelfException{ "Invalid load config directory, a table isn't in "
+                         "the file" };
+  }
+
+  return RvaTable{ data.first(static_cast<std::size_t>(count) * stride),
+    stride };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::guardFunctions() const
+  -> RvaTable
+{
+  const auto config = loadConfig();
+  if (!config) { return {}; }
+
+  return getRvaTable(config->GuardCFFunctionTable,
+    config->GuardCFFunctionCount,
+    guardTableStride(config->GuardFlags));
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::guardLongJumpTargets() const
+  -> RvaTable
+{
+  const auto config = loadConfig();
+  if (!config) { return {}; }
+
+  return getRvaTable(config->GuardLongJumpTargetTable,
+    config->GuardLongJumpTargetCount,
+    guardTableStride(config->GuardFlags));
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::guardAddressTakenIatEntries()
+    const -> RvaTable
+{
+  const auto config = loadConfig();
+  if (!config) { return {}; }
+
+  return getRvaTable(config->GuardAddressTakenIatEntryTable,
+    config->GuardAddressTakenIatEntryCount,
+    guardTableStride(config->GuardFlags));
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::safeSehHandlers() const
+  -> RvaTable
+{
+  const auto config = loadConfig();
+  if (!config) { return {}; }
+
+  /* The handler table doesn't have flags */
+  return getRvaTable(config->SEHandlerTable, config->SEHandlerCount, 4);
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::isGuardCallTarget(
+    DWORD rva) const -> bool
+{
+  const auto entry = guardFunctions().find(rva);
+  return entry && (entry->flags & IMAGE_GUARD_FLAG_FID_SUPPRESSED) == 0;
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::tlsDirectory() const
+  -> std::optional<typename Class::TlsDirectory>
+{
+  const auto data = getDataDirectory(IMAGE_DIRECTORY_ENTRY_TLS);
+  if (data.empty()) { return std::nullopt; }
+
+  return readStruct<typename Class::TlsDirectory>(data, 0);
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::tlsCallbacks() const
+  -> TlsCallbacks<typename Class::Address>
+{
+  const auto directory = tlsDirectory();
+  if (!directory || directory->AddressOfCallBacks == 0) { return {}; }
+
+  return TlsCallbacks<typename Class::Address>{ getDataAtVa(
+    directory->AddressOfCallBacks) };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::clrHeader() const
+  -> std::optional<IMAGE_COR20_HEADER>
+{
+  const auto data = getDataDirectory(IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR);
+  if (data.empty()) { return std::nullopt; }
+
+  return readStruct<IMAGE_COR20_HEADER>(data, 0);
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+auto Pe<Container, NumOfSections, Class, Allocator>::clrMetadata() const
+  -> std::optional<ClrMetadata>
+{
+  const auto header = clrHeader();
+  if (!header) { return std::nullopt; }
+
+  const auto data = getDataAtRva(header->MetaDataVirtualAddress);
+  if (header->MetaDataVirtualAddress == 0
+      || data.size() < header->MetaDataSize) {
+    throw PelfException{ "Invalid CLI header, the metadata isn't in the "
+                         "file" };
+  }
+
+  return ClrMetadata{ data.first(header->MetaDataSize) };
+}
+
+
+template<class Container,
+  std::size_t NumOfSections,
+  class Class,
+  class Allocator>
+constexpr auto
+  Pe<Container, NumOfSections, Class, Allocator>::getBytes(
+    std::uint64_t offset,
+    std::uint64_t size) const -> std::span<const unsigned char>
+{
+  const std::size_t file_size = std::size(this->mData);
+
+  if (offset > file_size || size > file_size - offset) {
+    throw PelfException{ "Invalid offset, out of the bounds of the file" };
+  }
+
+  using Value = std::remove_cv_t<typename Container::value_type>;
+  std::span<const unsigned char> bytes;
+
+  if constexpr (std::is_same_v<Value, unsigned char>) {
+    bytes = { std::data(this->mData), file_size };
+  } else {
+    bytes = { reinterpret_cast<const unsigned char*>(std::data(this->mData)),
+      file_size };
+  }
+
+  return bytes.subspan(static_cast<std::size_t>(offset),
+    static_cast<std::size_t>(size));
+}
+
+
+/** @brief Pe class for PE32 (32-bit) files
+ *
+ *  `open()` checks the optional header magic once and returns either a `Pe`
+ *  or a `Pe32`, the parsing code is instantiated separately for each class
+ * */
+template<class Container,
+  std::size_t NumOfSections = 0,
+  class Allocator = std::allocator<std::byte>>
+using Pe32 = Pe<Container, NumOfSections, Pe32Class, Allocator>;
+
+
+namespace pmr {
+
+/** @brief Pe parsed at runtime whose section table is allocated from a
+ * `std::pmr::memory_resource`
+ *
+ *  @tparam Container The type of the container used to store the file content
+ *  @tparam Class Image class (`Pe32PlusClass` or `Pe32Class`)
+ * */
+template<class Container, class Class = Pe32PlusClass>
+using Pe =
+  pelf::Pe<Container, 0, Class, std::pmr::polymorphic_allocator<std::byte>>;
+
+}// namespace pmr
+
 }// namespace pelf
 
 #endif
@@ -17,6 +17,11 @@
 #include "pelfExcept.h"
 #include <peStructs.h>
 #include <cassert>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 #include <boost/hana.hpp>
 
@@ -24,19 +29,164 @@ namespace pelf {
 
 namespace hana = boost::hana;
 
-/** @brief Metafunction that returns an array if `Num` is
- *  zero, and a vector otherwise
+/** @brief Metafunction that returns a vector if `Num` is
+ *  zero, and an array otherwise
  *
  *  @tparam Num Number of sections that table contains
  *  @tparam Struct Type of the elements the the array or vector contains
+ *  @tparam Allocator Allocator used by the vector, it's rebound to `Struct`
  *
  *  */
-template<class Struct, std::size_t Num>
+template<class Struct,
+  std::size_t Num,
+  class Allocator = std::allocator<Struct>>
 using Table = std::conditional_t<Num == 0,
-  std::vector<Struct>,
+  std::vector<Struct,
+    typename std::allocator_traits<Allocator>::template rebind_alloc<Struct>>,
   std::array<Struct, Num>>;
 
 
+/** @brief Returns an empty table, if the table is a vector it uses `alloc`
+ *
+ *  @tparam TableType Type returned by the `Table` metafunction
+ *  @param alloc Allocator used by the vector
+ *
+ *  @return Empty vector or value initialized array
+ *  */
+template<class TableType, class Allocator>
+constexpr auto makeTable(const Allocator& alloc) -> TableType
+{
+  if constexpr (requires { typename TableType::allocator_type; }) {
+    return TableType(typename TableType::allocator_type(alloc));
+  } else {
+    return TableType{};
+  }
+}
+
+
+/** @brief Returns the byte of `data` at `index`
+ *
+ *  Unlike `at()` it's available for every container with `size()` and
+ *  `operator[]`, e.g. `std::span` over a memory mapped file
+ *
+ *  @param data Bytes of the file
+ *  @param index Index of the byte
+ *
+ *  @return Returns the byte, it throws `PelfException` if `index` is out of
+ *  range
+ *  */
+template<class Container>
+constexpr auto readByte(const Container& data, std::size_t index)
+  -> unsigned char
+{
+  if (index >= std::size(data)) {
+    throw PelfException{ "Invalid offset, out of the bounds of the file" };
+  }
+
+  return static_cast<unsigned char>(data[index]);
+}
+
+
+/** @brief Reads an unsigned integer of type `T` from `data` at `offset`
+ *
+ *  @tparam T Unsigned integer type
+ *  @tparam Endian Byte order of the integer
+ *  @param data Bytes of the file
+ *  @param offset Offset of the first byte of the integer
+ *
+ *  @return Returns the integer, it throws `PelfException` if it's out of range
+ *  */
+template<class T, std::endian Endian = std::endian::little, class Container>
+constexpr auto readInteger(const Container& data, std::size_t offset) -> T
+{
+  if (offset > std::size(data) || sizeof(T) > std::size(data) - offset) {
+    throw PelfException{ "Invalid offset, out of the bounds of the file" };
+  }
+
+  T value{};
+
+  for (std::size_t i{}; i < sizeof(T); ++i) {
+    if constexpr (sizeof(T) > 1) { value = static_cast<T>(value << 8); }
+    /* Most significant byte first, it's the last one in little endian */
+    const std::size_t index =
+      Endian == std::endian::little ? offset + sizeof(T) - 1 - i : offset + i;
+    value = static_cast<T>(value | static_cast<unsigned char>(data[index]));
+  }
+
+  return value;
+}
+
+
+/** @brief Reads a hana struct from `data` at `offset`, member by member
+ *
+ *  Unlike `Pelf::readHeader()` it doesn't need a `Pelf` object, it's used for
+ *  structs found inside sections (e.g. compression headers)
+ *
+ *  @tparam Struct hana struct whose members are unsigned integers
+ *  @tparam Endian Byte order of the struct
+ *  @param data Bytes of the file
+ *  @param offset Offset of the struct
+ *
+ *  @return Returns the struct, it throws `PelfException` if it's out of range
+ *  */
+template<class Struct, std::endian Endian = std::endian::little, class Container>
+constexpr auto readStruct(const Container& data, std::size_t offset) -> Struct
+{
+  Struct s{};
+
+  hana::for_each(hana::keys(s), [&](auto key) {
+    auto& member = hana::at_key(s, key);
+    using Member = std::remove_reference_t<decltype(member)>;
+    member = readInteger<Member, Endian>(data, offset);
+    offset += sizeof(member);
+  });
+
+  return s;
+}
+
+
+/** @brief Reverses the bytes of `value`
+ *
+ *  Same as C++23 `std::byteswap`, it can be used in constant expressions
+ *
+ *  @tparam T Unsigned integer type
+ *  @param value Value to be swapped
+ *
+ *  @return `value` with its bytes in reverse order
+ *  */
+template<class T>
+[[nodiscard]] constexpr auto byteSwap(T value) noexcept
+  -> T requires std::is_unsigned_v<T>
+{
+  T result{};
+
+  /* Compilers recognize this loop and emit a single bswap/rev instruction */
+  for (std::size_t i{}; i < sizeof(T); ++i) {
+    result = static_cast<T>(result << 8 | (value >> (8 * i) & 0xff));
+  }
+
+  return result;
+}
+
+
+/** @brief Reverses the bytes of every member of a hana struct
+ *
+ *  The sequence of swaps is unrolled at compile time from the members of
+ *  `Struct`, e.g. for an `Elf64_Shdr` it's four 32-bit and six 64-bit swaps
+ *
+ *  @tparam Struct hana struct whose members are unsigned integers
+ *  @param s struct to be swapped in place
+ *  */
+template<class Struct>
+constexpr auto byteSwapStruct(Struct& s) noexcept -> void
+{
+  hana::for_each(hana::keys(s), [&](auto key) {
+    auto& member = hana::at_key(s, key);
+    member = byteSwap(member);
+  });
+}
+
+
 /**
  *
  * Checks if the template parameter Container has an alias named value_type
@@ -69,6 +219,18 @@ public:
   constexpr explicit Pelf(const Container& data) requires
     container_and_convertible_v<Container, unsigned char>;
 
+  /** @brief Pelf constructor
+   *
+   *  Same as above, but if `Container` is allocator aware (e.g.
+   *  std::pmr::vector) the copy of `data` is allocated with `alloc`
+   *
+   *  @param data The data to be parsed
+   *  @param alloc Allocator used to copy `data`
+   *  * */
+  template<class Allocator>
+  constexpr Pelf(const Container& data, const Allocator& alloc) requires
+    container_and_convertible_v<Container, unsigned char>;
+
 
   /** @brief Returns the original data passed to the Pe/Elf constructor
    *
@@ -106,15 +268,45 @@ protected:
   /** @brief Reads the contents from `mData` at the index `offset` into the
    * struct passed by reference
    *
+   *  @tparam Endian Byte order of the file, if it's not the byte order of the
+   *  host the members are swapped after copying them
    *  @tparam Header struct that represents either a Pe header or an Elf header
    *
    *
    *  @return Returns the offset from `mData` to continue reading the next struct
    * */
-  template<class Header>
+  template<std::endian Endian = std::endian::little, class Header>
   constexpr auto readHeader(Header& header, const std::ptrdiff_t offset)
     -> std::ptrdiff_t;
 
+  /** @brief Reads a table of consecutive structs from `mData` at the index
+   * `offset`
+   *
+   *  At runtime the whole table is bounds checked and copied at once, then
+   *  swapped in a single loop over the entries if `Endian` isn't the byte
+   *  order of the host
+   *
+   *  @tparam Endian Byte order of the file
+   *  @tparam TableType `Table` of hana structs, already resized
+   *
+   *  @return Returns the offset from `mData` right after the table
+   * */
+  template<std::endian Endian = std::endian::little, class TableType>
+  constexpr auto readTable(TableType& table, const std::ptrdiff_t offset)
+    -> std::ptrdiff_t;
+
+  /** @brief Checks that a table of `count` structs at the index `offset` is
+   * inside `mData` before the table is resized to `count`
+   *
+   *  `count` is read from the file, it throws `PelfException` instead of
+   *  letting a malformed file allocate a huge table
+   *
+   *  @tparam Struct hana struct of the entries
+   * */
+  template<class Struct>
+  constexpr auto checkTableSize(std::size_t count,
+    const std::ptrdiff_t offset) const -> void;
+
   /** @brief Returns an Struct filled with the data from `mData` from index
    * `offset`
    *
@@ -122,11 +314,12 @@ protected:
    * std::copy() is used
    *
    *  @tparam Struct hana struct that represents a pe or elf header
+   *  @tparam Endian Byte order of the file
    *  @param offset offset of the header
    *
    *  @return Returns a struct of the corresponding header
    *  */
-  template<class Struct>
+  template<class Struct, std::endian Endian = std::endian::little>
   [[nodiscard]] constexpr auto getStruct(std::size_t offset) -> Struct;
 };
 
@@ -135,6 +328,14 @@ constexpr Pelf<Container, Derived>::Pelf(const Container& data) requires
   container_and_convertible_v<Container, unsigned char> : mData(data)
 {}
 
+template<class Container, class Derived>
+template<class Allocator>
+constexpr Pelf<Container, Derived>::Pelf(const Container& data,
+  const Allocator& alloc) requires
+  container_and_convertible_v<Container, unsigned char>
+  : mData(std::make_obj_using_allocator<Container>(alloc, data))
+{}
+
 template<class Container, class Derived>
 constexpr auto Pelf<Container, Derived>::getRawData() const noexcept
   -> Container
@@ -171,7 +372,7 @@ constexpr auto Pelf<Container, Derived>::parse() -> void
 }
 
 template<class Container, class Derived>
-template<class Header>
+template<std::endian Endian, class Header>
 constexpr auto Pelf<Container, Derived>::readHeader(Header& header,
   const std::ptrdiff_t offset) -> std::ptrdiff_t
 {
@@ -181,7 +382,8 @@ constexpr auto Pelf<Container, Derived>::readHeader(Header& header,
   }
 
   if (std::is_constant_evaluated()) {
-    header = this->template getStruct<Header>(static_cast<std::size_t>(offset));
+    header = this->template getStruct<Header, Endian>(
+      static_cast<std::size_t>(offset));
   } else {
 
     assert(std::is_trivially_copyable<Header>::value);
@@ -194,13 +396,65 @@ constexpr auto Pelf<Container, Derived>::readHeader(Header& header,
     } else {
       throw PelfException{ "Invalid Header" };
     }
+
+    /* Files in the byte order of the host keep the straight copy */
+    if constexpr (Endian != std::endian::native) { byteSwapStruct(header); }
   }
 
   return offset + static_cast<std::ptrdiff_t>(sizeof(Header));
 }
 
+template<class Container, class Derived>
+template<std::endian Endian, class TableType>
+constexpr auto Pelf<Container, Derived>::readTable(TableType& table,
+  const std::ptrdiff_t offset) -> std::ptrdiff_t
+{
+  using Struct = typename TableType::value_type;
+
+  if (std::is_constant_evaluated()) {
+    std::ptrdiff_t next = offset;
+    for (auto& entry : table) { next = readHeader<Endian>(entry, next); }
+    return next;
+  }
+
+  if (offset < 0) {
+    throw PelfException{ "Invalid offset (negative), while parsing headers" };
+  }
+
+  const std::size_t start = static_cast<std::size_t>(offset);
+  const std::size_t size = table.size() * sizeof(Struct);
+
+  if (start > this->mData.size() || size > this->mData.size() - start) {
+    throw PelfException{ "Invalid Header" };
+  }
+
+  std::copy(this->mData.begin() + offset,
+    this->mData.begin() + offset + static_cast<std::ptrdiff_t>(size),
+    reinterpret_cast<char*>(table.data()));
+
+  if constexpr (Endian != std::endian::native) {
+    for (auto& entry : table) { byteSwapStruct(entry); }
+  }
+
+  return offset + static_cast<std::ptrdiff_t>(size);
+}
+
 template<class Container, class Derived>
 template<class Struct>
+constexpr auto Pelf<Container, Derived>::checkTableSize(std::size_t count,
+  const std::ptrdiff_t offset) const -> void
+{
+  if (count == 0) { return; }
+
+  if (offset < 0 || static_cast<std::size_t>(offset) > this->mData.size()
+      || count > (this->mData.size() - static_cast<std::size_t>(offset))
+                   / sizeof(Struct)) {
+    throw PelfException{ "Invalid table size, it isn't in the file" };
+  }
+}
+
+template<class Container, class Derived>
+template<class Struct, std::endian Endian>
 constexpr auto Pelf<Container, Derived>::getStruct(std::size_t offset)
   -> Struct
 {
@@ -213,7 +467,12 @@ constexpr auto Pelf<Container, Derived>::getStruct(std::size_t offset)
 #pragma unroll
     for (std::size_t i{}; i < sizeof(member); ++i) {
       if (sizeof(member) > 1) { member <<= 8; }
-      member |= mData.at(sizeof(member) - 1 + offset - i);
+      /* Most significant byte first, it's the last one in little endian */
+      if constexpr (Endian == std::endian::little) {
+        member |= readByte(mData, sizeof(member) - 1 + offset - i);
+      } else {
+        member |= readByte(mData, offset + i);
+      }
     }
 
     offset += sizeof(member);
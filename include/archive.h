@@ -0,0 +1,546 @@
+/** @file archive.h
+ *  @brief Archive class declaration
+ *
+ *  This file contains the Archive class declaration, a reader of Unix ar
+ *  archives (static libraries). It handles the GNU and BSD variants of the
+ *  long member names, the symbol tables of both variants and thin archives.
+ *  Members are sub-spans of the archive that can be passed to `Elf`, `Pe` or
+ *  `open()` without copying them
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef ARCHIVE_H_
+#define ARCHIVE_H_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "parallelFor.h"
+#include "pelfExcept.h"
+#include "pelfFormat.h"
+
+
+namespace pelf {
+
+
+/** @brief A member of an archive
+ *
+ *  `name` and `data` point into the data of the archive
+ * */
+struct ArchiveMember
+{
+  std::string_view name; /**< File name, or path for thin archives */
+  std::uint64_t offset{}; /**< Offset of the member header in the archive */
+  std::uint64_t size{}; /**< Size of the file */
+  std::uint64_t date{}; /**< Modification time, zero in deterministic
+                           archives */
+  std::uint32_t uid{}; /**< Owner */
+  std::uint32_t gid{}; /**< Group */
+  std::uint32_t mode{}; /**< File mode */
+  std::span<const unsigned char> data; /**< Contents, empty for the members of
+                                          thin archives (they're separate
+                                          files) */
+};
+
+
+/** @brief Entry of the symbol table of an archive */
+struct ArchiveSymbol
+{
+  std::string_view name; /**< Name of the symbol */
+  std::uint64_t memberOffset{}; /**< Offset of the header of the member that
+                                   defines it */
+};
+
+
+/** @brief Reader of Unix ar archives
+ *
+ *  The member headers are read by the constructor, the contents of the
+ *  members aren't touched until they're used
+ * */
+class Archive
+{
+public:
+  /** @brief Result of `open()` on the contents of a member */
+  using MemberFile = OpenResult<std::span<const unsigned char>>;
+
+  /** @brief Result of `parseMembers()` for one member */
+  struct ParsedMember
+  {
+    std::optional<MemberFile> file; /**< Parsed member, `std::nullopt` if
+                                       `open()` threw */
+    std::exception_ptr error; /**< Exception thrown by `open()` */
+  };
+
+  /** @brief Archive constructor
+   *
+   *  @param data Bytes of the archive, e.g. a memory mapped file, they must
+   *  outlive the archive
+   *
+   *  It throws `PelfException` if the data isn't an archive or a member
+   *  header or the symbol table is invalid
+   * */
+  explicit Archive(std::span<const unsigned char> data);
+
+  /** @brief Returns `true` for thin archives (!<thin>) */
+  [[nodiscard]] auto isThin() const noexcept -> bool;
+
+  /** @brief Returns the members, in the order of the archive
+   *
+   *  The symbol table and the long name table aren't members
+   * */
+  [[nodiscard]] auto members() const noexcept
+    -> std::span<const ArchiveMember>;
+
+  /** @brief Returns the first member named `name` */
+  [[nodiscard]] auto findMember(std::string_view name) const
+    -> std::optional<ArchiveMember>;
+
+  /** @brief Returns the member whose header is at `offset` */
+  [[nodiscard]] auto memberAt(std::uint64_t offset) const
+    -> std::optional<ArchiveMember>;
+
+  /** @brief Returns the number of entries of the symbol table, zero if the
+   * archive doesn't have one */
+  [[nodiscard]] auto symbolCount() const noexcept -> std::size_t;
+
+  /** @brief Returns the entries of the symbol table */
+  [[nodiscard]] auto symbols() const -> std::vector<ArchiveSymbol>;
+
+  /** @brief Returns the member that defines `symbol`
+   *
+   *  Only the symbol table of the archive is read, the members aren't parsed
+   *
+   *  @return Member, `std::nullopt` if the symbol table doesn't have `symbol`
+   * */
+  [[nodiscard]] auto findSymbol(std::string_view symbol) const
+    -> std::optional<ArchiveMember>;
+
+  /** @brief Calls `function(index, member)` for every member using `threads`
+   * threads
+   *
+   *  The first exception thrown by `function` stops the members that haven't
+   *  been visited and is rethrown once every thread has finished
+   *
+   *  @param function Callable, it's called from many threads at the same time
+   *  @param threads Number of threads, 0 uses one per core
+   * */
+  template<class Function>
+  auto forEachMember(Function&& function, unsigned threads = 0) const -> void;
+
+  /** @brief Parses every member with `open()` using `threads` threads
+   *
+   *  @param threads Number of threads, 0 uses one per core
+   *
+   *  @return One result per member, in the order of `members()`. Members that
+   *  aren't PE/ELF files are `Unknown`, members that can't be parsed keep the
+   *  exception
+   * */
+  [[nodiscard]] auto parseMembers(unsigned threads = 0) const
+    -> std::vector<ParsedMember>;
+
+private:
+  /** @brief Layout of the symbol table */
+  enum class SymbolFormat : std::uint8_t {
+    none, /**< No symbol table */
+    gnu32, /**< "/", big endian 32-bit offsets (also the first member of
+              COFF import libraries) */
+    gnu64, /**< "/SYM64/", big endian 64-bit offsets */
+    bsd32, /**< "__.SYMDEF", ranlib structs with 32-bit fields */
+    bsd64 /**< "__.SYMDEF_64", ranlib structs with 64-bit fields */
+  };
+
+  static constexpr std::size_t mHeaderSize{ 60 }; /**< Size of a member
+                                                     header */
+
+  std::span<const unsigned char> mData; /**< Bytes of the archive */
+  bool mThin{}; /**< Thin archive */
+  std::vector<ArchiveMember> mMembers; /**< Members, sorted by offset */
+
+  SymbolFormat mSymbolFormat{ SymbolFormat::none }; /**< Symbol table layout */
+  std::size_t mSymbolCount{}; /**< Entries of the symbol table */
+  std::span<const unsigned char> mSymbolEntries; /**< Offsets (GNU) or
+                                                    ranlib structs (BSD) */
+  std::span<const unsigned char> mSymbolNames; /**< Names of the symbols */
+
+  /** @brief Reads the symbol table `contents` of format `format` */
+  auto readSymbolTable(SymbolFormat format,
+    std::span<const unsigned char> contents) -> void;
+
+  /** @brief Calls `function(name, memberOffset)` for every entry of the
+   * symbol table until it returns `true` */
+  template<class Function> auto visitSymbols(Function&& function) const -> void;
+
+  /** @brief Parses a decimal (or octal) field of a member header, blanks are
+   * zero */
+  static auto parseNumber(std::span<const unsigned char> field,
+    unsigned base = 10) -> std::uint64_t;
+
+  /** @brief Returns the field without the trailing spaces */
+  static auto trim(std::span<const unsigned char> field) -> std::string_view;
+};
+
+
+inline Archive::Archive(std::span<const unsigned char> data) : mData(data)
+{
+  const auto signature = trim(data.first(std::min<std::size_t>(data.size(), 8)));
+  if (signature != "!<arch>\n" && signature != "!<thin>\n") {
+    throw PelfException{ "Invalid archive, missing the !<arch> signature" };
+  }
+  mThin = signature == "!<thin>\n";
+
+  std::span<const unsigned char> long_names;
+  std::size_t offset{ 8 };
+
+  while (offset < data.size()) {
+    /* Some tools pad the last member with newlines */
+    if (data.size() - offset < mHeaderSize) {
+      if (std::all_of(data.begin() + static_cast<std::ptrdiff_t>(offset),
+            data.end(),
+            [](unsigned char c) { return c == '\n'; })) {
+        break;
+      }
+      throw PelfException{ "Invalid archive member header, it's truncated" };
+    }
+
+    const auto header = data.subspan(offset, mHeaderSize);
+    if (header[58] != '`' || header[59] != '\n') {
+      throw PelfException{ "Invalid archive member header, bad terminator" };
+    }
+
+    ArchiveMember member;
+    member.name = trim(header.first(16));
+    member.offset = offset;
+    member.date = parseNumber(header.subspan(16, 12));
+    member.uid = static_cast<std::uint32_t>(parseNumber(header.subspan(28, 6)));
+    member.gid = static_cast<std::uint32_t>(parseNumber(header.subspan(34, 6)));
+    member.mode =
+      static_cast<std::uint32_t>(parseNumber(header.subspan(40, 8), 8));
+    member.size = parseNumber(header.subspan(48, 10));
+
+    const std::size_t contents = offset + mHeaderSize;
+    const auto& name = member.name;
+
+    const bool symbol_table = name == "/" || name == "/SYM64/";
+    const bool special = symbol_table || name == "//";
+
+    /* The members of thin archives are stored in separate files, only the
+     * symbol table and the long name table are in the archive */
+    const std::uint64_t stored = mThin && !special ? 0 : member.size;
+    if (stored > data.size() - contents) {
+      throw PelfException{ "Invalid archive member, it exceeds the archive" };
+    }
+
+    member.data = data.subspan(contents, static_cast<std::size_t>(stored));
+    offset = contents + static_cast<std::size_t>(stored) + (stored & 1);
+
+    if (symbol_table) {
+      /* COFF import libraries have a second, little endian, linker member */
+      if (mSymbolFormat == SymbolFormat::none) {
+        readSymbolTable(
+          name == "/" ? SymbolFormat::gnu32 : SymbolFormat::gnu64, member.data);
+      }
+      continue;
+    }
+
+    if (name == "//") {
+      long_names = member.data;
+      continue;
+    }
+
+    if (name.starts_with("#1/")) {
+      /* BSD: the name is stored before the contents and counted in the size */
+      const auto name_size = parseNumber(header.subspan(3, 13));
+      if (name_size > member.data.size()) {
+        throw PelfException{ "Invalid archive member, its name exceeds it" };
+      }
+
+      const auto bytes = member.data.first(static_cast<std::size_t>(name_size));
+      std::string_view bsd_name{ reinterpret_cast<const char*>(bytes.data()),
+        bytes.size() };
+      bsd_name = bsd_name.substr(0, bsd_name.find('\0'));
+
+      member.name = bsd_name;
+      member.data = member.data.subspan(static_cast<std::size_t>(name_size));
+      member.size -= name_size;
+
+      if (bsd_name.starts_with("__.SYMDEF")) {
+        readSymbolTable(bsd_name.starts_with("__.SYMDEF_64")
+                          ? SymbolFormat::bsd64
+                          : SymbolFormat::bsd32,
+          member.data);
+        continue;
+      }
+    } else if (name.starts_with("__.SYMDEF")) {
+      readSymbolTable(name.starts_with("__.SYMDEF_64") ? SymbolFormat::bsd64
+                                                       : SymbolFormat::bsd32,
+        member.data);
+      continue;
+    } else if (name.size() > 1 && name[0] == '/') {
+      /* GNU: offset of the name in the long name table, ended by "/\n" */
+      const auto name_offset = parseNumber(header.subspan(1, 15));
+      if (name_offset >= long_names.size()) {
+        throw PelfException{ "Invalid archive member, long name out of range" };
+      }
+
+      const std::string_view names{
+        reinterpret_cast<const char*>(long_names.data()), long_names.size() };
+      auto long_name = names.substr(static_cast<std::size_t>(name_offset));
+      long_name = long_name.substr(0, long_name.find('\n'));
+      if (long_name.ends_with('/')) { long_name.remove_suffix(1); }
+
+      member.name = long_name;
+    } else if (name.size() > 1 && name.ends_with('/')) {
+      member.name.remove_suffix(1);
+    }
+
+    mMembers.push_back(member);
+  }
+}
+
+inline auto Archive::isThin() const noexcept -> bool
+{
+  return mThin;
+}
+
+inline auto Archive::members() const noexcept -> std::span<const ArchiveMember>
+{
+  return mMembers;
+}
+
+inline auto Archive::findMember(std::string_view name) const
+  -> std::optional<ArchiveMember>
+{
+  for (const auto& member : mMembers) {
+    if (member.name == name) { return member; }
+  }
+
+  return std::nullopt;
+}
+
+inline auto Archive::memberAt(std::uint64_t offset) const
+  -> std::optional<ArchiveMember>
+{
+  const auto member = std::lower_bound(mMembers.begin(),
+    mMembers.end(),
+    offset,
+    [](const ArchiveMember& m, std::uint64_t value) { return m.offset < value; });
+
+  if (member == mMembers.end() || member->offset != offset) {
+    return std::nullopt;
+  }
+
+  return *member;
+}
+
+inline auto Archive::symbolCount() const noexcept -> std::size_t
+{
+  return mSymbolCount;
+}
+
+inline auto Archive::readSymbolTable(SymbolFormat format,
+  std::span<const unsigned char> contents) -> void
+{
+  const bool gnu = format == SymbolFormat::gnu32 || format == SymbolFormat::gnu64;
+  const std::size_t word =
+    format == SymbolFormat::gnu64 || format == SymbolFormat::bsd64 ? 8 : 4;
+
+  const auto read_word = [&](std::size_t offset) -> std::uint64_t {
+    if (word == 8) {
+      return gnu ? readInteger<std::uint64_t, std::endian::big>(contents, offset)
+                 : readInteger<std::uint64_t>(contents, offset);
+    }
+    return gnu ? readInteger<std::uint32_t, std::endian::big>(contents, offset)
+               : readInteger<std::uint32_t>(contents, offset);
+  };
+
+  if (gnu) {
+    /* Number of symbols, their member offsets and the names */
+    const auto count = read_word(0);
+    if (count > (contents.size() - word) / word) {
+      throw PelfException{ "Invalid archive symbol table, too many symbols" };
+    }
+
+    mSymbolCount = static_cast<std::size_t>(count);
+    mSymbolEntries = contents.subspan(word, mSymbolCount * word);
+    mSymbolNames = contents.subspan(word + mSymbolCount * word);
+  } else {
+    /* Size of the ranlib array, the array, size of the names and the names */
+    const auto entries_size = read_word(0);
+    if (entries_size > contents.size() - 2 * word) {
+      throw PelfException{ "Invalid archive symbol table, too many symbols" };
+    }
+
+    const auto entries_end = word + static_cast<std::size_t>(entries_size);
+    const auto names_size = read_word(entries_end);
+    if (names_size > contents.size() - entries_end - word) {
+      throw PelfException{ "Invalid archive symbol table, names out of range" };
+    }
+
+    mSymbolCount = static_cast<std::size_t>(entries_size) / (2 * word);
+    mSymbolEntries = contents.subspan(word, mSymbolCount * 2 * word);
+    mSymbolNames = contents.subspan(entries_end + word,
+      static_cast<std::size_t>(names_size));
+  }
+
+  mSymbolFormat = format;
+}
+
+template<class Function>
+auto Archive::visitSymbols(Function&& function) const -> void
+{
+  const std::string_view names{
+    reinterpret_cast<const char*>(mSymbolNames.data()), mSymbolNames.size() };
+
+  switch (mSymbolFormat) {
+  case SymbolFormat::none:
+    return;
+  case SymbolFormat::gnu32:
+  case SymbolFormat::gnu64: {
+    /* The names are in the order of the offsets */
+    const bool wide = mSymbolFormat == SymbolFormat::gnu64;
+    std::size_t name_offset{};
+
+    for (std::size_t i{}; i < mSymbolCount; ++i) {
+      const auto end = names.find('\0', name_offset);
+      if (end == std::string_view::npos) {
+        throw PelfException{ "Invalid archive symbol table, names out of range" };
+      }
+
+      const std::uint64_t member =
+        wide
+          ? readInteger<std::uint64_t, std::endian::big>(mSymbolEntries, i * 8)
+          : readInteger<std::uint32_t, std::endian::big>(mSymbolEntries, i * 4);
+
+      if (function(names.substr(name_offset, end - name_offset), member)) {
+        return;
+      }
+      name_offset = end + 1;
+    }
+    return;
+  }
+  case SymbolFormat::bsd32:
+  case SymbolFormat::bsd64: {
+    /* Every ranlib struct has the offset of its name */
+    const bool wide = mSymbolFormat == SymbolFormat::bsd64;
+    const std::size_t word = wide ? 8 : 4;
+
+    for (std::size_t i{}; i < mSymbolCount; ++i) {
+      const std::size_t entry = i * 2 * word;
+      const std::uint64_t name_offset =
+        wide ? readInteger<std::uint64_t>(mSymbolEntries, entry)
+             : readInteger<std::uint32_t>(mSymbolEntries, entry);
+      const std::uint64_t member =
+        wide ? readInteger<std::uint64_t>(mSymbolEntries, entry + word)
+             : readInteger<std::uint32_t>(mSymbolEntries, entry + word);
+
+      if (name_offset >= names.size()) {
+        throw PelfException{ "Invalid archive symbol table, names out of range" };
+      }
+
+      auto name = names.substr(static_cast<std::size_t>(name_offset));
+      name = name.substr(0, name.find('\0'));
+
+      if (function(name, member)) { return; }
+    }
+    return;
+  }
+  }
+}
+
+inline auto Archive::symbols() const -> std::vector<ArchiveSymbol>
+{
+  std::vector<ArchiveSymbol> result;
+  result.reserve(mSymbolCount);
+
+  visitSymbols([&](std::string_view name, std::uint64_t member) {
+    result.push_back({ name, member });
+    return false;
+  });
+
+  return result;
+}
+
+inline auto Archive::findSymbol(std::string_view symbol) const
+  -> std::optional<ArchiveMember>
+{
+  std::optional<std::uint64_t> offset;
+
+  visitSymbols([&](std::string_view name, std::uint64_t member) {
+    if (name != symbol) { return false; }
+    offset = member;
+    return true;
+  });
+
+  if (!offset) { return std::nullopt; }
+
+  return memberAt(*offset);
+}
+
+template<class Function>
+auto Archive::forEachMember(Function&& function, unsigned threads) const -> void
+{
+  detail::parallelFor(mMembers.size(), threads, [&](std::size_t index) {
+    function(index, mMembers[index]);
+  });
+}
+
+inline auto Archive::parseMembers(unsigned threads) const
+  -> std::vector<ParsedMember>
+{
+  std::vector<ParsedMember> results(mMembers.size());
+
+  forEachMember(
+    [&](std::size_t index, const ArchiveMember& member) {
+      try {
+        results[index].file.emplace(open(member.data));
+      } catch (...) {
+        results[index].error = std::current_exception();
+      }
+    },
+    threads);
+
+  return results;
+}
+
+inline auto Archive::parseNumber(std::span<const unsigned char> field,
+  unsigned base) -> std::uint64_t
+{
+  std::uint64_t value{};
+
+  for (const unsigned char c : field) {
+    if (c == ' ' || c == '\0') { break; }
+    if (c < '0' || c >= '0' + base) {
+      throw PelfException{ "Invalid archive member header, bad number" };
+    }
+    value = value * base + (c - '0');
+  }
+
+  return value;
+}
+
+inline auto Archive::trim(std::span<const unsigned char> field)
+  -> std::string_view
+{
+  std::string_view text{ reinterpret_cast<const char*>(field.data()),
+    field.size() };
+
+  while (!text.empty() && text.back() == ' ') { text.remove_suffix(1); }
+
+  return text;
+}
+
+
+}// namespace pelf
+
+
+#endif
@@ -0,0 +1,283 @@
+/** @file checksum.h
+ *  @brief Checksums used by the ELF and PE formats
+ *
+ *  This file contains `crc32()`, the CRC used by `.gnu_debuglink` to check
+ *  that a separate debug file matches the binary that references it, and
+ *  `Md5`, the hash of the imphash and of the Rich header hash of PE files
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef CHECKSUM_H_
+#define CHECKSUM_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+
+namespace pelf {
+
+
+namespace detail {
+
+  /** @brief Lookup tables of the slice-by-4 CRC-32, generated at compile
+   * time, `table[0]` is the classic byte at a time table */
+  inline constexpr auto crc32Tables = [] {
+    std::array<std::array<std::uint32_t, 256>, 4> tables{};
+
+    for (std::uint32_t i{}; i < 256; ++i) {
+      std::uint32_t crc = i;
+      for (int bit{}; bit < 8; ++bit) {
+        crc = (crc & 1) != 0 ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+      }
+      tables[0][i] = crc;
+    }
+
+    for (std::uint32_t i{}; i < 256; ++i) {
+      for (std::size_t t{ 1 }; t < tables.size(); ++t) {
+        const auto previous = tables[t - 1][i];
+        tables[t][i] = (previous >> 8) ^ tables[0][previous & 0xff];
+      }
+    }
+
+    return tables;
+  }();
+
+  /** @brief Per round shift amounts of MD5 */
+  inline constexpr std::array<std::uint32_t, 64> md5Shifts{ 7, 12, 17, 22, 7,
+    12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9,
+    14, 20, 5, 9, 14, 20, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11,
+    16, 23, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21 };
+
+  /** @brief Constants of MD5, floor(abs(sin(i + 1)) * 2^32) */
+  inline constexpr std::array<std::uint32_t, 64> md5Constants{ 0xd76aa478,
+    0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613,
+    0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122,
+    0xfd987193, 0xa679438e, 0x49b40821, 0xf61e2562, 0xc040b340, 0x265e5a51,
+    0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8, 0x21e1cde6,
+    0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9,
+    0x8d2a4c8a, 0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44,
+    0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70, 0x289b7ec6, 0xeaa127fa, 0xd4ef3085,
+    0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665, 0xf4292244,
+    0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d,
+    0x85845dd1, 0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82,
+    0xbd3af235, 0x2ad7d2bb, 0xeb86d391 };
+
+}// namespace detail
+
+
+/** @brief Computes the CRC-32 (ISO 3309, the same as zlib's `crc32()`) of
+ * `data`
+ *
+ *  @param data Bytes to be checksummed
+ *  @param crc CRC of the preceding bytes, to checksum data in chunks
+ *
+ *  @return Returns the CRC of the bytes checksummed so far
+ * */
+constexpr auto crc32(std::span<const unsigned char> data,
+  std::uint32_t crc = 0) noexcept -> std::uint32_t
+{
+  const auto& tables = detail::crc32Tables;
+
+  crc = ~crc;
+
+  std::size_t i{};
+
+  /* Four bytes per iteration, each byte goes through its own table so the
+   * lookups don't depend on each other */
+  for (; i + 4 <= data.size(); i += 4) {
+    crc ^= static_cast<std::uint32_t>(data[i])
+           | static_cast<std::uint32_t>(data[i + 1]) << 8
+           | static_cast<std::uint32_t>(data[i + 2]) << 16
+           | static_cast<std::uint32_t>(data[i + 3]) << 24;
+    crc = tables[3][crc & 0xff] ^ tables[2][(crc >> 8) & 0xff]
+          ^ tables[1][(crc >> 16) & 0xff] ^ tables[0][crc >> 24];
+  }
+
+  for (; i < data.size(); ++i) {
+    crc = (crc >> 8) ^ tables[0][(crc ^ data[i]) & 0xff];
+  }
+
+  return ~crc;
+}
+
+
+/** @brief Digest of `Md5` */
+using Md5Digest = std::array<unsigned char, 16>;
+
+
+/** @brief Incremental MD5 (RFC 1321)
+ *
+ *  Data is hashed in place as it's passed to `update()`, only the last
+ *  partial block is buffered, so a hash can be computed over many small
+ *  pieces (e.g. the names of the imports) without concatenating them
+ * */
+class Md5
+{
+public:
+  constexpr Md5() = default;
+
+  /** @brief Hashes `data` */
+  constexpr auto update(std::span<const unsigned char> data) noexcept -> void;
+
+  /** @brief Hashes the characters of `text` */
+  constexpr auto update(std::string_view text) noexcept -> void;
+
+  /** @brief Hashes a single byte */
+  constexpr auto update(unsigned char byte) noexcept -> void;
+
+  /** @brief Pads the message and returns the digest, the object must not be
+   * updated afterwards */
+  [[nodiscard]] constexpr auto finish() noexcept -> Md5Digest;
+
+private:
+  std::array<std::uint32_t, 4> mState{ 0x67452301,
+    0xefcdab89,
+    0x98badcfe,
+    0x10325476 }; /**< A, B, C and D */
+  std::array<unsigned char, 64> mBlock{}; /**< Partial block */
+  std::uint64_t mSize{}; /**< Number of bytes hashed */
+
+  /** @brief Hashes a complete block */
+  constexpr auto transform(std::span<const unsigned char, 64> block) noexcept
+    -> void;
+};
+
+
+/** @brief Returns the MD5 of `data` */
+[[nodiscard]] constexpr auto md5(std::span<const unsigned char> data) noexcept
+  -> Md5Digest
+{
+  Md5 hash;
+  hash.update(data);
+  return hash.finish();
+}
+
+
+/** @brief Returns the lower case hexadecimal representation of `digest`, the
+ * format used by imphash tools */
+[[nodiscard]] inline auto toHex(const Md5Digest& digest) -> std::string
+{
+  constexpr std::string_view digits{ "0123456789abcdef" };
+
+  std::string text;
+  text.reserve(digest.size() * 2);
+  for (const auto byte : digest) {
+    text += digits[byte >> 4];
+    text += digits[byte & 0xf];
+  }
+
+  return text;
+}
+
+
+constexpr auto Md5::update(std::span<const unsigned char> data) noexcept
+  -> void
+{
+  std::size_t used = mSize % 64;
+  mSize += data.size();
+
+  /* Complete the buffered block, then hash full blocks from `data` */
+  if (used != 0) {
+    const std::size_t count = std::min(data.size(), 64 - used);
+    for (std::size_t i{}; i < count; ++i) { mBlock[used + i] = data[i]; }
+    data = data.subspan(count);
+    used += count;
+    if (used < 64) { return; }
+    transform(mBlock);
+  }
+
+  for (; data.size() >= 64; data = data.subspan(64)) {
+    transform(data.first<64>());
+  }
+
+  for (std::size_t i{}; i < data.size(); ++i) { mBlock[i] = data[i]; }
+}
+
+constexpr auto Md5::update(std::string_view text) noexcept -> void
+{
+  for (const char c : text) { update(static_cast<unsigned char>(c)); }
+}
+
+constexpr auto Md5::update(unsigned char byte) noexcept -> void
+{
+  const std::size_t used = mSize % 64;
+  mBlock[used] = byte;
+  ++mSize;
+  if (used == 63) { transform(mBlock); }
+}
+
+constexpr auto Md5::finish() noexcept -> Md5Digest
+{
+  const std::uint64_t bits = mSize * 8;
+
+  update(static_cast<unsigned char>(0x80));
+  while (mSize % 64 != 56) { update(static_cast<unsigned char>(0)); }
+  for (std::size_t i{}; i < 8; ++i) {
+    update(static_cast<unsigned char>(bits >> (i * 8)));
+  }
+
+  Md5Digest digest{};
+  for (std::size_t i{}; i < digest.size(); ++i) {
+    digest[i] = static_cast<unsigned char>(mState[i / 4] >> (i % 4 * 8));
+  }
+
+  return digest;
+}
+
+constexpr auto Md5::transform(std::span<const unsigned char, 64> block) noexcept
+  -> void
+{
+  std::array<std::uint32_t, 16> words{};
+  for (std::size_t i{}; i < words.size(); ++i) {
+    words[i] = static_cast<std::uint32_t>(block[i * 4])
+               | static_cast<std::uint32_t>(block[i * 4 + 1]) << 8
+               | static_cast<std::uint32_t>(block[i * 4 + 2]) << 16
+               | static_cast<std::uint32_t>(block[i * 4 + 3]) << 24;
+  }
+
+  auto [a, b, c, d] = mState;
+
+  for (std::uint32_t i{}; i < 64; ++i) {
+    std::uint32_t f{};
+    std::uint32_t g{};
+    if (i < 16) {
+      f = (b & c) | (~b & d);
+      g = i;
+    } else if (i < 32) {
+      f = (d & b) | (~d & c);
+      g = (5 * i + 1) % 16;
+    } else if (i < 48) {
+      f = b ^ c ^ d;
+      g = (3 * i + 5) % 16;
+    } else {
+      f = c ^ (b | ~d);
+      g = (7 * i) % 16;
+    }
+
+    f += a + detail::md5Constants[i] + words[g];
+    a = d;
+    d = c;
+    c = b;
+    const auto shift = detail::md5Shifts[i];
+    b += (f << shift) | (f >> (32 - shift));
+  }
+
+  mState[0] += a;
+  mState[1] += b;
+  mState[2] += c;
+  mState[3] += d;
+}
+
+
+}// namespace pelf
+
+
+#endif
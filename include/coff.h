@@ -0,0 +1,755 @@
+/** @file coff.h
+ *  @brief Coff and CoffSymbolTable class declarations
+ *
+ *  This file contains a reader of COFF object files (.obj), including the
+ *  /bigobj variant, and a view of the COFF symbol table and string table that
+ *  is shared with `Pe`. Symbols are decoded from the bytes of the file when
+ *  they're accessed, `CoffSymbolIndex` sorts them by name for lookups in big
+ *  object files
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef COFF_H_
+#define COFF_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "Pelf.h"
+#include "peStructs.h"
+#include "pelfExcept.h"
+
+
+namespace pelf {
+
+
+/** @brief A record of the symbol table, without its auxiliary records
+ *
+ *  `name` and `aux` point into the data of the file
+ * */
+struct CoffSymbol
+{
+  std::uint32_t index{}; /**< Index of the record in the symbol table */
+  std::string_view name; /**< Name, long names are read from the string
+                            table */
+  DWORD value{}; /**< Value, e.g. offset in the section */
+  std::int32_t sectionNumber{}; /**< One based section number or
+                                   IMAGE_SYM_UNDEFINED/ABSOLUTE/DEBUG */
+  WORD type{}; /**< Type, see `isFunction()` */
+  BYTE storageClass{}; /**< IMAGE_SYM_CLASS_* */
+  BYTE numberOfAuxSymbols{}; /**< Number of auxiliary records */
+  std::span<const unsigned char> aux; /**< Auxiliary records */
+
+  /** @brief Returns `true` if the type of the symbol is a function */
+  [[nodiscard]] constexpr auto isFunction() const noexcept -> bool
+  {
+    return ((type >> 4) & 0x3) == IMAGE_SYM_DTYPE_FUNCTION;
+  }
+
+  /** @brief Returns `true` for external symbols not defined in the file */
+  [[nodiscard]] constexpr auto isUndefined() const noexcept -> bool
+  {
+    return sectionNumber == IMAGE_SYM_UNDEFINED
+           && storageClass == IMAGE_SYM_CLASS_EXTERNAL && value == 0;
+  }
+};
+
+
+/** @brief Function definition auxiliary record */
+struct CoffAuxFunction
+{
+  DWORD tagIndex{}; /**< Index of the .bf record */
+  DWORD totalSize{}; /**< Size of the code of the function */
+  DWORD pointerToLinenumber{}; /**< Offset of its first line number entry */
+  DWORD pointerToNextFunction{}; /**< Index of the next function */
+};
+
+
+/** @brief Auxiliary record of the .bf and .ef symbols */
+struct CoffAuxLineInfo
+{
+  WORD lineNumber{}; /**< Line number of the beginning or the end of the
+                        function */
+  DWORD pointerToNextFunction{}; /**< Index of the next .bf record (.bf) */
+};
+
+
+/** @brief Weak external auxiliary record */
+struct CoffAuxWeakExternal
+{
+  DWORD tagIndex{}; /**< Index of the symbol used if the weak external isn't
+                       defined */
+  DWORD characteristics{}; /**< IMAGE_WEAK_EXTERN_SEARCH_* */
+};
+
+
+/** @brief File auxiliary records */
+struct CoffAuxFile
+{
+  std::string_view name; /**< Name of the source file, it can span many
+                            records */
+};
+
+
+/** @brief Section definition auxiliary record */
+struct CoffAuxSection
+{
+  DWORD length{}; /**< Size of the section */
+  WORD numberOfRelocations{}; /**< Relocation entries of the section */
+  WORD numberOfLinenumbers{}; /**< Line number entries of the section */
+  DWORD checkSum{}; /**< Checksum of COMDAT sections */
+  std::uint32_t number{}; /**< Associated section of COMDAT sections
+                             (IMAGE_COMDAT_SELECT_ASSOCIATIVE) */
+  BYTE selection{}; /**< IMAGE_COMDAT_SELECT_* */
+};
+
+
+/** @brief CLR token definition auxiliary record */
+struct CoffAuxClrToken
+{
+  BYTE auxType{}; /**< Always 1 */
+  DWORD symbolTableIndex{}; /**< Index of the CLR token symbol */
+};
+
+
+/** @brief Decoded auxiliary records of a symbol, `std::monostate` if the
+ * symbol doesn't have any or their format isn't known */
+using CoffAux = std::variant<std::monostate,
+  CoffAuxFunction,
+  CoffAuxLineInfo,
+  CoffAuxWeakExternal,
+  CoffAuxFile,
+  CoffAuxSection,
+  CoffAuxClrToken>;
+
+
+/** @brief View of a COFF symbol table and its string table
+ *
+ *  Records have a fixed size, so any symbol can be decoded from its index
+ *  without decoding the previous ones. Iterating skips the auxiliary records
+ * */
+class CoffSymbolTable
+{
+public:
+  /** @brief Forward iterator over the symbols (not the auxiliary records) */
+  class Iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = CoffSymbol;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const CoffSymbol*;
+    using reference = CoffSymbol;
+
+    Iterator() = default;
+
+    Iterator(const CoffSymbolTable* table, std::size_t index)
+      : mTable(table), mIndex(index)
+    {}
+
+    [[nodiscard]] auto operator*() const -> CoffSymbol
+    {
+      return mTable->symbol(mIndex);
+    }
+
+    auto operator++() -> Iterator&
+    {
+      mIndex += 1 + mTable->auxCount(mIndex);
+      mIndex = std::min(mIndex, mTable->size());
+      return *this;
+    }
+
+    auto operator++(int) -> Iterator
+    {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    [[nodiscard]] auto operator==(const Iterator& other) const noexcept
+      -> bool
+    {
+      return mIndex == other.mIndex;
+    }
+
+  private:
+    const CoffSymbolTable* mTable{}; /**< Table */
+    std::size_t mIndex{}; /**< Index of the current record */
+  };
+
+  /** @brief Constructs an empty table */
+  CoffSymbolTable() = default;
+
+  /** @brief CoffSymbolTable constructor
+   *
+   *  @param symbols Records of the symbol table
+   *  @param strings String table, including its size field
+   *  @param recordSize IMAGE_SIZEOF_SYMBOL, or IMAGE_SIZEOF_SYMBOL_EX for
+   *  /bigobj files
+   * */
+  CoffSymbolTable(std::span<const unsigned char> symbols,
+    std::span<const unsigned char> strings,
+    std::size_t recordSize);
+
+  /** @brief Returns the number of records, including the auxiliary ones */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] auto empty() const noexcept -> bool;
+
+  /** @brief Returns the size of the records, 18 or 20 bytes */
+  [[nodiscard]] auto recordSize() const noexcept -> std::size_t;
+
+  /** @brief Decodes the record at `index` as a symbol
+   *
+   *  It throws `PelfException` if `index` is out of range or the name isn't
+   *  in the string table. `index` must not be an auxiliary record
+   * */
+  [[nodiscard]] auto symbol(std::size_t index) const -> CoffSymbol;
+
+  /** @brief Decodes the auxiliary records of `symbol` according to its storage
+   * class, type and section number */
+  [[nodiscard]] auto decodeAux(const CoffSymbol& symbol) const -> CoffAux;
+
+  /** @brief Returns the string at `offset` of the string table
+   *
+   *  @param offset Offset from the beginning of the table, the first string
+   *  is at offset 4
+   * */
+  [[nodiscard]] auto string(std::size_t offset) const -> std::string_view;
+
+  /** @brief Returns the string table, including its size field */
+  [[nodiscard]] auto stringTable() const noexcept
+    -> std::span<const unsigned char>;
+
+  [[nodiscard]] auto begin() const -> Iterator;
+
+  [[nodiscard]] auto end() const -> Iterator;
+
+private:
+  std::span<const unsigned char> mSymbols; /**< Records */
+  std::span<const unsigned char> mStrings; /**< String table */
+  std::size_t mRecordSize{ IMAGE_SIZEOF_SYMBOL }; /**< Size of a record */
+
+  /** @brief Returns the NumberOfAuxSymbols of the record at `index` */
+  [[nodiscard]] auto auxCount(std::size_t index) const -> std::size_t;
+};
+
+
+/** @brief Symbols of a `CoffSymbolTable` sorted by name
+ *
+ *  Only the names (views of the file) and the indices of the symbols are
+ *  stored, the table and the data of the file must outlive the index
+ * */
+class CoffSymbolIndex
+{
+public:
+  /** @brief Sorts the symbols of `table` by name */
+  explicit CoffSymbolIndex(const CoffSymbolTable& table);
+
+  /** @brief Returns the first symbol named `name`, in the order of the symbol
+   * table */
+  [[nodiscard]] auto find(std::string_view name) const
+    -> std::optional<CoffSymbol>;
+
+  /** @brief Returns the indices of the symbols named `name` (e.g. static
+   * symbols of many translation units, or section symbols) */
+  [[nodiscard]] auto findAll(std::string_view name) const
+    -> std::vector<std::uint32_t>;
+
+  /** @brief Returns the number of symbols */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+private:
+  CoffSymbolTable mTable; /**< Indexed table */
+  std::vector<std::pair<std::string_view, std::uint32_t>>
+    mEntries; /**< Names and indices, sorted */
+
+  /** @brief Returns the entries named `name` */
+  [[nodiscard]] auto range(std::string_view name) const
+    -> std::pair<decltype(mEntries)::const_iterator,
+      decltype(mEntries)::const_iterator>;
+};
+
+
+/** @brief Reader of COFF object files
+ *
+ *  Both the regular format (IMAGE_FILE_HEADER) and the /bigobj format
+ *  (ANON_OBJECT_HEADER_BIGOBJ) are supported. Nothing is copied, `data` must
+ *  outlive the object and the views returned by it
+ * */
+class Coff
+{
+public:
+  /** @brief Coff constructor
+   *
+   *  @param data Bytes of the object file. It throws `PelfException` if the
+   *  headers, the section table or the symbol table exceed the file, or if
+   *  it's a short import object
+   * */
+  explicit Coff(std::span<const unsigned char> data);
+
+  /** @brief Returns `true` for /bigobj object files */
+  [[nodiscard]] auto isBigObj() const noexcept -> bool;
+
+  /** @brief Returns the machine, e.g. IMAGE_FILE_MACHINE_AMD64 */
+  [[nodiscard]] auto machine() const noexcept -> WORD;
+
+  [[nodiscard]] auto timeDateStamp() const noexcept -> DWORD;
+
+  /** @brief Returns the characteristics, zero for /bigobj files */
+  [[nodiscard]] auto characteristics() const noexcept -> WORD;
+
+  [[nodiscard]] auto numberOfSections() const noexcept -> std::size_t;
+
+  /** @brief Returns the entry of the section table at `index` (zero based,
+   * the section number of symbols is one based) */
+  [[nodiscard]] auto section(std::size_t index) const -> IMAGE_SECTION_HEADER;
+
+  /** @brief Returns the name of the section at `index`, names longer than 8
+   * characters ("/123" or "//BASE64") are read from the string table */
+  [[nodiscard]] auto sectionName(std::size_t index) const -> std::string_view;
+
+  /** @brief Returns the raw data of `section`, empty for uninitialized data */
+  [[nodiscard]] auto sectionData(const IMAGE_SECTION_HEADER& section) const
+    -> std::span<const unsigned char>;
+
+  /** @brief Returns the first section named `name` */
+  [[nodiscard]] auto findSection(std::string_view name) const
+    -> std::optional<std::size_t>;
+
+  /** @brief Returns the symbol table */
+  [[nodiscard]] auto symbols() const noexcept -> const CoffSymbolTable&;
+
+private:
+  /** @brief Size of IMAGE_FILE_HEADER */
+  static constexpr std::size_t mFileHeaderSize{ 20 };
+  /** @brief Size of ANON_OBJECT_HEADER_BIGOBJ */
+  static constexpr std::size_t mBigObjHeaderSize{ 56 };
+  /** @brief Size of IMAGE_SECTION_HEADER */
+  static constexpr std::size_t mSectionHeaderSize{ 40 };
+
+  std::span<const unsigned char> mData; /**< Bytes of the file */
+  bool mBigObj{}; /**< /bigobj object file */
+  WORD mMachine{}; /**< Machine */
+  DWORD mTimeDateStamp{}; /**< Time stamp */
+  WORD mCharacteristics{}; /**< Characteristics */
+  std::size_t mNumberOfSections{}; /**< Entries of the section table */
+  std::size_t mSectionTable{}; /**< Offset of the section table */
+  CoffSymbolTable mSymbols; /**< Symbol table */
+};
+
+
+/** @brief Returns the symbol table and the string table that start at
+ * `pointer` in `data`
+ *
+ *  The string table follows the symbol table, a missing string table (which
+ *  some linkers don't write when it's empty) is an empty table
+ *
+ *  @param pointer PointerToSymbolTable, zero if there isn't a symbol table
+ *  @param count NumberOfSymbols
+ * */
+inline auto makeCoffSymbolTable(std::span<const unsigned char> data,
+  std::uint64_t pointer,
+  std::uint64_t count,
+  std::size_t recordSize = IMAGE_SIZEOF_SYMBOL) -> CoffSymbolTable
+{
+  if (pointer == 0 || count == 0) { return {}; }
+
+  if (pointer > data.size() || count > (data.size() - pointer) / recordSize) {
+    throw PelfException{ "Invalid symbol table, it exceeds the file" };
+  }
+
+  const auto symbols = data.subspan(static_cast<std::size_t>(pointer),
+    static_cast<std::size_t>(count) * recordSize);
+  const auto rest =
+    data.subspan(static_cast<std::size_t>(pointer) + symbols.size());
+
+  if (rest.size() < 4) { return { symbols, {}, recordSize }; }
+
+  const auto strings_size = readInteger<DWORD>(rest, 0);
+  if (strings_size > rest.size()) {
+    throw PelfException{ "Invalid string table, it exceeds the file" };
+  }
+
+  return { symbols,
+    rest.first(std::max<std::size_t>(strings_size, 4)),
+    recordSize };
+}
+
+
+inline CoffSymbolTable::CoffSymbolTable(std::span<const unsigned char> symbols,
+  std::span<const unsigned char> strings,
+  std::size_t recordSize)
+  : mSymbols(symbols), mStrings(strings), mRecordSize(recordSize)
+{}
+
+inline auto CoffSymbolTable::size() const noexcept -> std::size_t
+{
+  return mSymbols.size() / mRecordSize;
+}
+
+inline auto CoffSymbolTable::empty() const noexcept -> bool
+{
+  return size() == 0;
+}
+
+inline auto CoffSymbolTable::recordSize() const noexcept -> std::size_t
+{
+  return mRecordSize;
+}
+
+inline auto CoffSymbolTable::auxCount(std::size_t index) const -> std::size_t
+{
+  return readByte(mSymbols, index * mRecordSize + mRecordSize - 1);
+}
+
+inline auto CoffSymbolTable::symbol(std::size_t index) const -> CoffSymbol
+{
+  if (index >= size()) { throw PelfException{ "Invalid symbol index" }; }
+
+  /* Name[8], Value, SectionNumber (SHORT, or LONG in IMAGE_SYMBOL_EX), Type,
+   * StorageClass, NumberOfAuxSymbols */
+  const auto record = mSymbols.subspan(index * mRecordSize, mRecordSize);
+  const bool extended = mRecordSize == IMAGE_SIZEOF_SYMBOL_EX;
+  const std::size_t type_offset = extended ? 16 : 14;
+
+  CoffSymbol symbol;
+  symbol.index = static_cast<std::uint32_t>(index);
+
+  if (readInteger<DWORD>(record, 0) == 0) {
+    symbol.name = string(readInteger<DWORD>(record, 4));
+  } else {
+    std::string_view name{ reinterpret_cast<const char*>(record.data()), 8 };
+    symbol.name = name.substr(0, name.find('\0'));
+  }
+
+  symbol.value = readInteger<DWORD>(record, 8);
+  symbol.sectionNumber =
+    extended ? static_cast<std::int32_t>(readInteger<DWORD>(record, 12))
+             : static_cast<std::int16_t>(readInteger<WORD>(record, 12));
+  symbol.type = readInteger<WORD>(record, type_offset);
+  symbol.storageClass = record[type_offset + 2];
+  symbol.numberOfAuxSymbols = record[type_offset + 3];
+
+  /* Auxiliary records past the end of the table are ignored */
+  const std::size_t aux_count =
+    std::min<std::size_t>(symbol.numberOfAuxSymbols, size() - index - 1);
+  symbol.aux =
+    mSymbols.subspan((index + 1) * mRecordSize, aux_count * mRecordSize);
+
+  return symbol;
+}
+
+inline auto CoffSymbolTable::decodeAux(const CoffSymbol& symbol) const -> CoffAux
+{
+  if (symbol.aux.empty()) { return std::monostate{}; }
+
+  const auto& aux = symbol.aux;
+
+  switch (symbol.storageClass) {
+  case IMAGE_SYM_CLASS_FILE: {
+    /* The name fills the records, it's padded with null bytes */
+    const std::string_view name{ reinterpret_cast<const char*>(aux.data()),
+      aux.size() };
+    return CoffAuxFile{ name.substr(0, name.find('\0')) };
+  }
+  case IMAGE_SYM_CLASS_FUNCTION:
+    return CoffAuxLineInfo{ readInteger<WORD>(aux, 4),
+      readInteger<DWORD>(aux, 12) };
+  case IMAGE_SYM_CLASS_WEAK_EXTERNAL:
+    return CoffAuxWeakExternal{ readInteger<DWORD>(aux, 0),
+      readInteger<DWORD>(aux, 4) };
+  case IMAGE_SYM_CLASS_CLR_TOKEN:
+    return CoffAuxClrToken{ aux[0], readInteger<DWORD>(aux, 4) };
+  case IMAGE_SYM_CLASS_STATIC:
+    /* Section definition, the symbol of a section has the value 0 */
+    if (symbol.value == 0 && symbol.sectionNumber > 0) {
+      const WORD high = mRecordSize == IMAGE_SIZEOF_SYMBOL_EX
+                          ? readInteger<WORD>(aux, 16)
+                          : WORD{ 0 };
+      return CoffAuxSection{ readInteger<DWORD>(aux, 0),
+        readInteger<WORD>(aux, 4),
+        readInteger<WORD>(aux, 6),
+        readInteger<DWORD>(aux, 8),
+        readInteger<WORD>(aux, 12) | (std::uint32_t{ high } << 16),
+        aux[14] };
+    }
+    return std::monostate{};
+  case IMAGE_SYM_CLASS_EXTERNAL:
+    if (symbol.isFunction() && symbol.sectionNumber > 0) {
+      return CoffAuxFunction{ readInteger<DWORD>(aux, 0),
+        readInteger<DWORD>(aux, 4),
+        readInteger<DWORD>(aux, 8),
+        readInteger<DWORD>(aux, 12) };
+    }
+    /* Weak externals written with the external storage class */
+    if (symbol.isUndefined()) {
+      return CoffAuxWeakExternal{ readInteger<DWORD>(aux, 0),
+        readInteger<DWORD>(aux, 4) };
+    }
+    return std::monostate{};
+  default:
+    return std::monostate{};
+  }
+}
+
+inline auto CoffSymbolTable::string(std::size_t offset) const -> std::string_view
+{
+  if (offset < 4 || offset >= mStrings.size()) {
+    throw PelfException{ "Invalid string table offset" };
+  }
+
+  const std::string_view strings{ reinterpret_cast<const char*>(mStrings.data()),
+    mStrings.size() };
+  const auto end = strings.find('\0', offset);
+
+  return strings.substr(offset,
+    end == std::string_view::npos ? std::string_view::npos : end - offset);
+}
+
+inline auto CoffSymbolTable::stringTable() const noexcept
+  -> std::span<const unsigned char>
+{
+  return mStrings;
+}
+
+inline auto CoffSymbolTable::begin() const -> Iterator
+{
+  return { this, 0 };
+}
+
+inline auto CoffSymbolTable::end() const -> Iterator
+{
+  return { this, size() };
+}
+
+
+inline CoffSymbolIndex::CoffSymbolIndex(const CoffSymbolTable& table)
+  : mTable(table)
+{
+  mEntries.reserve(table.size());
+  for (const auto& symbol : table) {
+    mEntries.emplace_back(symbol.name, symbol.index);
+  }
+
+  /* Stable by index, so `find()` returns the first symbol of the table */
+  std::sort(mEntries.begin(), mEntries.end());
+}
+
+inline auto CoffSymbolIndex::range(std::string_view name) const
+  -> std::pair<decltype(mEntries)::const_iterator,
+    decltype(mEntries)::const_iterator>
+{
+  return std::equal_range(mEntries.begin(),
+    mEntries.end(),
+    name,
+    [](const auto& a, const auto& b) {
+      if constexpr (std::is_same_v<std::decay_t<decltype(a)>, std::string_view>) {
+        return a < b.first;
+      } else {
+        return a.first < b;
+      }
+    });
+}
+
+inline auto CoffSymbolIndex::find(std::string_view name) const
+  -> std::optional<CoffSymbol>
+{
+  const auto [first, last] = range(name);
+  if (first == last) { return std::nullopt; }
+
+  return mTable.symbol(first->second);
+}
+
+inline auto CoffSymbolIndex::findAll(std::string_view name) const
+  -> std::vector<std::uint32_t>
+{
+  const auto [first, last] = range(name);
+
+  std::vector<std::uint32_t> indices;
+  indices.reserve(static_cast<std::size_t>(std::distance(first, last)));
+  for (auto entry = first; entry != last; ++entry) {
+    indices.push_back(entry->second);
+  }
+
+  return indices;
+}
+
+inline auto CoffSymbolIndex::size() const noexcept -> std::size_t
+{
+  return mEntries.size();
+}
+
+
+inline Coff::Coff(std::span<const unsigned char> data) : mData(data)
+{
+  if (data.size() < mFileHeaderSize) {
+    throw PelfException{ "Invalid COFF file, it's too small" };
+  }
+
+  std::uint64_t symbol_table{};
+  std::uint64_t number_of_symbols{};
+  std::size_t record_size = IMAGE_SIZEOF_SYMBOL;
+
+  /* Sig1 = IMAGE_FILE_MACHINE_UNKNOWN and Sig2 = 0xffff */
+  if (readInteger<WORD>(data, 0) == 0 && readInteger<WORD>(data, 2) == 0xffff) {
+    static constexpr std::array<unsigned char, 16> bigobj_class_id = { 0xc7,
+      0xa1, 0xba, 0xd1, 0xee, 0xba, 0xa9, 0x4b, 0xaf, 0x20, 0xfa, 0xf6, 0x6a,
+      0xa4, 0xdc, 0xb8 };
+
+    if (data.size() < mBigObjHeaderSize || readInteger<WORD>(data, 4) < 2
+        || !std::equal(bigobj_class_id.begin(),
+          bigobj_class_id.end(),
+          data.begin() + 12)) {
+      throw PelfException{ "Invalid COFF file, import objects aren't supported" };
+    }
+
+    mBigObj = true;
+    mMachine = readInteger<WORD>(data, 6);
+    mTimeDateStamp = readInteger<DWORD>(data, 8);
+    mNumberOfSections = readInteger<DWORD>(data, 44);
+    symbol_table = readInteger<DWORD>(data, 48);
+    number_of_symbols = readInteger<DWORD>(data, 52);
+    mSectionTable = mBigObjHeaderSize;
+    record_size = IMAGE_SIZEOF_SYMBOL_EX;
+  } else {
+    const auto header = readStruct<IMAGE_FILE_HEADER>(data, 0);
+    mMachine = header.Machine;
+    mTimeDateStamp = header.TimeDateStamp;
+    mCharacteristics = header.Characteristics;
+    mNumberOfSections = header.NumberOfSections;
+    symbol_table = header.PointerToSymbolTable;
+    number_of_symbols = header.NumberOfSymbols;
+    mSectionTable = mFileHeaderSize + header.SizeOfOptionalHeader;
+  }
+
+  if (mSectionTable > data.size()
+      || mNumberOfSections > (data.size() - mSectionTable) / mSectionHeaderSize) {
+    throw PelfException{ "Invalid COFF file, the section table exceeds it" };
+  }
+
+  mSymbols =
+    makeCoffSymbolTable(data, symbol_table, number_of_symbols, record_size);
+}
+
+inline auto Coff::isBigObj() const noexcept -> bool
+{
+  return mBigObj;
+}
+
+inline auto Coff::machine() const noexcept -> WORD
+{
+  return mMachine;
+}
+
+inline auto Coff::timeDateStamp() const noexcept -> DWORD
+{
+  return mTimeDateStamp;
+}
+
+inline auto Coff::characteristics() const noexcept -> WORD
+{
+  return mCharacteristics;
+}
+
+inline auto Coff::numberOfSections() const noexcept -> std::size_t
+{
+  return mNumberOfSections;
+}
+
+inline auto Coff::section(std::size_t index) const -> IMAGE_SECTION_HEADER
+{
+  if (index >= mNumberOfSections) {
+    throw PelfException{ "Invalid section index" };
+  }
+
+  return readStruct<IMAGE_SECTION_HEADER>(mData,
+    mSectionTable + index * mSectionHeaderSize);
+}
+
+inline auto Coff::sectionName(std::size_t index) const -> std::string_view
+{
+  if (index >= mNumberOfSections) {
+    throw PelfException{ "Invalid section index" };
+  }
+
+  const auto bytes = mData.subspan(mSectionTable + index * mSectionHeaderSize, 8);
+  std::string_view name{ reinterpret_cast<const char*>(bytes.data()), 8 };
+  name = name.substr(0, name.find('\0'));
+
+  if (name.size() < 2 || name[0] != '/') { return name; }
+
+  /* "/123" is a decimal offset, "//ABCDEF" a base64 offset */
+  std::uint64_t offset{};
+  if (name[1] == '/') {
+    for (const char c : name.substr(2)) {
+      std::uint64_t digit{};
+      if (c >= 'A' && c <= 'Z') {
+        digit = static_cast<std::uint64_t>(c - 'A');
+      } else if (c >= 'a' && c <= 'z') {
+        digit = static_cast<std::uint64_t>(c - 'a' + 26);
+      } else if (c >= '0' && c <= '9') {
+        digit = static_cast<std::uint64_t>(c - '0' + 52);
+      } else if (c == '+' || c == '/') {
+        digit = c == '+' ? 62 : 63;
+      } else {
+        return name;
+      }
+      offset = offset * 64 + digit;
+    }
+  } else {
+    for (const char c : name.substr(1)) {
+      if (c < '0' || c > '9') { return name; }
+      offset = offset * 10 + static_cast<std::uint64_t>(c - '0');
+    }
+  }
+
+  return mSymbols.string(static_cast<std::size_t>(offset));
+}
+
+inline auto Coff::sectionData(const IMAGE_SECTION_HEADER& section) const
+  -> std::span<const unsigned char>
+{
+  if (section.PointerToRawData == 0) { return {}; }
+
+  if (section.PointerToRawData > mData.size()
+      || section.SizeOfRawData > mData.size() - section.PointerToRawData) {
+    throw PelfException{ "Invalid section, it exceeds the file" };
+  }
+
+  return mData.subspan(section.PointerToRawData, section.SizeOfRawData);
+}
+
+inline auto Coff::findSection(std::string_view name) const
+  -> std::optional<std::size_t>
+{
+  for (std::size_t i{}; i < mNumberOfSections; ++i) {
+    if (sectionName(i) == name) { return i; }
+  }
+
+  return std::nullopt;
+}
+
+inline auto Coff::symbols() const noexcept -> const CoffSymbolTable&
+{
+  return mSymbols;
+}
+
+
+}// namespace pelf
+
+
+#endif
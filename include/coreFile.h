@@ -0,0 +1,588 @@
+/** @file coreFile.h
+ *  @brief CoreFile class declaration
+ *
+ *  This file contains the CoreFile class declaration, a reader of the notes
+ *  and the memory of ELF core dumps. The notes (NT_PRSTATUS, NT_PRPSINFO,
+ *  NT_AUXV and NT_FILE) are decoded by the constructor, the memory of the
+ *  process is read from the PT_LOAD segments on demand, so with an `Elf` over
+ *  a memory mapped core only the pages that are actually read are loaded from
+ *  disk
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef COREFILE_H_
+#define COREFILE_H_
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Pelf.h"
+#include "elfNotes.h"
+#include "elfStructs.h"
+#include "pelfExcept.h"
+
+
+namespace pelf {
+
+
+/** @brief State of a thread, decoded from its NT_PRSTATUS note
+ *
+ *  The spans point into the data of the file
+ * */
+struct CoreThread
+{
+  std::int32_t tid{}; /**< Thread ID (pr_pid) */
+  std::int32_t ppid{}; /**< Parent process ID */
+  std::int32_t pgrp{}; /**< Process group ID */
+  std::int32_t sid{}; /**< Session ID */
+  std::int32_t signal{}; /**< Current signal (pr_cursig) */
+  std::uint64_t pendingSignals{}; /**< Set of pending signals */
+  std::uint64_t heldSignals{}; /**< Set of blocked signals */
+  std::chrono::microseconds userTime{}; /**< User time */
+  std::chrono::microseconds systemTime{}; /**< System time */
+  std::span<const unsigned char> registers; /**< General purpose registers
+                                               (elf_gregset_t), see
+                                               `CoreFile::registerValue()` */
+  std::span<const unsigned char> fpRegisters; /**< NT_PRFPREG note, empty if
+                                                 there isn't one */
+  std::span<const unsigned char> signalInfo; /**< NT_SIGINFO note
+                                                (siginfo_t), empty if there
+                                                isn't one */
+};
+
+
+/** @brief Process information, decoded from the NT_PRPSINFO note */
+struct CoreProcessInfo
+{
+  char state{}; /**< State letter, e.g. 'R' */
+  bool zombie{}; /**< The process is a zombie */
+  std::int8_t nice{}; /**< Nice value */
+  std::uint64_t flags{}; /**< Flags of the process */
+  std::uint32_t uid{}; /**< User ID */
+  std::uint32_t gid{}; /**< Group ID */
+  std::int32_t pid{}; /**< Process ID */
+  std::int32_t ppid{}; /**< Parent process ID */
+  std::int32_t pgrp{}; /**< Process group ID */
+  std::int32_t sid{}; /**< Session ID */
+  std::string_view fileName; /**< Name of the executable, at most 15
+                                characters */
+  std::string_view arguments; /**< Beginning of the command line, at most 80
+                                 characters */
+};
+
+
+/** @brief A file mapped by the process, decoded from the NT_FILE note */
+struct CoreMappedFile
+{
+  std::uint64_t start{}; /**< First address of the mapping */
+  std::uint64_t end{}; /**< End of the mapping (exclusive) */
+  std::uint64_t fileOffset{}; /**< Offset in the file, in bytes */
+  std::string_view path; /**< Path of the file */
+};
+
+
+/** @brief Entry of the auxiliary vector (NT_AUXV) */
+struct AuxvEntry
+{
+  std::uint64_t type{}; /**< a_type, e.g. AT_ENTRY */
+  std::uint64_t value{}; /**< a_val */
+};
+
+
+/** @brief A memory region of the process (PT_LOAD segment) */
+struct CoreMemoryRegion
+{
+  std::uint64_t start{}; /**< First address */
+  std::uint64_t end{}; /**< End of the region (exclusive) */
+  std::uint32_t flags{}; /**< PF_R, PF_W and PF_X */
+  std::span<const unsigned char> data; /**< Dumped bytes, they can be fewer
+                                          than the size of the region (e.g.
+                                          code mapped from a file) or none */
+};
+
+
+/** @brief Reader of ELF core dumps
+ *
+ *  @tparam ElfType `Elf` of the core file, its data must outlive the
+ *  `CoreFile`. Using a `std::span` over a `MappedFile` as the container of the
+ *  `Elf`, `readMemory()` doesn't copy anything
+ * */
+template<class ElfType>
+class CoreFile
+{
+public:
+  /** @brief CoreFile constructor
+   *
+   *  @param elf Parsed core file (ET_CORE), the notes are decoded here. It
+   *  throws `PelfException` if the file isn't a core file or a note is
+   *  invalid
+   * */
+  explicit CoreFile(const ElfType& elf);
+
+  /** @brief Returns the threads, in the order of their NT_PRSTATUS notes (the
+   * thread that received the signal comes first) */
+  [[nodiscard]] auto threads() const noexcept -> std::span<const CoreThread>;
+
+  /** @brief Returns the NT_PRPSINFO note, `std::nullopt` if there isn't one */
+  [[nodiscard]] auto processInfo() const noexcept
+    -> const std::optional<CoreProcessInfo>&;
+
+  /** @brief Returns the files mapped by the process (NT_FILE) */
+  [[nodiscard]] auto mappedFiles() const noexcept
+    -> std::span<const CoreMappedFile>;
+
+  /** @brief Returns the file mapped at `address` */
+  [[nodiscard]] auto findMappedFile(std::uint64_t address) const
+    -> std::optional<CoreMappedFile>;
+
+  /** @brief Returns the auxiliary vector, without the AT_NULL entry */
+  [[nodiscard]] auto auxv() const noexcept -> std::span<const AuxvEntry>;
+
+  /** @brief Returns the value of the first entry of type `type` of the
+   * auxiliary vector */
+  [[nodiscard]] auto auxvValue(std::uint64_t type) const
+    -> std::optional<std::uint64_t>;
+
+  /** @brief Returns the memory regions, sorted by address */
+  [[nodiscard]] auto memoryRegions() const noexcept
+    -> std::span<const CoreMemoryRegion>;
+
+  /** @brief Returns the memory region that contains `address` */
+  [[nodiscard]] auto findRegion(std::uint64_t address) const
+    -> std::optional<CoreMemoryRegion>;
+
+  /** @brief Returns `size` bytes of the memory of the process from `address`
+   *
+   *  The bytes aren't copied, they're a span of the data of the file
+   *
+   *  @return Bytes, empty if they aren't all in the dumped part of a single
+   *  region
+   * */
+  [[nodiscard]] auto readMemory(std::uint64_t address, std::size_t size) const
+    -> std::span<const unsigned char>;
+
+  /** @brief Reads a pointer (4 or 8 bytes, in the byte order of the file)
+   * from the memory of the process, e.g. a return address on the stack */
+  [[nodiscard]] auto readPointer(std::uint64_t address) const
+    -> std::optional<std::uint64_t>;
+
+  /** @brief Returns the general purpose register at `index` of `thread`
+   *
+   *  @param index Index in elf_gregset_t, e.g. 16 is RIP for x86-64. It
+   *  throws `PelfException` if it's out of range
+   * */
+  [[nodiscard]] auto registerValue(const CoreThread& thread,
+    std::size_t index) const -> std::uint64_t;
+
+  /** @brief Returns the program counter of `thread`
+   *
+   *  @return Value, `std::nullopt` if the machine isn't x86, x86-64, Arm or
+   *  AArch64
+   * */
+  [[nodiscard]] auto programCounter(const CoreThread& thread) const
+    -> std::optional<std::uint64_t>;
+
+  /** @brief Returns the stack pointer of `thread`, same as above */
+  [[nodiscard]] auto stackPointer(const CoreThread& thread) const
+    -> std::optional<std::uint64_t>;
+
+private:
+  static constexpr std::endian mEndian{ ElfType::byteOrder }; /**< Byte order
+                                                                 of the file */
+  static constexpr std::size_t mWordSize{
+    ElfType::FileClass::ident == ELFCLASS64 ? 8 : 4
+  }; /**< Size of long and pointers */
+
+  std::uint16_t mMachine{}; /**< e_machine */
+  std::vector<CoreThread> mThreads; /**< NT_PRSTATUS notes */
+  std::optional<CoreProcessInfo> mProcessInfo; /**< NT_PRPSINFO note */
+  std::vector<CoreMappedFile> mMappedFiles; /**< NT_FILE note */
+  std::vector<AuxvEntry> mAuxv; /**< NT_AUXV note */
+  std::vector<CoreMemoryRegion> mRegions; /**< PT_LOAD segments */
+
+  /** @brief Decodes a NT_PRSTATUS note */
+  auto readThread(std::span<const unsigned char> desc) const -> CoreThread;
+
+  /** @brief Decodes a NT_PRPSINFO note */
+  auto readProcessInfo(std::span<const unsigned char> desc) const
+    -> CoreProcessInfo;
+
+  /** @brief Decodes a NT_FILE note */
+  auto readMappedFiles(std::span<const unsigned char> desc) -> void;
+
+  /** @brief Decodes a NT_AUXV note */
+  auto readAuxv(std::span<const unsigned char> desc) -> void;
+
+  /** @brief Reads a long of the file at `offset` of `data` */
+  static auto readWord(std::span<const unsigned char> data, std::size_t offset)
+    -> std::uint64_t;
+
+  /** @brief Returns the string at the beginning of `field`, without the null
+   * bytes and the trailing spaces */
+  static auto readString(std::span<const unsigned char> field)
+    -> std::string_view;
+};
+
+
+template<class ElfType>
+CoreFile<ElfType>::CoreFile(const ElfType& elf)
+  : mMachine(elf.getHeaders().elfHeader.e_machine)
+{
+  if (elf.getHeaders().elfHeader.e_type != ET_CORE) {
+    throw PelfException{ "Invalid core file, the ELF type isn't ET_CORE" };
+  }
+
+  for (const auto& segment : elf.getHeaders().programHeaders) {
+    if (segment.p_type == PT_LOAD) {
+      mRegions.push_back({ segment.p_vaddr,
+        segment.p_vaddr + segment.p_memsz,
+        segment.p_flags,
+        elf.getSegmentData(segment) });
+      continue;
+    }
+
+    if (segment.p_type != PT_NOTE) { continue; }
+
+    for (const auto& note : elf.getNotes(segment)) {
+      if (!note.isOwner("CORE")) { continue; }
+
+      switch (note.header.n_type) {
+      case NT_PRSTATUS:
+        mThreads.push_back(readThread(note.desc));
+        break;
+      /* The notes of a thread follow its NT_PRSTATUS note */
+      case NT_PRFPREG:
+        if (!mThreads.empty()) { mThreads.back().fpRegisters = note.desc; }
+        break;
+      case NT_SIGINFO:
+        if (!mThreads.empty()) { mThreads.back().signalInfo = note.desc; }
+        break;
+      case NT_PRPSINFO:
+        mProcessInfo = readProcessInfo(note.desc);
+        break;
+      case NT_FILE:
+        readMappedFiles(note.desc);
+        break;
+      case NT_AUXV:
+        readAuxv(note.desc);
+        break;
+      default:
+        break;
+      }
+    }
+  }
+
+  std::sort(mRegions.begin(),
+    mRegions.end(),
+    [](const CoreMemoryRegion& a, const CoreMemoryRegion& b) {
+      return a.start < b.start;
+    });
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::threads() const noexcept -> std::span<const CoreThread>
+{
+  return mThreads;
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::processInfo() const noexcept
+  -> const std::optional<CoreProcessInfo>&
+{
+  return mProcessInfo;
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::mappedFiles() const noexcept
+  -> std::span<const CoreMappedFile>
+{
+  return mMappedFiles;
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::findMappedFile(std::uint64_t address) const
+  -> std::optional<CoreMappedFile>
+{
+  for (const auto& file : mMappedFiles) {
+    if (address >= file.start && address < file.end) { return file; }
+  }
+
+  return std::nullopt;
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::auxv() const noexcept -> std::span<const AuxvEntry>
+{
+  return mAuxv;
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::auxvValue(std::uint64_t type) const
+  -> std::optional<std::uint64_t>
+{
+  for (const auto& entry : mAuxv) {
+    if (entry.type == type) { return entry.value; }
+  }
+
+  return std::nullopt;
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::memoryRegions() const noexcept
+  -> std::span<const CoreMemoryRegion>
+{
+  return mRegions;
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::findRegion(std::uint64_t address) const
+  -> std::optional<CoreMemoryRegion>
+{
+  /* Last region that starts at or before the address */
+  const auto next = std::upper_bound(mRegions.begin(),
+    mRegions.end(),
+    address,
+    [](std::uint64_t value, const CoreMemoryRegion& region) {
+      return value < region.start;
+    });
+
+  if (next == mRegions.begin()) { return std::nullopt; }
+
+  const auto& region = *std::prev(next);
+  if (address >= region.end) { return std::nullopt; }
+
+  return region;
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::readMemory(std::uint64_t address,
+  std::size_t size) const -> std::span<const unsigned char>
+{
+  const auto region = findRegion(address);
+  if (!region) { return {}; }
+
+  const std::uint64_t offset = address - region->start;
+  if (offset > region->data.size() || size > region->data.size() - offset) {
+    return {};
+  }
+
+  return region->data.subspan(static_cast<std::size_t>(offset), size);
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::readPointer(std::uint64_t address) const
+  -> std::optional<std::uint64_t>
+{
+  const auto bytes = readMemory(address, mWordSize);
+  if (bytes.empty()) { return std::nullopt; }
+
+  return readWord(bytes, 0);
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::registerValue(const CoreThread& thread,
+  std::size_t index) const -> std::uint64_t
+{
+  if (index >= thread.registers.size() / mWordSize) {
+    throw PelfException{ "Invalid register index" };
+  }
+
+  return readWord(thread.registers, index * mWordSize);
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::programCounter(const CoreThread& thread) const
+  -> std::optional<std::uint64_t>
+{
+  switch (mMachine) {
+  case EM_X86_64:
+    return registerValue(thread, 16);// rip
+  case EM_386:
+    return registerValue(thread, 12);// eip
+  case EM_AARCH64:
+    return registerValue(thread, 32);// pc
+  case EM_ARM:
+    return registerValue(thread, 15);// r15
+  default:
+    return std::nullopt;
+  }
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::stackPointer(const CoreThread& thread) const
+  -> std::optional<std::uint64_t>
+{
+  switch (mMachine) {
+  case EM_X86_64:
+    return registerValue(thread, 19);// rsp
+  case EM_386:
+    return registerValue(thread, 15);// uesp
+  case EM_AARCH64:
+    return registerValue(thread, 31);// sp
+  case EM_ARM:
+    return registerValue(thread, 13);// r13
+  default:
+    return std::nullopt;
+  }
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::readThread(std::span<const unsigned char> desc) const
+  -> CoreThread
+{
+  /* elf_prstatus: elf_siginfo (12 bytes), pr_cursig, four longs (the signal
+   * sets, aligned), the IDs, four timevals and then the registers followed by
+   * pr_fpvalid */
+  constexpr std::size_t w = mWordSize;
+  constexpr std::size_t registers_offset = 32 + 10 * w;
+
+  if (desc.size() < registers_offset + w) {
+    throw PelfException{ "Invalid NT_PRSTATUS note, it's too small" };
+  }
+
+  const auto time = [&](std::size_t offset) {
+    return std::chrono::seconds{ readWord(desc, offset) }
+           + std::chrono::microseconds{ readWord(desc, offset + w) };
+  };
+
+  CoreThread thread;
+  thread.signal = readInteger<std::int16_t, mEndian>(desc, 12);
+  thread.pendingSignals = readWord(desc, 16);
+  thread.heldSignals = readWord(desc, 16 + w);
+  thread.tid = readInteger<std::int32_t, mEndian>(desc, 16 + 2 * w);
+  thread.ppid = readInteger<std::int32_t, mEndian>(desc, 20 + 2 * w);
+  thread.pgrp = readInteger<std::int32_t, mEndian>(desc, 24 + 2 * w);
+  thread.sid = readInteger<std::int32_t, mEndian>(desc, 28 + 2 * w);
+  thread.userTime = time(32 + 2 * w);
+  thread.systemTime = time(32 + 4 * w);
+  thread.registers =
+    desc.subspan(registers_offset, desc.size() - registers_offset - w);
+
+  return thread;
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::readProcessInfo(
+  std::span<const unsigned char> desc) const -> CoreProcessInfo
+{
+  /* elf_prpsinfo: four chars, pr_flag (long), the IDs, pr_fname[16] and
+   * pr_psargs[80]. 32-bit x86 and Arm use 16-bit uid/gid */
+  const std::size_t flag_offset = mWordSize == 8 ? 8 : 4;
+  const std::size_t id_size = mWordSize == 8 || desc.size() != 124 ? 4 : 2;
+  const std::size_t uid_offset = flag_offset + mWordSize;
+  const std::size_t pid_offset = uid_offset + 2 * id_size;
+  const std::size_t name_offset = pid_offset + 16;
+
+  if (desc.size() < name_offset + 96) {
+    throw PelfException{ "Invalid NT_PRPSINFO note, it's too small" };
+  }
+
+  const auto id = [&](std::size_t offset) -> std::uint32_t {
+    return id_size == 4 ? readInteger<std::uint32_t, mEndian>(desc, offset)
+                        : readInteger<std::uint16_t, mEndian>(desc, offset);
+  };
+
+  CoreProcessInfo info;
+  info.state = static_cast<char>(desc[1]);// pr_sname, pr_state is a number
+  info.zombie = desc[2] != 0;
+  info.nice = static_cast<std::int8_t>(desc[3]);
+  info.flags = readWord(desc, flag_offset);
+  info.uid = id(uid_offset);
+  info.gid = id(uid_offset + id_size);
+  info.pid = readInteger<std::int32_t, mEndian>(desc, pid_offset);
+  info.ppid = readInteger<std::int32_t, mEndian>(desc, pid_offset + 4);
+  info.pgrp = readInteger<std::int32_t, mEndian>(desc, pid_offset + 8);
+  info.sid = readInteger<std::int32_t, mEndian>(desc, pid_offset + 12);
+  info.fileName = readString(desc.subspan(name_offset, 16));
+  info.arguments = readString(desc.subspan(name_offset + 16, 80));
+
+  return info;
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::readMappedFiles(std::span<const unsigned char> desc)
+  -> void
+{
+  /* count, page size, count * {start, end, page offset} and count paths */
+  constexpr std::size_t w = mWordSize;
+
+  const auto count = readWord(desc, 0);
+  const auto page_size = readWord(desc, w);
+
+  if (count > (desc.size() - 2 * w) / (3 * w)) {
+    throw PelfException{ "Invalid NT_FILE note, too many files" };
+  }
+
+  const std::string_view paths{
+    reinterpret_cast<const char*>(desc.data()), desc.size() };
+  std::size_t path_offset = 2 * w + static_cast<std::size_t>(count) * 3 * w;
+
+  mMappedFiles.reserve(static_cast<std::size_t>(count));
+  for (std::size_t i{}; i < count; ++i) {
+    const std::size_t entry = 2 * w + i * 3 * w;
+
+    const auto end = paths.find('\0', path_offset);
+    if (end == std::string_view::npos) {
+      throw PelfException{ "Invalid NT_FILE note, path out of range" };
+    }
+
+    mMappedFiles.push_back({ readWord(desc, entry),
+      readWord(desc, entry + w),
+      readWord(desc, entry + 2 * w) * page_size,
+      paths.substr(path_offset, end - path_offset) });
+    path_offset = end + 1;
+  }
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::readAuxv(std::span<const unsigned char> desc) -> void
+{
+  for (std::size_t offset{}; offset + 2 * mWordSize <= desc.size();
+       offset += 2 * mWordSize) {
+    const auto type = readWord(desc, offset);
+    if (type == AT_NULL) { break; }
+
+    mAuxv.push_back({ type, readWord(desc, offset + mWordSize) });
+  }
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::readWord(std::span<const unsigned char> data,
+  std::size_t offset) -> std::uint64_t
+{
+  if constexpr (mWordSize == 8) {
+    return readInteger<std::uint64_t, mEndian>(data, offset);
+  } else {
+    return readInteger<std::uint32_t, mEndian>(data, offset);
+  }
+}
+
+template<class ElfType>
+auto CoreFile<ElfType>::readString(std::span<const unsigned char> field)
+  -> std::string_view
+{
+  std::string_view text{ reinterpret_cast<const char*>(field.data()),
+    field.size() };
+  text = text.substr(0, text.find('\0'));
+
+  while (!text.empty() && text.back() == ' ') { text.remove_suffix(1); }
+
+  return text;
+}
+
+
+}// namespace pelf
+
+
+#endif
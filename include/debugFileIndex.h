@@ -0,0 +1,608 @@
+/** @file debugFileIndex.h
+ *  @brief DebugFileIndex class declaration
+ *
+ *  This file contains the DebugFileIndex class declaration, a persistent
+ *  index of the ELF files of a debug directory (e.g. /usr/lib/debug or a
+ *  debuginfod cache) by GNU build ID and by `.gnu_debuglink` name and CRC.
+ *  Looking up the debug file of a stripped binary maps the index and probes
+ *  a hash table instead of walking the directory
+ *
+ *  The index is a single little endian file:
+ *
+ *    header   magic "PELFDBG1", record count and the offsets below
+ *    records  one per regular file of the directory, sorted by path (path,
+ *             mtime, size, build ID, CRC), they let `update()` skip files
+ *             that didn't change
+ *    tables   two open addressing hash tables (build ID, debug link) of
+ *             16-byte slots {hash, record + 1}, load factor at most 1/2
+ *    strings  paths and build IDs referenced by the records
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef DEBUGFILEINDEX_H_
+#define DEBUGFILEINDEX_H_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "checksum.h"
+#include "mappedFile.h"
+#include "parallelFor.h"
+#include "pelfFormat.h"
+
+
+namespace pelf {
+
+
+/** @brief Index of the debug files of a directory by build ID and by debug
+ * link
+ *
+ *  e.g.
+ *
+ *    DebugFileIndex::update("/usr/lib/debug", "debug.index");
+ *    const DebugFileIndex index{ "debug.index" };
+ *    const auto path = index.findByBuildId(elf.buildId());
+ * */
+class DebugFileIndex
+{
+public:
+  /** @brief Counters returned by `update()` */
+  struct UpdateStats
+  {
+    std::size_t scanned{}; /**< Regular files found in the directory */
+    std::size_t parsed{}; /**< Files (re)read because they are new or their
+                             mtime or size changed */
+    std::size_t reused{}; /**< Files copied from the previous index */
+    std::size_t removed{}; /**< Files of the previous index that are gone */
+  };
+
+  /** @brief Opens an index written by `update()`
+   *
+   *  @param indexFile Path of the index, it throws `PelfException` if it
+   *  can't be mapped or it isn't a valid index
+   * */
+  explicit DebugFileIndex(const std::filesystem::path& indexFile);
+
+  /** @brief Crawls `root` and writes the index to `indexFile`
+   *
+   *  If `indexFile` already exists, files whose mtime and size didn't change
+   *  are taken from it without opening them. The rest are parsed by `threads`
+   *  worker threads. The new index is written to a temporary file that
+   *  replaces `indexFile`, so readers never see a partial index. Directories
+   *  that can't be opened are skipped, if the crawl fails anyway it throws a
+   *  `PelfException` and `indexFile` isn't modified
+   *
+   *  @param root Directory to be indexed (recursively)
+   *  @param indexFile Path of the index
+   *  @param threads Number of worker threads, 0 uses one per core
+   *
+   *  @return Counters of the update
+   * */
+  static auto update(const std::filesystem::path& root,
+    const std::filesystem::path& indexFile,
+    unsigned threads = 0) -> UpdateStats;
+
+  /** @brief Returns the path of the file whose build ID is `buildId`
+   *
+   *  @param buildId Bytes of the build ID, see `Elf::buildId()`
+   *
+   *  @return Path of the file, `std::nullopt` if there isn't one
+   * */
+  [[nodiscard]] auto findByBuildId(std::span<const unsigned char> buildId) const
+    -> std::optional<std::filesystem::path>;
+
+  /** @brief Returns the path of the file named `fileName` whose CRC-32 is
+   * `crc`
+   *
+   *  @param fileName Name of the file without directories, see
+   *  `Elf::debugLink()`
+   *  @param crc CRC-32 of the contents of the file
+   *
+   *  @return Path of the file, `std::nullopt` if there isn't one
+   * */
+  [[nodiscard]] auto findByDebugLink(std::string_view fileName,
+    std::uint32_t crc) const -> std::optional<std::filesystem::path>;
+
+  /** @brief Returns the number of files in the index */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+private:
+  /** @brief A file of the indexed directory */
+  struct Entry
+  {
+    std::string path; /**< Path of the file (generic format) */
+    std::int64_t mtime{}; /**< Last write time, in ticks of file_time_type */
+    std::uint64_t size{}; /**< Size of the file in bytes */
+    std::uint32_t crc{}; /**< CRC-32 of the file (ELF files only) */
+    bool elf{}; /**< `true` if the file is a valid ELF file */
+    std::vector<unsigned char> buildId; /**< Build ID, can be empty */
+  };
+
+  static constexpr char mMagic[8] = { 'P', 'E', 'L', 'F', 'D', 'B', 'G', '1' };
+  static constexpr std::size_t mHeaderSize{ 64 };
+  static constexpr std::size_t mRecordSize{ 48 };
+  static constexpr std::size_t mSlotSize{ 16 };
+  static constexpr std::uint16_t mElfFlag{ 1 };
+
+  MappedFile mFile; /**< Mapping of the index */
+  std::span<const unsigned char> mData; /**< Bytes of the index */
+  std::size_t mRecordCount{}; /**< Number of records */
+  std::size_t mRecordsOffset{}; /**< Offset of the first record */
+  std::size_t mBuildIdSlots{}; /**< Slots of the build ID table */
+  std::size_t mBuildIdOffset{}; /**< Offset of the build ID table */
+  std::size_t mLinkSlots{}; /**< Slots of the debug link table */
+  std::size_t mLinkOffset{}; /**< Offset of the debug link table */
+  std::size_t mStringsOffset{}; /**< Offset of the strings */
+
+  /** @brief Returns the bytes of the strings area at `offset` */
+  [[nodiscard]] auto strings(std::uint64_t offset, std::uint64_t size) const
+    -> std::span<const unsigned char>;
+
+  /** @brief Reads the record at `index` into an `Entry` */
+  [[nodiscard]] auto readEntry(std::size_t index) const -> Entry;
+
+  /** @brief Probes the table at `offset` with `slots` slots for `hash`,
+   * `match` is called with the record index of every candidate */
+  template<class Match>
+  [[nodiscard]] auto probe(std::size_t offset,
+    std::size_t slots,
+    std::uint64_t hash,
+    Match match) const -> std::optional<std::filesystem::path>;
+
+  /** @brief Reads `path` and fills the ELF fields of `entry`, a file that
+   * can't be read or parsed is recorded as a non ELF file */
+  static auto readFile(Entry& entry) -> void;
+
+  /** @brief Writes `entries` to `path` in the index format */
+  static auto write(const std::filesystem::path& path,
+    const std::vector<Entry>& entries) -> void;
+
+  /** @brief Hash of a build ID */
+  static constexpr auto hashBuildId(std::span<const unsigned char> buildId)
+    noexcept -> std::uint64_t;
+
+  /** @brief Hash of a debug link (file name and CRC) */
+  static constexpr auto hashDebugLink(std::string_view fileName,
+    std::uint32_t crc) noexcept -> std::uint64_t;
+};
+
+
+namespace detail {
+
+  /** @brief 64-bit FNV-1a, the hash stored in the index so it must not
+   * change between versions of the library */
+  constexpr auto fnv1a(std::span<const unsigned char> data,
+    std::uint64_t hash = 0xcbf29ce484222325) noexcept -> std::uint64_t
+  {
+    for (const auto byte : data) {
+      hash ^= byte;
+      hash *= 0x100000001b3;
+    }
+    return hash;
+  }
+
+  /** @brief Appends `value` to `out` in little endian */
+  template<class T>
+  auto appendInteger(std::vector<unsigned char>& out, T value) -> void
+  {
+    for (std::size_t i{}; i < sizeof(T); ++i) {
+      out.push_back(static_cast<unsigned char>(
+        static_cast<std::uint64_t>(value) >> (8 * i)));
+    }
+  }
+
+  /** @brief Overwrites `sizeof(T)` bytes of `out` at `offset` with `value` in
+   * little endian */
+  template<class T>
+  auto storeInteger(std::vector<unsigned char>& out,
+    std::size_t offset,
+    T value) -> void
+  {
+    for (std::size_t i{}; i < sizeof(T); ++i) {
+      out[offset + i] = static_cast<unsigned char>(
+        static_cast<std::uint64_t>(value) >> (8 * i));
+    }
+  }
+
+  /** @brief Returns the file name of a generic path (after the last '/') */
+  inline auto fileName(std::string_view path) noexcept -> std::string_view
+  {
+    const auto slash = path.rfind('/');
+    return slash == std::string_view::npos ? path : path.substr(slash + 1);
+  }
+
+}// namespace detail
+
+
+inline DebugFileIndex::DebugFileIndex(const std::filesystem::path& indexFile)
+  : mFile(indexFile), mData(mFile.bytes())
+{
+  if (mData.size() < mHeaderSize
+      || !std::equal(std::begin(mMagic), std::end(mMagic), mData.begin())) {
+    throw pelfInvalidSignature{ "Invalid debug file index magic" };
+  }
+
+  const auto field = [&](std::size_t offset) {
+    return static_cast<std::size_t>(readInteger<std::uint64_t>(mData, offset));
+  };
+
+  mRecordCount = field(8);
+  mRecordsOffset = field(16);
+  mBuildIdSlots = field(24);
+  mBuildIdOffset = field(32);
+  mLinkSlots = field(40);
+  mLinkOffset = field(48);
+  mStringsOffset = field(56);
+
+  /* Every area must be inside the file, and the tables a power of two */
+  const auto inside = [&](std::size_t offset, std::size_t count,
+                        std::size_t size) {
+    return offset <= mData.size() && count <= (mData.size() - offset) / size;
+  };
+
+  if (!inside(mRecordsOffset, mRecordCount, mRecordSize)
+      || !inside(mBuildIdOffset, mBuildIdSlots, mSlotSize)
+      || !inside(mLinkOffset, mLinkSlots, mSlotSize)
+      || mStringsOffset > mData.size() || !std::has_single_bit(mBuildIdSlots)
+      || !std::has_single_bit(mLinkSlots)) {
+    throw pelfInvalidSize{ "Invalid debug file index", mData.size() };
+  }
+}
+
+inline auto DebugFileIndex::size() const noexcept -> std::size_t
+{
+  return mRecordCount;
+}
+
+inline auto DebugFileIndex::strings(std::uint64_t offset,
+  std::uint64_t size) const -> std::span<const unsigned char>
+{
+  const auto area = mData.subspan(mStringsOffset);
+  if (offset > area.size() || size > area.size() - offset) {
+    throw PelfException{ "Invalid string in the debug file index" };
+  }
+  return area.subspan(
+    static_cast<std::size_t>(offset), static_cast<std::size_t>(size));
+}
+
+inline auto DebugFileIndex::readEntry(std::size_t index) const -> Entry
+{
+  const std::size_t offset = mRecordsOffset + index * mRecordSize;
+
+  Entry entry;
+  entry.mtime =
+    static_cast<std::int64_t>(readInteger<std::uint64_t>(mData, offset));
+  entry.size = readInteger<std::uint64_t>(mData, offset + 8);
+  const auto path_offset = readInteger<std::uint64_t>(mData, offset + 16);
+  const auto path_size = readInteger<std::uint32_t>(mData, offset + 24);
+  entry.crc = readInteger<std::uint32_t>(mData, offset + 28);
+  const auto build_id_offset = readInteger<std::uint64_t>(mData, offset + 32);
+  const auto build_id_size = readInteger<std::uint16_t>(mData, offset + 40);
+  entry.elf = (readInteger<std::uint16_t>(mData, offset + 42) & mElfFlag) != 0;
+
+  const auto path = strings(path_offset, path_size);
+  entry.path.assign(path.begin(), path.end());
+
+  const auto build_id = strings(build_id_offset, build_id_size);
+  entry.buildId.assign(build_id.begin(), build_id.end());
+
+  return entry;
+}
+
+template<class Match>
+auto DebugFileIndex::probe(std::size_t offset,
+  std::size_t slots,
+  std::uint64_t hash,
+  Match match) const -> std::optional<std::filesystem::path>
+{
+  const std::size_t mask = slots - 1;
+
+  /* Linear probing, at least half of the slots are empty so the loop ends */
+  for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+    const std::size_t slot = offset + i * mSlotSize;
+    const auto record = readInteger<std::uint64_t>(mData, slot + 8);
+
+    if (record == 0) { return std::nullopt; }
+    if (record > mRecordCount) {
+      throw PelfException{ "Invalid slot in the debug file index" };
+    }
+
+    if (readInteger<std::uint64_t>(mData, slot) == hash) {
+      auto entry = readEntry(static_cast<std::size_t>(record - 1));
+      if (match(entry)) { return std::filesystem::path{ entry.path }; }
+    }
+  }
+}
+
+inline auto DebugFileIndex::findByBuildId(
+  std::span<const unsigned char> buildId) const
+  -> std::optional<std::filesystem::path>
+{
+  if (buildId.empty()) { return std::nullopt; }
+
+  return probe(mBuildIdOffset,
+    mBuildIdSlots,
+    hashBuildId(buildId),
+    [&](const Entry& entry) {
+      return std::equal(entry.buildId.begin(),
+        entry.buildId.end(),
+        buildId.begin(),
+        buildId.end());
+    });
+}
+
+inline auto DebugFileIndex::findByDebugLink(std::string_view fileName,
+  std::uint32_t crc) const -> std::optional<std::filesystem::path>
+{
+  return probe(mLinkOffset,
+    mLinkSlots,
+    hashDebugLink(fileName, crc),
+    [&](const Entry& entry) {
+      return entry.crc == crc && detail::fileName(entry.path) == fileName;
+    });
+}
+
+constexpr auto DebugFileIndex::hashBuildId(
+  std::span<const unsigned char> buildId) noexcept -> std::uint64_t
+{
+  return detail::fnv1a(buildId);
+}
+
+constexpr auto DebugFileIndex::hashDebugLink(std::string_view fileName,
+  std::uint32_t crc) noexcept -> std::uint64_t
+{
+  const unsigned char crc_bytes[4] = { static_cast<unsigned char>(crc),
+    static_cast<unsigned char>(crc >> 8),
+    static_cast<unsigned char>(crc >> 16),
+    static_cast<unsigned char>(crc >> 24) };
+
+  std::uint64_t hash = detail::fnv1a(crc_bytes);
+  for (const char c : fileName) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+inline auto DebugFileIndex::readFile(Entry& entry) -> void
+{
+  entry.elf = false;
+  entry.crc = 0;
+  entry.buildId.clear();
+
+  try {
+    const MappedFile file{ std::filesystem::path{ entry.path } };
+    const auto bytes = file.bytes();
+
+    if (detectFormat(bytes) != FileFormat::Elf) { return; }
+
+    std::visit(
+      [&](const auto& parsed) {
+        if constexpr (requires { parsed.buildId(); }) {
+          const auto build_id = parsed.buildId();
+          entry.buildId.assign(build_id.begin(), build_id.end());
+          entry.elf = true;
+        }
+      },
+      open(bytes));
+
+    /* Only ELF files can be the target of a debug link */
+    if (entry.elf) { entry.crc = crc32(bytes); }
+  } catch (const std::exception&) {
+    /* Unreadable or malformed files are recorded as non ELF files so they
+     * aren't parsed again until they change */
+    entry.elf = false;
+    entry.crc = 0;
+    entry.buildId.clear();
+  }
+}
+
+inline auto DebugFileIndex::write(const std::filesystem::path& path,
+  const std::vector<Entry>& entries) -> void
+{
+  /* Tables with at least twice as many slots as keys */
+  const auto table_slots = [](std::size_t keys) {
+    return std::bit_ceil(std::max<std::size_t>(keys * 2, 2));
+  };
+
+  std::size_t build_id_keys{};
+  std::size_t link_keys{};
+  for (const auto& entry : entries) {
+    build_id_keys += !entry.buildId.empty();
+    link_keys += entry.elf;
+  }
+
+  const std::size_t build_id_slots = table_slots(build_id_keys);
+  const std::size_t link_slots = table_slots(link_keys);
+
+  const std::size_t records_offset = mHeaderSize;
+  const std::size_t build_id_offset =
+    records_offset + entries.size() * mRecordSize;
+  const std::size_t link_offset = build_id_offset + build_id_slots * mSlotSize;
+  const std::size_t strings_offset = link_offset + link_slots * mSlotSize;
+
+  std::vector<unsigned char> out;
+  out.reserve(strings_offset);
+  out.insert(out.end(), std::begin(mMagic), std::end(mMagic));
+  for (const std::size_t value : { entries.size(),
+         records_offset,
+         build_id_slots,
+         build_id_offset,
+         link_slots,
+         link_offset,
+         strings_offset }) {
+    detail::appendInteger<std::uint64_t>(out, value);
+  }
+
+  std::vector<unsigned char> strings;
+  for (const auto& entry : entries) {
+    detail::appendInteger<std::uint64_t>(
+      out, static_cast<std::uint64_t>(entry.mtime));
+    detail::appendInteger<std::uint64_t>(out, entry.size);
+    detail::appendInteger<std::uint64_t>(out, strings.size());
+    detail::appendInteger<std::uint32_t>(
+      out, static_cast<std::uint32_t>(entry.path.size()));
+    strings.insert(strings.end(), entry.path.begin(), entry.path.end());
+    detail::appendInteger<std::uint32_t>(out, entry.crc);
+    detail::appendInteger<std::uint64_t>(out, strings.size());
+    strings.insert(strings.end(), entry.buildId.begin(), entry.buildId.end());
+    detail::appendInteger<std::uint16_t>(
+      out, static_cast<std::uint16_t>(entry.buildId.size()));
+    detail::appendInteger<std::uint16_t>(
+      out, static_cast<std::uint16_t>(entry.elf ? mElfFlag : 0));
+    detail::appendInteger<std::uint32_t>(out, 0);
+  }
+
+  out.resize(strings_offset);
+
+  const auto insert = [&](std::size_t offset,
+                        std::size_t slots,
+                        std::uint64_t hash,
+                        std::size_t record) {
+    for (std::size_t i = hash & (slots - 1);; i = (i + 1) & (slots - 1)) {
+      const std::size_t slot = offset + i * mSlotSize;
+      if (readInteger<std::uint64_t>(out, slot + 8) == 0) {
+        detail::storeInteger<std::uint64_t>(out, slot, hash);
+        detail::storeInteger<std::uint64_t>(out, slot + 8, record + 1);
+        return;
+      }
+    }
+  };
+
+  for (std::size_t i{}; i < entries.size(); ++i) {
+    const auto& entry = entries[i];
+    if (!entry.buildId.empty()) {
+      insert(
+        build_id_offset, build_id_slots, hashBuildId(entry.buildId), i);
+    }
+    if (entry.elf) {
+      insert(link_offset,
+        link_slots,
+        hashDebugLink(detail::fileName(entry.path), entry.crc),
+        i);
+    }
+  }
+
+  out.insert(out.end(), strings.begin(), strings.end());
+
+  /* Written next to the index and renamed, the rename is atomic */
+  auto temporary = path;
+  temporary += ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(out.data()),
+      static_cast<std::streamsize>(out.size()));
+    if (!file) { throw PelfException{ "Unable to write the debug file index" }; }
+  }
+  std::filesystem::rename(temporary, path);
+}
+
+inline auto DebugFileIndex::update(const std::filesystem::path& root,
+  const std::filesystem::path& indexFile,
+  unsigned threads) -> UpdateStats
+{
+  UpdateStats stats;
+
+  /* Entries of the previous index by path, an invalid or missing index
+   * means everything is parsed again */
+  std::unordered_map<std::string, Entry> previous;
+  std::error_code error;
+  if (std::filesystem::exists(indexFile, error)) {
+    try {
+      const DebugFileIndex old{ indexFile };
+      for (std::size_t i{}; i < old.size(); ++i) {
+        auto entry = old.readEntry(i);
+        auto path = entry.path;
+        previous.emplace(std::move(path), std::move(entry));
+      }
+    } catch (const PelfException&) {
+      previous.clear();
+    }
+  }
+
+  std::vector<Entry> entries;
+  std::vector<std::size_t> pending;
+
+  const auto options =
+    std::filesystem::directory_options::skip_permission_denied;
+  auto it = std::filesystem::recursive_directory_iterator(root, options);
+  for (; !error && it != std::filesystem::recursive_directory_iterator();
+       it.increment(error)) {
+    if (it->is_directory(error) && !it->is_symlink(error)) {
+      /* The iterator ends when it can't open the directory it enters, so a
+       * directory that can't be opened is skipped instead */
+      const std::filesystem::directory_iterator probe(
+        it->path(), options, error);
+      if (error) { it.disable_recursion_pending(); }
+      continue;
+    }
+    if (!it->is_regular_file(error)) { continue; }
+
+    Entry entry;
+    entry.path = it->path().generic_string();
+    entry.size = it->file_size(error);
+    if (error) { continue; }
+    entry.mtime = it->last_write_time(error).time_since_epoch().count();
+    if (error) { continue; }
+
+    ++stats.scanned;
+
+    const auto old = previous.find(entry.path);
+    if (old != previous.end() && old->second.mtime == entry.mtime
+        && old->second.size == entry.size) {
+      entries.push_back(std::move(old->second));
+      previous.erase(old);
+      ++stats.reused;
+    } else {
+      if (old != previous.end()) { previous.erase(old); }
+      pending.push_back(entries.size());
+      entries.push_back(std::move(entry));
+    }
+  }
+
+  /* Writing a partial crawl would record the files that weren't visited as
+   * removed */
+  if (error) {
+    throw PelfException{
+      "Unable to read the directory of the debug file index"
+    };
+  }
+
+  stats.removed = previous.size();
+  stats.parsed = pending.size();
+
+  /* New and modified files are parsed in parallel */
+  detail::parallelFor(pending.size(), threads,
+    [&](std::size_t i) { readFile(entries[pending[i]]); });
+
+  /* Sorted by path so the same directory always produces the same index */
+  std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    return a.path < b.path;
+  });
+
+  write(indexFile, entries);
+
+  return stats;
+}
+
+
+}// namespace pelf
+
+
+#endif
@@ -0,0 +1,148 @@
+/** @file decompress.h
+ *  @brief Decompression of SHF_COMPRESSED sections
+ *
+ *  This file contains `decompress()`, it inflates the data of a compressed
+ *  section straight into the output buffer. The codecs are optional because
+ *  they need an external library:
+ *
+ *    PELF_USE_ZLIB  enables ELFCOMPRESS_ZLIB (link with -lz)
+ *    PELF_USE_ZSTD  enables ELFCOMPRESS_ZSTD (link with -lzstd)
+ *
+ *  Without them compressed sections can still be found and their headers
+ *  read, `decompress()` throws `PelfException`
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef DECOMPRESS_H_
+#define DECOMPRESS_H_
+
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#if defined(PELF_USE_ZLIB)
+#include <zlib.h>
+#endif
+
+#if defined(PELF_USE_ZSTD)
+#include <zstd.h>
+#endif
+
+#include "pelfExcept.h"
+#include "elfStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief Returns `true` if `decompress()` supports the algorithm `type`
+ *
+ *  @param type `ch_type` of the compression header (ELFCOMPRESS_*)
+ * */
+constexpr auto isCompressionSupported(std::uint32_t type) noexcept -> bool
+{
+#if defined(PELF_USE_ZLIB)
+  if (type == ELFCOMPRESS_ZLIB) { return true; }
+#endif
+#if defined(PELF_USE_ZSTD)
+  if (type == ELFCOMPRESS_ZSTD) { return true; }
+#endif
+  static_cast<void>(type);
+  return false;
+}
+
+
+/** @brief Returns the largest ratio between the uncompressed and the
+ * compressed size that the algorithm `type` can reach
+ *
+ *  deflate can't expand a stream more than 1032:1 and a zstd RLE block
+ *  repeats a byte up to 128 KiB with a 4 byte block. A larger `ch_size`
+ *  can't be valid, so it's rejected before the buffer is allocated
+ *
+ *  @param type `ch_type` of the compression header (ELFCOMPRESS_*)
+ *  @return Ratio, 1 for unknown algorithms
+ * */
+constexpr auto maxCompressionRatio(std::uint32_t type) noexcept
+  -> std::uint64_t
+{
+  if (type == ELFCOMPRESS_ZLIB) { return 1032; }
+  if (type == ELFCOMPRESS_ZSTD) { return 32768; }
+  return 1;
+}
+
+
+/** @brief Decompresses `input` into `output`
+ *
+ *  The whole output is produced by a single call to the codec, there's no
+ *  intermediate buffer
+ *
+ *  @param type `ch_type` of the compression header (ELFCOMPRESS_*)
+ *  @param input Compressed data (after the compression header)
+ *  @param output Buffer of exactly `ch_size` bytes
+ *
+ *  It throws `PelfException` if the algorithm isn't supported, the data is
+ *  corrupted or its uncompressed size isn't `output.size()`
+ * */
+inline auto decompress(std::uint32_t type,
+  std::span<const unsigned char> input,
+  std::span<unsigned char> output) -> void
+{
+#if defined(PELF_USE_ZLIB)
+  if (type == ELFCOMPRESS_ZLIB) {
+    /* zlib counts in uInt, sections bigger than 4 GiB would need a loop */
+    if (input.size() > std::numeric_limits<uInt>::max()
+        || output.size() > std::numeric_limits<uInt>::max()) {
+      throw PelfException{ "Compressed section is too big for zlib" };
+    }
+
+    z_stream stream{};
+    if (inflateInit(&stream) != Z_OK) {
+      throw PelfException{ "Unable to initialize zlib" };
+    }
+
+    stream.next_in = const_cast<Bytef*>(input.data());
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = output.data();
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    const int result = inflate(&stream, Z_FINISH);
+    const auto produced = stream.total_out;
+    inflateEnd(&stream);
+
+    if (result != Z_STREAM_END || produced != output.size()) {
+      throw PelfException{ "Invalid zlib compressed section" };
+    }
+    return;
+  }
+#endif
+
+#if defined(PELF_USE_ZSTD)
+  if (type == ELFCOMPRESS_ZSTD) {
+    const std::size_t produced = ZSTD_decompress(
+      output.data(), output.size(), input.data(), input.size());
+
+    if (ZSTD_isError(produced) != 0 || produced != output.size()) {
+      throw PelfException{ "Invalid zstd compressed section" };
+    }
+    return;
+  }
+#endif
+
+  static_cast<void>(input);
+  static_cast<void>(output);
+
+  if (type == ELFCOMPRESS_ZLIB || type == ELFCOMPRESS_ZSTD) {
+    throw PelfException{ "Support for the compression algorithm of the "
+                         "section isn't enabled (PELF_USE_ZLIB/PELF_USE_ZSTD)" };
+  }
+  throw PelfException{ "Unknown compression algorithm" };
+}
+
+
+}// namespace pelf
+
+
+#endif
@@ -0,0 +1,1142 @@
+/** @file dwarfLine.h
+ *  @brief LineProgram, DebugLine and LineTable class declarations
+ *
+ *  This file contains a decoder of the DWARF line number information
+ *  (`.debug_line`, versions 2 to 5). `DebugLine` walks the line programs of
+ *  the section (one per compilation unit), `LineProgram` runs the state
+ *  machine of one of them and produces its rows lazily, and `LineTable`
+ *  collects the rows into a compact table sorted by address that maps
+ *  addresses to file:line:column
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef DWARFLINE_H_
+#define DWARFLINE_H_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "pelfExcept.h"
+#include "dwarfStructs.h"
+#include "dwarfReader.h"
+#include "elfStructs.h"
+#include "sectionCache.h"
+
+
+namespace pelf {
+
+
+/** @brief Contents of the sections needed to decode the line programs
+ *
+ *  The string sections are only used by DWARF 5, they can be empty otherwise
+ * */
+struct LineSections
+{
+  std::span<const unsigned char> line; /**< `.debug_line` */
+  std::span<const unsigned char> lineStr; /**< `.debug_line_str` */
+  std::span<const unsigned char> str; /**< `.debug_str` */
+};
+
+
+/** @brief Entry of the file name table of a line program */
+struct LineFileEntry
+{
+  std::string_view name; /**< File name, relative to its directory */
+  std::uint64_t directory{}; /**< Index in the directory table */
+};
+
+
+/** @brief Header of a line program
+ *
+ *  Offsets are relative to the beginning of `.debug_line`
+ * */
+struct LineProgramHeader
+{
+  std::size_t offset{}; /**< Offset of the unit (its length field) */
+  std::size_t programOffset{}; /**< Offset of the first opcode */
+  std::size_t endOffset{}; /**< Offset of the first byte after the unit */
+  std::uint16_t version{}; /**< DWARF version, 2 to 5 */
+  std::uint8_t offsetSize{ 4 }; /**< 4 (32-bit DWARF) or 8 (64-bit DWARF) */
+  std::uint8_t addressSize{}; /**< Size of the target addresses */
+  std::uint8_t minInstructionLength{}; /**< Size of the smallest instruction */
+  std::uint8_t maxOpsPerInstruction{ 1 }; /**< Operations per instruction,
+                                             greater than 1 for VLIW */
+  bool defaultIsStmt{}; /**< Initial value of the is_stmt register */
+  std::int8_t lineBase{}; /**< Smallest line advance of a special opcode */
+  std::uint8_t lineRange{}; /**< Number of line advances of special opcodes */
+  std::uint8_t opcodeBase{}; /**< First special opcode */
+  std::span<const unsigned char> standardOpcodeLengths; /**< Number of LEB128
+    operands of the standard opcodes 1 to `opcodeBase - 1` */
+  std::vector<std::string_view> directories; /**< Include directories, for
+    DWARF 5 the first one is the compilation directory */
+  std::vector<LineFileEntry> files; /**< File names, DWARF 5 tables start at
+    index 0 and older ones at 1 */
+};
+
+
+/** @brief Row of the line number matrix, the registers of the state machine
+ * when a row is appended */
+struct LineRow
+{
+  std::uint64_t address{}; /**< Address of the instruction */
+  std::uint32_t file{}; /**< Index in the file name table */
+  std::uint32_t line{}; /**< Source line, 0 if there isn't one */
+  std::uint32_t column{}; /**< Source column, 0 for the whole line */
+  std::uint32_t discriminator{}; /**< Block of the line the instruction
+                                    belongs to */
+  std::uint8_t opIndex{}; /**< Operation of a VLIW instruction */
+  bool isStmt{}; /**< Recommended breakpoint location */
+  bool basicBlock{}; /**< Beginning of a basic block */
+  bool endSequence{}; /**< First address after the end of a sequence, the
+                         other registers aren't meaningful */
+  bool prologueEnd{}; /**< Where the prologue of a function ends */
+  bool epilogueBegin{}; /**< Where the epilogue of a function begins */
+};
+
+
+template<std::endian Endian> class LineRowIterator;
+
+
+/** @brief Line program of a compilation unit
+ *
+ *  The header is decoded by the constructor and the rows are produced by the
+ *  state machine while iterating, e.g.
+ *  `for (const auto& row : program) { ... }`
+ *
+ *  @tparam Endian Byte order of the file
+ * */
+template<std::endian Endian = std::endian::little>
+class LineProgram
+{
+public:
+  /** @brief LineProgram constructor
+   *
+   *  @param sections Contents of the line and string sections, they must
+   *  outlive the program
+   *  @param offset Offset of the unit in `.debug_line` (DW_AT_stmt_list)
+   *  @param addressSize Size of the addresses for versions before 5, whose
+   *  header doesn't say it (8 for ELFCLASS64, 4 for ELFCLASS32)
+   *
+   *  It throws `PelfException` if the header is invalid or uses a form that
+   *  isn't supported
+   * */
+  LineProgram(const LineSections& sections, std::size_t offset,
+    std::uint8_t addressSize);
+
+  /** @brief Returns the decoded header */
+  [[nodiscard]] auto header() const noexcept -> const LineProgramHeader&;
+
+  /** @brief Returns the size of the unit, including its length field */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  /** @brief Returns the path of the file `file` of the file name table
+   *
+   *  @param file Value of the file register of a row
+   *
+   *  @return The name of the file joined to its directory, `std::nullopt` if
+   *  `file` isn't in the table
+   * */
+  [[nodiscard]] auto filePath(std::uint64_t file) const
+    -> std::optional<std::string>;
+
+  [[nodiscard]] auto begin() const -> LineRowIterator<Endian>;
+
+  [[nodiscard]] auto end() const noexcept -> LineRowIterator<Endian>;
+
+  /** @brief Runs the whole program calling `callback` with every row
+   *
+   *  It's the same as iterating over the program, without the iterator
+   *
+   *  @param callback Called with a `const LineRow&`
+   * */
+  template<class Callback> auto forEachRow(Callback&& callback) const -> void;
+
+private:
+  friend class LineRowIterator<Endian>;
+
+  /** @brief Registers of the state machine and position in the program */
+  struct State
+  {
+    DwarfReader<Endian> reader; /**< Next opcode */
+    LineRow row; /**< Registers, the last row appended */
+  };
+
+  /** @brief Operation and line advances of a special opcode */
+  struct SpecialOpcode
+  {
+    std::uint8_t operation{}; /**< Operation advance */
+    std::int16_t line{}; /**< Line advance */
+  };
+
+  LineProgramHeader mHeader; /**< Decoded header */
+  std::span<const unsigned char> mProgram; /**< Opcodes of the program */
+  std::array<SpecialOpcode, 256> mSpecial{}; /**< Advances of the special
+    opcodes, computed once instead of dividing for every opcode */
+
+  /** @brief Reads the DWARF 5 directory or file name table at the reader
+   *
+   *  @param reader Reader at the entry format count
+   *  @param sections String sections used by the `strp` forms
+   *  @param add Called with every `LineFileEntry`
+   * */
+  template<class Add>
+  static auto readEntries(DwarfReader<Endian>& reader,
+    const LineSections& sections, std::uint8_t offsetSize, Add&& add) -> void;
+
+  /** @brief Returns the state machine at the beginning of the program */
+  [[nodiscard]] auto start() const noexcept -> State;
+
+  /** @brief Runs the program until it appends a row
+   *
+   *  @param state State of the machine, `state.row` is the new row
+   *
+   *  @return `false` once the end of the program is reached
+   * */
+  auto step(State& state) const -> bool;
+};
+
+
+/** @brief Forward iterator over the rows of a `LineProgram`
+ *
+ *  The program must outlive the iterator
+ *
+ *  @tparam Endian Byte order of the file
+ * */
+template<std::endian Endian = std::endian::little>
+class LineRowIterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = LineRow;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const LineRow*;
+  using reference = const LineRow&;
+
+  /** @brief Constructs the end iterator */
+  LineRowIterator() = default;
+
+  /** @brief LineRowIterator constructor, it points to the first row of
+   * `program` */
+  explicit LineRowIterator(const LineProgram<Endian>& program);
+
+  [[nodiscard]] auto operator*() const noexcept -> reference;
+
+  [[nodiscard]] auto operator->() const noexcept -> pointer;
+
+  auto operator++() -> LineRowIterator&;
+
+  auto operator++(int) -> LineRowIterator;
+
+  [[nodiscard]] auto operator==(const LineRowIterator& other) const noexcept
+    -> bool;
+
+private:
+  const LineProgram<Endian>* mProgram{}; /**< nullptr for the end iterator */
+  typename LineProgram<Endian>::State mState{}; /**< State of the machine */
+};
+
+
+/** @brief Forward iterator over the line programs of `.debug_line`
+ *
+ *  A program is only decoded when the iterator reaches it
+ *
+ *  @tparam Endian Byte order of the file
+ * */
+template<std::endian Endian = std::endian::little>
+class LineProgramIterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = LineProgram<Endian>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const LineProgram<Endian>*;
+  using reference = const LineProgram<Endian>&;
+
+  /** @brief Constructs the end iterator */
+  LineProgramIterator() = default;
+
+  /** @brief LineProgramIterator constructor
+   *
+   *  @param sections Contents of the line and string sections
+   *  @param addressSize Size of the addresses for versions before 5
+   * */
+  LineProgramIterator(const LineSections& sections, std::uint8_t addressSize);
+
+  [[nodiscard]] auto operator*() const noexcept -> reference;
+
+  [[nodiscard]] auto operator->() const noexcept -> pointer;
+
+  auto operator++() -> LineProgramIterator&;
+
+  auto operator++(int) -> LineProgramIterator;
+
+  [[nodiscard]] auto operator==(const LineProgramIterator& other) const
+    noexcept -> bool;
+
+private:
+  LineSections mSections; /**< Contents of the sections */
+  std::uint8_t mAddressSize{}; /**< Size of the addresses */
+  std::optional<LineProgram<Endian>> mProgram; /**< Current program, empty
+    for the end iterator */
+};
+
+
+/** @brief Line programs of a `.debug_line` section
+ *
+ *  e.g. `for (const auto& program : DebugLine{ sections, 8 })`
+ *
+ *  @tparam Endian Byte order of the file
+ * */
+template<std::endian Endian = std::endian::little>
+class DebugLine
+{
+public:
+  /** @brief DebugLine constructor
+   *
+   *  @param sections Contents of the line and string sections, they must
+   *  outlive the `DebugLine` and the programs
+   *  @param addressSize Size of the addresses for versions before 5
+   * */
+  DebugLine(const LineSections& sections, std::uint8_t addressSize) noexcept;
+
+  /** @brief Returns the program at `offset` of `.debug_line`
+   *
+   *  @param offset DW_AT_stmt_list of a compilation unit
+   * */
+  [[nodiscard]] auto program(std::size_t offset) const -> LineProgram<Endian>;
+
+  [[nodiscard]] auto begin() const -> LineProgramIterator<Endian>;
+
+  [[nodiscard]] auto end() const noexcept -> LineProgramIterator<Endian>;
+
+private:
+  LineSections mSections; /**< Contents of the sections */
+  std::uint8_t mAddressSize; /**< Size of the addresses */
+};
+
+
+/** @brief Returns the line programs of a parsed `Elf`
+ *
+ *  The sections are read (and decompressed) through `cache`
+ *
+ *  @param cache Cache of the sections of the file, it must outlive the result
+ *
+ *  @return DebugLine, without programs if the file has no `.debug_line`
+ * */
+template<class ElfType>
+auto makeDebugLine(SectionCache<ElfType>& cache)
+  -> DebugLine<ElfType::byteOrder>;
+
+
+/** @brief Table sorted by address that maps addresses to file:line:column
+ *
+ *  Every row takes 24 bytes, the file paths are stored once per table. Rows
+ *  of the same sequence with the same address are collapsed into the last
+ *  one, which is the one debuggers report
+ * */
+class LineTable
+{
+public:
+  /** @brief Source location of an address
+   *
+   *  `file` points into the table, it's valid until the table is modified
+   *  or destroyed
+   * */
+  struct Location
+  {
+    std::string_view file; /**< Path of the source file */
+    std::uint32_t line{}; /**< Line, 0 if the address has no line */
+    std::uint32_t column{}; /**< Column, 0 for the whole line */
+  };
+
+  LineTable() = default;
+
+  /** @brief Builds the table from every program of `debugLine` */
+  template<std::endian Endian>
+  explicit LineTable(const DebugLine<Endian>& debugLine);
+
+  /** @brief Adds the rows of a program to the table
+   *
+   *  Programs can be added one at a time, e.g. only the ones of the
+   *  compilation units that are actually queried
+   *
+   *  @param program Line program of a compilation unit
+   * */
+  template<std::endian Endian>
+  auto add(const LineProgram<Endian>& program) -> void;
+
+  /** @brief Returns the location of the instruction at `address`
+   *
+   *  @return Location, `std::nullopt` if no sequence contains `address`
+   * */
+  [[nodiscard]] auto lookup(std::uint64_t address) const
+    -> std::optional<Location>;
+
+  /** @brief Looks up many addresses at once
+   *
+   *  The addresses are visited in increasing order so each search starts
+   *  where the previous one ended, it's faster than a lookup per address
+   *  when there are many of them
+   *
+   *  @param addresses Addresses to look up, in any order
+   *  @param locations Output, `locations[i]` is the location of
+   *  `addresses[i]`. It throws `pelfInvalidSize` if it isn't as big as
+   *  `addresses`
+   * */
+  auto lookup(std::span<const std::uint64_t> addresses,
+    std::span<std::optional<Location>> locations) const -> void;
+
+  /** @brief Returns the number of rows */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  /** @brief Returns the number of bytes used by the rows and the paths */
+  [[nodiscard]] auto memoryUsage() const noexcept -> std::size_t;
+
+private:
+  /** @brief Compact row of the table */
+  struct Row
+  {
+    std::uint64_t address{}; /**< Address of the instruction */
+    std::uint32_t file{}; /**< Index in `mFiles` */
+    std::uint32_t line{}; /**< Source line */
+    std::uint32_t column{}; /**< Source column */
+    bool endSequence{}; /**< First address after a sequence */
+  };
+
+  std::vector<Row> mRows; /**< Rows sorted by address */
+  std::vector<std::string> mFiles; /**< Paths of the source files */
+  std::unordered_map<std::string, std::uint32_t> mFileIndex; /**< Index of
+    every path in `mFiles` */
+
+  /** @brief Returns the index of `path` in `mFiles`, adding it if needed */
+  auto addFile(std::string&& path) -> std::uint32_t;
+
+  /** @brief Returns the location of a row, `std::nullopt` for the end of a
+   * sequence */
+  [[nodiscard]] auto location(const Row& row) const -> std::optional<Location>;
+
+  /** @brief Order of the rows, an end of sequence goes before a row of
+   * another sequence that starts at the same address */
+  static auto before(const Row& lhs, const Row& rhs) noexcept -> bool;
+
+  /** @brief Appends the rows of a program without sorting them */
+  template<std::endian Endian>
+  auto append(const LineProgram<Endian>& program) -> void;
+
+  /** @brief Sorts the rows from `first` to the end
+   *
+   *  Each sequence is already sorted, so the sequences are sorted by their
+   *  first address and the rows are only sorted one by one if two sequences
+   *  overlap
+   * */
+  auto sortSequences(std::size_t first) -> void;
+};
+
+
+template<std::endian Endian>
+LineProgram<Endian>::LineProgram(const LineSections& sections,
+  std::size_t offset, std::uint8_t addressSize)
+{
+  DwarfReader<Endian> reader{ sections.line };
+  reader.seek(offset);
+
+  auto& header = mHeader;
+  header.offset = offset;
+
+  const auto length = reader.readUnitLength();
+  header.offsetSize = length.offsetSize;
+  header.endOffset = reader.offset() + static_cast<std::size_t>(length.length);
+
+  header.version = reader.template read<std::uint16_t>();
+  if (header.version < 2 || header.version > 5) {
+    throw PelfException{ "Unsupported version of the line program" };
+  }
+
+  header.addressSize = addressSize;
+  if (header.version >= 5) {
+    header.addressSize = reader.template read<std::uint8_t>();
+    /* segment_selector_size, segmented addresses aren't used by ELF targets */
+    reader.skip(1);
+  }
+
+  const auto header_length = reader.readOffset(header.offsetSize);
+  if (header_length > header.endOffset - reader.offset()) {
+    throw PelfException{ "Invalid line program, header exceeds the unit" };
+  }
+  header.programOffset =
+    reader.offset() + static_cast<std::size_t>(header_length);
+
+  header.minInstructionLength = reader.template read<std::uint8_t>();
+  if (header.version >= 4) {
+    header.maxOpsPerInstruction = reader.template read<std::uint8_t>();
+  }
+  header.defaultIsStmt = reader.template read<std::uint8_t>() != 0;
+  header.lineBase = static_cast<std::int8_t>(reader.template read<std::uint8_t>());
+  header.lineRange = reader.template read<std::uint8_t>();
+  header.opcodeBase = reader.template read<std::uint8_t>();
+
+  if (header.lineRange == 0 || header.opcodeBase == 0
+      || header.maxOpsPerInstruction == 0) {
+    throw PelfException{ "Invalid line program header" };
+  }
+
+  header.standardOpcodeLengths = reader.readBytes(header.opcodeBase - 1U);
+
+  if (header.version >= 5) {
+    readEntries(reader, sections, header.offsetSize,
+      [&](const LineFileEntry& entry) {
+        header.directories.push_back(entry.name);
+      });
+    readEntries(reader, sections, header.offsetSize,
+      [&](const LineFileEntry& entry) { header.files.push_back(entry); });
+  } else {
+    for (auto directory = reader.readString(); !directory.empty();
+         directory = reader.readString()) {
+      header.directories.push_back(directory);
+    }
+
+    for (auto name = reader.readString(); !name.empty();
+         name = reader.readString()) {
+      LineFileEntry entry{ name, reader.readUleb128() };
+      /* Modification time and size */
+      static_cast<void>(reader.readUleb128());
+      static_cast<void>(reader.readUleb128());
+      header.files.push_back(entry);
+    }
+  }
+
+  if (reader.offset() > header.programOffset) {
+    throw PelfException{ "Invalid line program, header exceeds its length" };
+  }
+
+  mProgram = sections.line.subspan(
+    header.programOffset, header.endOffset - header.programOffset);
+
+  for (std::size_t opcode = header.opcodeBase; opcode < mSpecial.size();
+       ++opcode) {
+    const auto adjusted = opcode - header.opcodeBase;
+    mSpecial[opcode].operation =
+      static_cast<std::uint8_t>(adjusted / header.lineRange);
+    mSpecial[opcode].line =
+      static_cast<std::int16_t>(header.lineBase + adjusted % header.lineRange);
+  }
+}
+
+template<std::endian Endian>
+template<class Add>
+auto LineProgram<Endian>::readEntries(DwarfReader<Endian>& reader,
+  const LineSections& sections, std::uint8_t offsetSize, Add&& add) -> void
+{
+  struct Format
+  {
+    std::uint64_t type; /**< DW_LNCT_* */
+    std::uint64_t form; /**< DW_FORM_* */
+  };
+
+  const auto format_count = reader.template read<std::uint8_t>();
+  std::array<Format, 256> formats{};
+  for (std::size_t i{}; i < format_count; ++i) {
+    formats[i] = { reader.readUleb128(), reader.readUleb128() };
+  }
+
+  const auto count = reader.readUleb128();
+  for (std::uint64_t i{}; i < count; ++i) {
+    LineFileEntry entry;
+
+    for (std::size_t f{}; f < format_count; ++f) {
+      const auto [type, form] = formats[f];
+
+      std::uint64_t value{};
+      std::string_view string;
+
+      switch (form) {
+      case DW_FORM_string:
+        string = reader.readString();
+        break;
+      case DW_FORM_line_strp:
+        string = readStringAt(sections.lineStr, reader.readOffset(offsetSize));
+        break;
+      case DW_FORM_strp:
+        string = readStringAt(sections.str, reader.readOffset(offsetSize));
+        break;
+      case DW_FORM_data1:
+        value = reader.template read<std::uint8_t>();
+        break;
+      case DW_FORM_data2:
+        value = reader.template read<std::uint16_t>();
+        break;
+      case DW_FORM_data4:
+        value = reader.template read<std::uint32_t>();
+        break;
+      case DW_FORM_data8:
+        value = reader.template read<std::uint64_t>();
+        break;
+      case DW_FORM_udata:
+        value = reader.readUleb128();
+        break;
+      case DW_FORM_data16:
+        reader.skip(16);
+        break;
+      case DW_FORM_block:
+        reader.skip(static_cast<std::size_t>(reader.readUleb128()));
+        break;
+      default:
+        throw PelfException{ "Unsupported form in the line program header" };
+      }
+
+      if (type == DW_LNCT_path) {
+        entry.name = string;
+      } else if (type == DW_LNCT_directory_index) {
+        entry.directory = value;
+      }
+    }
+
+    add(entry);
+  }
+}
+
+template<std::endian Endian>
+auto LineProgram<Endian>::header() const noexcept -> const LineProgramHeader&
+{
+  return mHeader;
+}
+
+template<std::endian Endian>
+auto LineProgram<Endian>::size() const noexcept -> std::size_t
+{
+  return mHeader.endOffset - mHeader.offset;
+}
+
+template<std::endian Endian>
+auto LineProgram<Endian>::filePath(std::uint64_t file) const
+  -> std::optional<std::string>
+{
+  /* Before DWARF 5 both tables are 1-based, directory 0 is the compilation
+   * directory and it isn't in the table */
+  const std::uint64_t first = mHeader.version >= 5 ? 0 : 1;
+
+  if (file < first || file - first >= mHeader.files.size()) {
+    return std::nullopt;
+  }
+
+  const auto& entry = mHeader.files[file - first];
+  if (entry.name.starts_with('/') || entry.directory < first
+      || entry.directory - first >= mHeader.directories.size()) {
+    return std::string{ entry.name };
+  }
+
+  const auto directory = mHeader.directories[entry.directory - first];
+  if (directory.empty()) { return std::string{ entry.name }; }
+
+  std::string path;
+  path.reserve(directory.size() + 1 + entry.name.size());
+  path.append(directory);
+  if (!directory.ends_with('/')) { path.push_back('/'); }
+  path.append(entry.name);
+  return path;
+}
+
+template<std::endian Endian>
+auto LineProgram<Endian>::begin() const -> LineRowIterator<Endian>
+{
+  return LineRowIterator<Endian>{ *this };
+}
+
+template<std::endian Endian>
+auto LineProgram<Endian>::end() const noexcept -> LineRowIterator<Endian>
+{
+  return LineRowIterator<Endian>{};
+}
+
+template<std::endian Endian>
+template<class Callback>
+auto LineProgram<Endian>::forEachRow(Callback&& callback) const -> void
+{
+  auto state = start();
+  while (step(state)) { callback(static_cast<const LineRow&>(state.row)); }
+}
+
+template<std::endian Endian>
+auto LineProgram<Endian>::start() const noexcept -> State
+{
+  State state{ DwarfReader<Endian>{ mProgram }, {} };
+  state.row.file = 1;
+  state.row.line = 1;
+  state.row.isStmt = mHeader.defaultIsStmt;
+  return state;
+}
+
+template<std::endian Endian>
+auto LineProgram<Endian>::step(State& state) const -> bool
+{
+  auto& reader = state.reader;
+  auto& row = state.row;
+
+  /* The registers are reset after appending the row that ends a sequence,
+   * the flags after appending any row */
+  if (row.endSequence) {
+    row = start().row;
+  } else {
+    row.discriminator = 0;
+    row.basicBlock = false;
+    row.prologueEnd = false;
+    row.epilogueBegin = false;
+  }
+
+  const std::uint8_t opcode_base = mHeader.opcodeBase;
+  const std::uint64_t min_length = mHeader.minInstructionLength;
+  const std::uint64_t max_ops = mHeader.maxOpsPerInstruction;
+
+  const auto advance = [&](std::uint64_t operation) {
+    if (max_ops == 1) {
+      row.address += min_length * operation;
+    } else {
+      const std::uint64_t index = row.opIndex + operation;
+      row.address += min_length * (index / max_ops);
+      row.opIndex = static_cast<std::uint8_t>(index % max_ops);
+    }
+  };
+
+  while (!reader.empty()) {
+    const auto opcode = reader.template read<std::uint8_t>();
+
+    /* Special opcodes are most of the program, they advance the address and
+     * the line and append a row */
+    if (opcode >= opcode_base) {
+      const auto special = mSpecial[opcode];
+      advance(special.operation);
+      row.line = static_cast<std::uint32_t>(row.line + special.line);
+      return true;
+    }
+
+    switch (opcode) {
+    case 0: {
+      const auto length = reader.readUleb128();
+      if (length == 0 || length > reader.remaining()) {
+        throw PelfException{ "Invalid extended opcode in the line program" };
+      }
+      const auto next = reader.offset() + static_cast<std::size_t>(length);
+      const auto extended = reader.template read<std::uint8_t>();
+
+      switch (extended) {
+      case DW_LNE_end_sequence:
+        row.endSequence = true;
+        reader.seek(next);
+        return true;
+      case DW_LNE_set_address:
+        row.address =
+          reader.readAddress(static_cast<std::uint8_t>(length - 1));
+        row.opIndex = 0;
+        break;
+      case DW_LNE_set_discriminator:
+        row.discriminator = static_cast<std::uint32_t>(reader.readUleb128());
+        break;
+      default:
+        /* DW_LNE_define_file (removed by DWARF 5) and vendor opcodes */
+        break;
+      }
+
+      reader.seek(next);
+      break;
+    }
+    case DW_LNS_copy:
+      return true;
+    case DW_LNS_advance_pc:
+      advance(reader.readUleb128());
+      break;
+    case DW_LNS_advance_line:
+      row.line = static_cast<std::uint32_t>(row.line + reader.readSleb128());
+      break;
+    case DW_LNS_set_file:
+      row.file = static_cast<std::uint32_t>(reader.readUleb128());
+      break;
+    case DW_LNS_set_column:
+      row.column = static_cast<std::uint32_t>(reader.readUleb128());
+      break;
+    case DW_LNS_negate_stmt:
+      row.isStmt = !row.isStmt;
+      break;
+    case DW_LNS_set_basic_block:
+      row.basicBlock = true;
+      break;
+    case DW_LNS_const_add_pc:
+      advance(mSpecial[255].operation);
+      break;
+    case DW_LNS_fixed_advance_pc:
+      row.address += reader.template read<std::uint16_t>();
+      row.opIndex = 0;
+      break;
+    case DW_LNS_set_prologue_end:
+      row.prologueEnd = true;
+      break;
+    case DW_LNS_set_epilogue_begin:
+      row.epilogueBegin = true;
+      break;
+    default:
+      /* DW_LNS_set_isa and opcodes unknown to us, their operands are skipped
+       * using the lengths of the header */
+      for (auto i = mHeader.standardOpcodeLengths[opcode - 1U]; i != 0; --i) {
+        static_cast<void>(reader.readUleb128());
+      }
+      break;
+    }
+  }
+
+  return false;
+}
+
+
+template<std::endian Endian>
+LineRowIterator<Endian>::LineRowIterator(const LineProgram<Endian>& program)
+  : mProgram(&program), mState(program.start())
+{
+  ++*this;
+}
+
+template<std::endian Endian>
+auto LineRowIterator<Endian>::operator*() const noexcept -> reference
+{
+  return mState.row;
+}
+
+template<std::endian Endian>
+auto LineRowIterator<Endian>::operator->() const noexcept -> pointer
+{
+  return &mState.row;
+}
+
+template<std::endian Endian>
+auto LineRowIterator<Endian>::operator++() -> LineRowIterator&
+{
+  if (!mProgram->step(mState)) { *this = LineRowIterator{}; }
+  return *this;
+}
+
+template<std::endian Endian>
+auto LineRowIterator<Endian>::operator++(int) -> LineRowIterator
+{
+  auto copy = *this;
+  ++*this;
+  return copy;
+}
+
+template<std::endian Endian>
+auto LineRowIterator<Endian>::operator==(
+  const LineRowIterator& other) const noexcept -> bool
+{
+  if (mProgram == nullptr || other.mProgram == nullptr) {
+    return mProgram == other.mProgram;
+  }
+  return mProgram == other.mProgram
+         && mState.reader.offset() == other.mState.reader.offset();
+}
+
+
+template<std::endian Endian>
+LineProgramIterator<Endian>::LineProgramIterator(const LineSections& sections,
+  std::uint8_t addressSize)
+  : mSections(sections), mAddressSize(addressSize)
+{
+  if (!sections.line.empty()) { mProgram.emplace(sections, 0, addressSize); }
+}
+
+template<std::endian Endian>
+auto LineProgramIterator<Endian>::operator*() const noexcept -> reference
+{
+  return *mProgram;
+}
+
+template<std::endian Endian>
+auto LineProgramIterator<Endian>::operator->() const noexcept -> pointer
+{
+  return &*mProgram;
+}
+
+template<std::endian Endian>
+auto LineProgramIterator<Endian>::operator++() -> LineProgramIterator&
+{
+  const auto next = mProgram->header().endOffset;
+
+  /* Some linkers pad the section with zeros after the last unit */
+  if (std::all_of(mSections.line.begin() + static_cast<std::ptrdiff_t>(next),
+        mSections.line.end(), [](unsigned char byte) { return byte == 0; })) {
+    mProgram.reset();
+  } else {
+    mProgram.emplace(mSections, next, mAddressSize);
+  }
+
+  return *this;
+}
+
+template<std::endian Endian>
+auto LineProgramIterator<Endian>::operator++(int) -> LineProgramIterator
+{
+  auto copy = *this;
+  ++*this;
+  return copy;
+}
+
+template<std::endian Endian>
+auto LineProgramIterator<Endian>::operator==(
+  const LineProgramIterator& other) const noexcept -> bool
+{
+  if (!mProgram || !other.mProgram) {
+    return mProgram.has_value() == other.mProgram.has_value();
+  }
+  return mProgram->header().offset == other.mProgram->header().offset;
+}
+
+
+template<std::endian Endian>
+DebugLine<Endian>::DebugLine(const LineSections& sections,
+  std::uint8_t addressSize) noexcept
+  : mSections(sections), mAddressSize(addressSize)
+{}
+
+template<std::endian Endian>
+auto DebugLine<Endian>::program(std::size_t offset) const
+  -> LineProgram<Endian>
+{
+  return LineProgram<Endian>{ mSections, offset, mAddressSize };
+}
+
+template<std::endian Endian>
+auto DebugLine<Endian>::begin() const -> LineProgramIterator<Endian>
+{
+  return LineProgramIterator<Endian>{ mSections, mAddressSize };
+}
+
+template<std::endian Endian>
+auto DebugLine<Endian>::end() const noexcept -> LineProgramIterator<Endian>
+{
+  return LineProgramIterator<Endian>{};
+}
+
+
+template<class ElfType>
+auto makeDebugLine(SectionCache<ElfType>& cache)
+  -> DebugLine<ElfType::byteOrder>
+{
+  constexpr std::uint8_t address_size =
+    ElfType::FileClass::ident == ELFCLASS64 ? 8 : 4;
+
+  return DebugLine<ElfType::byteOrder>{
+    LineSections{ cache.get(".debug_line"), cache.get(".debug_line_str"),
+      cache.get(".debug_str") },
+    address_size
+  };
+}
+
+
+template<std::endian Endian>
+LineTable::LineTable(const DebugLine<Endian>& debugLine)
+{
+  /* A single sort at the end instead of a merge per program */
+  for (const auto& program : debugLine) { append(program); }
+  sortSequences(0);
+}
+
+template<std::endian Endian>
+auto LineTable::add(const LineProgram<Endian>& program) -> void
+{
+  const auto first = mRows.size();
+  append(program);
+  sortSequences(first);
+
+  /* Programs are usually added in address order and nothing is merged */
+  if (first != 0 && first != mRows.size()
+      && before(mRows[first], mRows[first - 1])) {
+    std::inplace_merge(mRows.begin(),
+      mRows.begin() + static_cast<std::ptrdiff_t>(first), mRows.end(), before);
+  }
+}
+
+template<std::endian Endian>
+auto LineTable::append(const LineProgram<Endian>& program) -> void
+{
+  /* Index in mFiles of every entry of the file name table of the program,
+   * resolved the first time a row uses it */
+  constexpr auto unresolved = std::numeric_limits<std::uint32_t>::max();
+  std::vector<std::uint32_t> files(program.header().files.size() + 1,
+    unresolved);
+
+  const auto file_index = [&](std::uint32_t file) {
+    if (file >= files.size()) {
+      return addFile(program.filePath(file).value_or(std::string{}));
+    }
+    if (files[file] == unresolved) {
+      files[file] = addFile(program.filePath(file).value_or(std::string{}));
+    }
+    return files[file];
+  };
+
+  bool sequence_start = true;
+
+  program.forEachRow([&](const LineRow& row) {
+    /* Rows of the same sequence at the same address, only the last one is
+     * ever found by a lookup. A row at the address of the end of its
+     * sequence covers no instructions */
+    if (!sequence_start && mRows.back().address == row.address) {
+      mRows.back() = { row.address, row.endSequence ? 0 : file_index(row.file),
+        row.line, row.column, row.endSequence };
+    } else {
+      mRows.push_back({ row.address,
+        row.endSequence ? 0 : file_index(row.file), row.line, row.column,
+        row.endSequence });
+    }
+
+    sequence_start = row.endSequence;
+  });
+}
+
+
+inline auto LineTable::lookup(std::uint64_t address) const
+  -> std::optional<Location>
+{
+  const auto row = std::upper_bound(mRows.begin(), mRows.end(), address,
+    [](std::uint64_t value, const Row& r) { return value < r.address; });
+
+  if (row == mRows.begin()) { return std::nullopt; }
+  return location(*std::prev(row));
+}
+
+inline auto LineTable::lookup(std::span<const std::uint64_t> addresses,
+  std::span<std::optional<Location>> locations) const -> void
+{
+  if (locations.size() < addresses.size()) {
+    throw pelfInvalidSize{ "Output span is smaller than the addresses",
+      locations.size() };
+  }
+
+  std::vector<std::size_t> order(addresses.size());
+  std::iota(order.begin(), order.end(), std::size_t{});
+  if (!std::is_sorted(addresses.begin(), addresses.end())) {
+    std::sort(order.begin(), order.end(),
+      [&](std::size_t lhs, std::size_t rhs) {
+        return addresses[lhs] < addresses[rhs];
+      });
+  }
+
+  const auto greater = [](std::uint64_t value, const Row& r) {
+    return value < r.address;
+  };
+
+  /* Galloping search from the row found for the previous address, nearby
+   * addresses (e.g. the frames of a crash) cost a few comparisons */
+  std::size_t position{};
+  for (const auto i : order) {
+    const auto address = addresses[i];
+
+    std::size_t low = position;
+    std::size_t step{ 1 };
+    while (low + step < mRows.size() && mRows[low + step].address <= address) {
+      low += step;
+      step *= 2;
+    }
+    const auto high = std::min(low + step, mRows.size());
+
+    const auto row = std::upper_bound(mRows.begin()
+                                        + static_cast<std::ptrdiff_t>(low),
+      mRows.begin() + static_cast<std::ptrdiff_t>(high), address, greater);
+    position = static_cast<std::size_t>(row - mRows.begin());
+
+    locations[i] = position == 0 ? std::nullopt
+                                 : location(mRows[position - 1]);
+    if (position != 0) { --position; }
+  }
+}
+
+inline auto LineTable::size() const noexcept -> std::size_t
+{
+  return mRows.size();
+}
+
+inline auto LineTable::memoryUsage() const noexcept -> std::size_t
+{
+  std::size_t total = mRows.capacity() * sizeof(Row);
+  for (const auto& file : mFiles) { total += file.capacity(); }
+  return total;
+}
+
+inline auto LineTable::sortSequences(std::size_t first) -> void
+{
+  const auto begin = mRows.begin() + static_cast<std::ptrdiff_t>(first);
+  if (std::is_sorted(begin, mRows.end(), before)) { return; }
+
+  struct Sequence
+  {
+    std::uint64_t address; /**< First address */
+    std::size_t first; /**< Index of the first row */
+    std::size_t last; /**< Index after the end of sequence row */
+  };
+
+  std::vector<Sequence> sequences;
+  for (std::size_t row = first; row < mRows.size();) {
+    std::size_t end = row;
+    while (end + 1 < mRows.size() && !mRows[end].endSequence) { ++end; }
+    sequences.push_back({ mRows[row].address, row, end + 1 });
+    row = end + 1;
+  }
+
+  std::stable_sort(sequences.begin(), sequences.end(),
+    [](const Sequence& lhs, const Sequence& rhs) {
+      return lhs.address < rhs.address;
+    });
+
+  std::vector<Row> sorted;
+  sorted.reserve(mRows.size() - first);
+  for (const auto& sequence : sequences) {
+    sorted.insert(sorted.end(),
+      mRows.begin() + static_cast<std::ptrdiff_t>(sequence.first),
+      mRows.begin() + static_cast<std::ptrdiff_t>(sequence.last));
+  }
+  std::copy(sorted.begin(), sorted.end(), begin);
+
+  /* Overlapping sequences, e.g. functions discarded by the linker whose
+   * sequences all start at address 0 */
+  if (!std::is_sorted(begin, mRows.end(), before)) {
+    std::stable_sort(begin, mRows.end(), before);
+  }
+}
+
+inline auto LineTable::addFile(std::string&& path) -> std::uint32_t
+{
+  const auto [entry, added] =
+    mFileIndex.try_emplace(path, static_cast<std::uint32_t>(mFiles.size()));
+  if (added) { mFiles.push_back(std::move(path)); }
+  return entry->second;
+}
+
+inline auto LineTable::location(const Row& row) const
+  -> std::optional<Location>
+{
+  if (row.endSequence) { return std::nullopt; }
+  return Location{ mFiles[row.file], row.line, row.column };
+}
+
+inline auto LineTable::before(const Row& lhs, const Row& rhs) noexcept -> bool
+{
+  if (lhs.address != rhs.address) { return lhs.address < rhs.address; }
+  return lhs.endSequence && !rhs.endSequence;
+}
+
+
+}// namespace pelf
+
+
+#endif
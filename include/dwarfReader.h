@@ -0,0 +1,353 @@
+/** @file dwarfReader.h
+ *  @brief DwarfReader class declaration
+ *
+ *  This file contains the DwarfReader class declaration, a cursor over the
+ *  bytes of a `.debug_*` section that decodes the primitive encodings of
+ *  DWARF: fixed size integers, LEB128 numbers, addresses, section offsets and
+ *  null terminated strings. Every read is bounds checked
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef DWARFREADER_H_
+#define DWARFREADER_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "pelfExcept.h"
+#include "dwarfStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief Length of a unit (CU, line program, ...) and the size of its
+ * offsets */
+struct UnitLength
+{
+  std::uint64_t length{}; /**< Bytes of the unit after the length field */
+  std::uint8_t offsetSize{ 4 }; /**< 4 (32-bit DWARF) or 8 (64-bit DWARF) */
+};
+
+
+/** @brief Cursor over the bytes of a DWARF section
+ *
+ *  It throws `PelfException` when a read goes past the end of the data
+ *
+ *  @tparam Endian Byte order of the file
+ * */
+template<std::endian Endian = std::endian::little>
+class DwarfReader
+{
+public:
+  constexpr DwarfReader() = default;
+
+  /** @brief DwarfReader constructor
+   *
+   *  @param data Bytes of the section, the reader starts at the first one
+   * */
+  constexpr explicit DwarfReader(std::span<const unsigned char> data) noexcept;
+
+  /** @brief Returns the offset of the cursor from the beginning of the data */
+  [[nodiscard]] constexpr auto offset() const noexcept -> std::size_t;
+
+  /** @brief Returns the number of bytes after the cursor */
+  [[nodiscard]] constexpr auto remaining() const noexcept -> std::size_t;
+
+  /** @brief Returns `true` if there are no bytes after the cursor */
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool;
+
+  /** @brief Moves the cursor to `offset` from the beginning of the data */
+  constexpr auto seek(std::size_t offset) -> void;
+
+  /** @brief Moves the cursor `size` bytes forward */
+  constexpr auto skip(std::size_t size) -> void;
+
+  /** @brief Reads an unsigned integer of type `T` */
+  template<class T> constexpr auto read() -> T;
+
+  /** @brief Reads an unsigned LEB128 number, bits past the 64th are dropped */
+  constexpr auto readUleb128() -> std::uint64_t;
+
+  /** @brief Reads a signed LEB128 number */
+  constexpr auto readSleb128() -> std::int64_t;
+
+  /** @brief Reads an unsigned integer of `size` bytes (1, 2, 4 or 8)
+   *
+   *  Used for target addresses, whose size comes from the unit header
+   * */
+  constexpr auto readAddress(std::uint8_t size) -> std::uint64_t;
+
+  /** @brief Reads an unsigned integer of 1 to 8 bytes, e.g. the 3 byte
+   * indices of DW_FORM_strx3 */
+  constexpr auto readUnsigned(std::size_t size) -> std::uint64_t;
+
+  /** @brief Reads a section offset of `size` bytes (4 or 8) */
+  constexpr auto readOffset(std::uint8_t size) -> std::uint64_t;
+
+  /** @brief Reads an initial length field
+   *
+   *  @return Length of the unit and the offset size of its format, it throws
+   *  `PelfException` if the unit exceeds the data
+   * */
+  constexpr auto readUnitLength() -> UnitLength;
+
+  /** @brief Reads a null terminated string
+   *
+   *  @return String without the terminator, it points into the data
+   * */
+  auto readString() -> std::string_view;
+
+  /** @brief Reads `size` bytes
+   *
+   *  @return Bytes, they point into the data
+   * */
+  constexpr auto readBytes(std::size_t size) -> std::span<const unsigned char>;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the section */
+  std::size_t mOffset{}; /**< Offset of the cursor */
+
+  /** @brief Throws `PelfException` if there are less than `size` bytes after
+   * the cursor */
+  constexpr auto require(std::size_t size) const -> void;
+};
+
+
+/** @brief Returns the null terminated string at `offset` of a string section
+ *
+ *  @param strings Bytes of `.debug_str` or `.debug_line_str`
+ *  @param offset Offset of the first character
+ *
+ *  @return String without the terminator, it throws `PelfException` if
+ *  `offset` is out of range or the string isn't terminated
+ * */
+inline auto readStringAt(std::span<const unsigned char> strings,
+  std::uint64_t offset) -> std::string_view
+{
+  if (offset >= strings.size()) {
+    throw PelfException{ "Invalid string offset, out of the string section" };
+  }
+
+  DwarfReader reader{ strings };
+  reader.seek(static_cast<std::size_t>(offset));
+  return reader.readString();
+}
+
+
+template<std::endian Endian>
+constexpr DwarfReader<Endian>::DwarfReader(
+  std::span<const unsigned char> data) noexcept
+  : mData(data)
+{}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::offset() const noexcept -> std::size_t
+{
+  return mOffset;
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::remaining() const noexcept -> std::size_t
+{
+  return mData.size() - mOffset;
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::empty() const noexcept -> bool
+{
+  return mOffset == mData.size();
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::seek(std::size_t offset) -> void
+{
+  if (offset > mData.size()) {
+    throw PelfException{ "Invalid offset, out of the bounds of the section" };
+  }
+  mOffset = offset;
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::skip(std::size_t size) -> void
+{
+  require(size);
+  mOffset += size;
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::require(std::size_t size) const -> void
+{
+  if (size > mData.size() - mOffset) {
+    throw PelfException{ "Invalid DWARF data, out of the bounds of the section" };
+  }
+}
+
+template<std::endian Endian>
+template<class T>
+constexpr auto DwarfReader<Endian>::read() -> T
+{
+  require(sizeof(T));
+
+  T value{};
+
+  /* Compilers turn this loop into a single (possibly swapping) load */
+  for (std::size_t i{}; i < sizeof(T); ++i) {
+    const std::size_t index = Endian == std::endian::little
+                                ? mOffset + sizeof(T) - 1 - i
+                                : mOffset + i;
+    if constexpr (sizeof(T) > 1) { value = static_cast<T>(value << 8); }
+    value = static_cast<T>(value | mData[index]);
+  }
+
+  mOffset += sizeof(T);
+  return value;
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::readUleb128() -> std::uint64_t
+{
+  /* Most numbers of a line program (columns, small advances) fit in one byte */
+  if (mOffset < mData.size() && mData[mOffset] < 0x80) {
+    return mData[mOffset++];
+  }
+
+  std::uint64_t value{};
+  unsigned shift{};
+
+  for (;;) {
+    require(1);
+    const unsigned char byte = mData[mOffset++];
+
+    if (shift < 64) {
+      value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    }
+    shift += 7;
+
+    if ((byte & 0x80) == 0) { return value; }
+  }
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::readSleb128() -> std::int64_t
+{
+  std::uint64_t value{};
+  unsigned shift{};
+  unsigned char byte{};
+
+  do {
+    require(1);
+    byte = mData[mOffset++];
+
+    if (shift < 64) {
+      value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    }
+    shift += 7;
+  } while ((byte & 0x80) != 0);
+
+  /* Sign extension from the last bit read */
+  if (shift < 64 && (byte & 0x40) != 0) { value |= ~std::uint64_t{} << shift; }
+
+  return static_cast<std::int64_t>(value);
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::readAddress(std::uint8_t size)
+  -> std::uint64_t
+{
+  switch (size) {
+  case 1:
+    return read<std::uint8_t>();
+  case 2:
+    return read<std::uint16_t>();
+  case 4:
+    return read<std::uint32_t>();
+  case 8:
+    return read<std::uint64_t>();
+  default:
+    throw PelfException{ "Unsupported DWARF address size" };
+  }
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::readUnsigned(std::size_t size)
+  -> std::uint64_t
+{
+  if (size == 0 || size > 8) {
+    throw PelfException{ "Unsupported size of a DWARF integer" };
+  }
+  require(size);
+
+  std::uint64_t value{};
+  for (std::size_t i{}; i < size; ++i) {
+    const std::size_t index = Endian == std::endian::little
+                                ? mOffset + size - 1 - i
+                                : mOffset + i;
+    value = value << 8 | mData[index];
+  }
+
+  mOffset += size;
+  return value;
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::readOffset(std::uint8_t size)
+  -> std::uint64_t
+{
+  return size == 8 ? read<std::uint64_t>() : read<std::uint32_t>();
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::readUnitLength() -> UnitLength
+{
+  UnitLength unit{ read<std::uint32_t>(), 4 };
+
+  if (unit.length == DWARF64_ESCAPE) {
+    unit = { read<std::uint64_t>(), 8 };
+  } else if (unit.length >= 0xfffffff0) {
+    throw PelfException{ "Invalid DWARF unit length, reserved value" };
+  }
+
+  if (unit.length > remaining()) {
+    throw PelfException{ "Invalid DWARF unit, it exceeds the section" };
+  }
+
+  return unit;
+}
+
+template<std::endian Endian>
+auto DwarfReader<Endian>::readString() -> std::string_view
+{
+  const std::string_view rest{
+    reinterpret_cast<const char*>(mData.data()) + mOffset, remaining() };
+  const auto size = rest.find('\0');
+
+  if (size == std::string_view::npos) {
+    throw PelfException{ "Invalid DWARF string, it isn't null terminated" };
+  }
+
+  mOffset += size + 1;
+  return rest.substr(0, size);
+}
+
+template<std::endian Endian>
+constexpr auto DwarfReader<Endian>::readBytes(std::size_t size)
+  -> std::span<const unsigned char>
+{
+  require(size);
+  const auto bytes = mData.subspan(mOffset, size);
+  mOffset += size;
+  return bytes;
+}
+
+
+}// namespace pelf
+
+
+#endif
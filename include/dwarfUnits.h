@@ -0,0 +1,875 @@
+/** @file dwarfUnits.h
+ *  @brief CompileUnitIndex and CompileUnits class declarations
+ *
+ *  This file contains the decoding of the compilation units of `.debug_info`
+ *  (only their header and their first DIE, the rest of the unit isn't read)
+ *  and an index that maps addresses to compilation units. The index comes
+ *  from `.debug_aranges`, compilation units missing from it (or every unit if
+ *  the section isn't there) contribute the ranges of their DW_AT_low_pc,
+ *  DW_AT_high_pc and DW_AT_ranges attributes. With the index a symbolizer
+ *  only decodes the compilation unit that contains an address
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef DWARFUNITS_H_
+#define DWARFUNITS_H_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "pelfExcept.h"
+#include "dwarfStructs.h"
+#include "dwarfReader.h"
+#include "dwarfLine.h"
+#include "elfStructs.h"
+#include "sectionCache.h"
+
+
+namespace pelf {
+
+
+/** @brief Contents of the DWARF sections of a file
+ *
+ *  Sections that aren't in the file are empty
+ * */
+struct DwarfSections
+{
+  std::span<const unsigned char> info; /**< `.debug_info` */
+  std::span<const unsigned char> abbrev; /**< `.debug_abbrev` */
+  std::span<const unsigned char> aranges; /**< `.debug_aranges` */
+  std::span<const unsigned char> ranges; /**< `.debug_ranges` (DWARF 2-4) */
+  std::span<const unsigned char> rnglists; /**< `.debug_rnglists` (DWARF 5) */
+  std::span<const unsigned char> addr; /**< `.debug_addr` */
+  std::span<const unsigned char> line; /**< `.debug_line` */
+  std::span<const unsigned char> lineStr; /**< `.debug_line_str` */
+  std::span<const unsigned char> str; /**< `.debug_str` */
+  std::span<const unsigned char> strOffsets; /**< `.debug_str_offsets` */
+
+  /** @brief Returns the sections used by the line programs */
+  [[nodiscard]] auto lineSections() const noexcept -> LineSections;
+};
+
+
+/** @brief Range of addresses, `high` is the first address after it */
+struct AddressRange
+{
+  std::uint64_t low{}; /**< First address */
+  std::uint64_t high{}; /**< First address after the range */
+};
+
+
+/** @brief Range of addresses of a compilation unit */
+struct CompileUnitRange
+{
+  std::uint64_t low{}; /**< First address */
+  std::uint64_t high{}; /**< First address after the range */
+  std::uint64_t unit{}; /**< Offset of the unit in `.debug_info` */
+};
+
+
+/** @brief Header and attributes of the first DIE of a compilation unit */
+struct CompileUnit
+{
+  std::size_t offset{}; /**< Offset of the unit in `.debug_info` */
+  std::size_t endOffset{}; /**< Offset of the first byte after the unit */
+  std::size_t dieOffset{}; /**< Offset of the first DIE */
+  std::uint16_t version{}; /**< DWARF version, 2 to 5 */
+  std::uint8_t unitType{ DW_UT_compile }; /**< DW_UT_*, DW_UT_compile before
+                                             DWARF 5 */
+  std::uint8_t offsetSize{ 4 }; /**< 4 (32-bit DWARF) or 8 (64-bit DWARF) */
+  std::uint8_t addressSize{}; /**< Size of the target addresses */
+  std::uint64_t abbrevOffset{}; /**< Offset of the abbreviations in
+                                   `.debug_abbrev` */
+  std::uint64_t tag{}; /**< Tag of the first DIE (DW_TAG_compile_unit, ...) */
+  std::string_view name; /**< DW_AT_name, usually the primary source file */
+  std::string_view compDir; /**< DW_AT_comp_dir */
+  std::optional<std::uint64_t> lowPc; /**< DW_AT_low_pc, base address of the
+                                         range lists */
+  std::optional<std::uint64_t> stmtList; /**< DW_AT_stmt_list, offset of the
+    line program in `.debug_line` */
+  std::vector<AddressRange> ranges; /**< Addresses of the code of the unit */
+};
+
+
+/** @brief Decodes the compilation unit at `offset` of `.debug_info`
+ *
+ *  Only the header and the attributes of the first DIE are read. Strings
+ *  and addresses in the supplementary object file (DW_FORM_strp_sup,
+ *  DW_FORM_GNU_strp_alt) are left empty
+ *
+ *  @param sections Contents of the DWARF sections
+ *  @param offset Offset of the unit
+ *
+ *  @return CompileUnit, it throws `PelfException` if the unit is invalid
+ * */
+template<std::endian Endian = std::endian::little>
+auto readCompileUnit(const DwarfSections& sections, std::size_t offset)
+  -> CompileUnit;
+
+
+/** @brief Reads the address ranges of `.debug_aranges`
+ *
+ *  @param aranges Contents of `.debug_aranges`
+ *
+ *  @return Ranges in the order of the section, empty ranges are dropped
+ * */
+template<std::endian Endian = std::endian::little>
+auto readAranges(std::span<const unsigned char> aranges)
+  -> std::vector<CompileUnitRange>;
+
+
+/** @brief Reads the address ranges of the compilation units of `.debug_info`
+ *
+ *  @param sections Contents of the DWARF sections
+ *  @param skip Sorted offsets of units that are skipped (e.g. the ones that
+ *  are already in `.debug_aranges`)
+ *
+ *  @return Ranges in the order of the units
+ * */
+template<std::endian Endian = std::endian::little>
+auto readUnitRanges(const DwarfSections& sections,
+  std::span<const std::uint64_t> skip = {}) -> std::vector<CompileUnitRange>;
+
+
+/** @brief Sorted map from address ranges to compilation units
+ *
+ *  The first addresses are kept in their own array, so the binary search
+ *  only touches 8 bytes per step. Contiguous ranges of the same unit are
+ *  merged
+ * */
+class CompileUnitIndex
+{
+public:
+  CompileUnitIndex() = default;
+
+  /** @brief CompileUnitIndex constructor
+   *
+   *  @param ranges Ranges in any order, if two of them overlap an address is
+   *  assigned to the one that starts last (the nested one), the range that
+   *  encloses it resumes after its end
+   * */
+  explicit CompileUnitIndex(std::vector<CompileUnitRange> ranges);
+
+  /** @brief Returns the offset in `.debug_info` of the unit that contains
+   * `address`, `std::nullopt` if there isn't one */
+  [[nodiscard]] auto lookup(std::uint64_t address) const noexcept
+    -> std::optional<std::uint64_t>;
+
+  /** @brief Returns the number of ranges (after splitting the overlapping
+   * ones and merging the adjacent ones of the same unit) */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  /** @brief Returns the number of bytes used by the index */
+  [[nodiscard]] auto memoryUsage() const noexcept -> std::size_t;
+
+private:
+  std::vector<std::uint64_t> mLows; /**< First address of every range */
+  std::vector<std::uint64_t> mHighs; /**< End of every range */
+  std::vector<std::uint64_t> mUnits; /**< Unit of every range */
+};
+
+
+/** @brief Compilation units of a parsed `Elf`
+ *
+ *  The sections are read through a `SectionCache`, and the index is only
+ *  built the first time it's needed
+ *
+ *  @tparam ElfType `Elf` whose units are decoded
+ * */
+template<class ElfType>
+class CompileUnits
+{
+public:
+  static constexpr std::endian endian{ ElfType::byteOrder }; /**< Byte order
+                                                                of the file */
+
+  /** @brief CompileUnits constructor
+   *
+   *  @param cache Cache of the sections of the file, it must outlive the
+   *  `CompileUnits`
+   * */
+  explicit CompileUnits(SectionCache<ElfType>& cache);
+
+  /** @brief Returns the contents of the DWARF sections */
+  [[nodiscard]] auto sections() const noexcept -> const DwarfSections&;
+
+  /** @brief Returns the index, it's built by the first call
+   *
+   *  It can be called from many threads at the same time
+   * */
+  auto index() -> const CompileUnitIndex&;
+
+  /** @brief Returns the compilation unit that contains `address`
+   *
+   *  @return CompileUnit, `std::nullopt` if no unit contains `address`
+   * */
+  auto find(std::uint64_t address) -> std::optional<CompileUnit>;
+
+  /** @brief Returns the compilation unit at `offset` of `.debug_info` */
+  [[nodiscard]] auto unit(std::size_t offset) const -> CompileUnit;
+
+  /** @brief Returns the line program of `unit`
+   *
+   *  @return LineProgram, `std::nullopt` if the unit has no DW_AT_stmt_list
+   * */
+  [[nodiscard]] auto lineProgram(const CompileUnit& unit) const
+    -> std::optional<LineProgram<endian>>;
+
+private:
+  DwarfSections mSections; /**< Contents of the sections */
+  std::once_flag mIndexOnce; /**< Set once the index is built */
+  CompileUnitIndex mIndex; /**< Address to unit index */
+};
+
+
+namespace detail {
+
+  /** @brief Attribute of an abbreviation */
+  struct AttributeSpec
+  {
+    std::uint64_t name{}; /**< DW_AT_* */
+    std::uint64_t form{}; /**< DW_FORM_* */
+    std::int64_t implicitConst{}; /**< Value of DW_FORM_implicit_const */
+  };
+
+  /** @brief Value of an attribute, strings of DW_FORM_string are in
+   * `string`, every other form is in `value` */
+  struct FormValue
+  {
+    std::uint64_t value{}; /**< Constant, address, offset or index */
+    std::string_view string; /**< Inline string */
+  };
+
+  /** @brief Finds the abbreviation `code` in the table at `offset`
+   *
+   *  @param tag Set to the tag of the abbreviation
+   *
+   *  @return Attributes of the abbreviation, it throws `PelfException` if
+   *  there isn't one with that code
+   * */
+  template<std::endian Endian>
+  auto readAbbreviation(std::span<const unsigned char> abbrev,
+    std::uint64_t offset, std::uint64_t code, std::uint64_t& tag)
+    -> std::vector<AttributeSpec>
+  {
+    DwarfReader<Endian> reader{ abbrev };
+    reader.seek(static_cast<std::size_t>(offset));
+
+    for (auto current = reader.readUleb128(); current != 0;
+         current = reader.readUleb128()) {
+      const auto current_tag = reader.readUleb128();
+      /* DW_CHILDREN_yes/no */
+      reader.skip(1);
+
+      std::vector<AttributeSpec> specs;
+      for (;;) {
+        AttributeSpec spec{ reader.readUleb128(), reader.readUleb128(), 0 };
+        if (spec.name == 0 && spec.form == 0) { break; }
+        if (spec.form == DW_FORM_implicit_const) {
+          spec.implicitConst = reader.readSleb128();
+        }
+        if (current == code) { specs.push_back(spec); }
+      }
+
+      if (current == code) {
+        tag = current_tag;
+        return specs;
+      }
+    }
+
+    throw PelfException{ "Invalid DIE, its abbreviation isn't in the table" };
+  }
+
+  /** @brief Reads an attribute value of form `form` */
+  template<std::endian Endian>
+  auto readForm(DwarfReader<Endian>& reader, std::uint64_t form,
+    const CompileUnit& unit, std::int64_t implicitConst) -> FormValue
+  {
+    switch (form) {
+    case DW_FORM_addr:
+      return { reader.readAddress(unit.addressSize), {} };
+    case DW_FORM_data1:
+    case DW_FORM_ref1:
+    case DW_FORM_flag:
+    case DW_FORM_strx1:
+    case DW_FORM_addrx1:
+      return { reader.template read<std::uint8_t>(), {} };
+    case DW_FORM_data2:
+    case DW_FORM_ref2:
+    case DW_FORM_strx2:
+    case DW_FORM_addrx2:
+      return { reader.template read<std::uint16_t>(), {} };
+    case DW_FORM_strx3:
+    case DW_FORM_addrx3:
+      return { reader.readUnsigned(3), {} };
+    case DW_FORM_data4:
+    case DW_FORM_ref4:
+    case DW_FORM_ref_sup4:
+    case DW_FORM_strx4:
+    case DW_FORM_addrx4:
+      return { reader.template read<std::uint32_t>(), {} };
+    case DW_FORM_data8:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_sig8:
+    case DW_FORM_ref_sup8:
+      return { reader.template read<std::uint64_t>(), {} };
+    case DW_FORM_data16:
+      reader.skip(16);
+      return {};
+    case DW_FORM_sdata:
+      return { static_cast<std::uint64_t>(reader.readSleb128()), {} };
+    case DW_FORM_udata:
+    case DW_FORM_ref_udata:
+    case DW_FORM_strx:
+    case DW_FORM_addrx:
+    case DW_FORM_loclistx:
+    case DW_FORM_rnglistx:
+    case DW_FORM_GNU_addr_index:
+    case DW_FORM_GNU_str_index:
+      return { reader.readUleb128(), {} };
+    case DW_FORM_string:
+      return { 0, reader.readString() };
+    case DW_FORM_strp:
+    case DW_FORM_line_strp:
+    case DW_FORM_sec_offset:
+    case DW_FORM_strp_sup:
+    case DW_FORM_GNU_ref_alt:
+    case DW_FORM_GNU_strp_alt:
+      return { reader.readOffset(unit.offsetSize), {} };
+    case DW_FORM_ref_addr:
+      /* DWARF 2 used the size of an address */
+      return { unit.version == 2 ? reader.readAddress(unit.addressSize)
+                                 : reader.readOffset(unit.offsetSize),
+        {} };
+    case DW_FORM_flag_present:
+      return { 1, {} };
+    case DW_FORM_implicit_const:
+      return { static_cast<std::uint64_t>(implicitConst), {} };
+    case DW_FORM_block1:
+      reader.skip(reader.template read<std::uint8_t>());
+      return {};
+    case DW_FORM_block2:
+      reader.skip(reader.template read<std::uint16_t>());
+      return {};
+    case DW_FORM_block4:
+      reader.skip(reader.template read<std::uint32_t>());
+      return {};
+    case DW_FORM_block:
+    case DW_FORM_exprloc:
+      reader.skip(static_cast<std::size_t>(reader.readUleb128()));
+      return {};
+    case DW_FORM_indirect:
+      return readForm(reader, reader.readUleb128(), unit, implicitConst);
+    default:
+      throw PelfException{ "Unsupported DWARF attribute form" };
+    }
+  }
+
+  /** @brief Returns `true` for the forms whose value is an index in
+   * `.debug_str_offsets` */
+  constexpr auto isStringIndex(std::uint64_t form) noexcept -> bool
+  {
+    return form == DW_FORM_strx || form == DW_FORM_GNU_str_index
+           || (form >= DW_FORM_strx1 && form <= DW_FORM_strx4);
+  }
+
+  /** @brief Returns `true` for the forms whose value is an index in
+   * `.debug_addr` */
+  constexpr auto isAddressIndex(std::uint64_t form) noexcept -> bool
+  {
+    return form == DW_FORM_addrx || form == DW_FORM_GNU_addr_index
+           || (form >= DW_FORM_addrx1 && form <= DW_FORM_addrx4);
+  }
+
+  /** @brief Returns `true` for the constant forms (DW_AT_high_pc is an offset
+   * from DW_AT_low_pc when it uses one of them) */
+  constexpr auto isConstant(std::uint64_t form) noexcept -> bool
+  {
+    return form == DW_FORM_data1 || form == DW_FORM_data2
+           || form == DW_FORM_data4 || form == DW_FORM_data8
+           || form == DW_FORM_udata || form == DW_FORM_sdata
+           || form == DW_FORM_implicit_const;
+  }
+
+  /** @brief Appends `range` to `ranges` if it isn't empty */
+  inline auto addRange(std::vector<AddressRange>& ranges,
+    std::uint64_t low, std::uint64_t high) -> void
+  {
+    if (low < high) { ranges.push_back({ low, high }); }
+  }
+
+}// namespace detail
+
+
+inline auto DwarfSections::lineSections() const noexcept -> LineSections
+{
+  return { line, lineStr, str };
+}
+
+
+template<std::endian Endian>
+auto readCompileUnit(const DwarfSections& sections, std::size_t offset)
+  -> CompileUnit
+{
+  DwarfReader<Endian> reader{ sections.info };
+  reader.seek(offset);
+
+  CompileUnit unit;
+  unit.offset = offset;
+
+  const auto length = reader.readUnitLength();
+  unit.offsetSize = length.offsetSize;
+  unit.endOffset = reader.offset() + static_cast<std::size_t>(length.length);
+
+  unit.version = reader.template read<std::uint16_t>();
+  if (unit.version < 2 || unit.version > 5) {
+    throw PelfException{ "Unsupported version of the compilation unit" };
+  }
+
+  if (unit.version >= 5) {
+    unit.unitType = reader.template read<std::uint8_t>();
+    unit.addressSize = reader.template read<std::uint8_t>();
+    unit.abbrevOffset = reader.readOffset(unit.offsetSize);
+
+    if (unit.unitType == DW_UT_skeleton
+        || unit.unitType == DW_UT_split_compile) {
+      /* dwo_id */
+      reader.skip(8);
+    } else if (unit.unitType == DW_UT_type
+               || unit.unitType == DW_UT_split_type) {
+      /* type_signature and type_offset */
+      reader.skip(8 + unit.offsetSize);
+    }
+  } else {
+    unit.abbrevOffset = reader.readOffset(unit.offsetSize);
+    unit.addressSize = reader.template read<std::uint8_t>();
+  }
+
+  unit.dieOffset = reader.offset();
+
+  const auto code = reader.readUleb128();
+  if (code == 0) { return unit; }
+
+  const auto specs = detail::readAbbreviation<Endian>(
+    sections.abbrev, unit.abbrevOffset, code, unit.tag);
+
+  /* The bases can come after the attributes that depend on them (clang puts
+   * DW_AT_addr_base last), so indices are resolved once every attribute has
+   * been read */
+  std::uint64_t name_form{};
+  std::uint64_t comp_dir_form{};
+  std::uint64_t low_pc_form{};
+  std::uint64_t high_pc_form{};
+  std::uint64_t ranges_form{};
+  detail::FormValue name;
+  detail::FormValue comp_dir;
+  detail::FormValue low_pc;
+  detail::FormValue high_pc;
+  detail::FormValue ranges;
+  std::optional<std::uint64_t> str_offsets_base;
+  std::optional<std::uint64_t> addr_base;
+  std::optional<std::uint64_t> rnglists_base;
+
+  for (const auto& spec : specs) {
+    auto form = spec.form;
+    if (form == DW_FORM_indirect) { form = reader.readUleb128(); }
+
+    const auto value = detail::readForm(reader, form, unit, spec.implicitConst);
+
+    switch (spec.name) {
+    case DW_AT_name:
+      name = value;
+      name_form = form;
+      break;
+    case DW_AT_comp_dir:
+      comp_dir = value;
+      comp_dir_form = form;
+      break;
+    case DW_AT_low_pc:
+      low_pc = value;
+      low_pc_form = form;
+      break;
+    case DW_AT_high_pc:
+      high_pc = value;
+      high_pc_form = form;
+      break;
+    case DW_AT_ranges:
+      ranges = value;
+      ranges_form = form;
+      break;
+    case DW_AT_stmt_list:
+      unit.stmtList = value.value;
+      break;
+    case DW_AT_str_offsets_base:
+      str_offsets_base = value.value;
+      break;
+    case DW_AT_addr_base:
+      addr_base = value.value;
+      break;
+    case DW_AT_rnglists_base:
+      rnglists_base = value.value;
+      break;
+    default:
+      break;
+    }
+  }
+
+  /* Without the base attributes the indices refer to the first table of
+   * the section, right after its header */
+  const std::uint64_t header_size = unit.offsetSize == 8 ? 16 : 8;
+
+  const auto string = [&](std::uint64_t form, const detail::FormValue& value)
+    -> std::string_view {
+    if (form == DW_FORM_string) { return value.string; }
+    if (form == DW_FORM_strp) { return readStringAt(sections.str, value.value); }
+    if (form == DW_FORM_line_strp) {
+      return readStringAt(sections.lineStr, value.value);
+    }
+    if (detail::isStringIndex(form)) {
+      DwarfReader<Endian> offsets{ sections.strOffsets };
+      offsets.seek(static_cast<std::size_t>(str_offsets_base.value_or(header_size)
+                                            + value.value * unit.offsetSize));
+      return readStringAt(sections.str, offsets.readOffset(unit.offsetSize));
+    }
+    return {};
+  };
+
+  const auto address = [&](std::uint64_t index) {
+    DwarfReader<Endian> addresses{ sections.addr };
+    addresses.seek(static_cast<std::size_t>(
+      addr_base.value_or(header_size) + index * unit.addressSize));
+    return addresses.readAddress(unit.addressSize);
+  };
+
+  unit.name = string(name_form, name);
+  unit.compDir = string(comp_dir_form, comp_dir);
+
+  if (low_pc_form == DW_FORM_addr) {
+    unit.lowPc = low_pc.value;
+  } else if (detail::isAddressIndex(low_pc_form)) {
+    unit.lowPc = address(low_pc.value);
+  }
+
+  if (ranges_form != 0) {
+    const std::uint64_t base_selection =
+      unit.addressSize == 8 ? std::numeric_limits<std::uint64_t>::max()
+                            : (std::uint64_t{ 1 } << (8 * unit.addressSize)) - 1;
+    std::uint64_t base = unit.lowPc.value_or(0);
+
+    if (unit.version >= 5) {
+      auto list = ranges.value;
+      if (ranges_form == DW_FORM_rnglistx) {
+        const auto table = rnglists_base.value_or(header_size + 4);
+        DwarfReader<Endian> offsets{ sections.rnglists };
+        offsets.seek(static_cast<std::size_t>(table + list * unit.offsetSize));
+        list = table + offsets.readOffset(unit.offsetSize);
+      }
+
+      DwarfReader<Endian> entries{ sections.rnglists };
+      entries.seek(static_cast<std::size_t>(list));
+
+      for (auto kind = entries.template read<std::uint8_t>();
+           kind != DW_RLE_end_of_list;
+           kind = entries.template read<std::uint8_t>()) {
+        switch (kind) {
+        case DW_RLE_base_addressx:
+          base = address(entries.readUleb128());
+          break;
+        case DW_RLE_startx_endx: {
+          const auto low = address(entries.readUleb128());
+          detail::addRange(unit.ranges, low, address(entries.readUleb128()));
+          break;
+        }
+        case DW_RLE_startx_length: {
+          const auto low = address(entries.readUleb128());
+          detail::addRange(unit.ranges, low, low + entries.readUleb128());
+          break;
+        }
+        case DW_RLE_offset_pair: {
+          const auto low = base + entries.readUleb128();
+          detail::addRange(unit.ranges, low, base + entries.readUleb128());
+          break;
+        }
+        case DW_RLE_base_address:
+          base = entries.readAddress(unit.addressSize);
+          break;
+        case DW_RLE_start_end: {
+          const auto low = entries.readAddress(unit.addressSize);
+          detail::addRange(
+            unit.ranges, low, entries.readAddress(unit.addressSize));
+          break;
+        }
+        case DW_RLE_start_length: {
+          const auto low = entries.readAddress(unit.addressSize);
+          detail::addRange(unit.ranges, low, low + entries.readUleb128());
+          break;
+        }
+        default:
+          throw PelfException{ "Invalid entry in a range list" };
+        }
+      }
+    } else {
+      DwarfReader<Endian> entries{ sections.ranges };
+      entries.seek(static_cast<std::size_t>(ranges.value));
+
+      for (;;) {
+        const auto low = entries.readAddress(unit.addressSize);
+        const auto high = entries.readAddress(unit.addressSize);
+
+        if (low == 0 && high == 0) { break; }
+        /* Base address selection entry */
+        if (low == base_selection) {
+          base = high;
+        } else {
+          detail::addRange(unit.ranges, base + low, base + high);
+        }
+      }
+    }
+  } else if (unit.lowPc && high_pc_form != 0) {
+    auto high = high_pc.value;
+    if (detail::isConstant(high_pc_form)) {
+      high += *unit.lowPc;
+    } else if (detail::isAddressIndex(high_pc_form)) {
+      high = address(high_pc.value);
+    }
+    detail::addRange(unit.ranges, *unit.lowPc, high);
+  }
+
+  return unit;
+}
+
+
+template<std::endian Endian>
+auto readAranges(std::span<const unsigned char> aranges)
+  -> std::vector<CompileUnitRange>
+{
+  std::vector<CompileUnitRange> ranges;
+  DwarfReader<Endian> reader{ aranges };
+
+  while (!reader.empty()) {
+    const auto start = reader.offset();
+    const auto length = reader.readUnitLength();
+    const auto end = reader.offset() + static_cast<std::size_t>(length.length);
+
+    const auto version = reader.template read<std::uint16_t>();
+    if (version != 2) {
+      throw PelfException{ "Unsupported version of .debug_aranges" };
+    }
+
+    const auto unit = reader.readOffset(length.offsetSize);
+    const auto address_size = reader.template read<std::uint8_t>();
+    const auto segment_size = reader.template read<std::uint8_t>();
+
+    /* The tuples are aligned to twice their address size from the start of
+     * the set */
+    const std::size_t tuple = 2U * address_size;
+    if (tuple == 0) {
+      throw PelfException{ "Invalid address size in .debug_aranges" };
+    }
+    const auto header = reader.offset() - start;
+    reader.seek(start + (header + tuple - 1) / tuple * tuple);
+
+    while (reader.offset() + segment_size + tuple <= end) {
+      reader.skip(segment_size);
+      const auto address = reader.readAddress(address_size);
+      const auto size = reader.readAddress(address_size);
+
+      if (address == 0 && size == 0) { break; }
+      if (size != 0) { ranges.push_back({ address, address + size, unit }); }
+    }
+
+    reader.seek(end);
+  }
+
+  return ranges;
+}
+
+
+template<std::endian Endian>
+auto readUnitRanges(const DwarfSections& sections,
+  std::span<const std::uint64_t> skip) -> std::vector<CompileUnitRange>
+{
+  std::vector<CompileUnitRange> ranges;
+  DwarfReader<Endian> reader{ sections.info };
+
+  while (!reader.empty()) {
+    const auto offset = reader.offset();
+    const auto length = reader.readUnitLength();
+    const auto end = reader.offset() + static_cast<std::size_t>(length.length);
+
+    if (!std::binary_search(skip.begin(), skip.end(), offset)) {
+      const auto unit = readCompileUnit<Endian>(sections, offset);
+      for (const auto& range : unit.ranges) {
+        ranges.push_back({ range.low, range.high, offset });
+      }
+    }
+
+    reader.seek(end);
+  }
+
+  return ranges;
+}
+
+
+inline CompileUnitIndex::CompileUnitIndex(std::vector<CompileUnitRange> ranges)
+{
+  std::stable_sort(ranges.begin(), ranges.end(),
+    [](const CompileUnitRange& lhs, const CompileUnitRange& rhs) {
+      return lhs.low < rhs.low;
+    });
+
+  mLows.reserve(ranges.size());
+  mHighs.reserve(ranges.size());
+  mUnits.reserve(ranges.size());
+
+  /* Adds [low, high) of `unit` after the last range, merging them if they're
+   * of the same unit and adjacent */
+  const auto add = [this](std::uint64_t low,
+                     std::uint64_t high,
+                     std::uint64_t unit) {
+    if (low >= high) { return; }
+
+    if (!mLows.empty() && mUnits.back() == unit && mHighs.back() == low) {
+      mHighs.back() = high;
+      return;
+    }
+
+    mLows.push_back(low);
+    mHighs.push_back(high);
+    mUnits.push_back(unit);
+  };
+
+  /* Sweep over the starts, the ranges that contain the current address are
+   * in `open` and the last one owns it. When it ends the address goes back
+   * to the range under it, unless that one has already ended too */
+  std::vector<const CompileUnitRange*> open;
+  std::uint64_t address{};
+
+  const auto close = [&] {
+    const auto* range = open.back();
+    open.pop_back();
+    if (range->high > address) {
+      add(address, range->high, range->unit);
+      address = range->high;
+    }
+  };
+
+  for (const auto& range : ranges) {
+    if (range.low >= range.high) { continue; }
+
+    while (!open.empty() && open.back()->high <= range.low) { close(); }
+
+    if (!open.empty()) { add(address, range.low, open.back()->unit); }
+
+    address = range.low;
+    open.push_back(&range);
+  }
+
+  while (!open.empty()) { close(); }
+}
+
+inline auto CompileUnitIndex::lookup(std::uint64_t address) const noexcept
+  -> std::optional<std::uint64_t>
+{
+  const auto next = std::upper_bound(mLows.begin(), mLows.end(), address);
+  if (next == mLows.begin()) { return std::nullopt; }
+
+  const auto index = static_cast<std::size_t>(next - mLows.begin()) - 1;
+  if (address >= mHighs[index]) { return std::nullopt; }
+
+  return mUnits[index];
+}
+
+inline auto CompileUnitIndex::size() const noexcept -> std::size_t
+{
+  return mLows.size();
+}
+
+inline auto CompileUnitIndex::memoryUsage() const noexcept -> std::size_t
+{
+  return (mLows.capacity() + mHighs.capacity() + mUnits.capacity())
+         * sizeof(std::uint64_t);
+}
+
+
+template<class ElfType>
+CompileUnits<ElfType>::CompileUnits(SectionCache<ElfType>& cache)
+  : mSections{ cache.get(".debug_info"), cache.get(".debug_abbrev"),
+      cache.get(".debug_aranges"), cache.get(".debug_ranges"),
+      cache.get(".debug_rnglists"), cache.get(".debug_addr"),
+      cache.get(".debug_line"), cache.get(".debug_line_str"),
+      cache.get(".debug_str"), cache.get(".debug_str_offsets") }
+{}
+
+template<class ElfType>
+auto CompileUnits<ElfType>::sections() const noexcept -> const DwarfSections&
+{
+  return mSections;
+}
+
+template<class ElfType>
+auto CompileUnits<ElfType>::index() -> const CompileUnitIndex&
+{
+  std::call_once(mIndexOnce, [&] {
+    auto ranges = readAranges<endian>(mSections.aranges);
+
+    /* Units that aren't in .debug_aranges (some compilers omit it, and
+     * linkers don't merge it for every input) are read from .debug_info */
+    std::vector<std::uint64_t> covered;
+    covered.reserve(ranges.size());
+    for (const auto& range : ranges) { covered.push_back(range.unit); }
+    std::sort(covered.begin(), covered.end());
+    covered.erase(std::unique(covered.begin(), covered.end()), covered.end());
+
+    const auto missing = readUnitRanges<endian>(mSections, covered);
+    ranges.insert(ranges.end(), missing.begin(), missing.end());
+
+    mIndex = CompileUnitIndex{ std::move(ranges) };
+  });
+
+  return mIndex;
+}
+
+template<class ElfType>
+auto CompileUnits<ElfType>::find(std::uint64_t address)
+  -> std::optional<CompileUnit>
+{
+  const auto offset = index().lookup(address);
+  if (!offset) { return std::nullopt; }
+
+  return unit(static_cast<std::size_t>(*offset));
+}
+
+template<class ElfType>
+auto CompileUnits<ElfType>::unit(std::size_t offset) const -> CompileUnit
+{
+  return readCompileUnit<endian>(mSections, offset);
+}
+
+template<class ElfType>
+auto CompileUnits<ElfType>::lineProgram(const CompileUnit& unit) const
+  -> std::optional<LineProgram<endian>>
+{
+  if (!unit.stmtList) { return std::nullopt; }
+
+  return LineProgram<endian>{ mSections.lineSections(),
+    static_cast<std::size_t>(*unit.stmtList), unit.addressSize };
+}
+
+
+}// namespace pelf
+
+
+#endif
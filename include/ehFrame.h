@@ -0,0 +1,1150 @@
+/** @file ehFrame.h
+ *  @brief EhFrame and EhFrameHdr class declarations
+ *
+ *  This file contains a decoder of the call frame information of `.eh_frame`
+ *  (CIEs and FDEs), the evaluation of the CFA rules of an FDE for a given
+ *  address and an accessor to the sorted table of `.eh_frame_hdr`, which finds
+ *  the FDE of an address with a binary search over the bytes of the file
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef EHFRAME_H_
+#define EHFRAME_H_
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "Pelf.h"
+#include "pelfExcept.h"
+#include "dwarfReader.h"
+#include "dwarfStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief Common Information Entry of `.eh_frame`
+ *
+ *  `augmentation` and `instructions` point into the data of the section
+ * */
+struct EhCie
+{
+  std::uint64_t offset{}; /**< Offset of the CIE in `.eh_frame` */
+  std::uint8_t version{}; /**< 1, 3 or 4 */
+  std::string_view augmentation; /**< e.g. "zR" or "zPLR" */
+  std::uint64_t codeAlignment{}; /**< Factor of the advance instructions */
+  std::int64_t dataAlignment{}; /**< Factor of the offset instructions */
+  std::uint64_t returnAddressRegister{}; /**< DWARF number of the register
+                                            with the return address */
+  std::uint8_t fdeEncoding{ DW_EH_PE_absptr }; /**< Encoding of the addresses
+                                                  of the FDEs ('R') */
+  std::uint8_t lsdaEncoding{ DW_EH_PE_omit }; /**< Encoding of the LSDA
+                                                 pointers of the FDEs ('L') */
+  std::uint8_t personalityEncoding{ DW_EH_PE_omit }; /**< Encoding of
+                                                        `personality` ('P') */
+  std::uint64_t personality{}; /**< Personality routine, or the address of a
+                                  pointer to it if `personalityEncoding` has
+                                  DW_EH_PE_indirect */
+  bool signalFrame{}; /**< 'S', the frame of a signal handler */
+  std::span<const unsigned char> instructions; /**< Initial instructions */
+};
+
+
+/** @brief Frame Description Entry of `.eh_frame`, with its CIE
+ *
+ *  `instructions` points into the data of the section
+ * */
+struct EhFde
+{
+  std::uint64_t offset{}; /**< Offset of the FDE in `.eh_frame` */
+  std::uint64_t initialLocation{}; /**< First address covered by the FDE */
+  std::uint64_t addressRange{}; /**< Number of bytes covered by the FDE */
+  std::uint64_t lsda{}; /**< Language specific data area, zero if there
+                           isn't one */
+  std::span<const unsigned char> instructions; /**< Call frame instructions */
+  EhCie cie; /**< CIE of the FDE */
+
+  /** @brief Returns `true` if `pc` is in [initialLocation,
+   * initialLocation + addressRange) */
+  [[nodiscard]] constexpr auto contains(std::uint64_t pc) const noexcept
+    -> bool;
+};
+
+
+/** @brief How the Canonical Frame Address is computed */
+enum class CfaRuleKind : std::uint8_t {
+  registerOffset, /**< Value of `reg` plus `offset` */
+  expression /**< Result of the DWARF expression `expression` */
+};
+
+/** @brief Rule of the Canonical Frame Address */
+struct CfaRule
+{
+  CfaRuleKind kind{}; /**< Kind of the rule */
+  std::uint32_t reg{}; /**< DWARF register number */
+  std::int64_t offset{}; /**< Offset added to the register */
+  std::span<const unsigned char> expression; /**< DWARF expression */
+};
+
+
+/** @brief How the value of a register of the caller is recovered */
+enum class RegisterRuleKind : std::uint8_t {
+  unspecified, /**< No rule, usually the same as `sameValue` */
+  undefined, /**< The register can't be recovered, e.g. the return address of
+                the outermost frame */
+  sameValue, /**< The register wasn't modified */
+  offset, /**< Saved at CFA + `value` */
+  valOffset, /**< The value is CFA + `value` */
+  inRegister, /**< Saved in the register `value` */
+  expression, /**< Saved at the address computed by `expression` */
+  valExpression /**< The value is computed by `expression` */
+};
+
+/** @brief Rule of a register */
+struct RegisterRule
+{
+  std::uint32_t reg{}; /**< DWARF register number */
+  RegisterRuleKind kind{}; /**< Kind of the rule */
+  std::int64_t value{}; /**< Offset or register number, see `kind` */
+  std::span<const unsigned char> expression; /**< DWARF expression */
+};
+
+
+/** @brief Fixed capacity set of register rules
+ *
+ *  Registers without a rule are `RegisterRuleKind::unspecified`, functions
+ *  rarely save more than a dozen registers so the rules are kept in an array
+ *  that doesn't allocate
+ * */
+class RegisterRules
+{
+public:
+  static constexpr std::size_t capacity{ 32 }; /**< Maximum number of rules */
+
+  /** @brief Returns the rule of register `reg`, `unspecified` if it hasn't
+   * got one */
+  [[nodiscard]] constexpr auto find(std::uint32_t reg) const noexcept
+    -> RegisterRule;
+
+  /** @brief Replaces the rule of `rule.reg`
+   *
+   *  An `unspecified` rule removes the register, it throws `PelfException` if
+   *  there are more than `capacity` registers
+   * */
+  constexpr auto set(const RegisterRule& rule) -> void;
+
+  /** @brief Returns the number of registers with a rule */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] constexpr auto begin() const noexcept -> const RegisterRule*;
+
+  [[nodiscard]] constexpr auto end() const noexcept -> const RegisterRule*;
+
+private:
+  std::array<RegisterRule, capacity> mRules{}; /**< Rules, unordered */
+  std::size_t mSize{}; /**< Number of rules */
+};
+
+
+/** @brief Row of the call frame table, the rules that apply to the addresses
+ * in [location, endLocation) */
+struct UnwindRow
+{
+  std::uint64_t location{}; /**< First address of the row */
+  std::uint64_t endLocation{}; /**< Address of the next row, or the end of the
+                                  FDE */
+  CfaRule cfa; /**< Rule of the Canonical Frame Address */
+  RegisterRules rules; /**< Rules of the registers */
+  std::uint64_t returnAddressRegister{}; /**< Register with the return
+                                            address, from the CIE */
+  std::uint64_t argsSize{}; /**< Bytes of arguments pushed on the stack
+                               (DW_CFA_GNU_args_size) */
+
+  /** @brief Returns the rule of register `reg` */
+  [[nodiscard]] constexpr auto rule(std::uint32_t reg) const noexcept
+    -> RegisterRule;
+};
+
+
+/** @brief Reads a pointer encoded with a DW_EH_PE_* encoding
+ *
+ *  DW_EH_PE_indirect isn't followed, the result is the address of the
+ *  pointer. DW_EH_PE_textrel and DW_EH_PE_funcrel need the state of the
+ *  unwinder and throw `PelfException`
+ *
+ *  @param reader Reader positioned at the pointer
+ *  @param encoding Encoding of the pointer
+ *  @param address Virtual address of the first byte of the reader's data, the
+ *  base of DW_EH_PE_pcrel
+ *  @param dataAddress Base of DW_EH_PE_datarel, it throws `PelfException` if
+ *  it's needed and there isn't one
+ *  @param addressSize Size of the target addresses, 4 or 8
+ *
+ *  @return Decoded pointer
+ * */
+template<std::endian Endian>
+constexpr auto readEncodedPointer(DwarfReader<Endian>& reader,
+  std::uint8_t encoding,
+  std::uint64_t address,
+  std::optional<std::uint64_t> dataAddress,
+  std::uint8_t addressSize) -> std::uint64_t;
+
+
+/** @brief Decoder of the CIEs and FDEs of an `.eh_frame` section
+ *
+ *  Parsed CIEs are kept in a small direct mapped cache, most files have one
+ *  or two CIEs shared by all the FDEs. The cache makes the lookups non-const,
+ *  use a copy of the object per thread
+ *
+ *  @tparam Endian Byte order of the file
+ * */
+template<std::endian Endian = std::endian::little>
+class EhFrame
+{
+public:
+  static constexpr std::size_t cieCacheSize{ 8 }; /**< Entries of the CIE
+                                                     cache */
+  static constexpr std::size_t rememberDepth{ 4 }; /**< Maximum nesting of
+                                                      DW_CFA_remember_state */
+
+  EhFrame() = default;
+
+  /** @brief EhFrame constructor
+   *
+   *  @param data Bytes of `.eh_frame`, everything after the end of the section
+   *  (e.g. the rest of the segment) is ignored as long as there is a zero
+   *  terminator
+   *  @param address Virtual address of the first byte of `data`
+   *  @param addressSize Size of the target addresses, 4 or 8
+   * */
+  EhFrame(std::span<const unsigned char> data,
+    std::uint64_t address,
+    std::uint8_t addressSize) noexcept;
+
+  /** @brief Returns the bytes of the section */
+  [[nodiscard]] auto data() const noexcept -> std::span<const unsigned char>;
+
+  /** @brief Returns the virtual address of the section */
+  [[nodiscard]] auto address() const noexcept -> std::uint64_t;
+
+  /** @brief Returns the CIE at `offset`, it throws `PelfException` if the
+   * entry isn't a valid CIE */
+  auto cie(std::uint64_t offset) -> EhCie;
+
+  /** @brief Returns the FDE at `offset`, it throws `PelfException` if the
+   * entry isn't a valid FDE */
+  auto fde(std::uint64_t offset) -> EhFde;
+
+  /** @brief Returns the FDE that covers `pc`
+   *
+   *  It walks all the entries of the section, `EhFrameHdr::find()` does a
+   *  binary search instead
+   *
+   *  @return FDE, `std::nullopt` if no FDE covers `pc`
+   * */
+  auto find(std::uint64_t pc) -> std::optional<EhFde>;
+
+  /** @brief Evaluates the CFA rules of `fde` at `pc`
+   *
+   *  The initial instructions of the CIE and the instructions of the FDE are
+   *  executed until the location passes `pc`
+   *
+   *  @param fde FDE returned by this object
+   *  @param pc Address covered by the FDE
+   *
+   *  @return Row of the call frame table that contains `pc`, it throws
+   *  `PelfException` if `pc` isn't covered by the FDE or the instructions are
+   *  invalid
+   * */
+  [[nodiscard]] auto unwindRow(const EhFde& fde, std::uint64_t pc) const
+    -> UnwindRow;
+
+private:
+  /** @brief Header of a CIE or FDE */
+  struct EntryHeader
+  {
+    std::size_t idOffset{}; /**< Offset of the CIE id/pointer field */
+    std::size_t size{}; /**< Bytes after the length field, zero for the
+                           terminator */
+    std::uint32_t id{}; /**< Zero for CIEs, distance to the CIE for FDEs */
+  };
+
+  /** @brief Rules saved by DW_CFA_remember_state */
+  struct SavedRules
+  {
+    CfaRule cfa; /**< Rule of the CFA */
+    RegisterRules rules; /**< Rules of the registers */
+  };
+
+  std::span<const unsigned char> mData; /**< Bytes of `.eh_frame` */
+  std::uint64_t mAddress{}; /**< Virtual address of `.eh_frame` */
+  std::uint8_t mAddressSize{ 8 }; /**< Size of the target addresses */
+  std::array<EhCie, cieCacheSize> mCies{}; /**< Cached CIEs */
+  std::array<bool, cieCacheSize> mCached{}; /**< Valid entries of `mCies` */
+
+  /** @brief Reads the header of the entry at `offset` */
+  [[nodiscard]] auto readEntryHeader(std::uint64_t offset) const
+    -> EntryHeader;
+
+  /** @brief Decodes the CIE at `offset` */
+  [[nodiscard]] auto parseCie(std::uint64_t offset) const -> EhCie;
+
+  /** @brief Decodes the FDE whose header is `entry` */
+  auto parseFde(std::uint64_t offset, const EntryHeader& entry) -> EhFde;
+
+  /** @brief Executes call frame instructions until the location passes `pc`
+   *
+   *  @param cie CIE of the instructions
+   *  @param instructions Instructions, they point into `mData`
+   *  @param pc Address whose row is computed
+   *  @param row Row updated by the instructions
+   *  @param initial Rules after the initial instructions of the CIE, `nullptr`
+   *  while executing them
+   * */
+  auto execute(const EhCie& cie,
+    std::span<const unsigned char> instructions,
+    std::uint64_t pc,
+    UnwindRow& row,
+    const RegisterRules* initial) const -> void;
+};
+
+
+/** @brief Entry of the binary search table of `.eh_frame_hdr` */
+struct EhFrameHdrEntry
+{
+  std::uint64_t initialLocation{}; /**< First address of the FDE */
+  std::uint64_t fdeAddress{}; /**< Virtual address of the FDE */
+};
+
+
+/** @brief Accessor to the `.eh_frame_hdr` section (the PT_GNU_EH_FRAME
+ * segment) and the `.eh_frame` section it points to
+ *
+ *  The table of FDEs sorted by address is read directly from the bytes of
+ *  the file, so `find()` is a binary search that touches O(log n) entries and
+ *  the FDE it returns. If the section has no table `find()` falls back to a
+ *  linear walk of `.eh_frame`
+ *
+ *  @tparam Endian Byte order of the file
+ * */
+template<std::endian Endian = std::endian::little>
+class EhFrameHdr
+{
+public:
+  /** @brief EhFrameHdr constructor
+   *
+   *  @param hdr Bytes of `.eh_frame_hdr`
+   *  @param hdrAddress Virtual address of `.eh_frame_hdr`
+   *  @param frame Bytes from the address returned by `readFramePointer()`,
+   *  e.g. the rest of the segment that contains `.eh_frame`
+   *  @param addressSize Size of the target addresses, 4 or 8
+   *
+   *  It throws `PelfException` if the header is invalid or the table exceeds
+   *  the section
+   * */
+  EhFrameHdr(std::span<const unsigned char> hdr,
+    std::uint64_t hdrAddress,
+    std::span<const unsigned char> frame,
+    std::uint8_t addressSize);
+
+  /** @brief Returns the address of `.eh_frame` stored in the header of
+   * `.eh_frame_hdr` */
+  [[nodiscard]] static auto readFramePointer(std::span<const unsigned char> hdr,
+    std::uint64_t hdrAddress,
+    std::uint8_t addressSize) -> std::uint64_t;
+
+  /** @brief Returns the number of entries of the table, zero if the section
+   * has no table */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  /** @brief Returns the entry `index` of the table */
+  [[nodiscard]] auto entry(std::size_t index) const -> EhFrameHdrEntry;
+
+  /** @brief Returns the FDE that covers `pc`
+   *
+   *  @return FDE, `std::nullopt` if no FDE covers `pc`
+   * */
+  auto find(std::uint64_t pc) -> std::optional<EhFde>;
+
+  /** @brief Returns the row of the call frame table that contains `pc`
+   *
+   *  @return Row, `std::nullopt` if no FDE covers `pc`
+   * */
+  auto unwindRow(std::uint64_t pc) -> std::optional<UnwindRow>;
+
+  /** @brief Returns the decoder of `.eh_frame` */
+  [[nodiscard]] auto frame() noexcept -> EhFrame<Endian>&;
+
+private:
+  std::span<const unsigned char> mHdr; /**< Bytes of `.eh_frame_hdr` */
+  std::uint64_t mHdrAddress{}; /**< Virtual address of `.eh_frame_hdr` */
+  std::size_t mTableOffset{}; /**< Offset of the table in `mHdr` */
+  std::size_t mCount{}; /**< Number of entries of the table */
+  std::size_t mValueSize{}; /**< Size of each value of the table */
+  std::uint8_t mTableEncoding{ DW_EH_PE_omit }; /**< Encoding of the table */
+  std::uint8_t mAddressSize{ 8 }; /**< Size of the target addresses */
+  EhFrame<Endian> mFrame; /**< Decoder of `.eh_frame` */
+
+  /** @brief Reads the value `column` (0 location, 1 FDE) of entry `index` */
+  [[nodiscard]] auto readValue(std::size_t index, std::size_t column) const
+    -> std::uint64_t;
+};
+
+
+constexpr auto EhFde::contains(std::uint64_t pc) const noexcept -> bool
+{
+  return pc >= initialLocation && pc - initialLocation < addressRange;
+}
+
+
+constexpr auto RegisterRules::find(std::uint32_t reg) const noexcept
+  -> RegisterRule
+{
+  for (std::size_t i{}; i < mSize; ++i) {
+    if (mRules[i].reg == reg) { return mRules[i]; }
+  }
+
+  return { reg, RegisterRuleKind::unspecified, 0, {} };
+}
+
+constexpr auto RegisterRules::set(const RegisterRule& rule) -> void
+{
+  for (std::size_t i{}; i < mSize; ++i) {
+    if (mRules[i].reg != rule.reg) { continue; }
+
+    if (rule.kind == RegisterRuleKind::unspecified) {
+      mRules[i] = mRules[--mSize];
+    } else {
+      mRules[i] = rule;
+    }
+    return;
+  }
+
+  if (rule.kind == RegisterRuleKind::unspecified) { return; }
+
+  if (mSize == capacity) {
+    throw PelfException{ "Too many register rules in a call frame table row" };
+  }
+  mRules[mSize++] = rule;
+}
+
+constexpr auto RegisterRules::size() const noexcept -> std::size_t
+{
+  return mSize;
+}
+
+constexpr auto RegisterRules::begin() const noexcept -> const RegisterRule*
+{
+  return mRules.data();
+}
+
+constexpr auto RegisterRules::end() const noexcept -> const RegisterRule*
+{
+  return mRules.data() + mSize;
+}
+
+
+constexpr auto UnwindRow::rule(std::uint32_t reg) const noexcept
+  -> RegisterRule
+{
+  return rules.find(reg);
+}
+
+
+template<std::endian Endian>
+constexpr auto readEncodedPointer(DwarfReader<Endian>& reader,
+  std::uint8_t encoding,
+  std::uint64_t address,
+  std::optional<std::uint64_t> dataAddress,
+  std::uint8_t addressSize) -> std::uint64_t
+{
+  if (encoding == DW_EH_PE_omit) {
+    throw PelfException{ "Invalid pointer encoding, the pointer is omitted" };
+  }
+
+  const std::uint8_t application = encoding & 0x70;
+
+  if (application == DW_EH_PE_aligned) {
+    const auto misalignment = (address + reader.offset()) % addressSize;
+    if (misalignment != 0) { reader.skip(addressSize - misalignment); }
+  }
+
+  const std::uint64_t field = address + reader.offset();
+  std::uint64_t value{};
+
+  switch (encoding & 0x0f) {
+  case DW_EH_PE_absptr:
+    value = reader.readAddress(addressSize);
+    break;
+  case DW_EH_PE_uleb128:
+    value = reader.readUleb128();
+    break;
+  case DW_EH_PE_udata2:
+    value = reader.template read<std::uint16_t>();
+    break;
+  case DW_EH_PE_udata4:
+    value = reader.template read<std::uint32_t>();
+    break;
+  case DW_EH_PE_udata8:
+    value = reader.template read<std::uint64_t>();
+    break;
+  case DW_EH_PE_sleb128:
+    value = static_cast<std::uint64_t>(reader.readSleb128());
+    break;
+  case DW_EH_PE_sdata2:
+    value = static_cast<std::uint64_t>(
+      std::int64_t{ static_cast<std::int16_t>(reader.template read<std::uint16_t>()) });
+    break;
+  case DW_EH_PE_sdata4:
+    value = static_cast<std::uint64_t>(
+      std::int64_t{ static_cast<std::int32_t>(reader.template read<std::uint32_t>()) });
+    break;
+  case DW_EH_PE_sdata8:
+    value = reader.template read<std::uint64_t>();
+    break;
+  default:
+    throw PelfException{ "Unsupported pointer encoding" };
+  }
+
+  switch (application) {
+  case DW_EH_PE_absptr:
+  case DW_EH_PE_aligned:
+    break;
+  case DW_EH_PE_pcrel:
+    value += field;
+    break;
+  case DW_EH_PE_datarel:
+    if (!dataAddress) {
+      throw PelfException{ "Unsupported pointer encoding, no data relative base" };
+    }
+    value += *dataAddress;
+    break;
+  default:
+    throw PelfException{
+      "Unsupported pointer encoding, text and function relative pointers"
+    };
+  }
+
+  return addressSize == 4 ? value & 0xffffffff : value;
+}
+
+
+template<std::endian Endian>
+EhFrame<Endian>::EhFrame(std::span<const unsigned char> data,
+  std::uint64_t address,
+  std::uint8_t addressSize) noexcept
+  : mData(data), mAddress(address), mAddressSize(addressSize)
+{}
+
+template<std::endian Endian>
+auto EhFrame<Endian>::data() const noexcept -> std::span<const unsigned char>
+{
+  return mData;
+}
+
+template<std::endian Endian>
+auto EhFrame<Endian>::address() const noexcept -> std::uint64_t
+{
+  return mAddress;
+}
+
+template<std::endian Endian>
+auto EhFrame<Endian>::readEntryHeader(std::uint64_t offset) const
+  -> EntryHeader
+{
+  if (offset >= mData.size()) {
+    throw PelfException{ "Invalid .eh_frame offset, out of the section" };
+  }
+
+  DwarfReader<Endian> reader{ mData };
+  reader.seek(static_cast<std::size_t>(offset));
+
+  /* The CIE id/pointer is 4 bytes in .eh_frame, even with a 64-bit length */
+  const auto length = reader.readUnitLength();
+  EntryHeader entry{ reader.offset(), static_cast<std::size_t>(length.length) };
+
+  if (entry.size == 0) { return entry; }
+  if (entry.size < 4) {
+    throw PelfException{ "Invalid .eh_frame entry, it's too small" };
+  }
+
+  entry.id = reader.template read<std::uint32_t>();
+  return entry;
+}
+
+template<std::endian Endian>
+auto EhFrame<Endian>::cie(std::uint64_t offset) -> EhCie
+{
+  const std::size_t slot = (offset / 4) % cieCacheSize;
+
+  if (!mCached[slot] || mCies[slot].offset != offset) {
+    mCies[slot] = parseCie(offset);
+    mCached[slot] = true;
+  }
+
+  return mCies[slot];
+}
+
+template<std::endian Endian>
+auto EhFrame<Endian>::parseCie(std::uint64_t offset) const -> EhCie
+{
+  const auto entry = readEntryHeader(offset);
+  if (entry.size == 0 || entry.id != 0) {
+    throw PelfException{ "Invalid CIE offset, the entry isn't a CIE" };
+  }
+
+  DwarfReader<Endian> reader{ mData.subspan(entry.idOffset, entry.size) };
+  const std::uint64_t address = mAddress + entry.idOffset;
+  reader.skip(4);
+
+  EhCie cie;
+  cie.offset = offset;
+  cie.version = reader.template read<std::uint8_t>();
+
+  if (cie.version != 1 && cie.version != 3 && cie.version != 4) {
+    throw PelfException{ "Unsupported CIE version" };
+  }
+
+  cie.augmentation = reader.readString();
+
+  /* Pointer to the exception table of very old GCC versions */
+  if (cie.augmentation == "eh") { reader.skip(mAddressSize); }
+
+  if (cie.version == 4) {
+    reader.skip(2);// address_size and segment_selector_size
+  }
+
+  cie.codeAlignment = reader.readUleb128();
+  cie.dataAlignment = reader.readSleb128();
+  cie.returnAddressRegister = cie.version == 1
+                                ? reader.template read<std::uint8_t>()
+                                : reader.readUleb128();
+
+  if (!cie.augmentation.empty() && cie.augmentation[0] == 'z') {
+    const auto size = reader.readUleb128();
+    if (size > reader.remaining()) {
+      throw PelfException{ "Invalid CIE, the augmentation data exceeds it" };
+    }
+    const std::size_t end = reader.offset() + static_cast<std::size_t>(size);
+
+    for (const char augmentation : cie.augmentation.substr(1)) {
+      if (augmentation == 'L') {
+        cie.lsdaEncoding = reader.template read<std::uint8_t>();
+      } else if (augmentation == 'P') {
+        cie.personalityEncoding = reader.template read<std::uint8_t>();
+        cie.personality = readEncodedPointer(reader,
+          cie.personalityEncoding,
+          address,
+          std::nullopt,
+          mAddressSize);
+      } else if (augmentation == 'R') {
+        cie.fdeEncoding = reader.template read<std::uint8_t>();
+      } else if (augmentation == 'S') {
+        cie.signalFrame = true;
+      } else if (augmentation != 'B' && augmentation != 'G') {
+        /* Unknown augmentation, the length lets us skip the rest */
+        break;
+      }
+    }
+
+    reader.seek(end);
+  } else if (!cie.augmentation.empty() && cie.augmentation != "eh") {
+    throw PelfException{ "Unsupported CIE augmentation" };
+  }
+
+  cie.instructions = reader.readBytes(reader.remaining());
+  return cie;
+}
+
+template<std::endian Endian>
+auto EhFrame<Endian>::fde(std::uint64_t offset) -> EhFde
+{
+  const auto entry = readEntryHeader(offset);
+  if (entry.size == 0 || entry.id == 0) {
+    throw PelfException{ "Invalid FDE offset, the entry isn't an FDE" };
+  }
+
+  return parseFde(offset, entry);
+}
+
+template<std::endian Endian>
+auto EhFrame<Endian>::parseFde(std::uint64_t offset, const EntryHeader& entry)
+  -> EhFde
+{
+  /* The CIE pointer is the distance from the field to the CIE */
+  if (entry.id > entry.idOffset) {
+    throw PelfException{ "Invalid FDE, its CIE is out of the section" };
+  }
+
+  EhFde fde;
+  fde.offset = offset;
+  fde.cie = cie(entry.idOffset - entry.id);
+
+  DwarfReader<Endian> reader{ mData.subspan(entry.idOffset, entry.size) };
+  const std::uint64_t address = mAddress + entry.idOffset;
+  reader.skip(4);
+
+  fde.initialLocation = readEncodedPointer(
+    reader, fde.cie.fdeEncoding, address, std::nullopt, mAddressSize);
+  /* The range only uses the format of the encoding */
+  fde.addressRange = readEncodedPointer(reader,
+    static_cast<std::uint8_t>(fde.cie.fdeEncoding & 0x0f),
+    address,
+    std::nullopt,
+    mAddressSize);
+
+  if (!fde.cie.augmentation.empty() && fde.cie.augmentation[0] == 'z') {
+    const auto size = reader.readUleb128();
+    if (size > reader.remaining()) {
+      throw PelfException{ "Invalid FDE, the augmentation data exceeds it" };
+    }
+    const std::size_t end = reader.offset() + static_cast<std::size_t>(size);
+
+    if (fde.cie.lsdaEncoding != DW_EH_PE_omit && size != 0) {
+      fde.lsda = readEncodedPointer(
+        reader, fde.cie.lsdaEncoding, address, std::nullopt, mAddressSize);
+    }
+
+    reader.seek(end);
+  }
+
+  fde.instructions = reader.readBytes(reader.remaining());
+  return fde;
+}
+
+template<std::endian Endian>
+auto EhFrame<Endian>::find(std::uint64_t pc) -> std::optional<EhFde>
+{
+  std::uint64_t offset{};
+
+  while (offset < mData.size()) {
+    const auto entry = readEntryHeader(offset);
+    if (entry.size == 0) { break; }// zero terminator
+
+    if (entry.id != 0) {
+      auto fde = parseFde(offset, entry);
+      if (fde.contains(pc)) { return fde; }
+    }
+
+    offset = entry.idOffset + entry.size;
+  }
+
+  return std::nullopt;
+}
+
+template<std::endian Endian>
+auto EhFrame<Endian>::unwindRow(const EhFde& fde, std::uint64_t pc) const
+  -> UnwindRow
+{
+  if (!fde.contains(pc)) {
+    throw PelfException{ "Invalid address, it isn't covered by the FDE" };
+  }
+
+  UnwindRow row;
+  row.location = fde.initialLocation;
+  row.endLocation = fde.initialLocation + fde.addressRange;
+  row.returnAddressRegister = fde.cie.returnAddressRegister;
+
+  /* DW_CFA_restore goes back to the rules of the initial instructions */
+  execute(fde.cie,
+    fde.cie.instructions,
+    std::numeric_limits<std::uint64_t>::max(),
+    row,
+    nullptr);
+  const RegisterRules initial = row.rules;
+  execute(fde.cie, fde.instructions, pc, row, &initial);
+
+  return row;
+}
+
+template<std::endian Endian>
+auto EhFrame<Endian>::execute(const EhCie& cie,
+  std::span<const unsigned char> instructions,
+  std::uint64_t pc,
+  UnwindRow& row,
+  const RegisterRules* initial) const -> void
+{
+  DwarfReader<Endian> reader{ instructions };
+  const std::uint64_t address =
+    mAddress + static_cast<std::uint64_t>(instructions.data() - mData.data());
+
+  /* Created on the first DW_CFA_remember_state, most FDEs don't have one */
+  std::optional<std::array<SavedRules, rememberDepth>> saved;
+  std::size_t depth{};
+
+  /* Moves to the next row, `false` once it starts after `pc` */
+  const auto advance_to = [&](std::uint64_t location) {
+    if (location > pc) {
+      row.endLocation = location;
+      return false;
+    }
+    row.location = location;
+    return true;
+  };
+
+  const auto read_register = [&] {
+    const auto reg = reader.readUleb128();
+    if (reg > std::numeric_limits<std::uint32_t>::max()) {
+      throw PelfException{ "Invalid call frame instruction, register number" };
+    }
+    return static_cast<std::uint32_t>(reg);
+  };
+
+  const auto factored = [&](std::int64_t value) {
+    return value * cie.dataAlignment;
+  };
+
+  const auto set_rule =
+    [&](std::uint32_t reg, RegisterRuleKind kind, std::int64_t value) {
+      row.rules.set({ reg, kind, value, {} });
+    };
+
+  const auto set_expression = [&](std::uint32_t reg, RegisterRuleKind kind) {
+    const auto size = reader.readUleb128();
+    if (size > reader.remaining()) {
+      throw PelfException{ "Invalid call frame instruction, expression size" };
+    }
+    row.rules.set(
+      { reg, kind, 0, reader.readBytes(static_cast<std::size_t>(size)) });
+  };
+
+  const auto restore = [&](std::uint32_t reg) {
+    if (initial == nullptr) {
+      throw PelfException{ "Invalid call frame instruction, restore in a CIE" };
+    }
+    row.rules.set(initial->find(reg));
+  };
+
+  while (!reader.empty()) {
+    const auto opcode = reader.template read<std::uint8_t>();
+    const std::uint8_t operand = opcode & 0x3f;
+
+    /* The high 2 bits select the instructions with an embedded operand */
+    switch (opcode & 0xc0) {
+    case DW_CFA_advance_loc:
+      if (!advance_to(row.location + operand * cie.codeAlignment)) { return; }
+      continue;
+    case DW_CFA_offset:
+      set_rule(operand,
+        RegisterRuleKind::offset,
+        factored(static_cast<std::int64_t>(reader.readUleb128())));
+      continue;
+    case DW_CFA_restore:
+      restore(operand);
+      continue;
+    default:
+      break;
+    }
+
+    switch (opcode) {
+    case DW_CFA_nop:
+      break;
+    case DW_CFA_set_loc:
+      if (!advance_to(readEncodedPointer(
+            reader, cie.fdeEncoding, address, std::nullopt, mAddressSize))) {
+        return;
+      }
+      break;
+    case DW_CFA_advance_loc1:
+      if (!advance_to(row.location
+                      + reader.template read<std::uint8_t>() * cie.codeAlignment)) {
+        return;
+      }
+      break;
+    case DW_CFA_advance_loc2:
+      if (!advance_to(row.location
+                      + reader.template read<std::uint16_t>() * cie.codeAlignment)) {
+        return;
+      }
+      break;
+    case DW_CFA_advance_loc4:
+      if (!advance_to(row.location
+                      + reader.template read<std::uint32_t>() * cie.codeAlignment)) {
+        return;
+      }
+      break;
+    case DW_CFA_offset_extended: {
+      const auto reg = read_register();
+      set_rule(reg,
+        RegisterRuleKind::offset,
+        factored(static_cast<std::int64_t>(reader.readUleb128())));
+      break;
+    }
+    case DW_CFA_restore_extended:
+      restore(read_register());
+      break;
+    case DW_CFA_undefined:
+      set_rule(read_register(), RegisterRuleKind::undefined, 0);
+      break;
+    case DW_CFA_same_value:
+      set_rule(read_register(), RegisterRuleKind::sameValue, 0);
+      break;
+    case DW_CFA_register: {
+      const auto reg = read_register();
+      set_rule(reg, RegisterRuleKind::inRegister, read_register());
+      break;
+    }
+    case DW_CFA_remember_state:
+      if (depth == rememberDepth) {
+        throw PelfException{ "Too many nested DW_CFA_remember_state" };
+      }
+      if (!saved) { saved.emplace(); }
+      (*saved)[depth++] = { row.cfa, row.rules };
+      break;
+    case DW_CFA_restore_state:
+      if (depth == 0) {
+        throw PelfException{ "DW_CFA_restore_state without a saved state" };
+      }
+      --depth;
+      row.cfa = (*saved)[depth].cfa;
+      row.rules = (*saved)[depth].rules;
+      break;
+    case DW_CFA_def_cfa: {
+      const auto reg = read_register();
+      row.cfa = { CfaRuleKind::registerOffset,
+        reg,
+        static_cast<std::int64_t>(reader.readUleb128()),
+        {} };
+      break;
+    }
+    case DW_CFA_def_cfa_register:
+      row.cfa.kind = CfaRuleKind::registerOffset;
+      row.cfa.reg = read_register();
+      row.cfa.expression = {};
+      break;
+    case DW_CFA_def_cfa_offset:
+      row.cfa.offset = static_cast<std::int64_t>(reader.readUleb128());
+      break;
+    case DW_CFA_def_cfa_expression: {
+      const auto size = reader.readUleb128();
+      if (size > reader.remaining()) {
+        throw PelfException{ "Invalid call frame instruction, expression size" };
+      }
+      row.cfa = { CfaRuleKind::expression,
+        0,
+        0,
+        reader.readBytes(static_cast<std::size_t>(size)) };
+      break;
+    }
+    case DW_CFA_expression:
+      set_expression(read_register(), RegisterRuleKind::expression);
+      break;
+    case DW_CFA_offset_extended_sf: {
+      const auto reg = read_register();
+      set_rule(reg, RegisterRuleKind::offset, factored(reader.readSleb128()));
+      break;
+    }
+    case DW_CFA_def_cfa_sf: {
+      const auto reg = read_register();
+      row.cfa = { CfaRuleKind::registerOffset,
+        reg,
+        factored(reader.readSleb128()),
+        {} };
+      break;
+    }
+    case DW_CFA_def_cfa_offset_sf:
+      row.cfa.offset = factored(reader.readSleb128());
+      break;
+    case DW_CFA_val_offset: {
+      const auto reg = read_register();
+      set_rule(reg,
+        RegisterRuleKind::valOffset,
+        factored(static_cast<std::int64_t>(reader.readUleb128())));
+      break;
+    }
+    case DW_CFA_val_offset_sf: {
+      const auto reg = read_register();
+      set_rule(reg, RegisterRuleKind::valOffset, factored(reader.readSleb128()));
+      break;
+    }
+    case DW_CFA_val_expression:
+      set_expression(read_register(), RegisterRuleKind::valExpression);
+      break;
+    case DW_CFA_GNU_window_save:
+      /* SPARC register windows / AArch64 return address signing, neither
+       * changes the rules of the row */
+      break;
+    case DW_CFA_GNU_args_size:
+      row.argsSize = reader.readUleb128();
+      break;
+    case DW_CFA_GNU_negative_offset_extended: {
+      const auto reg = read_register();
+      set_rule(reg,
+        RegisterRuleKind::offset,
+        -factored(static_cast<std::int64_t>(reader.readUleb128())));
+      break;
+    }
+    default:
+      throw PelfException{ "Unsupported call frame instruction" };
+    }
+  }
+}
+
+
+template<std::endian Endian>
+EhFrameHdr<Endian>::EhFrameHdr(std::span<const unsigned char> hdr,
+  std::uint64_t hdrAddress,
+  std::span<const unsigned char> frame,
+  std::uint8_t addressSize)
+  : mHdr(hdr), mHdrAddress(hdrAddress), mAddressSize(addressSize),
+    mFrame(frame, readFramePointer(hdr, hdrAddress, addressSize), addressSize)
+{
+  DwarfReader<Endian> reader{ hdr };
+  reader.skip(1);// version, checked by readFramePointer
+  const auto frame_encoding = reader.template read<std::uint8_t>();
+  const auto count_encoding = reader.template read<std::uint8_t>();
+  mTableEncoding = reader.template read<std::uint8_t>();
+
+  readEncodedPointer(
+    reader, frame_encoding, hdrAddress, hdrAddress, addressSize);
+
+  if (count_encoding == DW_EH_PE_omit || mTableEncoding == DW_EH_PE_omit) {
+    return;
+  }
+
+  const auto count =
+    readEncodedPointer(reader, count_encoding, hdrAddress, hdrAddress, addressSize);
+
+  switch (mTableEncoding & 0x0f) {
+  case DW_EH_PE_absptr:
+    mValueSize = addressSize;
+    break;
+  case DW_EH_PE_udata2:
+  case DW_EH_PE_sdata2:
+    mValueSize = 2;
+    break;
+  case DW_EH_PE_udata4:
+  case DW_EH_PE_sdata4:
+    mValueSize = 4;
+    break;
+  case DW_EH_PE_udata8:
+  case DW_EH_PE_sdata8:
+    mValueSize = 8;
+    break;
+  default:
+    /* LEB128 entries can't be searched, find() walks .eh_frame instead */
+    return;
+  }
+
+  if (count > reader.remaining() / (2 * mValueSize)) {
+    throw PelfException{ "Invalid .eh_frame_hdr, the table exceeds the section" };
+  }
+
+  mTableOffset = reader.offset();
+  mCount = static_cast<std::size_t>(count);
+}
+
+template<std::endian Endian>
+auto EhFrameHdr<Endian>::readFramePointer(std::span<const unsigned char> hdr,
+  std::uint64_t hdrAddress,
+  std::uint8_t addressSize) -> std::uint64_t
+{
+  DwarfReader<Endian> reader{ hdr };
+
+  if (reader.template read<std::uint8_t>() != 1) {
+    throw PelfException{ "Unsupported .eh_frame_hdr version" };
+  }
+
+  const auto frame_encoding = reader.template read<std::uint8_t>();
+  reader.skip(2);
+
+  return readEncodedPointer(
+    reader, frame_encoding, hdrAddress, hdrAddress, addressSize);
+}
+
+template<std::endian Endian>
+auto EhFrameHdr<Endian>::size() const noexcept -> std::size_t
+{
+  return mCount;
+}
+
+template<std::endian Endian>
+auto EhFrameHdr<Endian>::readValue(std::size_t index, std::size_t column) const
+  -> std::uint64_t
+{
+  const std::size_t offset = mTableOffset + (2 * index + column) * mValueSize;
+
+  /* Encoding used by GNU ld and lld, no need for the generic decoder */
+  if (mTableEncoding == (DW_EH_PE_datarel | DW_EH_PE_sdata4)) {
+    const auto value =
+      static_cast<std::int32_t>(readInteger<std::uint32_t, Endian>(mHdr, offset));
+    const auto address = mHdrAddress + static_cast<std::uint64_t>(value);
+    return mAddressSize == 4 ? address & 0xffffffff : address;
+  }
+
+  DwarfReader<Endian> reader{ mHdr };
+  reader.seek(offset);
+  return readEncodedPointer(
+    reader, mTableEncoding, mHdrAddress, mHdrAddress, mAddressSize);
+}
+
+template<std::endian Endian>
+auto EhFrameHdr<Endian>::entry(std::size_t index) const -> EhFrameHdrEntry
+{
+  if (index >= mCount) {
+    throw PelfException{ "Invalid index, out of the .eh_frame_hdr table" };
+  }
+
+  return { readValue(index, 0), readValue(index, 1) };
+}
+
+template<std::endian Endian>
+auto EhFrameHdr<Endian>::find(std::uint64_t pc) -> std::optional<EhFde>
+{
+  if (mCount == 0) { return mFrame.find(pc); }
+
+  /* Last entry whose initial location is <= pc */
+  std::size_t first{};
+  std::size_t last{ mCount };
+  while (first < last) {
+    const std::size_t middle = first + (last - first) / 2;
+    if (readValue(middle, 0) <= pc) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+
+  if (first == 0) { return std::nullopt; }
+
+  const auto fde_address = readValue(first - 1, 1);
+  if (fde_address < mFrame.address()) {
+    throw PelfException{ "Invalid .eh_frame_hdr entry, FDE out of .eh_frame" };
+  }
+
+  auto fde = mFrame.fde(fde_address - mFrame.address());
+  if (!fde.contains(pc)) { return std::nullopt; }
+
+  return fde;
+}
+
+template<std::endian Endian>
+auto EhFrameHdr<Endian>::unwindRow(std::uint64_t pc)
+  -> std::optional<UnwindRow>
+{
+  const auto fde = find(pc);
+  if (!fde) { return std::nullopt; }
+
+  return mFrame.unwindRow(*fde, pc);
+}
+
+template<std::endian Endian>
+auto EhFrameHdr<Endian>::frame() noexcept -> EhFrame<Endian>&
+{
+  return mFrame;
+}
+
+
+}// namespace pelf
+
+
+#endif
@@ -0,0 +1,287 @@
+/** @file elfNotes.h
+ *  @brief NoteIterator and NoteRange class declarations
+ *
+ *  This file contains an iterator over the notes stored in a PT_NOTE segment
+ *  or a SHT_NOTE section. Notes are decoded lazily from the bytes of the
+ *  segment, nothing outside of it is read
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef ELFNOTES_H_
+#define ELFNOTES_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string_view>
+
+#include "Pelf.h"
+#include "elfStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief A note decoded by `NoteIterator`
+ *
+ *  `name` and `desc` point into the data of the file, they are valid as long
+ *  as the data is
+ * */
+struct ElfNote
+{
+  Elf64_Nhdr header{}; /**< Note header, already in the byte order of the host */
+  std::span<const unsigned char> name; /**< Owner of the note, `n_namesz`
+                                          bytes (including the null byte) */
+  std::span<const unsigned char> desc; /**< Descriptor, `n_descsz` bytes */
+
+  /** @brief Returns the name of the owner without the null terminator
+   *
+   *  @return e.g. "GNU"
+   * */
+  [[nodiscard]] auto owner() const noexcept -> std::string_view;
+
+  /** @brief Returns `true` if the owner of the note is `owner`
+   *
+   *  Unlike `owner()` it can be used in constant expressions
+   *
+   *  @param owner Name without the null terminator, e.g. "GNU"
+   * */
+  [[nodiscard]] constexpr auto isOwner(std::string_view owner) const noexcept
+    -> bool;
+};
+
+
+/** @brief Forward iterator over the notes of a note segment or section
+ *
+ *  @tparam Endian Byte order of the file
+ * */
+template<std::endian Endian = std::endian::little>
+class NoteIterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = ElfNote;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const ElfNote*;
+  using reference = const ElfNote&;
+
+  /** @brief Constructs the end iterator */
+  constexpr NoteIterator() = default;
+
+  /** @brief NoteIterator constructor
+   *
+   *  @param data Bytes of the note segment or section
+   *  @param alignment Alignment of the name and the descriptor (4, or 8 for
+   *  some 64-bit notes), it's the `p_align`/`sh_addralign` of the segment
+   * */
+  constexpr NoteIterator(std::span<const unsigned char> data,
+    std::size_t alignment);
+
+  [[nodiscard]] constexpr auto operator*() const noexcept -> reference;
+
+  [[nodiscard]] constexpr auto operator->() const noexcept -> pointer;
+
+  constexpr auto operator++() -> NoteIterator&;
+
+  constexpr auto operator++(int) -> NoteIterator;
+
+  [[nodiscard]] constexpr auto operator==(const NoteIterator& other) const
+    noexcept -> bool;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes from the current note to
+                                           the end of the segment */
+  std::size_t mAlignment{ 4 }; /**< Alignment of name and descriptor */
+  std::size_t mSize{}; /**< Size of the current note, including padding */
+  ElfNote mNote{}; /**< Current note */
+
+  /** @brief Decodes the note at the beginning of `mData`
+   *
+   *  Trailing bytes that can't hold a note header are padding and end the
+   *  iteration, a note whose name or descriptor exceeds the segment throws
+   *  `PelfException`
+   * */
+  constexpr auto load() -> void;
+};
+
+
+/** @brief Range of the notes of a note segment or section
+ *
+ *  e.g. `for (const auto& note : NoteRange{ bytes })`
+ *
+ *  @tparam Endian Byte order of the file
+ * */
+template<std::endian Endian = std::endian::little>
+class NoteRange
+{
+public:
+  /** @brief NoteRange constructor
+   *
+   *  @param data Bytes of the note segment or section
+   *  @param alignment Alignment of the name and the descriptor
+   * */
+  constexpr explicit NoteRange(std::span<const unsigned char> data,
+    std::size_t alignment = 4) noexcept;
+
+  [[nodiscard]] constexpr auto begin() const -> NoteIterator<Endian>;
+
+  [[nodiscard]] constexpr auto end() const noexcept -> NoteIterator<Endian>;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the segment */
+  std::size_t mAlignment; /**< Alignment of name and descriptor */
+};
+
+
+/** @brief Returns the descriptor of the first NT_GNU_BUILD_ID note of `notes`
+ *
+ *  @param notes Notes of a segment or section
+ *
+ *  @return Build ID bytes, empty if there isn't a build ID note
+ * */
+template<std::endian Endian>
+constexpr auto findBuildId(const NoteRange<Endian>& notes)
+  -> std::span<const unsigned char>;
+
+
+inline auto ElfNote::owner() const noexcept -> std::string_view
+{
+  std::size_t size = name.size();
+  while (size != 0 && name[size - 1] == 0) { --size; }
+
+  return { reinterpret_cast<const char*>(name.data()), size };
+}
+
+constexpr auto ElfNote::isOwner(std::string_view owner) const noexcept -> bool
+{
+  /* n_namesz includes the null terminator */
+  if (name.size() != owner.size() + 1 || name[owner.size()] != 0) {
+    return false;
+  }
+
+  for (std::size_t i{}; i < owner.size(); ++i) {
+    if (name[i] != static_cast<unsigned char>(owner[i])) { return false; }
+  }
+
+  return true;
+}
+
+
+template<std::endian Endian>
+constexpr NoteIterator<Endian>::NoteIterator(std::span<const unsigned char> data,
+  std::size_t alignment)
+  : mData(data), mAlignment(alignment == 8 ? 8 : 4)
+{
+  load();
+}
+
+template<std::endian Endian>
+constexpr auto NoteIterator<Endian>::operator*() const noexcept -> reference
+{
+  return mNote;
+}
+
+template<std::endian Endian>
+constexpr auto NoteIterator<Endian>::operator->() const noexcept -> pointer
+{
+  return &mNote;
+}
+
+template<std::endian Endian>
+constexpr auto NoteIterator<Endian>::operator++() -> NoteIterator&
+{
+  mData = mSize < mData.size() ? mData.subspan(mSize)
+                               : std::span<const unsigned char>{};
+  load();
+  return *this;
+}
+
+template<std::endian Endian>
+constexpr auto NoteIterator<Endian>::operator++(int) -> NoteIterator
+{
+  auto copy = *this;
+  ++*this;
+  return copy;
+}
+
+template<std::endian Endian>
+constexpr auto NoteIterator<Endian>::operator==(
+  const NoteIterator& other) const noexcept -> bool
+{
+  return mData.data() == other.mData.data()
+         && mData.size() == other.mData.size();
+}
+
+template<std::endian Endian>
+constexpr auto NoteIterator<Endian>::load() -> void
+{
+  if (mData.size() < sizeof(Elf64_Nhdr)) {
+    mData = {};
+    return;
+  }
+
+  mNote.header.n_namesz = readInteger<std::uint32_t, Endian>(mData, 0);
+  mNote.header.n_descsz = readInteger<std::uint32_t, Endian>(mData, 4);
+  mNote.header.n_type = readInteger<std::uint32_t, Endian>(mData, 8);
+
+  const auto align = [&](std::size_t size) {
+    return (size + mAlignment - 1) & ~(mAlignment - 1);
+  };
+
+  const std::size_t name_offset = sizeof(Elf64_Nhdr);
+  const std::size_t name_size = align(mNote.header.n_namesz);
+  const std::size_t available = mData.size() - name_offset;
+
+  if (name_size > available || mNote.header.n_descsz > available - name_size) {
+    throw PelfException{ "Invalid note, it exceeds the note segment" };
+  }
+
+  const std::size_t desc_offset = name_offset + name_size;
+  mNote.name = mData.subspan(name_offset, mNote.header.n_namesz);
+  mNote.desc = mData.subspan(desc_offset, mNote.header.n_descsz);
+  mSize = desc_offset + align(mNote.header.n_descsz);
+}
+
+
+template<std::endian Endian>
+constexpr NoteRange<Endian>::NoteRange(std::span<const unsigned char> data,
+  std::size_t alignment) noexcept
+  : mData(data), mAlignment(alignment)
+{}
+
+template<std::endian Endian>
+constexpr auto NoteRange<Endian>::begin() const -> NoteIterator<Endian>
+{
+  return NoteIterator<Endian>{ mData, mAlignment };
+}
+
+template<std::endian Endian>
+constexpr auto NoteRange<Endian>::end() const noexcept -> NoteIterator<Endian>
+{
+  return NoteIterator<Endian>{};
+}
+
+
+template<std::endian Endian>
+constexpr auto findBuildId(const NoteRange<Endian>& notes)
+  -> std::span<const unsigned char>
+{
+  for (const auto& note : notes) {
+    if (note.header.n_type == NT_GNU_BUILD_ID && note.isOwner("GNU")) {
+      return note.desc;
+    }
+  }
+
+  return {};
+}
+
+
+}// namespace pelf
+
+
+#endif
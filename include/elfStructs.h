@@ -13,7 +13,11 @@
 #ifndef ELFSTRUCTS_H_
 #define ELFSTRUCTS_H_
 
+#include <array>
 #include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 #include <boost/hana.hpp>
 
@@ -22,9 +26,104 @@ namespace hana = boost::hana;
 namespace pelf {
 
 
+inline constexpr int ELFCLASS32 = 1;
 inline constexpr int ELFCLASS64 = 2;
+inline constexpr std::size_t EI_CLASS_OFFSET{
+  4
+}; /**< Index of the file class byte in e_ident */
+inline constexpr int ELFDATA2LSB = 1; /**< Two's complement, little endian */
+inline constexpr int ELFDATA2MSB = 2; /**< Two's complement, big endian */
+inline constexpr std::size_t EI_DATA_OFFSET{
+  5
+}; /**< Index of the data encoding byte in e_ident */
 inline constexpr int PN_XNUM = 0xffff;
 inline constexpr int SHN_LORESERVE = 0xff00;
+inline constexpr int SHN_XINDEX = 0xffff; /**< The real index is elsewhere */
+
+/* Section types (sh_type) */
+inline constexpr std::uint32_t SHT_NULL{ 0 }; /**< Inactive section header */
+inline constexpr std::uint32_t SHT_PROGBITS{
+  1
+}; /**< Information defined by the program */
+inline constexpr std::uint32_t SHT_SYMTAB{ 2 }; /**< Symbol table */
+inline constexpr std::uint32_t SHT_STRTAB{ 3 }; /**< String table */
+inline constexpr std::uint32_t SHT_NOTE{ 7 }; /**< Note section */
+inline constexpr std::uint32_t SHT_NOBITS{
+  8
+}; /**< Section that occupies no space in the file (e.g. .bss) */
+
+/* Section flags (sh_flags) */
+inline constexpr std::uint64_t SHF_WRITE{
+  0x1
+}; /**< Section is writable during execution */
+inline constexpr std::uint64_t SHF_ALLOC{
+  0x2
+}; /**< Section occupies memory during execution */
+inline constexpr std::uint64_t SHF_EXECINSTR{
+  0x4
+}; /**< Section contains executable instructions */
+inline constexpr std::uint64_t SHF_COMPRESSED{
+  0x800
+}; /**< Section data starts with a compression header (`Elf64_Chdr`) */
+
+/* Compression algorithms (ch_type) */
+inline constexpr std::uint32_t ELFCOMPRESS_ZLIB{ 1 }; /**< zlib stream */
+inline constexpr std::uint32_t ELFCOMPRESS_ZSTD{ 2 }; /**< Zstandard frame */
+
+/* File types (e_type) */
+inline constexpr std::uint16_t ET_REL{ 1 }; /**< Relocatable file */
+inline constexpr std::uint16_t ET_EXEC{ 2 }; /**< Executable file */
+inline constexpr std::uint16_t ET_DYN{ 3 }; /**< Shared object file */
+inline constexpr std::uint16_t ET_CORE{ 4 }; /**< Core file */
+
+/* Machines (e_machine) */
+inline constexpr std::uint16_t EM_386{ 3 }; /**< Intel 80386 */
+inline constexpr std::uint16_t EM_ARM{ 40 }; /**< 32-bit Arm */
+inline constexpr std::uint16_t EM_X86_64{ 62 }; /**< AMD x86-64 */
+inline constexpr std::uint16_t EM_AARCH64{ 183 }; /**< 64-bit Arm */
+
+/* Segment types (p_type) */
+inline constexpr std::uint32_t PT_LOAD{ 1 }; /**< Loadable segment */
+inline constexpr std::uint32_t PT_NOTE{ 4 }; /**< Segment with notes */
+inline constexpr std::uint32_t PT_GNU_EH_FRAME{
+  0x6474e550
+}; /**< Segment with the `.eh_frame_hdr` section */
+
+/* Note types (n_type) */
+inline constexpr std::uint32_t NT_GNU_BUILD_ID{
+  3
+}; /**< Unique build ID, the owner of the note is "GNU" */
+
+/* Core file note types, the owner of the notes is "CORE" */
+inline constexpr std::uint32_t NT_PRSTATUS{
+  1
+}; /**< Registers and signal state of a thread (`elf_prstatus`) */
+inline constexpr std::uint32_t NT_PRFPREG{
+  2
+}; /**< Floating point registers of a thread */
+inline constexpr std::uint32_t NT_PRPSINFO{
+  3
+}; /**< Process information (`elf_prpsinfo`) */
+inline constexpr std::uint32_t NT_AUXV{ 6 }; /**< Auxiliary vector */
+inline constexpr std::uint32_t NT_SIGINFO{
+  0x53494749
+}; /**< `siginfo_t` of the signal that killed the thread */
+inline constexpr std::uint32_t NT_FILE{ 0x46494c45 }; /**< Mapped files */
+
+/* Auxiliary vector types (a_type) */
+inline constexpr std::uint64_t AT_NULL{ 0 }; /**< End of the vector */
+inline constexpr std::uint64_t AT_PHDR{ 3 }; /**< Program headers of the
+                                                executable */
+inline constexpr std::uint64_t AT_PAGESZ{ 6 }; /**< Page size */
+inline constexpr std::uint64_t AT_BASE{ 7 }; /**< Base of the interpreter */
+inline constexpr std::uint64_t AT_ENTRY{ 9 }; /**< Entry point of the
+                                                 executable */
+inline constexpr std::uint64_t AT_RANDOM{ 25 }; /**< Address of 16 random
+                                                   bytes */
+inline constexpr std::uint64_t AT_EXECFN{ 31 }; /**< Address of the file
+                                                   name of the executable */
+inline constexpr std::uint64_t AT_SYSINFO_EHDR{ 33 }; /**< Address of the
+                                                         vDSO */
 inline constexpr unsigned char EI_MAG0{
   0x7f
 }; /**< Magic number identifying the File as an ELF object file */
@@ -138,21 +237,207 @@ struct Elf64_Shdr
 };
 #pragma pack(pop)
 
+/** @brief Hana struct that represents the 32 bit elf header
+ *
+ * */
+#pragma pack(push, 1)// Disable padding
+struct Elf32_Ehdr
+{
+  /** @brief Macro that defines members of the structure
+   *
+   *
+   * */
+  BOOST_HANA_DEFINE_STRUCT(Elf32_Ehdr,
+    (std::uint64_t, e_ident_high), // first 8 bytes of e_ident
+    (std::uint64_t, e_ident_low),  // lasy 6 bytes of e_ident
+    (std::uint16_t, e_type),
+    (std::uint16_t, e_machine),
+    (std::uint32_t, e_version),
+    (std::uint32_t, e_entry),
+    (std::uint32_t, e_phoff),
+    (std::uint32_t, e_shoff),
+    (std::uint32_t, e_flags),
+    (std::uint16_t, e_ehsize),
+    (std::uint16_t, e_phentsize),
+    (std::uint16_t, e_phnum),// Number of entries in the program header table
+    (std::uint16_t, e_shentsize),
+    (std::uint16_t, e_shnum),//
+    (std::uint16_t, e_shstrndx));
+};
+#pragma pack(pop)
+
+/** @brief Hana struct that represents the 32 bit program header table, notice
+ * that p_flags is at a different position than in the 64 bit header
+ *
+ * */
+#pragma pack(push, 1)// Disable padding
+struct Elf32_Phdr
+{
+  /** @brief Macro that defines members of the structure
+   *
+   *
+   * */
+  BOOST_HANA_DEFINE_STRUCT(Elf32_Phdr,
+    (std::uint32_t, p_type),
+    (std::uint32_t, p_offset),
+    (std::uint32_t, p_vaddr),
+    (std::uint32_t, p_paddr),
+    (std::uint32_t, p_filesz),
+    (std::uint32_t, p_memsz),
+    (std::uint32_t, p_flags),
+    (std::uint32_t, p_align));
+};
+#pragma pack(pop)
+
+
+/** @brief Hana struct that represents the 32 bit section header table
+ *
+ * */
+#pragma pack(push, 1)// Disable padding
+struct Elf32_Shdr
+{
+  /** @brief Macro that defines members of the structure
+   *
+   *
+   * */
+  BOOST_HANA_DEFINE_STRUCT(Elf32_Shdr,
+    (std::uint32_t, sh_name),
+    (std::uint32_t, sh_type),
+    (std::uint32_t, sh_flags),
+    (std::uint32_t, sh_addr),
+    (std::uint32_t, sh_offset),
+    (std::uint32_t, sh_size),
+    (std::uint32_t, sh_link),
+    (std::uint32_t, sh_info),
+    (std::uint32_t, sh_addralign),
+    (std::uint32_t, sh_entsize));
+};
+#pragma pack(pop)
+
+
+/** @brief Hana struct that represents the header of a note (both classes use
+ * 32-bit fields)
+ *
+ * */
+#pragma pack(push, 1)// Disable padding
+struct Elf64_Nhdr
+{
+  /** @brief Macro that defines members of the structure
+   *
+   *
+   * */
+  BOOST_HANA_DEFINE_STRUCT(Elf64_Nhdr,
+    (std::uint32_t, n_namesz),// Size of the name, including the null byte
+    (std::uint32_t, n_descsz),// Size of the descriptor
+    (std::uint32_t, n_type));
+};
+#pragma pack(pop)
+
+using Elf32_Nhdr = Elf64_Nhdr;
+
+
+/** @brief Hana struct that represents the 64 bit compression header, it's at
+ * the beginning of the data of `SHF_COMPRESSED` sections
+ *
+ * */
+#pragma pack(push, 1)// Disable padding
+struct Elf64_Chdr
+{
+  /** @brief Macro that defines members of the structure
+   *
+   *
+   * */
+  BOOST_HANA_DEFINE_STRUCT(Elf64_Chdr,
+    (std::uint32_t, ch_type),// Compression algorithm (ELFCOMPRESS_*)
+    (std::uint32_t, ch_reserved),
+    (std::uint64_t, ch_size),// Size of the uncompressed data
+    (std::uint64_t, ch_addralign));
+};
+#pragma pack(pop)
+
+
+/** @brief Hana struct that represents the 32 bit compression header
+ *
+ * */
+#pragma pack(push, 1)// Disable padding
+struct Elf32_Chdr
+{
+  /** @brief Macro that defines members of the structure
+   *
+   *
+   * */
+  BOOST_HANA_DEFINE_STRUCT(Elf32_Chdr,
+    (std::uint32_t, ch_type),
+    (std::uint32_t, ch_size),
+    (std::uint32_t, ch_addralign));
+};
+#pragma pack(pop)
+
+
+/** @brief Contents of the `.gnu_debuglink` section, it names the separate
+ * debug file of a stripped binary
+ *
+ * */
+struct DebugLink
+{
+  std::string_view fileName; /**< Name of the debug file (without directory) */
+  std::uint32_t crc{}; /**< CRC-32 of the whole debug file, see `crc32()` */
+};
+
+
+/** @brief File class of 64-bit ELF files (ELFCLASS64), selects the 64-bit
+ * structs when passed as template argument to `Elf`
+ *
+ * */
+struct Elf64Class
+{
+  using Ehdr = Elf64_Ehdr; /**< Elf header */
+  using Phdr = Elf64_Phdr; /**< Entry of the program header table */
+  using Shdr = Elf64_Shdr; /**< Entry of the section table */
+  using Chdr = Elf64_Chdr; /**< Compression header */
+
+  static constexpr unsigned char ident{ ELFCLASS64 }; /**< e_ident[EI_CLASS] */
+};
+
+/** @brief File class of 32-bit ELF files (ELFCLASS32), selects the 32-bit
+ * structs when passed as template argument to `Elf`
+ *
+ * */
+struct Elf32Class
+{
+  using Ehdr = Elf32_Ehdr; /**< Elf header */
+  using Phdr = Elf32_Phdr; /**< Entry of the program header table */
+  using Shdr = Elf32_Shdr; /**< Entry of the section table */
+  using Chdr = Elf32_Chdr; /**< Compression header */
+
+  static constexpr unsigned char ident{ ELFCLASS32 }; /**< e_ident[EI_CLASS] */
+};
+
+
 /**
  * @brief Structure that contains the Elf header and the program header table
  * from an ELF file
  *
  * @tparam NumOfProgramHeader Number of headers in the program header table
+ * @tparam Class File class (`Elf64Class` or `Elf32Class`)
+ * @tparam Allocator Allocator used by the program header table when it's a
+ * vector
  */
-template<std::size_t NumOfProgramHeader = 0> struct ElfHeaders
+template<std::size_t NumOfProgramHeader = 0,
+  class Class = Elf64Class,
+  class Allocator = std::allocator<typename Class::Phdr>>
+struct ElfHeaders
 {
+  using Phdr = typename Class::Phdr;
+
   template<std::size_t N>
   using ProgramHeaders = std::conditional_t<NumOfProgramHeader == 0,
-    std::vector<Elf64_Phdr>,
-    std::array<Elf64_Phdr, NumOfProgramHeader>>;
+    std::vector<Phdr,
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Phdr>>,
+    std::array<Phdr, NumOfProgramHeader>>;
 
 
-  Elf64_Ehdr elfHeader = {}; /**< Elf header */
+  typename Class::Ehdr elfHeader = {}; /**< Elf header */
   ProgramHeaders<NumOfProgramHeader>
     programHeaders = {}; /**< Array or vector containing all program headers from
                         the program header table*/
@@ -0,0 +1,185 @@
+/** @file mappedFile.h
+ *  @brief MappedFile class declaration
+ *
+ *  This file contains the MappedFile class declaration, a read only memory
+ *  mapping of a file. `bytes()` can be used as the container of `Elf`/`Pe`
+ *  (`std::span<const unsigned char>`) so the file is never copied and only the
+ *  pages that are actually read are loaded from disk
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+#if defined(_WIN32)
+#include <fstream>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "pelfExcept.h"
+
+
+namespace pelf {
+
+
+/** @brief Read only memory mapping of a file
+ *
+ *  On platforms without mmap the file is read into memory instead
+ * */
+class MappedFile
+{
+public:
+  /** @brief MappedFile constructor
+   *
+   *  @param path Path of the file, it throws `PelfException` if it can't be
+   *  opened or mapped
+   * */
+  explicit MappedFile(const std::filesystem::path& path);
+
+  MappedFile(const MappedFile&) = delete;
+  auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+  ~MappedFile();
+
+  /** @brief Returns the contents of the file
+   *
+   *  @return Span valid as long as the `MappedFile` is alive
+   * */
+  [[nodiscard]] auto bytes() const noexcept -> std::span<const unsigned char>;
+
+  /** @brief Returns the size of the file in bytes */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+private:
+  const unsigned char* mData{}; /**< First byte of the mapping */
+  std::size_t mSize{}; /**< Size of the mapping */
+
+#if defined(_WIN32)
+  std::vector<unsigned char> mBuffer; /**< Contents of the file */
+#endif
+
+  /** @brief Unmaps the file */
+  auto release() noexcept -> void;
+};
+
+
+#if defined(_WIN32)
+
+inline MappedFile::MappedFile(const std::filesystem::path& path)
+{
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) { throw PelfException{ "Unable to open the file" }; }
+
+  mBuffer.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char*>(mBuffer.data()),
+        static_cast<std::streamsize>(mBuffer.size()))) {
+    throw PelfException{ "Unable to read the file" };
+  }
+
+  mData = mBuffer.data();
+  mSize = mBuffer.size();
+}
+
+inline auto MappedFile::release() noexcept -> void
+{
+  mBuffer.clear();
+  mData = nullptr;
+  mSize = 0;
+}
+
+inline MappedFile::MappedFile(MappedFile&& other) noexcept
+  : mData(std::exchange(other.mData, nullptr)),
+    mSize(std::exchange(other.mSize, 0)), mBuffer(std::move(other.mBuffer))
+{}
+
+#else
+
+inline MappedFile::MappedFile(const std::filesystem::path& path)
+{
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) { throw PelfException{ "Unable to open the file" }; }
+
+  struct stat status
+  {
+  };
+  if (::fstat(fd, &status) != 0) {
+    ::close(fd);
+    throw PelfException{ "Unable to read the size of the file" };
+  }
+
+  mSize = static_cast<std::size_t>(status.st_size);
+
+  /* mmap() fails for empty files, they are represented by an empty span */
+  if (mSize != 0) {
+    void* address = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      throw PelfException{ "Unable to map the file" };
+    }
+    mData = static_cast<const unsigned char*>(address);
+  }
+
+  /* The mapping stays valid after closing the descriptor */
+  ::close(fd);
+}
+
+inline auto MappedFile::release() noexcept -> void
+{
+  if (mData != nullptr) {
+    ::munmap(const_cast<unsigned char*>(mData), mSize);
+  }
+  mData = nullptr;
+  mSize = 0;
+}
+
+inline MappedFile::MappedFile(MappedFile&& other) noexcept
+  : mData(std::exchange(other.mData, nullptr)),
+    mSize(std::exchange(other.mSize, 0))
+{}
+
+#endif
+
+inline auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile&
+{
+  if (this != &other) {
+    release();
+#if defined(_WIN32)
+    mBuffer = std::move(other.mBuffer);
+#endif
+    mData = std::exchange(other.mData, nullptr);
+    mSize = std::exchange(other.mSize, 0);
+  }
+  return *this;
+}
+
+inline MappedFile::~MappedFile() { release(); }
+
+inline auto MappedFile::bytes() const noexcept -> std::span<const unsigned char>
+{
+  return { mData, mSize };
+}
+
+inline auto MappedFile::size() const noexcept -> std::size_t { return mSize; }
+
+
+}// namespace pelf
+
+
+#endif
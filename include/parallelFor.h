@@ -0,0 +1,82 @@
+/** @file parallelFor.h
+ *  @brief Thread pool loop shared by the parallel parsers
+ *
+ *  This file contains `detail::parallelFor`, the loop used by every class
+ *  that parses or decompresses many independent items at once (archive
+ *  members, sections, debug files, PE images). Every thread takes the next
+ *  index, so big and small items are mixed and the work is balanced without
+ *  estimating sizes
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PARALLELFOR_H_
+#define PARALLELFOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace pelf {
+
+
+namespace detail {
+
+  /** @brief Calls `function(i)` for every i in [0, count) on `threads`
+   * threads, the calling thread included
+   *
+   *  The first exception thrown by `function` stops the remaining indexes and
+   *  is rethrown once every thread has finished
+   *
+   *  @param count Number of indexes
+   *  @param threads Number of threads, 0 uses one per core
+   *  @param function Callable, it's called from many threads at the same time
+   * */
+  template<class Function>
+  auto parallelFor(std::size_t count, unsigned threads, Function&& function)
+    -> void
+  {
+    if (threads == 0) {
+      threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(
+      std::min<std::size_t>(threads, std::max<std::size_t>(count, 1)));
+
+    std::atomic<std::size_t> next{};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    const auto worker = [&] {
+      for (std::size_t i = next++; i < count; i = next++) {
+        try {
+          function(i);
+        } catch (...) {
+          const std::scoped_lock lock{ error_mutex };
+          if (!error) { error = std::current_exception(); }
+          next = count;
+        }
+      }
+    };
+
+    {
+      std::vector<std::jthread> pool;
+      for (unsigned i{ 1 }; i < threads; ++i) { pool.emplace_back(worker); }
+      worker();
+    }
+
+    if (error) { std::rethrow_exception(error); }
+  }
+
+}// namespace detail
+
+
+}// namespace pelf
+
+
+#endif
@@ -0,0 +1,175 @@
+/** @file pdbSignatures.h
+ *  @brief Bulk extraction of the PDB signatures of PE images
+ *
+ *  This file contains functions that read the CodeView PDB 7.0 record (the
+ *  GUID, the age and the path of the PDB) of every PE image of a list of
+ *  files or a directory in parallel and write them as tab separated lines,
+ *  e.g. to fetch the PDBs of a corpus from a symbol server
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PDBSIGNATURES_H_
+#define PDBSIGNATURES_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <system_error>
+#include <variant>
+#include <vector>
+
+#include "mappedFile.h"
+#include "parallelFor.h"
+#include "peDebug.h"
+#include "pelfFormat.h"
+
+
+namespace pelf {
+
+
+/** @brief PDB signature of a PE image, unlike `PdbInfo` it owns the path */
+struct PdbSignature
+{
+  std::filesystem::path file; /**< Image */
+  std::array<unsigned char, 16> guid{}; /**< GUID of the PDB */
+  DWORD age{}; /**< Age of the PDB */
+  std::string pdbPath; /**< Path of the PDB when the image was linked */
+
+  /** @brief Returns a `PdbInfo` view of the signature, it's valid while the
+   * signature is alive */
+  [[nodiscard]] auto info() const noexcept -> PdbInfo
+  {
+    return PdbInfo{ guid, age, pdbPath };
+  }
+};
+
+
+/** @brief Reads the PDB signatures of `files`
+ *
+ *  @param files Paths of the files, files that can't be read, that aren't PE
+ *  images or that don't have an RSDS record are skipped
+ *  @param threads Number of threads, 0 uses one per hardware thread
+ *  @return Signatures in the order of `files`
+ * */
+[[nodiscard]] inline auto readPdbSignatures(
+  std::span<const std::filesystem::path> files,
+  unsigned threads = 0) -> std::vector<PdbSignature>;
+
+/** @brief Reads the PDB signatures of the regular files under `directory`,
+ * recursively
+ *
+ *  @return Signatures sorted by file path
+ * */
+[[nodiscard]] inline auto readPdbSignatures(
+  const std::filesystem::path& directory,
+  unsigned threads = 0) -> std::vector<PdbSignature>;
+
+/** @brief Writes one line per signature: the GUID, the age in decimal, the
+ * path of the PDB and the path of the image, separated by tabs */
+inline auto writePdbSignatures(std::ostream& out,
+  std::span<const PdbSignature> signatures) -> void;
+
+
+namespace detail {
+
+  inline auto readPdbSignature(const std::filesystem::path& path)
+    -> std::optional<PdbSignature>
+  {
+    try {
+      const MappedFile file{ path };
+      const auto bytes = file.bytes();
+
+      if (detectFormat(bytes) != FileFormat::Pe) { return std::nullopt; }
+
+      std::optional<PdbSignature> signature;
+      std::visit(
+        [&](const auto& parsed) {
+          if constexpr (requires { parsed.codeView(); }) {
+            const auto info = parsed.codeView();
+            if (!info) { return; }
+            signature = PdbSignature{
+              path, info->guid, info->age, std::string{ info->path }
+            };
+          }
+        },
+        open(bytes));
+
+      return signature;
+    } catch (const std::exception&) {
+      /* Unreadable or malformed files don't have a signature, whether the
+       * parser or the standard library (e.g. std::bad_alloc) rejects them */
+      return std::nullopt;
+    }
+  }
+
+}// namespace detail
+
+
+inline auto readPdbSignatures(std::span<const std::filesystem::path> files,
+  unsigned threads) -> std::vector<PdbSignature>
+{
+  std::vector<std::optional<PdbSignature>> results(files.size());
+
+  /* The results keep the input order */
+  detail::parallelFor(files.size(), threads, [&](std::size_t i) {
+    results[i] = detail::readPdbSignature(files[i]);
+  });
+
+  std::vector<PdbSignature> signatures;
+  for (auto& result : results) {
+    if (result) { signatures.push_back(std::move(*result)); }
+  }
+
+  return signatures;
+}
+
+inline auto readPdbSignatures(const std::filesystem::path& directory,
+  unsigned threads) -> std::vector<PdbSignature>
+{
+  std::vector<std::filesystem::path> files;
+
+  std::error_code error;
+  const auto options =
+    std::filesystem::directory_options::skip_permission_denied;
+  for (auto it =
+         std::filesystem::recursive_directory_iterator(directory, options);
+       !error && it != std::filesystem::recursive_directory_iterator();
+       it.increment(error)) {
+    if (it->is_regular_file(error)) {
+      files.push_back(it->path());
+    } else if (it->is_directory(error) && !it->is_symlink(error)) {
+      /* The iterator ends when it can't open the directory it enters, so a
+       * directory that can't be opened is skipped instead */
+      const std::filesystem::directory_iterator probe(
+        it->path(), options, error);
+      if (error) { it.disable_recursion_pending(); }
+    }
+  }
+
+  std::sort(files.begin(), files.end());
+
+  return readPdbSignatures(files, threads);
+}
+
+inline auto writePdbSignatures(std::ostream& out,
+  std::span<const PdbSignature> signatures) -> void
+{
+  for (const auto& signature : signatures) {
+    out << signature.info().guidString() << '\t' << signature.age << '\t'
+        << signature.pdbPath << '\t' << signature.file.string() << '\n';
+  }
+}
+
+
+}// namespace pelf
+
+#endif
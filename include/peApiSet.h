@@ -0,0 +1,338 @@
+/** @file peApiSet.h
+ *  @brief API set schema declarations
+ *
+ *  This file contains a reader of the API set schema of Windows 10 and later
+ *  (version 6), the `.apiset` section of apisetschema.dll that the loader
+ *  maps in every process. It redirects the virtual DLLs that images import,
+ *  e.g. api-ms-win-core-heap-l1-1-0.dll, to the DLLs that implement them
+ *  (their hosts), optionally depending on the DLL that imports them
+ *
+ *  The schema is a namespace header followed by sorted entries, a table of
+ *  the hashes of their names and the host values, all the names are UTF-16
+ *  strings at offsets from the beginning of the schema
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PEAPISET_H_
+#define PEAPISET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "Pelf.h"
+#include "peImports.h"
+#include "peStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief API set schema, the hosts are resolved from the bytes of the
+ * schema when they're requested */
+class ApiSetSchema
+{
+public:
+  static constexpr DWORD supportedVersion{ 6 }; /**< Windows 10 and later */
+
+  /** @brief ApiSetSchema constructor
+   *
+   *  @param data Bytes of the schema, it throws `PelfException` if it isn't
+   *  a version 6 schema or its tables, names or host values aren't in `data`
+   * */
+  explicit ApiSetSchema(std::span<const unsigned char> data);
+
+  /** @brief Finds the schema of apisetschema.dll, its `.apiset` section
+   *
+   *  @return Schema, `std::nullopt` if the image doesn't have the section
+   * */
+  template<class PeType>
+  [[nodiscard]] static auto find(const PeType& pe)
+    -> std::optional<ApiSetSchema>;
+
+  /** @brief Returns `true` if `name` is the name of an API set, the loader
+   * only looks up names that begin with "api-" or "ext-" */
+  [[nodiscard]] static constexpr auto isApiSetName(
+    std::string_view name) noexcept -> bool;
+
+  /** @brief Returns the version of the schema */
+  [[nodiscard]] auto version() const noexcept -> DWORD;
+
+  /** @brief Returns the number of API sets */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  /** @brief Returns the name of the API set `index`, without the extension,
+   * e.g. "api-ms-win-core-heap-l1-1-0". It throws `PelfException` if it's out
+   * of range */
+  [[nodiscard]] auto name(std::size_t index) const -> std::string;
+
+  /** @brief Resolves an API set to its host, like the loader does
+   *
+   *  The last component of the version is ignored, so
+   *  api-ms-win-core-heap-l1-1-1.dll resolves like
+   *  api-ms-win-core-heap-l1-1-0.dll. The comparison ignores the case
+   *
+   *  @param name Name of the API set, with or without the .dll extension
+   *  @param importer Name of the DLL that imports it, some API sets have a
+   *  different host for some importers (e.g. kernel32.dll itself)
+   *  @return Name of the host, `std::nullopt` if the API set isn't in the
+   *  schema or it doesn't have a host
+   * */
+  [[nodiscard]] auto resolve(std::string_view name,
+    std::string_view importer = {}) const -> std::optional<std::string>;
+
+private:
+  static constexpr std::size_t entrySize{ 24 }; /**< Size of an entry */
+  static constexpr std::size_t hashEntrySize{ 8 }; /**< Size of a hash */
+  static constexpr std::size_t valueSize{ 20 }; /**< Size of a host value */
+
+  std::span<const unsigned char> mData; /**< Bytes of the schema */
+  std::size_t mCount{}; /**< Number of entries */
+  DWORD mEntryOffset{}; /**< Offset of the entries */
+  DWORD mHashOffset{}; /**< Offset of the hash table */
+  DWORD mHashFactor{}; /**< Multiplier of the hash of the names */
+
+  /** @brief Returns the UTF-16 string of `length` bytes at `offset`, the
+   * names are ASCII so every code unit is narrowed to a char */
+  [[nodiscard]] auto string(DWORD offset, DWORD length) const -> std::string;
+
+  /** @brief Compares the UTF-16 string at `offset` to `text`, ignoring the
+   * case */
+  [[nodiscard]] auto equals(DWORD offset,
+    DWORD length,
+    std::string_view text) const -> bool;
+
+  /** @brief Returns the index of the entry whose hashed name is `hashed`,
+   * a binary search over the hash table */
+  [[nodiscard]] auto findEntry(std::string_view hashed) const
+    -> std::optional<std::size_t>;
+};
+
+
+inline ApiSetSchema::ApiSetSchema(std::span<const unsigned char> data)
+  : mData(data)
+{
+  /* Version, Size, Flags, Count, EntryOffset, HashOffset, HashFactor */
+  if (readInteger<DWORD>(data, 0) != supportedVersion) {
+    throw PelfException{ "Invalid API set schema, unsupported version" };
+  }
+
+  mCount = readInteger<DWORD>(data, 12);
+  mEntryOffset = readInteger<DWORD>(data, 16);
+  mHashOffset = readInteger<DWORD>(data, 20);
+  mHashFactor = readInteger<DWORD>(data, 24);
+
+  const auto inside = [&data](std::uint64_t offset, std::uint64_t length) {
+    return offset + length <= data.size();
+  };
+
+  if (!inside(mEntryOffset, mCount * entrySize)
+      || !inside(mHashOffset, mCount * hashEntrySize)) {
+    throw PelfException{ "Invalid API set schema, it isn't in the file" };
+  }
+
+  /* The names and the values are checked once here, so resolving an API set
+   * can't fail (the graph resolves them from many threads) */
+  for (std::size_t i{}; i < mCount; ++i) {
+    /* Flags, NameOffset, NameLength, HashedLength, ValueOffset, ValueCount */
+    const std::size_t entry = mEntryOffset + i * entrySize;
+    const DWORD name_length = readInteger<DWORD>(data, entry + 8);
+    const DWORD values = readInteger<DWORD>(data, entry + 16);
+    const DWORD count = readInteger<DWORD>(data, entry + 20);
+    if (!inside(readInteger<DWORD>(data, entry + 4), name_length)
+        || readInteger<DWORD>(data, entry + 12) > name_length
+        || !inside(values, std::uint64_t{ count } * valueSize)) {
+      throw PelfException{ "Invalid API set entry, it isn't in the file" };
+    }
+
+    /* Flags, NameOffset, NameLength, ValueOffset, ValueLength */
+    for (std::size_t j{}; j < count; ++j) {
+      const std::size_t value = values + j * valueSize;
+      if (!inside(readInteger<DWORD>(data, value + 4),
+            readInteger<DWORD>(data, value + 8))
+          || !inside(readInteger<DWORD>(data, value + 12),
+            readInteger<DWORD>(data, value + 16))) {
+        throw PelfException{ "Invalid API set value, it isn't in the file" };
+      }
+    }
+  }
+}
+
+template<class PeType>
+auto ApiSetSchema::find(const PeType& pe) -> std::optional<ApiSetSchema>
+{
+  /* The name of a section is 8 bytes padded with NULs, little endian here */
+  constexpr std::string_view apiset{ ".apiset" };
+  ULONGLONG name{};
+  for (std::size_t i{}; i < apiset.size(); ++i) {
+    name |= ULONGLONG{ static_cast<unsigned char>(apiset[i]) } << (i * 8);
+  }
+
+  for (const auto& section : pe.getSections()) {
+    if (section.Name == name) {
+      return ApiSetSchema{ pe.getDataAtRva(section.VirtualAddress) };
+    }
+  }
+
+  return std::nullopt;
+}
+
+constexpr auto ApiSetSchema::isApiSetName(std::string_view name) noexcept
+  -> bool
+{
+  if (name.size() < 4) { return false; }
+
+  const auto prefix = name.substr(0, 4);
+  return detail::equalsIgnoreCase(prefix, "api-")
+         || detail::equalsIgnoreCase(prefix, "ext-");
+}
+
+inline auto ApiSetSchema::version() const noexcept -> DWORD
+{
+  return supportedVersion;
+}
+
+inline auto ApiSetSchema::size() const noexcept -> std::size_t
+{
+  return mCount;
+}
+
+inline auto ApiSetSchema::name(std::size_t index) const -> std::string
+{
+  if (index >= mCount) {
+    throw PelfException{ "Invalid index, out of the API set schema" };
+  }
+
+  /* Flags, NameOffset, NameLength, HashedLength, ValueOffset, ValueCount */
+  const std::size_t entry = mEntryOffset + index * entrySize;
+  return string(readInteger<DWORD>(mData, entry + 4),
+    readInteger<DWORD>(mData, entry + 8));
+}
+
+inline auto ApiSetSchema::resolve(std::string_view name,
+  std::string_view importer) const -> std::optional<std::string>
+{
+  if (name.size() > 4
+      && detail::equalsIgnoreCase(name.substr(name.size() - 4), ".dll")) {
+    name.remove_suffix(4);
+  }
+
+  /* The hash covers the name without the last component of the version */
+  const auto hyphen = name.rfind('-');
+  if (hyphen == std::string_view::npos) { return std::nullopt; }
+
+  const auto index = findEntry(name.substr(0, hyphen));
+  if (!index) { return std::nullopt; }
+
+  const std::size_t entry = mEntryOffset + *index * entrySize;
+  const DWORD values = readInteger<DWORD>(mData, entry + 16);
+  const DWORD count = readInteger<DWORD>(mData, entry + 20);
+  if (count == 0) { return std::nullopt; }
+
+  /* Flags, NameOffset, NameLength, ValueOffset, ValueLength. The first value
+   * is the default host, the others are the hosts of specific importers */
+  std::size_t value = values;
+  for (std::size_t i{ 1 }; i < count && !importer.empty(); ++i) {
+    const std::size_t exception = values + i * valueSize;
+    if (equals(readInteger<DWORD>(mData, exception + 4),
+          readInteger<DWORD>(mData, exception + 8),
+          importer)) {
+      value = exception;
+      break;
+    }
+  }
+
+  const DWORD host_length = readInteger<DWORD>(mData, value + 16);
+  if (host_length == 0) { return std::nullopt; }
+
+  return string(readInteger<DWORD>(mData, value + 12), host_length);
+}
+
+inline auto ApiSetSchema::string(DWORD offset, DWORD length) const
+  -> std::string
+{
+  if (std::uint64_t{ offset } + length > mData.size()) {
+    throw PelfException{ "Invalid API set name, it isn't in the file" };
+  }
+
+  std::string text;
+  text.reserve(length / 2);
+  for (std::size_t i{}; i + 1 < length; i += 2) {
+    text += static_cast<char>(readInteger<WORD>(mData, offset + i));
+  }
+
+  return text;
+}
+
+inline auto ApiSetSchema::equals(DWORD offset,
+  DWORD length,
+  std::string_view text) const -> bool
+{
+  if (length != text.size() * 2
+      || std::uint64_t{ offset } + length > mData.size()) {
+    return false;
+  }
+
+  for (std::size_t i{}; i < text.size(); ++i) {
+    const WORD unit = readInteger<WORD>(mData, offset + i * 2);
+    if (unit > 0x7f
+        || detail::asciiLower(static_cast<char>(unit))
+             != detail::asciiLower(text[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+inline auto ApiSetSchema::findEntry(std::string_view hashed) const
+  -> std::optional<std::size_t>
+{
+  DWORD hash{};
+  for (const char c : hashed) {
+    hash = hash * mHashFactor
+           + static_cast<unsigned char>(detail::asciiLower(c));
+  }
+
+  /* Hash, Index, sorted by hash */
+  std::size_t first{};
+  std::size_t last{ mCount };
+  while (first < last) {
+    const std::size_t middle = first + (last - first) / 2;
+    if (readInteger<DWORD>(mData, mHashOffset + middle * hashEntrySize)
+        < hash) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+
+  /* Different names can have the same hash */
+  for (; first < mCount; ++first) {
+    const std::size_t slot = mHashOffset + first * hashEntrySize;
+    if (readInteger<DWORD>(mData, slot) != hash) { break; }
+
+    const DWORD index = readInteger<DWORD>(mData, slot + 4);
+    if (index >= mCount) { continue; }
+
+    const std::size_t entry = mEntryOffset + index * entrySize;
+    if (equals(readInteger<DWORD>(mData, entry + 4),
+          readInteger<DWORD>(mData, entry + 12),
+          hashed)) {
+      return index;
+    }
+  }
+
+  return std::nullopt;
+}
+
+
+}// namespace pelf
+
+#endif
@@ -0,0 +1,1353 @@
+/** @file peClr.h
+ *  @brief .NET metadata declarations
+ *
+ *  This file contains a parser of the metadata of .NET assemblies (ECMA-335
+ *  partition II), referenced by the CLI header of data directory 14: the
+ *  metadata root and its streams, the #Strings, #US, #GUID and #Blob heaps
+ *  and the tables of the #~ stream
+ *
+ *  The tables are stored one after another and the size of their rows
+ *  depends on the number of rows of the other tables (indexes and coded
+ *  indexes are 2 bytes for small tables and 4 bytes otherwise), so the
+ *  layout of every table is computed once by `MetadataTables`. A cell is then
+ *  read at `table offset + row * row size + column offset`, the tables and
+ *  the columns are views of the file
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PECLR_H_
+#define PECLR_H_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "Pelf.h"
+#include "peResources.h"
+#include "peStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief Metadata tables, the value is the number of the table */
+enum class MetadataTableId : std::uint8_t {
+  Module = 0x00,
+  TypeRef = 0x01,
+  TypeDef = 0x02,
+  FieldPtr = 0x03,
+  Field = 0x04,
+  MethodPtr = 0x05,
+  MethodDef = 0x06,
+  ParamPtr = 0x07,
+  Param = 0x08,
+  InterfaceImpl = 0x09,
+  MemberRef = 0x0a,
+  Constant = 0x0b,
+  CustomAttribute = 0x0c,
+  FieldMarshal = 0x0d,
+  DeclSecurity = 0x0e,
+  ClassLayout = 0x0f,
+  FieldLayout = 0x10,
+  StandAloneSig = 0x11,
+  EventMap = 0x12,
+  EventPtr = 0x13,
+  Event = 0x14,
+  PropertyMap = 0x15,
+  PropertyPtr = 0x16,
+  Property = 0x17,
+  MethodSemantics = 0x18,
+  MethodImpl = 0x19,
+  ModuleRef = 0x1a,
+  TypeSpec = 0x1b,
+  ImplMap = 0x1c,
+  FieldRva = 0x1d,
+  EncLog = 0x1e,
+  EncMap = 0x1f,
+  Assembly = 0x20,
+  AssemblyProcessor = 0x21,
+  AssemblyOs = 0x22,
+  AssemblyRef = 0x23,
+  AssemblyRefProcessor = 0x24,
+  AssemblyRefOs = 0x25,
+  File = 0x26,
+  ExportedType = 0x27,
+  ManifestResource = 0x28,
+  NestedClass = 0x29,
+  GenericParam = 0x2a,
+  MethodSpec = 0x2b,
+  GenericParamConstraint = 0x2c
+};
+
+inline constexpr std::size_t metadataTableCount{
+  0x2d
+}; /**< Number of tables defined by ECMA-335 */
+
+
+/** @brief Kinds of coded indexes, an index into one of several tables */
+enum class CodedIndexKind : std::uint8_t {
+  TypeDefOrRef,
+  HasConstant,
+  HasCustomAttribute,
+  HasFieldMarshal,
+  HasDeclSecurity,
+  MemberRefParent,
+  HasSemantics,
+  MethodDefOrRef,
+  MemberForwarded,
+  Implementation,
+  CustomAttributeType,
+  ResolutionScope,
+  TypeOrMethodDef
+};
+
+
+/** @brief A decoded coded index */
+struct CodedIndex
+{
+  MetadataTableId table{}; /**< Table */
+  DWORD row{}; /**< Row, starting at 1 like in tokens, 0 is a null index */
+
+  /** @brief Returns the metadata token of the row */
+  [[nodiscard]] constexpr auto token() const noexcept -> DWORD
+  {
+    return DWORD{ static_cast<std::uint8_t>(table) } << 24 | row;
+  }
+};
+
+
+namespace detail {
+
+  /* Types of the columns of the schema: constants, heap indexes, indexes
+   * into a table (0x40 | table) and coded indexes (0x80 | kind) */
+  inline constexpr BYTE columnU8{ 0x01 };
+  inline constexpr BYTE columnU16{ 0x02 };
+  inline constexpr BYTE columnU32{ 0x04 };
+  inline constexpr BYTE columnString{ 0x10 };
+  inline constexpr BYTE columnGuid{ 0x11 };
+  inline constexpr BYTE columnBlob{ 0x12 };
+
+  constexpr auto columnTable(MetadataTableId table) noexcept -> BYTE
+  {
+    return static_cast<BYTE>(0x40 | static_cast<BYTE>(table));
+  }
+
+  constexpr auto columnCoded(CodedIndexKind kind) noexcept -> BYTE
+  {
+    return static_cast<BYTE>(0x80 | static_cast<BYTE>(kind));
+  }
+
+  inline constexpr std::size_t maxMetadataColumns{ 9 };
+
+  /** @brief Tables a coded index refers to, by tag */
+  struct CodedIndexSchema
+  {
+    BYTE tagBits{}; /**< Number of low bits of the tag */
+    BYTE count{}; /**< Number of tags */
+    std::array<BYTE, 22> tables{}; /**< Table of every tag, 0xff if it
+                                      isn't used */
+  };
+
+  inline constexpr std::array<CodedIndexSchema, 13> codedIndexSchemas{ {
+    { 2, 3, { 0x02, 0x01, 0x1b } },
+    { 2, 3, { 0x04, 0x08, 0x17 } },
+    { 5,
+      22,
+      { 0x06, 0x04, 0x01, 0x02, 0x08, 0x09, 0x0a, 0x00, 0x0e, 0x17, 0x14,
+        0x11, 0x1a, 0x1b, 0x20, 0x23, 0x26, 0x27, 0x28, 0x2a, 0x2c, 0x2b } },
+    { 1, 2, { 0x04, 0x08 } },
+    { 2, 3, { 0x02, 0x06, 0x20 } },
+    { 3, 5, { 0x02, 0x01, 0x1a, 0x06, 0x1b } },
+    { 1, 2, { 0x14, 0x17 } },
+    { 1, 2, { 0x06, 0x0a } },
+    { 1, 2, { 0x04, 0x06 } },
+    { 2, 3, { 0x26, 0x23, 0x27 } },
+    { 3, 5, { 0xff, 0xff, 0x06, 0x0a, 0xff } },
+    { 2, 4, { 0x00, 0x1a, 0x23, 0x01 } },
+    { 1, 2, { 0x02, 0x06 } },
+  } };
+
+  using MetadataTableSchema = std::array<BYTE, maxMetadataColumns>;
+
+  /** @brief Columns of every table, 0 ends the columns of a table */
+  inline constexpr std::array<MetadataTableSchema, metadataTableCount>
+    metadataSchemas{ {
+      /* Module: Generation, Name, Mvid, EncId, EncBaseId */
+      { columnU16, columnString, columnGuid, columnGuid, columnGuid },
+      /* TypeRef: ResolutionScope, TypeName, TypeNamespace */
+      { columnCoded(CodedIndexKind::ResolutionScope),
+        columnString,
+        columnString },
+      /* TypeDef: Flags, TypeName, TypeNamespace, Extends, FieldList,
+       * MethodList */
+      { columnU32,
+        columnString,
+        columnString,
+        columnCoded(CodedIndexKind::TypeDefOrRef),
+        columnTable(MetadataTableId::Field),
+        columnTable(MetadataTableId::MethodDef) },
+      /* FieldPtr: Field */
+      { columnTable(MetadataTableId::Field) },
+      /* Field: Flags, Name, Signature */
+      { columnU16, columnString, columnBlob },
+      /* MethodPtr: Method */
+      { columnTable(MetadataTableId::MethodDef) },
+      /* MethodDef: RVA, ImplFlags, Flags, Name, Signature, ParamList */
+      { columnU32,
+        columnU16,
+        columnU16,
+        columnString,
+        columnBlob,
+        columnTable(MetadataTableId::Param) },
+      /* ParamPtr: Param */
+      { columnTable(MetadataTableId::Param) },
+      /* Param: Flags, Sequence, Name */
+      { columnU16, columnU16, columnString },
+      /* InterfaceImpl: Class, Interface */
+      { columnTable(MetadataTableId::TypeDef),
+        columnCoded(CodedIndexKind::TypeDefOrRef) },
+      /* MemberRef: Class, Name, Signature */
+      { columnCoded(CodedIndexKind::MemberRefParent),
+        columnString,
+        columnBlob },
+      /* Constant: Type, Padding, Parent, Value */
+      { columnU8,
+        columnU8,
+        columnCoded(CodedIndexKind::HasConstant),
+        columnBlob },
+      /* CustomAttribute: Parent, Type, Value */
+      { columnCoded(CodedIndexKind::HasCustomAttribute),
+        columnCoded(CodedIndexKind::CustomAttributeType),
+        columnBlob },
+      /* FieldMarshal: Parent, NativeType */
+      { columnCoded(CodedIndexKind::HasFieldMarshal), columnBlob },
+      /* DeclSecurity: Action, Parent, PermissionSet */
+      { columnU16, columnCoded(CodedIndexKind::HasDeclSecurity), columnBlob },
+      /* ClassLayout: PackingSize, ClassSize, Parent */
+      { columnU16, columnU32, columnTable(MetadataTableId::TypeDef) },
+      /* FieldLayout: Offset, Field */
+      { columnU32, columnTable(MetadataTableId::Field) },
+      /* StandAloneSig: Signature */
+      { columnBlob },
+      /* EventMap: Parent, EventList */
+      { columnTable(MetadataTableId::TypeDef),
+        columnTable(MetadataTableId::Event) },
+      /* EventPtr: Event */
+      { columnTable(MetadataTableId::Event) },
+      /* Event: EventFlags, Name, EventType */
+      { columnU16, columnString, columnCoded(CodedIndexKind::TypeDefOrRef) },
+      /* PropertyMap: Parent, PropertyList */
+      { columnTable(MetadataTableId::TypeDef),
+        columnTable(MetadataTableId::Property) },
+      /* PropertyPtr: Property */
+      { columnTable(MetadataTableId::Property) },
+      /* Property: Flags, Name, Type */
+      { columnU16, columnString, columnBlob },
+      /* MethodSemantics: Semantics, Method, Association */
+      { columnU16,
+        columnTable(MetadataTableId::MethodDef),
+        columnCoded(CodedIndexKind::HasSemantics) },
+      /* MethodImpl: Class, MethodBody, MethodDeclaration */
+      { columnTable(MetadataTableId::TypeDef),
+        columnCoded(CodedIndexKind::MethodDefOrRef),
+        columnCoded(CodedIndexKind::MethodDefOrRef) },
+      /* ModuleRef: Name */
+      { columnString },
+      /* TypeSpec: Signature */
+      { columnBlob },
+      /* ImplMap: MappingFlags, MemberForwarded, ImportName, ImportScope */
+      { columnU16,
+        columnCoded(CodedIndexKind::MemberForwarded),
+        columnString,
+        columnTable(MetadataTableId::ModuleRef) },
+      /* FieldRVA: RVA, Field */
+      { columnU32, columnTable(MetadataTableId::Field) },
+      /* EncLog: Token, FuncCode */
+      { columnU32, columnU32 },
+      /* EncMap: Token */
+      { columnU32 },
+      /* Assembly: HashAlgId, MajorVersion, MinorVersion, BuildNumber,
+       * RevisionNumber, Flags, PublicKey, Name, Culture */
+      { columnU32,
+        columnU16,
+        columnU16,
+        columnU16,
+        columnU16,
+        columnU32,
+        columnBlob,
+        columnString,
+        columnString },
+      /* AssemblyProcessor: Processor */
+      { columnU32 },
+      /* AssemblyOS: OSPlatformID, OSMajorVersion, OSMinorVersion */
+      { columnU32, columnU32, columnU32 },
+      /* AssemblyRef: MajorVersion, MinorVersion, BuildNumber,
+       * RevisionNumber, Flags, PublicKeyOrToken, Name, Culture, HashValue */
+      { columnU16,
+        columnU16,
+        columnU16,
+        columnU16,
+        columnU32,
+        columnBlob,
+        columnString,
+        columnString,
+        columnBlob },
+      /* AssemblyRefProcessor: Processor, AssemblyRef */
+      { columnU32, columnTable(MetadataTableId::AssemblyRef) },
+      /* AssemblyRefOS: OSPlatformId, OSMajorVersion, OSMinorVersion,
+       * AssemblyRef */
+      { columnU32,
+        columnU32,
+        columnU32,
+        columnTable(MetadataTableId::AssemblyRef) },
+      /* File: Flags, Name, HashValue */
+      { columnU32, columnString, columnBlob },
+      /* ExportedType: Flags, TypeDefId, TypeName, TypeNamespace,
+       * Implementation */
+      { columnU32,
+        columnU32,
+        columnString,
+        columnString,
+        columnCoded(CodedIndexKind::Implementation) },
+      /* ManifestResource: Offset, Flags, Name, Implementation */
+      { columnU32,
+        columnU32,
+        columnString,
+        columnCoded(CodedIndexKind::Implementation) },
+      /* NestedClass: NestedClass, EnclosingClass */
+      { columnTable(MetadataTableId::TypeDef),
+        columnTable(MetadataTableId::TypeDef) },
+      /* GenericParam: Number, Flags, Owner, Name */
+      { columnU16,
+        columnU16,
+        columnCoded(CodedIndexKind::TypeOrMethodDef),
+        columnString },
+      /* MethodSpec: Method, Instantiation */
+      { columnCoded(CodedIndexKind::MethodDefOrRef), columnBlob },
+      /* GenericParamConstraint: Owner, Constraint */
+      { columnTable(MetadataTableId::GenericParam),
+        columnCoded(CodedIndexKind::TypeDefOrRef) },
+    } };
+
+  /** @brief Reads a little endian integer of `width` bytes (1, 2 or 4) */
+  constexpr auto readCell(std::span<const unsigned char> data,
+    std::size_t offset,
+    std::size_t width) -> DWORD
+  {
+    switch (width) {
+    case 1:
+      return readInteger<BYTE>(data, offset);
+    case 2:
+      return readInteger<WORD>(data, offset);
+    default:
+      return readInteger<DWORD>(data, offset);
+    }
+  }
+
+}// namespace detail
+
+
+/** @brief Layout of the rows of a metadata table */
+struct MetadataTableLayout
+{
+  std::array<BYTE, detail::maxMetadataColumns> offsets{}; /**< Offset of
+                                                             every column */
+  std::array<BYTE, detail::maxMetadataColumns> widths{}; /**< Size of every
+                                                            column */
+  std::size_t columns{}; /**< Number of columns */
+  std::size_t rowSize{}; /**< Size of a row */
+};
+
+
+/** @brief Forward iterator over the values of a `MetadataColumn` */
+class MetadataColumnIterator;
+
+
+/** @brief A column of a metadata table, a view of the file
+ *
+ *  The values are read at `row * stride` from the first one
+ * */
+class MetadataColumn
+{
+public:
+  constexpr MetadataColumn() = default;
+
+  /** @brief MetadataColumn constructor
+   *
+   *  @param data Bytes of the table from the column of the first row
+   *  @param rows Number of rows
+   *  @param stride Size of a row
+   *  @param width Size of the column, 1, 2 or 4 bytes
+   * */
+  constexpr MetadataColumn(std::span<const unsigned char> data,
+    std::size_t rows,
+    std::size_t stride,
+    std::size_t width) noexcept;
+
+  /** @brief Returns the number of rows */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool;
+
+  /** @brief Returns the size of the values */
+  [[nodiscard]] constexpr auto width() const noexcept -> std::size_t;
+
+  /** @brief Returns the value of the row `index` (starting at 0), it throws
+   * `PelfException` if it's out of range */
+  [[nodiscard]] constexpr auto operator[](std::size_t index) const -> DWORD;
+
+  [[nodiscard]] constexpr auto begin() const noexcept
+    -> MetadataColumnIterator;
+
+  [[nodiscard]] constexpr auto end() const noexcept -> MetadataColumnIterator;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes from the first value */
+  std::size_t mRows{}; /**< Number of rows */
+  std::size_t mStride{}; /**< Size of a row */
+  std::size_t mWidth{}; /**< Size of a value */
+};
+
+
+class MetadataColumnIterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = DWORD;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const DWORD*;
+  using reference = DWORD;
+
+  constexpr MetadataColumnIterator() = default;
+
+  /** @brief MetadataColumnIterator constructor
+   *
+   *  @param column Column, it must outlive the iterator
+   *  @param index Index of the row
+   * */
+  constexpr MetadataColumnIterator(const MetadataColumn& column,
+    std::size_t index) noexcept;
+
+  [[nodiscard]] constexpr auto operator*() const -> reference;
+
+  constexpr auto operator++() noexcept -> MetadataColumnIterator&;
+
+  constexpr auto operator++(int) noexcept -> MetadataColumnIterator;
+
+  [[nodiscard]] constexpr auto operator==(
+    const MetadataColumnIterator& other) const noexcept -> bool;
+
+private:
+  const MetadataColumn* mColumn{}; /**< Column */
+  std::size_t mIndex{}; /**< Index of the current row */
+};
+
+
+/** @brief A metadata table, a view of the file */
+class MetadataTable
+{
+public:
+  constexpr MetadataTable() = default;
+
+  /** @brief MetadataTable constructor
+   *
+   *  @param data Bytes of the rows
+   *  @param rows Number of rows
+   *  @param layout Layout of the rows
+   * */
+  constexpr MetadataTable(std::span<const unsigned char> data,
+    std::size_t rows,
+    const MetadataTableLayout& layout) noexcept;
+
+  /** @brief Returns the number of rows */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool;
+
+  /** @brief Returns the layout of the rows */
+  [[nodiscard]] constexpr auto layout() const noexcept
+    -> const MetadataTableLayout&;
+
+  /** @brief Returns the column `index`, it throws `PelfException` if the
+   * table doesn't have it */
+  [[nodiscard]] constexpr auto column(std::size_t index) const
+    -> MetadataColumn;
+
+  /** @brief Returns the value of a cell
+   *
+   *  @param row Row, starting at 0
+   *  @param column Column
+   *  @return Value, heap and table indexes aren't resolved. It throws
+   *  `PelfException` if the cell is out of the table
+   * */
+  [[nodiscard]] constexpr auto value(std::size_t row,
+    std::size_t column) const -> DWORD;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the rows */
+  std::size_t mRows{}; /**< Number of rows */
+  MetadataTableLayout mLayout{}; /**< Layout of the rows */
+};
+
+
+/** @brief The #~ stream, the header of the tables and their layouts
+ *
+ *  The uncompressed #- stream of images edited by Edit and Continue has the
+ *  same header, its *Ptr tables are decoded like the other ones
+ * */
+class MetadataTables
+{
+public:
+  constexpr MetadataTables() = default;
+
+  /** @brief MetadataTables constructor, computes the layout of the tables
+   *
+   *  @param stream Bytes of the stream, it throws `PelfException` if the
+   *  header is truncated, if a table isn't in the stream or if the stream
+   *  has a table that isn't defined by ECMA-335
+   * */
+  constexpr explicit MetadataTables(std::span<const unsigned char> stream);
+
+  [[nodiscard]] constexpr auto majorVersion() const noexcept -> BYTE;
+
+  [[nodiscard]] constexpr auto minorVersion() const noexcept -> BYTE;
+
+  /** @brief Returns the size of the indexes into the #Strings heap */
+  [[nodiscard]] constexpr auto stringIndexSize() const noexcept
+    -> std::size_t;
+
+  /** @brief Returns the size of the indexes into the #GUID heap */
+  [[nodiscard]] constexpr auto guidIndexSize() const noexcept -> std::size_t;
+
+  /** @brief Returns the size of the indexes into the #Blob heap */
+  [[nodiscard]] constexpr auto blobIndexSize() const noexcept -> std::size_t;
+
+  /** @brief Returns the size of the coded indexes of kind `kind` */
+  [[nodiscard]] constexpr auto codedIndexSize(CodedIndexKind kind) const
+    noexcept -> std::size_t;
+
+  /** @brief Returns `true` if the table is sorted by its primary key */
+  [[nodiscard]] constexpr auto isSorted(MetadataTableId table) const noexcept
+    -> bool;
+
+  /** @brief Returns the number of rows of a table */
+  [[nodiscard]] constexpr auto rowCount(MetadataTableId table) const noexcept
+    -> std::size_t;
+
+  /** @brief Returns a table, empty if the stream doesn't have it */
+  [[nodiscard]] constexpr auto table(MetadataTableId table) const
+    -> MetadataTable;
+
+  /** @brief Decodes a coded index
+   *
+   *  @param kind Kind of the coded index
+   *  @param value Value of the column
+   *  @return CodedIndex, it throws `PelfException` if the tag isn't valid
+   * */
+  [[nodiscard]] static constexpr auto decode(CodedIndexKind kind,
+    DWORD value) -> CodedIndex;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the stream */
+  BYTE mMajorVersion{}; /**< Major version of the schema */
+  BYTE mMinorVersion{}; /**< Minor version of the schema */
+  BYTE mHeapSizes{}; /**< Sizes of the heap indexes, 0x01 #Strings, 0x02
+                        #GUID, 0x04 #Blob */
+  ULONGLONG mSorted{}; /**< Bit vector of the sorted tables */
+  std::array<DWORD, metadataTableCount> mRows{}; /**< Rows of every table */
+  std::array<std::size_t, metadataTableCount> mOffsets{}; /**< Offset of
+                                                             every table */
+  std::array<MetadataTableLayout, metadataTableCount>
+    mLayouts{}; /**< Layout of every table */
+
+  /** @brief Returns the size of an index into `table` */
+  [[nodiscard]] constexpr auto tableIndexSize(BYTE table) const noexcept
+    -> std::size_t;
+};
+
+
+/** @brief The #Strings heap, NUL terminated UTF-8 strings */
+class StringHeap
+{
+public:
+  constexpr StringHeap() = default;
+
+  constexpr explicit StringHeap(std::span<const unsigned char> data) noexcept;
+
+  /** @brief Returns the string at `index`, a view of the file. It throws
+   * `PelfException` if it's out of the heap */
+  [[nodiscard]] auto get(DWORD index) const -> std::string_view;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the heap */
+};
+
+
+/** @brief The #Blob heap, blobs prefixed by their compressed length */
+class BlobHeap
+{
+public:
+  constexpr BlobHeap() = default;
+
+  constexpr explicit BlobHeap(std::span<const unsigned char> data) noexcept;
+
+  /** @brief Returns the blob at `index`, a view of the file. It throws
+   * `PelfException` if it's out of the heap */
+  [[nodiscard]] constexpr auto get(DWORD index) const
+    -> std::span<const unsigned char>;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the heap */
+};
+
+
+/** @brief The #US heap, the string literals of the code (ldstr) as blobs of
+ * UTF-16 code units followed by a flag byte */
+class UserStringHeap
+{
+public:
+  constexpr UserStringHeap() = default;
+
+  constexpr explicit UserStringHeap(
+    std::span<const unsigned char> data) noexcept;
+
+  /** @brief Returns the string at `index`, the low 24 bits of the token of
+   * ldstr. It throws `PelfException` if it's out of the heap */
+  [[nodiscard]] constexpr auto get(DWORD index) const -> Utf16View;
+
+private:
+  BlobHeap mBlobs; /**< Bytes of the heap */
+};
+
+
+/** @brief The #GUID heap, an array of GUIDs */
+class GuidHeap
+{
+public:
+  constexpr GuidHeap() = default;
+
+  constexpr explicit GuidHeap(std::span<const unsigned char> data) noexcept;
+
+  /** @brief Returns the number of GUIDs */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t;
+
+  /** @brief Returns the GUID `index`, starting at 1, as stored in the file.
+   * 0 is a null GUID, it throws `PelfException` if it's out of the heap */
+  [[nodiscard]] constexpr auto get(DWORD index) const
+    -> std::array<unsigned char, 16>;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the heap */
+};
+
+
+/** @brief A stream of the metadata root */
+struct MetadataStream
+{
+  std::string_view name; /**< Name, e.g. "#~" */
+  std::span<const unsigned char> data; /**< Bytes of the stream */
+};
+
+
+/** @brief The metadata root, the version of the runtime and the streams */
+class MetadataRoot
+{
+public:
+  static constexpr DWORD signature{ 0x424a5342 }; /**< "BSJB" */
+
+  constexpr MetadataRoot() = default;
+
+  /** @brief MetadataRoot constructor
+   *
+   *  @param data Bytes of the metadata, it throws `PelfException` if the
+   *  signature isn't valid or the header is truncated
+   * */
+  explicit MetadataRoot(std::span<const unsigned char> data);
+
+  [[nodiscard]] constexpr auto majorVersion() const noexcept -> WORD;
+
+  [[nodiscard]] constexpr auto minorVersion() const noexcept -> WORD;
+
+  /** @brief Returns the version of the runtime, e.g. "v4.0.30319" */
+  [[nodiscard]] constexpr auto version() const noexcept -> std::string_view;
+
+  /** @brief Returns the number of streams */
+  [[nodiscard]] constexpr auto streamCount() const noexcept -> std::size_t;
+
+  /** @brief Returns the stream `index`, it throws `PelfException` if it's
+   * out of range or out of the metadata */
+  [[nodiscard]] auto stream(std::size_t index) const -> MetadataStream;
+
+  /** @brief Returns the first stream named `name`, `std::nullopt` if there
+   * isn't one */
+  [[nodiscard]] auto find(std::string_view name) const
+    -> std::optional<MetadataStream>;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the metadata */
+  WORD mMajorVersion{}; /**< Major version */
+  WORD mMinorVersion{}; /**< Minor version */
+  std::string_view mVersion; /**< Version of the runtime */
+  std::size_t mStreamsOffset{}; /**< Offset of the first stream header */
+  std::size_t mStreamCount{}; /**< Number of streams */
+};
+
+
+/** @brief A row of the TypeRef table */
+struct TypeRefRow
+{
+  CodedIndex resolutionScope; /**< Module, ModuleRef, AssemblyRef or TypeRef
+                                 of a nested type */
+  std::string_view name; /**< Name */
+  std::string_view typeNamespace; /**< Namespace */
+};
+
+/** @brief A row of the TypeDef table */
+struct TypeDefRow
+{
+  DWORD flags{}; /**< TypeAttributes */
+  std::string_view name; /**< Name */
+  std::string_view typeNamespace; /**< Namespace */
+  CodedIndex extends; /**< Base type, a null index for interfaces and
+                         System.Object */
+  DWORD fieldList{}; /**< First row of the fields of the type */
+  DWORD methodList{}; /**< First row of the methods of the type */
+};
+
+/** @brief A row of the MethodDef table */
+struct MethodDefRow
+{
+  DWORD rva{}; /**< RVA of the method body, 0 for abstract methods */
+  WORD implFlags{}; /**< MethodImplAttributes */
+  WORD flags{}; /**< MethodAttributes */
+  std::string_view name; /**< Name */
+  std::span<const unsigned char> signature; /**< Signature blob */
+  DWORD paramList{}; /**< First row of the parameters of the method */
+};
+
+/** @brief A row of the MemberRef table, a method or a field of another
+ * module */
+struct MemberRefRow
+{
+  CodedIndex parent; /**< TypeRef, TypeSpec, ModuleRef, MethodDef or
+                        TypeDef */
+  std::string_view name; /**< Name */
+  std::span<const unsigned char> signature; /**< Signature blob */
+};
+
+
+/** @brief Metadata of a .NET assembly
+ *
+ *  The streams are found once by the constructor, the rows are decoded when
+ *  they're accessed. The heaps of a stream that isn't present are empty
+ * */
+class ClrMetadata
+{
+public:
+  /** @brief ClrMetadata constructor
+   *
+   *  @param data Bytes of the metadata (the MetaData directory of the CLI
+   *  header), it throws `PelfException` if they aren't valid metadata
+   * */
+  explicit ClrMetadata(std::span<const unsigned char> data);
+
+  [[nodiscard]] constexpr auto root() const noexcept -> const MetadataRoot&;
+
+  [[nodiscard]] constexpr auto tables() const noexcept
+    -> const MetadataTables&;
+
+  [[nodiscard]] constexpr auto strings() const noexcept -> const StringHeap&;
+
+  [[nodiscard]] constexpr auto userStrings() const noexcept
+    -> const UserStringHeap&;
+
+  [[nodiscard]] constexpr auto guids() const noexcept -> const GuidHeap&;
+
+  [[nodiscard]] constexpr auto blobs() const noexcept -> const BlobHeap&;
+
+  /** @brief Returns the row `index` of the TypeRef table, starting at 0 */
+  [[nodiscard]] auto typeRef(std::size_t index) const -> TypeRefRow;
+
+  /** @brief Returns the row `index` of the TypeDef table, starting at 0 */
+  [[nodiscard]] auto typeDef(std::size_t index) const -> TypeDefRow;
+
+  /** @brief Returns the row `index` of the MethodDef table, starting at 0 */
+  [[nodiscard]] auto methodDef(std::size_t index) const -> MethodDefRow;
+
+  /** @brief Returns the row `index` of the MemberRef table, starting at 0 */
+  [[nodiscard]] auto memberRef(std::size_t index) const -> MemberRefRow;
+
+private:
+  MetadataRoot mRoot; /**< Metadata root */
+  MetadataTables mTables; /**< #~ stream */
+  StringHeap mStrings; /**< #Strings heap */
+  UserStringHeap mUserStrings; /**< #US heap */
+  GuidHeap mGuids; /**< #GUID heap */
+  BlobHeap mBlobs; /**< #Blob heap */
+};
+
+
+constexpr MetadataColumn::MetadataColumn(std::span<const unsigned char> data,
+  std::size_t rows,
+  std::size_t stride,
+  std::size_t width) noexcept
+  : mData(data), mRows(rows), mStride(stride), mWidth(width)
+{}
+
+constexpr auto MetadataColumn::size() const noexcept -> std::size_t
+{
+  return mRows;
+}
+
+constexpr auto MetadataColumn::empty() const noexcept -> bool
+{
+  return mRows == 0;
+}
+
+constexpr auto MetadataColumn::width() const noexcept -> std::size_t
+{
+  return mWidth;
+}
+
+constexpr auto MetadataColumn::operator[](std::size_t index) const -> DWORD
+{
+  if (index >= mRows) {
+    throw PelfException{ "Invalid index, out of the metadata table" };
+  }
+
+  return detail::readCell(mData, index * mStride, mWidth);
+}
+
+constexpr auto MetadataColumn::begin() const noexcept -> MetadataColumnIterator
+{
+  return { *this, 0 };
+}
+
+constexpr auto MetadataColumn::end() const noexcept -> MetadataColumnIterator
+{
+  return { *this, mRows };
+}
+
+
+constexpr MetadataColumnIterator::MetadataColumnIterator(
+  const MetadataColumn& column,
+  std::size_t index) noexcept
+  : mColumn(&column), mIndex(index)
+{}
+
+constexpr auto MetadataColumnIterator::operator*() const -> reference
+{
+  return (*mColumn)[mIndex];
+}
+
+constexpr auto MetadataColumnIterator::operator++() noexcept
+  -> MetadataColumnIterator&
+{
+  ++mIndex;
+  return *this;
+}
+
+constexpr auto MetadataColumnIterator::operator++(int) noexcept
+  -> MetadataColumnIterator
+{
+  auto previous = *this;
+  ++mIndex;
+  return previous;
+}
+
+constexpr auto MetadataColumnIterator::operator==(
+  const MetadataColumnIterator& other) const noexcept -> bool
+{
+  return mColumn == other.mColumn && mIndex == other.mIndex;
+}
+
+
+constexpr MetadataTable::MetadataTable(std::span<const unsigned char> data,
+  std::size_t rows,
+  const MetadataTableLayout& layout) noexcept
+  : mData(data), mRows(rows), mLayout(layout)
+{}
+
+constexpr auto MetadataTable::size() const noexcept -> std::size_t
+{
+  return mRows;
+}
+
+constexpr auto MetadataTable::empty() const noexcept -> bool
+{
+  return mRows == 0;
+}
+
+constexpr auto MetadataTable::layout() const noexcept
+  -> const MetadataTableLayout&
+{
+  return mLayout;
+}
+
+constexpr auto MetadataTable::column(std::size_t index) const
+  -> MetadataColumn
+{
+  if (index >= mLayout.columns) {
+    throw PelfException{ "Invalid column, out of the metadata table" };
+  }
+
+  /* An absent table has no bytes, but its columns still have offsets */
+  if (mRows == 0) { return { {}, 0, mLayout.rowSize, mLayout.widths[index] }; }
+
+  return { mData.subspan(mLayout.offsets[index]),
+    mRows,
+    mLayout.rowSize,
+    mLayout.widths[index] };
+}
+
+constexpr auto MetadataTable::value(std::size_t row, std::size_t column) const
+  -> DWORD
+{
+  if (row >= mRows || column >= mLayout.columns) {
+    throw PelfException{ "Invalid cell, out of the metadata table" };
+  }
+
+  return detail::readCell(mData,
+    row * mLayout.rowSize + mLayout.offsets[column],
+    mLayout.widths[column]);
+}
+
+
+constexpr MetadataTables::MetadataTables(std::span<const unsigned char> stream)
+  : mData(stream)
+{
+  /* Reserved, MajorVersion, MinorVersion, HeapSizes, Reserved, Valid, Sorted
+   * and the number of rows of every valid table */
+  mMajorVersion = readInteger<BYTE>(stream, 4);
+  mMinorVersion = readInteger<BYTE>(stream, 5);
+  mHeapSizes = readInteger<BYTE>(stream, 6);
+  const auto valid = readInteger<ULONGLONG>(stream, 8);
+  mSorted = readInteger<ULONGLONG>(stream, 16);
+
+  if ((valid >> metadataTableCount) != 0) {
+    throw PelfException{ "Invalid metadata tables, unknown table" };
+  }
+
+  std::size_t offset{ 24 };
+  for (std::size_t i{}; i < metadataTableCount; ++i) {
+    if ((valid >> i & 1) == 0) { continue; }
+    mRows[i] = readInteger<DWORD>(stream, offset);
+    offset += 4;
+  }
+
+  /* Extra data written by some obfuscators */
+  if ((mHeapSizes & 0x40) != 0) { offset += 4; }
+
+  /* The layouts depend on the number of rows of every table */
+  for (std::size_t i{}; i < metadataTableCount; ++i) {
+    auto& layout = mLayouts[i];
+    for (const BYTE type : detail::metadataSchemas[i]) {
+      if (type == 0) { break; }
+
+      std::size_t width{};
+      if (type == detail::columnString) {
+        width = stringIndexSize();
+      } else if (type == detail::columnGuid) {
+        width = guidIndexSize();
+      } else if (type == detail::columnBlob) {
+        width = blobIndexSize();
+      } else if ((type & 0x80) != 0) {
+        width = codedIndexSize(static_cast<CodedIndexKind>(type & 0x7f));
+      } else if ((type & 0x40) != 0) {
+        width = tableIndexSize(type & 0x3f);
+      } else {
+        width = type;
+      }
+
+      layout.offsets[layout.columns] = static_cast<BYTE>(layout.rowSize);
+      layout.widths[layout.columns] = static_cast<BYTE>(width);
+      ++layout.columns;
+      layout.rowSize += width;
+    }
+
+    mOffsets[i] = offset;
+    const std::size_t size = std::size_t{ mRows[i] } * layout.rowSize;
+    if (offset > stream.size() || size > stream.size() - offset) {
+      throw PelfException{ "Invalid metadata table, it isn't in the stream" };
+    }
+    offset += size;
+  }
+}
+
+constexpr auto MetadataTables::majorVersion() const noexcept -> BYTE
+{
+  return mMajorVersion;
+}
+
+constexpr auto MetadataTables::minorVersion() const noexcept -> BYTE
+{
+  return mMinorVersion;
+}
+
+constexpr auto MetadataTables::stringIndexSize() const noexcept
+  -> std::size_t
+{
+  return (mHeapSizes & 0x01) != 0 ? 4 : 2;
+}
+
+constexpr auto MetadataTables::guidIndexSize() const noexcept -> std::size_t
+{
+  return (mHeapSizes & 0x02) != 0 ? 4 : 2;
+}
+
+constexpr auto MetadataTables::blobIndexSize() const noexcept -> std::size_t
+{
+  return (mHeapSizes & 0x04) != 0 ? 4 : 2;
+}
+
+constexpr auto MetadataTables::codedIndexSize(CodedIndexKind kind) const
+  noexcept -> std::size_t
+{
+  /* 2 bytes if the largest table fits in the bits left by the tag */
+  const auto& schema = detail::codedIndexSchemas[static_cast<BYTE>(kind)];
+  DWORD rows{};
+  for (std::size_t i{}; i < schema.count; ++i) {
+    if (schema.tables[i] < metadataTableCount) {
+      rows = std::max(rows, mRows[schema.tables[i]]);
+    }
+  }
+
+  return rows < (DWORD{ 1 } << (16 - schema.tagBits)) ? 2 : 4;
+}
+
+constexpr auto MetadataTables::tableIndexSize(BYTE table) const noexcept
+  -> std::size_t
+{
+  return mRows[table] < 0x10000 ? 2 : 4;
+}
+
+constexpr auto MetadataTables::isSorted(MetadataTableId table) const noexcept
+  -> bool
+{
+  return (mSorted >> static_cast<BYTE>(table) & 1) != 0;
+}
+
+constexpr auto MetadataTables::rowCount(MetadataTableId table) const noexcept
+  -> std::size_t
+{
+  return mRows[static_cast<BYTE>(table)];
+}
+
+constexpr auto MetadataTables::table(MetadataTableId table) const
+  -> MetadataTable
+{
+  const auto index = static_cast<BYTE>(table);
+  if (index >= metadataTableCount) {
+    throw PelfException{ "Invalid metadata table" };
+  }
+
+  const auto& layout = mLayouts[index];
+  return { mData.subspan(mOffsets[index], mRows[index] * layout.rowSize),
+    mRows[index],
+    layout };
+}
+
+constexpr auto MetadataTables::decode(CodedIndexKind kind, DWORD value)
+  -> CodedIndex
+{
+  const auto& schema = detail::codedIndexSchemas[static_cast<BYTE>(kind)];
+  const DWORD tag = value & ((DWORD{ 1 } << schema.tagBits) - 1);
+  if (tag >= schema.count || schema.tables[tag] >= metadataTableCount) {
+    throw PelfException{ "Invalid coded index tag" };
+  }
+
+  return CodedIndex{ static_cast<MetadataTableId>(schema.tables[tag]),
+    value >> schema.tagBits };
+}
+
+
+constexpr StringHeap::StringHeap(std::span<const unsigned char> data) noexcept
+  : mData(data)
+{}
+
+inline auto StringHeap::get(DWORD index) const -> std::string_view
+{
+  if (index >= mData.size()) {
+    throw PelfException{ "Invalid index, out of the #Strings heap" };
+  }
+
+  const auto string = mData.subspan(index);
+  std::size_t size{};
+  while (size < string.size() && string[size] != 0) { ++size; }
+
+  /* A view of the file, like the names of the other headers */
+  return { reinterpret_cast<const char*>(string.data()), size };
+}
+
+
+constexpr BlobHeap::BlobHeap(std::span<const unsigned char> data) noexcept
+  : mData(data)
+{}
+
+constexpr auto BlobHeap::get(DWORD index) const
+  -> std::span<const unsigned char>
+{
+  /* The length is compressed in 1, 2 or 4 big endian bytes */
+  const BYTE first = readInteger<BYTE>(mData, index);
+  std::size_t length{};
+  std::size_t header{};
+  if ((first & 0x80) == 0) {
+    length = first;
+    header = 1;
+  } else if ((first & 0xc0) == 0x80) {
+    length = std::size_t{ first & 0x3fu } << 8 | readInteger<BYTE>(mData,
+                                                    index + 1);
+    header = 2;
+  } else if ((first & 0xe0) == 0xc0) {
+    length = readInteger<DWORD, std::endian::big>(mData, index) & 0x1fffffff;
+    header = 4;
+  } else {
+    throw PelfException{ "Invalid blob, its length isn't valid" };
+  }
+
+  if (index + header > mData.size()
+      || length > mData.size() - index - header) {
+    throw PelfException{ "Invalid blob, out of the #Blob heap" };
+  }
+
+  return mData.subspan(index + header, length);
+}
+
+
+constexpr UserStringHeap::UserStringHeap(
+  std::span<const unsigned char> data) noexcept
+  : mBlobs(data)
+{}
+
+constexpr auto UserStringHeap::get(DWORD index) const -> Utf16View
+{
+  /* The last byte of the blob isn't part of the string */
+  const auto blob = mBlobs.get(index);
+  return Utf16View{ blob.first(blob.size() - blob.size() % 2) };
+}
+
+
+constexpr GuidHeap::GuidHeap(std::span<const unsigned char> data) noexcept
+  : mData(data)
+{}
+
+constexpr auto GuidHeap::size() const noexcept -> std::size_t
+{
+  return mData.size() / 16;
+}
+
+constexpr auto GuidHeap::get(DWORD index) const
+  -> std::array<unsigned char, 16>
+{
+  std::array<unsigned char, 16> guid{};
+  if (index == 0) { return guid; }
+
+  if (index > size()) {
+    throw PelfException{ "Invalid index, out of the #GUID heap" };
+  }
+
+  for (std::size_t i{}; i < guid.size(); ++i) {
+    guid[i] = mData[(index - 1) * 16 + i];
+  }
+
+  return guid;
+}
+
+
+inline MetadataRoot::MetadataRoot(std::span<const unsigned char> data)
+  : mData(data)
+{
+  /* Signature, MajorVersion, MinorVersion, Reserved, Length, Version, Flags,
+   * Streams and the stream headers */
+  if (readInteger<DWORD>(data, 0) != signature) {
+    throw PelfException{ "Invalid metadata root signature" };
+  }
+
+  mMajorVersion = readInteger<WORD>(data, 4);
+  mMinorVersion = readInteger<WORD>(data, 6);
+  const DWORD length = readInteger<DWORD>(data, 12);
+  if (length > data.size() - 16) {
+    throw PelfException{ "Invalid metadata root, it's truncated" };
+  }
+
+  const auto version = data.subspan(16, length);
+  std::size_t size{};
+  while (size < version.size() && version[size] != 0) { ++size; }
+  mVersion = { reinterpret_cast<const char*>(version.data()), size };
+
+  mStreamCount = readInteger<WORD>(data, 16 + length + 2);
+  mStreamsOffset = 16 + length + 4;
+}
+
+constexpr auto MetadataRoot::majorVersion() const noexcept -> WORD
+{
+  return mMajorVersion;
+}
+
+constexpr auto MetadataRoot::minorVersion() const noexcept -> WORD
+{
+  return mMinorVersion;
+}
+
+constexpr auto MetadataRoot::version() const noexcept -> std::string_view
+{
+  return mVersion;
+}
+
+constexpr auto MetadataRoot::streamCount() const noexcept -> std::size_t
+{
+  return mStreamCount;
+}
+
+inline auto MetadataRoot::stream(std::size_t index) const -> MetadataStream
+{
+  if (index >= mStreamCount) {
+    throw PelfException{ "Invalid index, out of the metadata streams" };
+  }
+
+  /* Offset, Size and the NUL terminated name padded to 4 bytes */
+  std::size_t offset = mStreamsOffset;
+  for (std::size_t i{};; ++i) {
+    const DWORD stream_offset = readInteger<DWORD>(mData, offset);
+    const DWORD stream_size = readInteger<DWORD>(mData, offset + 4);
+
+    const auto name = mData.subspan(std::min(offset + 8, mData.size()));
+    std::size_t size{};
+    while (size < name.size() && name[size] != 0) { ++size; }
+    if (size == name.size()) {
+      throw PelfException{ "Invalid metadata stream header, it's truncated" };
+    }
+
+    if (i == index) {
+      if (stream_offset > mData.size()
+          || stream_size > mData.size() - stream_offset) {
+        throw PelfException{ "Invalid metadata stream, it isn't in the "
+                             "metadata" };
+      }
+
+      return MetadataStream{
+        { reinterpret_cast<const char*>(name.data()), size },
+        mData.subspan(stream_offset, stream_size)
+      };
+    }
+
+    offset += 8 + ((size + 4) & ~std::size_t{ 3 });
+  }
+}
+
+inline auto MetadataRoot::find(std::string_view name) const
+  -> std::optional<MetadataStream>
+{
+  for (std::size_t i{}; i < mStreamCount; ++i) {
+    const auto current = stream(i);
+    if (current.name == name) { return current; }
+  }
+
+  return std::nullopt;
+}
+
+
+inline ClrMetadata::ClrMetadata(std::span<const unsigned char> data)
+  : mRoot(data)
+{
+  for (std::size_t i{}; i < mRoot.streamCount(); ++i) {
+    const auto stream = mRoot.stream(i);
+    if (stream.name == "#~" || stream.name == "#-") {
+      mTables = MetadataTables{ stream.data };
+    } else if (stream.name == "#Strings") {
+      mStrings = StringHeap{ stream.data };
+    } else if (stream.name == "#US") {
+      mUserStrings = UserStringHeap{ stream.data };
+    } else if (stream.name == "#GUID") {
+      mGuids = GuidHeap{ stream.data };
+    } else if (stream.name == "#Blob") {
+      mBlobs = BlobHeap{ stream.data };
+    }
+  }
+}
+
+constexpr auto ClrMetadata::root() const noexcept -> const MetadataRoot&
+{
+  return mRoot;
+}
+
+constexpr auto ClrMetadata::tables() const noexcept -> const MetadataTables&
+{
+  return mTables;
+}
+
+constexpr auto ClrMetadata::strings() const noexcept -> const StringHeap&
+{
+  return mStrings;
+}
+
+constexpr auto ClrMetadata::userStrings() const noexcept
+  -> const UserStringHeap&
+{
+  return mUserStrings;
+}
+
+constexpr auto ClrMetadata::guids() const noexcept -> const GuidHeap&
+{
+  return mGuids;
+}
+
+constexpr auto ClrMetadata::blobs() const noexcept -> const BlobHeap&
+{
+  return mBlobs;
+}
+
+inline auto ClrMetadata::typeRef(std::size_t index) const -> TypeRefRow
+{
+  const auto table = mTables.table(MetadataTableId::TypeRef);
+  return TypeRefRow{ MetadataTables::decode(CodedIndexKind::ResolutionScope,
+                       table.value(index, 0)),
+    mStrings.get(table.value(index, 1)),
+    mStrings.get(table.value(index, 2)) };
+}
+
+inline auto ClrMetadata::typeDef(std::size_t index) const -> TypeDefRow
+{
+  const auto table = mTables.table(MetadataTableId::TypeDef);
+  return TypeDefRow{ table.value(index, 0),
+    mStrings.get(table.value(index, 1)),
+    mStrings.get(table.value(index, 2)),
+    MetadataTables::decode(CodedIndexKind::TypeDefOrRef,
+      table.value(index, 3)),
+    table.value(index, 4),
+    table.value(index, 5) };
+}
+
+inline auto ClrMetadata::methodDef(std::size_t index) const -> MethodDefRow
+{
+  const auto table = mTables.table(MetadataTableId::MethodDef);
+  return MethodDefRow{ table.value(index, 0),
+    static_cast<WORD>(table.value(index, 1)),
+    static_cast<WORD>(table.value(index, 2)),
+    mStrings.get(table.value(index, 3)),
+    mBlobs.get(table.value(index, 4)),
+    table.value(index, 5) };
+}
+
+inline auto ClrMetadata::memberRef(std::size_t index) const -> MemberRefRow
+{
+  const auto table = mTables.table(MetadataTableId::MemberRef);
+  return MemberRefRow{ MetadataTables::decode(CodedIndexKind::MemberRefParent,
+                         table.value(index, 0)),
+    mStrings.get(table.value(index, 1)),
+    mBlobs.get(table.value(index, 2)) };
+}
+
+
+}// namespace pelf
+
+#endif
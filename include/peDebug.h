@@ -0,0 +1,217 @@
+/** @file peDebug.h
+ *  @brief Debug directory and CodeView record declarations
+ *
+ *  This file contains an accessor to the debug directory of PE images (data
+ *  directory 6) and a decoder of the CodeView PDB 7.0 record (RSDS) its
+ *  CODEVIEW entry points to: the GUID, the age and the path of the PDB, the
+ *  key of the image on a symbol server
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PEDEBUG_H_
+#define PEDEBUG_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "Pelf.h"
+#include "peStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief Debug directory of an image, the entries are decoded from the bytes
+ * of the directory when they're accessed */
+class DebugDirectory
+{
+public:
+  static constexpr std::size_t entrySize{
+    28
+  }; /**< Size of an IMAGE_DEBUG_DIRECTORY */
+
+  constexpr DebugDirectory() = default;
+
+  /** @brief DebugDirectory constructor
+   *
+   *  @param data Bytes of the directory, a trailing partial entry is ignored
+   * */
+  constexpr explicit DebugDirectory(
+    std::span<const unsigned char> data) noexcept;
+
+  /** @brief Returns the number of entries */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool;
+
+  /** @brief Returns the entry `index`, it throws `PelfException` if it's out
+   * of range */
+  [[nodiscard]] constexpr auto entry(std::size_t index) const
+    -> IMAGE_DEBUG_DIRECTORY;
+
+  /** @brief Returns the first entry of type `type` (IMAGE_DEBUG_TYPE_*)
+   *
+   *  @return Entry, `std::nullopt` if the directory doesn't have one
+   * */
+  [[nodiscard]] constexpr auto find(DWORD type) const
+    -> std::optional<IMAGE_DEBUG_DIRECTORY>;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the directory */
+};
+
+
+/** @brief A CodeView PDB 7.0 record */
+struct PdbInfo
+{
+  static constexpr DWORD signature{ 0x53445352 }; /**< "RSDS" */
+
+  std::array<unsigned char, 16> guid{}; /**< GUID, as stored in the file
+                                           (the first three fields are little
+                                           endian) */
+  DWORD age{}; /**< Incremented every time the PDB is written */
+  std::string_view path; /**< Path of the PDB when the image was linked */
+
+  /** @brief Returns the GUID in registry format, e.g.
+   * "3844DBB9-2017-4967-BE7A-A4A2C20430FA" */
+  [[nodiscard]] auto guidString() const -> std::string;
+
+  /** @brief Returns the key of the PDB on a symbol server, the GUID without
+   * dashes followed by the age in hexadecimal, e.g.
+   * "3844DBB920174967BE7AA4A2C20430FA2" */
+  [[nodiscard]] auto symbolServerKey() const -> std::string;
+
+  /** @brief Returns the file name of `path`, the first and last components
+   * of the path of the PDB on a symbol server */
+  [[nodiscard]] auto fileName() const noexcept -> std::string_view;
+};
+
+
+/** @brief Decodes a CodeView record
+ *
+ *  @param data Data of a CODEVIEW entry of the debug directory
+ *  @return PdbInfo, `std::nullopt` if it isn't an RSDS record (e.g. the NB10
+ *  records of PDB 2.0). The path is a view of `data`
+ * */
+[[nodiscard]] inline auto decodeCodeView(std::span<const unsigned char> data)
+  -> std::optional<PdbInfo>;
+
+
+constexpr DebugDirectory::DebugDirectory(
+  std::span<const unsigned char> data) noexcept
+  : mData(data.first(data.size() - data.size() % entrySize))
+{}
+
+constexpr auto DebugDirectory::size() const noexcept -> std::size_t
+{
+  return mData.size() / entrySize;
+}
+
+constexpr auto DebugDirectory::empty() const noexcept -> bool
+{
+  return mData.empty();
+}
+
+constexpr auto DebugDirectory::entry(std::size_t index) const
+  -> IMAGE_DEBUG_DIRECTORY
+{
+  if (index >= size()) {
+    throw PelfException{ "Invalid index, out of the debug directory" };
+  }
+
+  return readStruct<IMAGE_DEBUG_DIRECTORY>(mData, index * entrySize);
+}
+
+constexpr auto DebugDirectory::find(DWORD type) const
+  -> std::optional<IMAGE_DEBUG_DIRECTORY>
+{
+  for (std::size_t i{}; i < size(); ++i) {
+    /* Type is at offset 12, only the matching entry is decoded */
+    if (readInteger<DWORD>(mData, i * entrySize + 12) == type) {
+      return entry(i);
+    }
+  }
+
+  return std::nullopt;
+}
+
+
+inline auto PdbInfo::guidString() const -> std::string
+{
+  constexpr std::string_view digits{ "0123456789ABCDEF" };
+
+  /* Data1, Data2 and Data3 are little endian, Data4 is a byte array */
+  constexpr std::array<std::size_t, 16> order{ 3, 2, 1, 0, 5, 4, 7, 6, 8, 9,
+    10, 11, 12, 13, 14, 15 };
+
+  std::string text;
+  text.reserve(36);
+  for (std::size_t i{}; i < order.size(); ++i) {
+    if (i == 4 || i == 6 || i == 8 || i == 10) { text += '-'; }
+    text += digits[guid[order[i]] >> 4];
+    text += digits[guid[order[i]] & 0xf];
+  }
+
+  return text;
+}
+
+inline auto PdbInfo::symbolServerKey() const -> std::string
+{
+  std::string key = guidString();
+  std::erase(key, '-');
+
+  constexpr std::string_view digits{ "0123456789ABCDEF" };
+  std::array<char, 8> age_digits{};
+  std::size_t count{};
+  DWORD value = age;
+  do {
+    age_digits[count++] = digits[value & 0xf];
+    value >>= 4;
+  } while (value != 0);
+  while (count != 0) { key += age_digits[--count]; }
+
+  return key;
+}
+
+inline auto PdbInfo::fileName() const noexcept -> std::string_view
+{
+  const auto separator = path.find_last_of("\\/");
+  return separator == std::string_view::npos ? path
+                                             : path.substr(separator + 1);
+}
+
+
+inline auto decodeCodeView(std::span<const unsigned char> data)
+  -> std::optional<PdbInfo>
+{
+  /* "RSDS", the GUID, the age and the NUL terminated path */
+  if (data.size() < 24 || readInteger<DWORD>(data, 0) != PdbInfo::signature) {
+    return std::nullopt;
+  }
+
+  PdbInfo info;
+  for (std::size_t i{}; i < info.guid.size(); ++i) {
+    info.guid[i] = data[4 + i];
+  }
+  info.age = readInteger<DWORD>(data, 20);
+
+  const auto path = data.subspan(24);
+  std::size_t size{};
+  while (size < path.size() && path[size] != 0) { ++size; }
+  info.path = { reinterpret_cast<const char*>(path.data()), size };
+
+  return info;
+}
+
+
+}// namespace pelf
+
+#endif
@@ -0,0 +1,592 @@
+/** @file peDependencyGraph.h
+ *  @brief PeDependencyGraph class declaration
+ *
+ *  This file contains the PeDependencyGraph class declaration, the graph of
+ *  the PE images of a directory (e.g. an extracted System32) in which every
+ *  import, regular or delay loaded, is resolved to the export that
+ *  implements it. API sets are redirected to their hosts through the schema
+ *  of apisetschema.dll and forwarders ("NTDLL.RtlAllocateHeap") are followed
+ *  to the DLL that has the code
+ *
+ *  The graph is built in three parallel passes over the modules, every pass
+ *  only reads what the previous one wrote:
+ *
+ *    parse      every file is mapped and parsed once, its imports and
+ *               exports are copied and the file is unmapped
+ *    forwarders the chain of every forwarder is followed once, the target is
+ *               shared by every import that reaches it
+ *    imports    the imports are resolved with the names of the modules and
+ *               the targets of the forwarders
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PEDEPENDENCYGRAPH_H_
+#define PEDEPENDENCYGRAPH_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "mappedFile.h"
+#include "parallelFor.h"
+#include "peApiSet.h"
+#include "pelfFormat.h"
+
+
+namespace pelf {
+
+
+/** @brief Result of the resolution of an import */
+enum class ImportStatus {
+  Resolved, /**< Resolved to an export that isn't a forwarder */
+  ModuleNotFound, /**< The DLL isn't in the directory */
+  ApiSetNotResolved, /**< The API set isn't in the schema or has no host */
+  ExportNotFound, /**< The DLL doesn't export the function */
+  ForwarderCycle /**< The forwarders don't end in an export */
+};
+
+
+/** @brief An entry of the export address table of a module */
+struct DependencyExport
+{
+  DWORD ordinal{}; /**< Ordinal */
+  std::string name; /**< First name of the export, empty if it doesn't have
+                       one */
+  DWORD rva{}; /**< RVA of the function, 0 for unused ordinals */
+  std::string forwarder; /**< "DLL.Function", empty if it isn't a forwarder */
+};
+
+
+/** @brief An import of a module and its resolution */
+struct DependencyImport
+{
+  std::string dll; /**< Name of the DLL in the import table */
+  std::string function; /**< Name, empty if it's imported by ordinal */
+  std::optional<WORD> ordinal; /**< Ordinal, if it's imported by ordinal */
+  bool delayLoaded{}; /**< From the delay import directory */
+  ImportStatus status{ ImportStatus::ModuleNotFound }; /**< Resolution */
+  std::size_t module{}; /**< Module that implements it, after the API sets
+                           and the forwarders, if it's resolved */
+  std::size_t exportIndex{}; /**< Index in the exports of `module` */
+};
+
+
+/** @brief A PE image of the directory */
+struct DependencyModule
+{
+  std::filesystem::path path; /**< Path of the file */
+  std::string name; /**< File name, the name the loader looks for */
+  std::vector<DependencyImport> imports; /**< Imports, then delay imports */
+  std::vector<DependencyExport> exports; /**< Export address table */
+  std::vector<std::size_t> dependencies; /**< Modules named by the import
+                                            tables (delay loaded included)
+                                            after the API sets, sorted */
+};
+
+
+/** @brief Graph of the imports and exports of the PE images of a directory
+ *
+ *  e.g.
+ *
+ *    const PeDependencyGraph graph{ "System32" };
+ *    const auto& notepad = graph.module(*graph.find("notepad.exe"));
+ *    for (const auto& imported : notepad.imports) {
+ *      if (imported.status == ImportStatus::Resolved) {
+ *        graph.module(imported.module).name;
+ *      }
+ *    }
+ * */
+class PeDependencyGraph
+{
+public:
+  /** @brief Maximum length of a chain of forwarders */
+  static constexpr std::size_t maxForwarderDepth{ 16 };
+
+  /** @brief PeDependencyGraph constructor
+   *
+   *  @param directory Directory of the images, the regular files that aren't
+   *  PE images or can't be parsed are skipped. Subdirectories aren't read,
+   *  the loader doesn't search them
+   *  @param apiSetSchema apisetschema.dll, by default the one in `directory`
+   *  if there is one. It throws `PelfException` if it can't be parsed
+   *  @param threads Number of threads, 0 uses one per hardware thread
+   * */
+  explicit PeDependencyGraph(const std::filesystem::path& directory,
+    const std::optional<std::filesystem::path>& apiSetSchema = std::nullopt,
+    unsigned threads = 0);
+
+  /** @brief Returns the modules, sorted by path */
+  [[nodiscard]] auto modules() const noexcept
+    -> std::span<const DependencyModule>;
+
+  /** @brief Returns the module `index`, it throws `PelfException` if it's
+   * out of range */
+  [[nodiscard]] auto module(std::size_t index) const
+    -> const DependencyModule&;
+
+  /** @brief Finds a module by file name, ignoring the case
+   *
+   *  @return Index, `std::nullopt` if it isn't in the directory
+   * */
+  [[nodiscard]] auto find(std::string_view name) const
+    -> std::optional<std::size_t>;
+
+  /** @brief Returns the API set schema, `std::nullopt` if there's none */
+  [[nodiscard]] auto apiSetSchema() const noexcept
+    -> const std::optional<ApiSetSchema>&;
+
+  /** @brief Resolves a DLL name like the loader, an API set is redirected to
+   * its host and a name without extension gets ".dll"
+   *
+   *  @param dll Name of the DLL
+   *  @param importer Name of the module that imports it
+   *  @return Index, `std::nullopt` if it isn't in the directory
+   * */
+  [[nodiscard]] auto resolveModule(std::string_view dll,
+    std::string_view importer = {}) const -> std::optional<std::size_t>;
+
+  /** @brief Resolves a function of a DLL like the imports of the modules
+   *
+   *  @param dll Name of the DLL
+   *  @param function Name of the function, or "#ordinal"
+   *  @param importer Name of the module that imports it
+   * */
+  [[nodiscard]] auto resolveImport(std::string_view dll,
+    std::string_view function,
+    std::string_view importer = {}) const -> DependencyImport;
+
+  /** @brief Returns the modules that `index` loads directly or indirectly,
+   * sorted and without `index` */
+  [[nodiscard]] auto transitiveDependencies(std::size_t index) const
+    -> std::vector<std::size_t>;
+
+private:
+  /** @brief Target of an export after its forwarders */
+  struct Target
+  {
+    ImportStatus status{}; /**< Resolution */
+    std::size_t module{}; /**< Module */
+    std::size_t index{}; /**< Index in the exports of `module` */
+  };
+
+  std::vector<DependencyModule> mModules; /**< Modules sorted by path */
+  std::vector<std::vector<std::pair<std::string, std::size_t>>>
+    mExportNames; /**< Names of the exports of every module and their index,
+                     sorted */
+  std::vector<std::vector<Target>> mForwarders; /**< Target of every export
+                                                   of every module */
+  std::unordered_map<std::string, std::size_t> mNames; /**< Lower case file
+                                                          names */
+  std::optional<MappedFile> mApiSetFile; /**< apisetschema.dll */
+  std::optional<ApiSetSchema> mApiSetSchema; /**< Schema of `mApiSetFile` */
+
+  /** @brief Resolves a DLL name, `resolveModule()` with the reason of the
+   * failure */
+  [[nodiscard]] auto locate(std::string_view dll,
+    std::string_view importer) const -> std::pair<ImportStatus, std::size_t>;
+
+  /** @brief Finds an export by name, or by ordinal if it's "#ordinal" */
+  [[nodiscard]] auto findExport(std::size_t module,
+    std::string_view function) const -> std::optional<std::size_t>;
+
+  /** @brief Finds an export by ordinal */
+  [[nodiscard]] auto findOrdinal(std::size_t module, DWORD ordinal) const
+    -> std::optional<std::size_t>;
+
+  /** @brief Follows the forwarders from an export */
+  [[nodiscard]] auto follow(std::size_t module, std::size_t index) const
+    -> Target;
+
+  /** @brief Resolves an import with the targets of the forwarders
+   *
+   *  @return Module named by the import, `std::nullopt` if it isn't found
+   * */
+  auto resolve(DependencyImport& imported, std::string_view importer) const
+    -> std::optional<std::size_t>;
+};
+
+
+namespace detail {
+
+  /** @brief Parses the ordinal of "#ordinal", 0 if it isn't a number */
+  inline auto parseOrdinal(std::string_view text) noexcept -> DWORD
+  {
+    DWORD ordinal{};
+    std::from_chars(text.data() + 1, text.data() + text.size(), ordinal);
+
+    return ordinal;
+  }
+
+  /** @brief Returns `name` in lower case */
+  inline auto lowerName(std::string_view name) -> std::string
+  {
+    std::string lower{ name };
+    for (auto& c : lower) { c = asciiLower(c); }
+
+    return lower;
+  }
+
+  /** @brief A module and the sorted names of its exports */
+  struct ParsedModule
+  {
+    DependencyModule module; /**< Module */
+    std::vector<std::pair<std::string, std::size_t>> names; /**< Names */
+  };
+
+  /** @brief Copies the imports and the exports of a PE image */
+  inline auto readDependencyModule(const std::filesystem::path& path)
+    -> std::optional<ParsedModule>
+  {
+    try {
+      const MappedFile file{ path };
+      const auto bytes = file.bytes();
+
+      if (detectFormat(bytes) != FileFormat::Pe) { return std::nullopt; }
+
+      std::optional<ParsedModule> parsed;
+      std::visit(
+        [&](const auto& pe) {
+          if constexpr (requires { pe.getExports(); }) {
+            ParsedModule result;
+            result.module.path = path;
+            result.module.name = path.filename().string();
+
+            const auto add_imports = [&](const auto& directory, bool delayed) {
+              for (const auto& imported : directory) {
+                for (const auto& function : imported.functions()) {
+                  result.module.imports.push_back(
+                    DependencyImport{ std::string{ imported.name() },
+                      std::string{ function.name },
+                      function.ordinal,
+                      delayed });
+                }
+              }
+            };
+            add_imports(pe.getImports(), false);
+            add_imports(pe.getDelayImports(), true);
+
+            const auto exports = pe.getExports();
+            result.module.exports.reserve(exports.size());
+            for (std::size_t i{}; i < exports.size(); ++i) {
+              const auto function = exports.function(i);
+              result.module.exports.push_back(DependencyExport{
+                function.ordinal,
+                {},
+                function.rva,
+                std::string{ function.forwarder } });
+            }
+
+            result.names.reserve(exports.nameCount());
+            for (std::size_t i{}; i < exports.nameCount(); ++i) {
+              const auto function = exports.namedFunction(i);
+              const std::size_t index =
+                function.ordinal - exports.ordinalBase();
+              auto& exported = result.module.exports[index];
+              if (exported.name.empty()) {
+                exported.name = std::string{ function.name };
+              }
+              result.names.emplace_back(std::string{ function.name }, index);
+            }
+            std::sort(result.names.begin(), result.names.end());
+
+            parsed = std::move(result);
+          }
+        },
+        open(bytes));
+
+      return parsed;
+    } catch (const std::exception&) {
+      /* Unreadable or malformed files aren't modules */
+      return std::nullopt;
+    }
+  }
+
+}// namespace detail
+
+
+inline PeDependencyGraph::PeDependencyGraph(
+  const std::filesystem::path& directory,
+  const std::optional<std::filesystem::path>& apiSetSchema,
+  unsigned threads)
+{
+  std::vector<std::filesystem::path> files;
+  std::error_code error;
+  for (auto it = std::filesystem::directory_iterator(directory, error);
+       !error && it != std::filesystem::directory_iterator();
+       it.increment(error)) {
+    if (it->is_regular_file(error)) { files.push_back(it->path()); }
+  }
+  std::sort(files.begin(), files.end());
+
+  /* Parse: every file once */
+  std::vector<std::optional<detail::ParsedModule>> parsed(files.size());
+  detail::parallelFor(files.size(), threads, [&](std::size_t i) {
+    parsed[i] = detail::readDependencyModule(files[i]);
+  });
+
+  for (auto& result : parsed) {
+    if (!result) { continue; }
+
+    /* Names are unique on Windows, the first path wins elsewhere */
+    const auto [it, inserted] = mNames.emplace(
+      detail::lowerName(result->module.name), mModules.size());
+    if (!inserted) { continue; }
+
+    mModules.push_back(std::move(result->module));
+    mExportNames.push_back(std::move(result->names));
+  }
+
+  std::optional<std::filesystem::path> schema = apiSetSchema;
+  if (!schema) {
+    if (const auto index = find("apisetschema.dll")) {
+      schema = mModules[*index].path;
+    }
+  }
+  if (schema) {
+    mApiSetFile.emplace(*schema);
+    const auto bytes = mApiSetFile->bytes();
+    std::visit(
+      [&](const auto& pe) {
+        if constexpr (requires { pe.getExports(); }) {
+          mApiSetSchema = ApiSetSchema::find(pe);
+        }
+      },
+      open(bytes));
+    if (!mApiSetSchema) {
+      throw PelfException{ "Invalid API set schema, no .apiset section" };
+    }
+  }
+
+  /* Forwarders: every chain once */
+  mForwarders.resize(mModules.size());
+  detail::parallelFor(mModules.size(), threads, [&](std::size_t i) {
+    const auto& exports = mModules[i].exports;
+    mForwarders[i].resize(exports.size());
+    for (std::size_t j{}; j < exports.size(); ++j) {
+      mForwarders[i][j] = exports[j].forwarder.empty()
+                            ? Target{ ImportStatus::Resolved, i, j }
+                            : follow(i, j);
+    }
+  });
+
+  /* Imports */
+  detail::parallelFor(mModules.size(), threads, [&](std::size_t i) {
+    auto& current = mModules[i];
+    for (auto& imported : current.imports) {
+      if (const auto module = resolve(imported, current.name)) {
+        current.dependencies.push_back(*module);
+      }
+    }
+
+    std::sort(current.dependencies.begin(), current.dependencies.end());
+    current.dependencies.erase(std::unique(current.dependencies.begin(),
+                                 current.dependencies.end()),
+      current.dependencies.end());
+  });
+}
+
+inline auto PeDependencyGraph::modules() const noexcept
+  -> std::span<const DependencyModule>
+{
+  return mModules;
+}
+
+inline auto PeDependencyGraph::module(std::size_t index) const
+  -> const DependencyModule&
+{
+  if (index >= mModules.size()) {
+    throw PelfException{ "Invalid index, out of the dependency graph" };
+  }
+
+  return mModules[index];
+}
+
+inline auto PeDependencyGraph::find(std::string_view name) const
+  -> std::optional<std::size_t>
+{
+  const auto it = mNames.find(detail::lowerName(name));
+  if (it == mNames.end()) { return std::nullopt; }
+
+  return it->second;
+}
+
+inline auto PeDependencyGraph::apiSetSchema() const noexcept
+  -> const std::optional<ApiSetSchema>&
+{
+  return mApiSetSchema;
+}
+
+inline auto PeDependencyGraph::resolveModule(std::string_view dll,
+  std::string_view importer) const -> std::optional<std::size_t>
+{
+  const auto [status, module] = locate(dll, importer);
+  if (status != ImportStatus::Resolved) { return std::nullopt; }
+
+  return module;
+}
+
+inline auto PeDependencyGraph::resolveImport(std::string_view dll,
+  std::string_view function,
+  std::string_view importer) const -> DependencyImport
+{
+  DependencyImport imported;
+  imported.dll = std::string{ dll };
+  if (function.starts_with('#')) {
+    imported.ordinal = static_cast<WORD>(detail::parseOrdinal(function));
+  } else {
+    imported.function = std::string{ function };
+  }
+
+  resolve(imported, importer);
+  return imported;
+}
+
+inline auto PeDependencyGraph::transitiveDependencies(std::size_t index) const
+  -> std::vector<std::size_t>
+{
+  std::vector<bool> visited(mModules.size());
+  std::vector<std::size_t> pending{ module(index).dependencies };
+  std::vector<std::size_t> result;
+  visited[index] = true;
+
+  while (!pending.empty()) {
+    const std::size_t current = pending.back();
+    pending.pop_back();
+    if (visited[current]) { continue; }
+
+    visited[current] = true;
+    result.push_back(current);
+    const auto& next = mModules[current].dependencies;
+    pending.insert(pending.end(), next.begin(), next.end());
+  }
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+inline auto PeDependencyGraph::locate(std::string_view dll,
+  std::string_view importer) const -> std::pair<ImportStatus, std::size_t>
+{
+  std::string name{ dll };
+  if (mApiSetSchema && ApiSetSchema::isApiSetName(name)) {
+    auto host = mApiSetSchema->resolve(name, importer);
+    if (!host) { return { ImportStatus::ApiSetNotResolved, 0 }; }
+    name = std::move(*host);
+  }
+
+  /* The loader appends .dll to names without extension */
+  if (name.find('.') == std::string::npos) { name += ".dll"; }
+
+  const auto index = find(name);
+  if (!index) { return { ImportStatus::ModuleNotFound, 0 }; }
+
+  return { ImportStatus::Resolved, *index };
+}
+
+inline auto PeDependencyGraph::findExport(std::size_t module,
+  std::string_view function) const -> std::optional<std::size_t>
+{
+  if (function.starts_with('#')) {
+    return findOrdinal(module, detail::parseOrdinal(function));
+  }
+
+  const auto& names = mExportNames[module];
+  const auto it = std::lower_bound(names.begin(),
+    names.end(),
+    function,
+    [](const auto& entry, std::string_view name) {
+      return std::string_view{ entry.first } < name;
+    });
+  if (it == names.end() || it->first != function) { return std::nullopt; }
+
+  return it->second;
+}
+
+inline auto PeDependencyGraph::findOrdinal(std::size_t module,
+  DWORD ordinal) const -> std::optional<std::size_t>
+{
+  /* The exports are the export address table, indexed by ordinal - base */
+  const auto& exports = mModules[module].exports;
+  if (exports.empty() || ordinal < exports.front().ordinal) {
+    return std::nullopt;
+  }
+
+  const std::size_t index = ordinal - exports.front().ordinal;
+  if (index >= exports.size() || exports[index].rva == 0) {
+    return std::nullopt;
+  }
+
+  return index;
+}
+
+inline auto PeDependencyGraph::follow(std::size_t module,
+  std::size_t index) const -> Target
+{
+  for (std::size_t depth{}; depth < maxForwarderDepth; ++depth) {
+    const auto& current = mModules[module];
+    const std::string_view forwarder = current.exports[index].forwarder;
+    if (forwarder.empty()) { return { ImportStatus::Resolved, module, index }; }
+
+    /* "DLL.Function" or "DLL.#ordinal", the DLL name can have dots */
+    const auto dot = forwarder.rfind('.');
+    if (dot == std::string_view::npos) {
+      return { ImportStatus::ExportNotFound, module, index };
+    }
+
+    const auto [status, target] =
+      locate(forwarder.substr(0, dot), current.name);
+    if (status != ImportStatus::Resolved) { return { status, module, index }; }
+
+    const auto found = findExport(target, forwarder.substr(dot + 1));
+    if (!found) { return { ImportStatus::ExportNotFound, target, 0 }; }
+
+    module = target;
+    index = *found;
+  }
+
+  return { ImportStatus::ForwarderCycle, module, index };
+}
+
+inline auto PeDependencyGraph::resolve(DependencyImport& imported,
+  std::string_view importer) const -> std::optional<std::size_t>
+{
+  const auto [status, module] = locate(imported.dll, importer);
+  imported.status = status;
+  if (status != ImportStatus::Resolved) { return std::nullopt; }
+
+  const auto index = imported.ordinal
+                       ? findOrdinal(module, *imported.ordinal)
+                       : findExport(module, imported.function);
+  if (!index) {
+    imported.status = ImportStatus::ExportNotFound;
+    imported.module = module;
+    return module;
+  }
+
+  /* The chains were followed once by the constructor */
+  const auto& target = mForwarders[module][*index];
+  imported.status = target.status;
+  imported.module = target.module;
+  imported.exportIndex = target.index;
+
+  return module;
+}
+
+
+}// namespace pelf
+
+#endif
@@ -0,0 +1,281 @@
+/** @file peExports.h
+ *  @brief Export directory declarations
+ *
+ *  This file contains a view of the export directory of PE images (data
+ *  directory 0): the export address table, indexed by ordinal, and the
+ *  sorted table of the names that maps them to ordinals. An export whose
+ *  address is inside the directory is a forwarder, a "DLL.Function" or
+ *  "DLL.#ordinal" string that the loader resolves in another DLL
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PEEXPORTS_H_
+#define PEEXPORTS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "Pelf.h"
+#include "peImports.h"
+#include "peStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief A function of the export directory */
+struct ExportedFunction
+{
+  DWORD ordinal{}; /**< Ordinal, the index in the export address table plus
+                      the ordinal base */
+  std::string_view name; /**< Name, empty if it's only exported by ordinal
+                            or it wasn't looked up */
+  DWORD rva{}; /**< RVA of the function, 0 for unused ordinals */
+  std::string_view forwarder; /**< "DLL.Function" or "DLL.#ordinal" if it's
+                                 a forwarder, empty otherwise */
+
+  /** @brief Returns `true` if the function is a forwarder */
+  [[nodiscard]] constexpr auto isForwarder() const noexcept -> bool
+  {
+    return !forwarder.empty();
+  }
+};
+
+
+/** @brief Export directory (data directory 0)
+ *
+ *  The tables are located by the constructor, the functions and the names
+ *  are decoded when they're accessed
+ *
+ *  @tparam PeType `Pe` of the image, it must outlive the directory
+ * */
+template<class PeType>
+class ExportDirectory
+{
+public:
+  static constexpr std::size_t headerSize{
+    40
+  }; /**< Size of an IMAGE_EXPORT_DIRECTORY */
+
+  /** @brief ExportDirectory constructor
+   *
+   *  @param pe Image
+   *  @param data Bytes of the directory, empty if the image doesn't export
+   *  anything. It throws `PelfException` if the tables aren't in the file
+   *  @param rva RVA of the directory, the forwarders are inside it
+   * */
+  ExportDirectory(const PeType& pe,
+    std::span<const unsigned char> data,
+    DWORD rva);
+
+  /** @brief Returns the header of the directory */
+  [[nodiscard]] auto header() const noexcept -> const IMAGE_EXPORT_DIRECTORY&;
+
+  /** @brief Returns the name of the DLL when it was linked */
+  [[nodiscard]] auto name() const -> std::string_view;
+
+  /** @brief Returns the ordinal of the first entry of the export address
+   * table */
+  [[nodiscard]] auto ordinalBase() const noexcept -> DWORD;
+
+  /** @brief Returns the number of entries of the export address table */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] auto empty() const noexcept -> bool;
+
+  /** @brief Returns the number of names */
+  [[nodiscard]] auto nameCount() const noexcept -> std::size_t;
+
+  /** @brief Returns the entry `index` of the export address table, without
+   * its name. It throws `PelfException` if it's out of range */
+  [[nodiscard]] auto function(std::size_t index) const -> ExportedFunction;
+
+  /** @brief Returns the function of the name `index`, names are sorted. It
+   * throws `PelfException` if it's out of range */
+  [[nodiscard]] auto namedFunction(std::size_t index) const
+    -> ExportedFunction;
+
+  /** @brief Finds a function by name, a binary search over the names
+   *
+   *  @return Function, `std::nullopt` if it isn't exported by that name
+   * */
+  [[nodiscard]] auto find(std::string_view name) const
+    -> std::optional<ExportedFunction>;
+
+  /** @brief Finds a function by ordinal, without its name
+   *
+   *  @return Function, `std::nullopt` if the ordinal is out of the table or
+   *  unused
+   * */
+  [[nodiscard]] auto findOrdinal(DWORD ordinal) const
+    -> std::optional<ExportedFunction>;
+
+private:
+  const PeType* mPe{}; /**< Image */
+  IMAGE_EXPORT_DIRECTORY mHeader{}; /**< Header */
+  DWORD mRva{}; /**< RVA of the directory */
+  DWORD mSize{}; /**< Size of the directory */
+  std::span<const unsigned char> mFunctions; /**< Export address table */
+  std::span<const unsigned char> mNames; /**< RVAs of the names */
+  std::span<const unsigned char> mOrdinals; /**< Indexes of the names */
+
+  /** @brief Returns the name `index` */
+  [[nodiscard]] auto nameAt(std::size_t index) const -> std::string_view;
+};
+
+
+template<class PeType>
+ExportDirectory<PeType>::ExportDirectory(const PeType& pe,
+  std::span<const unsigned char> data,
+  DWORD rva)
+  : mPe(&pe), mRva(rva), mSize(static_cast<DWORD>(data.size()))
+{
+  if (data.empty()) { return; }
+
+  mHeader = readStruct<IMAGE_EXPORT_DIRECTORY>(data, 0);
+
+  const auto table = [&pe](DWORD table_rva, std::uint64_t size) {
+    if (size == 0) { return std::span<const unsigned char>{}; }
+
+    const auto bytes = pe.getDataAtRva(table_rva);
+    if (bytes.size() < size) {
+      throw PelfException{ "Invalid export table, it isn't in the file" };
+    }
+
+    return bytes.first(size);
+  };
+
+  mFunctions = table(mHeader.AddressOfFunctions,
+    std::uint64_t{ mHeader.NumberOfFunctions } * 4);
+  mNames =
+    table(mHeader.AddressOfNames, std::uint64_t{ mHeader.NumberOfNames } * 4);
+  mOrdinals = table(mHeader.AddressOfNameOrdinals,
+    std::uint64_t{ mHeader.NumberOfNames } * 2);
+}
+
+template<class PeType>
+auto ExportDirectory<PeType>::header() const noexcept
+  -> const IMAGE_EXPORT_DIRECTORY&
+{
+  return mHeader;
+}
+
+template<class PeType>
+auto ExportDirectory<PeType>::name() const -> std::string_view
+{
+  if (mHeader.Name == 0) { return {}; }
+
+  return detail::peString(mPe->getDataAtRva(mHeader.Name));
+}
+
+template<class PeType>
+auto ExportDirectory<PeType>::ordinalBase() const noexcept -> DWORD
+{
+  return mHeader.Base;
+}
+
+template<class PeType>
+auto ExportDirectory<PeType>::size() const noexcept -> std::size_t
+{
+  return mFunctions.size() / 4;
+}
+
+template<class PeType>
+auto ExportDirectory<PeType>::empty() const noexcept -> bool
+{
+  return mFunctions.empty();
+}
+
+template<class PeType>
+auto ExportDirectory<PeType>::nameCount() const noexcept -> std::size_t
+{
+  return mNames.size() / 4;
+}
+
+template<class PeType>
+auto ExportDirectory<PeType>::function(std::size_t index) const
+  -> ExportedFunction
+{
+  if (index >= size()) {
+    throw PelfException{ "Invalid index, out of the export address table" };
+  }
+
+  ExportedFunction function;
+  function.ordinal = static_cast<DWORD>(mHeader.Base + index);
+  function.rva = readInteger<DWORD>(mFunctions, index * 4);
+
+  /* The address of a forwarder is its string, inside the directory */
+  if (function.rva >= mRva && function.rva - mRva < mSize) {
+    function.forwarder = detail::peString(mPe->getDataAtRva(function.rva));
+  }
+
+  return function;
+}
+
+template<class PeType>
+auto ExportDirectory<PeType>::namedFunction(std::size_t index) const
+  -> ExportedFunction
+{
+  if (index >= nameCount()) {
+    throw PelfException{ "Invalid index, out of the export name table" };
+  }
+
+  auto named = function(readInteger<WORD>(mOrdinals, index * 2));
+  named.name = nameAt(index);
+
+  return named;
+}
+
+template<class PeType>
+auto ExportDirectory<PeType>::find(std::string_view name) const
+  -> std::optional<ExportedFunction>
+{
+  /* The names are sorted by the linker like strcmp does */
+  std::size_t first{};
+  std::size_t last{ nameCount() };
+  while (first < last) {
+    const std::size_t middle = first + (last - first) / 2;
+    if (nameAt(middle) < name) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+
+  if (first == nameCount() || nameAt(first) != name) { return std::nullopt; }
+
+  return namedFunction(first);
+}
+
+template<class PeType>
+auto ExportDirectory<PeType>::findOrdinal(DWORD ordinal) const
+  -> std::optional<ExportedFunction>
+{
+  if (ordinal < mHeader.Base || ordinal - mHeader.Base >= size()) {
+    return std::nullopt;
+  }
+
+  const auto found = function(ordinal - mHeader.Base);
+  if (found.rva == 0) { return std::nullopt; }
+
+  return found;
+}
+
+template<class PeType>
+auto ExportDirectory<PeType>::nameAt(std::size_t index) const
+  -> std::string_view
+{
+  return detail::peString(
+    mPe->getDataAtRva(readInteger<DWORD>(mNames, index * 4)));
+}
+
+
+}// namespace pelf
+
+#endif
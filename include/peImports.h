@@ -0,0 +1,951 @@
+/** @file peImports.h
+ *  @brief Import directory declarations
+ *
+ *  This file contains views of the import directory of PE images (data
+ *  directory 1): the `IMAGE_IMPORT_DESCRIPTOR` of every DLL and the thunks of
+ *  its import lookup table. The delay import directory (data directory 13)
+ *  shares the same thunks, and the bound import directory (data directory 11)
+ *  lists the time stamps of the DLLs the image was bound against. The names
+ *  of the DLLs and of the functions are `std::string_view`s of the file, the
+ *  thunks are decoded while iterating
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PEIMPORTS_H_
+#define PEIMPORTS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "Pelf.h"
+#include "peStructs.h"
+
+
+namespace pelf {
+
+
+namespace detail {
+
+  /** @brief Returns the NUL terminated string at the beginning of `data`, or
+   * all of `data` if it isn't terminated */
+  inline auto peString(std::span<const unsigned char> data) -> std::string_view
+  {
+    std::size_t size{};
+    while (size < data.size() && data[size] != 0) { ++size; }
+
+    return { reinterpret_cast<const char*>(data.data()), size };
+  }
+
+  /** @brief Returns `c` in lower case, DLL names are ASCII */
+  constexpr auto asciiLower(char c) noexcept -> char
+  {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+  }
+
+  /** @brief Compares two ASCII strings ignoring the case, DLL names are case
+   * insensitive */
+  constexpr auto equalsIgnoreCase(std::string_view a, std::string_view b)
+    noexcept -> bool
+  {
+    if (a.size() != b.size()) { return false; }
+
+    for (std::size_t i{}; i < a.size(); ++i) {
+      if (asciiLower(a[i]) != asciiLower(b[i])) { return false; }
+    }
+
+    return true;
+  }
+
+  /** @brief Forward iterator over the entries of a directory whose entries
+   * have a fixed size, `Directory::module()` decodes them */
+  template<class Directory, class Module>
+  class DirectoryIterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Module;
+    using difference_type = std::ptrdiff_t;
+
+    DirectoryIterator() = default;
+
+    DirectoryIterator(const Directory* directory, std::size_t index)
+      : mDirectory(directory), mIndex(index)
+    {}
+
+    [[nodiscard]] auto operator*() const -> value_type
+    {
+      return mDirectory->module(mIndex);
+    }
+
+    auto operator++() -> DirectoryIterator&
+    {
+      ++mIndex;
+      return *this;
+    }
+
+    auto operator++(int) -> DirectoryIterator
+    {
+      auto copy = *this;
+      ++mIndex;
+      return copy;
+    }
+
+    [[nodiscard]] auto operator==(const DirectoryIterator& other) const
+      noexcept -> bool
+    {
+      return mIndex == other.mIndex;
+    }
+
+  private:
+    const Directory* mDirectory{}; /**< Directory */
+    std::size_t mIndex{}; /**< Index of the current entry */
+  };
+
+}// namespace detail
+
+
+/** @brief A function imported by name or by ordinal */
+struct ImportedFunction
+{
+  std::optional<WORD> ordinal; /**< Ordinal, if it's imported by ordinal */
+  WORD hint{}; /**< Index in the export name table of the DLL (a guess) */
+  std::string_view name; /**< Name, empty if it's imported by ordinal */
+  DWORD iatRva{}; /**< RVA of the slot of the import address table */
+};
+
+
+/** @brief Forward iterator over a table of thunks (an import lookup table)
+ *
+ *  @tparam PeType `Pe` of the image, the size of the thunks depends on its
+ *  class
+ * */
+template<class PeType>
+class ThunkIterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = ImportedFunction;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const ImportedFunction*;
+  using reference = const ImportedFunction&;
+
+  /** @brief Size of a thunk, 8 bytes in PE32+ and 4 bytes in PE32 */
+  static constexpr std::size_t thunkSize{
+    sizeof(typename PeType::FileClass::Address)
+  };
+
+  /** @brief Constructs the end iterator */
+  ThunkIterator() = default;
+
+  /** @brief ThunkIterator constructor
+   *
+   *  @param pe Image
+   *  @param thunks Bytes of the table from its beginning
+   *  @param iatRva RVA of the import address table of the same functions
+   *  @param nameBase Subtracted from the thunks of the functions imported by
+   *  name, the image base if they're virtual addresses
+   * */
+  ThunkIterator(const PeType& pe,
+    std::span<const unsigned char> thunks,
+    DWORD iatRva,
+    typename PeType::FileClass::Address nameBase = 0);
+
+  [[nodiscard]] auto operator*() const noexcept -> reference;
+
+  [[nodiscard]] auto operator->() const noexcept -> pointer;
+
+  auto operator++() -> ThunkIterator&;
+
+  auto operator++(int) -> ThunkIterator;
+
+  [[nodiscard]] auto operator==(const ThunkIterator& other) const noexcept
+    -> bool;
+
+private:
+  const PeType* mPe{}; /**< Image */
+  std::span<const unsigned char> mThunks; /**< Thunks from the current one */
+  DWORD mIatRva{}; /**< IAT slot of the current thunk */
+  typename PeType::FileClass::Address mNameBase{}; /**< Base of the names */
+  ImportedFunction mFunction{}; /**< Current function */
+
+  /** @brief Decodes the thunk at the beginning of `mThunks`, the iteration
+   * ends at a zero thunk or at the end of the section */
+  auto load() -> void;
+};
+
+
+/** @brief Range of the functions of a table of thunks */
+template<class PeType>
+class ThunkRange
+{
+public:
+  ThunkRange() = default;
+
+  /** @brief ThunkRange constructor
+   *
+   *  @param pe Image
+   *  @param lookupRva RVA of the table of thunks that has the names, the
+   *  range is empty if it isn't in the file
+   *  @param iatRva RVA of the import address table
+   *  @param nameBase Subtracted from the thunks of the functions imported by
+   *  name, the image base if they're virtual addresses
+   * */
+  ThunkRange(const PeType& pe,
+    DWORD lookupRva,
+    DWORD iatRva,
+    typename PeType::FileClass::Address nameBase = 0);
+
+  [[nodiscard]] auto begin() const -> ThunkIterator<PeType>;
+
+  [[nodiscard]] auto end() const -> ThunkIterator<PeType>;
+
+private:
+  const PeType* mPe{}; /**< Image */
+  std::span<const unsigned char> mThunks; /**< Bytes of the table */
+  DWORD mIatRva{}; /**< RVA of the import address table */
+  typename PeType::FileClass::Address mNameBase{}; /**< Base of the names */
+};
+
+
+/** @brief A DLL of the import directory */
+template<class PeType>
+class ImportedModule
+{
+public:
+  /** @brief ImportedModule constructor
+   *
+   *  @param pe Image
+   *  @param descriptor Import descriptor of the DLL
+   * */
+  ImportedModule(const PeType& pe, const IMAGE_IMPORT_DESCRIPTOR& descriptor);
+
+  /** @brief Returns the import descriptor */
+  [[nodiscard]] auto descriptor() const noexcept
+    -> const IMAGE_IMPORT_DESCRIPTOR&;
+
+  /** @brief Returns the name of the DLL, empty if it isn't in the file */
+  [[nodiscard]] auto name() const -> std::string_view;
+
+  /** @brief Returns the imported functions
+   *
+   *  They're read from the import lookup table (OriginalFirstThunk), or from
+   *  the import address table if the image doesn't have one, like old Borland
+   *  linkers do
+   * */
+  [[nodiscard]] auto functions() const -> ThunkRange<PeType>;
+
+private:
+  const PeType* mPe{}; /**< Image */
+  IMAGE_IMPORT_DESCRIPTOR mDescriptor{}; /**< Import descriptor */
+};
+
+
+/** @brief Import directory (data directory 1)
+ *
+ *  Only the number of descriptors is computed by the constructor, the
+ *  descriptors are decoded when they're accessed
+ *
+ *  @tparam PeType `Pe` of the image, it must outlive the directory
+ * */
+template<class PeType>
+class ImportDirectory
+{
+public:
+  static constexpr std::size_t descriptorSize{
+    20
+  }; /**< Size of an IMAGE_IMPORT_DESCRIPTOR */
+
+  /** @brief Forward iterator over the DLLs */
+  using Iterator =
+    detail::DirectoryIterator<ImportDirectory, ImportedModule<PeType>>;
+
+  /** @brief ImportDirectory constructor
+   *
+   *  @param pe Image
+   *  @param data Bytes of the descriptors, the table ends at a zero
+   *  descriptor or at the end of `data`
+   * */
+  ImportDirectory(const PeType& pe, std::span<const unsigned char> data);
+
+  /** @brief Returns the number of DLLs */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] auto empty() const noexcept -> bool;
+
+  /** @brief Returns the DLL `index`, it throws `PelfException` if it's out of
+   * range */
+  [[nodiscard]] auto module(std::size_t index) const -> ImportedModule<PeType>;
+
+  /** @brief Finds a DLL by name, ignoring the case
+   *
+   *  @return DLL, `std::nullopt` if the image doesn't import it
+   * */
+  [[nodiscard]] auto find(std::string_view name) const
+    -> std::optional<ImportedModule<PeType>>;
+
+  [[nodiscard]] auto begin() const -> Iterator;
+
+  [[nodiscard]] auto end() const -> Iterator;
+
+private:
+  const PeType* mPe{}; /**< Image */
+  std::span<const unsigned char> mData; /**< Descriptors */
+  std::size_t mSize{}; /**< Number of descriptors */
+};
+
+
+/** @brief A DLL of the delay import directory */
+template<class PeType>
+class DelayImportedModule
+{
+public:
+  /** @brief DelayImportedModule constructor
+   *
+   *  @param pe Image
+   *  @param descriptor Delay load descriptor of the DLL
+   *  @param imageBase Image base, the addresses of descriptors without
+   *  `dlattrRva` are virtual addresses
+   * */
+  DelayImportedModule(const PeType& pe,
+    const IMAGE_DELAYLOAD_DESCRIPTOR& descriptor,
+    typename PeType::FileClass::Address imageBase);
+
+  /** @brief Returns the delay load descriptor, as stored in the file */
+  [[nodiscard]] auto descriptor() const noexcept
+    -> const IMAGE_DELAYLOAD_DESCRIPTOR&;
+
+  /** @brief Returns `true` if the addresses of the descriptor are RVAs */
+  [[nodiscard]] auto isRvaBased() const noexcept -> bool;
+
+  /** @brief Returns the RVA of an address of the descriptor, e.g.
+   * `ModuleHandleRVA`, 0 if the address is 0 */
+  [[nodiscard]] auto rva(DWORD address) const noexcept -> DWORD;
+
+  /** @brief Returns the name of the DLL, empty if it isn't in the file */
+  [[nodiscard]] auto name() const -> std::string_view;
+
+  /** @brief Returns the delay imported functions, from the import name table
+   * and with the slots of the import address table the helper fills in */
+  [[nodiscard]] auto functions() const -> ThunkRange<PeType>;
+
+private:
+  const PeType* mPe{}; /**< Image */
+  IMAGE_DELAYLOAD_DESCRIPTOR mDescriptor{}; /**< Delay load descriptor */
+  typename PeType::FileClass::Address mImageBase{}; /**< Image base */
+};
+
+
+/** @brief Delay import directory (data directory 13)
+ *
+ *  Like `ImportDirectory` only the number of descriptors is computed by the
+ *  constructor
+ *
+ *  @tparam PeType `Pe` of the image, it must outlive the directory
+ * */
+template<class PeType>
+class DelayImportDirectory
+{
+public:
+  static constexpr std::size_t descriptorSize{
+    32
+  }; /**< Size of an IMAGE_DELAYLOAD_DESCRIPTOR */
+
+  /** @brief Forward iterator over the DLLs */
+  using Iterator = detail::DirectoryIterator<DelayImportDirectory,
+    DelayImportedModule<PeType>>;
+
+  /** @brief DelayImportDirectory constructor
+   *
+   *  @param pe Image
+   *  @param data Bytes of the descriptors, the table ends at a zero
+   *  descriptor or at the end of `data`
+   *  @param imageBase Image base of `pe`
+   * */
+  DelayImportDirectory(const PeType& pe,
+    std::span<const unsigned char> data,
+    typename PeType::FileClass::Address imageBase);
+
+  /** @brief Returns the number of DLLs */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] auto empty() const noexcept -> bool;
+
+  /** @brief Returns the DLL `index`, it throws `PelfException` if it's out of
+   * range */
+  [[nodiscard]] auto module(std::size_t index) const
+    -> DelayImportedModule<PeType>;
+
+  /** @brief Finds a DLL by name, ignoring the case
+   *
+   *  @return DLL, `std::nullopt` if the image doesn't delay load it
+   * */
+  [[nodiscard]] auto find(std::string_view name) const
+    -> std::optional<DelayImportedModule<PeType>>;
+
+  [[nodiscard]] auto begin() const -> Iterator;
+
+  [[nodiscard]] auto end() const -> Iterator;
+
+private:
+  const PeType* mPe{}; /**< Image */
+  std::span<const unsigned char> mData; /**< Descriptors */
+  std::size_t mSize{}; /**< Number of descriptors */
+  typename PeType::FileClass::Address mImageBase{}; /**< Image base */
+};
+
+
+/** @brief A DLL that a bound DLL forwards functions to */
+struct BoundForwarder
+{
+  DWORD timeDateStamp{}; /**< Time stamp of the DLL when it was bound */
+  std::string_view name; /**< Name of the DLL */
+};
+
+
+/** @brief A DLL of the bound import directory */
+class BoundImportedModule
+{
+public:
+  /** @brief BoundImportedModule constructor
+   *
+   *  @param directory Bytes of the directory, the names are relative to them
+   *  @param offset Offset of the descriptor
+   * */
+  BoundImportedModule(std::span<const unsigned char> directory,
+    std::size_t offset);
+
+  /** @brief Returns the bound import descriptor */
+  [[nodiscard]] auto descriptor() const -> IMAGE_BOUND_IMPORT_DESCRIPTOR;
+
+  /** @brief Returns the time stamp of the DLL the image was bound against,
+   * the bound addresses are stale if the DLL has a different one */
+  [[nodiscard]] auto timeDateStamp() const -> DWORD;
+
+  /** @brief Returns the name of the DLL */
+  [[nodiscard]] auto name() const -> std::string_view;
+
+  /** @brief Returns the number of DLLs it forwards functions to */
+  [[nodiscard]] auto forwarderCount() const -> std::size_t;
+
+  /** @brief Returns the forwarder `index`, it throws `PelfException` if it's
+   * out of range */
+  [[nodiscard]] auto forwarder(std::size_t index) const -> BoundForwarder;
+
+private:
+  std::span<const unsigned char> mDirectory; /**< Bytes of the directory */
+  std::size_t mOffset{}; /**< Offset of the descriptor */
+};
+
+
+/** @brief Bound import directory (data directory 11)
+ *
+ *  The descriptors have a variable size, every one is followed by its
+ *  forwarder references, so they're only accessed by iterating. The
+ *  constructor computes the number of DLLs
+ * */
+class BoundImportDirectory
+{
+public:
+  static constexpr std::size_t descriptorSize{
+    8
+  }; /**< Size of an IMAGE_BOUND_IMPORT_DESCRIPTOR and of an
+          IMAGE_BOUND_FORWARDER_REF */
+
+  /** @brief Forward iterator over the DLLs */
+  class Iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = BoundImportedModule;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+
+    Iterator(const BoundImportDirectory* directory, std::size_t offset)
+      : mDirectory(directory), mOffset(offset)
+    {}
+
+    [[nodiscard]] auto operator*() const -> value_type
+    {
+      return BoundImportedModule{ mDirectory->mData, mOffset };
+    }
+
+    auto operator++() -> Iterator&
+    {
+      mOffset += descriptorSize * (1 + (**this).forwarderCount());
+      return *this;
+    }
+
+    auto operator++(int) -> Iterator
+    {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    [[nodiscard]] auto operator==(const Iterator& other) const noexcept
+      -> bool
+    {
+      return mOffset == other.mOffset;
+    }
+
+  private:
+    const BoundImportDirectory* mDirectory{}; /**< Directory */
+    std::size_t mOffset{}; /**< Offset of the current descriptor */
+  };
+
+  BoundImportDirectory() = default;
+
+  /** @brief BoundImportDirectory constructor
+   *
+   *  @param data Bytes of the directory, the table ends at a zero descriptor
+   *  or at the end of `data`
+   * */
+  explicit BoundImportDirectory(std::span<const unsigned char> data);
+
+  /** @brief Returns the number of DLLs */
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] auto empty() const noexcept -> bool;
+
+  /** @brief Finds a DLL by name, ignoring the case
+   *
+   *  @return DLL, `std::nullopt` if the image isn't bound against it
+   * */
+  [[nodiscard]] auto find(std::string_view name) const
+    -> std::optional<BoundImportedModule>;
+
+  [[nodiscard]] auto begin() const -> Iterator;
+
+  [[nodiscard]] auto end() const -> Iterator;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the directory */
+  std::size_t mSize{}; /**< Number of descriptors */
+  std::size_t mEnd{}; /**< Offset of the end of the last descriptor */
+};
+
+
+template<class PeType>
+ThunkIterator<PeType>::ThunkIterator(const PeType& pe,
+  std::span<const unsigned char> thunks,
+  DWORD iatRva,
+  typename PeType::FileClass::Address nameBase)
+  : mPe(&pe), mThunks(thunks), mIatRva(iatRva), mNameBase(nameBase)
+{
+  load();
+}
+
+template<class PeType>
+auto ThunkIterator<PeType>::operator*() const noexcept -> reference
+{
+  return mFunction;
+}
+
+template<class PeType>
+auto ThunkIterator<PeType>::operator->() const noexcept -> pointer
+{
+  return &mFunction;
+}
+
+template<class PeType>
+auto ThunkIterator<PeType>::operator++() -> ThunkIterator&
+{
+  mThunks = mThunks.subspan(thunkSize);
+  mIatRva += thunkSize;
+  load();
+  return *this;
+}
+
+template<class PeType>
+auto ThunkIterator<PeType>::operator++(int) -> ThunkIterator
+{
+  auto copy = *this;
+  ++*this;
+  return copy;
+}
+
+template<class PeType>
+auto ThunkIterator<PeType>::operator==(const ThunkIterator& other) const
+  noexcept -> bool
+{
+  return mThunks.data() == other.mThunks.data()
+         && mThunks.size() == other.mThunks.size();
+}
+
+template<class PeType>
+auto ThunkIterator<PeType>::load() -> void
+{
+  using Address = typename PeType::FileClass::Address;
+
+  const Address thunk =
+    mThunks.size() < thunkSize ? 0 : readInteger<Address>(mThunks, 0);
+  if (thunk == 0) {
+    mThunks = {};
+    return;
+  }
+
+  mFunction = ImportedFunction{};
+  mFunction.iatRva = mIatRva;
+
+  /* The most significant bit selects an ordinal, otherwise the low 31 bits
+   * are the RVA of an IMAGE_IMPORT_BY_NAME */
+  constexpr Address ordinal_flag = Address{ 1 } << (thunkSize * 8 - 1);
+  if ((thunk & ordinal_flag) != 0) {
+    mFunction.ordinal = static_cast<WORD>(thunk);
+    return;
+  }
+
+  const auto hint_name =
+    mPe->getDataAtRva(static_cast<DWORD>((thunk - mNameBase) & 0x7fffffff));
+  if (hint_name.size() < 2) {
+    throw PelfException{ "Invalid import, its name isn't in the file" };
+  }
+
+  mFunction.hint = readInteger<WORD>(hint_name, 0);
+  mFunction.name = detail::peString(hint_name.subspan(2));
+}
+
+
+template<class PeType>
+ThunkRange<PeType>::ThunkRange(const PeType& pe,
+  DWORD lookupRva,
+  DWORD iatRva,
+  typename PeType::FileClass::Address nameBase)
+  : mPe(&pe), mThunks(pe.getDataAtRva(lookupRva)), mIatRva(iatRva),
+    mNameBase(nameBase)
+{}
+
+template<class PeType>
+auto ThunkRange<PeType>::begin() const -> ThunkIterator<PeType>
+{
+  if (mPe == nullptr) { return {}; }
+
+  return ThunkIterator<PeType>{ *mPe, mThunks, mIatRva, mNameBase };
+}
+
+template<class PeType>
+auto ThunkRange<PeType>::end() const -> ThunkIterator<PeType>
+{
+  return {};
+}
+
+
+template<class PeType>
+ImportedModule<PeType>::ImportedModule(const PeType& pe,
+  const IMAGE_IMPORT_DESCRIPTOR& descriptor)
+  : mPe(&pe), mDescriptor(descriptor)
+{}
+
+template<class PeType>
+auto ImportedModule<PeType>::descriptor() const noexcept
+  -> const IMAGE_IMPORT_DESCRIPTOR&
+{
+  return mDescriptor;
+}
+
+template<class PeType>
+auto ImportedModule<PeType>::name() const -> std::string_view
+{
+  return detail::peString(mPe->getDataAtRva(mDescriptor.Name));
+}
+
+template<class PeType>
+auto ImportedModule<PeType>::functions() const -> ThunkRange<PeType>
+{
+  const DWORD lookup = mDescriptor.OriginalFirstThunk != 0
+                         ? mDescriptor.OriginalFirstThunk
+                         : mDescriptor.FirstThunk;
+
+  return ThunkRange<PeType>{ *mPe, lookup, mDescriptor.FirstThunk };
+}
+
+
+template<class PeType>
+ImportDirectory<PeType>::ImportDirectory(const PeType& pe,
+  std::span<const unsigned char> data)
+  : mPe(&pe), mData(data)
+{
+  /* A descriptor without name and IAT ends the table */
+  while ((mSize + 1) * descriptorSize <= mData.size()) {
+    const std::size_t offset = mSize * descriptorSize;
+    if (readInteger<DWORD>(mData, offset + 12) == 0
+        && readInteger<DWORD>(mData, offset + 16) == 0) {
+      break;
+    }
+    ++mSize;
+  }
+}
+
+template<class PeType>
+auto ImportDirectory<PeType>::size() const noexcept -> std::size_t
+{
+  return mSize;
+}
+
+template<class PeType>
+auto ImportDirectory<PeType>::empty() const noexcept -> bool
+{
+  return mSize == 0;
+}
+
+template<class PeType>
+auto ImportDirectory<PeType>::module(std::size_t index) const
+  -> ImportedModule<PeType>
+{
+  if (index >= mSize) {
+    throw PelfException{ "Invalid index, out of the import directory" };
+  }
+
+  return ImportedModule<PeType>{ *mPe,
+    readStruct<IMAGE_IMPORT_DESCRIPTOR>(mData, index * descriptorSize) };
+}
+
+template<class PeType>
+auto ImportDirectory<PeType>::find(std::string_view name) const
+  -> std::optional<ImportedModule<PeType>>
+{
+  for (const auto& imported : *this) {
+    if (detail::equalsIgnoreCase(imported.name(), name)) { return imported; }
+  }
+
+  return std::nullopt;
+}
+
+template<class PeType>
+auto ImportDirectory<PeType>::begin() const -> Iterator
+{
+  return Iterator{ this, 0 };
+}
+
+template<class PeType>
+auto ImportDirectory<PeType>::end() const -> Iterator
+{
+  return Iterator{ this, mSize };
+}
+
+
+template<class PeType>
+DelayImportedModule<PeType>::DelayImportedModule(const PeType& pe,
+  const IMAGE_DELAYLOAD_DESCRIPTOR& descriptor,
+  typename PeType::FileClass::Address imageBase)
+  : mPe(&pe), mDescriptor(descriptor), mImageBase(imageBase)
+{}
+
+template<class PeType>
+auto DelayImportedModule<PeType>::descriptor() const noexcept
+  -> const IMAGE_DELAYLOAD_DESCRIPTOR&
+{
+  return mDescriptor;
+}
+
+template<class PeType>
+auto DelayImportedModule<PeType>::isRvaBased() const noexcept -> bool
+{
+  return (mDescriptor.Attributes & dlattrRva) != 0;
+}
+
+template<class PeType>
+auto DelayImportedModule<PeType>::rva(DWORD address) const noexcept -> DWORD
+{
+  if (address == 0 || isRvaBased()) { return address; }
+
+  /* The virtual addresses of PE32 images fit in the DWORD fields */
+  return static_cast<DWORD>(address - mImageBase);
+}
+
+template<class PeType>
+auto DelayImportedModule<PeType>::name() const -> std::string_view
+{
+  return detail::peString(mPe->getDataAtRva(rva(mDescriptor.DllNameRVA)));
+}
+
+template<class PeType>
+auto DelayImportedModule<PeType>::functions() const -> ThunkRange<PeType>
+{
+  return ThunkRange<PeType>{ *mPe,
+    rva(mDescriptor.ImportNameTableRVA),
+    rva(mDescriptor.ImportAddressTableRVA),
+    isRvaBased() ? 0 : mImageBase };
+}
+
+
+template<class PeType>
+DelayImportDirectory<PeType>::DelayImportDirectory(const PeType& pe,
+  std::span<const unsigned char> data,
+  typename PeType::FileClass::Address imageBase)
+  : mPe(&pe), mData(data), mImageBase(imageBase)
+{
+  /* A descriptor without name and IAT ends the table */
+  while ((mSize + 1) * descriptorSize <= mData.size()) {
+    const std::size_t offset = mSize * descriptorSize;
+    if (readInteger<DWORD>(mData, offset + 4) == 0
+        && readInteger<DWORD>(mData, offset + 12) == 0) {
+      break;
+    }
+    ++mSize;
+  }
+}
+
+template<class PeType>
+auto DelayImportDirectory<PeType>::size() const noexcept -> std::size_t
+{
+  return mSize;
+}
+
+template<class PeType>
+auto DelayImportDirectory<PeType>::empty() const noexcept -> bool
+{
+  return mSize == 0;
+}
+
+template<class PeType>
+auto DelayImportDirectory<PeType>::module(std::size_t index) const
+  -> DelayImportedModule<PeType>
+{
+  if (index >= mSize) {
+    throw PelfException{ "Invalid index, out of the delay import directory" };
+  }
+
+  return DelayImportedModule<PeType>{ *mPe,
+    readStruct<IMAGE_DELAYLOAD_DESCRIPTOR>(mData, index * descriptorSize),
+    mImageBase };
+}
+
+template<class PeType>
+auto DelayImportDirectory<PeType>::find(std::string_view name) const
+  -> std::optional<DelayImportedModule<PeType>>
+{
+  for (const auto& imported : *this) {
+    if (detail::equalsIgnoreCase(imported.name(), name)) { return imported; }
+  }
+
+  return std::nullopt;
+}
+
+template<class PeType>
+auto DelayImportDirectory<PeType>::begin() const -> Iterator
+{
+  return Iterator{ this, 0 };
+}
+
+template<class PeType>
+auto DelayImportDirectory<PeType>::end() const -> Iterator
+{
+  return Iterator{ this, mSize };
+}
+
+
+inline BoundImportedModule::BoundImportedModule(
+  std::span<const unsigned char> directory,
+  std::size_t offset)
+  : mDirectory(directory), mOffset(offset)
+{}
+
+inline auto BoundImportedModule::descriptor() const
+  -> IMAGE_BOUND_IMPORT_DESCRIPTOR
+{
+  return readStruct<IMAGE_BOUND_IMPORT_DESCRIPTOR>(mDirectory, mOffset);
+}
+
+inline auto BoundImportedModule::timeDateStamp() const -> DWORD
+{
+  return readInteger<DWORD>(mDirectory, mOffset);
+}
+
+inline auto BoundImportedModule::name() const -> std::string_view
+{
+  const WORD name = readInteger<WORD>(mDirectory, mOffset + 4);
+  if (name >= mDirectory.size()) {
+    throw PelfException{ "Invalid bound import, its name isn't in the file" };
+  }
+
+  return detail::peString(mDirectory.subspan(name));
+}
+
+inline auto BoundImportedModule::forwarderCount() const -> std::size_t
+{
+  return readInteger<WORD>(mDirectory, mOffset + 6);
+}
+
+inline auto BoundImportedModule::forwarder(std::size_t index) const
+  -> BoundForwarder
+{
+  if (index >= forwarderCount()) {
+    throw PelfException{ "Invalid index, out of the bound forwarders" };
+  }
+
+  const std::size_t offset =
+    mOffset + BoundImportDirectory::descriptorSize * (index + 1);
+  const WORD name = readInteger<WORD>(mDirectory, offset + 4);
+  if (name >= mDirectory.size()) {
+    throw PelfException{ "Invalid forwarder, its name isn't in the file" };
+  }
+
+  return BoundForwarder{ readInteger<DWORD>(mDirectory, offset),
+    detail::peString(mDirectory.subspan(name)) };
+}
+
+
+inline BoundImportDirectory::BoundImportDirectory(
+  std::span<const unsigned char> data)
+  : mData(data)
+{
+  /* A zero descriptor ends the table, a descriptor whose forwarder
+   * references are truncated too */
+  while (mEnd + descriptorSize <= mData.size()) {
+    if (readInteger<DWORD>(mData, mEnd) == 0
+        && readInteger<WORD>(mData, mEnd + 4) == 0) {
+      break;
+    }
+
+    const std::size_t next =
+      mEnd + descriptorSize * (1 + readInteger<WORD>(mData, mEnd + 6));
+    if (next > mData.size()) { break; }
+
+    mEnd = next;
+    ++mSize;
+  }
+}
+
+inline auto BoundImportDirectory::size() const noexcept -> std::size_t
+{
+  return mSize;
+}
+
+inline auto BoundImportDirectory::empty() const noexcept -> bool
+{
+  return mSize == 0;
+}
+
+inline auto BoundImportDirectory::find(std::string_view name) const
+  -> std::optional<BoundImportedModule>
+{
+  for (const auto& bound : *this) {
+    if (detail::equalsIgnoreCase(bound.name(), name)) { return bound; }
+  }
+
+  return std::nullopt;
+}
+
+inline auto BoundImportDirectory::begin() const -> Iterator
+{
+  return Iterator{ this, 0 };
+}
+
+inline auto BoundImportDirectory::end() const -> Iterator
+{
+  return Iterator{ this, mEnd };
+}
+
+
+}// namespace pelf
+
+#endif
@@ -0,0 +1,391 @@
+/** @file peLoadConfig.h
+ *  @brief Load config and TLS directory tables declarations
+ *
+ *  This file contains views of the tables referenced by the load config
+ *  directory (data directory 10): the Control Flow Guard tables of /guard:cf
+ *  images (valid call targets, long jump targets, address taken IAT entries)
+ *  and the SafeSEH handler table of x86 images, all of them sorted arrays of
+ *  RVAs. It also contains a view of the zero terminated array of the TLS
+ *  callbacks of the TLS directory (data directory 9)
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PELOADCONFIG_H_
+#define PELOADCONFIG_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <span>
+
+#include "Pelf.h"
+#include "peStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief An entry of an `RvaTable` */
+struct RvaTableEntry
+{
+  DWORD rva{}; /**< RVA of the target */
+  BYTE flags{}; /**< IMAGE_GUARD_FLAG_*, 0 if the table doesn't have flags */
+};
+
+
+class RvaTable;
+
+
+/** @brief Forward iterator over the entries of an `RvaTable` */
+class RvaTableIterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = RvaTableEntry;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const RvaTableEntry*;
+  using reference = RvaTableEntry;
+
+  constexpr RvaTableIterator() = default;
+
+  /** @brief RvaTableIterator constructor
+   *
+   *  @param table Table, it must outlive the iterator
+   *  @param index Index of the entry
+   * */
+  constexpr RvaTableIterator(const RvaTable& table, std::size_t index) noexcept;
+
+  [[nodiscard]] constexpr auto operator*() const -> reference;
+
+  constexpr auto operator++() noexcept -> RvaTableIterator&;
+
+  constexpr auto operator++(int) noexcept -> RvaTableIterator;
+
+  [[nodiscard]] constexpr auto operator==(
+    const RvaTableIterator& other) const noexcept -> bool;
+
+private:
+  const RvaTable* mTable{}; /**< Table */
+  std::size_t mIndex{}; /**< Index of the current entry */
+};
+
+
+/** @brief A table of sorted RVAs, e.g. the CFG function table
+ *
+ *  Every entry is an RVA followed by `stride - 4` bytes, the first of them
+ *  has the IMAGE_GUARD_FLAG_* of the entry. The entries are decoded from the
+ *  bytes of the file when they're accessed, so tables with hundreds of
+ *  thousands of entries aren't copied
+ * */
+class RvaTable
+{
+public:
+  constexpr RvaTable() = default;
+
+  /** @brief RvaTable constructor
+   *
+   *  @param data Bytes of the table, a trailing partial entry is ignored
+   *  @param stride Size of an entry, at least 4
+   * */
+  constexpr RvaTable(std::span<const unsigned char> data,
+    std::size_t stride) noexcept;
+
+  /** @brief Returns the number of entries */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool;
+
+  /** @brief Returns the size of an entry */
+  [[nodiscard]] constexpr auto stride() const noexcept -> std::size_t;
+
+  /** @brief Returns the entry `index`, it throws `PelfException` if it's out
+   * of range */
+  [[nodiscard]] constexpr auto entry(std::size_t index) const -> RvaTableEntry;
+
+  /** @brief Returns the entry of `rva`, a binary search over the table
+   *
+   *  @return Entry, `std::nullopt` if `rva` isn't in the table
+   * */
+  [[nodiscard]] constexpr auto find(DWORD rva) const
+    -> std::optional<RvaTableEntry>;
+
+  /** @brief Returns `true` if `rva` is in the table */
+  [[nodiscard]] constexpr auto contains(DWORD rva) const -> bool;
+
+  [[nodiscard]] constexpr auto begin() const noexcept -> RvaTableIterator;
+
+  [[nodiscard]] constexpr auto end() const noexcept -> RvaTableIterator;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the table */
+  std::size_t mStride{ 4 }; /**< Size of an entry */
+};
+
+
+/** @brief Forward iterator over the zero terminated array of addresses of
+ * the TLS callbacks
+ *
+ *  @tparam Address `ULONGLONG` in PE32+ images, `DWORD` in PE32 images
+ * */
+template<class Address>
+class TlsCallbackIterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = Address;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const Address*;
+  using reference = Address;
+
+  /** @brief Constructs the end iterator */
+  constexpr TlsCallbackIterator() = default;
+
+  /** @brief TlsCallbackIterator constructor
+   *
+   *  @param data Bytes of the array from the current address
+   * */
+  constexpr explicit TlsCallbackIterator(
+    std::span<const unsigned char> data) noexcept;
+
+  [[nodiscard]] constexpr auto operator*() const -> reference;
+
+  constexpr auto operator++() noexcept -> TlsCallbackIterator&;
+
+  constexpr auto operator++(int) noexcept -> TlsCallbackIterator;
+
+  [[nodiscard]] constexpr auto operator==(
+    const TlsCallbackIterator& other) const noexcept -> bool;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes from the current address,
+                                           empty at the end */
+
+  /** @brief Ends the iteration at a zero address or at the end of the data */
+  constexpr auto check() noexcept -> void;
+};
+
+
+/** @brief Range of the virtual addresses of the TLS callbacks */
+template<class Address>
+class TlsCallbacks
+{
+public:
+  constexpr TlsCallbacks() = default;
+
+  /** @brief TlsCallbacks constructor
+   *
+   *  @param data Bytes of the file from the beginning of the array
+   * */
+  constexpr explicit TlsCallbacks(
+    std::span<const unsigned char> data) noexcept;
+
+  [[nodiscard]] constexpr auto begin() const noexcept
+    -> TlsCallbackIterator<Address>;
+
+  [[nodiscard]] constexpr auto end() const noexcept
+    -> TlsCallbackIterator<Address>;
+
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the array */
+};
+
+
+/** @brief Returns the size of the entries of the guard tables
+ *
+ *  @param guardFlags GuardFlags of the load config directory
+ * */
+[[nodiscard]] constexpr auto guardTableStride(DWORD guardFlags) noexcept
+  -> std::size_t
+{
+  return 4
+         + ((guardFlags & IMAGE_GUARD_CF_FUNCTION_TABLE_SIZE_MASK)
+            >> IMAGE_GUARD_CF_FUNCTION_TABLE_SIZE_SHIFT);
+}
+
+
+constexpr RvaTableIterator::RvaTableIterator(const RvaTable& table,
+  std::size_t index) noexcept
+  : mTable(&table), mIndex(index)
+{}
+
+constexpr auto RvaTableIterator::operator*() const -> reference
+{
+  return mTable->entry(mIndex);
+}
+
+constexpr auto RvaTableIterator::operator++() noexcept -> RvaTableIterator&
+{
+  ++mIndex;
+  return *this;
+}
+
+constexpr auto RvaTableIterator::operator++(int) noexcept -> RvaTableIterator
+{
+  auto previous = *this;
+  ++mIndex;
+  return previous;
+}
+
+constexpr auto RvaTableIterator::operator==(
+  const RvaTableIterator& other) const noexcept -> bool
+{
+  return mTable == other.mTable && mIndex == other.mIndex;
+}
+
+
+constexpr RvaTable::RvaTable(std::span<const unsigned char> data,
+  std::size_t stride) noexcept
+  : mData(data.first(data.size() - data.size() % std::max<std::size_t>(
+                                     stride, 4))),
+    mStride(std::max<std::size_t>(stride, 4))
+{}
+
+constexpr auto RvaTable::size() const noexcept -> std::size_t
+{
+  return mData.size() / mStride;
+}
+
+constexpr auto RvaTable::empty() const noexcept -> bool
+{
+  return mData.empty();
+}
+
+constexpr auto RvaTable::stride() const noexcept -> std::size_t
+{
+  return mStride;
+}
+
+constexpr auto RvaTable::entry(std::size_t index) const -> RvaTableEntry
+{
+  if (index >= size()) {
+    throw PelfException{ "Invalid index, out of the RVA table" };
+  }
+
+  const std::size_t offset = index * mStride;
+  return RvaTableEntry{ readInteger<DWORD>(mData, offset),
+    mStride > 4 ? mData[offset + 4] : BYTE{} };
+}
+
+constexpr auto RvaTable::find(DWORD rva) const -> std::optional<RvaTableEntry>
+{
+  /* First entry whose RVA is >= rva, only that field is read */
+  std::size_t first{};
+  std::size_t last{ size() };
+  while (first < last) {
+    const std::size_t middle = first + (last - first) / 2;
+    if (readInteger<DWORD>(mData, middle * mStride) < rva) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+
+  if (first == size()) { return std::nullopt; }
+
+  const auto found = entry(first);
+  if (found.rva != rva) { return std::nullopt; }
+
+  return found;
+}
+
+constexpr auto RvaTable::contains(DWORD rva) const -> bool
+{
+  return find(rva).has_value();
+}
+
+constexpr auto RvaTable::begin() const noexcept -> RvaTableIterator
+{
+  return { *this, 0 };
+}
+
+constexpr auto RvaTable::end() const noexcept -> RvaTableIterator
+{
+  return { *this, size() };
+}
+
+
+template<class Address>
+constexpr TlsCallbackIterator<Address>::TlsCallbackIterator(
+  std::span<const unsigned char> data) noexcept
+  : mData(data)
+{
+  check();
+}
+
+template<class Address>
+constexpr auto TlsCallbackIterator<Address>::operator*() const -> reference
+{
+  return readInteger<Address>(mData, 0);
+}
+
+template<class Address>
+constexpr auto TlsCallbackIterator<Address>::operator++() noexcept
+  -> TlsCallbackIterator&
+{
+  mData = mData.subspan(sizeof(Address));
+  check();
+  return *this;
+}
+
+template<class Address>
+constexpr auto TlsCallbackIterator<Address>::operator++(int) noexcept
+  -> TlsCallbackIterator
+{
+  auto previous = *this;
+  ++*this;
+  return previous;
+}
+
+template<class Address>
+constexpr auto TlsCallbackIterator<Address>::operator==(
+  const TlsCallbackIterator& other) const noexcept -> bool
+{
+  return mData.data() == other.mData.data()
+         && mData.size() == other.mData.size();
+}
+
+template<class Address>
+constexpr auto TlsCallbackIterator<Address>::check() noexcept -> void
+{
+  if (mData.size() < sizeof(Address) || readInteger<Address>(mData, 0) == 0) {
+    mData = {};
+  }
+}
+
+
+template<class Address>
+constexpr TlsCallbacks<Address>::TlsCallbacks(
+  std::span<const unsigned char> data) noexcept
+  : mData(data)
+{}
+
+template<class Address>
+constexpr auto TlsCallbacks<Address>::begin() const noexcept
+  -> TlsCallbackIterator<Address>
+{
+  return TlsCallbackIterator<Address>{ mData };
+}
+
+template<class Address>
+constexpr auto TlsCallbacks<Address>::end() const noexcept
+  -> TlsCallbackIterator<Address>
+{
+  return {};
+}
+
+template<class Address>
+constexpr auto TlsCallbacks<Address>::empty() const noexcept -> bool
+{
+  return begin() == end();
+}
+
+
+}// namespace pelf
+
+#endif
@@ -0,0 +1,587 @@
+/** @file peResources.h
+ *  @brief Resource tree (`.rsrc`) declarations
+ *
+ *  This file contains views of the resource directory of PE images: the
+ *  directories of the tree (`IMAGE_RESOURCE_DIRECTORY`), their entries and the
+ *  UTF-16 names of the entries. Nothing is copied, a directory is decoded when
+ *  it's reached and `ResourceDirectory::find()` is a binary search over its
+ *  entries, so looking up a resource reads O(log n) entries of each level
+ *  instead of the whole tree
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PERESOURCES_H_
+#define PERESOURCES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "Pelf.h"
+#include "peStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief UTF-16LE string read in place
+ *
+ *  The bytes of PE files aren't aligned for `char16_t`, the code units are
+ *  read one by one. `toUtf8()` is the only function that allocates
+ * */
+class Utf16View
+{
+public:
+  constexpr Utf16View() = default;
+
+  /** @brief Utf16View constructor
+   *
+   *  @param bytes Code units, a trailing odd byte is ignored
+   * */
+  constexpr explicit Utf16View(std::span<const unsigned char> bytes) noexcept;
+
+  /** @brief Returns the number of code units */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool;
+
+  /** @brief Returns the code unit `index`, it throws `PelfException` if it's
+   * out of range */
+  [[nodiscard]] constexpr auto operator[](std::size_t index) const -> char16_t;
+
+  /** @brief Returns the bytes of the string */
+  [[nodiscard]] constexpr auto bytes() const noexcept
+    -> std::span<const unsigned char>;
+
+  /** @brief Compares the code units of the string with a UTF-8 string
+   *
+   *  @return Negative, zero or positive like `std::string_view::compare()`
+   * */
+  [[nodiscard]] constexpr auto compare(std::string_view utf8) const -> int;
+
+  /** @brief Same as `compare()`, but ASCII letters are compared as upper case
+   * letters like the names of the resource directories are sorted */
+  [[nodiscard]] constexpr auto compareIgnoreCase(std::string_view utf8) const
+    -> int;
+
+  [[nodiscard]] constexpr auto operator==(std::string_view utf8) const -> bool;
+
+  /** @brief Converts the string to UTF-8, unpaired surrogates are replaced
+   * with U+FFFD */
+  [[nodiscard]] auto toUtf8() const -> std::string;
+
+private:
+  std::span<const unsigned char> mBytes; /**< Code units */
+
+  /** @brief Compares the string with `utf8`, folding ASCII letters if
+   * `ignoreCase` is true */
+  [[nodiscard]] constexpr auto compareWith(std::string_view utf8,
+    bool ignoreCase) const -> int;
+};
+
+
+/** @brief Name of a resource: an ID or a string
+ *
+ *  It's constructed implicitly from both, so lookups read like the resource
+ *  script, e.g. `find(RT_RCDATA)` or `find("CONFIG")`
+ * */
+class ResourceId
+{
+public:
+  /** @brief Constructs an ID */
+  constexpr ResourceId(int id) noexcept;
+
+  /** @brief Constructs a name, it's UTF-8 and compared ignoring the case of
+   * ASCII letters */
+  constexpr ResourceId(std::string_view name) noexcept;
+
+  constexpr ResourceId(const char* name) noexcept;
+
+  /** @brief Returns `true` if it's a name */
+  [[nodiscard]] constexpr auto isName() const noexcept -> bool;
+
+  /** @brief Returns the ID, 0 for names */
+  [[nodiscard]] constexpr auto id() const noexcept -> WORD;
+
+  /** @brief Returns the name, empty for IDs */
+  [[nodiscard]] constexpr auto name() const noexcept -> std::string_view;
+
+private:
+  std::string_view mName; /**< Name */
+  WORD mId{}; /**< ID */
+  bool mIsName{}; /**< `true` if it's a name */
+};
+
+
+class ResourceDirectory;
+
+
+/** @brief Entry of a resource directory */
+class ResourceEntry
+{
+public:
+  /** @brief ResourceEntry constructor
+   *
+   *  @param resources Bytes of the resource directory (data directory 2)
+   *  @param name First DWORD of the entry, a name or an ID
+   *  @param offset Second DWORD of the entry, a subdirectory or a data entry
+   * */
+  constexpr ResourceEntry(std::span<const unsigned char> resources,
+    DWORD name,
+    DWORD offset) noexcept;
+
+  /** @brief Returns `true` if the entry has a name instead of an ID */
+  [[nodiscard]] constexpr auto isNamed() const noexcept -> bool;
+
+  /** @brief Returns the ID, the language in the third level of the tree. It's
+   * 0 for named entries */
+  [[nodiscard]] constexpr auto id() const noexcept -> WORD;
+
+  /** @brief Returns the name, it throws `PelfException` if it isn't in the
+   * resource directory. It's empty for entries with an ID */
+  [[nodiscard]] constexpr auto name() const -> Utf16View;
+
+  /** @brief Returns `true` if the entry points to a subdirectory */
+  [[nodiscard]] constexpr auto isDirectory() const noexcept -> bool;
+
+  /** @brief Returns the subdirectory, it throws `PelfException` if the entry
+   * is a leaf or the directory isn't in the resource directory */
+  [[nodiscard]] constexpr auto directory() const -> ResourceDirectory;
+
+  /** @brief Returns the data entry of a leaf, it throws `PelfException` if the
+   * entry is a directory or the data entry isn't in the resource directory */
+  [[nodiscard]] constexpr auto dataEntry() const -> IMAGE_RESOURCE_DATA_ENTRY;
+
+private:
+  std::span<const unsigned char> mResources; /**< Resource directory */
+  DWORD mName{}; /**< Name or ID */
+  DWORD mOffset{}; /**< Offset of the subdirectory or the data entry */
+};
+
+
+/** @brief A directory of the resource tree
+ *
+ *  The root directory lists the types, its subdirectories the names of the
+ *  resources of a type and theirs the languages, whose entries are the
+ *  leaves. Subdirectories are decoded when `ResourceEntry::directory()` is
+ *  called, a malformed tree with cycles doesn't make anything loop
+ * */
+class ResourceDirectory
+{
+public:
+  static constexpr std::size_t entrySize{
+    8
+  }; /**< Size of an IMAGE_RESOURCE_DIRECTORY_ENTRY */
+
+  /** @brief Forward iterator over the entries of the directory */
+  class Iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ResourceEntry;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr Iterator() = default;
+
+    constexpr Iterator(const ResourceDirectory* directory, std::size_t index)
+      : mDirectory(directory), mIndex(index)
+    {}
+
+    [[nodiscard]] constexpr auto operator*() const -> value_type
+    {
+      return mDirectory->entry(mIndex);
+    }
+
+    constexpr auto operator++() -> Iterator&
+    {
+      ++mIndex;
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> Iterator
+    {
+      auto copy = *this;
+      ++mIndex;
+      return copy;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const Iterator& other) const
+      noexcept -> bool
+    {
+      return mIndex == other.mIndex;
+    }
+
+  private:
+    const ResourceDirectory* mDirectory{}; /**< Directory */
+    std::size_t mIndex{}; /**< Index of the current entry */
+  };
+
+  /** @brief Constructs an empty directory, used for images without
+   * resources */
+  constexpr ResourceDirectory() = default;
+
+  /** @brief ResourceDirectory constructor
+   *
+   *  @param resources Bytes of the resource directory (data directory 2)
+   *  @param offset Offset of the directory, 0 for the root. It throws
+   *  `PelfException` if the directory or its entries aren't in `resources`
+   * */
+  constexpr ResourceDirectory(std::span<const unsigned char> resources,
+    std::size_t offset);
+
+  /** @brief Returns the header of the directory */
+  [[nodiscard]] constexpr auto header() const -> IMAGE_RESOURCE_DIRECTORY;
+
+  /** @brief Returns the number of entries, named entries first */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool;
+
+  /** @brief Returns the entry `index`, it throws `PelfException` if it's out
+   * of range */
+  [[nodiscard]] constexpr auto entry(std::size_t index) const
+    -> ResourceEntry;
+
+  /** @brief Finds the entry with the name or ID `id`
+   *
+   *  Named entries are sorted by name ignoring the case, the entries with an
+   *  ID by ID, only the half of the directory that can hold `id` is searched
+   *
+   *  @return Entry, `std::nullopt` if the directory doesn't have it
+   * */
+  [[nodiscard]] constexpr auto find(const ResourceId& id) const
+    -> std::optional<ResourceEntry>;
+
+  [[nodiscard]] constexpr auto begin() const -> Iterator;
+
+  [[nodiscard]] constexpr auto end() const -> Iterator;
+
+private:
+  std::span<const unsigned char> mResources; /**< Resource directory */
+  std::size_t mOffset{}; /**< Offset of the directory */
+  std::size_t mNamedEntries{}; /**< NumberOfNamedEntries */
+  std::size_t mIdEntries{}; /**< NumberOfIdEntries */
+};
+
+
+/** @brief A resource found by `Pe::findResource()` */
+struct Resource
+{
+  WORD language{}; /**< Language ID, e.g. 0x409 for English (United States) */
+  IMAGE_RESOURCE_DATA_ENTRY entry{}; /**< Data entry */
+  std::span<const unsigned char> data; /**< Bytes of the resource */
+};
+
+
+constexpr Utf16View::Utf16View(std::span<const unsigned char> bytes) noexcept
+  : mBytes(bytes.first(bytes.size() & ~std::size_t{ 1 }))
+{}
+
+constexpr auto Utf16View::size() const noexcept -> std::size_t
+{
+  return mBytes.size() / 2;
+}
+
+constexpr auto Utf16View::empty() const noexcept -> bool
+{
+  return mBytes.empty();
+}
+
+constexpr auto Utf16View::operator[](std::size_t index) const -> char16_t
+{
+  if (index >= size()) {
+    throw PelfException{ "Invalid index, out of the string" };
+  }
+
+  return static_cast<char16_t>(readInteger<WORD>(mBytes, index * 2));
+}
+
+constexpr auto Utf16View::bytes() const noexcept
+  -> std::span<const unsigned char>
+{
+  return mBytes;
+}
+
+constexpr auto Utf16View::compare(std::string_view utf8) const -> int
+{
+  return compareWith(utf8, false);
+}
+
+constexpr auto Utf16View::compareIgnoreCase(std::string_view utf8) const
+  -> int
+{
+  return compareWith(utf8, true);
+}
+
+constexpr auto Utf16View::operator==(std::string_view utf8) const -> bool
+{
+  return compare(utf8) == 0;
+}
+
+inline auto Utf16View::toUtf8() const -> std::string
+{
+  std::string text;
+  text.reserve(size());
+
+  for (std::size_t i{}; i < size(); ++i) {
+    char32_t code_point = (*this)[i];
+
+    if (code_point >= 0xd800 && code_point < 0xdc00 && i + 1 < size()
+        && (*this)[i + 1] >= 0xdc00 && (*this)[i + 1] < 0xe000) {
+      code_point =
+        0x10000 + ((code_point - 0xd800) << 10) + ((*this)[i + 1] - 0xdc00);
+      ++i;
+    } else if (code_point >= 0xd800 && code_point < 0xe000) {
+      code_point = 0xfffd;
+    }
+
+    if (code_point < 0x80) {
+      text += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+      text += static_cast<char>(0xc0 | (code_point >> 6));
+      text += static_cast<char>(0x80 | (code_point & 0x3f));
+    } else if (code_point < 0x10000) {
+      text += static_cast<char>(0xe0 | (code_point >> 12));
+      text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+      text += static_cast<char>(0x80 | (code_point & 0x3f));
+    } else {
+      text += static_cast<char>(0xf0 | (code_point >> 18));
+      text += static_cast<char>(0x80 | ((code_point >> 12) & 0x3f));
+      text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+      text += static_cast<char>(0x80 | (code_point & 0x3f));
+    }
+  }
+
+  return text;
+}
+
+constexpr auto Utf16View::compareWith(std::string_view utf8,
+  bool ignoreCase) const -> int
+{
+  const auto fold = [ignoreCase](char32_t c) -> char32_t {
+    return ignoreCase && c >= 'a' && c <= 'z' ? c - ('a' - 'A') : c;
+  };
+
+  std::size_t unit{};
+  std::size_t position{};
+  char16_t low_surrogate{};
+
+  while (true) {
+    /* Next code unit of `utf8`, invalid sequences are read as U+FFFD */
+    char32_t other{};
+    bool other_end{};
+    if (low_surrogate != 0) {
+      other = low_surrogate;
+      low_surrogate = 0;
+    } else if (position == utf8.size()) {
+      other_end = true;
+    } else {
+      const auto lead = static_cast<unsigned char>(utf8[position++]);
+      const std::size_t length = lead < 0x80           ? 0
+                                 : (lead & 0xe0) == 0xc0 ? 1
+                                 : (lead & 0xf0) == 0xe0 ? 2
+                                 : (lead & 0xf8) == 0xf0 ? 3
+                                                         : 4;
+      other = length == 0 ? lead : lead & (0x3f >> length);
+
+      for (std::size_t i{}; i < length && length < 4; ++i) {
+        if (position == utf8.size()
+            || (static_cast<unsigned char>(utf8[position]) & 0xc0) != 0x80) {
+          other = 0xfffd;
+          break;
+        }
+        other = (other << 6) | (utf8[position++] & 0x3f);
+      }
+
+      if (length == 4 || other > 0x10ffff) { other = 0xfffd; }
+      if (other >= 0x10000) {
+        low_surrogate = static_cast<char16_t>(0xdc00 | (other & 0x3ff));
+        other = 0xd800 | ((other - 0x10000) >> 10);
+      }
+    }
+
+    const bool end = unit == size();
+    if (end || other_end) { return end && other_end ? 0 : end ? -1 : 1; }
+
+    const char32_t current = fold((*this)[unit++]);
+    other = fold(other);
+    if (current != other) { return current < other ? -1 : 1; }
+  }
+}
+
+
+constexpr ResourceId::ResourceId(int id) noexcept
+  : mId(static_cast<WORD>(id))
+{}
+
+constexpr ResourceId::ResourceId(std::string_view name) noexcept
+  : mName(name), mIsName(true)
+{}
+
+constexpr ResourceId::ResourceId(const char* name) noexcept
+  : ResourceId(std::string_view{ name })
+{}
+
+constexpr auto ResourceId::isName() const noexcept -> bool
+{
+  return mIsName;
+}
+
+constexpr auto ResourceId::id() const noexcept -> WORD
+{
+  return mId;
+}
+
+constexpr auto ResourceId::name() const noexcept -> std::string_view
+{
+  return mName;
+}
+
+
+constexpr ResourceEntry::ResourceEntry(
+  std::span<const unsigned char> resources,
+  DWORD name,
+  DWORD offset) noexcept
+  : mResources(resources), mName(name), mOffset(offset)
+{}
+
+constexpr auto ResourceEntry::isNamed() const noexcept -> bool
+{
+  return (mName & IMAGE_RESOURCE_NAME_IS_STRING) != 0;
+}
+
+constexpr auto ResourceEntry::id() const noexcept -> WORD
+{
+  return isNamed() ? WORD{} : static_cast<WORD>(mName);
+}
+
+constexpr auto ResourceEntry::name() const -> Utf16View
+{
+  if (!isNamed()) { return {}; }
+
+  /* IMAGE_RESOURCE_DIR_STRING_U, a WORD with the length and the code units */
+  const std::size_t offset = mName & ~IMAGE_RESOURCE_NAME_IS_STRING;
+  const std::size_t length = readInteger<WORD>(mResources, offset);
+  if (length * 2 > mResources.size() - offset - 2) {
+    throw PelfException{ "Invalid resource name, out of the resource directory" };
+  }
+
+  return Utf16View{ mResources.subspan(offset + 2, length * 2) };
+}
+
+constexpr auto ResourceEntry::isDirectory() const noexcept -> bool
+{
+  return (mOffset & IMAGE_RESOURCE_DATA_IS_DIRECTORY) != 0;
+}
+
+constexpr auto ResourceEntry::directory() const -> ResourceDirectory
+{
+  if (!isDirectory()) {
+    throw PelfException{ "Invalid resource entry, it isn't a directory" };
+  }
+
+  return ResourceDirectory{ mResources,
+    mOffset & ~IMAGE_RESOURCE_DATA_IS_DIRECTORY };
+}
+
+constexpr auto ResourceEntry::dataEntry() const -> IMAGE_RESOURCE_DATA_ENTRY
+{
+  if (isDirectory()) {
+    throw PelfException{ "Invalid resource entry, it isn't a data entry" };
+  }
+
+  return readStruct<IMAGE_RESOURCE_DATA_ENTRY>(mResources, mOffset);
+}
+
+
+constexpr ResourceDirectory::ResourceDirectory(
+  std::span<const unsigned char> resources,
+  std::size_t offset)
+  : mResources(resources), mOffset(offset)
+{
+  const auto directory = header();
+  mNamedEntries = directory.NumberOfNamedEntries;
+  mIdEntries = directory.NumberOfIdEntries;
+
+  /* The header was read, so `offset + 16` is in range */
+  if (size() * entrySize > mResources.size() - offset - 16) {
+    throw PelfException{
+      "Invalid resource directory, its entries exceed the data directory"
+    };
+  }
+}
+
+constexpr auto ResourceDirectory::header() const -> IMAGE_RESOURCE_DIRECTORY
+{
+  return readStruct<IMAGE_RESOURCE_DIRECTORY>(mResources, mOffset);
+}
+
+constexpr auto ResourceDirectory::size() const noexcept -> std::size_t
+{
+  return mNamedEntries + mIdEntries;
+}
+
+constexpr auto ResourceDirectory::empty() const noexcept -> bool
+{
+  return size() == 0;
+}
+
+constexpr auto ResourceDirectory::entry(std::size_t index) const
+  -> ResourceEntry
+{
+  if (index >= size()) {
+    throw PelfException{ "Invalid index, out of the resource directory" };
+  }
+
+  const std::size_t offset = mOffset + 16 + index * entrySize;
+  return ResourceEntry{ mResources,
+    readInteger<DWORD>(mResources, offset),
+    readInteger<DWORD>(mResources, offset + 4) };
+}
+
+constexpr auto ResourceDirectory::find(const ResourceId& id) const
+  -> std::optional<ResourceEntry>
+{
+  /* Named entries are [0, mNamedEntries), the IDs follow them */
+  std::size_t first = id.isName() ? 0 : mNamedEntries;
+  std::size_t last = id.isName() ? mNamedEntries : size();
+
+  while (first < last) {
+    const std::size_t middle = first + (last - first) / 2;
+    const auto current = entry(middle);
+    const int order = id.isName()
+                        ? current.name().compareIgnoreCase(id.name())
+                        : (id.id() < current.id()) - (current.id() < id.id());
+
+    if (order == 0) { return current; }
+    if (order < 0) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+
+  return std::nullopt;
+}
+
+constexpr auto ResourceDirectory::begin() const -> Iterator
+{
+  return Iterator{ this, 0 };
+}
+
+constexpr auto ResourceDirectory::end() const -> Iterator
+{
+  return Iterator{ this, size() };
+}
+
+
+}// namespace pelf
+
+#endif
@@ -0,0 +1,218 @@
+/** @file peRich.h
+ *  @brief Rich header decoder declarations
+ *
+ *  This file contains a decoder of the Rich header, the undocumented array
+ *  that Microsoft linkers write between the DOS stub and the PE header. It
+ *  lists the tools (comp.id, a product ID and a build number) that produced
+ *  the objects of the image and how many objects each one produced, encoded
+ *  with a XOR key that is also a checksum of the DOS header and the entries
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PERICH_H_
+#define PERICH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "Pelf.h"
+#include "checksum.h"
+#include "peStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief An entry of the Rich header */
+struct RichEntry
+{
+  WORD productId{}; /**< Tool, e.g. the C compiler of a Visual Studio version */
+  WORD build{}; /**< Build number of the tool */
+  DWORD count{}; /**< Number of objects produced by the tool */
+
+  /** @brief Returns the comp.id, the product ID and the build number */
+  [[nodiscard]] constexpr auto compId() const noexcept -> DWORD
+  {
+    return DWORD{ productId } << 16 | build;
+  }
+};
+
+
+/** @brief Rich header of an image
+ *
+ *  The entries are decoded from the bytes of the file when they're accessed
+ * */
+class RichHeader
+{
+public:
+  static constexpr DWORD richSignature{ 0x68636952 }; /**< "Rich" */
+  static constexpr DWORD dansSignature{ 0x536e6144 }; /**< "DanS" */
+
+  /** @brief Finds the Rich header
+   *
+   *  @param header Bytes of the file before the PE header
+   *  @return RichHeader, `std::nullopt` if there's no "Rich" signature or
+   *  the beginning of the header isn't found
+   * */
+  [[nodiscard]] static constexpr auto find(
+    std::span<const unsigned char> header) -> std::optional<RichHeader>;
+
+  /** @brief Returns the XOR key stored after "Rich" */
+  [[nodiscard]] constexpr auto key() const noexcept -> DWORD;
+
+  /** @brief Returns the offset of the encoded "DanS" in the file */
+  [[nodiscard]] constexpr auto offset() const noexcept -> std::size_t;
+
+  /** @brief Returns the number of entries */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool;
+
+  /** @brief Returns the entry `index`, it throws `PelfException` if it's out
+   * of range */
+  [[nodiscard]] constexpr auto entry(std::size_t index) const -> RichEntry;
+
+  /** @brief Computes the checksum the linker uses as the key, from the bytes
+   * before the header (without e_lfanew) and the entries */
+  [[nodiscard]] constexpr auto checksum() const -> DWORD;
+
+  /** @brief Returns `true` if the key is the checksum, a mismatch means the
+   * DOS header or the entries were modified after linking */
+  [[nodiscard]] constexpr auto isChecksumValid() const -> bool;
+
+  /** @brief Returns the MD5 of the decoded header, from "DanS" to the entry
+   * before "Rich", used to cluster images built by the same toolchain */
+  [[nodiscard]] constexpr auto hash() const -> Md5Digest;
+
+private:
+  std::span<const unsigned char> mHeader; /**< Bytes from the beginning of
+                                             the file to "Rich" */
+  std::size_t mOffset{}; /**< Offset of "DanS" */
+  DWORD mKey{}; /**< XOR key */
+
+  constexpr RichHeader(std::span<const unsigned char> header,
+    std::size_t offset,
+    DWORD key) noexcept;
+};
+
+
+constexpr RichHeader::RichHeader(std::span<const unsigned char> header,
+  std::size_t offset,
+  DWORD key) noexcept
+  : mHeader(header), mOffset(offset), mKey(key)
+{}
+
+constexpr auto RichHeader::find(std::span<const unsigned char> header)
+  -> std::optional<RichHeader>
+{
+  /* "Rich" is the last DWORD aligned signature before the PE header, the
+   * entries and "DanS" before it are encoded */
+  std::size_t rich = header.size() & ~std::size_t{ 3 };
+  while (true) {
+    if (rich < 0x40 + 8) { return std::nullopt; }
+    rich -= 4;
+    if (rich + 8 <= header.size()
+        && readInteger<DWORD>(header, rich) == richSignature) {
+      break;
+    }
+  }
+
+  const DWORD key = readInteger<DWORD>(header, rich + 4);
+  for (std::size_t dans = rich; dans >= 0x40 + 4;) {
+    dans -= 4;
+    if ((readInteger<DWORD>(header, dans) ^ key) != dansSignature) { continue; }
+
+    /* "DanS" is followed by three zero DWORDs, then the entries */
+    if (rich - dans < 16 || (rich - dans - 16) % 8 != 0) { return std::nullopt; }
+
+    return RichHeader{ header.first(rich), dans, key };
+  }
+
+  return std::nullopt;
+}
+
+constexpr auto RichHeader::key() const noexcept -> DWORD
+{
+  return mKey;
+}
+
+constexpr auto RichHeader::offset() const noexcept -> std::size_t
+{
+  return mOffset;
+}
+
+constexpr auto RichHeader::size() const noexcept -> std::size_t
+{
+  return (mHeader.size() - mOffset - 16) / 8;
+}
+
+constexpr auto RichHeader::empty() const noexcept -> bool
+{
+  return size() == 0;
+}
+
+constexpr auto RichHeader::entry(std::size_t index) const -> RichEntry
+{
+  if (index >= size()) {
+    throw PelfException{ "Invalid index, out of the Rich header" };
+  }
+
+  const std::size_t offset = mOffset + 16 + index * 8;
+  const DWORD comp_id = readInteger<DWORD>(mHeader, offset) ^ mKey;
+
+  return RichEntry{ static_cast<WORD>(comp_id >> 16),
+    static_cast<WORD>(comp_id),
+    readInteger<DWORD>(mHeader, offset + 4) ^ mKey };
+}
+
+constexpr auto RichHeader::checksum() const -> DWORD
+{
+  const auto rotate = [](DWORD value, DWORD shift) -> DWORD {
+    shift %= 32;
+    return shift == 0 ? value : value << shift | value >> (32 - shift);
+  };
+
+  auto sum = static_cast<DWORD>(mOffset);
+
+  /* e_lfanew (0x3c) is skipped, it's written after the header */
+  for (std::size_t i{}; i < mOffset; ++i) {
+    if (i >= 0x3c && i < 0x40) { continue; }
+    sum += rotate(mHeader[i], static_cast<DWORD>(i));
+  }
+
+  for (std::size_t i{}; i < size(); ++i) {
+    const auto current = entry(i);
+    sum += rotate(current.compId(), current.count);
+  }
+
+  return sum;
+}
+
+constexpr auto RichHeader::isChecksumValid() const -> bool
+{
+  return checksum() == mKey;
+}
+
+constexpr auto RichHeader::hash() const -> Md5Digest
+{
+  Md5 digest;
+
+  for (std::size_t offset{ mOffset }; offset < mHeader.size(); offset += 4) {
+    const DWORD value = readInteger<DWORD>(mHeader, offset) ^ mKey;
+    for (std::size_t i{}; i < 4; ++i) {
+      digest.update(static_cast<unsigned char>(value >> (i * 8)));
+    }
+  }
+
+  return digest.finish();
+}
+
+
+}// namespace pelf
+
+#endif
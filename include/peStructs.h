@@ -14,6 +14,7 @@
 
 #include <boost/hana.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <array>
 
@@ -30,6 +31,31 @@ using ULONGLONG = std::uint64_t;
 
 inline constexpr std::uint8_t IMAGE_NUMBER_OF_DIRECTORY_ENTRIES{ 16 };
 
+/* Machine types (IMAGE_FILE_HEADER::Machine) */
+inline constexpr WORD IMAGE_FILE_MACHINE_I386{ 0x14c }; /**< x86 */
+inline constexpr WORD IMAGE_FILE_MACHINE_ARMNT{ 0x1c4 }; /**< ARM Thumb-2 */
+inline constexpr WORD IMAGE_FILE_MACHINE_AMD64{ 0x8664 }; /**< x64 */
+inline constexpr WORD IMAGE_FILE_MACHINE_ARM64{ 0xaa64 }; /**< ARM64 */
+
+/* Indices of the data directories of the optional header */
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_EXPORT{ 0 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_IMPORT{ 1 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_RESOURCE{ 2 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_EXCEPTION{ 3 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_SECURITY{
+  4
+}; /**< Its address is a file offset, not an RVA */
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_BASERELOC{ 5 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_DEBUG{ 6 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_ARCHITECTURE{ 7 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_GLOBALPTR{ 8 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_TLS{ 9 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_LOAD_CONFIG{ 10 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_BOUND_IMPORT{ 11 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_IAT{ 12 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_DELAY_IMPORT{ 13 };
+inline constexpr std::size_t IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR{ 14 };
+
 
 /** @brief Struct that represents the COFF header format. It's 32/64 bit
  * independent header
@@ -132,30 +158,328 @@ struct WindowsSpecificFields
 #pragma pack(pop)
 
 
+/**
+ * @brief Struct that represents the standard fields of the optional header of
+ * PE32 files, it has an additional field (`BaseOfData`)
+ *
+ */
+#pragma pack(push, 1)
+struct StandardCoffFields32
+{
+  BOOST_HANA_DEFINE_STRUCT(StandardCoffFields32,
+    (WORD, Magic),
+    (BYTE, MajorLinkerVersion),
+    (BYTE, MinorLinkerVersion),
+    (DWORD, SizeOfCode),
+    (DWORD, SizeOfInitializedData),
+    (DWORD, SizeOfUninitializedData),
+    (DWORD, AddressOfEntryPoint),
+    (DWORD, BaseOfCode),
+    (DWORD, BaseOfData));
+};
+#pragma pack(pop)
+
+
+/**
+ * @brief Struct that represents the windows specific fields of PE32 files,
+ * the image base and the stack/heap sizes are 32 bit values
+ *
+ */
+#pragma pack(push, 1)
+struct WindowsSpecificFields32
+{
+  BOOST_HANA_DEFINE_STRUCT(WindowsSpecificFields32,
+
+    (DWORD, ImageBase),
+    (DWORD, SectionAlignment),
+    (DWORD, FileAlignment),
+    (WORD, MajorOperatingSystemVersion),
+    (WORD, MinorOperatingSystemVersion),
+    (WORD, MajorImageVersion),
+    (WORD, MinorImageVersion),
+    (WORD, MajorSubsystemVersion),
+    (WORD, MinorSubsystemVersion),
+    (DWORD, Win32VersionValue),
+    (DWORD, SizeOfImage),
+    (DWORD, SizeOfHeaders),
+    (DWORD, CheckSum),
+    (WORD, Subsystem),
+    (WORD, DllCharacteristics),
+    (DWORD, SizeOfStackReserve),
+    (DWORD, SizeOfStackCommit),
+    (DWORD, SizeOfHeapReserve),
+    (DWORD, SizeOfHeapCommit),
+    (DWORD, LoaderFlags),
+    (DWORD, NumberOfRvaAndSizes));
+};
+#pragma pack(pop)
+
+
+/**
+ * @brief Struct that represents the load config directory of PE32+ files
+ *
+ * The directory grew with every version of Windows, `Size` is the size of the
+ * version written by the linker and the fields after it aren't in the file.
+ * The tables and pointers are virtual addresses, not RVAs. The fields after
+ * the long jump table of /guard:cf (Windows 10 1607) aren't decoded
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_LOAD_CONFIG_DIRECTORY64
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_LOAD_CONFIG_DIRECTORY64,
+    (DWORD, Size),
+    (DWORD, TimeDateStamp),
+    (WORD, MajorVersion),
+    (WORD, MinorVersion),
+    (DWORD, GlobalFlagsClear),
+    (DWORD, GlobalFlagsSet),
+    (DWORD, CriticalSectionDefaultTimeout),
+    (ULONGLONG, DeCommitFreeBlockThreshold),
+    (ULONGLONG, DeCommitTotalFreeThreshold),
+    (ULONGLONG, LockPrefixTable),
+    (ULONGLONG, MaximumAllocationSize),
+    (ULONGLONG, VirtualMemoryThreshold),
+    (ULONGLONG, ProcessAffinityMask),
+    (DWORD, ProcessHeapFlags),
+    (WORD, CSDVersion),
+    (WORD, DependentLoadFlags),
+    (ULONGLONG, EditList),
+    (ULONGLONG, SecurityCookie),
+    (ULONGLONG, SEHandlerTable),
+    (ULONGLONG, SEHandlerCount),
+    (ULONGLONG, GuardCFCheckFunctionPointer),
+    (ULONGLONG, GuardCFDispatchFunctionPointer),
+    (ULONGLONG, GuardCFFunctionTable),
+    (ULONGLONG, GuardCFFunctionCount),
+    (DWORD, GuardFlags),
+    (WORD, CodeIntegrityFlags),
+    (WORD, CodeIntegrityCatalog),
+    (DWORD, CodeIntegrityCatalogOffset),
+    (DWORD, CodeIntegrityReserved),
+    (ULONGLONG, GuardAddressTakenIatEntryTable),
+    (ULONGLONG, GuardAddressTakenIatEntryCount),
+    (ULONGLONG, GuardLongJumpTargetTable),
+    (ULONGLONG, GuardLongJumpTargetCount));
+};
+#pragma pack(pop)
+
+/**
+ * @brief Struct that represents the load config directory of PE32 files, the
+ * addresses are 32 bit values and `ProcessHeapFlags` comes before
+ * `ProcessAffinityMask`
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_LOAD_CONFIG_DIRECTORY32
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_LOAD_CONFIG_DIRECTORY32,
+    (DWORD, Size),
+    (DWORD, TimeDateStamp),
+    (WORD, MajorVersion),
+    (WORD, MinorVersion),
+    (DWORD, GlobalFlagsClear),
+    (DWORD, GlobalFlagsSet),
+    (DWORD, CriticalSectionDefaultTimeout),
+    (DWORD, DeCommitFreeBlockThreshold),
+    (DWORD, DeCommitTotalFreeThreshold),
+    (DWORD, LockPrefixTable),
+    (DWORD, MaximumAllocationSize),
+    (DWORD, VirtualMemoryThreshold),
+    (DWORD, ProcessHeapFlags),
+    (DWORD, ProcessAffinityMask),
+    (WORD, CSDVersion),
+    (WORD, DependentLoadFlags),
+    (DWORD, EditList),
+    (DWORD, SecurityCookie),
+    (DWORD, SEHandlerTable),
+    (DWORD, SEHandlerCount),
+    (DWORD, GuardCFCheckFunctionPointer),
+    (DWORD, GuardCFDispatchFunctionPointer),
+    (DWORD, GuardCFFunctionTable),
+    (DWORD, GuardCFFunctionCount),
+    (DWORD, GuardFlags),
+    (WORD, CodeIntegrityFlags),
+    (WORD, CodeIntegrityCatalog),
+    (DWORD, CodeIntegrityCatalogOffset),
+    (DWORD, CodeIntegrityReserved),
+    (DWORD, GuardAddressTakenIatEntryTable),
+    (DWORD, GuardAddressTakenIatEntryCount),
+    (DWORD, GuardLongJumpTargetTable),
+    (DWORD, GuardLongJumpTargetCount));
+};
+#pragma pack(pop)
+
+/**
+ * @brief Struct that represents the TLS directory of PE32+ files
+ *
+ * The fields except the last two are virtual addresses, `AddressOfCallBacks`
+ * points to a zero terminated array of the addresses of the TLS callbacks
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_TLS_DIRECTORY64
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_TLS_DIRECTORY64,
+    (ULONGLONG, StartAddressOfRawData),
+    (ULONGLONG, EndAddressOfRawData),
+    (ULONGLONG, AddressOfIndex),
+    (ULONGLONG, AddressOfCallBacks),
+    (DWORD, SizeOfZeroFill),
+    (DWORD, Characteristics));
+};
+#pragma pack(pop)
+
+/**
+ * @brief Struct that represents the TLS directory of PE32 files
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_TLS_DIRECTORY32
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_TLS_DIRECTORY32,
+    (DWORD, StartAddressOfRawData),
+    (DWORD, EndAddressOfRawData),
+    (DWORD, AddressOfIndex),
+    (DWORD, AddressOfCallBacks),
+    (DWORD, SizeOfZeroFill),
+    (DWORD, Characteristics));
+};
+#pragma pack(pop)
+
+/**
+ * @brief Struct that represents the CLI header of .NET assemblies (data
+ * directory 14)
+ *
+ * The directories of the header are stored as RVA and size pairs, the
+ * metadata is at `MetaDataVirtualAddress`
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_COR20_HEADER
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_COR20_HEADER,
+    (DWORD, cb),
+    (WORD, MajorRuntimeVersion),
+    (WORD, MinorRuntimeVersion),
+    (DWORD, MetaDataVirtualAddress),
+    (DWORD, MetaDataSize),
+    (DWORD, Flags),
+    (DWORD, EntryPointToken),
+    (DWORD, ResourcesVirtualAddress),
+    (DWORD, ResourcesSize),
+    (DWORD, StrongNameSignatureVirtualAddress),
+    (DWORD, StrongNameSignatureSize),
+    (DWORD, CodeManagerTableVirtualAddress),
+    (DWORD, CodeManagerTableSize),
+    (DWORD, VTableFixupsVirtualAddress),
+    (DWORD, VTableFixupsSize),
+    (DWORD, ExportAddressTableJumpsVirtualAddress),
+    (DWORD, ExportAddressTableJumpsSize),
+    (DWORD, ManagedNativeHeaderVirtualAddress),
+    (DWORD, ManagedNativeHeaderSize));
+};
+#pragma pack(pop)
+
+/* Flags of the CLI header */
+inline constexpr DWORD COMIMAGE_FLAGS_ILONLY{ 0x1 };
+inline constexpr DWORD COMIMAGE_FLAGS_32BITREQUIRED{ 0x2 };
+inline constexpr DWORD COMIMAGE_FLAGS_IL_LIBRARY{ 0x4 };
+inline constexpr DWORD COMIMAGE_FLAGS_STRONGNAMESIGNED{ 0x8 };
+inline constexpr DWORD COMIMAGE_FLAGS_NATIVE_ENTRYPOINT{
+  0x10
+}; /**< EntryPointToken is an RVA instead of a MethodDef token */
+inline constexpr DWORD COMIMAGE_FLAGS_TRACKDEBUGDATA{ 0x10000 };
+inline constexpr DWORD COMIMAGE_FLAGS_32BITPREFERRED{ 0x20000 };
+
+/* GuardFlags of the load config directory */
+inline constexpr DWORD IMAGE_GUARD_CF_INSTRUMENTED{ 0x100 }; /**< /guard:cf */
+inline constexpr DWORD IMAGE_GUARD_CFW_INSTRUMENTED{ 0x200 };
+inline constexpr DWORD IMAGE_GUARD_CF_FUNCTION_TABLE_PRESENT{ 0x400 };
+inline constexpr DWORD IMAGE_GUARD_SECURITY_COOKIE_UNUSED{ 0x800 };
+inline constexpr DWORD IMAGE_GUARD_PROTECT_DELAYLOAD_IAT{ 0x1000 };
+inline constexpr DWORD IMAGE_GUARD_DELAYLOAD_IAT_IN_ITS_OWN_SECTION{ 0x2000 };
+inline constexpr DWORD IMAGE_GUARD_CF_EXPORT_SUPPRESSION_INFO_PRESENT{
+  0x4000
+};
+inline constexpr DWORD IMAGE_GUARD_CF_ENABLE_EXPORT_SUPPRESSION{ 0x8000 };
+inline constexpr DWORD IMAGE_GUARD_CF_LONGJUMP_TABLE_PRESENT{ 0x10000 };
+inline constexpr DWORD IMAGE_GUARD_CF_FUNCTION_TABLE_SIZE_MASK{
+  0xf0000000
+}; /**< Number of bytes of flags after the RVA of each entry of the guard
+      tables */
+inline constexpr DWORD IMAGE_GUARD_CF_FUNCTION_TABLE_SIZE_SHIFT{ 28 };
+
+/* Flags of the entries of the guard tables */
+inline constexpr BYTE IMAGE_GUARD_FLAG_FID_SUPPRESSED{ 0x1 }; /**< Not a valid
+                                                                 call target */
+inline constexpr BYTE IMAGE_GUARD_FLAG_EXPORT_SUPPRESSED{ 0x2 };
+inline constexpr BYTE IMAGE_GUARD_FLAG_FID_LANGEXCPTHANDLER{ 0x4 };
+inline constexpr BYTE IMAGE_GUARD_FLAG_FID_XFG{ 0x8 };
+
+
+/**
+ * @brief Image class of PE32+ (64-bit) files, selects the optional header
+ * structs when passed as template argument to `Pe`
+ *
+ */
+struct Pe32PlusClass
+{
+  using StandardFields = StandardCoffFields; /**< Standard fields */
+  using WindowsFields = WindowsSpecificFields; /**< Windows specific fields */
+  using Address = ULONGLONG; /**< Size of virtual addresses and pointers */
+  using LoadConfigDirectory = IMAGE_LOAD_CONFIG_DIRECTORY64; /**< Load config */
+  using TlsDirectory = IMAGE_TLS_DIRECTORY64; /**< TLS directory */
+
+  static constexpr WORD magic{ 0x20b }; /**< Magic of the optional header */
+};
+
+/**
+ * @brief Image class of PE32 (32-bit) files, selects the optional header
+ * structs when passed as template argument to `Pe`
+ *
+ */
+struct Pe32Class
+{
+  using StandardFields = StandardCoffFields32; /**< Standard fields */
+  using WindowsFields = WindowsSpecificFields32; /**< Windows specific fields */
+  using Address = DWORD; /**< Size of virtual addresses and pointers */
+  using LoadConfigDirectory = IMAGE_LOAD_CONFIG_DIRECTORY32; /**< Load config */
+  using TlsDirectory = IMAGE_TLS_DIRECTORY32; /**< TLS directory */
+
+  static constexpr WORD magic{ 0x10b }; /**< Magic of the optional header */
+};
+
+
 /**
  * @brief Struct that wraps the Optional header
  *
+ * @tparam Class Image class (`Pe32PlusClass` or `Pe32Class`)
  */
-struct OptionalHeader
+template<class Class> struct BasicOptionalHeader
 {
-  StandardCoffFields mScf{};
-  WindowsSpecificFields mWsf{};
+  typename Class::StandardFields mScf{};
+  typename Class::WindowsFields mWsf{};
   std::array<IMAGE_DATA_DIRECTORY, IMAGE_NUMBER_OF_DIRECTORY_ENTRIES>
     mDataDirectories{};
 };
 
+/** @brief Optional header of PE32+ files */
+using OptionalHeader = BasicOptionalHeader<Pe32PlusClass>;
+
 
 /**
  * @brief Struct that wraps all Headers of a Pe file (both Coff Header and
  * Optional Header)
  *
+ * @tparam Class Image class (`Pe32PlusClass` or `Pe32Class`)
  */
-struct PeHeaders
+template<class Class> struct BasicPeHeaders
 {
   IMAGE_FILE_HEADER
   mCoffHeader{}; /**< Struct that represents the coff header */
-  OptionalHeader mOptionalHeader; /**< Struct that represents the
-                                    optional header */
+  BasicOptionalHeader<Class> mOptionalHeader; /**< Struct that represents the
+                                                optional header */
 
   /* Methods to make access to headers more readable for the user */
 
@@ -176,7 +500,7 @@ struct PeHeaders
    * @return Returns the struct `OptionalHeader`
    */
   [[nodiscard]] constexpr auto getOptionalHeader() const noexcept
-    -> OptionalHeader
+    -> BasicOptionalHeader<Class>
   {
     return mOptionalHeader;
   }
@@ -184,10 +508,11 @@ struct PeHeaders
   /**
    * @brief Get the Standard Coff Fields object
    *
-   * @return Returns the struct `StandardCoffFields`
+   * @return Returns the struct `StandardCoffFields` (`StandardCoffFields32`
+   * for PE32 files)
    */
   [[nodiscard]] constexpr auto getStandardCoffFields() const noexcept
-    -> StandardCoffFields
+    -> typename Class::StandardFields
   {
     return mOptionalHeader.mScf;
   }
@@ -196,9 +521,10 @@ struct PeHeaders
    * @brief Get the Windows Specific Fields object
    *
    * @return Returns the struct `WindowsSpecificFields`
+   * (`WindowsSpecificFields32` for PE32 files)
    */
   [[nodiscard]] constexpr auto getWindowsSpecificFields() const noexcept
-    -> WindowsSpecificFields
+    -> typename Class::WindowsFields
   {
     return mOptionalHeader.mWsf;
   }
@@ -213,12 +539,15 @@ struct PeHeaders
   }
 };
 
+/** @brief Headers of PE32+ files */
+using PeHeaders = BasicPeHeaders<Pe32PlusClass>;
+
 #pragma pack(push, 1)
 struct IMAGE_SECTION_HEADER
 {
   BOOST_HANA_DEFINE_STRUCT(IMAGE_SECTION_HEADER,
     (ULONGLONG, Name),
-    (ULONGLONG, PhysAddressAndVirtSize),
+    (DWORD, PhysAddressAndVirtSize),
     (DWORD, VirtualAddress),
     (DWORD, SizeOfRawData),
     (DWORD, PointerToRawData),
@@ -231,6 +560,350 @@ struct IMAGE_SECTION_HEADER
 #pragma pack(pop)
 
 
+/**
+ * @brief Struct that represents an entry of the exception directory (`.pdata`)
+ * of x64 images
+ *
+ * The entries are sorted by `BeginAddress`, all the fields are RVAs
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_RUNTIME_FUNCTION_ENTRY
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_RUNTIME_FUNCTION_ENTRY,
+    (DWORD, BeginAddress),
+    (DWORD, EndAddress),
+    (DWORD, UnwindInfoAddress));
+};
+#pragma pack(pop)
+
+/**
+ * @brief Struct that represents the export directory of an image
+ *
+ * `AddressOfFunctions` is the RVA of the export address table, indexed by
+ * ordinal - `Base`. `AddressOfNames` is the RVA of the sorted table of the
+ * RVAs of the names and `AddressOfNameOrdinals` the RVA of the table of
+ * their indexes in the export address table
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_EXPORT_DIRECTORY
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_EXPORT_DIRECTORY,
+    (DWORD, Characteristics),
+    (DWORD, TimeDateStamp),
+    (WORD, MajorVersion),
+    (WORD, MinorVersion),
+    (DWORD, Name),
+    (DWORD, Base),
+    (DWORD, NumberOfFunctions),
+    (DWORD, NumberOfNames),
+    (DWORD, AddressOfFunctions),
+    (DWORD, AddressOfNames),
+    (DWORD, AddressOfNameOrdinals));
+};
+#pragma pack(pop)
+
+/**
+ * @brief Struct that represents the import descriptor of a DLL
+ *
+ * `OriginalFirstThunk` is the RVA of the import lookup table (the names),
+ * `FirstThunk` the RVA of the import address table that the loader fills in.
+ * The table of descriptors ends at a zero descriptor
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_IMPORT_DESCRIPTOR
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_IMPORT_DESCRIPTOR,
+    (DWORD, OriginalFirstThunk),
+    (DWORD, TimeDateStamp),
+    (DWORD, ForwarderChain),
+    (DWORD, Name),
+    (DWORD, FirstThunk));
+};
+#pragma pack(pop)
+
+/**
+ * @brief Struct that represents the delay load descriptor of a DLL
+ *
+ * The DLL is loaded by the delay load helper the first time one of its
+ * functions is called. If `Attributes` has `dlattrRva` the addresses are
+ * RVAs, otherwise they're virtual addresses (Visual C++ 6 and older). The
+ * table of descriptors ends at a zero descriptor
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_DELAYLOAD_DESCRIPTOR
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_DELAYLOAD_DESCRIPTOR,
+    (DWORD, Attributes),
+    (DWORD, DllNameRVA),
+    (DWORD, ModuleHandleRVA),
+    (DWORD, ImportAddressTableRVA),
+    (DWORD, ImportNameTableRVA),
+    (DWORD, BoundImportAddressTableRVA),
+    (DWORD, UnloadInformationTableRVA),
+    (DWORD, TimeDateStamp));
+};
+#pragma pack(pop)
+
+/** @brief The addresses of an IMAGE_DELAYLOAD_DESCRIPTOR are RVAs */
+inline constexpr DWORD dlattrRva{ 0x1 };
+
+/**
+ * @brief Struct that represents a DLL of the bound import directory
+ *
+ * `TimeDateStamp` is the time stamp of the DLL the image was bound against,
+ * `OffsetModuleName` is relative to the beginning of the directory. It's
+ * followed by `NumberOfModuleForwarderRefs` IMAGE_BOUND_FORWARDER_REF
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_BOUND_IMPORT_DESCRIPTOR
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_BOUND_IMPORT_DESCRIPTOR,
+    (DWORD, TimeDateStamp),
+    (WORD, OffsetModuleName),
+    (WORD, NumberOfModuleForwarderRefs));
+};
+#pragma pack(pop)
+
+/**
+ * @brief Struct that represents a DLL that a bound DLL forwards functions to
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_BOUND_FORWARDER_REF
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_BOUND_FORWARDER_REF,
+    (DWORD, TimeDateStamp),
+    (WORD, OffsetModuleName),
+    (WORD, Reserved));
+};
+#pragma pack(pop)
+
+/**
+ * @brief Struct that represents an entry of the debug directory
+ *
+ * The data of the entry is at `AddressOfRawData` (an RVA) once mapped and at
+ * `PointerToRawData` in the file, both are 0 for entries without data
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_DEBUG_DIRECTORY
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_DEBUG_DIRECTORY,
+    (DWORD, Characteristics),
+    (DWORD, TimeDateStamp),
+    (WORD, MajorVersion),
+    (WORD, MinorVersion),
+    (DWORD, Type),
+    (DWORD, SizeOfData),
+    (DWORD, AddressOfRawData),
+    (DWORD, PointerToRawData));
+};
+#pragma pack(pop)
+
+/* Types of the entries of the debug directory */
+inline constexpr DWORD IMAGE_DEBUG_TYPE_UNKNOWN{ 0 };
+inline constexpr DWORD IMAGE_DEBUG_TYPE_COFF{ 1 };
+inline constexpr DWORD IMAGE_DEBUG_TYPE_CODEVIEW{ 2 }; /**< PDB reference */
+inline constexpr DWORD IMAGE_DEBUG_TYPE_FPO{ 3 };
+inline constexpr DWORD IMAGE_DEBUG_TYPE_MISC{ 4 };
+inline constexpr DWORD IMAGE_DEBUG_TYPE_EXCEPTION{ 5 };
+inline constexpr DWORD IMAGE_DEBUG_TYPE_FIXUP{ 6 };
+inline constexpr DWORD IMAGE_DEBUG_TYPE_BORLAND{ 9 };
+inline constexpr DWORD IMAGE_DEBUG_TYPE_CLSID{ 11 };
+inline constexpr DWORD IMAGE_DEBUG_TYPE_VC_FEATURE{ 12 };
+inline constexpr DWORD IMAGE_DEBUG_TYPE_POGO{ 13 }; /**< Profile guided
+                                                       optimization */
+inline constexpr DWORD IMAGE_DEBUG_TYPE_ILTCG{ 14 };
+inline constexpr DWORD IMAGE_DEBUG_TYPE_REPRO{ 16 }; /**< Deterministic build */
+inline constexpr DWORD IMAGE_DEBUG_TYPE_EX_DLLCHARACTERISTICS{ 20 };
+
+/**
+ * @brief Struct that represents a directory of the resource tree
+ *
+ * It's followed by `NumberOfNamedEntries` entries with a name, sorted by name,
+ * and `NumberOfIdEntries` entries with an ID, sorted by ID. Each entry is a
+ * pair of DWORDs, the name or ID and the offset of a subdirectory or of an
+ * IMAGE_RESOURCE_DATA_ENTRY
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_RESOURCE_DIRECTORY
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_RESOURCE_DIRECTORY,
+    (DWORD, Characteristics),
+    (DWORD, TimeDateStamp),
+    (WORD, MajorVersion),
+    (WORD, MinorVersion),
+    (WORD, NumberOfNamedEntries),
+    (WORD, NumberOfIdEntries));
+};
+#pragma pack(pop)
+
+/**
+ * @brief Struct that represents a leaf of the resource tree
+ *
+ * `OffsetToData` is an RVA, unlike the offsets of the directories
+ *
+ */
+#pragma pack(push, 1)
+struct IMAGE_RESOURCE_DATA_ENTRY
+{
+  BOOST_HANA_DEFINE_STRUCT(IMAGE_RESOURCE_DATA_ENTRY,
+    (DWORD, OffsetToData),
+    (DWORD, Size),
+    (DWORD, CodePage),
+    (DWORD, Reserved));
+};
+#pragma pack(pop)
+
+/* Flags of the entries of a resource directory */
+inline constexpr DWORD IMAGE_RESOURCE_NAME_IS_STRING{
+  0x80000000
+}; /**< The name is the offset of a counted UTF-16 string */
+inline constexpr DWORD IMAGE_RESOURCE_DATA_IS_DIRECTORY{
+  0x80000000
+}; /**< The entry points to a subdirectory */
+
+/* Predefined resource types */
+inline constexpr WORD RT_CURSOR{ 1 };
+inline constexpr WORD RT_BITMAP{ 2 };
+inline constexpr WORD RT_ICON{ 3 };
+inline constexpr WORD RT_MENU{ 4 };
+inline constexpr WORD RT_DIALOG{ 5 };
+inline constexpr WORD RT_STRING{ 6 }; /**< Blocks of 16 strings */
+inline constexpr WORD RT_FONTDIR{ 7 };
+inline constexpr WORD RT_FONT{ 8 };
+inline constexpr WORD RT_ACCELERATOR{ 9 };
+inline constexpr WORD RT_RCDATA{ 10 }; /**< Raw data */
+inline constexpr WORD RT_MESSAGETABLE{ 11 };
+inline constexpr WORD RT_GROUP_CURSOR{ 12 };
+inline constexpr WORD RT_GROUP_ICON{ 14 };
+inline constexpr WORD RT_VERSION{ 16 }; /**< VS_VERSIONINFO */
+inline constexpr WORD RT_DLGINCLUDE{ 17 };
+inline constexpr WORD RT_PLUGPLAY{ 19 };
+inline constexpr WORD RT_VXD{ 20 };
+inline constexpr WORD RT_ANICURSOR{ 21 };
+inline constexpr WORD RT_ANIICON{ 22 };
+inline constexpr WORD RT_HTML{ 23 };
+inline constexpr WORD RT_MANIFEST{ 24 }; /**< Side-by-side assembly manifest */
+
+/**
+ * @brief Struct that represents the fixed part of a VS_VERSIONINFO resource
+ *
+ * The versions are split in two DWORDs, e.g. 1.2.3.4 is 0x00010002 and
+ * 0x00030004
+ *
+ */
+#pragma pack(push, 1)
+struct VS_FIXEDFILEINFO
+{
+  BOOST_HANA_DEFINE_STRUCT(VS_FIXEDFILEINFO,
+    (DWORD, dwSignature),
+    (DWORD, dwStrucVersion),
+    (DWORD, dwFileVersionMS),
+    (DWORD, dwFileVersionLS),
+    (DWORD, dwProductVersionMS),
+    (DWORD, dwProductVersionLS),
+    (DWORD, dwFileFlagsMask),
+    (DWORD, dwFileFlags),
+    (DWORD, dwFileOS),
+    (DWORD, dwFileType),
+    (DWORD, dwFileSubtype),
+    (DWORD, dwFileDateMS),
+    (DWORD, dwFileDateLS));
+};
+#pragma pack(pop)
+
+inline constexpr DWORD VS_FFI_SIGNATURE{
+  0xfeef04bd
+}; /**< dwSignature of VS_FIXEDFILEINFO */
+
+/* Flags of VS_FIXEDFILEINFO */
+inline constexpr DWORD VS_FF_DEBUG{ 0x01 };
+inline constexpr DWORD VS_FF_PRERELEASE{ 0x02 };
+inline constexpr DWORD VS_FF_PATCHED{ 0x04 };
+inline constexpr DWORD VS_FF_PRIVATEBUILD{ 0x08 };
+inline constexpr DWORD VS_FF_INFOINFERRED{ 0x10 };
+inline constexpr DWORD VS_FF_SPECIALBUILD{ 0x20 };
+
+/* File types of VS_FIXEDFILEINFO */
+inline constexpr DWORD VFT_UNKNOWN{ 0 };
+inline constexpr DWORD VFT_APP{ 1 };
+inline constexpr DWORD VFT_DLL{ 2 };
+inline constexpr DWORD VFT_DRV{ 3 };
+inline constexpr DWORD VFT_FONT{ 4 };
+inline constexpr DWORD VFT_VXD{ 5 };
+inline constexpr DWORD VFT_STATIC_LIB{ 7 };
+
+/* Operating systems of VS_FIXEDFILEINFO */
+inline constexpr DWORD VOS_NT{ 0x40000 };
+inline constexpr DWORD VOS_NT_WINDOWS32{ 0x40004 };
+
+/* Sizes of the records of the COFF symbol table */
+inline constexpr std::size_t IMAGE_SIZEOF_SYMBOL{ 18 }; /**< IMAGE_SYMBOL */
+inline constexpr std::size_t IMAGE_SIZEOF_SYMBOL_EX{
+  20
+}; /**< IMAGE_SYMBOL_EX, used by /bigobj object files */
+
+/* Special section numbers of symbols */
+inline constexpr std::int32_t IMAGE_SYM_UNDEFINED{ 0 }; /**< External symbol */
+inline constexpr std::int32_t IMAGE_SYM_ABSOLUTE{ -1 }; /**< Absolute value */
+inline constexpr std::int32_t IMAGE_SYM_DEBUG{ -2 }; /**< Debugging symbol */
+
+/* Complex type of a symbol, stored in bits 4-5 of its type */
+inline constexpr WORD IMAGE_SYM_DTYPE_FUNCTION{ 2 }; /**< Function */
+
+/* Storage classes of symbols */
+inline constexpr BYTE IMAGE_SYM_CLASS_EXTERNAL{ 2 };
+inline constexpr BYTE IMAGE_SYM_CLASS_STATIC{ 3 };
+inline constexpr BYTE IMAGE_SYM_CLASS_LABEL{ 6 };
+inline constexpr BYTE IMAGE_SYM_CLASS_FUNCTION{ 101 }; /**< .bf and .ef */
+inline constexpr BYTE IMAGE_SYM_CLASS_FILE{ 103 }; /**< Source file */
+inline constexpr BYTE IMAGE_SYM_CLASS_SECTION{ 104 };
+inline constexpr BYTE IMAGE_SYM_CLASS_WEAK_EXTERNAL{ 105 };
+inline constexpr BYTE IMAGE_SYM_CLASS_CLR_TOKEN{ 107 };
+
+/* COMDAT selection of the section definition auxiliary records */
+inline constexpr BYTE IMAGE_COMDAT_SELECT_NODUPLICATES{ 1 };
+inline constexpr BYTE IMAGE_COMDAT_SELECT_ANY{ 2 };
+inline constexpr BYTE IMAGE_COMDAT_SELECT_SAME_SIZE{ 3 };
+inline constexpr BYTE IMAGE_COMDAT_SELECT_EXACT_MATCH{ 4 };
+inline constexpr BYTE IMAGE_COMDAT_SELECT_ASSOCIATIVE{ 5 };
+inline constexpr BYTE IMAGE_COMDAT_SELECT_LARGEST{ 6 };
+
+/* Search of the weak external auxiliary records */
+inline constexpr DWORD IMAGE_WEAK_EXTERN_SEARCH_NOLIBRARY{ 1 };
+inline constexpr DWORD IMAGE_WEAK_EXTERN_SEARCH_LIBRARY{ 2 };
+inline constexpr DWORD IMAGE_WEAK_EXTERN_SEARCH_ALIAS{ 3 };
+
+/* Flags of UNWIND_INFO */
+inline constexpr BYTE UNW_FLAG_NHANDLER{ 0x0 }; /**< No handler */
+inline constexpr BYTE UNW_FLAG_EHANDLER{ 0x1 }; /**< Exception handler */
+inline constexpr BYTE UNW_FLAG_UHANDLER{ 0x2 }; /**< Termination handler */
+inline constexpr BYTE UNW_FLAG_CHAININFO{
+  0x4
+}; /**< The unwind info is followed by the RUNTIME_FUNCTION of the primary
+      function */
+
+/* Operations of the unwind codes of UNWIND_INFO */
+inline constexpr BYTE UWOP_PUSH_NONVOL{ 0 };
+inline constexpr BYTE UWOP_ALLOC_LARGE{ 1 };
+inline constexpr BYTE UWOP_ALLOC_SMALL{ 2 };
+inline constexpr BYTE UWOP_SET_FPREG{ 3 };
+inline constexpr BYTE UWOP_SAVE_NONVOL{ 4 };
+inline constexpr BYTE UWOP_SAVE_NONVOL_FAR{ 5 };
+inline constexpr BYTE UWOP_EPILOG{ 6 }; /**< UWOP_SAVE_XMM in version 1 */
+inline constexpr BYTE UWOP_SPARE_CODE{ 7 }; /**< UWOP_SAVE_XMM_FAR in version 1 */
+inline constexpr BYTE UWOP_SAVE_XMM128{ 8 };
+inline constexpr BYTE UWOP_SAVE_XMM128_FAR{ 9 };
+inline constexpr BYTE UWOP_PUSH_MACHFRAME{ 10 };
+
+
 }// namespace pelf
 
 #endif
@@ -0,0 +1,400 @@
+/** @file peUnwind.h
+ *  @brief ExceptionTable class and UNWIND_INFO decoder declarations
+ *
+ *  This file contains an accessor to the exception directory (`.pdata`) of
+ *  x64 images, a table of `IMAGE_RUNTIME_FUNCTION_ENTRY` sorted by address
+ *  that gives the boundaries of every non-leaf function, and a decoder of the
+ *  `UNWIND_INFO` structures the entries point to. Both read the bytes of the
+ *  file in place
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PEUNWIND_H_
+#define PEUNWIND_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+
+#include "Pelf.h"
+#include "peStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief Exception directory of an x64 image
+ *
+ *  Entries are decoded from the bytes of the directory when they're
+ *  accessed, `find()` is a binary search that reads O(log n) of them
+ * */
+class ExceptionTable
+{
+public:
+  static constexpr std::size_t entrySize{ 12 }; /**< Size of an
+                                                   IMAGE_RUNTIME_FUNCTION_ENTRY */
+
+  constexpr ExceptionTable() = default;
+
+  /** @brief ExceptionTable constructor
+   *
+   *  @param data Bytes of the exception directory, a trailing partial entry is
+   *  ignored
+   * */
+  constexpr explicit ExceptionTable(std::span<const unsigned char> data) noexcept;
+
+  /** @brief Returns the number of entries */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t;
+
+  /** @brief Returns `true` if the table has no entries */
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool;
+
+  /** @brief Returns the entry `index`, it throws `PelfException` if it's out of
+   * range */
+  [[nodiscard]] constexpr auto entry(std::size_t index) const
+    -> IMAGE_RUNTIME_FUNCTION_ENTRY;
+
+  /** @brief Returns the entry of the function that contains `rva`
+   *
+   *  @return Entry, `std::nullopt` if `rva` is in a leaf function (they don't
+   *  have an entry) or outside of the code
+   * */
+  [[nodiscard]] constexpr auto find(DWORD rva) const
+    -> std::optional<IMAGE_RUNTIME_FUNCTION_ENTRY>;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the directory */
+};
+
+
+/** @brief An unwind code decoded by `UnwindCodeIterator` */
+struct UnwindCode
+{
+  BYTE codeOffset{}; /**< Offset in the prolog of the end of the instruction */
+  BYTE operation{}; /**< UWOP_* */
+  BYTE info{}; /**< Operation info, the register for pushes and saves */
+  DWORD value{}; /**< Allocation size for UWOP_ALLOC_*, stack offset for
+                    UWOP_SAVE_*, the raw next slots for the other operations
+                    that have them */
+  BYTE slots{}; /**< Number of 2 byte slots used by the code */
+};
+
+
+/** @brief Forward iterator over the unwind codes of an `UNWIND_INFO` */
+class UnwindCodeIterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = UnwindCode;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const UnwindCode*;
+  using reference = const UnwindCode&;
+
+  /** @brief Constructs the end iterator */
+  constexpr UnwindCodeIterator() = default;
+
+  /** @brief UnwindCodeIterator constructor
+   *
+   *  @param slots Slots of the unwind codes, 2 bytes each
+   * */
+  constexpr explicit UnwindCodeIterator(std::span<const unsigned char> slots);
+
+  [[nodiscard]] constexpr auto operator*() const noexcept -> reference;
+
+  [[nodiscard]] constexpr auto operator->() const noexcept -> pointer;
+
+  constexpr auto operator++() -> UnwindCodeIterator&;
+
+  constexpr auto operator++(int) -> UnwindCodeIterator;
+
+  [[nodiscard]] constexpr auto operator==(const UnwindCodeIterator& other) const
+    noexcept -> bool;
+
+private:
+  std::span<const unsigned char> mSlots; /**< Slots from the current code */
+  UnwindCode mCode{}; /**< Current code */
+
+  /** @brief Decodes the code at the beginning of `mSlots`, it throws
+   * `PelfException` if it's truncated or the operation is unknown */
+  constexpr auto load() -> void;
+};
+
+
+/** @brief Range of the unwind codes of an `UNWIND_INFO`, in reverse order of
+ * the prolog instructions */
+class UnwindCodeRange
+{
+public:
+  /** @brief UnwindCodeRange constructor
+   *
+   *  @param slots Slots of the unwind codes
+   * */
+  constexpr explicit UnwindCodeRange(std::span<const unsigned char> slots) noexcept;
+
+  [[nodiscard]] constexpr auto begin() const -> UnwindCodeIterator;
+
+  [[nodiscard]] constexpr auto end() const noexcept -> UnwindCodeIterator;
+
+private:
+  std::span<const unsigned char> mSlots; /**< Slots of the codes */
+};
+
+
+/** @brief Decoded `UNWIND_INFO`
+ *
+ *  `codeSlots` and `handlerData` point into the data of the file
+ * */
+struct UnwindInfo
+{
+  BYTE version{}; /**< 1, or 2 for images with epilog codes */
+  BYTE flags{}; /**< UNW_FLAG_* */
+  BYTE sizeOfProlog{}; /**< Bytes of the prolog */
+  BYTE countOfCodes{}; /**< Number of slots of the unwind codes */
+  BYTE frameRegister{}; /**< Frame pointer register, zero if there isn't one */
+  BYTE frameOffset{}; /**< Offset of the frame pointer from RSP, scaled by
+                         16 */
+  std::span<const unsigned char> codeSlots; /**< Unwind codes, 2 bytes per
+                                               slot */
+  DWORD handler{}; /**< RVA of the exception/termination handler, zero if
+                      there isn't one */
+  std::span<const unsigned char> handlerData; /**< Bytes after the handler
+                                                 RVA up to the end of the
+                                                 section, their layout is
+                                                 defined by the handler */
+  std::optional<IMAGE_RUNTIME_FUNCTION_ENTRY> chained; /**< Entry of the
+                                                          primary function
+                                                          (UNW_FLAG_CHAININFO) */
+
+  /** @brief Returns the decoded unwind codes */
+  [[nodiscard]] constexpr auto codes() const noexcept -> UnwindCodeRange;
+};
+
+
+/** @brief Decodes an `UNWIND_INFO`
+ *
+ *  @param data Bytes from the RVA of the unwind info to the end of its section
+ *
+ *  @return UnwindInfo, it throws `PelfException` if the version is unknown or
+ *  the structure exceeds `data`
+ * */
+constexpr auto decodeUnwindInfo(std::span<const unsigned char> data)
+  -> UnwindInfo;
+
+
+constexpr ExceptionTable::ExceptionTable(std::span<const unsigned char> data) noexcept
+  : mData(data.first(data.size() - data.size() % entrySize))
+{}
+
+constexpr auto ExceptionTable::size() const noexcept -> std::size_t
+{
+  return mData.size() / entrySize;
+}
+
+constexpr auto ExceptionTable::empty() const noexcept -> bool
+{
+  return mData.empty();
+}
+
+constexpr auto ExceptionTable::entry(std::size_t index) const
+  -> IMAGE_RUNTIME_FUNCTION_ENTRY
+{
+  if (index >= size()) {
+    throw PelfException{ "Invalid index, out of the exception table" };
+  }
+
+  return readStruct<IMAGE_RUNTIME_FUNCTION_ENTRY>(mData, index * entrySize);
+}
+
+constexpr auto ExceptionTable::find(DWORD rva) const
+  -> std::optional<IMAGE_RUNTIME_FUNCTION_ENTRY>
+{
+  /* Last entry whose BeginAddress is <= rva, only that field is read */
+  std::size_t first{};
+  std::size_t last{ size() };
+  while (first < last) {
+    const std::size_t middle = first + (last - first) / 2;
+    if (readInteger<DWORD>(mData, middle * entrySize) <= rva) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+
+  if (first == 0) { return std::nullopt; }
+
+  const auto function = entry(first - 1);
+  if (rva >= function.EndAddress) { return std::nullopt; }
+
+  return function;
+}
+
+
+constexpr UnwindCodeIterator::UnwindCodeIterator(
+  std::span<const unsigned char> slots)
+  : mSlots(slots)
+{
+  load();
+}
+
+constexpr auto UnwindCodeIterator::operator*() const noexcept -> reference
+{
+  return mCode;
+}
+
+constexpr auto UnwindCodeIterator::operator->() const noexcept -> pointer
+{
+  return &mCode;
+}
+
+constexpr auto UnwindCodeIterator::operator++() -> UnwindCodeIterator&
+{
+  mSlots = mSlots.subspan(std::size_t{ mCode.slots } * 2);
+  load();
+  return *this;
+}
+
+constexpr auto UnwindCodeIterator::operator++(int) -> UnwindCodeIterator
+{
+  auto copy = *this;
+  ++*this;
+  return copy;
+}
+
+constexpr auto UnwindCodeIterator::operator==(
+  const UnwindCodeIterator& other) const noexcept -> bool
+{
+  return mSlots.data() == other.mSlots.data()
+         && mSlots.size() == other.mSlots.size();
+}
+
+constexpr auto UnwindCodeIterator::load() -> void
+{
+  if (mSlots.size() < 2) {
+    mSlots = {};
+    return;
+  }
+
+  mCode = {};
+  mCode.codeOffset = mSlots[0];
+  mCode.operation = mSlots[1] & 0x0f;
+  mCode.info = mSlots[1] >> 4;
+
+  /* Number of slots and the scale of the value in the following slots */
+  BYTE slots{ 1 };
+  DWORD scale{ 1 };
+
+  switch (mCode.operation) {
+  case UWOP_PUSH_NONVOL:
+  case UWOP_SET_FPREG:
+  case UWOP_PUSH_MACHFRAME:
+    break;
+  case UWOP_ALLOC_SMALL:
+    mCode.value = DWORD{ mCode.info } * 8 + 8;
+    break;
+  case UWOP_ALLOC_LARGE:
+    slots = mCode.info == 0 ? 2 : 3;
+    scale = mCode.info == 0 ? 8 : 1;
+    break;
+  case UWOP_SAVE_NONVOL:
+    slots = 2;
+    scale = 8;
+    break;
+  case UWOP_SAVE_XMM128:
+    slots = 2;
+    scale = 16;
+    break;
+  case UWOP_EPILOG:
+    slots = 2;
+    break;
+  case UWOP_SAVE_NONVOL_FAR:
+  case UWOP_SPARE_CODE:
+  case UWOP_SAVE_XMM128_FAR:
+    slots = 3;
+    break;
+  default:
+    throw PelfException{ "Unsupported unwind code operation" };
+  }
+
+  if (mSlots.size() < std::size_t{ slots } * 2) {
+    throw PelfException{ "Invalid unwind code, it exceeds the unwind info" };
+  }
+
+  if (slots == 2) {
+    mCode.value = readInteger<WORD>(mSlots, 2) * scale;
+  } else if (slots == 3) {
+    mCode.value = readInteger<DWORD>(mSlots, 2) * scale;
+  }
+  mCode.slots = slots;
+}
+
+
+constexpr UnwindCodeRange::UnwindCodeRange(
+  std::span<const unsigned char> slots) noexcept
+  : mSlots(slots)
+{}
+
+constexpr auto UnwindCodeRange::begin() const -> UnwindCodeIterator
+{
+  return UnwindCodeIterator{ mSlots };
+}
+
+constexpr auto UnwindCodeRange::end() const noexcept -> UnwindCodeIterator
+{
+  return {};
+}
+
+
+constexpr auto UnwindInfo::codes() const noexcept -> UnwindCodeRange
+{
+  return UnwindCodeRange{ codeSlots };
+}
+
+
+constexpr auto decodeUnwindInfo(std::span<const unsigned char> data)
+  -> UnwindInfo
+{
+  if (data.size() < 4) {
+    throw PelfException{ "Invalid unwind info, out of the bounds of the file" };
+  }
+
+  UnwindInfo info;
+  info.version = data[0] & 0x07;
+  info.flags = data[0] >> 3;
+  info.sizeOfProlog = data[1];
+  info.countOfCodes = data[2];
+  info.frameRegister = data[3] & 0x0f;
+  info.frameOffset = data[3] >> 4;
+
+  if (info.version != 1 && info.version != 2) {
+    throw PelfException{ "Unsupported unwind info version" };
+  }
+
+  /* The array of codes always has an even number of slots */
+  const std::size_t codes_size = std::size_t{ info.countOfCodes } * 2;
+  const std::size_t end = 4 + ((std::size_t{ info.countOfCodes } + 1) & ~std::size_t{ 1 }) * 2;
+
+  if (data.size() < 4 + codes_size) {
+    throw PelfException{ "Invalid unwind info, the codes exceed the section" };
+  }
+  info.codeSlots = data.subspan(4, codes_size);
+
+  if ((info.flags & UNW_FLAG_CHAININFO) != 0) {
+    info.chained = readStruct<IMAGE_RUNTIME_FUNCTION_ENTRY>(data, end);
+  } else if ((info.flags & (UNW_FLAG_EHANDLER | UNW_FLAG_UHANDLER)) != 0) {
+    info.handler = readInteger<DWORD>(data, end);
+    info.handlerData = data.subspan(end + sizeof(DWORD));
+  }
+
+  return info;
+}
+
+
+}// namespace pelf
+
+
+#endif
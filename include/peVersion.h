@@ -0,0 +1,502 @@
+/** @file peVersion.h
+ *  @brief VS_VERSIONINFO decoder declarations
+ *
+ *  This file contains a decoder of version resources (RT_VERSION): the
+ *  `VS_FIXEDFILEINFO` with the binary versions and the string tables of
+ *  `StringFileInfo` (FileVersion, ProductName...). The resource is a tree of
+ *  blocks with a UTF-16 key, a value and children, they're read in place and
+ *  the strings are `Utf16View`s of the file
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PEVERSION_H_
+#define PEVERSION_H_
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "Pelf.h"
+#include "peResources.h"
+#include "peStructs.h"
+
+
+namespace pelf {
+
+
+class VersionBlockIterator;
+
+
+/** @brief A block of a version resource
+ *
+ *  Every block starts with its length, the length of its value, its type and
+ *  a NUL terminated key, the value and each child are aligned to 4 bytes from
+ *  the beginning of the resource
+ * */
+class VersionBlock
+{
+public:
+  /** @brief Constructs an empty block without children */
+  constexpr VersionBlock() = default;
+
+  /** @brief VersionBlock constructor
+   *
+   *  @param data Bytes from the beginning of the block, it throws
+   *  `PelfException` if the block exceeds them or its key isn't terminated
+   * */
+  constexpr explicit VersionBlock(std::span<const unsigned char> data);
+
+  /** @brief Returns the length of the block, children included */
+  [[nodiscard]] constexpr auto length() const noexcept -> std::size_t;
+
+  /** @brief Returns the type, 1 for text values and 0 for binary values */
+  [[nodiscard]] constexpr auto type() const noexcept -> WORD;
+
+  /** @brief Returns the key */
+  [[nodiscard]] constexpr auto key() const noexcept -> Utf16View;
+
+  /** @brief Returns the bytes of the value */
+  [[nodiscard]] constexpr auto value() const noexcept
+    -> std::span<const unsigned char>;
+
+  /** @brief Returns the value as a string, without the NUL terminator */
+  [[nodiscard]] constexpr auto text() const -> Utf16View;
+
+  /** @brief Finds the first child whose key is `key`
+   *
+   *  @return Child, `std::nullopt` if the block doesn't have it
+   * */
+  [[nodiscard]] constexpr auto find(std::string_view key) const
+    -> std::optional<VersionBlock>;
+
+  [[nodiscard]] constexpr auto begin() const -> VersionBlockIterator;
+
+  [[nodiscard]] constexpr auto end() const -> VersionBlockIterator;
+
+private:
+  std::span<const unsigned char> mData; /**< Bytes of the block */
+  Utf16View mKey; /**< Key */
+  std::span<const unsigned char> mValue; /**< Value */
+  std::span<const unsigned char> mChildren; /**< Children */
+  WORD mType{}; /**< wType */
+};
+
+
+/** @brief Forward iterator over the children of a `VersionBlock` */
+class VersionBlockIterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = VersionBlock;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const VersionBlock*;
+  using reference = const VersionBlock&;
+
+  /** @brief Constructs the end iterator */
+  constexpr VersionBlockIterator() = default;
+
+  /** @brief VersionBlockIterator constructor
+   *
+   *  @param children Bytes of the children, the iteration stops at the end
+   *  or at a zero length (padding)
+   * */
+  constexpr explicit VersionBlockIterator(
+    std::span<const unsigned char> children);
+
+  [[nodiscard]] constexpr auto operator*() const noexcept -> reference;
+
+  [[nodiscard]] constexpr auto operator->() const noexcept -> pointer;
+
+  constexpr auto operator++() -> VersionBlockIterator&;
+
+  constexpr auto operator++(int) -> VersionBlockIterator;
+
+  [[nodiscard]] constexpr auto operator==(
+    const VersionBlockIterator& other) const noexcept -> bool;
+
+private:
+  std::span<const unsigned char> mChildren; /**< Children from the current
+                                               one */
+  VersionBlock mBlock{}; /**< Current child */
+
+  /** @brief Decodes the child at the beginning of `mChildren` */
+  constexpr auto load() -> void;
+};
+
+
+/** @brief A version number, e.g. 1.2.3.4 */
+struct VersionNumber
+{
+  WORD major{};
+  WORD minor{};
+  WORD build{};
+  WORD revision{};
+
+  constexpr auto operator<=>(const VersionNumber&) const = default;
+};
+
+
+/** @brief A language and code page of the string tables, e.g. 0x409 and 1200
+ * (UTF-16) */
+struct Translation
+{
+  WORD language{};
+  WORD codePage{};
+
+  constexpr auto operator==(const Translation&) const -> bool = default;
+};
+
+
+/** @brief Decoded VS_VERSIONINFO resource
+ *
+ *  Only the root block is decoded by the constructor, the string tables are
+ *  searched when a string is requested
+ * */
+class VersionInfo
+{
+public:
+  /** @brief VersionInfo constructor
+   *
+   *  @param data Bytes of the resource, it throws `PelfException` if the root
+   *  block isn't a VS_VERSION_INFO
+   * */
+  constexpr explicit VersionInfo(std::span<const unsigned char> data);
+
+  /** @brief Returns the root block */
+  [[nodiscard]] constexpr auto root() const noexcept -> const VersionBlock&;
+
+  /** @brief Returns the VS_FIXEDFILEINFO, `std::nullopt` if the resource
+   * doesn't have one or its signature is wrong */
+  [[nodiscard]] constexpr auto fixedFileInfo() const
+    -> std::optional<VS_FIXEDFILEINFO>;
+
+  /** @brief Returns the binary file version of the VS_FIXEDFILEINFO */
+  [[nodiscard]] constexpr auto fileVersion() const
+    -> std::optional<VersionNumber>;
+
+  /** @brief Returns the binary product version of the VS_FIXEDFILEINFO */
+  [[nodiscard]] constexpr auto productVersion() const
+    -> std::optional<VersionNumber>;
+
+  /** @brief Returns the number of translations of VarFileInfo */
+  [[nodiscard]] constexpr auto translationCount() const -> std::size_t;
+
+  /** @brief Returns the translation `index`, it throws `PelfException` if
+   * it's out of range */
+  [[nodiscard]] constexpr auto translation(std::size_t index) const
+    -> Translation;
+
+  /** @brief Returns the StringFileInfo block, its children are the string
+   * tables. It's empty if the resource doesn't have one */
+  [[nodiscard]] constexpr auto stringFileInfo() const -> VersionBlock;
+
+  /** @brief Returns the translation of a string table from its key (e.g.
+   * "040904b0"), `std::nullopt` if the key isn't 8 hexadecimal digits */
+  [[nodiscard]] static constexpr auto tableTranslation(
+    const VersionBlock& table) -> std::optional<Translation>;
+
+  /** @brief Finds a string, e.g. "FileVersion"
+   *
+   *  The table of the first translation is searched first, like Explorer
+   *  does, then the other tables in order
+   *
+   *  @return String, `std::nullopt` if no table has it
+   * */
+  [[nodiscard]] constexpr auto string(std::string_view key) const
+    -> std::optional<Utf16View>;
+
+  /** @brief Finds a string in the table of `translation`
+   *
+   *  @return String, `std::nullopt` if the table or the string doesn't exist
+   * */
+  [[nodiscard]] constexpr auto string(std::string_view key,
+    const Translation& translation) const -> std::optional<Utf16View>;
+
+private:
+  VersionBlock mRoot; /**< VS_VERSION_INFO block */
+
+  /** @brief Returns the value of the Translation block of VarFileInfo */
+  [[nodiscard]] constexpr auto translations() const
+    -> std::span<const unsigned char>;
+};
+
+
+constexpr VersionBlockIterator::VersionBlockIterator(
+  std::span<const unsigned char> children)
+  : mChildren(children)
+{
+  load();
+}
+
+constexpr auto VersionBlockIterator::operator*() const noexcept -> reference
+{
+  return mBlock;
+}
+
+constexpr auto VersionBlockIterator::operator->() const noexcept -> pointer
+{
+  return &mBlock;
+}
+
+constexpr auto VersionBlockIterator::operator++() -> VersionBlockIterator&
+{
+  const std::size_t next = (mBlock.length() + 3) & ~std::size_t{ 3 };
+  mChildren = mChildren.subspan(std::min(next, mChildren.size()));
+  load();
+  return *this;
+}
+
+constexpr auto VersionBlockIterator::operator++(int) -> VersionBlockIterator
+{
+  auto copy = *this;
+  ++*this;
+  return copy;
+}
+
+constexpr auto VersionBlockIterator::operator==(
+  const VersionBlockIterator& other) const noexcept -> bool
+{
+  return mChildren.data() == other.mChildren.data()
+         && mChildren.size() == other.mChildren.size();
+}
+
+constexpr auto VersionBlockIterator::load() -> void
+{
+  if (mChildren.size() < 6 || readInteger<WORD>(mChildren, 0) == 0) {
+    mChildren = {};
+    return;
+  }
+
+  mBlock = VersionBlock{ mChildren };
+}
+
+
+constexpr VersionBlock::VersionBlock(std::span<const unsigned char> data)
+{
+  const std::size_t length = readInteger<WORD>(data, 0);
+  if (length < 6 || length > data.size()) {
+    throw PelfException{ "Invalid version block, its length is out of range" };
+  }
+
+  mData = data.first(length);
+  const std::size_t value_length = readInteger<WORD>(mData, 2);
+  mType = readInteger<WORD>(mData, 4);
+
+  std::size_t key_end{ 6 };
+  while (key_end + 1 < length && readInteger<WORD>(mData, key_end) != 0) {
+    key_end += 2;
+  }
+  if (key_end + 1 >= length) {
+    throw PelfException{ "Invalid version block, its key isn't terminated" };
+  }
+  mKey = Utf16View{ mData.subspan(6, key_end - 6) };
+
+  /* wValueLength counts characters for text values and bytes otherwise */
+  const auto align = [length](std::size_t offset) {
+    return std::min((offset + 3) & ~std::size_t{ 3 }, length);
+  };
+  const std::size_t value_offset = align(key_end + 2);
+  const std::size_t value_size = std::min(
+    mType == 1 ? value_length * 2 : value_length, length - value_offset);
+  mValue = mData.subspan(value_offset, value_size);
+  mChildren = mData.subspan(align(value_offset + value_size));
+}
+
+constexpr auto VersionBlock::length() const noexcept -> std::size_t
+{
+  return mData.size();
+}
+
+constexpr auto VersionBlock::type() const noexcept -> WORD
+{
+  return mType;
+}
+
+constexpr auto VersionBlock::key() const noexcept -> Utf16View
+{
+  return mKey;
+}
+
+constexpr auto VersionBlock::value() const noexcept
+  -> std::span<const unsigned char>
+{
+  return mValue;
+}
+
+constexpr auto VersionBlock::text() const -> Utf16View
+{
+  /* Some compilers count the terminator in wValueLength, others don't */
+  std::size_t size{};
+  while (size + 1 < mValue.size() && readInteger<WORD>(mValue, size) != 0) {
+    size += 2;
+  }
+
+  return Utf16View{ mValue.first(size) };
+}
+
+constexpr auto VersionBlock::find(std::string_view key) const
+  -> std::optional<VersionBlock>
+{
+  for (const auto& child : *this) {
+    if (child.key() == key) { return child; }
+  }
+
+  return std::nullopt;
+}
+
+constexpr auto VersionBlock::begin() const -> VersionBlockIterator
+{
+  return VersionBlockIterator{ mChildren };
+}
+
+constexpr auto VersionBlock::end() const -> VersionBlockIterator
+{
+  return VersionBlockIterator{};
+}
+
+
+constexpr VersionInfo::VersionInfo(std::span<const unsigned char> data)
+  : mRoot(data)
+{
+  if (mRoot.key() != "VS_VERSION_INFO") {
+    throw PelfException{ "Invalid version resource, it isn't a VS_VERSION_INFO" };
+  }
+}
+
+constexpr auto VersionInfo::root() const noexcept -> const VersionBlock&
+{
+  return mRoot;
+}
+
+constexpr auto VersionInfo::fixedFileInfo() const
+  -> std::optional<VS_FIXEDFILEINFO>
+{
+  if (mRoot.value().size() < 52) { return std::nullopt; }
+
+  const auto info = readStruct<VS_FIXEDFILEINFO>(mRoot.value(), 0);
+  if (info.dwSignature != VS_FFI_SIGNATURE) { return std::nullopt; }
+
+  return info;
+}
+
+constexpr auto VersionInfo::fileVersion() const -> std::optional<VersionNumber>
+{
+  const auto info = fixedFileInfo();
+  if (!info) { return std::nullopt; }
+
+  return VersionNumber{ static_cast<WORD>(info->dwFileVersionMS >> 16),
+    static_cast<WORD>(info->dwFileVersionMS),
+    static_cast<WORD>(info->dwFileVersionLS >> 16),
+    static_cast<WORD>(info->dwFileVersionLS) };
+}
+
+constexpr auto VersionInfo::productVersion() const
+  -> std::optional<VersionNumber>
+{
+  const auto info = fixedFileInfo();
+  if (!info) { return std::nullopt; }
+
+  return VersionNumber{ static_cast<WORD>(info->dwProductVersionMS >> 16),
+    static_cast<WORD>(info->dwProductVersionMS),
+    static_cast<WORD>(info->dwProductVersionLS >> 16),
+    static_cast<WORD>(info->dwProductVersionLS) };
+}
+
+constexpr auto VersionInfo::translationCount() const -> std::size_t
+{
+  return translations().size() / 4;
+}
+
+constexpr auto VersionInfo::translation(std::size_t index) const
+  -> Translation
+{
+  if (index >= translationCount()) {
+    throw PelfException{ "Invalid index, out of the translations" };
+  }
+
+  const auto values = translations();
+  return Translation{ readInteger<WORD>(values, index * 4),
+    readInteger<WORD>(values, index * 4 + 2) };
+}
+
+constexpr auto VersionInfo::stringFileInfo() const -> VersionBlock
+{
+  return mRoot.find("StringFileInfo").value_or(VersionBlock{});
+}
+
+constexpr auto VersionInfo::tableTranslation(const VersionBlock& table)
+  -> std::optional<Translation>
+{
+  const auto key = table.key();
+  if (key.size() != 8) { return std::nullopt; }
+
+  DWORD value{};
+  for (std::size_t i{}; i < 8; ++i) {
+    const char16_t c = key[i];
+    DWORD digit{};
+    if (c >= u'0' && c <= u'9') {
+      digit = c - u'0';
+    } else if (c >= u'a' && c <= u'f') {
+      digit = c - u'a' + 10;
+    } else if (c >= u'A' && c <= u'F') {
+      digit = c - u'A' + 10;
+    } else {
+      return std::nullopt;
+    }
+    value = value << 4 | digit;
+  }
+
+  return Translation{ static_cast<WORD>(value >> 16),
+    static_cast<WORD>(value) };
+}
+
+constexpr auto VersionInfo::string(std::string_view key) const
+  -> std::optional<Utf16View>
+{
+  if (translationCount() != 0) {
+    if (auto text = string(key, translation(0))) { return text; }
+  }
+
+  for (const auto& table : stringFileInfo()) {
+    if (const auto text = table.find(key)) { return text->text(); }
+  }
+
+  return std::nullopt;
+}
+
+constexpr auto VersionInfo::string(std::string_view key,
+  const Translation& translation) const -> std::optional<Utf16View>
+{
+  for (const auto& table : stringFileInfo()) {
+    if (tableTranslation(table) != translation) { continue; }
+
+    if (const auto text = table.find(key)) { return text->text(); }
+  }
+
+  return std::nullopt;
+}
+
+constexpr auto VersionInfo::translations() const
+  -> std::span<const unsigned char>
+{
+  const auto var_file_info = mRoot.find("VarFileInfo");
+  if (!var_file_info) { return {}; }
+
+  const auto translation = var_file_info->find("Translation");
+  if (!translation) { return {}; }
+
+  return translation->value();
+}
+
+
+}// namespace pelf
+
+#endif
@@ -0,0 +1,268 @@
+/** @file pelfFormat.h
+ *  @brief File format detection
+ *
+ *  This file contains `detectFormat()`, a cheap magic number sniffer, and
+ *  `open()` which uses it to construct either a `Pe` or an `Elf` without
+ *  having to try one and catch the exception thrown by the other
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef PELFFORMAT_H_
+#define PELFFORMAT_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <variant>
+
+#include "Pe.h"
+#include "Elf.h"
+
+
+namespace pelf {
+
+
+/** @brief File formats recognized by `detectFormat()` */
+enum class FileFormat {
+  Unknown, /**< None of the formats below */
+  Pe, /**< MZ header followed by a PE signature */
+  Elf, /**< \x7fELF */
+  Archive, /**< Unix ar archive (!<arch>, or !<thin> for thin archives) */
+  MachO /**< Mach-O or universal (fat) Mach-O, it can't be parsed */
+};
+
+
+/** @brief Returned by `open()` when the data can't be parsed by `Pe` or `Elf`
+ *
+ * */
+struct Unknown
+{
+  FileFormat format{
+    FileFormat::Unknown
+  }; /**< Detected format, a known format here means it's recognized but
+        not supported (e.g. an archive) */
+};
+
+
+/** @brief Result of `open()`, 64-bit little endian images come first so the
+ * most common alternatives have the lowest indices */
+template<class Container, class Allocator = std::allocator<std::byte>>
+using OpenResult = std::variant<Pe<Container, 0, Pe32PlusClass, Allocator>,
+  Elf<Container, 0, 0, Elf64Class, std::endian::little, Allocator>,
+  Pe<Container, 0, Pe32Class, Allocator>,
+  Elf<Container, 0, 0, Elf32Class, std::endian::little, Allocator>,
+  Elf<Container, 0, 0, Elf64Class, std::endian::big, Allocator>,
+  Elf<Container, 0, 0, Elf32Class, std::endian::big, Allocator>,
+  Unknown>;
+
+
+/** @brief Detects the format of the file by looking at its magic numbers
+ *
+ *  Only a handful of bytes are read, this function never throws
+ *
+ *  @tparam Container Container used to pass the data from the file
+ *  @param data Bytes of the file
+ *
+ *  @return Returns the detected `FileFormat`
+ * */
+template<class Container>
+constexpr auto detectFormat(const Container& data) noexcept
+  -> FileFormat requires container_and_convertible_v<Container, unsigned char>;
+
+
+/** @brief Returns `true` if `open()` can parse data of format `format`
+ *
+ *  Besides the magic numbers, it checks that the file uses a layout supported
+ *  by the parsers (32/64-bit little and big endian ELF, PE32 and PE32+)
+ *
+ *  @param data Bytes of the file
+ *  @param format Format returned by `detectFormat(data)`
+ *
+ *  @return `true` if the file is supported
+ * */
+template<class Container>
+constexpr auto isSupported(const Container& data, FileFormat format) noexcept
+  -> bool requires container_and_convertible_v<Container, unsigned char>;
+
+
+/** @brief Detects the format of `data` and parses it with `Pe` or `Elf`
+ *
+ *  The image class (32 or 64 bit) and the byte order are checked here once,
+ *  the returned `Pe`/`Elf` is specialised for them so its parsing loops don't
+ *  branch on either.
+ *  Formats that are recognized but not supported and unknown formats return
+ *  `Unknown` instead of throwing, an exception is only thrown if the file
+ *  looks like a supported PE/ELF file but it's malformed
+ *
+ *  @param data Bytes of the file
+ *  @param alloc Allocator passed to the `Pe`/`Elf` constructor
+ *
+ *  @return Returns a variant that holds a `Pe`, an `Elf` or `Unknown`
+ * */
+template<class Container, class Allocator = std::allocator<std::byte>>
+constexpr auto open(const Container& data, const Allocator& alloc = Allocator{})
+  -> OpenResult<Container, Allocator> requires
+  container_and_convertible_v<Container, unsigned char>;
+
+
+namespace detail {
+
+  /** @brief Returns the byte at `index` or zero if it's out of range */
+  template<class Container>
+  constexpr auto byteAt(const Container& data, std::size_t index) noexcept
+    -> std::uint8_t
+  {
+    return index < data.size() ? static_cast<std::uint8_t>(data[index]) : 0;
+  }
+
+  /** @brief Reads a little endian 32 bit value, zero if it's out of range */
+  template<class Container>
+  constexpr auto readLe32(const Container& data, std::size_t index) noexcept
+    -> std::uint32_t
+  {
+    return static_cast<std::uint32_t>(byteAt(data, index))
+           | static_cast<std::uint32_t>(byteAt(data, index + 1)) << 8
+           | static_cast<std::uint32_t>(byteAt(data, index + 2)) << 16
+           | static_cast<std::uint32_t>(byteAt(data, index + 3)) << 24;
+  }
+
+  /** @brief Returns the magic of the optional header of a PE file */
+  template<class Container>
+  constexpr auto peOptionalHeaderMagic(const Container& data) noexcept -> WORD
+  {
+    /* The optional header is right after the PE signature and coff header */
+    const std::size_t offset =
+      readLe32(data, 0x3c) + sizeof(DWORD) + sizeof(IMAGE_FILE_HEADER);
+    return static_cast<WORD>(
+      byteAt(data, offset) | byteAt(data, offset + 1) << 8);
+  }
+
+  /** @brief Returns `true` if `data` starts with `magic` */
+  template<class Container, std::size_t N>
+  constexpr auto startsWith(const Container& data, const char (&magic)[N])
+    noexcept -> bool
+  {
+    /* N - 1 to skip the null terminator */
+    if (data.size() < N - 1) { return false; }
+
+    for (std::size_t i{}; i < N - 1; ++i) {
+      if (byteAt(data, i) != static_cast<std::uint8_t>(magic[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+}// namespace detail
+
+
+template<class Container>
+constexpr auto detectFormat(const Container& data) noexcept
+  -> FileFormat requires container_and_convertible_v<Container, unsigned char>
+{
+  if (data.size() < 4) { return FileFormat::Unknown; }
+
+  if (detail::byteAt(data, 0) == EI_MAG0 && detail::byteAt(data, 1) == EI_MAG1
+      && detail::byteAt(data, 2) == EI_MAG2
+      && detail::byteAt(data, 3) == EI_MAG3) {
+    return FileFormat::Elf;
+  }
+
+  if (detail::startsWith(data, "MZ")) {
+    /* e_lfanew, the PE signature must be inside the file */
+    const std::size_t pe_header_address = detail::readLe32(data, 0x3c);
+    if (data.size() >= 0x40 && pe_header_address <= data.size() - 4
+        && detail::readLe32(data, pe_header_address) == 0x00004550) {
+      return FileFormat::Pe;
+    }
+    return FileFormat::Unknown;
+  }
+
+  if (detail::startsWith(data, "!<arch>\n")
+      || detail::startsWith(data, "!<thin>\n")) {
+    return FileFormat::Archive;
+  }
+
+  switch (detail::readLe32(data, 0)) {
+  case 0xfeedface:// MH_MAGIC
+  case 0xcefaedfe:// MH_CIGAM
+  case 0xfeedfacf:// MH_MAGIC_64
+  case 0xcffaedfe:// MH_CIGAM_64
+    return FileFormat::MachO;
+  case 0xbebafeca: {
+    /* FAT_MAGIC (stored big endian), Java class files use the same magic,
+     * but their next field (version) is always bigger than the number of
+     * architectures of a universal binary */
+    const std::uint32_t number_of_archs =
+      static_cast<std::uint32_t>(detail::byteAt(data, 4)) << 24
+      | static_cast<std::uint32_t>(detail::byteAt(data, 5)) << 16
+      | static_cast<std::uint32_t>(detail::byteAt(data, 6)) << 8
+      | static_cast<std::uint32_t>(detail::byteAt(data, 7));
+    return number_of_archs != 0 && number_of_archs < 45 ? FileFormat::MachO
+                                                        : FileFormat::Unknown;
+  }
+  default:
+    return FileFormat::Unknown;
+  }
+}
+
+
+template<class Container>
+constexpr auto isSupported(const Container& data, FileFormat format) noexcept
+  -> bool requires container_and_convertible_v<Container, unsigned char>
+{
+  switch (format) {
+  case FileFormat::Elf: {
+    const auto file_class = detail::byteAt(data, EI_CLASS_OFFSET);
+    const auto encoding = detail::byteAt(data, EI_DATA_OFFSET);
+    return (file_class == ELFCLASS64 || file_class == ELFCLASS32)
+           && (encoding == ELFDATA2LSB || encoding == ELFDATA2MSB);
+  }
+  case FileFormat::Pe: {
+    const auto magic = detail::peOptionalHeaderMagic(data);
+    return magic == Pe32PlusClass::magic || magic == Pe32Class::magic;
+  }
+  default:
+    return false;
+  }
+}
+
+
+template<class Container, class Allocator>
+constexpr auto open(const Container& data, const Allocator& alloc)
+  -> OpenResult<Container, Allocator> requires
+  container_and_convertible_v<Container, unsigned char>
+{
+  using Result = OpenResult<Container, Allocator>;
+
+  const auto format = detectFormat(data);
+
+  if (!isSupported(data, format)) { return Result{ Unknown{ format } }; }
+
+  if (format == FileFormat::Pe) {
+    if (detail::peOptionalHeaderMagic(data) == Pe32Class::magic) {
+      return Result{ std::in_place_index<2>, data, alloc };
+    }
+    return Result{ std::in_place_index<0>, data, alloc };
+  }
+
+  const bool elf32 = detail::byteAt(data, EI_CLASS_OFFSET) == ELFCLASS32;
+
+  if (detail::byteAt(data, EI_DATA_OFFSET) == ELFDATA2MSB) {
+    if (elf32) { return Result{ std::in_place_index<5>, data, alloc }; }
+    return Result{ std::in_place_index<4>, data, alloc };
+  }
+
+  if (elf32) { return Result{ std::in_place_index<3>, data, alloc }; }
+  return Result{ std::in_place_index<1>, data, alloc };
+}
+
+
+}// namespace pelf
+
+
+#endif
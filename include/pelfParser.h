@@ -3,5 +3,6 @@
 
 #include "Pe.h"
 #include "Elf.h"
+#include "pelfFormat.h"
 
 #endif
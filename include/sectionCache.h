@@ -0,0 +1,188 @@
+/** @file sectionCache.h
+ *  @brief SectionCache class declaration
+ *
+ *  This file contains the SectionCache class declaration, a thread safe cache
+ *  of the contents of the sections of an `Elf`. Compressed sections are
+ *  decompressed once, the first time they are requested, and `prefetch()`
+ *  decompresses many sections in parallel (e.g. all the `.debug_*` sections
+ *  before symbolizing)
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef SECTIONCACHE_H_
+#define SECTIONCACHE_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "parallelFor.h"
+#include "pelfExcept.h"
+
+
+namespace pelf {
+
+
+/** @brief Cache of the (decompressed) contents of the sections of an `Elf`
+ *
+ *  @tparam ElfType `Elf` whose sections are cached, it must outlive the cache
+ * */
+template<class ElfType>
+class SectionCache
+{
+public:
+  /** @brief SectionCache constructor
+   *
+   *  @param elf Parsed file, the cache keeps a reference to it
+   * */
+  explicit SectionCache(const ElfType& elf);
+
+  /** @brief Returns the contents of the section at `index`
+   *
+   *  It can be called from many threads at the same time, a section is only
+   *  decompressed once. The span is valid until `clear()` is called or the
+   *  cache is destroyed
+   *
+   *  @param index Index of the section in the section table
+   *
+   *  @return Contents of the section, it throws `PelfException` if `index` is
+   *  out of range or the section can't be decompressed
+   * */
+  auto get(std::size_t index) -> std::span<const unsigned char>;
+
+  /** @brief Returns the contents of the first section named `name`
+   *
+   *  @param name Name of the section, e.g. ".debug_info"
+   *
+   *  @return Contents of the section, empty if there isn't one
+   * */
+  auto get(std::string_view name) -> std::span<const unsigned char>;
+
+  /** @brief Decompresses the sections at `indices` using `threads` threads
+   *
+   *  The first exception thrown by a worker stops the sections that haven't
+   *  been decompressed and is rethrown once every thread has finished
+   *
+   *  @param indices Indices of the sections in the section table
+   *  @param threads Number of threads, 0 uses one per core
+   * */
+  auto prefetch(std::span<const std::size_t> indices, unsigned threads = 0)
+    -> void;
+
+  /** @brief Decompresses every compressed section in parallel
+   *
+   *  @param threads Number of threads, 0 uses one per core
+   * */
+  auto prefetch(unsigned threads = 0) -> void;
+
+  /** @brief Releases the memory of the decompressed sections
+   *
+   *  It must not be called while other threads use the cache
+   * */
+  auto clear() -> void;
+
+  /** @brief Returns the number of bytes held by the cache
+   *
+   *  It must not be called while other threads use the cache
+   * */
+  [[nodiscard]] auto memoryUsage() const -> std::size_t;
+
+private:
+  /** @brief Cached contents of a section */
+  struct Slot
+  {
+    std::once_flag once; /**< Set once the section is loaded */
+    std::vector<unsigned char> buffer; /**< Decompressed data */
+    std::span<const unsigned char> data; /**< Contents of the section */
+  };
+
+  const ElfType& mElf; /**< Parsed file */
+  decltype(std::declval<const ElfType&>().getSections()) mSections; /**< Section
+    table of the parsed file */
+  std::unique_ptr<Slot[]> mSlots; /**< One slot per section */
+};
+
+
+template<class ElfType>
+SectionCache<ElfType>::SectionCache(const ElfType& elf)
+  : mElf(elf), mSections(elf.getSections()),
+    mSlots(std::make_unique<Slot[]>(mSections.size()))
+{}
+
+template<class ElfType>
+auto SectionCache<ElfType>::get(std::size_t index)
+  -> std::span<const unsigned char>
+{
+  if (index >= mSections.size()) {
+    throw PelfException{ "Invalid section index" };
+  }
+
+  auto& slot = mSlots[index];
+
+  /* If the decompression throws, the flag isn't set and the next call tries
+   * again */
+  std::call_once(slot.once, [&] {
+    slot.data = mElf.getSectionContents(mSections[index], slot.buffer);
+  });
+
+  return slot.data;
+}
+
+template<class ElfType>
+auto SectionCache<ElfType>::get(std::string_view name)
+  -> std::span<const unsigned char>
+{
+  for (std::size_t i{}; i < mSections.size(); ++i) {
+    if (mElf.getSectionName(mSections[i]) == name) { return get(i); }
+  }
+
+  return {};
+}
+
+template<class ElfType>
+auto SectionCache<ElfType>::prefetch(std::span<const std::size_t> indices,
+  unsigned threads) -> void
+{
+  detail::parallelFor(indices.size(), threads, [&](std::size_t i) {
+    static_cast<void>(get(indices[i]));
+  });
+}
+
+template<class ElfType>
+auto SectionCache<ElfType>::prefetch(unsigned threads) -> void
+{
+  std::vector<std::size_t> compressed;
+  for (std::size_t i{}; i < mSections.size(); ++i) {
+    if (mElf.isCompressed(mSections[i])) { compressed.push_back(i); }
+  }
+
+  prefetch(compressed, threads);
+}
+
+template<class ElfType> auto SectionCache<ElfType>::clear() -> void
+{
+  mSlots = std::make_unique<Slot[]>(mSections.size());
+}
+
+template<class ElfType>
+auto SectionCache<ElfType>::memoryUsage() const -> std::size_t
+{
+  std::size_t total{};
+  for (std::size_t i{}; i < mSections.size(); ++i) {
+    total += mSlots[i].buffer.capacity();
+  }
+  return total;
+}
+
+
+}// namespace pelf
+
+
+#endif
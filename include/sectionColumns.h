@@ -0,0 +1,247 @@
+/** @file sectionColumns.h
+ *  @brief SectionColumns class declaration
+ *
+ *  This file contains the SectionColumns class declaration, a columnar
+ *  (struct of arrays) copy of an Elf section table. Each field lives in its
+ *  own contiguous array so queries that only look at a couple of fields
+ *  (flags and sizes, offsets and sizes) can be vectorised by the compiler
+ *
+ *
+ *  @author Rebraws
+ *  */
+
+
+#ifndef SECTIONCOLUMNS_H_
+#define SECTIONCOLUMNS_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "elfStructs.h"
+
+
+namespace pelf {
+
+
+/** @brief Columnar view of an Elf section table
+ *
+ *  The section table is stored as separate arrays of `sh_offset`, `sh_size`,
+ *  `sh_flags`, `sh_addr` and `sh_type`, the index of a section is the same
+ *  in every column and in the original section table
+ *
+ * */
+class SectionColumns
+{
+public:
+  static constexpr std::size_t npos{
+    std::numeric_limits<std::size_t>::max()
+  }; /**< Returned by the search functions when no section matches */
+
+  /** @brief SectionColumns constructor
+   *
+   *  @tparam Sections Container of section headers (`Elf64_Shdr`), usually
+   *  the value returned by `Elf::getSections()`
+   *  @param sections section table to be split into columns
+   * */
+  template<class Sections>
+  constexpr explicit SectionColumns(const Sections& sections);
+
+  /** @brief Returns the number of sections
+   *
+   *  @return Number of entries in every column
+   * */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t;
+
+  /** @brief Returns the `sh_offset` column */
+  [[nodiscard]] constexpr auto offsets() const noexcept
+    -> std::span<const std::uint64_t>;
+
+  /** @brief Returns the `sh_size` column */
+  [[nodiscard]] constexpr auto sizes() const noexcept
+    -> std::span<const std::uint64_t>;
+
+  /** @brief Returns the `sh_flags` column */
+  [[nodiscard]] constexpr auto flags() const noexcept
+    -> std::span<const std::uint64_t>;
+
+  /** @brief Returns the `sh_addr` column */
+  [[nodiscard]] constexpr auto addrs() const noexcept
+    -> std::span<const std::uint64_t>;
+
+  /** @brief Returns the `sh_type` column */
+  [[nodiscard]] constexpr auto types() const noexcept
+    -> std::span<const std::uint32_t>;
+
+  /** @brief Returns the indices of all sections that have every bit of
+   * `flagMask` set and whose size is greater than `minSize`
+   *
+   *  e.g. `filter(SHF_EXECINSTR, 0x1000)` returns every executable section
+   *  bigger than a page
+   *
+   *  @param flagMask bits that must be set in `sh_flags`
+   *  @param minSize the section size must be strictly greater than this value
+   *
+   *  @return Indices of the matching sections in ascending order
+   * */
+  [[nodiscard]] constexpr auto filter(std::uint64_t flagMask,
+    std::uint64_t minSize = 0) const -> std::vector<std::size_t>;
+
+  /** @brief Returns the index of the first section whose file range
+   * [sh_offset, sh_offset + sh_size) contains `offset`
+   *
+   *  `SHT_NOBITS` sections don't occupy space in the file so they are skipped
+   *
+   *  @param offset File offset
+   *
+   *  @return Index of the section or `npos` if no section contains `offset`
+   * */
+  [[nodiscard]] constexpr auto findByOffset(std::uint64_t offset) const noexcept
+    -> std::size_t;
+
+  /** @brief Returns the index of the first `SHF_ALLOC` section whose memory
+   * range [sh_addr, sh_addr + sh_size) contains `address`
+   *
+   *  @param address Virtual address
+   *
+   *  @return Index of the section or `npos` if no section contains `address`
+   * */
+  [[nodiscard]] constexpr auto findByAddress(std::uint64_t address) const
+    noexcept -> std::size_t;
+
+private:
+  std::vector<std::uint64_t> mOffsets; /**< `sh_offset` of every section */
+  std::vector<std::uint64_t> mSizes; /**< `sh_size` of every section */
+  std::vector<std::uint64_t> mFlags; /**< `sh_flags` of every section */
+  std::vector<std::uint64_t> mAddrs; /**< `sh_addr` of every section */
+  std::vector<std::uint32_t> mTypes; /**< `sh_type` of every section */
+};
+
+
+template<class Sections>
+constexpr SectionColumns::SectionColumns(const Sections& sections)
+{
+  const auto count = static_cast<std::size_t>(std::size(sections));
+
+  mOffsets.resize(count);
+  mSizes.resize(count);
+  mFlags.resize(count);
+  mAddrs.resize(count);
+  mTypes.resize(count);
+
+  std::size_t i{};
+  for (const auto& section : sections) {
+    mOffsets[i] = section.sh_offset;
+    mSizes[i] = section.sh_size;
+    mFlags[i] = section.sh_flags;
+    mAddrs[i] = section.sh_addr;
+    mTypes[i] = section.sh_type;
+    ++i;
+  }
+}
+
+constexpr auto SectionColumns::size() const noexcept -> std::size_t
+{
+  return mOffsets.size();
+}
+
+constexpr auto SectionColumns::offsets() const noexcept
+  -> std::span<const std::uint64_t>
+{
+  return mOffsets;
+}
+
+constexpr auto SectionColumns::sizes() const noexcept
+  -> std::span<const std::uint64_t>
+{
+  return mSizes;
+}
+
+constexpr auto SectionColumns::flags() const noexcept
+  -> std::span<const std::uint64_t>
+{
+  return mFlags;
+}
+
+constexpr auto SectionColumns::addrs() const noexcept
+  -> std::span<const std::uint64_t>
+{
+  return mAddrs;
+}
+
+constexpr auto SectionColumns::types() const noexcept
+  -> std::span<const std::uint32_t>
+{
+  return mTypes;
+}
+
+constexpr auto SectionColumns::filter(std::uint64_t flagMask,
+  std::uint64_t minSize) const -> std::vector<std::size_t>
+{
+  const std::size_t count = size();
+
+  /* First pass: branch free predicate over two columns, this is the loop that
+   * gets vectorised */
+  std::vector<std::uint8_t> matches(count);
+  const std::uint64_t* flags = mFlags.data();
+  const std::uint64_t* sizes = mSizes.data();
+  for (std::size_t i{}; i < count; ++i) {
+    matches[i] = static_cast<std::uint8_t>(
+      ((flags[i] & flagMask) == flagMask) & (sizes[i] > minSize));
+  }
+
+  /* Second pass: compaction, the store is unconditional and the output
+   * index only advances on a match */
+  std::vector<std::size_t> indices(count);
+  std::size_t found{};
+  for (std::size_t i{}; i < count; ++i) {
+    indices[found] = i;
+    found += matches[i];
+  }
+  indices.resize(found);
+
+  return indices;
+}
+
+constexpr auto SectionColumns::findByOffset(std::uint64_t offset) const
+  noexcept -> std::size_t
+{
+  /* The loop is written as a min-reduction without an early exit so it can be
+   * vectorised, (offset - sh_offset) wraps around when offset < sh_offset so a
+   * single unsigned comparison checks both ends of the range */
+  std::size_t best = npos;
+  const std::size_t count = size();
+
+  for (std::size_t i{}; i < count; ++i) {
+    const bool hit = ((offset - mOffsets[i]) < mSizes[i])
+                     & (mTypes[i] != SHT_NOBITS);
+    const std::size_t candidate = hit ? i : npos;
+    best = candidate < best ? candidate : best;
+  }
+
+  return best;
+}
+
+constexpr auto SectionColumns::findByAddress(std::uint64_t address) const
+  noexcept -> std::size_t
+{
+  std::size_t best = npos;
+  const std::size_t count = size();
+
+  for (std::size_t i{}; i < count; ++i) {
+    const bool hit = ((address - mAddrs[i]) < mSizes[i])
+                     & ((mFlags[i] & SHF_ALLOC) != 0);
+    const std::size_t candidate = hit ? i : npos;
+    best = candidate < best ? candidate : best;
+  }
+
+  return best;
+}
+
+
+}// namespace pelf
+
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef GUARD_H_
+#define GUARD_H_
+
+#include <array>
+
+/* This file contains binary contents of guard.exe, it's built by
+ * make_pe.py inside test_programs folder */
+
+inline constexpr unsigned int guard_len = 3072;
+
+static constexpr std::array<unsigned char, guard_len> guard_program = {
+  0x4d, 0x5a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x40, 0x00, 0x00, 0x00, 0x50, 0x45, 0x00, 0x00, 0x64, 0x86, 0x02, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xf0, 0x00, 0x22, 0x00, 0x0b, 0x02, 0x0e, 0x00, 0x00, 0x02, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00,
+  0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00,
+  0x00, 0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x30, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x03, 0x00, 0x60, 0x81, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x27, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x18, 0x01, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+  0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x60, 0x2e, 0x72, 0x64, 0x61,
+  0x74, 0x61, 0x00, 0x00, 0x60, 0x07, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00,
+  0x00, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x40,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc3, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x18, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x21, 0x00, 0x40,
+  0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x20, 0x21, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00, 0x2c, 0x01, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x01, 0x10, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x27, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x32, 0xa2, 0xdf, 0x2d,
+  0x99, 0x2b, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x10, 0x00,
+  0x00, 0x00, 0x20, 0x10, 0x00, 0x00, 0x00, 0x30, 0x10, 0x00, 0x00, 0x00,
+  0x40, 0x10, 0x00, 0x00, 0x00, 0x50, 0x10, 0x00, 0x00, 0x00, 0x60, 0x10,
+  0x00, 0x00, 0x00, 0x70, 0x10, 0x00, 0x00, 0x01, 0x80, 0x10, 0x00, 0x00,
+  0x00, 0x90, 0x10, 0x00, 0x00, 0x00, 0xa0, 0x10, 0x00, 0x00, 0x00, 0xb0,
+  0x10, 0x00, 0x00, 0x00, 0xc0, 0x10, 0x00, 0x00, 0x00, 0xd0, 0x10, 0x00,
+  0x00, 0x00, 0xe0, 0x10, 0x00, 0x00, 0x00, 0xf0, 0x10, 0x00, 0x00, 0x00,
+  0x00, 0x11, 0x00, 0x00, 0x00, 0x10, 0x11, 0x00, 0x00, 0x00, 0x20, 0x11,
+  0x00, 0x00, 0x00, 0x30, 0x11, 0x00, 0x00, 0x00, 0x40, 0x11, 0x00, 0x00,
+  0x00, 0x50, 0x11, 0x00, 0x00, 0x00, 0x60, 0x11, 0x00, 0x00, 0x00, 0x70,
+  0x11, 0x00, 0x00, 0x00, 0x80, 0x11, 0x00, 0x00, 0x00, 0x90, 0x11, 0x00,
+  0x00, 0x00, 0xa0, 0x11, 0x00, 0x00, 0x00, 0xb0, 0x11, 0x00, 0x00, 0x00,
+  0xc0, 0x11, 0x00, 0x00, 0x00, 0xd0, 0x11, 0x00, 0x00, 0x00, 0xe0, 0x11,
+  0x00, 0x00, 0x00, 0xf0, 0x11, 0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00,
+  0x00, 0x10, 0x12, 0x00, 0x00, 0x00, 0x20, 0x12, 0x00, 0x00, 0x00, 0x30,
+  0x12, 0x00, 0x00, 0x00, 0x40, 0x12, 0x00, 0x00, 0x00, 0x50, 0x12, 0x00,
+  0x00, 0x00, 0x60, 0x12, 0x00, 0x00, 0x00, 0x70, 0x12, 0x00, 0x00, 0x00,
+  0x80, 0x12, 0x00, 0x00, 0x00, 0x90, 0x12, 0x00, 0x00, 0x00, 0xa0, 0x12,
+  0x00, 0x00, 0x00, 0xb0, 0x12, 0x00, 0x00, 0x00, 0xc0, 0x12, 0x00, 0x00,
+  0x00, 0xd0, 0x12, 0x00, 0x00, 0x00, 0xe0, 0x12, 0x00, 0x00, 0x00, 0xf0,
+  0x12, 0x00, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x10, 0x13, 0x00,
+  0x00, 0x00, 0x20, 0x13, 0x00, 0x00, 0x00, 0x30, 0x13, 0x00, 0x00, 0x00,
+  0x40, 0x13, 0x00, 0x00, 0x00, 0x50, 0x13, 0x00, 0x00, 0x00, 0x60, 0x13,
+  0x00, 0x00, 0x00, 0x70, 0x13, 0x00, 0x00, 0x00, 0x80, 0x13, 0x00, 0x00,
+  0x00, 0x90, 0x13, 0x00, 0x00, 0x01, 0xa0, 0x13, 0x00, 0x00, 0x00, 0xb0,
+  0x13, 0x00, 0x00, 0x00, 0xc0, 0x13, 0x00, 0x00, 0x00, 0xd0, 0x13, 0x00,
+  0x00, 0x00, 0xe0, 0x13, 0x00, 0x00, 0x00, 0xf0, 0x13, 0x00, 0x00, 0x00,
+  0x00, 0x14, 0x00, 0x00, 0x00, 0x10, 0x14, 0x00, 0x00, 0x00, 0x20, 0x14,
+  0x00, 0x00, 0x00, 0x30, 0x14, 0x00, 0x00, 0x00, 0x40, 0x14, 0x00, 0x00,
+  0x00, 0x50, 0x14, 0x00, 0x00, 0x00, 0x60, 0x14, 0x00, 0x00, 0x00, 0x70,
+  0x14, 0x00, 0x00, 0x00, 0x80, 0x14, 0x00, 0x00, 0x00, 0x90, 0x14, 0x00,
+  0x00, 0x00, 0xa0, 0x14, 0x00, 0x00, 0x00, 0xb0, 0x14, 0x00, 0x00, 0x00,
+  0xc0, 0x14, 0x00, 0x00, 0x00, 0xd0, 0x14, 0x00, 0x00, 0x00, 0xe0, 0x14,
+  0x00, 0x00, 0x00, 0xf0, 0x14, 0x00, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00,
+  0x00, 0x10, 0x15, 0x00, 0x00, 0x00, 0x20, 0x15, 0x00, 0x00, 0x00, 0x30,
+  0x15, 0x00, 0x00, 0x00, 0x40, 0x15, 0x00, 0x00, 0x00, 0x50, 0x15, 0x00,
+  0x00, 0x00, 0x60, 0x15, 0x00, 0x00, 0x00, 0x70, 0x15, 0x00, 0x00, 0x00,
+  0x80, 0x15, 0x00, 0x00, 0x00, 0x90, 0x15, 0x00, 0x00, 0x00, 0xa0, 0x15,
+  0x00, 0x00, 0x00, 0xb0, 0x15, 0x00, 0x00, 0x00, 0xc0, 0x15, 0x00, 0x00,
+  0x00, 0xd0, 0x15, 0x00, 0x00, 0x00, 0xe0, 0x15, 0x00, 0x00, 0x00, 0xf0,
+  0x15, 0x00, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x10, 0x16, 0x00,
+  0x00, 0x00, 0x20, 0x16, 0x00, 0x00, 0x00, 0x30, 0x16, 0x00, 0x00, 0x00,
+  0x40, 0x16, 0x00, 0x00, 0x00, 0x50, 0x16, 0x00, 0x00, 0x00, 0x60, 0x16,
+  0x00, 0x00, 0x00, 0x70, 0x16, 0x00, 0x00, 0x00, 0x80, 0x16, 0x00, 0x00,
+  0x00, 0x90, 0x16, 0x00, 0x00, 0x00, 0xa0, 0x16, 0x00, 0x00, 0x00, 0xb0,
+  0x16, 0x00, 0x00, 0x01, 0xc0, 0x16, 0x00, 0x00, 0x00, 0xd0, 0x16, 0x00,
+  0x00, 0x00, 0xe0, 0x16, 0x00, 0x00, 0x00, 0xf0, 0x16, 0x00, 0x00, 0x00,
+  0x00, 0x17, 0x00, 0x00, 0x00, 0x10, 0x17, 0x00, 0x00, 0x00, 0x20, 0x17,
+  0x00, 0x00, 0x00, 0x30, 0x17, 0x00, 0x00, 0x00, 0x40, 0x17, 0x00, 0x00,
+  0x00, 0x50, 0x17, 0x00, 0x00, 0x00, 0x60, 0x17, 0x00, 0x00, 0x00, 0x70,
+  0x17, 0x00, 0x00, 0x00, 0x80, 0x17, 0x00, 0x00, 0x00, 0x90, 0x17, 0x00,
+  0x00, 0x00, 0xa0, 0x17, 0x00, 0x00, 0x00, 0xb0, 0x17, 0x00, 0x00, 0x00,
+  0xc0, 0x17, 0x00, 0x00, 0x00, 0xd0, 0x17, 0x00, 0x00, 0x00, 0xe0, 0x17,
+  0x00, 0x00, 0x00, 0xf0, 0x17, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00,
+  0x00, 0x10, 0x18, 0x00, 0x00, 0x00, 0x20, 0x18, 0x00, 0x00, 0x00, 0x30,
+  0x18, 0x00, 0x00, 0x00, 0x40, 0x18, 0x00, 0x00, 0x00, 0x50, 0x18, 0x00,
+  0x00, 0x00, 0x60, 0x18, 0x00, 0x00, 0x00, 0x70, 0x18, 0x00, 0x00, 0x00,
+  0x80, 0x18, 0x00, 0x00, 0x00, 0x90, 0x18, 0x00, 0x00, 0x00, 0xa0, 0x18,
+  0x00, 0x00, 0x00, 0xb0, 0x18, 0x00, 0x00, 0x00, 0xc0, 0x18, 0x00, 0x00,
+  0x00, 0xd0, 0x18, 0x00, 0x00, 0x00, 0xe0, 0x18, 0x00, 0x00, 0x00, 0xf0,
+  0x18, 0x00, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0x10, 0x19, 0x00,
+  0x00, 0x00, 0x20, 0x19, 0x00, 0x00, 0x00, 0x30, 0x19, 0x00, 0x00, 0x00,
+  0x40, 0x19, 0x00, 0x00, 0x00, 0x50, 0x19, 0x00, 0x00, 0x00, 0x60, 0x19,
+  0x00, 0x00, 0x00, 0x70, 0x19, 0x00, 0x00, 0x00, 0x80, 0x19, 0x00, 0x00,
+  0x00, 0x90, 0x19, 0x00, 0x00, 0x00, 0xa0, 0x19, 0x00, 0x00, 0x00, 0xb0,
+  0x19, 0x00, 0x00, 0x00, 0xc0, 0x19, 0x00, 0x00, 0x00, 0xd0, 0x19, 0x00,
+  0x00, 0x01, 0xe0, 0x19, 0x00, 0x00, 0x00, 0xf0, 0x19, 0x00, 0x00, 0x00,
+  0x00, 0x1a, 0x00, 0x00, 0x00, 0x10, 0x1a, 0x00, 0x00, 0x00, 0x20, 0x1a,
+  0x00, 0x00, 0x00, 0x30, 0x1a, 0x00, 0x00, 0x00, 0x40, 0x1a, 0x00, 0x00,
+  0x00, 0x50, 0x1a, 0x00, 0x00, 0x00, 0x60, 0x1a, 0x00, 0x00, 0x00, 0x70,
+  0x1a, 0x00, 0x00, 0x00, 0x80, 0x1a, 0x00, 0x00, 0x00, 0x90, 0x1a, 0x00,
+  0x00, 0x00, 0xa0, 0x1a, 0x00, 0x00, 0x00, 0xb0, 0x1a, 0x00, 0x00, 0x00,
+  0xc0, 0x1a, 0x00, 0x00, 0x00, 0xd0, 0x1a, 0x00, 0x00, 0x00, 0xe0, 0x1a,
+  0x00, 0x00, 0x00, 0xf0, 0x1a, 0x00, 0x00, 0x00, 0x00, 0x1b, 0x00, 0x00,
+  0x00, 0x10, 0x1b, 0x00, 0x00, 0x00, 0x20, 0x1b, 0x00, 0x00, 0x00, 0x30,
+  0x1b, 0x00, 0x00, 0x00, 0x40, 0x1b, 0x00, 0x00, 0x00, 0x50, 0x1b, 0x00,
+  0x00, 0x00, 0x60, 0x1b, 0x00, 0x00, 0x00, 0x70, 0x1b, 0x00, 0x00, 0x00,
+  0x80, 0x1b, 0x00, 0x00, 0x00, 0x90, 0x1b, 0x00, 0x00, 0x00, 0xa0, 0x1b,
+  0x00, 0x00, 0x00, 0xb0, 0x1b, 0x00, 0x00, 0x00, 0xc0, 0x1b, 0x00, 0x00,
+  0x00, 0xd0, 0x1b, 0x00, 0x00, 0x00, 0xe0, 0x1b, 0x00, 0x00, 0x00, 0xf0,
+  0x1b, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x10, 0x1c, 0x00,
+  0x00, 0x00, 0x20, 0x1c, 0x00, 0x00, 0x00, 0x30, 0x1c, 0x00, 0x00, 0x00,
+  0x40, 0x1c, 0x00, 0x00, 0x00, 0x50, 0x1c, 0x00, 0x00, 0x00, 0x60, 0x1c,
+  0x00, 0x00, 0x00, 0x70, 0x1c, 0x00, 0x00, 0x00, 0x80, 0x1c, 0x00, 0x00,
+  0x00, 0x90, 0x1c, 0x00, 0x00, 0x00, 0xa0, 0x1c, 0x00, 0x00, 0x00, 0xb0,
+  0x1c, 0x00, 0x00, 0x00, 0xc0, 0x1c, 0x00, 0x00, 0x00, 0xd0, 0x1c, 0x00,
+  0x00, 0x00, 0xe0, 0x1c, 0x00, 0x00, 0x00, 0xf0, 0x1c, 0x00, 0x00, 0x01,
+  0x00, 0x1d, 0x00, 0x00, 0x00, 0x10, 0x1d, 0x00, 0x00, 0x00, 0x20, 0x1d,
+  0x00, 0x00, 0x00, 0x30, 0x1d, 0x00, 0x00, 0x00, 0x40, 0x1d, 0x00, 0x00,
+  0x00, 0x50, 0x1d, 0x00, 0x00, 0x00, 0x60, 0x1d, 0x00, 0x00, 0x00, 0x70,
+  0x1d, 0x00, 0x00, 0x00, 0x80, 0x1d, 0x00, 0x00, 0x00, 0x90, 0x1d, 0x00,
+  0x00, 0x00, 0xa0, 0x1d, 0x00, 0x00, 0x00, 0xb0, 0x1d, 0x00, 0x00, 0x00,
+  0xc0, 0x1d, 0x00, 0x00, 0x00, 0xd0, 0x1d, 0x00, 0x00, 0x00, 0xe0, 0x1d,
+  0x00, 0x00, 0x00, 0xf0, 0x1d, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x00,
+  0x00, 0x10, 0x1e, 0x00, 0x00, 0x00, 0x20, 0x1e, 0x00, 0x00, 0x00, 0x30,
+  0x1e, 0x00, 0x00, 0x00, 0x40, 0x1e, 0x00, 0x00, 0x00, 0x50, 0x1e, 0x00,
+  0x00, 0x00, 0x60, 0x1e, 0x00, 0x00, 0x00, 0x70, 0x1e, 0x00, 0x00, 0x00,
+  0x80, 0x1e, 0x00, 0x00, 0x00, 0x90, 0x1e, 0x00, 0x00, 0x00, 0xa0, 0x1e,
+  0x00, 0x00, 0x00, 0xb0, 0x1e, 0x00, 0x00, 0x00, 0xc0, 0x1e, 0x00, 0x00,
+  0x00, 0xd0, 0x1e, 0x00, 0x00, 0x00, 0xe0, 0x1e, 0x00, 0x00, 0x00, 0xf0,
+  0x1e, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x10, 0x1f, 0x00,
+  0x00, 0x00, 0x20, 0x1f, 0x00, 0x00, 0x00, 0x30, 0x1f, 0x00, 0x00, 0x00,
+  0x40, 0x1f, 0x00, 0x00, 0x00, 0x50, 0x1f, 0x00, 0x00, 0x00, 0x60, 0x1f,
+  0x00, 0x00, 0x00, 0x70, 0x1f, 0x00, 0x00, 0x00, 0x80, 0x1f, 0x00, 0x00,
+  0x00, 0x90, 0x1f, 0x00, 0x00, 0x00, 0xa0, 0x1f, 0x00, 0x00, 0x00, 0xb0,
+  0x1f, 0x00, 0x00, 0x00, 0xc0, 0x1f, 0x00, 0x00, 0x00, 0xd0, 0x1f, 0x00,
+  0x00, 0x00, 0xe0, 0x1f, 0x00, 0x00, 0x00, 0xf0, 0x1f, 0x00, 0x00, 0x00,
+  0x00, 0x20, 0x00, 0x00, 0x00, 0x10, 0x20, 0x00, 0x00, 0x01, 0x20, 0x20,
+  0x00, 0x00, 0x00, 0x30, 0x20, 0x00, 0x00, 0x00, 0x40, 0x20, 0x00, 0x00,
+  0x00, 0x50, 0x20, 0x00, 0x00, 0x00, 0x60, 0x20, 0x00, 0x00, 0x00, 0x70,
+  0x20, 0x00, 0x00, 0x00, 0x80, 0x20, 0x00, 0x00, 0x00, 0x90, 0x20, 0x00,
+  0x00, 0x00, 0xa0, 0x20, 0x00, 0x00, 0x00, 0xb0, 0x20, 0x00, 0x00, 0x00,
+  0xc0, 0x20, 0x00, 0x00, 0x00, 0xd0, 0x20, 0x00, 0x00, 0x00, 0xe0, 0x20,
+  0x00, 0x00, 0x00, 0xf0, 0x20, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00,
+  0x00, 0x10, 0x21, 0x00, 0x00, 0x00, 0x20, 0x21, 0x00, 0x00, 0x00, 0x30,
+  0x21, 0x00, 0x00, 0x00, 0x40, 0x21, 0x00, 0x00, 0x00, 0x50, 0x21, 0x00,
+  0x00, 0x00, 0x60, 0x21, 0x00, 0x00, 0x00, 0x70, 0x21, 0x00, 0x00, 0x00,
+  0x80, 0x21, 0x00, 0x00, 0x00, 0x90, 0x21, 0x00, 0x00, 0x00, 0xa0, 0x21,
+  0x00, 0x00, 0x00, 0xb0, 0x21, 0x00, 0x00, 0x00, 0xc0, 0x21, 0x00, 0x00,
+  0x00, 0xd0, 0x21, 0x00, 0x00, 0x00, 0xe0, 0x21, 0x00, 0x00, 0x00, 0xf0,
+  0x21, 0x00, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x10, 0x22, 0x00,
+  0x00, 0x00, 0x20, 0x22, 0x00, 0x00, 0x00, 0x30, 0x22, 0x00, 0x00, 0x00,
+  0x40, 0x22, 0x00, 0x00, 0x00, 0x50, 0x22, 0x00, 0x00, 0x00, 0x60, 0x22,
+  0x00, 0x00, 0x00, 0x70, 0x22, 0x00, 0x00, 0x00, 0x80, 0x22, 0x00, 0x00,
+  0x00, 0x90, 0x22, 0x00, 0x00, 0x00, 0xa0, 0x22, 0x00, 0x00, 0x00, 0xb0,
+  0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x11, 0x00, 0x00,
+  0x00, 0xa4, 0x12, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00,
+  0x54, 0x4c, 0x53, 0x20, 0x64, 0x61, 0x74, 0x61, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x20, 0x10, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00,
+  0x30, 0x10, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x10, 0x27, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00,
+  0x18, 0x27, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00, 0x18, 0x27, 0x00, 0x40,
+  0x01, 0x00, 0x00, 0x00, 0x20, 0x27, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef LIBDEBUG_THIN_H_
+#define LIBDEBUG_THIN_H_
+
+#include <array>
+
+/* This file contains binary contents of libdebug_thin.a, its compilation
+ * is specified at debug_main.c inside test_programs folder */
+
+inline constexpr unsigned int libdebug_thin_archive_len = 338;
+
+static constexpr std::array<unsigned char, libdebug_thin_archive_len> libdebug_thin_archive = {
+  0x21, 0x3c, 0x74, 0x68, 0x69, 0x6e, 0x3e, 0x0a, 0x2f, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x30, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x30, 0x20, 0x20, 0x20, 0x20, 0x20, 0x30, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x30, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x34, 0x34, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x60, 0x0a, 0x00, 0x00, 0x00, 0x03,
+  0x00, 0x00, 0x00, 0xda, 0x00, 0x00, 0x01, 0x16, 0x00, 0x00, 0x01, 0x16,
+  0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x00, 0x73, 0x75, 0x6d, 0x5f, 0x64,
+  0x69, 0x67, 0x69, 0x74, 0x73, 0x00, 0x63, 0x68, 0x65, 0x63, 0x6b, 0x73,
+  0x75, 0x6d, 0x00, 0x00, 0x2f, 0x2f, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x34, 0x36, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x60, 0x0a, 0x64, 0x65, 0x62, 0x75, 0x67, 0x5f, 0x6d, 0x61,
+  0x69, 0x6e, 0x2e, 0x6f, 0x2f, 0x0a, 0x64, 0x65, 0x62, 0x75, 0x67, 0x5f,
+  0x75, 0x74, 0x69, 0x6c, 0x5f, 0x77, 0x69, 0x74, 0x68, 0x5f, 0x61, 0x5f,
+  0x6c, 0x6f, 0x6e, 0x67, 0x5f, 0x6e, 0x61, 0x6d, 0x65, 0x2e, 0x6f, 0x2f,
+  0x0a, 0x0a, 0x2f, 0x30, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x30, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x30, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x30, 0x20, 0x20, 0x20, 0x20, 0x20, 0x36, 0x34, 0x34, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x31, 0x33, 0x32, 0x38, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x60, 0x0a, 0x2f, 0x31, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x30, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x30, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x30, 0x20, 0x20, 0x20, 0x20, 0x20, 0x36, 0x34, 0x34, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x31, 0x33, 0x31, 0x32, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x60, 0x0a,
+};
+
+#endif
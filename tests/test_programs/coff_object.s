@@ -0,0 +1,68 @@
+# COFF object file used to test Coff, it has long section and symbol names,
+# section definitions (one of them COMDAT), a weak external and a file record
+# that spans three auxiliary records
+#
+#   llvm-mc -triple x86_64-pc-windows-msvc -filetype=obj coff_object.s \
+#     -o coff_object.obj
+#
+#   LLVM 14
+
+	.file	"src/checksum/coff_object_with_a_long_name.c"
+	.def	@feat.00;
+	.scl	3;
+	.type	0;
+	.endef
+	.globl	@feat.00
+.set @feat.00, 0
+
+	.text
+	.def	compute_checksum_of_buffer;
+	.scl	2;
+	.type	32;
+	.endef
+	.globl	compute_checksum_of_buffer
+	.p2align	4, 0x90
+compute_checksum_of_buffer:
+	xorl	%eax, %eax
+	testq	%rdx, %rdx
+	je	.LBB0_2
+.LBB0_1:
+	movzbl	(%rcx), %r8d
+	addq	%r8, %rax
+	incq	%rcx
+	decq	%rdx
+	jne	.LBB0_1
+.LBB0_2:
+	retq
+
+	.def	helper;
+	.scl	3;
+	.type	32;
+	.endef
+helper:
+	callq	external_function
+	callq	weak_hook
+	movl	counter(%rip), %eax
+	retq
+
+	.section	.text$inline_function,"xr",discard,inline_function
+	.def	inline_function;
+	.scl	2;
+	.type	32;
+	.endef
+	.globl	inline_function
+inline_function:
+	movl	$42, %eax
+	retq
+
+	.data
+	.globl	counter
+	.p2align	2
+counter:
+	.long	7
+
+	.section	.rdata,"dr"
+message:
+	.asciz	"checksum"
+
+	.weak	weak_hook
@@ -0,0 +1,22 @@
+/*
+ * Freestanding program that crashes with SIGSEGV, its core dump (core) is
+ * used to test CoreFile
+ *
+ *   gcc -O1 -static -nostdlib -fno-pie -no-pie crash.c -o crash
+ *   ulimit -c unlimited && env -i ./crash && mv core crash_core
+ *
+ *   gcc (Debian 12.2.0-14) 12.2.0, Linux x86-64
+ */
+
+static volatile long depth;
+
+__attribute__((noinline)) static void crash(long value)
+{
+  depth = value;
+  *(volatile long*)0 = value;
+}
+
+void _start(void)
+{
+  crash(42);
+}
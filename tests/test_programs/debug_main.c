@@ -0,0 +1,58 @@
+/*
+ * Freestanding test program with DWARF debug information, it's split in two
+ * translation units (debug_main.c and debug_util.c) so the debug sections
+ * contain more than one compilation unit.
+ *
+ * Uncompressed (hello_debug):
+ *   gcc -g -gdwarf-5 -O1 -static -nostdlib -fno-pie -no-pie \
+ *     -Wl,--build-id=sha1 -Wl,--eh-frame-hdr \
+ *     debug_main.c debug_util.c -o hello_debug
+ *
+ * Compressed debug sections (hello_zdebug):
+ *   objcopy --compress-debug-sections=zlib hello_debug hello_zdebug
+ *
+ * DWARF 4 (hello_debug4):
+ *   the same gcc command with -gdwarf-4 and -o hello_debug4
+ *
+ * Compilation units with DW_AT_ranges and without .debug_aranges
+ * (hello_ranges):
+ *   the same gcc command with -ffunction-sections and -o hello_ranges, then
+ *   objcopy --remove-section .debug_aranges hello_ranges
+ *
+ * Static library (libdebug.a) and thin archive (libdebug_thin.a):
+ *   gcc -c -O1 -fno-asynchronous-unwind-tables debug_main.c -o debug_main.o
+ *   gcc -c -O1 debug_util.c -o debug_util_with_a_long_name.o
+ *   ar rcs libdebug.a debug_main.o debug_util_with_a_long_name.o
+ *   ar rcsT libdebug_thin.a debug_main.o debug_util_with_a_long_name.o
+ *
+ *   gcc (Debian 12.2.0-14) 12.2.0, GNU Binutils for Debian 2.40
+ */
+
+long sum_digits(long value);
+long checksum(const char* text, long size);
+
+static const char message[] = "Hello from a freestanding program\n";
+
+static long write_message(const char* text, long size)
+{
+  long result;
+  __asm__ volatile("syscall"
+                   : "=a"(result)
+                   : "a"(1), "D"(1), "S"(text), "d"(size)
+                   : "rcx", "r11", "memory");
+  return result;
+}
+
+__attribute__((noreturn)) static void exit_program(long code)
+{
+  __asm__ volatile("syscall" : : "a"(60), "D"(code));
+  __builtin_unreachable();
+}
+
+void _start(void)
+{
+  const long size = sizeof(message) - 1;
+  const long written = write_message(message, size);
+  const long code = sum_digits(checksum(message, written)) % 2;
+  exit_program(code);
+}
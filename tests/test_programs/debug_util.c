@@ -0,0 +1,20 @@
+/* Second translation unit of hello_debug, see debug_main.c */
+
+long sum_digits(long value)
+{
+  long sum = 0;
+  while (value > 0) {
+    sum += value % 10;
+    value /= 10;
+  }
+  return sum;
+}
+
+long checksum(const char* text, long size)
+{
+  long hash = 5381;
+  for (long i = 0; i < size; ++i) {
+    hash = hash * 33 + text[i];
+  }
+  return hash < 0 ? -hash : hash;
+}
@@ -0,0 +1,43 @@
+/*
+ * 32-bit test program, it doesn't use any library so it can be assembled and
+ * linked as both a 32-bit ELF and a PE32 image with GNU binutils.
+ *
+ * ELF (hello32_elf):
+ *   as --32 hello32.s -o hello32.o
+ *   ld -m elf_i386 --build-id=sha1 hello32.o -o hello32_elf
+ *
+ * PE32 (hello32.exe):
+ *   as --32 hello32.s -o hello32.o
+ *   objcopy -O pe-i386 hello32.o hello32.obj
+ *   ld -m i386pe --image-base=0x400000 hello32.obj -o hello32.exe
+ *
+ * Stripped ELF whose .gnu_debuglink points to hello32_elf (hello32_stripped):
+ *   objcopy --strip-all --add-gnu-debuglink=hello32_elf hello32_elf \
+ *     hello32_stripped
+ *
+ *   GNU assembler / GNU ld (GNU Binutils for Debian) 2.40
+ */
+
+        .text
+        .globl  _start
+_start:
+        call    1f                  /* ecx = address of message, computed */
+1:      popl    %ecx                /* relative to eip so the program has */
+        addl    $(message - 1b), %ecx /* no relocations */
+
+        movl    $4, %eax            /* write(1, message, length) */
+        movl    $1, %ebx
+        movl    $(message_end - message), %edx
+        int     $0x80
+
+        movl    $1, %eax            /* exit(0) */
+        xorl    %ebx, %ebx
+        int     $0x80
+
+message:
+        .ascii  "Hello World!\n"
+message_end:
+
+        .data
+counter:
+        .long   0
@@ -0,0 +1,872 @@
+#!/usr/bin/env python3
+"""Builds small PE32+ images for the tests that hello.exe can't cover.
+
+There is no Windows linker in the test environment, so the images are laid
+out here: a DOS header, the PE headers, a .text section with a single `ret`
+and the sections that hold the structures under test.
+
+  llvm-rc -no-cpp /FO resources.res resources.rc
+  ./make_pe.py resources resources.res resources.exe
+  ./make_pe.py imports imports.exe
+  ./make_pe.py debug debug.exe
+  ./make_pe.py guard guard.exe
+  ./make_pe.py guard32 guard32.exe
+  ./make_pe.py clr clr.exe
+  ./make_pe.py delay delay.exe
+  ./make_pe.py depends_app depends_app.exe
+  ./make_pe.py depends_kernel32 depends_kernel32.dll
+  ./make_pe.py depends_ntdll depends_ntdll.dll
+  ./make_pe.py apisetschema apisetschema.dll
+
+The `resources` image gets a .rsrc section with the resource tree of a .res
+file compiled by llvm-rc (the same tree cvtres and link.exe produce: the
+directories breadth first, then the data entries, the names and the data).
+
+The `imports` image is a PE32 file with an .idata section that imports
+functions by name and by ordinal from the DLLs of IMPORTS.
+
+The `debug` image has a debug directory with a CodeView (RSDS) entry for the
+PDB of CODEVIEW, a VC feature entry and a repro entry without data.
+
+The `guard` images have a load config directory with a security cookie and
+/guard:cf tables, and a TLS directory with callbacks. The PE32+ one has CFG
+entries with a byte of flags and a long jump table, the PE32 one a SafeSEH
+handler table and the 0x5C byte load config of Windows 8.1 behind a data
+directory of 0x40 bytes like old linkers wrote.
+
+The `clr` image is a PE32 .NET assembly with a CLI header and the metadata
+of ASSEMBLY: a Hello.Program class with a static field, a Main method that
+calls System.Console.WriteLine and a constructor. The #Strings heap uses
+4 byte indexes like the heaps of large assemblies.
+
+The `delay` image is a PE32 file that imports KERNEL32.dll, delay loads the
+DLLs of DELAY_IMPORTS (one with a descriptor of virtual addresses like
+Visual C++ 6 wrote) and has the bound import directory of BOUND_IMPORTS in
+the headers, after the section table.
+
+The `depends_*` images and `apisetschema` are a directory of PE32 images for
+the dependency graph, the imports and exports of DEPENDS and the API set
+schema (version 6) of API_SETS.
+"""
+
+import struct
+import sys
+
+FILE_ALIGNMENT = 0x200
+SECTION_ALIGNMENT = 0x1000
+IMAGE_BASE = 0x140000000
+IMAGE_BASE32 = 0x400000
+
+IMAGE_SCN_CNT_CODE = 0x00000020
+IMAGE_SCN_CNT_INITIALIZED_DATA = 0x00000040
+IMAGE_SCN_MEM_EXECUTE = 0x20000000
+IMAGE_SCN_MEM_READ = 0x40000000
+
+IMAGE_DIRECTORY_ENTRY_EXPORT = 0
+IMAGE_DIRECTORY_ENTRY_IMPORT = 1
+IMAGE_DIRECTORY_ENTRY_RESOURCE = 2
+IMAGE_DIRECTORY_ENTRY_DEBUG = 6
+IMAGE_DIRECTORY_ENTRY_TLS = 9
+IMAGE_DIRECTORY_ENTRY_LOAD_CONFIG = 10
+IMAGE_DIRECTORY_ENTRY_BOUND_IMPORT = 11
+IMAGE_DIRECTORY_ENTRY_DELAY_IMPORT = 13
+IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR = 14
+IMAGE_DIRECTORY_ENTRY_IAT = 12
+
+IMAGE_DEBUG_TYPE_CODEVIEW = 2
+IMAGE_DEBUG_TYPE_VC_FEATURE = 12
+IMAGE_DEBUG_TYPE_REPRO = 16
+
+IMAGE_GUARD_CF_INSTRUMENTED = 0x100
+IMAGE_GUARD_CF_FUNCTION_TABLE_PRESENT = 0x400
+IMAGE_GUARD_CF_LONGJUMP_TABLE_PRESENT = 0x10000
+IMAGE_GUARD_FLAG_FID_SUPPRESSED = 0x1
+
+COMIMAGE_FLAGS_ILONLY = 0x1
+
+DLATTR_RVA = 0x1
+
+# DLLs and functions of the `imports` image, integers are ordinals
+IMPORTS = [
+    ("KERNEL32.dll", ["GetProcAddress", "LoadLibraryA", "ExitProcess"]),
+    ("USER32.dll", ["MessageBoxA", 2]),
+    ("Control.OCX", ["DllRegisterServer"]),
+    ("plugin.drv", [7, "Initialize"]),
+    ("WS2_32.dll", [115, 23, 16, 1000]),
+    ("wsock32.dll", [52]),
+    ("OLEAUT32.dll", [2, 6, 302]),
+]
+
+# DLLs, functions and whether the descriptor has RVAs of the `delay` image
+DELAY_IMPORTS = [
+    ("USER32.dll", ["MessageBoxA", 2], True),
+    ("dbghelp.dll", ["SymInitialize", "SymCleanup"], False),
+]
+
+# DLLs, time stamps and forwarder references of the `delay` image
+BOUND_IMPORTS = [
+    ("KERNEL32.dll", 0x5e8f1a2b, [("NTDLL.DLL", 0x3c4d5e6f)]),
+    ("USER32.dll", 0x1a2b3c4d, []),
+]
+
+# Images of the dependency graph: the name, the imports, the delay imports
+# and the exports (ordinal, name or None, "code" or a forwarder)
+DEPENDS = {
+    "depends_app": ("app.exe",
+                    [("api-ms-win-core-heap-l1-1-0.dll", ["HeapAlloc"]),
+                     ("KERNEL32.dll", ["ExitProcess", "Missing", 6]),
+                     ("ext-ms-win-missing-l1-1-0.dll", ["Nothing"])],
+                    [("absent.dll", ["Foo"], True),
+                     ("ntdll.dll", ["RtlFreeHeap"], True)],
+                    []),
+    "depends_kernel32": ("KERNEL32.dll",
+                         [("ntdll.dll", ["RtlAllocateHeap"])],
+                         [],
+                         [(1, "ExitProcess", "code"),
+                          (2, "HeapAlloc", "NTDLL.RtlAllocateHeap"),
+                          (3, "Loop1", "kernel32.Loop2"),
+                          (4, "Loop2", "KERNEL32.Loop1"),
+                          (5, "HeapFree", "api-ms-win-core-heap-l1-1-0.RtlFreeHeap"),
+                          (6, None, "code")]),
+    "depends_ntdll": ("ntdll.dll", [], [],
+                      [(1, "RtlAllocateHeap", "code"),
+                       (2, "RtlFreeHeap", "code")]),
+}
+
+# API sets of the `apisetschema` image and their hosts, the first host is the
+# default one and the others are the hosts of an importer
+API_SETS = [
+    ("api-ms-win-core-heap-l1-1-0", [("", "kernel32.dll"),
+                                     ("kernel32.dll", "ntdll.dll")]),
+    ("ext-ms-win-missing-l1-1-0", []),
+]
+API_SET_HASH_FACTOR = 0x1F
+
+# GUID {3844DBB9-2017-4967-BE7A-A4A2C20430FA}, age and path of the PDB of the
+# `debug` image
+CODEVIEW = (bytes.fromhex("b9db443817206749be7aa4a2c20430fa"), 2,
+            "C:\\build\\pelf\\debug.pdb")
+
+
+# Metadata tables of the `clr` image: the table number, the columns (u16,
+# u32, a #Strings, #GUID or #Blob index or a 2 byte table or coded index) and
+# the rows. Coded indexes are (row << tag bits) | tag
+ASSEMBLY = [
+    (0x00, "Module", ["u16", "string", "guid", "guid", "guid"],
+     [(0, "hello.exe", 1, 0, 0)]),
+    (0x01, "TypeRef", ["index", "string", "string"],
+     [(1 << 2 | 2, "Object", "System"), (1 << 2 | 2, "Console", "System")]),
+    (0x02, "TypeDef", ["u32", "string", "string", "index", "index", "index"],
+     [(0, "<Module>", "", 0, 1, 1),
+      (0x100001, "Program", "Hello", 1 << 2 | 1, 1, 1)]),
+    (0x04, "Field", ["u16", "string", "blob"],
+     [(0x11, "greeting", b"\x06\x0e")]),
+    (0x06, "MethodDef", ["u32", "u16", "u16", "string", "blob", "index"],
+     [("Main", 0, 0x96, "Main", b"\x00\x01\x01\x1d\x0e", 1),
+      (".ctor", 0, 0x1886, ".ctor", b"\x20\x00\x01", 2)]),
+    (0x08, "Param", ["u16", "u16", "string"], [(0, 1, "args")]),
+    (0x0A, "MemberRef", ["index", "string", "blob"],
+     [(2 << 3 | 1, "WriteLine", b"\x00\x01\x01\x0e"),
+      (1 << 3 | 1, ".ctor", b"\x20\x00\x01")]),
+    (0x20, "Assembly", ["u32", "u16", "u16", "u16", "u16", "u32", "blob",
+                        "string", "string"],
+     [(0x8004, 1, 2, 3, 4, 0, b"", "hello", "")]),
+    (0x23, "AssemblyRef", ["u16", "u16", "u16", "u16", "u32", "blob", "string",
+                           "string", "blob"],
+     [(4, 0, 0, 0, 0, bytes.fromhex("b77a5c561934e089"), "mscorlib", "", b"")]),
+]
+
+# IL of the methods of the `clr` image: ldstr "Hello, World!", call
+# Console::WriteLine, ret and ldarg.0, call Object::.ctor, ret
+METHODS = {
+    "Main": b"\x72\x01\x00\x00\x70\x28\x01\x00\x00\x0a\x2a",
+    ".ctor": b"\x02\x28\x02\x00\x00\x0a\x2a",
+}
+USER_STRINGS = ["Hello, World!"]
+MVID = bytes.fromhex("0f1e2d3c4b5a69788796a5b4c3d2e1f0")
+
+
+def align(value, alignment):
+    return (value + alignment - 1) & ~(alignment - 1)
+
+
+def read_id(data, offset):
+    """Reads a type or a name of a .res header, an ordinal or a string"""
+    if struct.unpack_from("<H", data, offset)[0] == 0xFFFF:
+        return struct.unpack_from("<H", data, offset + 2)[0], offset + 4
+    end = offset
+    while struct.unpack_from("<H", data, end)[0] != 0:
+        end += 2
+    return data[offset:end].decode("utf-16-le"), end + 2
+
+
+def read_res(data):
+    """Returns the resources of a .res file as (type, name, language, data)"""
+    resources = []
+    offset = 0
+    while offset < len(data):
+        data_size, header_size = struct.unpack_from("<II", data, offset)
+        type_id, position = read_id(data, offset + 8)
+        name_id, position = read_id(data, position)
+        position = align(position, 4)
+        language = struct.unpack_from("<H", data, position + 6)[0]
+        contents = data[offset + header_size:offset + header_size + data_size]
+        # The first entry of a .res file is empty
+        if data_size != 0 or type_id != 0:
+            resources.append((type_id, name_id, language, contents))
+        offset = align(offset + header_size + data_size, 4)
+    return resources
+
+
+def sort_key(key):
+    # Named entries come first, sorted like the loader compares them
+    if isinstance(key, str):
+        return (0, key.upper(), 0)
+    return (1, "", key)
+
+
+def build_rsrc(resources, rva):
+    """Lays out the resource tree of `resources` at `rva`"""
+    tree = {}
+    for type_id, name_id, language, contents in resources:
+        tree.setdefault(type_id, {}).setdefault(name_id, {})[language] = contents
+
+    # Directories breadth first: the types, then the names, then the languages
+    directories = [("root", sorted(tree, key=sort_key), tree)]
+    for type_id in sorted(tree, key=sort_key):
+        names = tree[type_id]
+        directories.append(((type_id,), sorted(names, key=sort_key), names))
+    for type_id in sorted(tree, key=sort_key):
+        for name_id in sorted(tree[type_id], key=sort_key):
+            languages = tree[type_id][name_id]
+            directories.append(((type_id, name_id), sorted(languages), languages))
+
+    directory_offsets = {}
+    offset = 0
+    for path, keys, _ in directories:
+        directory_offsets[path] = offset
+        offset += 16 + 8 * len(keys)
+
+    leaves = [(t, n, l) for t in sorted(tree, key=sort_key)
+              for n in sorted(tree[t], key=sort_key) for l in sorted(tree[t][n])]
+    data_entry_offsets = {}
+    for leaf in leaves:
+        data_entry_offsets[leaf] = offset
+        offset += 16
+
+    strings = sorted({key for _, keys, _ in directories for key in keys
+                      if isinstance(key, str)})
+    string_offsets = {}
+    for string in strings:
+        string_offsets[string] = offset
+        offset += 2 + 2 * len(string)
+
+    data_offsets = {}
+    for leaf in leaves:
+        offset = align(offset, 8)
+        data_offsets[leaf] = offset
+        offset += len(tree[leaf[0]][leaf[1]][leaf[2]])
+
+    rsrc = bytearray(offset)
+    for path, keys, children in directories:
+        position = directory_offsets[path]
+        named = sum(1 for key in keys if isinstance(key, str))
+        struct.pack_into("<IIHHHH", rsrc, position, 0, 0, 0, 0, named,
+                         len(keys) - named)
+        for index, key in enumerate(keys):
+            name = (0x80000000 | string_offsets[key]) if isinstance(key, str) else key
+            child = (key,) if path == "root" else path + (key,)
+            if len(child) == 3:
+                target = data_entry_offsets[child]
+            else:
+                target = 0x80000000 | directory_offsets[child]
+            struct.pack_into("<II", rsrc, position + 16 + 8 * index, name, target)
+
+    for leaf in leaves:
+        contents = tree[leaf[0]][leaf[1]][leaf[2]]
+        struct.pack_into("<IIII", rsrc, data_entry_offsets[leaf],
+                         rva + data_offsets[leaf], len(contents), 0, 0)
+        rsrc[data_offsets[leaf]:data_offsets[leaf] + len(contents)] = contents
+
+    for string in strings:
+        encoded = string.encode("utf-16-le")
+        struct.pack_into("<H", rsrc, string_offsets[string], len(string))
+        position = string_offsets[string] + 2
+        rsrc[position:position + len(encoded)] = encoded
+
+    return bytes(rsrc)
+
+
+def build_imports(imports, rva, pe32):
+    """Lays out the import descriptors of `imports` at `rva`
+
+    Returns the contents and the import and IAT directories, the lookup tables
+    and the IATs have the same thunks like in a file that isn't bound.
+    """
+    thunk_size = 4 if pe32 else 8
+    ordinal_flag = 1 << (thunk_size * 8 - 1)
+
+    offset = 20 * (len(imports) + 1)
+    lookup_offsets = []
+    for _, functions in imports:
+        lookup_offsets.append(offset)
+        offset += thunk_size * (len(functions) + 1)
+    iat_start = offset
+    iat_offsets = []
+    for _, functions in imports:
+        iat_offsets.append(offset)
+        offset += thunk_size * (len(functions) + 1)
+    iat_size = offset - iat_start
+
+    name_offsets = {}
+    for _, functions in imports:
+        for function in functions:
+            if isinstance(function, str) and function not in name_offsets:
+                name_offsets[function] = offset
+                offset = align(offset + 2 + len(function) + 1, 2)
+    dll_offsets = []
+    for dll, _ in imports:
+        dll_offsets.append(offset)
+        offset += len(dll) + 1
+
+    contents = bytearray(align(offset, 4))
+    thunk_format = "<I" if pe32 else "<Q"
+    for index, (dll, functions) in enumerate(imports):
+        struct.pack_into("<IIIII", contents, 20 * index, rva + lookup_offsets[index],
+                         0, 0, rva + dll_offsets[index], rva + iat_offsets[index])
+        for position, function in enumerate(functions):
+            if isinstance(function, str):
+                thunk = rva + name_offsets[function]
+            else:
+                thunk = ordinal_flag | function
+            for table in (lookup_offsets[index], iat_offsets[index]):
+                struct.pack_into(thunk_format, contents,
+                                 table + thunk_size * position, thunk)
+        contents[dll_offsets[index]:dll_offsets[index] + len(dll)] = dll.encode()
+
+    for hint, (function, name_offset) in enumerate(name_offsets.items()):
+        struct.pack_into("<H", contents, name_offset, hint)
+        contents[name_offset + 2:name_offset + 2 + len(function)] = function.encode()
+
+    return bytes(contents), {IMAGE_DIRECTORY_ENTRY_IMPORT: (0, 20 * (len(imports) + 1)),
+                             IMAGE_DIRECTORY_ENTRY_IAT: (iat_start, iat_size)}
+
+
+def build_delay_imports(imports, rva):
+    """Lays out the PE32 delay load descriptors of `imports` at `rva`
+
+    Every DLL gets an import name table, an import address table and a module
+    handle. Descriptors without DLATTR_RVA have virtual addresses, their
+    import name tables too.
+    """
+    offset = 32 * (len(imports) + 1)
+    tables = []
+    for _, functions, _ in imports:
+        tables.append((offset, offset + 4 * (len(functions) + 1),
+                       offset + 8 * (len(functions) + 1)))
+        offset += 8 * (len(functions) + 1) + 4
+
+    name_offsets = {}
+    for _, functions, _ in imports:
+        for function in functions:
+            if isinstance(function, str):
+                name_offsets[function] = offset
+                offset = align(offset + 2 + len(function) + 1, 2)
+    dll_offsets = []
+    for dll, _, _ in imports:
+        dll_offsets.append(offset)
+        offset += len(dll) + 1
+
+    contents = bytearray(align(offset, 4))
+    for index, (dll, functions, rva_based) in enumerate(imports):
+        base = rva if rva_based else IMAGE_BASE32 + rva
+        names, iat, handle = tables[index]
+        struct.pack_into("<IIIIIIII", contents, 32 * index,
+                         DLATTR_RVA if rva_based else 0, base + dll_offsets[index],
+                         base + handle, base + iat, base + names, 0, 0, 0)
+        for position, function in enumerate(functions):
+            if isinstance(function, str):
+                thunk = base + name_offsets[function]
+            else:
+                thunk = 0x80000000 | function
+            struct.pack_into("<I", contents, names + 4 * position, thunk)
+            # The IAT points to the stubs that call the helper, .text here
+            struct.pack_into("<I", contents, iat + 4 * position,
+                             IMAGE_BASE32 + SECTION_ALIGNMENT)
+        contents[dll_offsets[index]:dll_offsets[index] + len(dll)] = dll.encode()
+
+    for function, name_offset in name_offsets.items():
+        contents[name_offset + 2:name_offset + 2 + len(function)] = function.encode()
+
+    return bytes(contents), {IMAGE_DIRECTORY_ENTRY_DELAY_IMPORT:
+                             (0, 32 * (len(imports) + 1))}
+
+
+def build_exports(dll, exports, rva):
+    """Lays out the export directory of `exports` at `rva`, the functions
+    are the `ret` at the beginning of .text"""
+    base = min(ordinal for ordinal, _, _ in exports)
+    count = max(ordinal for ordinal, _, _ in exports) - base + 1
+    named = sorted((name, ordinal) for ordinal, name, _ in exports if name)
+
+    functions = 40
+    names = functions + 4 * count
+    ordinals = names + 4 * len(named)
+    strings = bytearray()
+    string_start = ordinals + 2 * len(named)
+
+    def string(value):
+        offset = string_start + len(strings)
+        strings.extend(value.encode() + b"\0")
+        return rva + offset
+
+    contents = bytearray(string_start)
+    struct.pack_into("<IIHHIIIIIII", contents, 0, 0, 0, 0, 0, string(dll), base,
+                     count, len(named), rva + functions, rva + names,
+                     rva + ordinals)
+    for ordinal, _, target in exports:
+        address = SECTION_ALIGNMENT if target == "code" else string(target)
+        struct.pack_into("<I", contents, functions + 4 * (ordinal - base), address)
+    for index, (name, ordinal) in enumerate(named):
+        struct.pack_into("<I", contents, names + 4 * index, string(name))
+        struct.pack_into("<H", contents, ordinals + 2 * index, ordinal - base)
+
+    contents += strings
+    return bytes(contents), {IMAGE_DIRECTORY_ENTRY_EXPORT: (0, len(contents))}
+
+
+def build_api_sets(api_sets):
+    """Lays out a version 6 API set schema, the entries sorted by name and
+    the hash table sorted by hash"""
+    def hashed(name):
+        value = 0
+        for c in name[:name.rfind("-")].lower():
+            value = (value * API_SET_HASH_FACTOR + ord(c)) & 0xFFFFFFFF
+        return value
+
+    api_sets = sorted(api_sets)
+    entries = 28
+    hashes = entries + 24 * len(api_sets)
+    values = hashes + 8 * len(api_sets)
+    strings_offset = values + 20 * sum(len(hosts) for _, hosts in api_sets)
+    strings = bytearray()
+
+    def string(value):
+        offset = strings_offset + len(strings)
+        strings.extend(value.encode("utf-16-le"))
+        return offset, 2 * len(value)
+
+    contents = bytearray(strings_offset)
+    value_index = 0
+    for index, (name, hosts) in enumerate(api_sets):
+        name_offset, name_length = string(name)
+        hashed_length = 2 * name.rfind("-")
+        struct.pack_into("<IIIIII", contents, entries + 24 * index, 0, name_offset,
+                         name_length, hashed_length, values + 20 * value_index,
+                         len(hosts))
+        for importer, host in hosts:
+            importer_offset, importer_length = string(importer) if importer else (0, 0)
+            host_offset, host_length = string(host)
+            struct.pack_into("<IIIII", contents, values + 20 * value_index, 0,
+                             importer_offset, importer_length, host_offset,
+                             host_length)
+            value_index += 1
+
+    for index, (value, entry) in enumerate(sorted(
+            (hashed(name), index) for index, (name, _) in enumerate(api_sets))):
+        struct.pack_into("<II", contents, hashes + 8 * index, value, entry)
+
+    contents += strings
+    struct.pack_into("<IIIIIII", contents, 0, 6, len(contents), 0, len(api_sets),
+                     entries, hashes, API_SET_HASH_FACTOR)
+    return bytes(contents)
+
+
+def build_bound_imports(imports):
+    """Lays out the bound import directory of `imports`, the names are
+    relative to its beginning"""
+    count = sum(1 + len(forwarders) for _, _, forwarders in imports) + 1
+    names = bytearray()
+    name_offsets = {}
+    for dll, _, forwarders in imports:
+        for name in [dll] + [forwarder for forwarder, _ in forwarders]:
+            if name not in name_offsets:
+                name_offsets[name] = 8 * count + len(names)
+                names += name.encode() + b"\0"
+
+    contents = bytearray()
+    for dll, stamp, forwarders in imports:
+        contents += struct.pack("<IHH", stamp, name_offsets[dll], len(forwarders))
+        for forwarder, forwarder_stamp in forwarders:
+            contents += struct.pack("<IHH", forwarder_stamp,
+                                    name_offsets[forwarder], 0)
+    contents += bytes(8)
+
+    return bytes(contents + names)
+
+
+def build_debug(rva, offset):
+    """Lays out a debug directory and the data of its entries at `rva`"""
+    guid, age, path = CODEVIEW
+    codeview = b"RSDS" + guid + struct.pack("<I", age) + path.encode() + b"\0"
+    feature = struct.pack("<IIIII", 0, 9, 9, 0, 0)
+    entries = [(IMAGE_DEBUG_TYPE_CODEVIEW, codeview),
+               (IMAGE_DEBUG_TYPE_VC_FEATURE, feature),
+               (IMAGE_DEBUG_TYPE_REPRO, b"")]
+
+    contents = bytearray(28 * len(entries))
+    for index, (debug_type, data) in enumerate(entries):
+        # Entries without data have neither an RVA nor a file offset
+        address = pointer = 0
+        if data:
+            contents += bytes(align(len(contents), 4) - len(contents))
+            address, pointer = rva + len(contents), offset + len(contents)
+        struct.pack_into("<IIHHIIII", contents, 28 * index, 0, 0x62193b26, 0, 0,
+                         debug_type, len(data), address, pointer)
+        contents += data
+
+    return bytes(contents), {IMAGE_DIRECTORY_ENTRY_DEBUG: (0, 28 * len(entries))}
+
+
+def build_guard(rva, pe32):
+    """Lays out a load config directory, its tables and a TLS directory"""
+    image_base = IMAGE_BASE32 if pe32 else IMAGE_BASE
+    address = "I" if pe32 else "Q"
+    text = 0x1000
+
+    # CFG targets every 16 bytes of .text, some of them suppressed
+    functions = [(text + 0x10 * index, IMAGE_GUARD_FLAG_FID_SUPPRESSED
+                  if index % 50 == 7 else 0) for index in range(100 if pe32 else 300)]
+    long_jumps = [(text + 0x108, 0), (text + 0x2a4, 0), (text + 0x400, 0)]
+    handlers = [text + 0x80, text + 0x90, text + 0x240, text + 0x900]
+
+    flags_size = 0 if pe32 else 1
+    guard_flags = (IMAGE_GUARD_CF_INSTRUMENTED | IMAGE_GUARD_CF_FUNCTION_TABLE_PRESENT
+                   | flags_size << 28)
+    if not pe32:
+        guard_flags |= IMAGE_GUARD_CF_LONGJUMP_TABLE_PRESENT
+
+    config_size = 0x5C if pe32 else 0x118
+    contents = bytearray(config_size)
+
+    def append(data):
+        contents.extend(bytes(align(len(contents), 8) - len(contents)))
+        position = len(contents)
+        contents.extend(data)
+        return image_base + rva + position
+
+    def table(entries):
+        return append(b"".join(struct.pack("<I", target)
+                               + bytes([flags])[:flags_size]
+                               for target, flags in entries))
+
+    cookie = append(struct.pack("<" + address,
+                                0xBB40E64E if pe32 else 0x2B992DDFA232))
+    function_table = table(functions)
+    if pe32:
+        handler_table = append(b"".join(struct.pack("<I", handler)
+                                        for handler in handlers))
+    else:
+        long_jump_table = table(long_jumps)
+
+    tls_data = append(b"TLS data")
+    tls_index = append(bytes(4))
+    callbacks = [image_base + text + 0x20, image_base + text + 0x30][:1 if pe32 else 2]
+    callback_array = append(b"".join(struct.pack("<" + address, callback)
+                                     for callback in callbacks + [0]))
+    tls = append(struct.pack("<" + address * 4 + "II", tls_data, tls_data + 8,
+                             tls_index, callback_array, 8, 0))
+    tls_size = 24 if pe32 else 40
+
+    # Size, the fields up to the security cookie are 0
+    struct.pack_into("<I", contents, 0, config_size)
+    if pe32:
+        struct.pack_into("<IIIIIII", contents, 0x3C, cookie, handler_table,
+                         len(handlers), 0, 0, function_table, len(functions))
+        struct.pack_into("<I", contents, 0x58, guard_flags)
+        directory_size = 0x40
+    else:
+        struct.pack_into("<QQQQQQQ", contents, 0x58, cookie, 0, 0, 0, 0,
+                         function_table, len(functions))
+        struct.pack_into("<I", contents, 0x90, guard_flags)
+        struct.pack_into("<QQ", contents, 0xB0, long_jump_table, len(long_jumps))
+        directory_size = config_size
+
+    return bytes(contents), {IMAGE_DIRECTORY_ENTRY_LOAD_CONFIG: (0, directory_size),
+                             IMAGE_DIRECTORY_ENTRY_TLS: (tls - image_base - rva,
+                                                         tls_size)}
+
+
+def build_metadata(method_rvas):
+    """Lays out the metadata root and the streams of ASSEMBLY"""
+    strings = bytearray(b"\0")
+    string_offsets = {"": 0}
+    blobs = bytearray(b"\0")
+    blob_offsets = {b"": 0}
+
+    def string(value):
+        if value not in string_offsets:
+            string_offsets[value] = len(strings)
+            strings.extend(value.encode() + b"\0")
+        return string_offsets[value]
+
+    def blob(value):
+        if value not in blob_offsets:
+            blob_offsets[value] = len(blobs)
+            blobs.extend(bytes([len(value)]) + value)
+        return blob_offsets[value]
+
+    user_strings = bytearray(b"\0")
+    for value in USER_STRINGS:
+        encoded = value.encode("utf-16-le")
+        # The last byte is 1 if the string has characters other than ASCII
+        user_strings.extend(bytes([len(encoded) + 1]) + encoded + b"\0")
+
+    # Strings are 4 byte indexes, the other heaps and the indexes 2 bytes
+    heap_sizes = 0x01
+    formats = {"u16": "<H", "u32": "<I", "string": "<I", "guid": "<H",
+               "blob": "<H", "index": "<H"}
+    valid = 0
+    rows = bytearray()
+    tables = bytearray()
+    for number, _, columns, table_rows in ASSEMBLY:
+        valid |= 1 << number
+        rows.extend(struct.pack("<I", len(table_rows)))
+        for row in table_rows:
+            for kind, value in zip(columns, row):
+                if kind == "string":
+                    value = string(value)
+                elif kind == "blob":
+                    value = blob(value)
+                elif number == 0x06 and kind == "u32":
+                    value = method_rvas[value]
+                tables.extend(struct.pack(formats[kind], value))
+
+    sorted_tables = 0x000016003325FA00
+    table_stream = (struct.pack("<IBBBBQQ", 0, 2, 0, heap_sizes, 1, valid,
+                                sorted_tables) + rows + tables)
+
+    streams = [("#~", table_stream), ("#Strings", strings),
+               ("#US", user_strings), ("#GUID", MVID), ("#Blob", blobs)]
+
+    version = b"v4.0.30319"
+    version_length = align(len(version) + 1, 4)
+    header_size = 16 + version_length + 4
+    for name, _ in streams:
+        header_size += 8 + align(len(name) + 1, 4)
+
+    root = bytearray(struct.pack("<IHHII", 0x424A5342, 1, 1, 0, version_length))
+    root += version + bytes(version_length - len(version))
+    root += struct.pack("<HH", 0, len(streams))
+    offset = header_size
+    for name, data in streams:
+        root += struct.pack("<II", offset, align(len(data), 4))
+        root += name.encode() + bytes(align(len(name) + 1, 4) - len(name))
+        offset += align(len(data), 4)
+    for _, data in streams:
+        root += bytes(data) + bytes(align(len(data), 4) - len(data))
+
+    return bytes(root)
+
+
+def build_clr(rva):
+    """Lays out the CLI header, the method bodies and the metadata at `rva`"""
+    contents = bytearray(72)
+
+    method_rvas = {}
+    for name, code in METHODS.items():
+        contents += bytes(align(len(contents), 4) - len(contents))
+        method_rvas[name] = rva + len(contents)
+        # Tiny header, the size of the code and CorILMethod_TinyFormat
+        contents += bytes([len(code) << 2 | 2]) + code
+
+    contents += bytes(align(len(contents), 4) - len(contents))
+    metadata_offset = len(contents)
+    metadata = build_metadata(method_rvas)
+    contents += metadata
+
+    struct.pack_into("<IHHIIII", contents, 0, 72, 2, 5, rva + metadata_offset,
+                     len(metadata), COMIMAGE_FLAGS_ILONLY, 0x06000001)
+
+    return bytes(contents), {IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR: (0, 72)}
+
+
+def build_image(sections, directories, pe32=False, bound_imports=b"", dll=False):
+    """Builds a PE32+ image, or a PE32 image if `pe32` is true
+
+    `sections` is a list of (name, characteristics, builder), the builder gets
+    the RVA and the file offset of the section and returns its contents, or
+    its contents and a
+    dictionary from the index of a data directory to its offset in the
+    section and its size. `directories` maps the index of a data directory to
+    the name of the section it covers. `bound_imports` is written after the
+    section table. `dll` sets IMAGE_FILE_DLL.
+    """
+    optional_size = 224 if pe32 else 240
+    bound_offset = 0x40 + 4 + 20 + optional_size + 40 * len(sections)
+    headers_size = align(bound_offset + len(bound_imports), FILE_ALIGNMENT)
+
+    data_directories = [(0, 0)] * 16
+    layout = []
+    rva = SECTION_ALIGNMENT
+    file_offset = headers_size
+    for name, characteristics, builder in sections:
+        contents = builder(rva, file_offset)
+        if isinstance(contents, tuple):
+            contents, section_directories = contents
+            for index, (offset, size) in section_directories.items():
+                data_directories[index] = (rva + offset, size)
+        raw_size = align(len(contents), FILE_ALIGNMENT)
+        layout.append((name, characteristics, contents, rva, file_offset, raw_size))
+        rva += align(len(contents), SECTION_ALIGNMENT)
+        file_offset += raw_size
+    image_size = rva
+
+    image = bytearray(file_offset)
+    struct.pack_into("<2s58xI", image, 0, b"MZ", 0x40)
+    struct.pack_into("<4s", image, 0x40, b"PE\0\0")
+    struct.pack_into("<HHIIIHH", image, 0x44, 0x14c if pe32 else 0x8664,
+                     len(sections), 0, 0, 0, optional_size,
+                     (0x102 if pe32 else 0x22) | (0x2000 if dll else 0))
+
+    if bound_imports:
+        data_directories[IMAGE_DIRECTORY_ENTRY_BOUND_IMPORT] = (bound_offset,
+                                                                len(bound_imports))
+        image[bound_offset:bound_offset + len(bound_imports)] = bound_imports
+
+    for index, section_name in directories.items():
+        for name, _, contents, section_rva, _, _ in layout:
+            if name == section_name:
+                data_directories[index] = (section_rva, len(contents))
+
+    code = next(entry for entry in layout if entry[0] == ".text")
+    if pe32:
+        optional = struct.pack("<HBBIIIIIIIIIHHHHHHIIIIHHIIIIII", 0x10B, 14, 0,
+                               code[5], 0, 0, code[3], code[3], 0, IMAGE_BASE32,
+                               SECTION_ALIGNMENT, FILE_ALIGNMENT, 6, 0, 0, 0, 6,
+                               0, 0, image_size, headers_size, 0, 3, 0x8140,
+                               0x100000, 0x1000, 0x100000, 0x1000, 0, 16)
+    else:
+        optional = struct.pack("<HBBIIIIIQIIHHHHHHIIIIHHQQQQII", 0x20B, 14, 0,
+                               code[5], 0, 0, code[3], code[3], IMAGE_BASE,
+                               SECTION_ALIGNMENT, FILE_ALIGNMENT, 6, 0, 0, 0, 6,
+                               0, 0, image_size, headers_size, 0, 3, 0x8160,
+                               0x100000, 0x1000, 0x100000, 0x1000, 0, 16)
+    optional += b"".join(struct.pack("<II", *entry) for entry in data_directories)
+    image[0x58:0x58 + len(optional)] = optional
+
+    position = 0x58 + len(optional)
+    for name, characteristics, contents, section_rva, offset, raw_size in layout:
+        struct.pack_into("<8sIIIIIIHHI", image, position, name.encode(),
+                         len(contents), section_rva, raw_size, offset, 0, 0, 0, 0,
+                         characteristics)
+        image[offset:offset + len(contents)] = contents
+        position += 40
+
+    return bytes(image)
+
+
+def text_section():
+    return (".text", IMAGE_SCN_CNT_CODE | IMAGE_SCN_MEM_EXECUTE | IMAGE_SCN_MEM_READ,
+            lambda rva, offset: b"\xc3")
+
+
+def make_resources(res_file):
+    with open(res_file, "rb") as file:
+        resources = read_res(file.read())
+
+    return build_image([text_section(),
+                        (".rsrc", IMAGE_SCN_CNT_INITIALIZED_DATA | IMAGE_SCN_MEM_READ,
+                         lambda rva, offset: build_rsrc(resources, rva))],
+                       {IMAGE_DIRECTORY_ENTRY_RESOURCE: ".rsrc"})
+
+
+def make_imports():
+    return build_image([text_section(),
+                        (".idata", IMAGE_SCN_CNT_INITIALIZED_DATA | IMAGE_SCN_MEM_READ,
+                         lambda rva, offset: build_imports(IMPORTS, rva, True))],
+                       {}, pe32=True)
+
+
+def make_debug():
+    return build_image([text_section(),
+                        (".rdata", IMAGE_SCN_CNT_INITIALIZED_DATA | IMAGE_SCN_MEM_READ,
+                         build_debug)],
+                       {})
+
+
+def make_guard(pe32):
+    return build_image([text_section(),
+                        (".rdata", IMAGE_SCN_CNT_INITIALIZED_DATA | IMAGE_SCN_MEM_READ,
+                         lambda rva, offset: build_guard(rva, pe32))],
+                       {}, pe32=pe32)
+
+
+def make_clr():
+    return build_image([(".text", IMAGE_SCN_CNT_CODE | IMAGE_SCN_MEM_EXECUTE
+                         | IMAGE_SCN_MEM_READ, lambda rva, offset: build_clr(rva))],
+                       {}, pe32=True)
+
+
+def make_delay():
+    imports = [("KERNEL32.dll", ["ExitProcess"])]
+    return build_image([text_section(),
+                        (".idata", IMAGE_SCN_CNT_INITIALIZED_DATA | IMAGE_SCN_MEM_READ,
+                         lambda rva, offset: build_imports(imports, rva, True)),
+                        (".didat", IMAGE_SCN_CNT_INITIALIZED_DATA | IMAGE_SCN_MEM_READ,
+                         lambda rva, offset: build_delay_imports(DELAY_IMPORTS, rva))],
+                       {}, pe32=True, bound_imports=build_bound_imports(BOUND_IMPORTS))
+
+
+def make_depends(image):
+    name, imports, delay_imports, exports = DEPENDS[image]
+    data = IMAGE_SCN_CNT_INITIALIZED_DATA | IMAGE_SCN_MEM_READ
+    sections = [text_section()]
+    if exports:
+        sections.append((".edata", data,
+                         lambda rva, offset: build_exports(name, exports, rva)))
+    if imports:
+        sections.append((".idata", data,
+                         lambda rva, offset: build_imports(imports, rva, True)))
+    if delay_imports:
+        sections.append((".didat", data,
+                         lambda rva, offset: build_delay_imports(delay_imports, rva)))
+    return build_image(sections, {}, pe32=True, dll=name.endswith(".dll"))
+
+
+def make_api_set_schema():
+    return build_image([text_section(),
+                        (".apiset", IMAGE_SCN_CNT_INITIALIZED_DATA | IMAGE_SCN_MEM_READ,
+                         lambda rva, offset: build_api_sets(API_SETS))],
+                       {}, pe32=True, dll=True)
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+
+    if sys.argv[1] == "resources" and len(sys.argv) == 4:
+        image = make_resources(sys.argv[2])
+    elif sys.argv[1] == "imports" and len(sys.argv) == 3:
+        image = make_imports()
+    elif sys.argv[1] == "debug" and len(sys.argv) == 3:
+        image = make_debug()
+    elif sys.argv[1] in ("guard", "guard32") and len(sys.argv) == 3:
+        image = make_guard(sys.argv[1] == "guard32")
+    elif sys.argv[1] == "clr" and len(sys.argv) == 3:
+        image = make_clr()
+    elif sys.argv[1] == "delay" and len(sys.argv) == 3:
+        image = make_delay()
+    elif sys.argv[1] in DEPENDS and len(sys.argv) == 3:
+        image = make_depends(sys.argv[1])
+    elif sys.argv[1] == "apisetschema" and len(sys.argv) == 3:
+        image = make_api_set_schema()
+    else:
+        sys.exit(__doc__)
+
+    with open(sys.argv[-1], "wb") as file:
+        file.write(image)
+
+
+if __name__ == "__main__":
+    main()
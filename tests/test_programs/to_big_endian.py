@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""Converts a little endian ELF file into its big endian equivalent.
+
+binutils can't change the endianness of an x86 image and there is no cross
+toolchain in the test environment, so the big endian test programs are built
+from the little endian ones by byte swapping every structure Pelf reads (Elf
+header, program header table, section table, symbol tables and notes).
+Section contents (code, strings) are copied unchanged.
+
+  ./to_big_endian.py hello32_elf hello32_be_elf
+  ./to_big_endian.py hello_elf hello_be_elf
+"""
+
+import struct
+import sys
+
+# Field layouts without the byte order prefix
+LAYOUTS = {
+    1: {"ehdr": "16sHHIIIIIHHHHHH", "phdr": "IIIIIIII",
+        "shdr": "IIIIIIIIII", "sym": "IIIBBH"},
+    2: {"ehdr": "16sHHIQQQIHHHHHH", "phdr": "IIQQQQQQ",
+        "shdr": "IIQQQQIIQQ", "sym": "IBBHQQ"},
+}
+
+SHT_SYMTAB = 2
+SHT_NOTE = 7
+SHT_DYNSYM = 11
+
+
+def swap(data, offset, layout):
+    values = struct.unpack_from("<" + layout, data, offset)
+    struct.pack_into(">" + layout, data, offset, *values)
+    return values
+
+
+def convert(data):
+    data = bytearray(data)
+    if data[:4] != b"\x7fELF" or data[5] != 1:
+        sys.exit("Not a little endian ELF file")
+
+    layout = LAYOUTS[data[4]]
+    ehdr = swap(data, 0, layout["ehdr"])
+    data[5] = 2  # ELFDATA2MSB
+
+    phoff, shoff = ehdr[5], ehdr[6]
+    phentsize, phnum, shentsize, shnum = ehdr[9], ehdr[10], ehdr[11], ehdr[12]
+
+    for i in range(phnum):
+        swap(data, phoff + i * phentsize, layout["phdr"])
+
+    for i in range(shnum):
+        shdr = swap(data, shoff + i * shentsize, layout["shdr"])
+        sh_type = shdr[1]
+        offset, size = shdr[4], shdr[5]
+        entsize = shdr[9]
+
+        if sh_type in (SHT_SYMTAB, SHT_DYNSYM):
+            for entry in range(offset, offset + size, entsize):
+                swap(data, entry, layout["sym"])
+        elif sh_type == SHT_NOTE:
+            entry = offset
+            while entry + 12 <= offset + size:
+                namesz, descsz, _ = swap(data, entry, "III")
+                entry += 12 + (namesz + 3) // 4 * 4 + (descsz + 3) // 4 * 4
+
+    return bytes(data)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    with open(sys.argv[1], "rb") as source:
+        data = convert(source.read())
+    with open(sys.argv[2], "wb") as target:
+        target.write(data)
+
+
+if __name__ == "__main__":
+    main()
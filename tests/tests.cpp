@@ -3,12 +3,52 @@
 
 #include <cstdint>
 #include <array>
+#include <memory_resource>
+#include <new>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <atomic>
+#include <sstream>
 
 
 #include "hello.h"// Header file with program content as an std::array (for PE)
 #include "hello_elf.h"// header file with program content for ELF
+#include "hello32.h"// PE32 program content
+#include "hello32_elf.h"// 32-bit ELF program content
+#include "hello32_be_elf.h"// big endian copy of hello32_elf
+#include "hello32_stripped.h"// hello32_elf stripped, with a debug link
+#include "hello_debug.h"// ELF with DWARF debug information
+#include "hello_zdebug.h"// hello_debug with zlib compressed debug sections
+#include "hello_debug4.h"// hello_debug with DWARF 4 debug information
+#include "hello_ranges.h"// compilation units with range lists, no aranges
+#include "libdebug.h"// static library with two object files
+#include "libdebug_thin.h"// thin archive of the same object files
+#include "crash_core.h"// core dump of a program killed by SIGSEGV
+#include "coff_object.h"// COFF object file built with llvm-mc
+#include "resources.h"// PE32+ image with a resource tree
+#include "imports.h"// PE32 image that imports by name and by ordinal
+#include "debug_pe.h"// PE32+ image with a CodeView record
+#include "guard.h"// PE32+ image with /guard:cf tables and TLS callbacks
+#include "guard32.h"// PE32 image with a SafeSEH table and TLS callbacks
+#include "clr.h"// PE32 .NET assembly
+#include "delay.h"// PE32 with delay and bound imports
+#include "depends_app.h"// Directory of the dependency graph
+#include "depends_kernel32.h"
+#include "depends_ntdll.h"
+#include "apisetschema.h"
 
 #include "pelfParser.h"
+#include "debugFileIndex.h"
+#include "sectionCache.h"
+#include "dwarfLine.h"
+#include "dwarfUnits.h"
+#include "ehFrame.h"
+#include "archive.h"
+#include "coreFile.h"
+#include "pdbSignatures.h"
+#include "peDependencyGraph.h"
 
 
 namespace hana = boost::hana;
@@ -132,6 +172,18 @@ TEST_CASE("Test Pe sections")
   REQUIRE(compile_coff.NumberOfSections == compile_sections.size());
 
   REQUIRE(runtime_sections.size() == compile_sections.size());
+
+  /* First section is .text at RVA 0x1000, raw data at file offset 0x400 */
+  static constexpr auto text = compile_sections.at(0);
+  REQUIRE(text.Name == 0x747865742eULL);// ".text" read as little endian
+  REQUIRE(text.VirtualAddress == 0x1000);
+  REQUIRE(text.PointerToRawData == 0x400);
+
+  BOOST_HANA_RUNTIME_CHECK(hana::equal(text, runtime_sections.at(0)));
+
+  /* Last section is .reloc */
+  REQUIRE(runtime_sections.at(5).VirtualAddress == 0x3e000);
+  REQUIRE(runtime_sections.at(5).PointerToRawData == 0x38a00);
 }
 
 
@@ -155,6 +207,36 @@ TEST_CASE("Test Pe and ELF Constructor exceptions")
   REQUIRE_THROWS_AS(pelf::Elf{ hello_program }, pelf::PelfException);
 
   REQUIRE_THROWS_AS(pelf::Pe{ hello_program_elf }, pelf::PelfException);
+
+  /* The number of entries is checked against the file before the tables are
+   * allocated */
+  const auto write = [](std::vector<unsigned char>& bytes,
+                       std::size_t offset,
+                       std::uint64_t value,
+                       std::size_t size) {
+    for (std::size_t i{}; i < size; ++i) {
+      bytes[offset + i] = static_cast<unsigned char>(value >> (i * 8));
+    }
+  };
+  const auto section_table =
+    pelf::Elf{ hello_program_elf }.getHeaders().elfHeader.e_shoff;
+
+  std::vector<unsigned char> many_sections(
+    hello_program_elf.begin(), hello_program_elf.end());
+  write(many_sections, 60, 0, 2);
+  write(many_sections, section_table + 32, 0xffffffffffffff, 8);
+  REQUIRE_THROWS_AS(pelf::Elf{ many_sections }, pelf::PelfException);
+
+  std::vector<unsigned char> many_headers(
+    hello_program_elf.begin(), hello_program_elf.end());
+  write(many_headers, 56, 0xffff, 2);
+  write(many_headers, section_table + 44, 0xffffffff, 4);
+  REQUIRE_THROWS_AS(pelf::Elf{ many_headers }, pelf::PelfException);
+
+  std::vector<unsigned char> truncated(
+    hello_program_elf.begin(), hello_program_elf.end());
+  truncated.resize(section_table + 64 * 10);
+  REQUIRE_THROWS_AS(pelf::Elf{ truncated }, pelf::PelfException);
 }
 
 TEST_CASE("Test ELF header parsing")
@@ -193,4 +275,2153 @@ TEST_CASE("Test ELF header parsing")
   /* Checking table offsets */
   REQUIRE(elf_header.e_phoff == 64);
   REQUIRE(elf_header.e_shoff == 15496);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test ELF section columns")
+{
+  pelf::Elf runtime_elf{ hello_program_elf };
+
+  const auto sections = runtime_elf.getSections();
+  const auto columns = runtime_elf.getSectionColumns();
+
+  REQUIRE(sections.size() == elf_tables_size.sectionTable);
+  REQUIRE(columns.size() == sections.size());
+  REQUIRE(columns.offsets()[13] == sections.at(13).sh_offset);
+
+  /* .init, .plt, .text and .fini are the only executable sections */
+  const auto executable = columns.filter(pelf::SHF_EXECINSTR);
+  REQUIRE(executable == std::vector<std::size_t>{ 11, 12, 13, 14 });
+
+  /* Only .text is bigger than 0x100 bytes */
+  REQUIRE(columns.filter(pelf::SHF_EXECINSTR, 0x100)
+          == std::vector<std::size_t>{ 13 });
+
+  /* .text starts at 0x1070 (offset) and 0x401070 (address) */
+  REQUIRE(columns.findByOffset(0x1075) == 13);
+  REQUIRE(columns.findByAddress(0x401075) == 13);
+
+  /* .bss is SHT_NOBITS, and nothing is mapped at address 0 */
+  REQUIRE(columns.findByAddress(0x404090) == 24);
+  REQUIRE(columns.findByAddress(0) == pelf::SectionColumns::npos);
+  REQUIRE(columns.findByOffset(0xffffff) == pelf::SectionColumns::npos);
+}
+
+
+TEST_CASE("Test parsing into a memory resource")
+{
+  /* Every table must come from `arena`, the upstream resource throws if the
+   * buffer is exhausted */
+  std::array<std::byte, 16384> buffer{};
+  std::pmr::monotonic_buffer_resource arena{ buffer.data(),
+    buffer.size(),
+    std::pmr::null_memory_resource() };
+
+  const pelf::pmr::Elf<decltype(hello_program_elf)> elf{ hello_program_elf,
+    &arena };
+  const pelf::pmr::Pe<decltype(hello_program)> pe{ hello_program, &arena };
+
+  REQUIRE(elf.getAllocator().resource() == &arena);
+  REQUIRE(pe.getAllocator().resource() == &arena);
+
+  REQUIRE(elf.getSections().size() == elf_tables_size.sectionTable);
+  REQUIRE(elf.getHeaders().programHeaders.size()
+          == elf_tables_size.programTable);
+  REQUIRE(pe.getSections().size() == 6);
+
+  BOOST_HANA_RUNTIME_CHECK(
+    hana::equal(elf.getHeaders().elfHeader, compile_elf.getHeaders().elfHeader));
+
+  /* An arena that is too small proves the tables are not allocated with the
+   * default allocator */
+  std::array<std::byte, 64> small_buffer{};
+  std::pmr::monotonic_buffer_resource small_arena{ small_buffer.data(),
+    small_buffer.size(),
+    std::pmr::null_memory_resource() };
+
+  REQUIRE_THROWS_AS(
+    pelf::pmr::Elf<decltype(hello_program_elf)>(hello_program_elf, &small_arena),
+    std::bad_alloc);
+}
+
+
+TEST_CASE("Test format detection and pelf::open")
+{
+  static_assert(pelf::detectFormat(hello_program) == pelf::FileFormat::Pe);
+  static_assert(pelf::detectFormat(hello_program_elf) == pelf::FileFormat::Elf);
+
+  const std::vector<unsigned char> archive{ '!', '<', 'a', 'r', 'c', 'h', '>',
+    '\n', '/', ' ', ' ' };
+  const std::vector<unsigned char> macho{ 0xcf, 0xfa, 0xed, 0xfe, 0x07, 0x00 };
+  const std::vector<unsigned char> garbage{ 'M', 'Z', 0x00 };
+
+  REQUIRE(pelf::detectFormat(archive) == pelf::FileFormat::Archive);
+  REQUIRE(pelf::detectFormat(macho) == pelf::FileFormat::MachO);
+  REQUIRE(pelf::detectFormat(garbage) == pelf::FileFormat::Unknown);
+
+  const auto pe = pelf::open(hello_program);
+  REQUIRE(pe.index() == 0);
+  REQUIRE(std::get<0>(pe).getHeaders().getCoffHeader().Machine == 0x8664);
+
+  const auto elf = pelf::open(hello_program_elf);
+  REQUIRE(elf.index() == 1);
+  REQUIRE(std::get<1>(elf).getHeaders().elfHeader.e_entry == 0x4010c0);
+
+  /* Recognized but unsupported formats don't throw */
+  const auto unknown = pelf::open(archive);
+  REQUIRE(std::holds_alternative<pelf::Unknown>(unknown));
+  REQUIRE(std::get<pelf::Unknown>(unknown).format == pelf::FileFormat::Archive);
+
+  REQUIRE(std::get<pelf::Unknown>(pelf::open(garbage)).format
+          == pelf::FileFormat::Unknown);
+}
+
+
+TEST_CASE("Test 32-bit ELF parsing")
+{
+  static constexpr auto tables_size = pelf::getElfTablesSize(hello32_program_elf);
+  static_assert(tables_size.sectionTable == 7);
+  static_assert(tables_size.programTable == 4);
+
+  static constexpr pelf::Elf32<decltype(hello32_program_elf),
+    tables_size.sectionTable,
+    tables_size.programTable>
+    compile_elf32{ hello32_program_elf };
+
+  static constexpr auto elf_header = compile_elf32.getHeaders().elfHeader;
+  static constexpr auto sections = compile_elf32.getSections();
+
+  REQUIRE(elf_header.e_entry == 0x8049000);
+  REQUIRE(elf_header.e_shoff == 8456);
+  REQUIRE(sections.at(2).sh_addr == 0x8049000);
+  REQUIRE(sections.at(2).sh_flags == (pelf::SHF_ALLOC | pelf::SHF_EXECINSTR));
+
+  const pelf::Elf32 runtime_elf32{ hello32_program_elf };
+  BOOST_HANA_RUNTIME_CHECK(
+    hana::equal(runtime_elf32.getHeaders().elfHeader, elf_header));
+  REQUIRE(runtime_elf32.getHeaders().programHeaders.at(1).p_vaddr
+          == 0x8049000);
+  REQUIRE(runtime_elf32.getSectionColumns().findByAddress(0x8049010) == 2);
+
+  /* The class in e_ident must match the class of the parser */
+  REQUIRE_THROWS_AS(pelf::Elf{ hello32_program_elf }, pelf::pelfInvalidSignature);
+  REQUIRE_THROWS_AS(pelf::Elf32{ hello_program_elf }, pelf::pelfInvalidSignature);
+
+  REQUIRE(pelf::open(hello32_program_elf).index() == 3);
+}
+
+
+TEST_CASE("Test PE32 parsing")
+{
+  static constexpr auto sections = pelf::getPeNumberOfSections(hello32_program);
+  static_assert(sections == 3);
+
+  static constexpr pelf::Pe32<decltype(hello32_program), sections> compile_pe32{
+    hello32_program
+  };
+
+  static constexpr auto scf = compile_pe32.getHeaders().getStandardCoffFields();
+  static constexpr auto wsf = compile_pe32.getHeaders().getWindowsSpecificFields();
+
+  REQUIRE(scf.Magic == 0x10b);
+  REQUIRE(scf.BaseOfData == 0x2000);
+  REQUIRE(wsf.ImageBase == 0x400000);
+  REQUIRE(wsf.SizeOfStackReserve == 0x200000);
+  REQUIRE(compile_pe32.getHeaders().getDataDirectories().at(1).VirtualAddress
+          == 0x3000);
+  REQUIRE(compile_pe32.getSections().at(0).VirtualAddress == 0x1000);
+  REQUIRE(compile_pe32.getSections().at(0).PointerToRawData == 0x400);
+
+  const pelf::Pe32 runtime_pe32{ hello32_program };
+  BOOST_HANA_RUNTIME_CHECK(
+    hana::equal(runtime_pe32.getHeaders().getWindowsSpecificFields(), wsf));
+
+  /* The optional header magic must match the class of the parser */
+  REQUIRE_THROWS_AS(pelf::Pe{ hello32_program }, pelf::pelfInvalidSignature);
+  REQUIRE_THROWS_AS(pelf::Pe32{ hello_program }, pelf::pelfInvalidSignature);
+
+  REQUIRE(pelf::open(hello32_program).index() == 2);
+}
+
+
+TEST_CASE("Test big endian ELF parsing")
+{
+  REQUIRE(pelf::byteSwap(std::uint16_t{ 0x1234 }) == 0x3412);
+  REQUIRE(pelf::byteSwap(std::uint32_t{ 0x12345678 }) == 0x78563412);
+  REQUIRE(pelf::byteSwap(std::uint64_t{ 0x0102030405060708 })
+          == 0x0807060504030201);
+
+  static constexpr auto tables_size =
+    pelf::getElfTablesSize(hello32_program_be_elf);
+  static_assert(tables_size.sectionTable == 7);
+  static_assert(tables_size.programTable == 4);
+
+  static constexpr pelf::Elf32<decltype(hello32_program_be_elf),
+    tables_size.sectionTable,
+    tables_size.programTable,
+    std::endian::big>
+    compile_be{ hello32_program_be_elf };
+
+  static constexpr pelf::Elf32<decltype(hello32_program_elf),
+    tables_size.sectionTable,
+    tables_size.programTable>
+    compile_le{ hello32_program_elf };
+
+  static constexpr auto be_header = compile_be.getHeaders().elfHeader;
+  static constexpr auto le_header = compile_le.getHeaders().elfHeader;
+
+  REQUIRE(be_header.e_entry == 0x8049000);
+  REQUIRE(be_header.e_shoff == le_header.e_shoff);
+  REQUIRE(be_header.e_phnum == le_header.e_phnum);
+  /* e_ident is read as bytes, only EI_DATA is different */
+  REQUIRE(be_header.e_ident_high
+          == (le_header.e_ident_high ^ (std::uint64_t{ 3 } << 40)));
+  REQUIRE(be_header.e_ident_low == le_header.e_ident_low);
+
+  for (std::size_t i{}; i < tables_size.sectionTable; ++i) {
+    BOOST_HANA_RUNTIME_CHECK(hana::equal(
+      compile_be.getSections().at(i), compile_le.getSections().at(i)));
+  }
+
+  /* Runtime parsing swaps the fields after copying them */
+  const pelf::Elf32<decltype(hello32_program_be_elf), 0, 0, std::endian::big>
+    runtime_be{ hello32_program_be_elf };
+  BOOST_HANA_RUNTIME_CHECK(
+    hana::equal(runtime_be.getHeaders().elfHeader, be_header));
+
+  for (std::size_t i{}; i < tables_size.programTable; ++i) {
+    BOOST_HANA_RUNTIME_CHECK(
+      hana::equal(runtime_be.getHeaders().programHeaders.at(i),
+        compile_le.getHeaders().programHeaders.at(i)));
+  }
+  REQUIRE(runtime_be.getSectionColumns().findByAddress(0x8049010) == 2);
+
+  /* The byte order in e_ident must match the byte order of the parser */
+  REQUIRE_THROWS_AS(
+    pelf::Elf32{ hello32_program_be_elf }, pelf::pelfInvalidSignature);
+
+  REQUIRE(pelf::open(hello32_program_be_elf).index() == 5);
+}
+
+
+TEST_CASE("Test ELF notes and build ID")
+{
+  static constexpr std::array<unsigned char, 20> hello_build_id = { 0xf7,
+    0x10, 0x46, 0x3b, 0x82, 0xff, 0x5d, 0x96, 0x5b, 0xb9, 0x9e, 0xba, 0x3d,
+    0xbf, 0xd8, 0x75, 0xa5, 0x0e, 0x6a, 0x9b };
+
+  static constexpr auto tables_size = pelf::getElfTablesSize(hello_program_elf);
+  static constexpr pelf::Elf<decltype(hello_program_elf),
+    tables_size.sectionTable,
+    tables_size.programTable>
+    compile_elf{ hello_program_elf };
+
+  static constexpr auto compile_build_id = compile_elf.buildId();
+  static_assert(compile_build_id.size() == 20);
+  static_assert(compile_build_id[0] == 0xf7 && compile_build_id[19] == 0x9b);
+
+  /* A span over the data (e.g. a memory mapped file) isn't copied */
+  const std::span<const unsigned char> bytes{ hello_program_elf };
+  const pelf::Elf<std::span<const unsigned char>> elf{ bytes };
+  const auto build_id = elf.buildId();
+
+  REQUIRE(std::equal(build_id.begin(),
+    build_id.end(),
+    hello_build_id.begin(),
+    hello_build_id.end()));
+  REQUIRE(build_id.data() >= hello_program_elf.data());
+  REQUIRE(build_id.data() < hello_program_elf.data() + hello_program_elf.size());
+
+  /* hello_elf has two notes in its first PT_NOTE segment */
+  std::vector<std::uint32_t> types;
+  for (const auto& segment : elf.getHeaders().programHeaders) {
+    if (segment.p_type != pelf::PT_NOTE) { continue; }
+    for (const auto& note : elf.getNotes(segment)) {
+      REQUIRE(note.owner() == "GNU");
+      types.push_back(note.header.n_type);
+    }
+  }
+  REQUIRE(std::find(types.begin(), types.end(), pelf::NT_GNU_BUILD_ID)
+          != types.end());
+
+  /* Notes of big endian files are swapped too */
+  const pelf::Elf32 elf32{ hello32_program_elf };
+  const pelf::Elf32<decltype(hello32_program_be_elf), 0, 0, std::endian::big>
+    elf32_be{ hello32_program_be_elf };
+  const auto id32 = elf32.buildId();
+  const auto id32_be = elf32_be.buildId();
+  REQUIRE(id32.size() == 20);
+  REQUIRE(id32[0] == 0xa3);
+  REQUIRE(std::equal(id32.begin(), id32.end(), id32_be.begin(), id32_be.end()));
+
+  /* Truncated note */
+  const std::array<unsigned char, 16> truncated = { 4, 0, 0, 0, 20, 0, 0, 0, 3,
+    0, 0, 0, 'G', 'N', 'U', 0 };
+  const pelf::NoteRange notes{ std::span<const unsigned char>{ truncated } };
+  REQUIRE_THROWS_AS(notes.begin(), pelf::PelfException);
+}
+
+
+TEST_CASE("Test debug link and debug file index")
+{
+  static constexpr std::string_view check = "123456789";
+  REQUIRE(pelf::crc32(std::span{ reinterpret_cast<const unsigned char*>(
+                                   check.data()),
+            check.size() })
+          == 0xcbf43926);
+
+  const pelf::Elf32 stripped{ hello32_program_stripped };
+  REQUIRE(stripped.findSection(".text").has_value());
+  REQUIRE(stripped.getSectionName(stripped.getSections().at(1))
+          == ".note.gnu.build-id");
+
+  const auto link = stripped.debugLink();
+  REQUIRE(link.has_value());
+  REQUIRE(link->fileName == "hello32_elf");
+  REQUIRE(link->crc == pelf::crc32(hello32_program_elf));
+  REQUIRE_FALSE(pelf::Elf32{ hello32_program_elf }.debugLink().has_value());
+
+  /* Debug directory with two ELF files and a file that isn't ELF */
+  namespace fs = std::filesystem;
+  const fs::path root = fs::temp_directory_path() / "pelf_debug_index_test";
+  const fs::path index_file = root / "debug.index";
+  fs::remove_all(root);
+  fs::create_directories(root / "debug" / "sub");
+
+  const auto write_file = [](const fs::path& path, const auto& data) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()),
+      static_cast<std::streamsize>(data.size()));
+  };
+  write_file(root / "debug" / "hello32_elf", hello32_program_elf);
+  write_file(root / "debug" / "sub" / "hello_elf", hello_program_elf);
+  write_file(root / "debug" / "hello.exe", hello32_program);
+
+  /* A malformed ELF file is recorded without stopping the other workers, its
+   * section table is larger than the file */
+  std::vector<unsigned char> corrupt(
+    hello_program_elf.begin(), hello_program_elf.end());
+  const auto section_table =
+    pelf::Elf{ hello_program_elf }.getHeaders().elfHeader.e_shoff;
+  corrupt[60] = 0;
+  corrupt[61] = 0;
+  std::fill_n(corrupt.begin() + static_cast<std::ptrdiff_t>(section_table) + 32,
+    7,
+    0xff);
+  write_file(root / "debug" / "corrupt", corrupt);
+
+  auto stats = pelf::DebugFileIndex::update(root / "debug", index_file, 2);
+  REQUIRE(stats.scanned == 4);
+  REQUIRE(stats.parsed == 4);
+
+  {
+    const pelf::DebugFileIndex index{ index_file };
+    REQUIRE(index.size() == 4);
+
+    /* stripped binary -> debug file, by build ID and by debug link */
+    const auto by_build_id = index.findByBuildId(stripped.buildId());
+    REQUIRE(by_build_id.has_value());
+    REQUIRE(by_build_id->filename() == "hello32_elf");
+
+    const auto by_link = index.findByDebugLink(link->fileName, link->crc);
+    REQUIRE(by_link.has_value());
+    REQUIRE(*by_link == *by_build_id);
+
+    const auto elf64 = index.findByBuildId(pelf::Elf{ hello_program_elf }.buildId());
+    REQUIRE(elf64.has_value());
+    REQUIRE(elf64->filename() == "hello_elf");
+
+    REQUIRE_FALSE(index.findByDebugLink("hello32_elf", link->crc + 1));
+    REQUIRE_FALSE(index.findByDebugLink("hello.exe", 0));
+  }
+
+  /* Unchanged files are reused, removed files are dropped */
+  fs::remove(root / "debug" / "sub" / "hello_elf");
+  stats = pelf::DebugFileIndex::update(root / "debug", index_file);
+  REQUIRE(stats.reused == 3);
+  REQUIRE(stats.parsed == 0);
+  REQUIRE(stats.removed == 1);
+
+  /* A modified file is parsed again */
+  write_file(root / "debug" / "hello32_elf", hello_program_elf);
+  fs::last_write_time(root / "debug" / "hello32_elf",
+    fs::last_write_time(root / "debug" / "hello32_elf") + std::chrono::hours(1));
+  stats = pelf::DebugFileIndex::update(root / "debug", index_file);
+  REQUIRE(stats.parsed == 1);
+
+  const pelf::DebugFileIndex index{ index_file };
+  REQUIRE_FALSE(index.findByBuildId(stripped.buildId()).has_value());
+  REQUIRE(index.findByBuildId(pelf::Elf{ hello_program_elf }.buildId())
+            ->filename()
+          == "hello32_elf");
+
+  fs::remove_all(root);
+}
+
+
+TEST_CASE("Test compressed debug sections")
+{
+  const pelf::Elf debug{ std::span<const unsigned char>{ hello_program_debug } };
+  const pelf::Elf zdebug{ hello_program_zdebug };
+
+  const auto plain_info = *debug.findSection(".debug_info");
+  const auto compressed_info = *zdebug.findSection(".debug_info");
+
+  REQUIRE_FALSE(debug.isCompressed(plain_info));
+  REQUIRE(zdebug.isCompressed(compressed_info));
+  REQUIRE(zdebug.getCompressionHeader(compressed_info).ch_type
+          == pelf::ELFCOMPRESS_ZLIB);
+  REQUIRE(zdebug.getSectionSize(compressed_info) == plain_info.sh_size);
+  REQUIRE(zdebug.getSectionSize(compressed_info) > compressed_info.sh_size);
+
+  /* Sections that aren't compressed are returned without copying them */
+  std::vector<unsigned char> buffer;
+  const auto plain = debug.getSectionContents(plain_info, buffer);
+  REQUIRE(buffer.empty());
+  REQUIRE(plain.data() == hello_program_debug.data() + plain_info.sh_offset);
+
+#if defined(PELF_USE_ZLIB)
+  const auto inflated = zdebug.getSectionContents(compressed_info, buffer);
+  REQUIRE(std::equal(
+    inflated.begin(), inflated.end(), plain.begin(), plain.end()));
+
+  std::array<unsigned char, 16> small{};
+  REQUIRE_THROWS_AS(
+    zdebug.getSectionContents(compressed_info, std::span{ small }),
+    pelf::pelfInvalidSize);
+
+  /* ch_size is checked before the buffer is resized */
+  REQUIRE_THROWS_AS(zdebug.getSectionContents(compressed_info, buffer, 16),
+    pelf::pelfInvalidSize);
+
+  std::vector<unsigned char> huge(
+    hello_program_zdebug.begin(), hello_program_zdebug.end());
+  for (std::size_t i{ 8 }; i < 15; ++i) {
+    huge[compressed_info.sh_offset + i] = 0xff;
+  }
+  const pelf::Elf huge_zdebug{ huge };
+  std::vector<unsigned char> unused;
+  REQUIRE_THROWS_AS(huge_zdebug.getSectionContents(compressed_info, unused),
+    pelf::pelfInvalidSize);
+  REQUIRE(unused.empty());
+
+  /* Every compressed section decompressed in parallel and cached */
+  pelf::SectionCache cache{ zdebug };
+  cache.prefetch(4);
+  REQUIRE(cache.memoryUsage() > 0);
+
+  for (const auto& section : debug.getSections()) {
+    const auto name = debug.getSectionName(section);
+    if (!name.starts_with(".debug_")) { continue; }
+
+    const auto expected = debug.getSectionData(section);
+    const auto contents = cache.get(name);
+    REQUIRE(std::equal(
+      contents.begin(), contents.end(), expected.begin(), expected.end()));
+  }
+  REQUIRE(cache.get(".debug_info").data() == cache.get(".debug_info").data());
+#else
+  REQUIRE_THROWS_AS(
+    zdebug.getSectionContents(compressed_info, buffer), pelf::PelfException);
+#endif
+}
+
+
+TEST_CASE("Test DWARF line table")
+{
+  const pelf::Elf debug{ std::span<const unsigned char>{ hello_program_debug } };
+  const pelf::Elf debug4{ hello_program_debug4 };
+  pelf::SectionCache cache{ debug };
+  pelf::SectionCache cache4{ debug4 };
+
+  const auto debug_line = pelf::makeDebugLine(cache);
+  const auto debug_line4 = pelf::makeDebugLine(cache4);
+
+  /* One line program per compilation unit */
+  REQUIRE(std::distance(debug_line.begin(), debug_line.end()) == 2);
+  REQUIRE(std::distance(debug_line4.begin(), debug_line4.end()) == 2);
+
+  const auto program = *debug_line.begin();
+  REQUIRE(program.header().version == 5);
+  REQUIRE(program.header().addressSize == 8);
+  REQUIRE(program.header().directories.front() == "/root/repo/tests/test_programs");
+  REQUIRE(program.filePath(1) == "/root/repo/tests/test_programs/debug_main.c");
+  REQUIRE_FALSE(program.filePath(2).has_value());
+
+  const auto program4 = *debug_line4.begin();
+  REQUIRE(program4.header().version == 4);
+  REQUIRE(program4.header().lineBase == -5);
+  REQUIRE(program4.header().lineRange == 14);
+  REQUIRE(program4.filePath(1) == "debug_main.c");
+  REQUIRE_FALSE(program4.filePath(0).has_value());
+
+  /* The iterator and forEachRow() run the same state machine */
+  std::vector<pelf::LineRow> rows(program.begin(), program.end());
+  std::size_t count{};
+  program.forEachRow([&](const pelf::LineRow& row) {
+    REQUIRE(row.address == rows[count].address);
+    REQUIRE(row.line == rows[count].line);
+    ++count;
+  });
+  REQUIRE(count == rows.size());
+  REQUIRE(rows.front().address == 0x401000);
+  REQUIRE(rows.front().line == 39);
+  REQUIRE(rows.front().isStmt);
+  REQUIRE(rows.back().endSequence);
+  REQUIRE(rows.back().address == 0x401044);
+
+  for (const auto* line : { &debug_line, &debug_line4 }) {
+    const pelf::LineTable table{ *line };
+    REQUIRE(table.size() > 0);
+
+    auto location = table.lookup(0x401000);
+    REQUIRE(location);
+    REQUIRE(location->file.ends_with("debug_main.c"));
+    REQUIRE(location->line == 39);
+    REQUIRE(location->column == 1);
+
+    /* The last of the rows at the same address */
+    REQUIRE(table.lookup(0x401004)->line == 25);
+    REQUIRE(table.lookup(0x401043)->line == 34);
+
+    /* A sequence ends where the next one starts */
+    location = table.lookup(0x401044);
+    REQUIRE(location->file.ends_with("debug_util.c"));
+    REQUIRE(location->line == 6);
+
+    REQUIRE_FALSE(table.lookup(0x400fff));
+    REQUIRE(table.lookup(0x4010ce));
+    REQUIRE_FALSE(table.lookup(0x4010cf));
+
+    const std::array<std::uint64_t, 6> addresses{ 0x4010ce, 0x401000,
+      0x4010cf, 0x401044, 0x400000, 0x401004 };
+    std::array<std::optional<pelf::LineTable::Location>, addresses.size()>
+      locations;
+    table.lookup(addresses, locations);
+
+    for (std::size_t i{}; i < addresses.size(); ++i) {
+      const auto expected = table.lookup(addresses[i]);
+      REQUIRE(locations[i].has_value() == expected.has_value());
+      if (expected) {
+        REQUIRE(locations[i]->file == expected->file);
+        REQUIRE(locations[i]->line == expected->line);
+      }
+    }
+
+    std::array<std::optional<pelf::LineTable::Location>, 2> small;
+    REQUIRE_THROWS_AS(table.lookup(addresses, small), pelf::pelfInvalidSize);
+  }
+
+#if defined(PELF_USE_ZLIB)
+  /* Compressed sections are decompressed by the cache */
+  const pelf::Elf zdebug{ hello_program_zdebug };
+  pelf::SectionCache zcache{ zdebug };
+  const pelf::LineTable table{ pelf::makeDebugLine(zcache) };
+  REQUIRE(table.lookup(0x401000)->line == 39);
+#endif
+}
+
+
+TEST_CASE("Test DWARF compilation unit index")
+{
+  const pelf::Elf debug{ std::span<const unsigned char>{ hello_program_debug } };
+  const pelf::Elf debug4{ hello_program_debug4 };
+  const pelf::Elf ranges{ hello_program_ranges };
+  pelf::SectionCache cache{ debug };
+  pelf::SectionCache cache4{ debug4 };
+  pelf::SectionCache ranges_cache{ ranges };
+
+  pelf::CompileUnits units{ cache };
+  pelf::CompileUnits units4{ cache4 };
+  pelf::CompileUnits ranges_units{ ranges_cache };
+
+  /* Both units are in .debug_aranges, and .debug_info gives the same
+   * ranges */
+  const auto aranges = pelf::readAranges(units.sections().aranges);
+  const auto info_ranges = pelf::readUnitRanges(units.sections());
+  REQUIRE(aranges.size() == 2);
+  REQUIRE(info_ranges.size() == 2);
+  for (std::size_t i{}; i < aranges.size(); ++i) {
+    REQUIRE(aranges[i].low == info_ranges[i].low);
+    REQUIRE(aranges[i].high == info_ranges[i].high);
+    REQUIRE(aranges[i].unit == info_ranges[i].unit);
+  }
+  REQUIRE(aranges[1].unit == 0x1e5);
+
+  const auto check_units = [](auto& unit_index) {
+    REQUIRE(unit_index.index().size() == 2);
+
+    const auto main_unit = unit_index.find(0x401000);
+    REQUIRE(main_unit);
+    REQUIRE(main_unit->offset == 0);
+    REQUIRE(main_unit->name == "debug_main.c");
+    REQUIRE(main_unit->compDir == "/root/repo/tests/test_programs");
+    REQUIRE(main_unit->lowPc == 0x401000);
+    REQUIRE(main_unit->ranges.size() == 1);
+    REQUIRE(main_unit->ranges[0].high == 0x401044);
+
+    REQUIRE(unit_index.find(0x401044)->name == "debug_util.c");
+    REQUIRE_FALSE(unit_index.find(0x400fff));
+    REQUIRE_FALSE(unit_index.find(0x4010cf));
+  };
+  check_units(units);
+  check_units(units4);
+  REQUIRE(units.find(0x401000)->version == 5);
+  REQUIRE(units4.find(0x401000)->version == 4);
+
+  /* Only the line program of the unit that contains the address is decoded */
+  const auto util = units.find(0x4010a0);
+  REQUIRE(util->stmtList);
+  pelf::LineTable table;
+  table.add(*units.lineProgram(*util));
+  REQUIRE(table.lookup(0x4010a0)->file.ends_with("debug_util.c"));
+  REQUIRE_FALSE(table.lookup(0x401000));
+
+  /* Without .debug_aranges the index comes from the range lists */
+  REQUIRE(ranges_units.sections().aranges.empty());
+  REQUIRE(ranges_units.find(0x401000)->name == "debug_main.c");
+  REQUIRE(ranges_units.find(0x401043)->name == "debug_main.c");
+
+  const auto ranges_util = ranges_units.find(0x4010a0);
+  REQUIRE(ranges_util->name == "debug_util.c");
+  REQUIRE(ranges_util->lowPc == 0);
+  REQUIRE(ranges_util->ranges.size() == 2);
+  REQUIRE(ranges_util->ranges[0].low == 0x401044);
+  REQUIRE(ranges_util->ranges[1].low == 0x401093);
+  REQUIRE(ranges_util->ranges[1].high == 0x4010cf);
+
+  /* Contiguous ranges of the same unit are merged */
+  REQUIRE(ranges_units.index().size() == 2);
+  REQUIRE_FALSE(ranges_units.find(0x4010cf));
+
+  /* Overlapping ranges go to the unit that starts last */
+  const pelf::CompileUnitIndex overlapping{ { { 0x2000, 0x3000, 2 },
+    { 0x1000, 0x4000, 1 } } };
+  REQUIRE(overlapping.lookup(0x1800) == 1);
+  REQUIRE(overlapping.lookup(0x2800) == 2);
+  REQUIRE(overlapping.lookup(0x3000) == 1);
+  REQUIRE(overlapping.lookup(0x3800) == 1);
+  REQUIRE_FALSE(overlapping.lookup(0x4000));
+  REQUIRE(overlapping.size() == 3);
+
+  /* Ranges that only overlap partly, nested twice and of the same unit */
+  const pelf::CompileUnitIndex nested{ { { 0x1000, 0x5000, 1 },
+    { 0x2000, 0x4000, 2 },
+    { 0x2800, 0x3000, 3 },
+    { 0x3800, 0x6000, 4 },
+    { 0x5800, 0x6800, 4 },
+    { 0x7000, 0x7000, 5 } } };
+  REQUIRE(nested.lookup(0x1fff) == 1);
+  REQUIRE(nested.lookup(0x2000) == 2);
+  REQUIRE(nested.lookup(0x2900) == 3);
+  REQUIRE(nested.lookup(0x3000) == 2);
+  REQUIRE(nested.lookup(0x3800) == 4);
+  REQUIRE(nested.lookup(0x4800) == 4);
+  REQUIRE(nested.lookup(0x6400) == 4);
+  REQUIRE_FALSE(nested.lookup(0x6800));
+  REQUIRE_FALSE(nested.lookup(0x7000));
+  REQUIRE(nested.size() == 5);
+
+  /* DW_AT_low_pc and DW_AT_high_pc as indices into .debug_addr */
+  static constexpr std::array<unsigned char, 11> addrx_abbrev{ 0x01, 0x11,
+    0x00, 0x11, 0x29, 0x12, 0x29, 0x73, 0x17, 0x00, 0x00 };
+  static constexpr std::array<unsigned char, 19> addrx_info{ 0x0f, 0x00,
+    0x00, 0x00, 0x05, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+    0x01, 0x08, 0x00, 0x00, 0x00 };
+  static constexpr std::array<unsigned char, 24> addrx_addr{ 0x14, 0x00,
+    0x00, 0x00, 0x05, 0x00, 0x08, 0x00, 0x00, 0x10, 0x40, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x12, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00 };
+  pelf::DwarfSections addrx_sections;
+  addrx_sections.info = addrx_info;
+  addrx_sections.abbrev = addrx_abbrev;
+  addrx_sections.addr = addrx_addr;
+  const auto addrx_unit = pelf::readCompileUnit(addrx_sections, 0);
+  REQUIRE(addrx_unit.lowPc == 0x401000);
+  REQUIRE(addrx_unit.ranges.size() == 1);
+  REQUIRE(addrx_unit.ranges[0].low == 0x401000);
+  REQUIRE(addrx_unit.ranges[0].high == 0x401200);
+}
+
+
+TEST_CASE("Test .eh_frame_hdr and call frame rules")
+{
+  using Rule = pelf::RegisterRuleKind;
+  constexpr std::uint32_t rbx{ 3 };
+  constexpr std::uint32_t rbp{ 6 };
+  constexpr std::uint32_t rsp{ 7 };
+  constexpr std::uint32_t r15{ 15 };
+  constexpr std::uint32_t ra{ 16 };
+
+  /* hello_debug has 3 FDEs, the first function pushes a register */
+  const pelf::Elf debug{ hello_program_debug };
+  auto debug_hdr = debug.ehFrameHdr();
+  REQUIRE(debug_hdr);
+  REQUIRE(debug_hdr->size() == 3);
+  REQUIRE(debug_hdr->entry(0).initialLocation == 0x401000);
+  REQUIRE(debug_hdr->entry(2).initialLocation == 0x401093);
+
+  const auto start = debug_hdr->find(0x401010);
+  REQUIRE(start);
+  REQUIRE(start->initialLocation == 0x401000);
+  REQUIRE(start->addressRange == 0x44);
+  REQUIRE(start->cie.augmentation == "zR");
+  REQUIRE(start->cie.codeAlignment == 1);
+  REQUIRE(start->cie.dataAlignment == -8);
+
+  const auto first_row = debug_hdr->unwindRow(0x401003);
+  REQUIRE(first_row->cfa.reg == rsp);
+  REQUIRE(first_row->cfa.offset == 8);
+  REQUIRE(first_row->endLocation == 0x401004);
+  REQUIRE(first_row->rule(ra).kind == Rule::offset);
+  REQUIRE(first_row->rule(ra).value == -8);
+
+  const auto pushed_row = debug_hdr->unwindRow(0x401004);
+  REQUIRE(pushed_row->location == 0x401004);
+  REQUIRE(pushed_row->cfa.offset == 16);
+  REQUIRE(pushed_row->endLocation == 0x401044);
+
+  REQUIRE(debug_hdr->find(0x4010ce)->initialLocation == 0x401093);
+  REQUIRE_FALSE(debug_hdr->find(0x4010cf));
+  REQUIRE_FALSE(debug_hdr->find(0x400fff));
+
+  /* hello_elf: frame pointers, a PLT with a CFA expression and _start */
+  const std::span<const unsigned char> bytes{ hello_program_elf };
+  const pelf::Elf<std::span<const unsigned char>> elf{ bytes };
+  auto hdr = elf.ehFrameHdr();
+  REQUIRE(hdr);
+  REQUIRE(hdr->size() == 14);
+  REQUIRE(hdr->frame().address() == 0x402090);
+  REQUIRE(hdr->frame().data().data() == hello_program_elf.data() + 0x2090);
+
+  for (std::size_t i{ 1 }; i < hdr->size(); ++i) {
+    REQUIRE(hdr->entry(i - 1).initialLocation < hdr->entry(i).initialLocation);
+  }
+
+  const auto frame_row = hdr->unwindRow(0x401080);
+  REQUIRE(frame_row->location == 0x401074);
+  REQUIRE(frame_row->endLocation == 0x4010a7);
+  REQUIRE(frame_row->cfa.kind == pelf::CfaRuleKind::registerOffset);
+  REQUIRE(frame_row->cfa.reg == rbp);
+  REQUIRE(frame_row->cfa.offset == 16);
+  REQUIRE(frame_row->rule(rbp).kind == Rule::offset);
+  REQUIRE(frame_row->rule(rbp).value == -16);
+  REQUIRE(hdr->unwindRow(0x4010a7)->cfa.reg == rsp);
+  REQUIRE(hdr->unwindRow(0x401070)->rule(rbp).kind == Rule::unspecified);
+
+  const auto plt_row = hdr->unwindRow(0x401040);
+  REQUIRE(plt_row->location == 0x401030);
+  REQUIRE(plt_row->cfa.kind == pelf::CfaRuleKind::expression);
+  REQUIRE_FALSE(plt_row->cfa.expression.empty());
+
+  REQUIRE(hdr->unwindRow(0x4010c4)->rule(ra).kind == Rule::undefined);
+
+  const auto saved_row = hdr->unwindRow(0x401340);
+  REQUIRE(saved_row->cfa.offset == 64);
+  REQUIRE(saved_row->rules.size() == 7);
+  REQUIRE(saved_row->rule(rbx).value == -56);
+  REQUIRE(saved_row->rule(r15).value == -16);
+
+  /* The linear walk of .eh_frame finds the same FDEs */
+  for (const std::uint64_t pc : { 0x401020, 0x401080, 0x4010c0, 0x401374 }) {
+    REQUIRE(hdr->frame().find(pc)->offset == hdr->find(pc)->offset);
+  }
+  REQUIRE_FALSE(hdr->find(0x401390));
+  REQUIRE_FALSE(hdr->frame().find(0x401390));
+
+  /* Files without .eh_frame_hdr */
+  REQUIRE_FALSE(pelf::Elf32{ hello32_program_elf }.ehFrameHdr());
+
+  /* A CIE and an FDE with remember/restore state and the GNU extensions */
+  const std::array<unsigned char, 78> frame_data = { 0x12, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x7a, 0x52, 0x00, 0x01, 0x78, 0x10, 0x01,
+    0x00, 0x0c, 0x07, 0x08, 0x90, 0x01, 0x30, 0x00, 0x00, 0x00, 0x1a, 0x00,
+    0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x0e, 0x10, 0x86, 0x02,
+    0x43, 0x0a, 0x0d, 0x06, 0x09, 0x03, 0x0c, 0x14, 0x05, 0x01, 0x2e, 0x20,
+    0x02, 0x10, 0x0b, 0xc6, 0x2f, 0x03, 0x02, 0x44, 0x07, 0x10, 0x00, 0x00,
+    0x00, 0x00 };
+  pelf::EhFrame frame{ std::span<const unsigned char>{ frame_data }, 0x1000, 8 };
+
+  const auto fde = frame.find(0x2010);
+  REQUIRE(fde);
+  REQUIRE(fde->offset == 22);
+  REQUIRE_FALSE(frame.find(0x2100));
+  REQUIRE_THROWS_AS(frame.unwindRow(*fde, 0x2100), pelf::PelfException);
+  REQUIRE_THROWS_AS(frame.fde(0), pelf::PelfException);
+
+  const auto remembered = frame.unwindRow(*fde, 0x2010);
+  REQUIRE(remembered.location == 0x2004);
+  REQUIRE(remembered.endLocation == 0x2014);
+  REQUIRE(remembered.cfa.reg == rbp);
+  REQUIRE(remembered.rule(rbx).kind == Rule::inRegister);
+  REQUIRE(remembered.rule(rbx).value == 12);
+  REQUIRE(remembered.rule(5).kind == Rule::valOffset);
+  REQUIRE(remembered.rule(5).value == -8);
+  REQUIRE(remembered.argsSize == 32);
+
+  const auto restored = frame.unwindRow(*fde, 0x2014);
+  REQUIRE(restored.cfa.reg == rsp);
+  REQUIRE(restored.cfa.offset == 16);
+  REQUIRE(restored.rule(rbp).kind == Rule::unspecified);
+  REQUIRE(restored.rule(5).kind == Rule::unspecified);
+  REQUIRE(restored.rule(rbx).kind == Rule::offset);
+  REQUIRE(restored.rule(rbx).value == 16);
+  REQUIRE(restored.rule(ra).value == -8);
+  REQUIRE(restored.endLocation == 0x2018);
+
+  const auto last = frame.unwindRow(*fde, 0x20ff);
+  REQUIRE(last.rule(ra).kind == Rule::undefined);
+  REQUIRE(last.endLocation == 0x2100);
+}
+
+
+TEST_CASE("Test Pe exception table and unwind info")
+{
+  /* hello.exe has 771 RUNTIME_FUNCTION entries in .pdata */
+  static constexpr auto compile_table = compile_pe.getExceptionTable();
+  static_assert(compile_table.size() == 771);
+  static_assert(compile_table.entry(0).BeginAddress == 0x1000);
+  static_assert(compile_pe.rvaToOffset(0x3a000) == 0x36200);
+
+  const std::span<const unsigned char> bytes{ hello_program };
+  const pelf::Pe<std::span<const unsigned char>> pe{ bytes };
+  const auto table = pe.getExceptionTable();
+  REQUIRE(table.size() == 771);
+  REQUIRE(pe.getDataDirectory(pelf::IMAGE_DIRECTORY_ENTRY_EXCEPTION).data()
+          == hello_program.data() + 0x36200);
+  REQUIRE(pe.getDataDirectory(pelf::IMAGE_DIRECTORY_ENTRY_EXPORT).empty());
+  REQUIRE_FALSE(pe.rvaToOffset(0x50000));
+  REQUIRE(pe.getDataAtRva(0x50000).empty());
+
+  for (std::size_t i{ 1 }; i < table.size(); ++i) {
+    REQUIRE(table.entry(i - 1).EndAddress <= table.entry(i).BeginAddress);
+  }
+
+  const auto first = table.entry(0);
+  REQUIRE(first.EndAddress == 0x102e);
+  REQUIRE(first.UnwindInfoAddress == 0x33910);
+  REQUIRE(table.find(0x1000)->BeginAddress == 0x1000);
+  REQUIRE(table.find(0x102d)->BeginAddress == 0x1000);
+  REQUIRE_FALSE(table.find(0x102e));// gap between two functions
+  REQUIRE_FALSE(table.find(0xfff));
+  REQUIRE_FALSE(table.find(0x30000));
+
+  const auto small = pe.getUnwindInfo(first);
+  REQUIRE(small.version == 1);
+  REQUIRE(small.flags == pelf::UNW_FLAG_NHANDLER);
+  REQUIRE(small.countOfCodes == 1);
+  REQUIRE(small.codes().begin()->operation == pelf::UWOP_ALLOC_SMALL);
+  REQUIRE(small.codes().begin()->value == 0x38);
+
+  /* Frame pointer, large allocation and a handler */
+  const auto framed = table.find(0x1200);
+  REQUIRE(framed->BeginAddress == 0x1140);
+  const auto info = pe.getUnwindInfo(*framed);
+  REQUIRE(info.flags == (pelf::UNW_FLAG_EHANDLER | pelf::UNW_FLAG_UHANDLER));
+  REQUIRE(info.sizeOfProlog == 0x10);
+  REQUIRE(info.frameRegister == 5);// rbp
+  REQUIRE(info.frameOffset == 8);
+  REQUIRE(info.handler == 0x852c);
+  REQUIRE(info.handlerData[0] == 0x94);
+
+  std::vector<pelf::UnwindCode> codes(info.codes().begin(), info.codes().end());
+  REQUIRE(codes.size() == 3);
+  REQUIRE(codes[0].operation == pelf::UWOP_SET_FPREG);
+  REQUIRE(codes[0].codeOffset == 0x10);
+  REQUIRE(codes[1].operation == pelf::UWOP_ALLOC_LARGE);
+  REQUIRE(codes[1].value == 0xa0);
+  REQUIRE(codes[1].slots == 2);
+  REQUIRE(codes[2].operation == pelf::UWOP_PUSH_NONVOL);
+  REQUIRE(codes[2].info == 5);
+  REQUIRE(codes[2].codeOffset == 1);
+
+  /* A function split in chained parts */
+  const auto part = table.find(0x20700);
+  REQUIRE(part->BeginAddress == 0x206db);
+  const auto chained_info = pe.getUnwindInfo(*part);
+  REQUIRE(chained_info.flags == pelf::UNW_FLAG_CHAININFO);
+  REQUIRE(chained_info.countOfCodes == 10);
+  REQUIRE(chained_info.chained->BeginAddress == 0x20680);
+  REQUIRE(chained_info.chained->UnwindInfoAddress == 0x35a10);
+
+  std::size_t saves{};
+  for (const auto& code : chained_info.codes()) {
+    REQUIRE(code.operation == pelf::UWOP_SAVE_NONVOL);
+    ++saves;
+  }
+  REQUIRE(saves == 5);
+  REQUIRE(chained_info.codes().begin()->info == 15);// r15
+  REQUIRE(chained_info.codes().begin()->value == 0x428);
+
+  /* Every unwind info of the file can be decoded */
+  for (std::size_t i{}; i < table.size(); ++i) {
+    const auto unwind = pe.getUnwindInfo(table.entry(i));
+    std::size_t slots{};
+    for (const auto& code : unwind.codes()) { slots += code.slots; }
+    REQUIRE(slots == unwind.countOfCodes);
+  }
+
+  /* x86 images don't have an x64 exception directory */
+  REQUIRE(pelf::Pe32{ hello32_program }.getExceptionTable().empty());
+
+  const std::array<unsigned char, 4> bad_version = { 0x03, 0, 0, 0 };
+  REQUIRE_THROWS_AS(pelf::decodeUnwindInfo(bad_version), pelf::PelfException);
+  const std::array<unsigned char, 4> truncated = { 0x01, 0, 2, 0 };
+  REQUIRE_THROWS_AS(pelf::decodeUnwindInfo(truncated), pelf::PelfException);
+}
+
+
+TEST_CASE("Test ar archives")
+{
+  const std::span<const unsigned char> bytes{ libdebug_archive };
+  const pelf::Archive archive{ bytes };
+  REQUIRE_FALSE(archive.isThin());
+
+  /* The symbol table and the long name table aren't members */
+  const auto members = archive.members();
+  REQUIRE(members.size() == 2);
+  REQUIRE(members[0].name == "debug_main.o");
+  REQUIRE(members[0].offset == 0xcc);
+  REQUIRE(members[0].size == 1328);
+  REQUIRE(members[0].mode == 0644);
+  REQUIRE(members[0].date == 0);// deterministic archive
+  REQUIRE(members[1].name == "debug_util_with_a_long_name.o");// "//" table
+  REQUIRE(members[1].data.size() == 1312);
+  REQUIRE(members[0].data.data() == libdebug_archive.data() + 0xcc + 60);
+
+  /* Members are sub-spans, they can be parsed in place */
+  const pelf::Elf<std::span<const unsigned char>> object{ members[1].data };
+  REQUIRE(object.getHeaders().elfHeader.e_type == 1);// ET_REL
+  REQUIRE(object.findSection(".text"));
+
+  /* Symbols are looked up in the symbol table only */
+  REQUIRE(archive.symbolCount() == 3);
+  const auto symbols = archive.symbols();
+  REQUIRE(symbols[0].name == "_start");
+  REQUIRE(symbols[0].memberOffset == 0xcc);
+  REQUIRE(symbols[2].name == "checksum");
+  REQUIRE(archive.findSymbol("_start")->name == "debug_main.o");
+  REQUIRE(archive.findSymbol("sum_digits")->name
+          == "debug_util_with_a_long_name.o");
+  REQUIRE(archive.findSymbol("checksum")->offset == 0x638);
+  REQUIRE_FALSE(archive.findSymbol("message"));// static
+  REQUIRE_FALSE(archive.findSymbol("check"));
+  REQUIRE(archive.findMember("debug_main.o")->offset == 0xcc);
+  REQUIRE_FALSE(archive.findMember("debug_main"));
+  REQUIRE_FALSE(archive.memberAt(0xcd));
+
+  /* Parallel parsing keeps the order of the members */
+  for (const unsigned threads : { 1U, 2U, 0U }) {
+    const auto parsed = archive.parseMembers(threads);
+    REQUIRE(parsed.size() == 2);
+    for (const auto& member : parsed) {
+      REQUIRE_FALSE(member.error);
+      REQUIRE(member.file->index() == 1);// Elf64 little endian
+    }
+    REQUIRE(std::get<1>(*parsed[1].file).getHeaders().elfHeader.e_shnum
+            == object.getHeaders().elfHeader.e_shnum);
+  }
+
+  std::atomic<int> visited{};
+  REQUIRE_THROWS_AS(archive.forEachMember(
+                      [&](std::size_t index, const pelf::ArchiveMember&) {
+                        ++visited;
+                        if (index == 1) { throw pelf::PelfException{ "stop" }; }
+                      },
+                      2),
+    pelf::PelfException);
+  REQUIRE(visited == 2);
+
+  /* Thin archives only have the names of the members */
+  const std::span<const unsigned char> thin_bytes{ libdebug_thin_archive };
+  const pelf::Archive thin{ thin_bytes };
+  REQUIRE(thin.isThin());
+  REQUIRE(thin.members().size() == 2);
+  REQUIRE(thin.members()[0].name == "debug_main.o");
+  REQUIRE(thin.members()[0].size == 1328);
+  REQUIRE(thin.members()[0].data.empty());
+  REQUIRE(thin.findSymbol("checksum")->name == "debug_util_with_a_long_name.o");
+
+  /* BSD archive, "#1/" names and a __.SYMDEF table */
+  using namespace std::string_view_literals;
+  std::vector<unsigned char> bsd;
+  const auto add = [&](std::string_view text) {
+    bsd.insert(bsd.end(), text.begin(), text.end());
+  };
+  const auto add32 = [&](std::uint32_t value) {
+    for (int i{}; i < 4; ++i) {
+      bsd.push_back(static_cast<unsigned char>(value >> (i * 8)));
+    }
+  };
+  const auto add_header = [&](std::string_view name, std::string_view size) {
+    const auto field = [&](std::string_view text, std::size_t width) {
+      add(text);
+      bsd.insert(bsd.end(), width - text.size(), ' ');
+    };
+    field(name, 16);
+    field("0", 12);
+    field("0", 6);
+    field("0", 6);
+    field("100644", 8);
+    field(size, 10);
+    add("`\n");
+  };
+  add("!<arch>\n");
+  add_header("#1/12", "36");
+  add("__.SYMDEF\0\0\0"sv);
+  add32(8);// one ranlib struct
+  add32(0);// name offset
+  add32(104);// member offset
+  add32(8);// size of the names
+  add("foo\0\0\0\0\0"sv);
+  add_header("#1/20", "23");
+  add("a_long_bsd_name.o\0\0\0"sv);
+  add("abc");// odd size, padded
+  REQUIRE(bsd.size() == 187);
+  bsd.push_back('\n');
+
+  const pelf::Archive bsd_archive{ bsd };
+  REQUIRE(bsd_archive.members().size() == 1);
+  REQUIRE(bsd_archive.members()[0].name == "a_long_bsd_name.o");
+  REQUIRE(bsd_archive.members()[0].size == 3);
+  REQUIRE(bsd_archive.members()[0].data.size() == 3);
+  REQUIRE(bsd_archive.findSymbol("foo")->name == "a_long_bsd_name.o");
+  REQUIRE(std::get<pelf::Unknown>(*bsd_archive.parseMembers()[0].file).format
+          == pelf::FileFormat::Unknown);
+
+  const std::span<const unsigned char> elf_bytes{ hello_program_elf };
+  REQUIRE_THROWS_AS(pelf::Archive{ elf_bytes }, pelf::PelfException);
+  const auto truncated = bytes.first(0xcc + 60 + 100);
+  REQUIRE_THROWS_AS(pelf::Archive{ truncated }, pelf::PelfException);
+}
+
+
+TEST_CASE("Test core files")
+{
+  const std::span<const unsigned char> bytes{ crash_core };
+  const pelf::Elf<std::span<const unsigned char>> elf{ bytes };
+  const pelf::CoreFile core{ elf };
+
+  /* The only thread, killed by SIGSEGV in crash() */
+  REQUIRE(core.threads().size() == 1);
+  const auto& thread = core.threads()[0];
+  REQUIRE(thread.signal == 11);
+  REQUIRE(thread.tid == 9212);
+  REQUIRE(thread.ppid == 9200);
+  REQUIRE(thread.registers.size() == 27 * 8);
+  REQUIRE(thread.fpRegisters.size() == 512);
+  REQUIRE(thread.signalInfo.size() == 128);
+  REQUIRE(core.programCounter(thread) == 0x401007);
+  REQUIRE(core.stackPointer(thread) == 0x7ffdbfd665e8);
+  REQUIRE(core.registerValue(thread, 14) == 42);// rdi, argument of crash()
+  REQUIRE_THROWS_AS(core.registerValue(thread, 27), pelf::PelfException);
+
+  const auto& info = core.processInfo();
+  REQUIRE(info);
+  REQUIRE(info->state == 'R');
+  REQUIRE(info->pid == 9212);
+  REQUIRE(info->fileName == "crash");
+  REQUIRE(info->arguments == "./crash");
+
+  /* The text, read only data and data segments of the executable */
+  const auto files = core.mappedFiles();
+  REQUIRE(files.size() == 3);
+  REQUIRE(files[1].start == 0x401000);
+  REQUIRE(files[1].end == 0x402000);
+  REQUIRE(files[1].fileOffset == 0x1000);
+  REQUIRE(files[1].path == "/tmp/crash/crash");
+  REQUIRE(core.findMappedFile(0x401007)->start == 0x401000);
+  REQUIRE_FALSE(core.findMappedFile(0x403000));
+
+  REQUIRE(core.auxv().size() == 22);
+  REQUIRE(core.auxvValue(pelf::AT_ENTRY) == 0x401010);
+  REQUIRE(core.auxvValue(pelf::AT_PAGESZ) == 0x1000);
+  REQUIRE_FALSE(core.auxvValue(pelf::AT_BASE + 1000));
+
+  /* Memory is read in place, the return address into _start is on the
+   * stack and `depth` in .bss */
+  REQUIRE(core.memoryRegions().size() == 9);
+  const auto stack = core.readMemory(0x7ffdbfd665e8, 8);
+  REQUIRE(stack.data() == crash_core.data() + 0xe000 + 0x205e8);
+  REQUIRE(core.readPointer(*core.stackPointer(thread)) == 0x40101a);
+  REQUIRE(core.readPointer(0x403000) == 42);
+
+  /* The text segment isn't dumped, it's in the executable */
+  const auto text = core.findRegion(0x401007);
+  REQUIRE(text->start == 0x401000);
+  REQUIRE(text->data.empty());
+  REQUIRE(core.readMemory(0x401007, 1).empty());
+  REQUIRE(core.readMemory(0x403ff8, 8).size() == 8);
+  REQUIRE(core.readMemory(0x403ff9, 8).empty());// crosses the region
+  REQUIRE_FALSE(core.findRegion(0x1000));
+  REQUIRE_FALSE(core.readPointer(0x404000));
+
+  const pelf::Elf<std::span<const unsigned char>> executable{
+    std::span<const unsigned char>{ hello_program_elf }
+  };
+  REQUIRE_THROWS_AS(pelf::CoreFile{ executable }, pelf::PelfException);
+}
+
+
+TEST_CASE("Test COFF object files and symbol tables")
+{
+  const pelf::Coff coff{ std::span<const unsigned char>{ coff_object } };
+  REQUIRE_FALSE(coff.isBigObj());
+  REQUIRE(coff.machine() == pelf::IMAGE_FILE_MACHINE_AMD64);
+  REQUIRE(coff.numberOfSections() == 5);
+  REQUIRE(coff.sectionName(0) == ".text");
+  REQUIRE(coff.sectionName(3) == ".text$inline_function");// "/73"
+  REQUIRE(coff.findSection(".rdata") == 4);
+  REQUIRE(coff.sectionData(coff.section(4)).size() == 9);
+  REQUIRE(coff.sectionData(coff.section(2)).empty());// .bss
+
+  /* 15 symbols in 24 records */
+  const auto& table = coff.symbols();
+  REQUIRE(table.size() == 24);
+  REQUIRE(table.recordSize() == pelf::IMAGE_SIZEOF_SYMBOL);
+  std::vector<pelf::CoffSymbol> symbols(table.begin(), table.end());
+  REQUIRE(symbols.size() == 15);
+  REQUIRE(symbols[7].name == "compute_checksum_of_buffer");// string table
+  REQUIRE(symbols[7].index == 12);
+  REQUIRE(symbols[7].isFunction());
+  REQUIRE(symbols[7].sectionNumber == 1);
+  REQUIRE(symbols[8].name == "helper");
+  REQUIRE(symbols[8].value == 23);
+  REQUIRE(symbols[8].storageClass == pelf::IMAGE_SYM_CLASS_STATIC);
+  REQUIRE(symbols[6].sectionNumber == pelf::IMAGE_SYM_ABSOLUTE);
+  REQUIRE(symbols[9].isUndefined());
+  REQUIRE(table.symbol(12).name == symbols[7].name);
+  REQUIRE_THROWS_AS(table.symbol(24), pelf::PelfException);
+
+  /* Auxiliary records */
+  const auto comdat = std::get<pelf::CoffAuxSection>(table.decodeAux(symbols[3]));
+  REQUIRE(comdat.length == 6);
+  REQUIRE(comdat.number == 4);
+  REQUIRE(comdat.selection == pelf::IMAGE_COMDAT_SELECT_ANY);
+  REQUIRE(std::get<pelf::CoffAuxSection>(table.decodeAux(symbols[0])).length == 40);
+
+  const auto weak = std::get<pelf::CoffAuxWeakExternal>(table.decodeAux(symbols[10]));
+  REQUIRE(weak.tagIndex == 17);
+  REQUIRE(weak.characteristics == pelf::IMAGE_WEAK_EXTERN_SEARCH_ALIAS);
+  REQUIRE(table.symbol(weak.tagIndex).name
+          == ".weak.weak_hook.default.compute_checksum_of_buffer");
+
+  REQUIRE(std::get<pelf::CoffAuxFile>(table.decodeAux(symbols[14])).name
+          == "src/checksum/coff_object_with_a_long_name.c");
+  REQUIRE(std::holds_alternative<std::monostate>(table.decodeAux(symbols[7])));
+
+  /* Lookups by name */
+  const pelf::CoffSymbolIndex index{ table };
+  REQUIRE(index.size() == 15);
+  REQUIRE(index.find("counter")->index == 18);
+  REQUIRE(index.find("inline_function")->sectionNumber == 4);
+  REQUIRE_FALSE(index.find("count"));
+  REQUIRE(index.findAll("helper") == std::vector<std::uint32_t>{ 13 });
+
+  /* /bigobj: 20 byte records and 32-bit section numbers, with a function
+   * definition and a .bf record */
+  std::vector<unsigned char> bigobj(180);
+  const auto put16 = [&](std::size_t offset, std::uint16_t value) {
+    bigobj[offset] = static_cast<unsigned char>(value);
+    bigobj[offset + 1] = static_cast<unsigned char>(value >> 8);
+  };
+  const auto put32 = [&](std::size_t offset, std::uint32_t value) {
+    put16(offset, static_cast<std::uint16_t>(value));
+    put16(offset + 2, static_cast<std::uint16_t>(value >> 16));
+  };
+  put16(2, 0xffff);
+  put16(4, 2);
+  put16(6, pelf::IMAGE_FILE_MACHINE_ARM64);
+  const std::array<unsigned char, 16> class_id = { 0xc7, 0xa1, 0xba, 0xd1,
+    0xee, 0xba, 0xa9, 0x4b, 0xaf, 0x20, 0xfa, 0xf6, 0x6a, 0xa4, 0xdc, 0xb8 };
+  std::copy(class_id.begin(), class_id.end(), bigobj.begin() + 12);
+  put32(44, 1);// sections
+  put32(48, 96);// symbol table
+  put32(52, 4);// symbols
+  std::copy_n(".text", 5, bigobj.begin() + 56);
+  std::copy_n("main", 4, bigobj.begin() + 96);
+  put32(96 + 12, 1);// section number
+  put16(96 + 16, 0x20);// function
+  bigobj[96 + 18] = pelf::IMAGE_SYM_CLASS_EXTERNAL;
+  bigobj[96 + 19] = 1;
+  put32(116, 2);// tag index
+  put32(116 + 4, 16);// total size
+  std::copy_n(".bf", 3, bigobj.begin() + 136);
+  put32(136 + 12, 1);
+  bigobj[136 + 18] = pelf::IMAGE_SYM_CLASS_FUNCTION;
+  bigobj[136 + 19] = 1;
+  put16(156 + 4, 12);// line number
+  put32(176, 4);// empty string table
+
+  const pelf::Coff big{ bigobj };
+  REQUIRE(big.isBigObj());
+  REQUIRE(big.machine() == pelf::IMAGE_FILE_MACHINE_ARM64);
+  REQUIRE(big.sectionName(0) == ".text");
+  REQUIRE(big.symbols().recordSize() == pelf::IMAGE_SIZEOF_SYMBOL_EX);
+  const auto main_symbol = big.symbols().symbol(0);
+  REQUIRE(main_symbol.name == "main");
+  REQUIRE(main_symbol.sectionNumber == 1);
+  const auto function =
+    std::get<pelf::CoffAuxFunction>(big.symbols().decodeAux(main_symbol));
+  REQUIRE(function.tagIndex == 2);
+  REQUIRE(function.totalSize == 16);
+  const auto begin_function = big.symbols().symbol(function.tagIndex);
+  REQUIRE(begin_function.name == ".bf");
+  REQUIRE(std::get<pelf::CoffAuxLineInfo>(big.symbols().decodeAux(begin_function))
+            .lineNumber
+          == 12);
+
+  /* The symbol table of an image */
+  const auto image_symbols = pelf::Pe32{ hello32_program }.getSymbolTable();
+  REQUIRE(image_symbols.size() == 51);
+  REQUIRE(image_symbols.symbol(0).name == "message");// short name
+  REQUIRE(image_symbols.symbol(3).name == "___RUNTIME_PSEUDO_RELOC_LIST__");
+  REQUIRE(pelf::CoffSymbolIndex{ image_symbols }.find("_start")->index == 30);
+  REQUIRE(runtime_pe.getSymbolTable().empty());
+
+  bigobj.resize(150);// truncated symbol table
+  REQUIRE_THROWS_AS(pelf::Coff{ bigobj }, pelf::PelfException);
+}
+
+
+TEST_CASE("Test Pe resources")
+{
+  static constexpr auto resource_sections =
+    pelf::getPeNumberOfSections(resources_program);
+  static constexpr pelf::Pe<decltype(resources_program), resource_sections>
+    compile_resources{ resources_program };
+  static_assert(compile_resources.getResources().size() == 4);
+  static_assert(
+    compile_resources.findResource(pelf::RT_RCDATA, "payload")->data.size()
+    == 18);
+
+  const std::span<const unsigned char> bytes{ resources_program };
+  const pelf::Pe<std::span<const unsigned char>> pe{ bytes };
+  const auto root = pe.getResources();
+
+  /* The types have IDs, sorted: RT_STRING, RT_RCDATA, RT_VERSION and
+   * RT_MANIFEST */
+  REQUIRE(root.size() == 4);
+  REQUIRE(root.header().NumberOfNamedEntries == 0);
+  std::vector<pelf::WORD> types;
+  for (const auto entry : root) {
+    REQUIRE_FALSE(entry.isNamed());
+    REQUIRE(entry.isDirectory());
+    types.push_back(entry.id());
+  }
+  REQUIRE(types
+          == std::vector<pelf::WORD>{ pelf::RT_STRING,
+            pelf::RT_RCDATA,
+            pelf::RT_VERSION,
+            pelf::RT_MANIFEST });
+
+  /* RCDATA has two named resources before the ID 7 */
+  const auto rcdata = root.find(pelf::RT_RCDATA)->directory();
+  REQUIRE(rcdata.size() == 3);
+  REQUIRE(rcdata.header().NumberOfNamedEntries == 2);
+  REQUIRE(rcdata.entry(0).name() == "CONFIG");
+  REQUIRE(rcdata.entry(0).name().toUtf8() == "CONFIG");
+  REQUIRE(rcdata.entry(1).name() == "PAYLOAD");
+  REQUIRE(rcdata.entry(2).id() == 7);
+  REQUIRE(rcdata.entry(2).name().empty());
+  REQUIRE(rcdata.find("Payload")->name() == "PAYLOAD");
+  REQUIRE(rcdata.find(7)->id() == 7);
+  REQUIRE_FALSE(rcdata.find("PAYLOADS"));
+  REQUIRE_FALSE(rcdata.find("CONF"));
+  REQUIRE_FALSE(rcdata.find(8));
+  REQUIRE_FALSE(root.find(pelf::RT_ICON));
+  REQUIRE_THROWS_AS(rcdata.entry(3), pelf::PelfException);
+
+  /* CONFIG in German, English and French */
+  const auto config = rcdata.find("config")->directory();
+  REQUIRE(config.size() == 3);
+  REQUIRE(config.entry(0).id() == 0x407);
+  REQUIRE_FALSE(config.entry(0).isDirectory());
+  REQUIRE_THROWS_AS(config.entry(0).directory(), pelf::PelfException);
+  REQUIRE_THROWS_AS(rcdata.entry(0).dataEntry(), pelf::PelfException);
+
+  const auto as_string = [](std::span<const unsigned char> data) {
+    return std::string{ data.begin(), data.end() };
+  };
+
+  const auto english = pe.findResource(pelf::RT_RCDATA, "CONFIG", 0x409);
+  REQUIRE(english);
+  REQUIRE(english->language == 0x409);
+  REQUIRE(as_string(english->data) == "english configuration");
+  REQUIRE(english->data.data()
+          == resources_program.data() + 0x400
+               + (english->entry.OffsetToData - 0x2000));
+
+  const auto german = pe.findResource(pelf::RT_RCDATA, "CONFIG");
+  REQUIRE(german->language == 0x407);// the first language
+  REQUIRE(as_string(german->data) == "deutsche Konfiguration");
+
+  const auto french = pe.findResource(pelf::RT_RCDATA, "CONFIG", 0x40c);
+  REQUIRE(pelf::Utf16View{ french->data }.toUtf8()
+          == "configuration en fran\xc3\xa7" "aise");
+  REQUIRE(pelf::Utf16View{ french->data }.compare(
+            "configuration en fran\xc3\xa7" "aise")
+          == 0);
+  REQUIRE(pelf::Utf16View{ french->data }.compare("configuration en franc")
+          > 0);
+
+  REQUIRE_FALSE(pe.findResource(pelf::RT_RCDATA, "CONFIG", 0x410));
+  REQUIRE_FALSE(pe.findResource(pelf::RT_RCDATA, "MISSING"));
+  REQUIRE_FALSE(pe.findResource(pelf::RT_BITMAP, 1));
+  REQUIRE(as_string(pe.findResource(pelf::RT_RCDATA, 7)->data) == "seven");
+
+  const auto payload = pe.findResource(pelf::RT_RCDATA, "PAYLOAD");
+  REQUIRE(payload->data.size() == 18);
+  REQUIRE(payload->data[16] == 0x34);
+  REQUIRE(payload->data[17] == 0x12);
+
+  const auto manifest = pe.findResource(pelf::RT_MANIFEST, 1);
+  REQUIRE(as_string(manifest->data).starts_with("<assembly"));
+  REQUIRE(pe.findResource(pelf::RT_VERSION, 1)->data.size() == 668);
+
+  /* hello.exe doesn't have resources */
+  REQUIRE(runtime_pe.getResources().empty());
+  REQUIRE_FALSE(runtime_pe.findResource(pelf::RT_VERSION, 1));
+
+  /* A root directory with more entries than the data directory can hold */
+  std::vector<unsigned char> broken{ resources_program.begin(),
+    resources_program.end() };
+  broken[0x400 + 14] = 0xff;
+  broken[0x400 + 15] = 0xff;
+  const pelf::Pe<std::span<const unsigned char>> broken_pe{
+    std::span<const unsigned char>{ broken }
+  };
+  REQUIRE_THROWS_AS(broken_pe.getResources(), pelf::PelfException);
+}
+
+
+TEST_CASE("Test Pe version info")
+{
+  static constexpr auto resource_sections =
+    pelf::getPeNumberOfSections(resources_program);
+  static constexpr pelf::Pe<decltype(resources_program), resource_sections>
+    compile_resources{ resources_program };
+  static_assert(compile_resources.versionInfo()->fileVersion()
+                == pelf::VersionNumber{ 1, 2, 3, 4 });
+  static_assert(*compile_resources.versionInfo()->string("FileVersion")
+                == "1.2.3.4");
+
+  const std::span<const unsigned char> bytes{ resources_program };
+  const pelf::Pe<std::span<const unsigned char>> pe{ bytes };
+  const auto version = pe.versionInfo();
+  REQUIRE(version);
+
+  const auto fixed = version->fixedFileInfo();
+  REQUIRE(fixed);
+  REQUIRE(fixed->dwSignature == pelf::VS_FFI_SIGNATURE);
+  REQUIRE(fixed->dwFileVersionMS == 0x00010002);
+  REQUIRE(fixed->dwFileVersionLS == 0x00030004);
+  REQUIRE(fixed->dwFileFlagsMask == 0x3f);
+  REQUIRE(fixed->dwFileOS == pelf::VOS_NT_WINDOWS32);
+  REQUIRE(fixed->dwFileType == pelf::VFT_APP);
+  REQUIRE(version->fileVersion() == pelf::VersionNumber{ 1, 2, 3, 4 });
+  REQUIRE(version->productVersion() == pelf::VersionNumber{ 1, 2, 0, 0 });
+  REQUIRE(version->productVersion() < version->fileVersion());
+
+  REQUIRE(version->translationCount() == 2);
+  REQUIRE(version->translation(0) == pelf::Translation{ 0x409, 1200 });
+  REQUIRE(version->translation(1) == pelf::Translation{ 0x407, 1200 });
+  REQUIRE_THROWS_AS(version->translation(2), pelf::PelfException);
+
+  /* The strings are views of the file, converted on demand */
+  const auto product = version->string("ProductName");
+  REQUIRE(product);
+  REQUIRE(*product == "Pelf tests");
+  REQUIRE(product->size() == 10);
+  REQUIRE(product->bytes().data() > resources_program.data());
+  REQUIRE(product->bytes().data()
+          < resources_program.data() + resources_program.size());
+  REQUIRE(product->toUtf8() == "Pelf tests");
+  REQUIRE(version->string("CompanyName")->toUtf8() == "Pelf");
+  REQUIRE(*version->string("FileDescription") == "Resource test program");
+  REQUIRE(*version->string("OriginalFilename") == "resources.exe");
+  REQUIRE(*version->string("ProductVersion") == "1.2");
+  REQUIRE_FALSE(version->string("LegalCopyright"));
+  REQUIRE_FALSE(version->string("productname"));// keys are case sensitive
+
+  REQUIRE(*version->string("ProductName", { 0x407, 1200 })
+          == "Pelf Tests (Deutsch)");
+  REQUIRE_FALSE(version->string("FileVersion", { 0x407, 1200 }));
+  REQUIRE_FALSE(version->string("ProductName", { 0x40c, 1200 }));
+
+  /* Walking the tables */
+  std::vector<std::string> tables;
+  for (const auto& table : version->stringFileInfo()) {
+    const auto translation = pelf::VersionInfo::tableTranslation(table);
+    REQUIRE(translation);
+    REQUIRE(translation->codePage == 1200);
+    tables.push_back(table.key().toUtf8());
+  }
+  REQUIRE(tables == std::vector<std::string>{ "040904b0", "040704b0" });
+
+  std::size_t strings{};
+  const auto english = *version->stringFileInfo().begin();
+  for (const auto& string : english) {
+    REQUIRE(string.type() == 1);
+    REQUIRE_FALSE(string.text().empty());
+    ++strings;
+  }
+  REQUIRE(strings == 6);
+
+  /* hello.exe doesn't have resources */
+  REQUIRE_FALSE(runtime_pe.versionInfo());
+
+  /* Blocks that exceed the resource or have a wrong root key */
+  const auto data = pe.findResource(pelf::RT_VERSION, 1)->data;
+  REQUIRE_THROWS_AS(pelf::VersionInfo{ data.first(100) }, pelf::PelfException);
+  REQUIRE_THROWS_AS(pelf::VersionInfo{ english.value() }, pelf::PelfException);
+  std::vector<unsigned char> renamed{ data.begin(), data.end() };
+  renamed[6] = 'W';
+  REQUIRE_THROWS_AS(pelf::VersionInfo{ renamed }, pelf::PelfException);
+}
+
+
+TEST_CASE("Test Pe imports, imphash and Rich header")
+{
+  /* hello.exe imports 88 functions from KERNEL32.dll */
+  const auto imports = runtime_pe.getImports();
+  REQUIRE(imports.size() == 1);
+  const auto kernel32 = imports.module(0);
+  REQUIRE(kernel32.name() == "KERNEL32.dll");
+  REQUIRE(kernel32.descriptor().Name == 0x3637a);
+  REQUIRE(std::distance(kernel32.functions().begin(),
+            kernel32.functions().end())
+          == 88);
+  const auto close_handle = *kernel32.functions().begin();
+  REQUIRE(close_handle.name == "CloseHandle");
+  REQUIRE(close_handle.hint == 142);
+  REQUIRE_FALSE(close_handle.ordinal);
+  REQUIRE(close_handle.iatRva == kernel32.descriptor().FirstThunk);
+  REQUIRE(imports.find("kernel32.DLL"));
+  REQUIRE_FALSE(imports.find("user32.dll"));
+  REQUIRE_THROWS_AS(imports.module(1), pelf::PelfException);
+  REQUIRE(pelf::toHex(*runtime_pe.imphash())
+          == "eb991af5db6e24e3e88f2474d2e8b839");
+
+  /* A PE32 image with imports by ordinal and extensions that are kept */
+  const std::span<const unsigned char> bytes{ imports_program };
+  const pelf::Pe32<std::span<const unsigned char>> pe32{ bytes };
+  const auto imports32 = pe32.getImports();
+  std::vector<std::string> names;
+  for (const auto& imported : imports32) {
+    for (const auto& function : imported.functions()) {
+      const auto name = function.ordinal
+                          ? "#" + std::to_string(*function.ordinal)
+                          : std::string{ function.name };
+      names.push_back(std::string{ imported.name() } + "!" + name);
+    }
+  }
+  REQUIRE(names
+          == std::vector<std::string>{ "KERNEL32.dll!GetProcAddress",
+            "KERNEL32.dll!LoadLibraryA",
+            "KERNEL32.dll!ExitProcess",
+            "USER32.dll!MessageBoxA",
+            "USER32.dll!#2",
+            "Control.OCX!DllRegisterServer",
+            "plugin.drv!#7",
+            "plugin.drv!Initialize",
+            "WS2_32.dll!#115",
+            "WS2_32.dll!#23",
+            "WS2_32.dll!#16",
+            "WS2_32.dll!#1000",
+            "wsock32.dll!#52",
+            "OLEAUT32.dll!#2",
+            "OLEAUT32.dll!#6",
+            "OLEAUT32.dll!#302" });
+
+  /* The IAT slots are 4 bytes apart in PE32 */
+  const auto user32 = *imports32.find("user32.dll");
+  auto function = user32.functions().begin();
+  const auto first_slot = function->iatRva;
+  ++function;
+  REQUIRE(function->iatRva == first_slot + 4);
+  REQUIRE(function->ordinal == 2);
+
+  /* The ordinals of winsock and oleaut32 are hashed by name like pefile does,
+   * "...,ws2_32.wsastartup,ws2_32.socket,ws2_32.recv,ws2_32.ord1000,
+   * wsock32.gethostbyname,oleaut32.sysallocstring,oleaut32.sysfreestring,
+   * oleaut32.ord302" */
+  REQUIRE(pelf::ordinalName("ws2_32.DLL", 115) == "WSAStartup");
+  REQUIRE(pelf::ordinalName("WSOCK32.dll", 151) == "__WSAFDIsSet");
+  REQUIRE(pelf::ordinalName("oleaut32.dll", 443) == "UnRegisterTypeLibForUser");
+  REQUIRE_FALSE(pelf::ordinalName("ws2_32.dll", 100));
+  REQUIRE_FALSE(pelf::ordinalName("ws2_32", 115));
+  REQUIRE_FALSE(pelf::ordinalName("USER32.dll", 2));
+  static_assert(pelf::ordinalName("ws2_32.dll", 500) == "WEP");
+  REQUIRE(pelf::toHex(*pe32.imphash()) == "134f4f6e19ebe8836a439a466a9473e9");
+
+  /* The Rich header of hello.exe */
+  static_assert(compile_pe.richHeader()->key() == 0x3d5bc5c6);
+  const auto rich = runtime_pe.richHeader();
+  REQUIRE(rich);
+  REQUIRE(rich->offset() == 0x80);
+  REQUIRE(rich->size() == 10);
+  REQUIRE(rich->entry(0).productId == 0x103);
+  REQUIRE(rich->entry(0).build == 29395);
+  REQUIRE(rich->entry(0).count == 11);
+  REQUIRE(rich->entry(9).compId() == (0x102u << 16 | 30709));
+  REQUIRE_THROWS_AS(rich->entry(10), pelf::PelfException);
+  REQUIRE(rich->checksum() == rich->key());
+  REQUIRE(rich->isChecksumValid());
+  REQUIRE(pelf::toHex(rich->hash()) == "eb874adc3d0157c4e60d9ee678d31fa2");
+
+  /* Patching the DOS stub breaks the checksum */
+  std::vector<unsigned char> patched{ hello_program.begin(),
+    hello_program.end() };
+  patched[0x50] ^= 1;
+  const pelf::Pe<std::span<const unsigned char>> patched_pe{
+    std::span<const unsigned char>{ patched }
+  };
+  REQUIRE(patched_pe.richHeader()->entry(0).count == 11);
+  REQUIRE_FALSE(patched_pe.richHeader()->isChecksumValid());
+
+  /* Images built by other linkers don't have one */
+  REQUIRE_FALSE(pe32.richHeader());
+
+  static constexpr std::array<unsigned char, 3> abc{ 'a', 'b', 'c' };
+  REQUIRE(pelf::toHex(pelf::md5(abc)) == "900150983cd24fb0d6963f7d28e17f72");
+}
+
+
+TEST_CASE("Test Pe debug directory and PDB signatures")
+{
+  static constexpr auto debug_sections =
+    pelf::getPeNumberOfSections(debug_pe_program);
+  static constexpr pelf::Pe<decltype(debug_pe_program), debug_sections>
+    compile_debug{ debug_pe_program };
+  static_assert(compile_debug.getDebugDirectory().size() == 3);
+  static_assert(compile_debug.getDebugDirectory().entry(0).Type
+                == pelf::IMAGE_DEBUG_TYPE_CODEVIEW);
+
+  const std::span<const unsigned char> bytes{ debug_pe_program };
+  const pelf::Pe<std::span<const unsigned char>> pe{ bytes };
+
+  const auto directory = pe.getDebugDirectory();
+  REQUIRE(directory.size() == 3);
+  REQUIRE(directory.entry(1).Type == pelf::IMAGE_DEBUG_TYPE_VC_FEATURE);
+  REQUIRE(pe.getDebugData(directory.entry(1)).size() == 20);
+  REQUIRE_THROWS_AS(directory.entry(3), pelf::PelfException);
+  REQUIRE_FALSE(directory.find(pelf::IMAGE_DEBUG_TYPE_POGO));
+
+  /* REPRO entries of deterministic builds may not have data */
+  const auto repro = directory.find(pelf::IMAGE_DEBUG_TYPE_REPRO);
+  REQUIRE(repro);
+  REQUIRE(pe.getDebugData(*repro).empty());
+
+  const auto code_view = directory.find(pelf::IMAGE_DEBUG_TYPE_CODEVIEW);
+  REQUIRE(code_view);
+  REQUIRE(code_view->AddressOfRawData == 0x2054);
+  REQUIRE(code_view->PointerToRawData == 0x454);
+
+  const auto info = pe.codeView();
+  REQUIRE(info);
+  REQUIRE(info->guidString() == "3844DBB9-2017-4967-BE7A-A4A2C20430FA");
+  REQUIRE(info->age == 2);
+  REQUIRE(info->path == "C:\\build\\pelf\\debug.pdb");
+  REQUIRE(info->fileName() == "debug.pdb");
+  REQUIRE(info->symbolServerKey() == "3844DBB920174967BE7AA4A2C20430FA2");
+
+  /* The path is a view of the file */
+  REQUIRE(reinterpret_cast<const unsigned char*>(info->path.data())
+          == bytes.data() + 0x454 + 24);
+
+  /* Only RSDS records are decoded */
+  REQUIRE_FALSE(pelf::decodeCodeView(bytes.subspan(0x454, 23)));
+  REQUIRE_FALSE(pelf::decodeCodeView(bytes.subspan(0x455, 0x2f)));
+
+  /* hello.exe only has a POGO entry */
+  REQUIRE(runtime_pe.getDebugDirectory().size() == 1);
+  REQUIRE(runtime_pe.getDebugDirectory().entry(0).Type
+          == pelf::IMAGE_DEBUG_TYPE_POGO);
+  REQUIRE_FALSE(runtime_pe.codeView());
+
+  /* Bulk mode over a directory */
+  namespace fs = std::filesystem;
+  const fs::path root = fs::temp_directory_path() / "pelf_pdb_signatures_test";
+  fs::remove_all(root);
+  fs::create_directories(root / "sub");
+
+  const auto write_file = [](const fs::path& path, const auto& data) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()),
+      static_cast<std::streamsize>(data.size()));
+  };
+  write_file(root / "debug.exe", debug_pe_program);
+  write_file(root / "sub" / "copy.exe", debug_pe_program);
+  write_file(root / "hello.exe", hello_program);
+  write_file(root / "hello_elf", hello_program_elf);
+  write_file(root / "garbage.exe", std::string_view{ "MZ garbage" });
+
+  const auto signatures = pelf::readPdbSignatures(root, 2);
+  REQUIRE(signatures.size() == 2);
+  REQUIRE(signatures[0].file == root / "debug.exe");
+  REQUIRE(signatures[1].file == root / "sub" / "copy.exe");
+  REQUIRE(signatures[1].info().symbolServerKey() == info->symbolServerKey());
+
+  const std::array<fs::path, 3> files{ root / "sub" / "copy.exe",
+    root / "hello.exe",
+    root / "debug.exe" };
+  const auto listed = pelf::readPdbSignatures(files);
+  REQUIRE(listed.size() == 2);
+  REQUIRE(listed[0].file == files[0]);
+  REQUIRE(listed[1].file == files[2]);
+
+  std::ostringstream out;
+  pelf::writePdbSignatures(out, std::span{ listed }.first(1));
+  REQUIRE(out.str()
+          == "3844DBB9-2017-4967-BE7A-A4A2C20430FA\t2\t"
+             "C:\\build\\pelf\\debug.pdb\t"
+               + files[0].string() + "\n");
+
+  fs::remove_all(root);
+}
+
+
+TEST_CASE("Test Pe load config, CFG tables and TLS callbacks")
+{
+  static constexpr auto guard_sections =
+    pelf::getPeNumberOfSections(guard_program);
+  static constexpr pelf::Pe<decltype(guard_program), guard_sections>
+    compile_guard{ guard_program };
+  static_assert(compile_guard.guardFunctions().size() == 300);
+  static_assert(compile_guard.isGuardCallTarget(0x1010));
+
+  const std::span<const unsigned char> bytes{ guard_program };
+  const pelf::Pe<std::span<const unsigned char>> pe{ bytes };
+
+  const auto config = pe.loadConfig();
+  REQUIRE(config);
+  REQUIRE(config->Size == 0x118);
+  REQUIRE(config->SecurityCookie == 0x140002118);
+  REQUIRE(pelf::readInteger<pelf::ULONGLONG>(
+            pe.getDataAtVa(config->SecurityCookie), 0)
+          == 0x2B992DDFA232);
+  REQUIRE((config->GuardFlags & pelf::IMAGE_GUARD_CF_INSTRUMENTED) != 0);
+  REQUIRE(pelf::guardTableStride(config->GuardFlags) == 5);
+  REQUIRE(pe.getDataAtVa(0x1000).empty());
+
+  /* The CFG function table is a view of the file */
+  const auto functions = pe.guardFunctions();
+  REQUIRE(functions.size() == 300);
+  REQUIRE(functions.stride() == 5);
+  REQUIRE(functions.entry(0).rva == 0x1000);
+  REQUIRE(functions.entry(7).flags == pelf::IMAGE_GUARD_FLAG_FID_SUPPRESSED);
+  REQUIRE(functions.entry(299).rva == 0x22b0);
+  REQUIRE_THROWS_AS(functions.entry(300), pelf::PelfException);
+
+  std::size_t suppressed{};
+  pelf::DWORD previous{};
+  for (const auto entry : functions) {
+    REQUIRE(entry.rva >= previous);
+    previous = entry.rva;
+    suppressed += (entry.flags & pelf::IMAGE_GUARD_FLAG_FID_SUPPRESSED) != 0;
+  }
+  REQUIRE(suppressed == 6);
+
+  REQUIRE(functions.contains(0x1070));
+  REQUIRE_FALSE(functions.contains(0x1008));
+  REQUIRE_FALSE(functions.contains(0x22c0));
+  REQUIRE_FALSE(functions.find(0xfff));
+  REQUIRE(pe.isGuardCallTarget(0x1000));
+  REQUIRE(pe.isGuardCallTarget(0x22b0));
+  REQUIRE_FALSE(pe.isGuardCallTarget(0x1070));
+  REQUIRE_FALSE(pe.isGuardCallTarget(0x1008));
+
+  const auto long_jumps = pe.guardLongJumpTargets();
+  REQUIRE(long_jumps.size() == 3);
+  REQUIRE(long_jumps.entry(1).rva == 0x12a4);
+  REQUIRE(long_jumps.contains(0x1400));
+  REQUIRE(pe.guardAddressTakenIatEntries().empty());
+  REQUIRE(pe.safeSehHandlers().empty());
+
+  /* TLS callbacks */
+  const auto tls = pe.tlsDirectory();
+  REQUIRE(tls);
+  REQUIRE(tls->SizeOfZeroFill == 8);
+  REQUIRE(std::string_view{ reinterpret_cast<const char*>(
+                              pe.getDataAtVa(tls->StartAddressOfRawData)
+                                .data()),
+            8 }
+          == "TLS data");
+  const auto callbacks = pe.tlsCallbacks();
+  REQUIRE(std::vector<pelf::ULONGLONG>(callbacks.begin(), callbacks.end())
+          == std::vector<pelf::ULONGLONG>{ 0x140001020, 0x140001030 });
+
+  /* PE32 image whose load config is older than the structure */
+  const std::span<const unsigned char> bytes32{ guard32_program };
+  const pelf::Pe32<std::span<const unsigned char>> pe32{ bytes32 };
+  REQUIRE(pe32.getHeaders()
+            .getOptionalHeader()
+            .mDataDirectories[pelf::IMAGE_DIRECTORY_ENTRY_LOAD_CONFIG]
+            .Size
+          == 0x40);
+  const auto config32 = pe32.loadConfig();
+  REQUIRE(config32);
+  REQUIRE(config32->Size == 0x5c);
+  REQUIRE(config32->SecurityCookie == 0x402060);
+  REQUIRE(pelf::readInteger<pelf::DWORD>(
+            pe32.getDataAtVa(config32->SecurityCookie), 0)
+          == 0xBB40E64E);
+  REQUIRE(config32->GuardLongJumpTargetTable == 0);
+
+  const auto handlers = pe32.safeSehHandlers();
+  REQUIRE(handlers.size() == 4);
+  REQUIRE(handlers.entry(3).rva == 0x1900);
+  REQUIRE(handlers.contains(0x1240));
+  REQUIRE_FALSE(handlers.contains(0x1250));
+
+  const auto functions32 = pe32.guardFunctions();
+  REQUIRE(functions32.size() == 100);
+  REQUIRE(functions32.stride() == 4);
+  REQUIRE(functions32.entry(7).flags == 0);
+  REQUIRE(pe32.isGuardCallTarget(0x1070));
+  REQUIRE(pe32.guardLongJumpTargets().empty());
+
+  const auto callbacks32 = pe32.tlsCallbacks();
+  REQUIRE(std::vector<pelf::DWORD>(callbacks32.begin(), callbacks32.end())
+          == std::vector<pelf::DWORD>{ 0x401020 });
+
+  /* hello.exe isn't built with /guard:cf and has no TLS callbacks */
+  const auto hello_config = runtime_pe.loadConfig();
+  REQUIRE(hello_config);
+  REQUIRE(hello_config->Size == 0x138);
+  REQUIRE(hello_config->SecurityCookie == 0x1400371f0);
+  REQUIRE(hello_config->GuardFlags == pelf::IMAGE_GUARD_CF_INSTRUMENTED);
+  REQUIRE(runtime_pe.guardFunctions().empty());
+  REQUIRE_FALSE(runtime_pe.isGuardCallTarget(0x1000));
+  REQUIRE(runtime_pe.tlsDirectory()->AddressOfCallBacks == 0x1400253b0);
+  REQUIRE(runtime_pe.tlsCallbacks().empty());
+  REQUIRE_FALSE(pelf::Pe<std::span<const unsigned char>>{
+    std::span<const unsigned char>{ debug_pe_program } }
+                  .loadConfig());
+}
+
+
+TEST_CASE("Test Pe .NET metadata")
+{
+  static constexpr auto clr_sections =
+    pelf::getPeNumberOfSections(clr_program);
+  static constexpr pelf::Pe32<decltype(clr_program), clr_sections>
+    compile_clr{ clr_program };
+  static_assert(compile_clr.clrHeader()->EntryPointToken == 0x06000001);
+
+  const std::span<const unsigned char> bytes{ clr_program };
+  const pelf::Pe32<std::span<const unsigned char>> pe{ bytes };
+
+  const auto header = pe.clrHeader();
+  REQUIRE(header);
+  REQUIRE(header->cb == 72);
+  REQUIRE(header->MajorRuntimeVersion == 2);
+  REQUIRE(header->MinorRuntimeVersion == 5);
+  REQUIRE(header->Flags == pelf::COMIMAGE_FLAGS_ILONLY);
+  REQUIRE(header->MetaDataVirtualAddress == 0x105c);
+
+  const auto metadata = pe.clrMetadata();
+  REQUIRE(metadata);
+  const auto& root = metadata->root();
+  REQUIRE(root.version() == "v4.0.30319");
+  REQUIRE(root.streamCount() == 5);
+  REQUIRE(root.stream(0).name == "#~");
+  REQUIRE(root.find("#GUID")->data.size() == 16);
+  REQUIRE_FALSE(root.find("#Pdb"));
+  REQUIRE_THROWS_AS(root.stream(5), pelf::PelfException);
+
+  /* The layouts are computed from the heap sizes and the number of rows */
+  const auto& tables = metadata->tables();
+  REQUIRE(tables.majorVersion() == 2);
+  REQUIRE(tables.stringIndexSize() == 4);
+  REQUIRE(tables.guidIndexSize() == 2);
+  REQUIRE(tables.blobIndexSize() == 2);
+  REQUIRE(tables.codedIndexSize(pelf::CodedIndexKind::TypeDefOrRef) == 2);
+  REQUIRE(tables.rowCount(pelf::MetadataTableId::TypeDef) == 2);
+  REQUIRE(tables.rowCount(pelf::MetadataTableId::CustomAttribute) == 0);
+  REQUIRE(tables.isSorted(pelf::MetadataTableId::CustomAttribute));
+  REQUIRE_FALSE(tables.isSorted(pelf::MetadataTableId::MethodDef));
+  REQUIRE(tables.table(pelf::MetadataTableId::TypeDef).layout().rowSize == 18);
+  REQUIRE(tables.table(pelf::MetadataTableId::MethodDef).layout().rowSize
+          == 16);
+  REQUIRE(tables.table(pelf::MetadataTableId::Assembly).layout().rowSize
+          == 26);
+  REQUIRE(tables.table(pelf::MetadataTableId::Event).empty());
+
+  /* Typed rows */
+  const auto program = metadata->typeDef(1);
+  REQUIRE(program.name == "Program");
+  REQUIRE(program.typeNamespace == "Hello");
+  REQUIRE(program.flags == 0x100001);
+  REQUIRE(program.extends.table == pelf::MetadataTableId::TypeRef);
+  REQUIRE(metadata->typeRef(program.extends.row - 1).name == "Object");
+  REQUIRE(program.methodList == 1);
+  REQUIRE(metadata->typeDef(0).name == "<Module>");
+  REQUIRE_THROWS_AS(metadata->typeDef(2), pelf::PelfException);
+
+  const auto main = metadata->methodDef(0);
+  REQUIRE(main.name == "Main");
+  REQUIRE(main.flags == 0x96);
+  REQUIRE(main.paramList == 1);
+  REQUIRE(std::vector<unsigned char>(main.signature.begin(),
+            main.signature.end())
+          == std::vector<unsigned char>{ 0x00, 0x01, 0x01, 0x1d, 0x0e });
+  REQUIRE(main.signature.data() > bytes.data());
+  REQUIRE(main.signature.data() < bytes.data() + bytes.size());
+  /* Tiny header of 11 bytes of IL */
+  REQUIRE(pe.getDataAtRva(main.rva)[0] == (11 << 2 | 2));
+  REQUIRE(pelf::CodedIndex{ pelf::MetadataTableId::MethodDef, 1 }.token()
+          == header->EntryPointToken);
+
+  const auto write_line = metadata->memberRef(0);
+  REQUIRE(write_line.name == "WriteLine");
+  REQUIRE(write_line.parent.table == pelf::MetadataTableId::TypeRef);
+  REQUIRE(metadata->typeRef(write_line.parent.row - 1).name == "Console");
+  REQUIRE(metadata->typeRef(write_line.parent.row - 1).typeNamespace
+          == "System");
+  REQUIRE(metadata->memberRef(1).name == ".ctor");
+
+  /* Columnar access */
+  const auto methods = tables.table(pelf::MetadataTableId::MethodDef);
+  const auto names = methods.column(3);
+  REQUIRE(names.width() == 4);
+  std::vector<std::string_view> method_names;
+  for (const auto name : names) {
+    method_names.push_back(metadata->strings().get(name));
+  }
+  REQUIRE(method_names == std::vector<std::string_view>{ "Main", ".ctor" });
+  REQUIRE(methods.column(0)[1] == metadata->methodDef(1).rva);
+  REQUIRE_THROWS_AS(methods.column(6), pelf::PelfException);
+  REQUIRE_THROWS_AS(names[2], pelf::PelfException);
+
+  /* The columns of an absent table are empty */
+  const auto events = tables.table(pelf::MetadataTableId::Event);
+  REQUIRE(events.size() == 0);
+  const auto event_types = events.column(2);
+  REQUIRE(event_types.empty());
+  REQUIRE(event_types.width() == 2);
+  REQUIRE(event_types.begin() == event_types.end());
+  REQUIRE_THROWS_AS(event_types[0], pelf::PelfException);
+
+  const auto module = tables.table(pelf::MetadataTableId::Module);
+  REQUIRE(metadata->strings().get(module.value(0, 1)) == "hello.exe");
+  const auto mvid = metadata->guids().get(module.value(0, 2));
+  REQUIRE(mvid[0] == 0x0f);
+  REQUIRE(mvid[15] == 0xf0);
+  REQUIRE(metadata->guids().size() == 1);
+  REQUIRE_THROWS_AS(metadata->guids().get(2), pelf::PelfException);
+
+  const auto assembly_refs = tables.table(pelf::MetadataTableId::AssemblyRef);
+  REQUIRE(metadata->strings().get(assembly_refs.value(0, 6)) == "mscorlib");
+  REQUIRE(metadata->blobs().get(assembly_refs.value(0, 5)).size() == 8);
+  REQUIRE(metadata->typeRef(0).resolutionScope.table
+          == pelf::MetadataTableId::AssemblyRef);
+
+  /* ldstr 0x70000001 */
+  REQUIRE(metadata->userStrings().get(1) == "Hello, World!");
+
+  REQUIRE_THROWS_AS(pelf::MetadataTables::decode(
+                      pelf::CodedIndexKind::CustomAttributeType, 0x1),
+    pelf::PelfException);
+  REQUIRE(pelf::MetadataTables::decode(
+            pelf::CodedIndexKind::CustomAttributeType, 0x2b)
+            .token()
+          == 0x0a000005);
+  REQUIRE_THROWS_AS(pelf::MetadataRoot{ bytes }, pelf::PelfException);
+
+  /* Coded indexes are 4 bytes once a table has 2^(16 - tag bits) rows */
+  const auto type_specs = [](pelf::DWORD rows) {
+    std::vector<unsigned char> stream(32 + 16 + std::size_t{ rows } * 2);
+    stream[4] = 2;
+    stream[8] = 1 << 2;// TypeDef
+    stream[11] = 1 << 3;// TypeSpec (0x1b)
+    stream[24] = 1;
+    stream[28] = static_cast<unsigned char>(rows);
+    stream[29] = static_cast<unsigned char>(rows >> 8);
+    return stream;
+  };
+  const auto wide = type_specs(16384);
+  const pelf::MetadataTables wide_tables{ std::span{ wide } };
+  REQUIRE(wide_tables.codedIndexSize(pelf::CodedIndexKind::TypeDefOrRef) == 4);
+  REQUIRE(wide_tables.codedIndexSize(pelf::CodedIndexKind::HasConstant) == 2);
+  REQUIRE(wide_tables.table(pelf::MetadataTableId::TypeDef).layout().rowSize
+          == 16);
+  REQUIRE(wide_tables.table(pelf::MetadataTableId::TypeSpec).size() == 16384);
+
+  const auto narrow = type_specs(16383);
+  const pelf::MetadataTables narrow_tables{ std::span{ narrow } };
+  REQUIRE(
+    narrow_tables.codedIndexSize(pelf::CodedIndexKind::TypeDefOrRef) == 2);
+  REQUIRE(
+    narrow_tables.codedIndexSize(pelf::CodedIndexKind::MemberRefParent) == 4);
+  REQUIRE(narrow_tables.table(pelf::MetadataTableId::TypeDef).layout().rowSize
+          == 14);
+
+  /* The last row of the TypeSpec table isn't in the stream */
+  REQUIRE_THROWS_AS(
+    pelf::MetadataTables{ std::span{ narrow }.first(narrow.size() - 4) },
+    pelf::PelfException);
+
+  /* Native images don't have a CLI header */
+  REQUIRE_FALSE(runtime_pe.clrHeader());
+  REQUIRE_FALSE(runtime_pe.clrMetadata());
+}
+
+
+TEST_CASE("Test Pe delay and bound imports")
+{
+  const std::span<const unsigned char> bytes{ delay_program };
+  const pelf::Pe32<std::span<const unsigned char>> pe{ bytes };
+
+  REQUIRE(pe.getImports().size() == 1);
+
+  const auto delay_imports = pe.getDelayImports();
+  REQUIRE(delay_imports.size() == 2);
+  std::vector<std::string> names;
+  for (const auto& imported : delay_imports) {
+    for (const auto& function : imported.functions()) {
+      const auto name = function.ordinal
+                          ? "#" + std::to_string(*function.ordinal)
+                          : std::string{ function.name };
+      names.push_back(std::string{ imported.name() } + "!" + name);
+    }
+  }
+  REQUIRE(names
+          == std::vector<std::string>{ "USER32.dll!MessageBoxA",
+            "USER32.dll!#2",
+            "dbghelp.dll!SymInitialize",
+            "dbghelp.dll!SymCleanup" });
+
+  const auto user32 = delay_imports.module(0);
+  REQUIRE(user32.isRvaBased());
+  REQUIRE(user32.descriptor().ImportAddressTableRVA == 0x306c);
+  REQUIRE(user32.functions().begin()->iatRva == 0x306c);
+  REQUIRE(user32.rva(user32.descriptor().ModuleHandleRVA) == 0x3078);
+
+  /* Visual C++ 6 descriptors have virtual addresses */
+  const auto dbghelp = *delay_imports.find("DBGHELP.DLL");
+  REQUIRE_FALSE(dbghelp.isRvaBased());
+  REQUIRE(dbghelp.descriptor().ImportAddressTableRVA == 0x403088);
+  REQUIRE(dbghelp.rva(dbghelp.descriptor().ImportAddressTableRVA) == 0x3088);
+  auto function = dbghelp.functions().begin();
+  ++function;
+  REQUIRE(function->name == "SymCleanup");
+  REQUIRE(function->iatRva == 0x308c);
+  REQUIRE(dbghelp.rva(0) == 0);
+  REQUIRE_FALSE(delay_imports.find("KERNEL32.dll"));
+  REQUIRE_THROWS_AS(delay_imports.module(2), pelf::PelfException);
+
+  /* The bound import directory is in the headers */
+  const auto bound = pe.getBoundImports();
+  REQUIRE(bound.size() == 2);
+  REQUIRE(std::distance(bound.begin(), bound.end()) == 2);
+  const auto kernel32 = *bound.begin();
+  REQUIRE(kernel32.name() == "KERNEL32.dll");
+  REQUIRE(kernel32.timeDateStamp() == 0x5e8f1a2b);
+  REQUIRE(kernel32.descriptor().NumberOfModuleForwarderRefs == 1);
+  REQUIRE(kernel32.forwarderCount() == 1);
+  REQUIRE(kernel32.forwarder(0).name == "NTDLL.DLL");
+  REQUIRE(kernel32.forwarder(0).timeDateStamp == 0x3c4d5e6f);
+  REQUIRE_THROWS_AS(kernel32.forwarder(1), pelf::PelfException);
+  const auto bound_user32 = bound.find("user32.dll");
+  REQUIRE(bound_user32);
+  REQUIRE(bound_user32->timeDateStamp() == 0x1a2b3c4d);
+  REQUIRE(bound_user32->forwarderCount() == 0);
+  REQUIRE_FALSE(bound.find("NTDLL.DLL"));
+
+  /* A truncated forwarder reference ends the table */
+  std::vector<unsigned char> directory{ 0x2b, 0x1a, 0x8f, 0x5e, 0x10, 0x00,
+    0x01, 0x00, 0x6f, 0x5e, 0x4d, 0x3c, 0x10, 0x00 };
+  REQUIRE(pelf::BoundImportDirectory{ std::span{ directory } }.empty());
+
+  /* Images that don't have the directories */
+  REQUIRE(runtime_pe.getDelayImports().empty());
+  REQUIRE(runtime_pe.getBoundImports().empty());
+}
+
+
+TEST_CASE("Test Pe exports, API sets and dependency graph")
+{
+  /* Exports */
+  const std::span<const unsigned char> kernel32_bytes{
+    depends_kernel32_program
+  };
+  const pelf::Pe32<std::span<const unsigned char>> kernel32{ kernel32_bytes };
+  const auto exports = kernel32.getExports();
+  REQUIRE(exports.name() == "KERNEL32.dll");
+  REQUIRE(exports.ordinalBase() == 1);
+  REQUIRE(exports.size() == 6);
+  REQUIRE(exports.nameCount() == 5);
+  REQUIRE(exports.namedFunction(0).name == "ExitProcess");
+  REQUIRE(exports.namedFunction(4).name == "Loop2");
+  REQUIRE_THROWS_AS(exports.namedFunction(5), pelf::PelfException);
+
+  const auto exit_process = exports.find("ExitProcess");
+  REQUIRE(exit_process);
+  REQUIRE(exit_process->ordinal == 1);
+  REQUIRE(exit_process->rva == 0x1000);
+  REQUIRE_FALSE(exit_process->isForwarder());
+  const auto heap_alloc = exports.find("HeapAlloc");
+  REQUIRE(heap_alloc->ordinal == 2);
+  REQUIRE(heap_alloc->forwarder == "NTDLL.RtlAllocateHeap");
+  REQUIRE_FALSE(exports.find("heapalloc"));
+  REQUIRE_FALSE(exports.find("Loop3"));
+  REQUIRE(exports.findOrdinal(6)->rva == 0x1000);
+  REQUIRE(exports.findOrdinal(6)->name.empty());
+  REQUIRE_FALSE(exports.findOrdinal(0));
+  REQUIRE_FALSE(exports.findOrdinal(7));
+  REQUIRE(runtime_pe.getExports().empty());
+
+  /* API set schema */
+  const std::span<const unsigned char> schema_bytes{ apisetschema_program };
+  const pelf::Pe32<std::span<const unsigned char>> schema_pe{ schema_bytes };
+  const auto schema = pelf::ApiSetSchema::find(schema_pe);
+  REQUIRE(schema);
+  REQUIRE(schema->version() == 6);
+  REQUIRE(schema->size() == 2);
+  REQUIRE(schema->name(0) == "api-ms-win-core-heap-l1-1-0");
+  REQUIRE_THROWS_AS(schema->name(2), pelf::PelfException);
+  REQUIRE(schema->resolve("api-ms-win-core-heap-l1-1-0.dll") == "kernel32.dll");
+  REQUIRE(schema->resolve("API-MS-Win-Core-Heap-L1-1-5.DLL") == "kernel32.dll");
+  REQUIRE(schema->resolve("api-ms-win-core-heap-l1-1-0", "KERNEL32.dll")
+          == "ntdll.dll");
+  REQUIRE(schema->resolve("api-ms-win-core-heap-l1-1-0", "user32.dll")
+          == "kernel32.dll");
+  REQUIRE_FALSE(schema->resolve("api-ms-win-core-heap-l1-2-0.dll"));
+  REQUIRE_FALSE(schema->resolve("ext-ms-win-missing-l1-1-0.dll"));
+  REQUIRE(pelf::ApiSetSchema::isApiSetName("EXT-ms-win-missing-l1-1-0.dll"));
+  REQUIRE_FALSE(pelf::ApiSetSchema::isApiSetName("kernel32.dll"));
+  REQUIRE_FALSE(pelf::ApiSetSchema::find(kernel32));
+  REQUIRE_THROWS_AS(pelf::ApiSetSchema{ kernel32_bytes }, pelf::PelfException);
+
+  /* A directory with an API set schema and a file that isn't a PE image */
+  namespace fs = std::filesystem;
+  const fs::path root = fs::temp_directory_path() / "pelf_dependency_test";
+  fs::remove_all(root);
+  fs::create_directories(root / "sub");
+  const auto write_file = [](const fs::path& path, const auto& data) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()),
+      static_cast<std::streamsize>(data.size()));
+  };
+  write_file(root / "app.exe", depends_app_program);
+  write_file(root / "KERNEL32.DLL", depends_kernel32_program);
+  write_file(root / "ntdll.dll", depends_ntdll_program);
+  write_file(root / "apisetschema.dll", apisetschema_program);
+  write_file(root / "sub" / "user32.dll", depends_ntdll_program);
+  write_file(root / "readme.txt", std::string_view{ "not a PE image" });
+
+  const pelf::PeDependencyGraph graph{ root };
+  REQUIRE(graph.modules().size() == 4);
+  REQUIRE(graph.apiSetSchema());
+  const auto app_index = graph.find("APP.EXE");
+  const auto kernel32_index = graph.find("kernel32.dll");
+  const auto ntdll_index = graph.find("ntdll.dll");
+  REQUIRE(app_index);
+  REQUIRE(kernel32_index);
+  REQUIRE(ntdll_index);
+  REQUIRE_FALSE(graph.find("user32.dll"));
+  REQUIRE_FALSE(graph.find("readme.txt"));
+  REQUIRE_THROWS_AS(graph.module(4), pelf::PelfException);
+
+  const auto& app = graph.module(*app_index);
+  REQUIRE(app.name == "app.exe");
+  REQUIRE(app.imports.size() == 7);
+  REQUIRE(app.exports.empty());
+
+  /* API set, then the forwarder of kernel32 to ntdll */
+  REQUIRE(app.imports[0].dll == "api-ms-win-core-heap-l1-1-0.dll");
+  REQUIRE(app.imports[0].status == pelf::ImportStatus::Resolved);
+  REQUIRE(app.imports[0].module == *ntdll_index);
+  REQUIRE(graph.module(app.imports[0].module)
+            .exports[app.imports[0].exportIndex]
+            .name
+          == "RtlAllocateHeap");
+
+  REQUIRE(app.imports[1].function == "ExitProcess");
+  REQUIRE(app.imports[1].status == pelf::ImportStatus::Resolved);
+  REQUIRE(app.imports[1].module == *kernel32_index);
+  REQUIRE(app.imports[2].status == pelf::ImportStatus::ExportNotFound);
+  REQUIRE(app.imports[3].ordinal == 6);
+  REQUIRE(app.imports[3].status == pelf::ImportStatus::Resolved);
+  REQUIRE(app.imports[3].exportIndex == 5);
+  REQUIRE(app.imports[4].status == pelf::ImportStatus::ApiSetNotResolved);
+
+  REQUIRE(app.imports[5].delayLoaded);
+  REQUIRE(app.imports[5].status == pelf::ImportStatus::ModuleNotFound);
+  REQUIRE(app.imports[6].delayLoaded);
+  REQUIRE(app.imports[6].status == pelf::ImportStatus::Resolved);
+  REQUIRE(app.imports[6].module == *ntdll_index);
+  REQUIRE_FALSE(app.imports[1].delayLoaded);
+
+  REQUIRE(app.dependencies
+          == std::vector<std::size_t>{ *kernel32_index, *ntdll_index });
+  REQUIRE(graph.module(*kernel32_index).dependencies
+          == std::vector<std::size_t>{ *ntdll_index });
+  REQUIRE(graph.transitiveDependencies(*kernel32_index)
+          == std::vector<std::size_t>{ *ntdll_index });
+  REQUIRE(graph.transitiveDependencies(*ntdll_index).empty());
+
+  /* Forwarders through an API set whose host depends on the importer, and
+   * forwarders that never end */
+  const auto heap_free = graph.resolveImport("kernel32", "HeapFree");
+  REQUIRE(heap_free.status == pelf::ImportStatus::Resolved);
+  REQUIRE(heap_free.module == *ntdll_index);
+  REQUIRE(heap_free.exportIndex == 1);
+  REQUIRE(graph.resolveImport("KERNEL32.dll", "Loop1").status
+          == pelf::ImportStatus::ForwarderCycle);
+  REQUIRE(graph.resolveImport("KERNEL32.dll", "#1").exportIndex == 0);
+  REQUIRE(graph.resolveImport("KERNEL32.dll", "#7").status
+          == pelf::ImportStatus::ExportNotFound);
+  REQUIRE(graph.resolveModule("api-ms-win-core-heap-l1-1-0.dll")
+          == kernel32_index);
+  REQUIRE(graph.resolveModule("api-ms-win-core-heap-l1-1-0.dll", "kernel32.dll")
+          == ntdll_index);
+  REQUIRE(graph.resolveModule("NTDLL") == ntdll_index);
+  REQUIRE_FALSE(graph.resolveModule("ext-ms-win-missing-l1-1-0.dll"));
+
+  /* One thread gives the same graph, without a schema API sets aren't found */
+  const pelf::PeDependencyGraph serial{ root, root / "apisetschema.dll", 1 };
+  REQUIRE(serial.module(*app_index).dependencies == app.dependencies);
+  REQUIRE(serial.module(*app_index).imports[0].module == *ntdll_index);
+
+  fs::remove(root / "apisetschema.dll");
+  const pelf::PeDependencyGraph without_schema{ root };
+  REQUIRE_FALSE(without_schema.apiSetSchema());
+  const auto& unresolved =
+    without_schema.module(*without_schema.find("app.exe"));
+  REQUIRE(unresolved.imports[0].status == pelf::ImportStatus::ModuleNotFound);
+  REQUIRE_THROWS_AS(pelf::PeDependencyGraph(root, root / "ntdll.dll"),
+    pelf::PelfException);
+
+  /* A schema whose host values aren't in the file is rejected when it's
+   * parsed, before the workers resolve the imports of 40 modules */
+  std::vector<unsigned char> corrupt(
+    apisetschema_program.begin(), apisetschema_program.end());
+  const std::size_t apiset = schema_pe.getSections().at(1).PointerToRawData;
+  const std::size_t first_entry =
+    apiset + pelf::readInteger<pelf::DWORD>(corrupt, apiset + 16);
+  std::fill_n(
+    corrupt.begin() + static_cast<std::ptrdiff_t>(first_entry + 16), 4, 0xf0);
+  REQUIRE_THROWS_AS(
+    pelf::ApiSetSchema::find(pelf::Pe32<std::span<const unsigned char>>{
+      std::span<const unsigned char>{ corrupt } }),
+    pelf::PelfException);
+
+  write_file(root / "apisetschema.dll", corrupt);
+  for (int i{}; i < 40; ++i) {
+    write_file(root / ("app" + std::to_string(i) + ".exe"), depends_app_program);
+  }
+  REQUIRE_THROWS_AS(pelf::PeDependencyGraph(root, std::nullopt, 4),
+    pelf::PelfException);
+
+  /* The first exception of a worker is rethrown once the pool has joined */
+  REQUIRE_THROWS_AS(pelf::detail::parallelFor(1000,
+                      4,
+                      [](std::size_t i) {
+                        if (i == 10) { throw pelf::PelfException{ "worker" }; }
+                      }),
+    pelf::PelfException);
+
+  fs::remove_all(root);
+}